@@ -0,0 +1,396 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+
+/* @file       eupdater-compress.c
+    @brief      This file implements a linux command line tool which compresses a binary image for the CMD_START_EXT
+                download of the eUpdater with codec UPD_CODEC_LZ4
+    @author     agent@local
+    @date       10/18/2026
+    
+    build:      gcc -O2 -Wall -o eupdater-compress eupdater-compress.c
+    
+    usage:      eupdater-compress image.bin image.lz4
+                eupdater-compress -d image.lz4 image.bin
+    
+    the input is the raw binary of the image (e.g., from fromelf --bin or arm-none-eabi-objcopy -O binary). the output 
+    is in lz4 block format, with the match offsets up to 64K of the standard. the updater keeps no history in ram, as 
+    it reads the matches back from the flash it has written, so any lz4 block encoder can be used as well. the tool 
+    prints the size and the crc32 of the image, which the host must put inside CMD_START_EXT. with -d the tool 
+    decompresses a stream and checks it in the same way the updater does.
+**/
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+// the biggest offset of the lz4 block format
+#define LZ_MAXOFFSET        65535
+
+#define LZ_HASHLOG          14
+#define LZ_MINMATCH         4
+// rules of the lz4 block format: the last match starts at least 12 bytes before the end and the last 5 bytes are literals
+#define LZ_MFLIMIT          12
+#define LZ_LASTLITERALS     5
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_read32(const uint8_t *p);
+static size_t s_compress(const uint8_t *in, size_t size, uint8_t *out);
+static size_t s_emit(uint8_t *out, const uint8_t *literals, size_t litlen, size_t offset, size_t matchlen);
+static size_t s_emit_length(uint8_t *out, size_t len);
+static long s_decompress(const uint8_t *in, size_t size, uint8_t *out, size_t capacity);
+static uint32_t s_crc32(const uint8_t *data, size_t size);
+static uint8_t * s_file_read(const char *filename, size_t *size);
+static int s_file_write(const char *filename, const uint8_t *data, size_t size);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of main
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int decompress = 0;
+    uint8_t *in = NULL;
+    uint8_t *out = NULL;
+    size_t insize = 0;
+    long outsize = 0;
+    size_t capacity = 0;
+    
+    if((argc == 4) && (0 == strcmp(argv[1], "-d")))
+    {
+        decompress = 1;
+        argv++;
+    }
+    else if(argc != 3)
+    {
+        fprintf(stderr, "usage: %s image.bin image.lz4\n       %s -d image.lz4 image.bin\n", argv[0], argv[0]);
+        return(1);
+    }
+    
+    in = s_file_read(argv[1], &insize);
+    if(NULL == in)
+    {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return(1);
+    }
+    
+    // lz4 expands an incompressible input by at most 1/255 plus the token
+    capacity = (0 == decompress) ? (insize + insize/255 + 16) : (16*1024*1024);
+    out = (uint8_t*)malloc(capacity);
+    if(NULL == out)
+    {
+        return(1);
+    }
+    
+    if(0 == decompress)
+    {
+        outsize = (long)s_compress(in, insize, out);
+        printf("image: %zu bytes, crc32 0x%08X. compressed: %ld bytes (%.1f%%)\n", insize, s_crc32(in, insize), outsize, 
+               (0 == insize) ? (0.0) : (100.0*outsize/insize));
+    }
+    else
+    {
+        outsize = s_decompress(in, insize, out, capacity);
+        if(outsize < 0)
+        {
+            fprintf(stderr, "%s is not a valid stream at byte %ld\n", argv[1], -outsize-1);
+            return(1);
+        }
+        printf("image: %ld bytes, crc32 0x%08X\n", outsize, s_crc32(out, (size_t)outsize));
+    }
+    
+    if(0 != s_file_write(argv[2], out, (size_t)outsize))
+    {
+        fprintf(stderr, "cannot write %s\n", argv[2]);
+        return(1);
+    }
+    
+    free(in);
+    free(out);
+    
+    return(0);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_read32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return(v);
+}
+
+// greedy parsing with a single candidate per hash. images are small, so speed is not an issue
+static size_t s_compress(const uint8_t *in, size_t size, uint8_t *out)
+{
+    static uint32_t table[1 << LZ_HASHLOG];     // position+1 of the last sequence with such a hash. 0 is none
+    size_t ip = 0;
+    size_t anchor = 0;
+    size_t op = 0;
+    size_t ref = 0;
+    size_t len = 0;
+    uint32_t seq = 0;
+    uint32_t h = 0;
+    const size_t mflimit = (size > LZ_MFLIMIT) ? (size - LZ_MFLIMIT) : (0);
+    const size_t matchlimit = (size > LZ_LASTLITERALS) ? (size - LZ_LASTLITERALS) : (0);
+    
+    memset(table, 0, sizeof(table));
+    
+    while(ip < mflimit)
+    {
+        seq = s_read32(&in[ip]);
+        h = (seq * 2654435761U) >> (32 - LZ_HASHLOG);
+        ref = table[h];
+        table[h] = (uint32_t)(ip + 1);
+        
+        if((0 != ref) && ((ip - (ref-1)) <= LZ_MAXOFFSET) && (seq == s_read32(&in[ref-1])))
+        {
+            ref--;
+            len = LZ_MINMATCH;
+            while(((ip + len) < matchlimit) && (in[ref+len] == in[ip+len]))
+            {
+                len++;
+            }
+            op += s_emit(&out[op], &in[anchor], ip - anchor, ip - ref, len);
+            ip += len;
+            anchor = ip;
+        }
+        else
+        {
+            ip++;
+        }
+    }
+    
+    // the last sequence has only literals
+    op += s_emit(&out[op], &in[anchor], size - anchor, 0, 0);
+    
+    return(op);
+}
+
+static size_t s_emit(uint8_t *out, const uint8_t *literals, size_t litlen, size_t offset, size_t matchlen)
+{
+    size_t op = 1;
+    uint8_t token = (uint8_t)(((litlen < 15) ? (litlen) : (15)) << 4);
+    
+    if(litlen >= 15)
+    {
+        op += s_emit_length(&out[op], litlen - 15);
+    }
+    memcpy(&out[op], literals, litlen);
+    op += litlen;
+    
+    if(0 != matchlen)
+    {
+        matchlen -= LZ_MINMATCH;
+        token |= (uint8_t)((matchlen < 15) ? (matchlen) : (15));
+        out[op++] = offset & 0xFF;
+        out[op++] = (offset >> 8) & 0xFF;
+        if(matchlen >= 15)
+        {
+            op += s_emit_length(&out[op], matchlen - 15);
+        }
+    }
+    
+    out[0] = token;
+    
+    return(op);
+}
+
+static size_t s_emit_length(uint8_t *out, size_t len)
+{
+    size_t op = 0;
+    
+    while(len >= 255)
+    {
+        out[op++] = 255;
+        len -= 255;
+    }
+    out[op++] = (uint8_t)len;
+    
+    return(op);
+}
+
+// returns the size of the output or -(1+position) of the error inside the input
+static long s_decompress(const uint8_t *in, size_t size, uint8_t *out, size_t capacity)
+{
+    size_t ip = 0;
+    size_t op = 0;
+    size_t len = 0;
+    size_t offset = 0;
+    uint8_t token = 0;
+    uint8_t byte = 0;
+    
+    while(ip < size)
+    {
+        token = in[ip++];
+        
+        len = token >> 4;
+        if(15 == len)
+        {
+            do
+            {
+                if(ip >= size)
+                {
+                    return(-(long)ip-1);
+                }
+                byte = in[ip++];
+                len += byte;
+            } while(255 == byte);
+        }
+        if(((ip + len) > size) || ((op + len) > capacity))
+        {
+            return(-(long)ip-1);
+        }
+        memcpy(&out[op], &in[ip], len);
+        ip += len;
+        op += len;
+        
+        if(ip == size)
+        {   // the last sequence has only literals
+            break;
+        }
+        
+        if((ip + 2) > size)
+        {
+            return(-(long)ip-1);
+        }
+        offset = in[ip] | (in[ip+1] << 8);
+        ip += 2;
+        if((0 == offset) || (offset > op))
+        {
+            return(-(long)ip-1);
+        }
+        
+        len = token & 0x0F;
+        if(15 == len)
+        {
+            do
+            {
+                if(ip >= size)
+                {
+                    return(-(long)ip-1);
+                }
+                byte = in[ip++];
+                len += byte;
+            } while(255 == byte);
+        }
+        len += LZ_MINMATCH;
+        if((op + len) > capacity)
+        {
+            return(-(long)ip-1);
+        }
+        // byte by byte because the match can overlap the bytes it produces
+        for(; len > 0; len--, op++)
+        {
+            out[op] = out[op - offset];
+        }
+    }
+    
+    return((long)op);
+}
+
+// the crc32 of zlib, the same as the one of updater-core.c
+static uint32_t s_crc32(const uint8_t *data, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    size_t i = 0;
+    int b = 0;
+    
+    for(i=0; i<size; i++)
+    {
+        crc ^= data[i];
+        for(b=0; b<8; b++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    
+    return(crc ^ 0xFFFFFFFF);
+}
+
+static uint8_t * s_file_read(const char *filename, size_t *size)
+{
+    FILE *f = fopen(filename, "rb");
+    uint8_t *data = NULL;
+    long length = 0;
+    
+    if(NULL == f)
+    {
+        return(NULL);
+    }
+    
+    fseek(f, 0, SEEK_END);
+    length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    
+    data = (uint8_t*)malloc((length > 0) ? (length) : (1));
+    if((NULL != data) && (length > 0) && (1 != fread(data, (size_t)length, 1, f)))
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    
+    *size = (length > 0) ? ((size_t)length) : (0);
+    return(data);
+}
+
+static int s_file_write(const char *filename, const uint8_t *data, size_t size)
+{
+    FILE *f = fopen(filename, "wb");
+    int r = 0;
+    
+    if(NULL == f)
+    {
+        return(-1);
+    }
+    
+    if((size > 0) && (1 != fwrite(data, size, 1, f)))
+    {
+        r = -1;
+    }
+    fclose(f);
+    
+    return(r);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
+
@@ -0,0 +1,459 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+
+/* @file       eupdater-delta.c
+    @brief      This file implements a linux command line tool which builds the delta between the installed image and
+                a new one for the CMD_START_EXT download of the eUpdater with codec UPD_CODEC_DELTA
+    @author     agent@local
+    @date       10/18/2026
+    
+    build:      gcc -O2 -Wall -o eupdater-delta eupdater-delta.c
+    
+    usage:      eupdater-delta old.bin new.bin new.delta
+                eupdater-delta -a old.bin new.delta new.bin
+    
+    the images are raw binaries (e.g., from fromelf --bin or arm-none-eabi-objcopy -O binary). the delta is made of
+    the operations described in updater-core.c: as in bsdiff, a region of the new image which is similar to one of the 
+    old image is sent as the bytewise difference with it, which is mostly made of zeros when the code has only moved. 
+    thus the delta is meant to be compressed with eupdater-compress and sent with UPD_CODEC_DELTA_LZ4. the tool prints 
+    the size and the crc32 of the new image, which the host must put inside CMD_START_EXT. with -a the tool applies a 
+    delta in the same way the updater does.
+**/
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define DELTA_HASHLOG       16
+#define DELTA_MINMATCH      8           // shorter exact matches are not worth an operation
+#define DELTA_CHAIN         64          // candidates visited for each position
+#define DELTA_BLOCK         16          // an approximate match is extended by blocks ...
+#define DELTA_BLOCKEQUAL    8           // ... which have at least this number of equal bytes
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    uint8_t*        data;
+    size_t          size;
+    size_t          capacity;
+} deltaBuffer_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_diff(const uint8_t *old, size_t oldsize, const uint8_t *new, size_t newsize, deltaBuffer_t *delta);
+static size_t s_match_length(const uint8_t *a, const uint8_t *b, size_t max);
+static size_t s_match_extend(const uint8_t *a, const uint8_t *b, size_t max);
+static void s_emit(deltaBuffer_t *delta, uint8_t opcode, size_t length, size_t from, const uint8_t *old, const uint8_t *new);
+static long s_apply(const uint8_t *old, size_t oldsize, const uint8_t *delta, size_t size, uint8_t *new, size_t capacity);
+static void s_put(deltaBuffer_t *b, const void *data, size_t size);
+static void s_put32(deltaBuffer_t *b, uint32_t value);
+static uint32_t s_get32(const uint8_t *p);
+static uint32_t s_hash(const uint8_t *p);
+static uint32_t s_crc32(const uint8_t *data, size_t size);
+static uint8_t * s_file_read(const char *filename, size_t *size);
+static int s_file_write(const char *filename, const uint8_t *data, size_t size);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of main
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int apply = 0;
+    uint8_t *old = NULL;
+    uint8_t *in = NULL;
+    size_t oldsize = 0;
+    size_t insize = 0;
+    deltaBuffer_t out = {NULL, 0, 0};
+    long newsize = 0;
+    
+    if((argc == 5) && (0 == strcmp(argv[1], "-a")))
+    {
+        apply = 1;
+        argv++;
+    }
+    else if(argc != 4)
+    {
+        fprintf(stderr, "usage: %s old.bin new.bin new.delta\n       %s -a old.bin new.delta new.bin\n", argv[0], argv[0]);
+        return(1);
+    }
+    
+    old = s_file_read(argv[1], &oldsize);
+    in = s_file_read(argv[2], &insize);
+    if((NULL == old) || (NULL == in))
+    {
+        fprintf(stderr, "cannot read %s or %s\n", argv[1], argv[2]);
+        return(1);
+    }
+    
+    if(0 == apply)
+    {
+        s_diff(old, oldsize, in, insize, &out);
+        printf("image: %zu bytes, crc32 0x%08X. delta: %zu bytes (%.1f%%)\n", insize, s_crc32(in, insize), out.size,
+               (0 == insize) ? (0.0) : (100.0*out.size/insize));
+    }
+    else
+    {
+        out.capacity = 16*1024*1024;
+        out.data = (uint8_t*)malloc(out.capacity);
+        newsize = s_apply(old, oldsize, in, insize, out.data, out.capacity);
+        if(newsize < 0)
+        {
+            fprintf(stderr, "%s is not a valid delta of %s at byte %ld\n", argv[2], argv[1], -newsize-1);
+            return(1);
+        }
+        out.size = (size_t)newsize;
+        printf("image: %zu bytes, crc32 0x%08X\n", out.size, s_crc32(out.data, out.size));
+    }
+    
+    if(0 != s_file_write(argv[3], out.data, out.size))
+    {
+        fprintf(stderr, "cannot write %s\n", argv[3]);
+        return(1);
+    }
+    
+    free(old);
+    free(in);
+    free(out.data);
+    
+    return(0);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+// a simplified bsdiff: for each position of the new image we look for the longest exact match inside the old image,
+// preferring the alignment of the previous match. the match is then extended while the bytes mostly stay equal.
+static void s_diff(const uint8_t *old, size_t oldsize, const uint8_t *new, size_t newsize, deltaBuffer_t *delta)
+{
+    int32_t *head = (int32_t*)malloc(sizeof(int32_t) << DELTA_HASHLOG);
+    int32_t *prev = (int32_t*)malloc(sizeof(int32_t) * (oldsize + 1));
+    size_t pos = 0;
+    size_t literals = 0;
+    size_t bestlen = 0;
+    size_t bestfrom = 0;
+    size_t len = 0;
+    size_t ext = 0;
+    long lastshift = 0;         // old position - new position of the last match
+    int32_t cand = 0;
+    int chain = 0;
+    size_t i = 0;
+    
+    memset(head, 0xff, sizeof(int32_t) << DELTA_HASHLOG);
+    for(i=0; i+DELTA_MINMATCH <= oldsize; i++)
+    {
+        uint32_t h = s_hash(&old[i]);
+        prev[i] = head[h];
+        head[h] = (int32_t)i;
+    }
+    
+    s_put32(delta, (uint32_t)oldsize);
+    s_put32(delta, s_crc32(old, oldsize));
+    
+    while(pos < newsize)
+    {
+        bestlen = 0;
+        
+        if(pos + DELTA_MINMATCH <= newsize)
+        {
+            // the alignment of the previous match first: code which has only moved keeps it
+            long from = (long)pos + lastshift;
+            if((from >= 0) && ((size_t)from < oldsize))
+            {
+                bestlen = s_match_length(&old[from], &new[pos], ((oldsize-from) < (newsize-pos)) ? (oldsize-from) : (newsize-pos));
+                bestfrom = (size_t)from;
+            }
+            
+            for(cand = head[s_hash(&new[pos])], chain = 0; (cand >= 0) && (chain < DELTA_CHAIN); cand = prev[cand], chain++)
+            {
+                size_t max = ((oldsize-cand) < (newsize-pos)) ? (oldsize-cand) : (newsize-pos);
+                len = s_match_length(&old[cand], &new[pos], max);
+                if(len > bestlen)
+                {
+                    bestlen = len;
+                    bestfrom = (size_t)cand;
+                }
+            }
+        }
+        
+        if(bestlen < DELTA_MINMATCH)
+        {
+            literals++;
+            pos++;
+            continue;
+        }
+        
+        if(0 != literals)
+        {
+            s_emit(delta, 'I', literals, 0, old, &new[pos-literals]);
+            literals = 0;
+        }
+        
+        len = bestlen;
+        ext = s_match_extend(&old[bestfrom+len], &new[pos+len], ((oldsize-bestfrom-len) < (newsize-pos-len)) ? (oldsize-bestfrom-len) : (newsize-pos-len));
+        
+        s_emit(delta, (0 == ext) ? ('C') : ('A'), len+ext, bestfrom, old, &new[pos]);
+        lastshift = (long)bestfrom - (long)pos;
+        pos += len+ext;
+    }
+    
+    if(0 != literals)
+    {
+        s_emit(delta, 'I', literals, 0, old, &new[pos-literals]);
+    }
+    
+    free(head);
+    free(prev);
+}
+
+static size_t s_match_length(const uint8_t *a, const uint8_t *b, size_t max)
+{
+    size_t len = 0;
+    
+    while((len < max) && (a[len] == b[len]))
+    {
+        len++;
+    }
+    
+    return(len);
+}
+
+// returns how many bytes after an exact match can go in the same 'A' operation
+static size_t s_match_extend(const uint8_t *a, const uint8_t *b, size_t max)
+{
+    size_t ext = 0;
+    size_t equal = 0;
+    size_t i = 0;
+    
+    while((ext + DELTA_BLOCK) <= max)
+    {
+        for(i=0, equal=0; i<DELTA_BLOCK; i++)
+        {
+            equal += (a[ext+i] == b[ext+i]) ? (1) : (0);
+        }
+        if(equal < DELTA_BLOCKEQUAL)
+        {
+            break;
+        }
+        ext += DELTA_BLOCK;
+    }
+    
+    // the tail which is equal is taken anyway
+    ext += s_match_length(&a[ext], &b[ext], max-ext);
+    
+    return(ext);
+}
+
+static void s_emit(deltaBuffer_t *delta, uint8_t opcode, size_t length, size_t from, const uint8_t *old, const uint8_t *new)
+{
+    size_t i = 0;
+    uint8_t byte = 0;
+    
+    s_put(delta, &opcode, 1);
+    s_put32(delta, (uint32_t)length);
+    
+    if('I' == opcode)
+    {
+        s_put(delta, new, length);
+        return;
+    }
+    
+    s_put32(delta, (uint32_t)from);
+    
+    if('A' == opcode)
+    {
+        for(i=0; i<length; i++)
+        {
+            byte = (uint8_t)(new[i] - old[from+i]);
+            s_put(delta, &byte, 1);
+        }
+    }
+}
+
+// returns the size of the new image or -(1+position) of the error inside the delta
+static long s_apply(const uint8_t *old, size_t oldsize, const uint8_t *delta, size_t size, uint8_t *new, size_t capacity)
+{
+    size_t ip = 8;
+    size_t op = 0;
+    size_t length = 0;
+    size_t from = 0;
+    size_t i = 0;
+    uint8_t opcode = 0;
+    
+    if((size < 8) || (s_get32(&delta[0]) != oldsize) || (s_get32(&delta[4]) != s_crc32(old, oldsize)))
+    {
+        return(-1);
+    }
+    
+    while(ip < size)
+    {
+        opcode = delta[ip];
+        if((('C' != opcode) && ('A' != opcode) && ('I' != opcode)) || ((ip + (('I' == opcode) ? (5) : (9))) > size))
+        {
+            return(-(long)ip-1);
+        }
+        
+        length = s_get32(&delta[ip+1]);
+        from = ('I' == opcode) ? (0) : (s_get32(&delta[ip+5]));
+        ip += ('I' == opcode) ? (5) : (9);
+        
+        if((0 == length) || ((op + length) > capacity) || (('I' != opcode) && ((from > oldsize) || (length > (oldsize - from)))) ||
+           (('C' != opcode) && ((ip + length) > size)))
+        {
+            return(-(long)ip-1);
+        }
+        
+        for(i=0; i<length; i++)
+        {
+            switch(opcode)
+            {
+                case 'C':   new[op+i] = old[from+i];                                break;
+                case 'A':   new[op+i] = (uint8_t)(old[from+i] + delta[ip+i]);       break;
+                default:    new[op+i] = delta[ip+i];                                break;
+            }
+        }
+        
+        op += length;
+        ip += ('C' == opcode) ? (0) : (length);
+    }
+    
+    return((long)op);
+}
+
+static void s_put(deltaBuffer_t *b, const void *data, size_t size)
+{
+    if((b->size + size) > b->capacity)
+    {
+        b->capacity = 2*(b->size + size) + 1024;
+        b->data = (uint8_t*)realloc(b->data, b->capacity);
+    }
+    memcpy(&b->data[b->size], data, size);
+    b->size += size;
+}
+
+static void s_put32(deltaBuffer_t *b, uint32_t value)
+{
+    uint8_t le[4] = { value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, (value >> 24) & 0xFF };
+    s_put(b, le, 4);
+}
+
+static uint32_t s_get32(const uint8_t *p)
+{
+    return(p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+static uint32_t s_hash(const uint8_t *p)
+{
+    uint64_t v = 0;
+    memcpy(&v, p, DELTA_MINMATCH);
+    return((uint32_t)((v * 0x9E3779B97F4A7C15ULL) >> (64 - DELTA_HASHLOG)));
+}
+
+// the crc32 of zlib, the same as the one of updater-core.c
+static uint32_t s_crc32(const uint8_t *data, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    size_t i = 0;
+    int b = 0;
+    
+    for(i=0; i<size; i++)
+    {
+        crc ^= data[i];
+        for(b=0; b<8; b++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    
+    return(crc ^ 0xFFFFFFFF);
+}
+
+static uint8_t * s_file_read(const char *filename, size_t *size)
+{
+    FILE *f = fopen(filename, "rb");
+    uint8_t *data = NULL;
+    long length = 0;
+    
+    if(NULL == f)
+    {
+        return(NULL);
+    }
+    
+    fseek(f, 0, SEEK_END);
+    length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    
+    data = (uint8_t*)malloc((length > 0) ? (length) : (1));
+    if((NULL != data) && (length > 0) && (1 != fread(data, (size_t)length, 1, f)))
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    
+    *size = (length > 0) ? ((size_t)length) : (0);
+    return(data);
+}
+
+static int s_file_write(const char *filename, const uint8_t *data, size_t size)
+{
+    FILE *f = fopen(filename, "wb");
+    int r = 0;
+    
+    if(NULL == f)
+    {
+        return(-1);
+    }
+    
+    if((size > 0) && (1 != fwrite(data, size, 1, f)))
+    {
+        r = -1;
+    }
+    fclose(f);
+    
+    return(r);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
+
@@ -162,6 +162,8 @@ typedef enum {
     CMD_SHALS           = 0x0A,
     CMD_BLINK           = 0x0B,
     CMD_UPD_ONCE        = 0x0C,
+    CMD_DATAWIN         = 0x0D,
+    CMD_START_EXT       = 0x0E,
     CMD_MACGET          = 0x10,
     CMD_MACSET          = 0x11,
     CMD_SYSEEPROMERASE  = 0x12,
@@ -183,6 +185,66 @@ enum {
 #define MAX0(a) ( ((a)>0) ? (a) : (0) )
 
 
+// the windowed download (CMD_DATAWIN) lets the host keep up to UPD_WIN_SIZE packets in flight instead of waiting
+// for the reply of each CMD_DATA. the request is:
+//   [0] = CMD_DATAWIN, [1..2] = seq, [3..6] = address, [7..8] = size, [9..12] = crc32 of data, [13..] = data
+// and the reply is:
+//   [0] = CMD_DATAWIN, [1] = result, [2..3] = seq, [4..5] = next seq expected, [6..9] = mask of seqs received after it
+// all fields are little endian. seq starts from 0 after CMD_START. bit i of the mask tells that seq next+1+i is received,
+// so that a single reply is a selective ack of the whole window and the host resends only what is missing.
+// a packet already received is acked again but not written again, as flash cannot be programmed twice.
+// the crc32 is the one of zlib. an old updater does not reply to CMD_DATAWIN, so the host falls back to CMD_DATA.
+#define UPD_WIN_SIZE            32
+#define UPD_WIN_HEADERSIZE      13
+#define UPD_WIN_REPLYSIZE       10
+
+// contiguous chunks of data are collected in ram and written with a single hal_flash_write()
+#define UPD_STAGING_SIZE        2048
+
+// hal_flash_write() of the stm32f4 accepts only even addresses and sizes, and it programs only erased half words. a 
+// chunk which begins or ends at an odd address shares a half word with the chunk before or after it, which may not be 
+// received yet: its byte is kept as an edge until the other byte of the half word comes, or until CMD_END, when it is 
+// written with 0xFF in place of the missing byte. each chunk in flight can leave two edges.
+#define UPD_STAGING_EDGES       (2*UPD_WIN_SIZE+2)
+
+// CMD_START_EXT is a CMD_START which also declares the codec, the size and the crc32 of the image:
+//   [0] = CMD_START_EXT, [1] = what to program, [2] = codec, [3..6] = size of the image, [7..10] = crc32 of the image
+// and whose reply is the same as the one of CMD_START. with UPD_CODEC_LZ4 the data of CMD_DATAWIN is a stream in lz4 
+// block format, with match offsets up to 64K, which the updater decompresses on the fly. no window is kept in ram: a 
+// match is read back from the flash already written or from the staging. the address of each chunk is then the start of the memory space plus the offset of the chunk inside the compressed stream, and
+// the chunks are accepted only in order. at CMD_END the crc32 of the programmed image must be the declared one,
+// otherwise the image is treated as when packets are lost and is not marked valid in the partition table.
+// with UPD_CODEC_DELTA the stream builds the new image from the installed one. it begins with the size and the crc32 
+// of the installed image, then it has a sequence of operations, all little endian:
+//   'C' [len u32] [from u32]           : copies len bytes of the installed image from offset from
+//   'A' [len u32] [from u32] [len bytes]: as 'C' but adds each byte to the copied one (as bsdiff does)
+//   'I' [len u32] [len bytes]          : inserts len bytes
+// UPD_CODEC_DELTA_LZ4 is the same stream compressed in the lz4 format of UPD_CODEC_LZ4. it is decompressed into the 
+// flash above the scratch space, where its matches are read back, and it is applied at CMD_END.
+#define UPD_CODEC_RAW           0
+#define UPD_CODEC_LZ4           1
+#define UPD_CODEC_DELTA         2
+#define UPD_CODEC_DELTA_LZ4     3
+
+// a delta is applied into a scratch space above the application, so that the installed image is used as source and 
+// is changed only when the new one is complete and verified. then only the flash pages which differ are erased and 
+// written. the loader is instead built in ram as for the other codecs.
+#define UPD_DELTA_SCRATCH_ROMADDR   (EENV_MEMMAP_EAPPLICATION_ROMADDR + EENV_MEMMAP_EAPPLICATION_ROMSIZE)
+#define UPD_DELTA_SCRATCH_ROMSIZE   (EENV_MEMMAP_EAPPLICATION_ROMSIZE)
+
+#if     ((UPD_DELTA_SCRATCH_ROMADDR + UPD_DELTA_SCRATCH_ROMSIZE) <= (EENV_ROMSTART + EENV_ROMSIZE - EENV_MEMMAP_SHARSERV_ROMSIZE))
+    #define UPD_DELTA_SCRATCH_ISAVAILABLE
+#endif
+
+// the decompressed stream of UPD_CODEC_DELTA_LZ4 uses the rest of the flash. each page is erased when the stream reaches it
+#define UPD_DELTA_STREAM_ROMADDR    (UPD_DELTA_SCRATCH_ROMADDR + UPD_DELTA_SCRATCH_ROMSIZE)
+#if     defined(UPD_DELTA_SCRATCH_ISAVAILABLE)
+    #define UPD_DELTA_STREAM_ROMSIZE    (EENV_ROMSTART + EENV_ROMSIZE - EENV_MEMMAP_SHARSERV_ROMSIZE - UPD_DELTA_STREAM_ROMADDR)
+#else
+    #define UPD_DELTA_STREAM_ROMSIZE    (0)
+#endif
+
+
 // static functions
 #if     !defined(_MAINTAINER_APPL_)
 static eEresult_t s_sys_eeprom_erase(void);
@@ -190,6 +252,82 @@ static eEresult_t s_sys_eeprom_erase(void);
 
 static uint8_t s_overlapping_with_code_space(uint32_t addr, uint32_t size);
 
+static void s_win_reset(void);
+static uint8_t s_win_is_received(uint16_t seq);
+static void s_win_mark(uint16_t seq);
+static hal_result_t s_staging_put(uint32_t address, uint16_t size, const uint8_t *data);
+static hal_result_t s_staging_flush(void);
+static hal_result_t s_staging_append(uint32_t address, uint8_t byte);
+static hal_result_t s_staging_write(uint32_t address, uint32_t size, const uint8_t *data);
+static hal_result_t s_staging_edge(uint32_t address, uint8_t byte);
+static hal_result_t s_staging_edges_flush(void);
+static hal_result_t s_flash_write(uint32_t address, uint32_t size, const uint8_t *data);
+static uint32_t s_crc32(const uint8_t *data, uint32_t size);
+
+static void s_image_start(uint8_t codec, uint32_t address, uint32_t base, uint32_t capacity, uint32_t size, uint32_t crc, uint8_t toram);
+static uint8_t s_image_is_valid(const uint8_t *image, uint32_t capacity);
+static hal_result_t s_image_decode(const uint8_t *data, uint16_t size);
+static hal_result_t s_image_output(uint8_t byte);
+static hal_result_t s_image_finish(void);
+static hal_result_t s_image_install(uint32_t address);
+static hal_result_t s_lz_decode(const uint8_t *data, uint16_t size);
+static hal_result_t s_lz_copy(void);
+static uint8_t s_lz_match_get(uint32_t position);
+static hal_result_t s_lz_output(uint8_t byte);
+static hal_result_t s_delta_put(uint8_t byte);
+
+
+// status of the windowed download
+static uint16_t s_win_next = 0;             // all the packets with seq lower than s_win_next are received
+static uint32_t s_win_mask = 0;             // bit i is set if packet s_win_next+1+i is received
+
+static uint32_t s_staging_address = 0;
+static uint16_t s_staging_size = 0;
+static uint8_t s_staging_data[UPD_STAGING_SIZE] = {0};
+
+typedef struct
+{
+    uint32_t    address;    // of the half word
+    uint8_t     bytes[2];   // the byte not received yet is 0xFF
+} upd_staging_edge_t;
+
+static upd_staging_edge_t s_staging_edges[UPD_STAGING_EDGES] = {0};
+static uint8_t s_staging_edgesnumber = 0;
+
+// status of the image declared by CMD_START_EXT
+enum { UPD_LZ_TOKEN = 0, UPD_LZ_LITLEN = 1, UPD_LZ_LITERALS = 2, UPD_LZ_OFFSET0 = 3, UPD_LZ_OFFSET1 = 4, UPD_LZ_MATCHLEN = 5 };
+enum { UPD_DELTA_HEADER = 0, UPD_DELTA_OPCODE = 1, UPD_DELTA_ARGS = 2, UPD_DELTA_BYTES = 3 };
+
+static uint8_t  s_image_codec = UPD_CODEC_RAW;
+static uint8_t  s_image_toram = 0;          // the decompressed image goes into s_ramforloader_data
+static uint8_t  s_image_toscratch = 0;      // the image goes into the scratch space and is installed at CMD_END
+static uint8_t  s_image_scratcherased = 0;
+static uint32_t s_image_address = 0;        // where the image is written
+static uint32_t s_image_base = 0;           // where the installed image is
+static uint32_t s_image_capacity = 0;       // size of the memory space
+static uint32_t s_image_size = 0;           // 0 if not declared
+static uint32_t s_image_crc = 0;
+static uint32_t s_image_consumed = 0;       // bytes of the stream
+static uint32_t s_image_produced = 0;       // bytes of the image
+
+static uint8_t  s_lz_state = UPD_LZ_TOKEN;
+static uint32_t s_lz_litlen = 0;
+static uint32_t s_lz_matchlen = 0;
+static uint16_t s_lz_offset = 0;
+static uint32_t s_lz_produced = 0;          // bytes decompressed so far
+static uint32_t s_lz_address = 0;           // where they are written
+
+static uint8_t  s_delta_state = UPD_DELTA_HEADER;
+static uint8_t  s_delta_opcode = 0;
+static uint8_t  s_delta_args[8] = {0};
+static uint8_t  s_delta_argsnumber = 0;
+static uint8_t  s_delta_argsneeded = 0;
+static uint32_t s_delta_basesize = 0;
+static uint32_t s_delta_length = 0;
+static uint32_t s_delta_from = 0;
+static uint32_t s_delta_position = 0;
+
+
 void upd_core_init(void)
 {
 #if     defined(HAL_USE_VERSION_2) || defined(HAL_IS_VERSION_2)
@@ -217,7 +355,7 @@ void upd_core_init(void)
 #define PROGRAM_APP      0x5A
 #define PROGRAM_SHARSERV 0x5B
 
-uint8_t upd_core_manage_cmd(uint8_t *pktin, eOipv4addr_t remaddr, uint8_t *pktout, uint16_t capacityout, uint16_t *sizeout)
+uint8_t upd_core_manage_cmd(uint8_t *pktin, uint16_t sizein, eOipv4addr_t remaddr, uint8_t *pktout, uint16_t capacityout, uint16_t *sizeout)
 {
     static uint32_t s_prog_mem_start = 0xFFFFFFFF;
     static uint32_t s_prog_mem_size  = 0;
@@ -338,6 +476,7 @@ uint8_t upd_core_manage_cmd(uint8_t *pktin, eOipv4addr_t remaddr, uint8_t *pktou
 //             return 1;
 //         }// break;        
 
+        case CMD_START_EXT:
         case CMD_START:
         {
             //hal_trace_puts("CMD_START");
@@ -345,9 +484,11 @@ uint8_t upd_core_manage_cmd(uint8_t *pktin, eOipv4addr_t remaddr, uint8_t *pktou
             s_download_packets = 1;
             s_download_state = pktin[1];
             s_erased_eeprom = 0;
+            s_win_reset();
+            s_image_start(UPD_CODEC_RAW, 0, 0, 0, 0, 0, 0);
             
             *sizeout = 2;
-            pktout[0] = CMD_START;
+            pktout[0] = pktin[POS_OPC];
 
             switch (s_download_state)
             {
@@ -378,6 +519,47 @@ uint8_t upd_core_manage_cmd(uint8_t *pktin, eOipv4addr_t remaddr, uint8_t *pktou
                 } break;                
             }
             
+            if((CMD_START_EXT == pktin[POS_OPC]) && (0 != s_download_state))
+            {
+                uint8_t codec = pktin[2];
+                uint32_t imagesize = pktin[6]<<24 | pktin[5]<<16 | pktin[4]<<8 | pktin[3];
+                uint32_t imagecrc = pktin[10]<<24 | pktin[9]<<16 | pktin[8]<<8 | pktin[7];
+                uint8_t toram = 0;
+                uint8_t isdelta = ((UPD_CODEC_DELTA == codec) || (UPD_CODEC_DELTA_LZ4 == codec)) ? (1) : (0);
+                uint8_t cando = (codec <= UPD_CODEC_DELTA_LZ4) ? (1) : (0);
+#if defined(USERAM_FOR_LOADER) 
+                toram = (PROGRAM_LOADER == s_download_state) ? (1) : (0);
+#endif                
+                
+                if((UPD_CODEC_DELTA_LZ4 == codec) && (0 == UPD_DELTA_STREAM_ROMSIZE))
+                {
+                    cando = 0;
+                }
+                else if((1 == isdelta) && (0 == toram))
+                {   // the delta is applied in the scratch space
+#if defined(UPD_DELTA_SCRATCH_ISAVAILABLE) && !defined(ERASE_EARLY)
+                    cando = (s_prog_mem_size <= UPD_DELTA_SCRATCH_ROMSIZE) ? (1) : (0);
+#else
+                    cando = 0;
+#endif
+                }
+                
+                if((0 == cando) || (0 == imagesize) || (imagesize > s_prog_mem_size))
+                {
+                    s_download_state = 0;
+                    s_prog_mem_start = s_prog_mem_size = 0;
+                    pktout[1] = UPD_ERR_UNK;
+                }
+                else if((1 == isdelta) && (0 == toram))
+                {
+                    s_image_start(codec, UPD_DELTA_SCRATCH_ROMADDR, s_prog_mem_start, s_prog_mem_size, imagesize, imagecrc, 0);
+                }
+                else
+                {
+                    s_image_start(codec, s_prog_mem_start, s_prog_mem_start, s_prog_mem_size, imagesize, imagecrc, toram);
+                }
+            }
+            
             // cannot accept a download of such a hex file
             if(0 == s_download_state)
             {
@@ -464,7 +646,8 @@ uint8_t upd_core_manage_cmd(uint8_t *pktin, eOipv4addr_t remaddr, uint8_t *pktou
             
         case CMD_DATA:
         {
-            if (0 == s_download_state)
+            // a compressed stream can be sent only with CMD_DATAWIN
+            if ((0 == s_download_state) || (UPD_CODEC_RAW != s_image_codec))
             {
                 *sizeout = 2;
                 pktout[0] = CMD_DATA;
@@ -486,8 +669,8 @@ uint8_t upd_core_manage_cmd(uint8_t *pktin, eOipv4addr_t remaddr, uint8_t *pktou
 
             void *data = pktin + 7;
 
-                  
-            if ((address >= s_prog_mem_start) && (address+size < s_prog_mem_start+s_prog_mem_size))
+            // the data must be all inside the received packet
+            if ((7+size <= sizein) && (address >= s_prog_mem_start) && (address+size < s_prog_mem_start+s_prog_mem_size))
             {
                 
 #if !defined(ERASE_EARLY)
@@ -618,6 +801,159 @@ uint8_t upd_core_manage_cmd(uint8_t *pktin, eOipv4addr_t remaddr, uint8_t *pktou
                
             return 1;
         }// break;
+
+        case CMD_DATAWIN:
+        {
+            uint16_t seq = pktin[2]<<8 | pktin[1];
+            
+            uint32_t address = pktin[6]<<24 |
+                               pktin[5]<<16 |
+                               pktin[4]<<8  |
+                               pktin[3];
+
+            uint16_t size = pktin[8]<<8 | pktin[7];
+            
+            uint32_t crc = pktin[12]<<24 |
+                           pktin[11]<<16 |
+                           pktin[10]<<8  |
+                           pktin[9];
+
+            uint8_t *data = pktin + UPD_WIN_HEADERSIZE;
+            uint8_t received = 0;
+            
+            if(capacityout < UPD_WIN_REPLYSIZE)
+            {
+                return 0;
+            }
+
+            *sizeout = UPD_WIN_REPLYSIZE;
+            pktout[0] = CMD_DATAWIN;
+            pktout[1] = UPD_OK;            
+            
+            if(0 == s_download_state)
+            {
+                pktout[1] = UPD_ERR_UNK;
+            }
+            else if(UPD_WIN_HEADERSIZE+size > sizein)
+            {
+                // the header and the data must be all inside the received packet
+                pktout[1] = UPD_ERR_PROT;
+            }
+            else if(0 == (received = s_win_is_received(seq)))
+            {
+                // out of the window: the host must wait for the packets before it
+                pktout[1] = UPD_ERR_LOST;
+            }
+            else if(2 == received)
+            {
+                // already received: we just ack it again
+                pktout[1] = UPD_OK;
+            }
+            else if((UPD_CODEC_RAW != s_image_codec) && (seq != s_win_next))
+            {
+                // the decompression needs the stream in order
+                pktout[1] = UPD_ERR_LOST;
+            }
+            else if((UPD_CODEC_RAW != s_image_codec) && (address != s_prog_mem_start+s_image_consumed))
+            {
+                pktout[1] = UPD_ERR_PROT;
+            }
+            else if((address < s_prog_mem_start) || (address+size > s_prog_mem_start+s_prog_mem_size))
+            {
+                // a chunk may end exactly at the end of the memory space
+                pktout[1] = UPD_ERR_PROT;
+            }
+            else if(crc != s_crc32(data, size))
+            {
+                // corrupted: it is not marked as received, thus the host sends it again
+                pktout[1] = UPD_ERR_PROT;
+            }
+            else
+            {
+#if defined(USERAM_FOR_LOADER) 
+                if((PROGRAM_LOADER == s_download_state) && (UPD_CODEC_RAW != s_image_codec))
+                {
+                    if(hal_res_OK == s_image_decode(data, size))
+                    {
+                        s_win_mark(seq);
+                        ++s_download_packets;
+                    }
+                    else
+                    {
+                        s_download_packets = 0;
+                        pktout[1] = UPD_ERR_PROT;
+                    }
+                }
+                else if((PROGRAM_LOADER == s_download_state) && (address-s_prog_mem_start+size > sizeof(s_ramforloader_data)))
+                {
+                    pktout[1] = UPD_ERR_PROT;
+                }
+                else if(PROGRAM_LOADER == s_download_state)
+                {
+                    uint32_t position = address - s_prog_mem_start;
+                    memcpy(&s_ramforloader_data[position], data, size);
+                    if((position+size)> s_ramforloader_maxoffset)
+                    {
+                        s_ramforloader_maxoffset = position+size;
+                    }
+                    s_win_mark(seq);
+                    ++s_download_packets;
+                }
+                else
+#endif                
+                {
+#if !defined(ERASE_EARLY)
+                    // a delta needs the installed image, which is changed only at CMD_END
+                    if((0 == s_erased_eeprom) && (0 == s_image_toscratch))
+                    {
+                        hal_sys_irq_disable();
+                        halres = hal_flash_erase(s_prog_mem_start, s_prog_mem_size);
+                        hal_sys_irq_enable();
+                        
+                        if(hal_res_OK != halres)
+                        {
+                            s_download_state = 0;
+                            pktout[1] = UPD_ERR_FLASH;    
+                        }
+                        else
+                        {
+                            s_erased_eeprom = s_download_state;
+                        } 
+                    }
+#endif
+                    if((0 != s_erased_eeprom) || (1 == s_image_toscratch))
+                    {
+                        halres = (UPD_CODEC_RAW == s_image_codec) ? s_staging_put(address, size, data) : s_image_decode(data, size);
+                        
+                        if(hal_res_OK == halres)
+                        {
+                            s_win_mark(seq);
+                            ++s_download_packets;
+                        }
+                        else
+                        {
+                            // a failed write of the staged data or a broken stream: the count of packets cannot match 
+                            // anymore, thus CMD_END will report UPD_ERR_LOST and erase the partial image
+                            s_download_packets = 0;
+                            pktout[1] = UPD_ERR_FLASH;
+                        }
+                    }
+                }
+            }
+            
+            pktout[2] = seq & 0xFF;
+            pktout[3] = (seq>>8) & 0xFF;
+            pktout[4] = s_win_next & 0xFF;
+            pktout[5] = (s_win_next>>8) & 0xFF;
+            pktout[6] = s_win_mask & 0xFF;
+            pktout[7] = (s_win_mask>>8) & 0xFF;
+            pktout[8] = (s_win_mask>>16) & 0xFF;
+            pktout[9] = (s_win_mask>>24) & 0xFF;
+            
+            eupdater_parser_download_toggleled();   
+               
+            return 1;
+        }// break;
             
         case CMD_END:
         {
@@ -645,6 +981,38 @@ uint8_t upd_core_manage_cmd(uint8_t *pktin, eOipv4addr_t remaddr, uint8_t *pktou
             *sizeout = 2;
             pktout[0] = CMD_END;
             
+            // the data of CMD_DATAWIN which is still in ram must reach the flash before we check the count
+            if((hal_res_OK != s_staging_flush()) || (hal_res_OK != s_staging_edges_flush()) || (hal_res_OK != s_image_finish()))
+            {
+                s_download_packets = 0;
+            }
+            
+            // an image declared by CMD_START_EXT is marked valid only if it is complete and has the declared crc
+#if defined(USERAM_FOR_LOADER) 
+            if((0 != s_image_size) && (PROGRAM_LOADER == s_download_state))
+            {
+                if(0 == s_image_is_valid(s_ramforloader_data, s_prog_mem_size))
+                {
+                    s_download_packets = 0;
+                }
+            }
+            else
+#endif
+            if((0 != s_image_size) && (0 == s_image_is_valid((const uint8_t*)s_image_address, s_prog_mem_size)))
+            {
+                s_download_packets = 0;
+            }
+            else if(1 == s_image_toscratch)
+            {
+                // the new image is verified in the scratch space, thus we can change the installed one. if anything 
+                // fails from now on, the memory space is erased as after a failed download
+                s_erased_eeprom = s_download_state;
+                if((hal_res_OK != s_image_install(s_prog_mem_start)) || (s_image_crc != s_crc32((const uint8_t*)s_prog_mem_start, s_image_size)))
+                {
+                    s_download_packets = 0;
+                }
+            }
+            
             //char str[64] = {0};            
             uint16_t sentpkts = (pktin[2]<<8)|pktin[1];
             //snprintf(str, sizeof(str), "sent = %d, downloaded = %d", sentpkts, s_download_packets);
@@ -1117,3 +1485,673 @@ static uint8_t s_overlapping_with_code_space(uint32_t addr, uint32_t size)
     
     return(0);
 }
+
+
+static void s_win_reset(void)
+{
+    s_win_next = 0;
+    s_win_mask = 0;
+    s_staging_address = 0;
+    s_staging_size = 0;
+    s_staging_edgesnumber = 0;
+}
+
+// returns 1 if seq is inside the window and not received yet, 2 if it is already received, 0 if it is beyond the window
+static uint8_t s_win_is_received(uint16_t seq)
+{
+    uint16_t distance = seq - s_win_next;
+    
+    if(0 == distance)
+    {
+        return(1);
+    }
+    
+    if(distance >= 0x8000)
+    {   // it is before s_win_next
+        return(2);
+    }
+    
+    if(distance > UPD_WIN_SIZE)
+    {
+        return(0);
+    }
+    
+    return((s_win_mask & (1UL << (distance-1))) ? (2) : (1));
+}
+
+static void s_win_mark(uint16_t seq)
+{
+    uint16_t distance = seq - s_win_next;
+    uint32_t bit0 = 0;
+    
+    if(0 != distance)
+    {
+        s_win_mask |= (1UL << (distance-1));
+        return;
+    }
+    
+    // the window slides beyond seq and beyond all the packets after it which are already received
+    s_win_next++;
+    do
+    {
+        bit0 = s_win_mask & 1;
+        s_win_mask >>= 1;
+        if(0 != bit0)
+        {
+            s_win_next++;
+        }
+    } while(0 != bit0);
+}
+
+static hal_result_t s_staging_put(uint32_t address, uint16_t size, const uint8_t *data)
+{
+    hal_result_t res = hal_res_OK;
+    
+    // a chunk which does not continue the staged data or which does not fit forces a write of what is staged 
+    if((0 != s_staging_size) && ((address != s_staging_address+s_staging_size) || (s_staging_size+size > UPD_STAGING_SIZE)))
+    {
+        res = s_staging_flush();
+        if(hal_res_OK != res)
+        {
+            return(res);
+        }
+    }
+    
+    if(size > UPD_STAGING_SIZE)
+    {
+        return(s_staging_write(address, size, data));
+    }
+    
+    if(0 == s_staging_size)
+    {
+        s_staging_address = address;
+    }
+    
+    memcpy(&s_staging_data[s_staging_size], data, size);
+    s_staging_size += size;
+    
+    if(UPD_STAGING_SIZE == s_staging_size)
+    {
+        res = s_staging_flush();
+    }
+    
+    return(res);
+}
+
+// the bytes of a stream are staged one by one at consecutive addresses
+static hal_result_t s_staging_append(uint32_t address, uint8_t byte)
+{
+    if(0 == s_staging_size)
+    {
+        s_staging_address = address;
+    }
+    
+    s_staging_data[s_staging_size++] = byte;
+    
+    if(UPD_STAGING_SIZE == s_staging_size)
+    {
+        return(s_staging_flush());
+    }
+    
+    return(hal_res_OK);
+}
+
+static hal_result_t s_staging_flush(void)
+{
+    uint16_t size = s_staging_size;
+    
+    s_staging_size = 0;
+    
+    if(0 == size)
+    {
+        return(hal_res_OK);
+    }
+    
+    return(s_staging_write(s_staging_address, size, s_staging_data));
+}
+
+// the first byte of a chunk at an odd address and the last byte of a chunk which ends at an odd address are edges
+static hal_result_t s_staging_write(uint32_t address, uint32_t size, const uint8_t *data)
+{
+    hal_result_t res = hal_res_OK;
+    
+    if((0 != size) && (0 != (address & 1)))
+    {
+        res = s_staging_edge(address, data[0]);
+        address++;
+        data++;
+        size--;
+    }
+    
+    if((hal_res_OK == res) && (0 != (size & 1)))
+    {
+        size--;
+        res = s_staging_edge(address+size, data[size]);
+    }
+    
+    if((hal_res_OK == res) && (0 != size))
+    {
+        res = s_flash_write(address, size, data);
+    }
+    
+    return(res);
+}
+
+static hal_result_t s_staging_edge(uint32_t address, uint8_t byte)
+{
+    uint32_t halfword = address & ~((uint32_t)1);
+    uint8_t bytes[2] = {0xFF, 0xFF};
+    uint8_t i = 0;
+    
+    for(i=0; i<s_staging_edgesnumber; i++)
+    {
+        if(halfword == s_staging_edges[i].address)
+        {   // the other byte is already here: the half word is complete
+            bytes[0] = s_staging_edges[i].bytes[0];
+            bytes[1] = s_staging_edges[i].bytes[1];
+            bytes[address & 1] = byte;
+            s_staging_edges[i] = s_staging_edges[--s_staging_edgesnumber];
+            return(s_flash_write(halfword, 2, bytes));
+        }
+    }
+    
+    if(UPD_STAGING_EDGES == s_staging_edgesnumber)
+    {   // the host has more chunks in flight than the window allows
+        return(hal_res_NOK_generic);
+    }
+    
+    s_staging_edges[s_staging_edgesnumber].address = halfword;
+    s_staging_edges[s_staging_edgesnumber].bytes[0] = 0xFF;
+    s_staging_edges[s_staging_edgesnumber].bytes[1] = 0xFF;
+    s_staging_edges[s_staging_edgesnumber].bytes[address & 1] = byte;
+    s_staging_edgesnumber++;
+    
+    return(hal_res_OK);
+}
+
+// the missing bytes are not part of the image, thus they stay erased
+static hal_result_t s_staging_edges_flush(void)
+{
+    hal_result_t res = hal_res_OK;
+    uint8_t i = 0;
+    
+    for(i=0; (hal_res_OK == res) && (i<s_staging_edgesnumber); i++)
+    {
+        res = s_flash_write(s_staging_edges[i].address, 2, s_staging_edges[i].bytes);
+    }
+    
+    s_staging_edgesnumber = 0;
+    
+    return(res);
+}
+
+// address and size are even. when the address is a multiple of 4, hal_flash_write() of hal2 programs by words and, 
+// if the size is not a multiple of 4, then it programs the last half word at the wrong address: that half word is
+// written alone.
+static hal_result_t s_flash_write(uint32_t address, uint32_t size, const uint8_t *data)
+{
+    hal_result_t res = hal_res_OK;
+    uint32_t tail = ((0 == (address & 3)) && (2 == (size & 3)) && (size > 2)) ? (2) : (0);
+    
+    hal_sys_irq_disable();
+    res = hal_flash_write(address, size-tail, (void*)data);
+    if((hal_res_OK == res) && (0 != tail))
+    {
+        res = hal_flash_write(address+size-tail, tail, (void*)(data+size-tail));
+    }
+    hal_sys_irq_enable();
+    
+    return(res);
+}
+
+// the crc32 of zlib (reflected 0x04C11DB7), computed with a table of 16 entries to keep the rom small
+static uint32_t s_crc32(const uint8_t *data, uint32_t size)
+{
+    static const uint32_t table[16] = 
+    {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    uint32_t crc = 0xFFFFFFFF;
+    uint32_t i = 0;
+    
+    for(i=0; i<size; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    
+    return(crc ^ 0xFFFFFFFF);
+}
+
+static void s_image_start(uint8_t codec, uint32_t address, uint32_t base, uint32_t capacity, uint32_t size, uint32_t crc, uint8_t toram)
+{
+    s_image_codec = codec;
+    s_image_address = address;
+    s_image_base = base;
+    s_image_capacity = capacity;
+    s_image_toram = toram;
+    s_image_toscratch = (address != base) ? (1) : (0);
+    s_image_scratcherased = 0;
+    s_image_size = size;
+    s_image_crc = crc;
+    s_image_consumed = 0;
+    s_image_produced = 0;
+    
+    s_lz_state = UPD_LZ_TOKEN;
+    s_lz_litlen = 0;
+    s_lz_matchlen = 0;
+    s_lz_offset = 0;
+    s_lz_produced = 0;
+    s_lz_address = (UPD_CODEC_DELTA_LZ4 == codec) ? (UPD_DELTA_STREAM_ROMADDR) : (address);
+    
+    s_delta_state = UPD_DELTA_HEADER;
+    s_delta_argsnumber = 0;
+    s_delta_argsneeded = 8;
+    s_delta_basesize = 0;
+}
+
+static uint8_t s_image_is_valid(const uint8_t *image, uint32_t capacity)
+{
+    if(UPD_CODEC_RAW != s_image_codec)
+    {   // the stream must be over
+        if(s_image_produced != s_image_size)
+        {
+            return(0);
+        }
+        // the last sequence of lz4 has only literals
+        if(((UPD_CODEC_LZ4 == s_image_codec) || (UPD_CODEC_DELTA_LZ4 == s_image_codec)) && (UPD_LZ_TOKEN != s_lz_state) && (UPD_LZ_OFFSET0 != s_lz_state))
+        {
+            return(0);
+        }
+        if(((UPD_CODEC_DELTA == s_image_codec) || (UPD_CODEC_DELTA_LZ4 == s_image_codec)) && (UPD_DELTA_OPCODE != s_delta_state))
+        {
+            return(0);
+        }
+    }
+    
+    if(s_image_size > capacity)
+    {
+        return(0);
+    }
+    
+    return((s_image_crc == s_crc32(image, s_image_size)) ? (1) : (0));
+}
+
+static hal_result_t s_image_decode(const uint8_t *data, uint16_t size)
+{
+    hal_result_t res = hal_res_OK;
+    uint16_t i = 0;
+    
+    s_image_consumed += size;
+    
+    if((1 == s_image_toscratch) && (0 == s_image_scratcherased))
+    {
+        hal_sys_irq_disable();
+        res = hal_flash_erase(s_image_address, s_image_size);
+        hal_sys_irq_enable();
+        if(hal_res_OK != res)
+        {
+            return(res);
+        }
+        s_image_scratcherased = 1;
+    }
+    
+    if((UPD_CODEC_LZ4 == s_image_codec) || (UPD_CODEC_DELTA_LZ4 == s_image_codec))
+    {
+        return(s_lz_decode(data, size));
+    }
+    
+    for(i=0; i<size; i++)
+    {
+        if(hal_res_OK != s_delta_put(data[i]))
+        {
+            return(hal_res_NOK_generic);
+        }
+    }
+    
+    return(hal_res_OK);
+}
+
+static hal_result_t s_image_output(uint8_t byte)
+{
+    if(s_image_produced >= s_image_size)
+    {
+        return(hal_res_NOK_generic);
+    }
+    
+#if defined(USERAM_FOR_LOADER) 
+    if(1 == s_image_toram)
+    {
+        s_ramforloader_data[s_image_produced++] = byte;
+        return(hal_res_OK);
+    }
+#endif
+    
+    s_image_produced++;
+    
+    return(s_staging_append(s_image_address + s_image_produced - 1, byte));
+}
+
+// the delta of UPD_CODEC_DELTA_LZ4 is decompressed in flash: it is applied now
+static hal_result_t s_image_finish(void)
+{
+    const uint8_t *stream = (const uint8_t*)UPD_DELTA_STREAM_ROMADDR;
+    hal_result_t res = hal_res_OK;
+    uint32_t i = 0;
+    
+    if(UPD_CODEC_DELTA_LZ4 != s_image_codec)
+    {
+        return(hal_res_OK);
+    }
+    
+    for(i=0; (hal_res_OK == res) && (i<s_lz_produced); i++)
+    {
+        res = s_delta_put(stream[i]);
+    }
+    
+    if(hal_res_OK == res)
+    {
+        res = s_staging_flush();
+    }
+    
+    return((hal_res_OK == res) ? (s_staging_edges_flush()) : (res));
+}
+
+// copies the image from the scratch space to its memory space. the pages which already have the same content are 
+// neither erased nor written
+static hal_result_t s_image_install(uint32_t address)
+{
+    hal_result_t res = hal_res_OK;
+    uint32_t offset = 0;
+    uint32_t pageaddr = 0;
+    uint32_t inpage = 0;
+    uint32_t done = 0;
+    uint32_t n = 0;
+    
+    while(offset < s_image_size)
+    {
+        pageaddr = hal_flash_get_pageaddr(address+offset);
+        inpage = pageaddr + hal_flash_get_pagesize(address+offset) - (address+offset);
+        if(inpage > (s_image_size - offset))
+        {
+            inpage = s_image_size - offset;
+        }
+        
+        if((0 == offset) && (pageaddr != address))
+        {   // we would erase what is before the memory space
+            return(hal_res_NOK_generic);
+        }
+        
+        if(0 != memcmp((const void*)(address+offset), (const void*)(s_image_address+offset), inpage))
+        {
+            hal_sys_irq_disable();
+            res = hal_flash_erase(pageaddr, inpage);
+            hal_sys_irq_enable();
+            
+            // the page is written in chunks, so that the interrupts are not disabled for too long
+            for(done=0; (hal_res_OK == res) && (done < inpage); done += n)
+            {
+                n = ((inpage - done) > UPD_STAGING_SIZE) ? (UPD_STAGING_SIZE) : (inpage - done);
+                memcpy(s_staging_data, (const void*)(s_image_address+offset+done), n);
+                s_staging_address = address+offset+done;
+                s_staging_size = n;
+                res = s_staging_flush();
+            }
+            
+            if(hal_res_OK != res)
+            {
+                return(res);
+            }
+        }
+        
+        offset += inpage;
+    }
+    
+    // the last byte of an image of odd size
+    return(s_staging_edges_flush());
+}
+
+static hal_result_t s_lz_decode(const uint8_t *data, uint16_t size)
+{
+    uint16_t i = 0;
+    uint8_t byte = 0;
+    
+    for(i=0; i<size; i++)
+    {
+        byte = data[i];
+        
+        switch(s_lz_state)
+        {
+            case UPD_LZ_TOKEN:
+            {
+                s_lz_litlen = byte >> 4;
+                s_lz_matchlen = byte & 0x0F;
+                s_lz_state = (15 == s_lz_litlen) ? (UPD_LZ_LITLEN) : ((0 == s_lz_litlen) ? (UPD_LZ_OFFSET0) : (UPD_LZ_LITERALS));
+            } break;
+            
+            case UPD_LZ_LITLEN:
+            {
+                s_lz_litlen += byte;
+                if(255 != byte)
+                {
+                    s_lz_state = UPD_LZ_LITERALS;
+                }
+            } break;
+            
+            case UPD_LZ_LITERALS:
+            {
+                if(hal_res_OK != s_lz_output(byte))
+                {
+                    return(hal_res_NOK_generic);
+                }
+                if(0 == --s_lz_litlen)
+                {
+                    s_lz_state = UPD_LZ_OFFSET0;
+                }
+            } break;
+            
+            case UPD_LZ_OFFSET0:
+            {
+                s_lz_offset = byte;
+                s_lz_state = UPD_LZ_OFFSET1;
+            } break;
+            
+            case UPD_LZ_OFFSET1:
+            {
+                s_lz_offset |= ((uint16_t)byte) << 8;
+                if((0 == s_lz_offset) || (s_lz_offset > s_lz_produced))
+                {
+                    return(hal_res_NOK_generic);
+                }
+                if(15 == s_lz_matchlen)
+                {
+                    s_lz_state = UPD_LZ_MATCHLEN;
+                }
+                else if(hal_res_OK != s_lz_copy())
+                {
+                    return(hal_res_NOK_generic);
+                }
+            } break;
+            
+            case UPD_LZ_MATCHLEN:
+            {
+                s_lz_matchlen += byte;
+                if((255 != byte) && (hal_res_OK != s_lz_copy()))
+                {
+                    return(hal_res_NOK_generic);
+                }
+            } break;
+            
+            default:
+            {
+                return(hal_res_NOK_generic);
+            } 
+        }
+    }
+    
+    return(hal_res_OK);
+}
+
+static hal_result_t s_lz_copy(void)
+{
+    // the minimum length of a match is 4. the match can overlap the bytes it produces
+    uint32_t n = 0;
+    
+    s_lz_state = UPD_LZ_TOKEN;
+    
+    for(n=0; n<s_lz_matchlen+4; n++)
+    {
+        if(hal_res_OK != s_lz_output(s_lz_match_get(s_lz_produced - s_lz_offset)))
+        {
+            return(hal_res_NOK_generic);
+        }
+    }
+    
+    return(hal_res_OK);
+}
+
+// the bytes already produced are in the flash or, the last ones, still in the staging
+static uint8_t s_lz_match_get(uint32_t position)
+{
+    uint32_t address = s_lz_address + position;
+    
+#if defined(USERAM_FOR_LOADER) 
+    if((1 == s_image_toram) && (UPD_CODEC_LZ4 == s_image_codec))
+    {
+        return(s_ramforloader_data[position]);
+    }
+#endif
+    
+    if((address >= s_staging_address) && ((address - s_staging_address) < s_staging_size))
+    {
+        return(s_staging_data[address - s_staging_address]);
+    }
+    
+    return(*((const uint8_t*)address));
+}
+
+static hal_result_t s_lz_output(uint8_t byte)
+{
+    uint32_t address = s_lz_address + s_lz_produced;
+    hal_result_t res = hal_res_OK;
+    
+    if(UPD_CODEC_LZ4 == s_image_codec)
+    {
+        s_lz_produced++;
+        return(s_image_output(byte));
+    }
+    
+    if(s_lz_produced >= UPD_DELTA_STREAM_ROMSIZE)
+    {
+        return(hal_res_NOK_generic);
+    }
+    
+    if(address == hal_flash_get_pageaddr(address))
+    {
+        hal_sys_irq_disable();
+        res = hal_flash_erase(address, 1);
+        hal_sys_irq_enable();
+        if(hal_res_OK != res)
+        {
+            return(res);
+        }
+    }
+    
+    s_lz_produced++;
+    
+    return(s_staging_append(address, byte));
+}
+
+static hal_result_t s_delta_put(uint8_t byte)
+{
+    const uint8_t *base = (const uint8_t*)s_image_base;
+    uint32_t i = 0;
+    
+    switch(s_delta_state)
+    {
+        case UPD_DELTA_HEADER:
+        case UPD_DELTA_ARGS:
+        {
+            s_delta_args[s_delta_argsnumber++] = byte;
+            if(s_delta_argsnumber < s_delta_argsneeded)
+            {
+                return(hal_res_OK);
+            }
+            
+            s_delta_length = s_delta_args[3]<<24 | s_delta_args[2]<<16 | s_delta_args[1]<<8 | s_delta_args[0];
+            s_delta_from = s_delta_args[7]<<24 | s_delta_args[6]<<16 | s_delta_args[5]<<8 | s_delta_args[4];
+            s_delta_position = 0;
+            
+            if(UPD_DELTA_HEADER == s_delta_state)
+            {   // the delta must have been built against the installed image
+                s_delta_basesize = s_delta_length;
+                if((s_delta_basesize > s_image_capacity) || (s_delta_from != s_crc32(base, s_delta_basesize)))
+                {
+                    return(hal_res_NOK_generic);
+                }
+                s_delta_state = UPD_DELTA_OPCODE;
+                return(hal_res_OK);
+            }
+            
+            if((0 == s_delta_length) || (('I' != s_delta_opcode) && ((s_delta_from > s_delta_basesize) || (s_delta_length > (s_delta_basesize - s_delta_from)))))
+            {
+                return(hal_res_NOK_generic);
+            }
+            
+            if('C' == s_delta_opcode)
+            {
+                for(i=0; i<s_delta_length; i++)
+                {
+                    if(hal_res_OK != s_image_output(base[s_delta_from+i]))
+                    {
+                        return(hal_res_NOK_generic);
+                    }
+                }
+                s_delta_state = UPD_DELTA_OPCODE;
+            }
+            else
+            {
+                s_delta_state = UPD_DELTA_BYTES;
+            }
+        } break;
+        
+        case UPD_DELTA_OPCODE:
+        {
+            s_delta_opcode = byte;
+            s_delta_argsnumber = 0;
+            s_delta_argsneeded = ('I' == byte) ? (4) : (8);
+            s_delta_args[4] = s_delta_args[5] = s_delta_args[6] = s_delta_args[7] = 0;
+            if(('C' != byte) && ('A' != byte) && ('I' != byte))
+            {
+                return(hal_res_NOK_generic);
+            }
+            s_delta_state = UPD_DELTA_ARGS;
+        } break;
+        
+        case UPD_DELTA_BYTES:
+        {
+            if('A' == s_delta_opcode)
+            {
+                byte += base[s_delta_from + s_delta_position];
+            }
+            if(hal_res_OK != s_image_output(byte))
+            {
+                return(hal_res_NOK_generic);
+            }
+            if(++s_delta_position == s_delta_length)
+            {
+                s_delta_state = UPD_DELTA_OPCODE;
+            }
+        } break;
+        
+        default:
+        {
+            return(hal_res_NOK_generic);
+        }
+    }
+    
+    return(hal_res_OK);
+}
+
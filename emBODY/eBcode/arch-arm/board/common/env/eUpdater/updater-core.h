@@ -23,6 +23,6 @@
 #include "stdint.h"
 
 extern void upd_core_init(void);
-extern uint8_t upd_core_manage_cmd(uint8_t *pktin, eOipv4addr_t remaddr, uint8_t *pktout, uint16_t capacityout, uint16_t *sizeout);
+extern uint8_t upd_core_manage_cmd(uint8_t *pktin, uint16_t sizein, eOipv4addr_t remaddr, uint8_t *pktout, uint16_t capacityout, uint16_t *sizeout);
 
 #endif
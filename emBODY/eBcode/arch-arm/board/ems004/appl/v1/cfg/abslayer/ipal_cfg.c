@@ -150,7 +150,9 @@ const ipal_cfg_t ipal_cfg =
         .usr_tnet_exec              = NULL,
         .usr_tnet_login_msg         = NULL,              
         .usr_tnet_welcome_msg       = NULL,
-        .usr_tnet_prompt            = NULL
+        .usr_tnet_prompt            = NULL,
+
+        .hal_eth_rxrefill           = (ipal_result_t (*)(void))  hal_eth_rx_refill
 
     } 
 };
@@ -159,6 +161,15 @@ const ipal_cfg_t ipal_cfg =
 const ipal_cfg_t *ipal_cfgMINE = &ipal_cfg;
 
 
+// the prebuilt hal2 libraries in hal2/lib were built before hal_eth_rx_refill() was added to hal2, thus this weak 
+// version keeps the application linkable with them. their ETH isr copies every frame, thus it does not need spares.
+// when the libraries are rebuilt with the new hal_eth.c, armlink takes the version in the library.
+__weak extern hal_result_t hal_eth_rx_refill(void)
+{
+    return(hal_res_NOK_unsupported);
+}
+
+
 
 static void onethframerx(void)
 {
@@ -58,9 +58,9 @@
 #endif
 
 //   <o> Memory Pool size [Bytes]      <1500-32000:4>
-//   <i> It keeps buffers for IP transmission.
+//   <i> It keeps buffers for IP transmission and also the frames used by the ETH DMA for zero-copy reception
 #ifndef IPAL_MEMPOOLSIZE
- #define IPAL_MEMPOOLSIZE      6144
+ #define IPAL_MEMPOOLSIZE      18432
 #endif
 
 // </h>System
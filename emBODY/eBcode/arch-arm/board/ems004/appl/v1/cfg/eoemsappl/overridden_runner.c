@@ -51,6 +51,12 @@
 
 #include "eventviewer.h"
 
+#include "osal_system.h"
+#include "EOMtheEMSapplCfg.h"
+#include "EOtheRunnerProfiler.h"
+#include "EoProtocolMN.h"
+#include "hal_mpu.h"
+
 #include <stdio.h>
 #include <string.h>
 
@@ -76,6 +82,18 @@
 #define SET_DESIRED_CURR_IN_ONLY_ONE_MSG
 #define runner_timeout_send_diagnostics         1000
 #define runner_countmax_check_ethlink_status    5000 //every one second
+#define runner_timeout_encoders_reading         150 // usec
+
+// if defined, the execution times of RX, DO, TX and of the whole cycle are kept by EOtheRunnerProfiler inside the nv 
+// mn-appl-runnerprofiler, which the host reads and clears. it needs eoprot_tag_mn_appl_runnerprofiler (of type 
+// eOrunnerprofiler_statistics_t) in the EoProtocolMN.h of icub-firmware-shared
+//#define USE_RUNNER_PROFILER
+
+// if defined, the begin and end of RX, DO, TX are recorded in the binary trace of the eventviewer together with the 
+// task switches. the trace is read with eventviewer_trace_dump() and decoded with eventviewer/tools/eventviewer-decode.c
+// the task switches are there only if oosiit is built with OOSIIT_USE_EVENTVIEWER_TRACE
+//#define USE_RUNNER_TRACE
+#define runner_trace_capacity                   512 // items of 8 bytes. it must be a power of two
 
 #define COUNT_WATCHDOG_VIRTUALSTRAIN_MAX        10
 #define COUNT_BETWEEN_TWO_UPDATES_MAx           200 /* equal to timeout in mc4 before mc4 considers useless strain values
@@ -152,6 +170,14 @@ static eOresult_t s_eom_emsrunner_hid_SetCurrentsetpoint_inOneMsgOnly(EOtheEMSap
 EO_static_inline  eOresult_t s_eom_emsrunner_hid_SetCurrentsetpoint(EOtheEMSapplBody *p, int16_t *pwmList, uint8_t size);
 static void s_checkEthLinks(void);
 
+#if defined(USE_RUNNER_PROFILER)
+static void s_eom_emsrunner_profiler_init(void);
+#endif
+
+#if defined(USE_RUNNER_TRACE)
+static void s_eom_emsrunner_trace_init(void);
+#endif
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of static variables
@@ -164,6 +190,10 @@ static uint8_t count_between_two_updates = 0;
 #if defined(EVIEWER_ENABLED) 
 static uint8_t event_view = 0;
 #endif 
+#if defined(USE_RUNNER_TRACE)
+static evTraceItem_t s_eom_emsrunner_trace_ring[runner_trace_capacity];
+static uint16_t s_eom_emsrunner_trace_cycle = 0;
+#endif
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern public functions
 // --------------------------------------------------------------------------------------------------------------------
@@ -182,8 +212,23 @@ extern void eom_emsrunner_hid_userdef_taskRX_activity_beforedatagramreception(EO
     if(1 == count)
     {
         eo_emsapplBody_SignalDetectedCANboards(eo_emsapplBody_GetHandle());
+        #if defined(USE_RUNNER_PROFILER)
+        s_eom_emsrunner_profiler_init();
+        #endif
+        #if defined(USE_RUNNER_TRACE)
+        s_eom_emsrunner_trace_init();
+        #endif
     }
     
+    #if defined(USE_RUNNER_PROFILER)
+    eo_runnerprofiler_Start(eo_runnerprofiler_GetHandle(), eo_runnerprofiler_phase_cycle);
+    eo_runnerprofiler_Start(eo_runnerprofiler_GetHandle(), eo_runnerprofiler_phase_rx);
+    #endif
+    #if defined(USE_RUNNER_TRACE)
+    s_eom_emsrunner_trace_cycle = (uint16_t)count;
+    eventviewer_trace_put(ev_TRACE_ID_runner_rx_begin, s_eom_emsrunner_trace_cycle);
+    #endif
+    
     /*    
     eOmn_appl_runMode_t runmode =  eo_emsapplBody_GetAppRunMode(eo_emsapplBody_GetHandle());
     if(applrunMode__2foc == runmode)
@@ -245,6 +290,13 @@ extern void eom_emsrunner_hid_userdef_taskRX_activity_afterdatagramreception(EOM
         // step 2: read the can frames. this function also parses them and triggers associated action ...
         eo_appCanSP_read(cansp, (eOcanport_t)port, numofRXcanframe, NULL); 
     }
+    
+    #if defined(USE_RUNNER_PROFILER)
+    eo_runnerprofiler_Stop(eo_runnerprofiler_GetHandle(), eo_runnerprofiler_phase_rx);
+    #endif
+    #if defined(USE_RUNNER_TRACE)
+    eventviewer_trace_put(ev_TRACE_ID_runner_rx_end, s_eom_emsrunner_trace_cycle);
+    #endif
 }
 
 
@@ -256,6 +308,12 @@ extern void eom_emsrunner_hid_userdef_taskDO_activity(EOMtheEMSrunner *p)
     EOtheEMSapplBody* emsappbody_ptr = eo_emsapplBody_GetHandle();
     eOmn_appl_runMode_t runmode = eo_emsapplBody_GetAppRunMode(emsappbody_ptr);
 
+    #if defined(USE_RUNNER_PROFILER)
+    eo_runnerprofiler_Start(eo_runnerprofiler_GetHandle(), eo_runnerprofiler_phase_do);
+    #endif
+    #if defined(USE_RUNNER_TRACE)
+    eventviewer_trace_put(ev_TRACE_ID_runner_do_begin, s_eom_emsrunner_trace_cycle);
+    #endif
     /* TAG_ALE */
 //     if(applrunMode__skinAndMc4 == runmode)
 //     {
@@ -284,15 +342,20 @@ extern void eom_emsrunner_hid_userdef_taskDO_activity(EOMtheEMSrunner *p)
         
         case applrunMode__skinOnly:
         {
-            return; //currently nothing to do 
-        }//break;
+            //currently nothing to do 
+        } break;
         
         default:
         {
-            return;
-        }
+        } break;
     };
   
+    #if defined(USE_RUNNER_PROFILER)
+    eo_runnerprofiler_Stop(eo_runnerprofiler_GetHandle(), eo_runnerprofiler_phase_do);
+    #endif
+    #if defined(USE_RUNNER_TRACE)
+    eventviewer_trace_put(ev_TRACE_ID_runner_do_end, s_eom_emsrunner_trace_cycle);
+    #endif
 }
 
 
@@ -302,6 +365,13 @@ extern void eom_emsrunner_hid_userdef_taskTX_activity_beforedatagramtransmission
     uint8_t numofframes2betransmitted_can1 = 0;
     uint8_t numofframes2betransmitted_can2 = 0;
     
+    #if defined(USE_RUNNER_PROFILER)
+    eo_runnerprofiler_Start(eo_runnerprofiler_GetHandle(), eo_runnerprofiler_phase_tx);
+    #endif
+    #if defined(USE_RUNNER_TRACE)
+    eventviewer_trace_put(ev_TRACE_ID_runner_tx_begin, s_eom_emsrunner_trace_cycle);
+    #endif
+    
     // i enable transmission on both can buses. functions are not blocking as the transmission is done by the ISRs
     eo_appCanSP_starttransmit_XXX(eo_emsapplBody_GetCanServiceHandle(emsappbody_ptr), eOcanport1, &numofframes2betransmitted_can1);
     eo_appCanSP_starttransmit_XXX(eo_emsapplBody_GetCanServiceHandle(emsappbody_ptr), eOcanport2, &numofframes2betransmitted_can2);
@@ -346,6 +416,13 @@ extern void eom_emsrunner_hid_userdef_taskTX_activity_afterdatagramtransmission(
         //eo_theEMSdgn_Signalerror(eo_theEMSdgn_GetHandle(), eodgn_nvidbdoor_emsapplcommon , runner_timeout_send_diagnostics);
     }
     
+    #if defined(USE_RUNNER_PROFILER)
+    eo_runnerprofiler_Stop(eo_runnerprofiler_GetHandle(), eo_runnerprofiler_phase_tx);
+    eo_runnerprofiler_Stop(eo_runnerprofiler_GetHandle(), eo_runnerprofiler_phase_cycle);
+    #endif
+    #if defined(USE_RUNNER_TRACE)
+    eventviewer_trace_put(ev_TRACE_ID_runner_tx_end, s_eom_emsrunner_trace_cycle);
+    #endif
 }
 
 
@@ -512,36 +589,11 @@ static void s_eom_emsrunner_hid_userdef_taskDO_activity_2foc(EOMtheEMSrunner *p)
 
     uint16_t numofjoint = eo_appTheDB_GetNumberOfConnectedJoints(eo_appTheDB_GetHandle());
     
-    //uint64_t start_read = osal_system_abstime_get();
-    //uint64_t enc1_delta = start_read - eo_appEncReader_startSPI1(app_enc_reader);
-    //uint64_t stop_read = 0;
-    
-    uint8_t spi1 = 0, spi3 = 0;
-    
-    for(uint8_t i=0; i<30; ++i)
-    {
-        if (eo_appEncReader_isReady(app_enc_reader))
-        {
-            //stop_read = osal_system_abstime_get();
-            break;
-        }
-        else
-        {
-            if (!eo_appEncReader_isReadySPI1(app_enc_reader)) ++spi1;
-            if (!eo_appEncReader_isReadySPI3(app_enc_reader)) ++spi3;
-            hal_sys_delay(5);
-        }
-    }
-    
-    /*
-    static char msg[31];
+    // the check of the eth links does not need the encoders, thus it is done while their reading may still go on
+    s_checkEthLinks();
     
-    if (spi1 || spi3)
-    {
-        snprintf(msg,sizeof(msg),"ENC TOUT %d %d",spi1,spi3);
-        send_diagnostics_to_server(msg, 0xffffffff, 1);        
-    }
-    */
+    // the end of the reading is signalled by the isr of the last encoder of each chain: we dont wait any longer than that 
+    eo_appEncReader_WaitReady(app_enc_reader, runner_timeout_encoders_reading);
     
     if (eo_appEncReader_isReady(eo_emsapplBody_GetEncoderReaderHandle(emsappbody_ptr)))
     {    
@@ -578,8 +630,6 @@ static void s_eom_emsrunner_hid_userdef_taskDO_activity_2foc(EOMtheEMSrunner *p)
 
     /*Note: motor status is updated with data sent by 2foc by can */
 
-    s_checkEthLinks();
-
 }
 
 
@@ -852,6 +902,46 @@ static void s_checkEthLinks(void)
 }
 
 
+#if defined(USE_RUNNER_PROFILER)
+static void s_eom_emsrunner_profiler_init(void)
+{
+    EOMtheEMSapplCfg* emscfg = eom_emsapplcfg_GetHandle();
+    eOrunnerprofiler_cfg_t config = {0};
+    
+    // the budgets are the same windows of the runner as those given in the mn-appl-status
+    config.nanotime_get                                 = osal_system_nanotime_get;
+    config.budgets[eo_runnerprofiler_phase_rx]          = emscfg->runobjcfg.execDOafter;
+    config.budgets[eo_runnerprofiler_phase_do]          = emscfg->runobjcfg.execTXafter - emscfg->runobjcfg.execDOafter;
+    config.budgets[eo_runnerprofiler_phase_tx]          = emscfg->runobjcfg.period - emscfg->runobjcfg.execTXafter;
+    config.budgets[eo_runnerprofiler_phase_cycle]       = emscfg->runobjcfg.period;
+    // if the nv is not in the protocol, the profiler keeps the statistics in its own memory
+    eOprotID32_t id32 = eoprot_ID_get(eoprot_endpoint_management, eoprot_entity_mn_appl, 0, eoprot_tag_mn_appl_runnerprofiler);
+    config.statistics = (eOrunnerprofiler_statistics_t*)eoprot_variable_ramof_get(eoprot_board_localboard, id32);
+    
+    eo_runnerprofiler_Initialise(&config);
+}
+#endif
+
+
+#if defined(USE_RUNNER_TRACE)
+static void s_eom_emsrunner_trace_init(void)
+{
+    evTraceCfg_t config = {0};
+    
+    // the timestamp is the cycle counter of the cpu
+    config.ring             = s_eom_emsrunner_trace_ring;
+    config.capacity         = runner_trace_capacity;
+    config.timestamp        = NULL;
+    config.tickspersecond   = hal_mpu_speed_get(hal_mpu_speedtype_cpu);
+    
+    if(ev_res_OK == eventviewer_trace_init(&config))
+    {
+        eventviewer_trace_enable(1);
+    }
+}
+#endif
+
+
 // marco.accame: commented it out on nov 26 2014 because it is not used and the compiler complains
 //static void s_eom_emsrunner_hid_read_can_messages(eOcanport_t port, eObool_t all, uint8_t max)
 //{
@@ -46,6 +46,8 @@
 
 #include "EoError.h"
 
+#include "EOtheRunnerProfiler.h"
+
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of extern public interface
 // --------------------------------------------------------------------------------------------------------------------
@@ -325,6 +327,31 @@ extern void eoprot_fun_UPDT_mn_appl_config_txratedivider(const EOnv* nv, const e
 }
 
 
+// the nv mn-appl-runnerprofiler keeps the eOrunnerprofiler_statistics_t of EOtheRunnerProfiler, which writes them
+// directly into its ram when overridden_runner.c is built with USE_RUNNER_PROFILER.
+extern void eoprot_fun_INIT_mn_appl_runnerprofiler(const EOnv* nv)
+{
+    eOrunnerprofiler_statistics_t statistics = {0};
+    
+    eo_nv_Set(nv, &statistics, eobool_true, eo_nv_upd_dontdo);
+}
+
+
+// a set<> from the host clears the statistics, whatever value it carries
+extern void eoprot_fun_UPDT_mn_appl_runnerprofiler(const EOnv* nv, const eOropdescriptor_t* rd)
+{
+    if(eobool_false == eo_nv_hid_isLocal(nv))
+    {
+        return;
+    }
+    
+    if(eores_OK != eo_runnerprofiler_Reset(eo_runnerprofiler_GetHandle()))
+    {   // the profiler is not running: we just clear the nv
+        memset(nv->ram, 0, sizeof(eOrunnerprofiler_statistics_t));
+    }
+}
+
+
 extern void eoprot_fun_UPDT_mn_appl_cmmnds_go2state(const EOnv* nv, const eOropdescriptor_t* rd) 
 {
     eOmn_appl_state_t *go2state = (eOmn_appl_state_t *)nv->ram;
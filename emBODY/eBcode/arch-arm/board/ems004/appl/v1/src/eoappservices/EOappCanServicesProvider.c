@@ -51,6 +51,7 @@
 #include "EOtheMemoryPool.h"
 #include "EOtheErrorManager.h"
 #include "EoError.h"
+#include "EOarray.h"
 
 //embobj-icub
 #include "EOicubCanProto.h"
@@ -71,6 +72,7 @@
 #include "osal.h"
 
 #include "EoProtocol.h"
+#include "EOMtheEMSappl.h"
 
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of extern public interface
@@ -92,6 +94,10 @@
 
 #define eoappCanSP_timeoutsenddiagnostics           1000
 #define eoappCanSP_onEvtMode_timeoutSendFrame       2000
+
+// the skin frames are the ones of class ICUBCANPROTO_CLASS_PERIODIC_SKIN, which is in bits 10-8 of the id
+#define EOAPPCANSP_SKINFRAME_MASK                   0x0700
+#define EOAPPCANSP_SKINFRAME_VALUE                  (ICUBCANPROTO_CLASS_PERIODIC_SKIN << 8)
 //#define eoappCanSP_onDemandMode_timeoutSendFrame    17000
 
 
@@ -146,6 +152,10 @@ static void s_eo_appCanSP_callbackOnErr_portx(void *arg, eOcanport_t port);
 static void s_eo_appCanSP_updateDiagnosticValues(EOappCanSP *p, eOcanport_t port);
 static void s_eo_appCanSP_clearDiagnosticValues(EOappCanSP *p, eOcanport_t port);
 
+static EOarray* s_eo_appCanSP_skinfastpath_array_get(EOappCanSP *p, eOcanport_t canport, eObool_t *isactive);
+static uint8_t s_eo_appCanSP_skinfastpath_flush(EOarray *array, const eOsk_candata_t *run, uint8_t numofframes);
+static void s_eo_appCanSP_skinfastpath_overflow(EOappCanSP *p, eOcanport_t canport, uint16_t lost);
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of static variables
@@ -250,6 +260,8 @@ extern EOappCanSP* eo_appCanSP_New(eOappCanSP_cfg_t *cfg)
     }
     
     
+    memset(retptr->skinfastpath, 0, sizeof(retptr->skinfastpath));
+    
     retptr->run_data.isrunning = 0;
     
     
@@ -465,43 +477,95 @@ extern eOresult_t eo_appCanSP_read(EOappCanSP *p, eOcanport_t canport, uint8_t n
 {
     eOresult_t          res = eores_NOK_generic;
     hal_result_t        halres = hal_res_NOK_nodata;
-    hal_can_frame_t     canframe = {0};
+    hal_can_frame_t     *canframe = NULL;
     uint8_t             i;
+    uint8_t             batchsize = 0;
+    uint8_t             batchread = 0;
     uint8_t readcanframes = 0;
+    EOarray             *skinarray = NULL;
+    eObool_t            skinfastpath = eobool_false;
+    uint8_t             skinrunsize = 0;
+    uint16_t            skinlost = 0;
     
 
     if(NULL == p)
     {
         return(eores_NOK_nullpointer);
     }
+    
+    // if there is a skin on this port its frames do not go through the parser
+    skinarray = s_eo_appCanSP_skinfastpath_array_get(p, canport, &skinfastpath);
 
-    for(i=0; i<numofcanframe ; i++)
+    // the frames are drained from the hal fifo in batches, each one inside a single critical section, and then parsed
+    while(readcanframes < numofcanframe)
     {
-        memset(&canframe, 0, sizeof(hal_can_frame_t));
+        batchsize = numofcanframe - readcanframes;
+        if(batchsize > EOAPPCANSP_RXBATCH_MAXFRAMES)
+        {
+            batchsize = EOAPPCANSP_RXBATCH_MAXFRAMES;
+        }
         
-        halres = hal_can_get((hal_can_port_t)canport, &canframe, NULL);
+        batchread = 0;
+        halres = hal_can_get_many((hal_can_port_t)canport, p->rxbatch, batchsize, &batchread);
         if(hal_res_OK != halres)
         {
             break;      // marco.accame on 12 jan 2015: changed the original continue in a break because:
                         // if we have a NOK then we cannot go on because the fifo is surely empty.                     
         }
 
-        readcanframes ++;
-                      
-        res = eo_icubCanProto_ParseCanFrame(p->icubCanProto_ptr, (eOcanframe_t*)&canframe, (eOcanport_t)canport);
-
-        if(eores_OK != res) 
-        {  
-            eOerrmanDescriptor_t errdes = {0};
-            errdes.code                 = eoerror_code_get(eoerror_category_System, eoerror_value_SYS_canservices_parsingfailure);
-            errdes.par16                = (canframe.id & 0x0fff) | ((canframe.size & 0x000f) << 12);
-            errdes.par64                = eo_common_canframe_data2u64((eOcanframe_t*)&canframe);
-            errdes.sourcedevice         = (eOcanport1 == canport) ? (eo_errman_sourcedevice_canbus1) : (eo_errman_sourcedevice_canbus2);
-            errdes.sourceaddress        = eo_icubCanProto_hid_getSourceBoardAddrFromFrameId(canframe.id);                
-            eo_errman_Error(eo_errman_GetHandle(), eo_errortype_warning, NULL, s_eobj_ownname, &errdes);             
+        readcanframes += batchread;
+        
+        for(i=0; i<batchread; i++)
+        {
+            canframe = &p->rxbatch[i];
+            
+            if((eobool_true == skinfastpath) && (EOAPPCANSP_SKINFRAME_VALUE == (canframe->id & EOAPPCANSP_SKINFRAME_MASK)))
+            {
+                if(NULL != skinarray)
+                {   // the frame is added to the run, which is copied into the arrayofcandata when full or at the end 
+                    p->skinrun[skinrunsize].info = EOSK_CANDATA_INFO(canframe->size, canframe->id);
+                    memcpy(p->skinrun[skinrunsize].data, canframe->data, sizeof(p->skinrun[skinrunsize].data));
+                    skinrunsize ++;
+                    if(EOAPPCANSP_SKINRUN_MAXFRAMES == skinrunsize)
+                    {
+                        skinlost += s_eo_appCanSP_skinfastpath_flush(skinarray, p->skinrun, skinrunsize);
+                        skinrunsize = 0;
+                    }
+                }
+                // else the frame is not signalled: it is dropped as eo_icubCanProto_parser_per_sk_cmd__allSkinMsg() would do
+                continue;
+            }
+                          
+            res = eo_icubCanProto_ParseCanFrame(p->icubCanProto_ptr, (eOcanframe_t*)canframe, (eOcanport_t)canport);
+
+            if(eores_OK != res) 
+            {  
+                eOerrmanDescriptor_t errdes = {0};
+                errdes.code                 = eoerror_code_get(eoerror_category_System, eoerror_value_SYS_canservices_parsingfailure);
+                errdes.par16                = (canframe->id & 0x0fff) | ((canframe->size & 0x000f) << 12);
+                errdes.par64                = eo_common_canframe_data2u64((eOcanframe_t*)canframe);
+                errdes.sourcedevice         = (eOcanport1 == canport) ? (eo_errman_sourcedevice_canbus1) : (eo_errman_sourcedevice_canbus2);
+                errdes.sourceaddress        = eo_icubCanProto_hid_getSourceBoardAddrFromFrameId(canframe->id);                
+                eo_errman_Error(eo_errman_GetHandle(), eo_errortype_warning, NULL, s_eobj_ownname, &errdes);             
+            }
+        }
+        
+        if(batchread < batchsize)
+        {   // the fifo is now empty
+            break;
         }
     }
     
+    if(0 != skinrunsize)
+    {
+        skinlost += s_eo_appCanSP_skinfastpath_flush(skinarray, p->skinrun, skinrunsize);
+    }
+    
+    if(0 != skinlost)
+    {
+        s_eo_appCanSP_skinfastpath_overflow(p, canport, skinlost);
+    }
+    
     if(NULL != numofreadcanframes)
     {
         *numofreadcanframes = readcanframes;    
@@ -529,6 +593,19 @@ extern eOresult_t eo_appCanSP_GetNumOfRecCanframe(EOappCanSP *p, eOcanport_t can
 }
 
 
+extern eOresult_t eo_appCanSP_GetSkinOverflows(EOappCanSP *p, eOcanport_t canport, uint32_t *overflows)
+{
+    if((NULL == p) || (NULL == overflows))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    *overflows = p->skinfastpath[canport].overflows;
+    
+    return(eores_OK);
+}
+
+
 extern eOresult_t eo_appCanSP_GetNumOfTxCanframe(EOappCanSP *p, eOcanport_t canport, uint8_t *numofTXcanframe)
 {
     if(NULL == p)
@@ -818,6 +895,37 @@ extern eOresult_t eo_appCanSP_SendMessage_TEST(EOappCanSP *p, uint8_t *payload_p
 }
 
 
+// the prebuilt hal2 libraries in hal2/lib were built before hal_can_get_many() was added to hal2, thus this weak
+// version keeps the application linkable with them: it gets the frames one by one with hal_can_get(). when the
+// libraries are rebuilt with the new hal_can.c, armlink takes the version in the library, which gets them all in a
+// single critical section.
+__weak extern hal_result_t hal_can_get_many(hal_can_t id, hal_can_frame_t *frames, uint8_t max, uint8_t *read)
+{
+    uint8_t n = 0;
+    uint8_t remaining = 0;
+
+    if((NULL == frames) || (NULL == read))
+    {
+        return(hal_res_NOK_nullpointer);
+    }
+
+    while(n < max)
+    {
+        if(hal_res_OK != hal_can_get(id, &frames[n], &remaining))
+        {
+            break;
+        }
+        n++;
+        if(0 == remaining)
+        {
+            break;
+        }
+    }
+
+    *read = n;
+
+    return((0 == n) ? (hal_res_NOK_nodata) : (hal_res_OK));
+}
 
 
 
@@ -1269,6 +1377,81 @@ static void s_eo_appCanSP_clearDiagnosticValues(EOappCanSP *p, eOcanport_t port)
 }
 
 
+// it tells if the skin fast path is active on the port and returns the array where to put the skin frames. the array is NULL 
+// when the frames must be dropped, with the same rules of eo_icubCanProto_parser_per_sk_cmd__allSkinMsg(): they are kept only
+// if the skin signals them and if we are in RUN state.
+static EOarray* s_eo_appCanSP_skinfastpath_array_get(EOappCanSP *p, eOcanport_t canport, eObool_t *isactive)
+{
+    eOappCanSP_skinfastpath_t *fastpath = &p->skinfastpath[canport];
+    eOsmStatesEMSappl_t applstate = eo_sm_emsappl_STcfg;
+    
+    *isactive = eobool_false;
+    
+    if(NULL == fastpath->skin)
+    {   // the skin is looked for until it is found, as the database may not be ready yet
+        eOsk_skinId_t skId = 0;
+        eOappTheDB_SkinCanLocation_t canloc = {0};
+        canloc.emscanport = canport;
+        if(eores_OK == eo_appTheDB_GetSkinId_BySkinCanLocation(eo_appTheDB_GetHandle(), canloc, &skId))
+        {
+            fastpath->skin = (eOsk_skin_t *)eoprot_entity_ramof_get(eoprot_board_localboard, eoprot_endpoint_skin, eosk_entity_skin, (eOprotIndex_t)skId);
+        }
+        
+        if(NULL == fastpath->skin)
+        {   // the skin frames, if any, go through the parser which gives the proper diagnostics
+            return(NULL);
+        }
+    }
+    
+    *isactive = eobool_true;
+    
+    if(eosk_sigmode_dontsignal == fastpath->skin->config.sigmode)
+    {
+        return(NULL);
+    }
+    
+    eom_emsappl_GetCurrentState(eom_emsappl_GetHandle(), &applstate);   
+    if(eo_sm_emsappl_STrun != applstate)
+    {
+        return(NULL);
+    }
+    
+    return((EOarray*)(&fastpath->skin->status.arrayofcandata));
+}
+
+
+// it copies a run of skin frames into the array with a single operation and returns the number of frames which did not fit
+static uint8_t s_eo_appCanSP_skinfastpath_flush(EOarray *array, const eOsk_candata_t *run, uint8_t numofframes)
+{
+    uint16_t size = eo_array_Size(array);
+    uint16_t room = eo_array_Capacity(array) - size;
+    uint8_t tocopy = (numofframes < room) ? (numofframes) : (room);
+    
+    if(0 != tocopy)
+    {
+        eo_array_Assign(array, size, (void*)run, tocopy);
+    }
+    
+    return(numofframes - tocopy);
+}
+
+
+// a single diagnostic message for all the skin frames lost in a eo_appCanSP_read()
+static void s_eo_appCanSP_skinfastpath_overflow(EOappCanSP *p, eOcanport_t canport, uint16_t lost)
+{
+    eOerrmanDescriptor_t des = {0};
+    
+    p->skinfastpath[canport].overflows += lost;
+    
+    des.code            = eoerror_code_get(eoerror_category_Skin, eoerror_value_SK_arrayofcandataoverflow);
+    des.par16           = lost;
+    des.par64           = p->skinfastpath[canport].overflows;
+    des.sourceaddress   = 0;
+    des.sourcedevice    = (eOcanport1 == canport) ? (eo_errman_sourcedevice_canbus1) : (eo_errman_sourcedevice_canbus2);
+    eo_errman_Error(eo_errman_GetHandle(), eo_errortype_warning, NULL, s_eobj_ownname, &des); 
+}
+
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - old code
@@ -174,6 +174,17 @@ extern eOresult_t eo_appCanSP_read(EOappCanSP *p, eOcanport_t canport, uint8_t n
 extern eOresult_t eo_appCanSP_GetNumOfRecCanframe(EOappCanSP *p, eOcanport_t canport, uint8_t *numofRXcanframe);
 
 
+/** @fn         extern eOresult_t eo_appCanSP_GetSkinOverflows(EOappCanSP *p, eOcanport_t canport, uint32_t *overflows)
+    @brief      gets the number of skin can frames received on port @e canport which were lost because the arrayofcandata 
+                of the skin was full.
+    @param      p                   target obj
+    @param      canport             the can port
+    @param      overflows           in output contains the number of lost frames since startup.
+    @return     eores_OK or eores_NOK_nullpointer
+ **/
+extern eOresult_t eo_appCanSP_GetSkinOverflows(EOappCanSP *p, eOcanport_t canport, uint32_t *overflows);
+
+
 /** @fn         extern eOresult_t eo_appCanSP_SetRunMode(EOappCanSP *p, eo_appCanSP_runMode_t runmode);
     @brief      set run mode: if on evt the transmission is performed always, on demand canframes to transmit are put in queue, but transmitted on demand.
     @param      p                       target obj
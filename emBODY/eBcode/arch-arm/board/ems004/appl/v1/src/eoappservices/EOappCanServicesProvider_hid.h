@@ -44,7 +44,12 @@
 
 
 // - #define used with hidden struct ----------------------------------------------------------------------------------
-// empty-section
+
+// max number of skin frames which are copied together inside the arrayofcandata 
+#define EOAPPCANSP_SKINRUN_MAXFRAMES        16
+
+// max number of frames drained from the hal can rx fifo with a single hal_can_get_many()
+#define EOAPPCANSP_RXBATCH_MAXFRAMES        16
 
 
 // - definition of the hidden struct implementing the object ----------------------------------------------------------
@@ -75,6 +80,15 @@ typedef struct
 } eOappCanSP_periphstatus_t;
 
 
+// the skin frames received on a can port are recognised by their class and copied in runs straight into the 
+// arrayofcandata of the skin attached to the port, without passing through the parser of the icub can protocol.
+typedef struct
+{
+    eOsk_skin_t*        skin;           // the skin attached to the can port. NULL if not yet found
+    uint32_t            overflows;      // skin frames lost because the arrayofcandata was full
+} eOappCanSP_skinfastpath_t;
+
+
 /** @struct     EOconstvector_hid
     @brief      Hidden definition. Implements private data used only internally by the 
                 public or private (static) functions of the object and protected data
@@ -89,6 +103,9 @@ struct EOappCanSP_hid
     eOappCanSP_waitTxIsDone_datastruct_t    waittxdata[hal_can_ports_num];
     eOappCanSP_runnning_data_t              run_data;
     eOappCanSP_periphstatus_t               periphstatus[hal_can_ports_num];
+    eOappCanSP_skinfastpath_t               skinfastpath[hal_can_ports_num];
+    eOsk_candata_t                          skinrun[EOAPPCANSP_SKINRUN_MAXFRAMES];
+    hal_can_frame_t                         rxbatch[EOAPPCANSP_RXBATCH_MAXFRAMES];
 };
 
 // - declaration of extern hidden functions ---------------------------------------------------------------------------
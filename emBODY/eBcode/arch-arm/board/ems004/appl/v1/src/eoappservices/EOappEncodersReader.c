@@ -132,6 +132,8 @@ extern EOappEncReader* eo_appEncReader_New(eOappEncReader_cfg_t *cfg)
 
     //save in obj its configuration
     memcpy(&(retptr->cfg), cfg, sizeof(eOappEncReader_cfg_t));
+    memset(&retptr->waitinfo, 0, sizeof(eOappEncReader_waitinfo_t));
+    retptr->semaphore = osal_semaphore_new(1, 0);
 
     //map application encoder num in hal econder num
     s_eo_appEncReader_mapStreams2HalNumbering(retptr);
@@ -165,6 +167,9 @@ extern eOresult_t eo_appEncReader_StartRead(EOappEncReader *p)
 
     s_eo_appEncReader_check(p);
 
+    // a token left by a previous reading which was not waited for (or whose wait timed out) must not end the next wait
+    osal_semaphore_set(p->semaphore, 0);
+
     if(ENCODER_NULL != p->configuredEnc_SPI1.readSeq.first)
     { 
         memset(&p->times[0], 0, 4); // spi1  
@@ -323,6 +328,59 @@ extern eOappEncReader_diagnosticsinfo_t* eo_appEncReader_GetDiagnosticsHandle(EO
 
     return(&p->dgninfo);
 }
+
+
+extern eOboolvalues_t eo_appEncReader_WaitReady(EOappEncReader *p, eOreltime_t timeout)
+{
+    eOabstime_t start = 0;
+    eOabstime_t now = 0;
+    eOboolvalues_t ready = eobool_false;
+    uint32_t waited = 0;
+    osal_reltime_t tick = 0;
+    
+    if(NULL == p)
+    {
+        return(eobool_false);
+    }
+    
+    ready = eo_appEncReader_isReady(p);
+    
+    if(eobool_false == ready)
+    {   // the task blocks on the semaphore given by the isr of the last encoder of the chains, and meanwhile the cpu goes
+        // to the other tasks. osal truncates the timeout to whole ticks, thus a timeout shorter than a tick becomes one tick.
+        start = osal_system_abstime_get();
+        tick = osal_info_get_tick();
+        osal_semaphore_decrement(p->semaphore, ((0 != timeout) && (timeout < tick)) ? (tick) : (timeout));
+        ready = eo_appEncReader_isReady(p);
+        now = osal_system_abstime_get();
+        waited = (uint32_t)(now - start);
+    }
+    
+    p->waitinfo.last = waited;
+    if(waited > p->waitinfo.max)
+    {
+        p->waitinfo.max = waited;
+    }
+    if(eobool_false == ready)
+    {
+        p->waitinfo.timeouts ++;
+    }
+    
+    return(ready);
+}
+
+
+extern eOresult_t eo_appEncReader_GetWaitInfo(EOappEncReader *p, eOappEncReader_waitinfo_t *waitinfo)
+{
+    if((NULL == p) || (NULL == waitinfo))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    memcpy(waitinfo, &p->waitinfo, sizeof(eOappEncReader_waitinfo_t));
+    
+    return(eores_OK);
+}
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern hidden functions 
 // --------------------------------------------------------------------------------------------------------------------
@@ -431,10 +489,14 @@ static void s_eo_appEncReader_isrCbk_onLastEncRead_SPI1(void *arg)
    p->times[0][3] = osal_system_abstime_get(); 
  
    p->configuredEnc_SPI1.st = eOEncReader_readSt__finished;
-   //if reading on spi3 are already fnished and the user has configured a callback ==> then invoke it
-   if((eOEncReader_readSt__finished == p->configuredEnc_SPI3.st) && (NULL != p->cfg.callbackOnLastRead))
+   //if the reading of all the configured chains is finished ==> wake up eo_appEncReader_WaitReady() and invoke the callback of the user
+   if(eobool_true == eo_appEncReader_isReady(p))
    {
-        p->cfg.callbackOnLastRead(p->cfg.callback_arg);
+        osal_semaphore_increment(p->semaphore, osal_callerISR);
+        if(NULL != p->cfg.callbackOnLastRead)
+        {
+            p->cfg.callbackOnLastRead(p->cfg.callback_arg);
+        }
    }
 }
 
@@ -447,10 +509,14 @@ static void s_eo_appEncReader_isrCbk_onLastEncRead_SPI3(void *arg)
    //set status of reding on spi3
    p->configuredEnc_SPI3.st = eOEncReader_readSt__finished;
 
-   //if reading on spi1 are already fnished and the user has configured a callback ==> then invoke it
-   if((eOEncReader_readSt__finished == p->configuredEnc_SPI1.st) && (NULL != p->cfg.callbackOnLastRead))
+   //if the reading of all the configured chains is finished ==> wake up eo_appEncReader_WaitReady() and invoke the callback of the user
+   if(eobool_true == eo_appEncReader_isReady(p))
    {
-        p->cfg.callbackOnLastRead(p->cfg.callback_arg);
+        osal_semaphore_increment(p->semaphore, osal_callerISR);
+        if(NULL != p->cfg.callbackOnLastRead)
+        {
+            p->cfg.callbackOnLastRead(p->cfg.callback_arg);
+        }
    }
 }
 
@@ -33,6 +33,7 @@
 // - external dependencies --------------------------------------------------------------------------------------------
 //abstlayaer
 #include "hal_encoder.h"
+#include "osal_semaphore.h"
 
 
 // - declaration of extern public interface ---------------------------------------------------------------------------
@@ -70,7 +71,7 @@ typedef enum
 typedef struct
 {
   EOappEncReader_configEncSPIXReadSequence_hid_t readSeq;  /**< contains the sequence of reading of encoders connected to SPIX (1 or 3)*/ 
-  eOappEncReader_readStatusSPIX_t                st;       /**< contains the status of reading on SPIX (1 or 3) */
+  volatile eOappEncReader_readStatusSPIX_t       st;       /**< contains the status of reading on SPIX (1 or 3). it is set to finished by the isr */
 } EOappEncReader_confEncDataPerSPI_hid_t;
 
 
@@ -87,6 +88,8 @@ struct EOappEncReader_hid
     EOappEncReader_confEncDataPerSPI_hid_t configuredEnc_SPI3;
     eOappEncReader_diagnosticsinfo_t dgninfo;
     uint64_t    times[2][4];
+    eOappEncReader_waitinfo_t               waitinfo;
+    osal_semaphore_t*                       semaphore;      /* given by the isr when the reading of all the chains is finished */
 }; 
 
 
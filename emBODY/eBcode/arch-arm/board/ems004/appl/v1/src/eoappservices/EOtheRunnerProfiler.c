@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - doxy
+// --------------------------------------------------------------------------------------------------------------------
+
+/* @file       EOtheRunnerProfiler.c
+    @brief      This file implements the profiler of the phases of the EMS runner.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "string.h"
+#include "EoCommon.h"
+
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of extern public interface
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "EOtheRunnerProfiler.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of extern hidden interface
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "EOtheRunnerProfiler_hid.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+// empty-section
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of extern variables, but better using _get(), _set()
+// --------------------------------------------------------------------------------------------------------------------
+// empty-section
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+// empty-section
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_eo_runnerprofiler_statistics_clear(void);
+
+static uint8_t s_eo_runnerprofiler_bucket(uint32_t usec);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static EOtheRunnerProfiler s_eo_therunnerprofiler =
+{
+    EO_INIT(.initted)               eobool_false,
+    EO_INIT(.config)                {0},
+    EO_INIT(.runs)                  {{0}},
+    EO_INIT(.stats)                 NULL,
+    EO_INIT(.statistics)            {0}
+};
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+
+extern EOtheRunnerProfiler * eo_runnerprofiler_Initialise(const eOrunnerprofiler_cfg_t *cfg)
+{
+    if(eobool_true == s_eo_therunnerprofiler.initted)
+    {
+        return(&s_eo_therunnerprofiler);
+    }
+
+    if((NULL == cfg) || (NULL == cfg->nanotime_get))
+    {
+        return(NULL);
+    }
+
+    memcpy(&s_eo_therunnerprofiler.config, cfg, sizeof(eOrunnerprofiler_cfg_t));
+    s_eo_therunnerprofiler.stats = (NULL != cfg->statistics) ? (cfg->statistics) : (&s_eo_therunnerprofiler.statistics);
+    s_eo_runnerprofiler_statistics_clear();
+    s_eo_therunnerprofiler.initted = eobool_true;
+
+    return(&s_eo_therunnerprofiler);
+}
+
+
+extern EOtheRunnerProfiler * eo_runnerprofiler_GetHandle(void)
+{
+    return((eobool_true == s_eo_therunnerprofiler.initted) ? (&s_eo_therunnerprofiler) : (NULL));
+}
+
+
+extern eOresult_t eo_runnerprofiler_Start(EOtheRunnerProfiler *p, eOrunnerprofiler_phase_t phase)
+{
+    eOrunnerprofiler_phaserun_t *run = NULL;
+
+    if(NULL == p)
+    {
+        return(eores_NOK_nullpointer);
+    }
+
+    run = &p->runs[phase];
+    run->startedat = p->config.nanotime_get() / 1000;
+    run->running = eobool_true;
+
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_runnerprofiler_Stop(EOtheRunnerProfiler *p, eOrunnerprofiler_phase_t phase)
+{
+    eOrunnerprofiler_phaserun_t *run = NULL;
+    eOrunnerprofiler_phasestatistics_t *stat = NULL;
+    uint64_t delta = 0;
+    uint32_t duration = 0;
+    uint8_t bucket = 0;
+
+    if(NULL == p)
+    {
+        return(eores_NOK_nullpointer);
+    }
+
+    run = &p->runs[phase];
+
+    if(eobool_false == run->running)
+    {
+        return(eores_NOK_generic);
+    }
+
+    run->running = eobool_false;
+
+    delta = p->config.nanotime_get() / 1000 - run->startedat;
+    duration = (delta > 0xffffffff) ? (0xffffffff) : ((uint32_t)delta);
+
+    stat = &p->stats->phases[phase];
+
+    if((0 == stat->count) || (duration < stat->min))
+    {
+        stat->min = duration;
+    }
+
+    if((0 == stat->count) || (duration > stat->max))
+    {
+        stat->max = duration;
+        if(eo_runnerprofiler_phase_cycle == phase)
+        {
+            p->stats->worstcycletime = run->startedat;
+        }
+    }
+
+    stat->count++;
+    run->sum += duration;
+    // the mean is kept updated because the statistics may be read directly by the host
+    stat->mean = (uint32_t)(run->sum / stat->count);
+
+    if((0 != p->config.budgets[phase]) && (duration > p->config.budgets[phase]))
+    {
+        stat->overruns++;
+    }
+
+    bucket = s_eo_runnerprofiler_bucket(duration);
+    if(0xffffffff != stat->histogram[bucket])
+    {
+        stat->histogram[bucket]++;
+    }
+
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_runnerprofiler_GetStatistics(EOtheRunnerProfiler *p, eOrunnerprofiler_statistics_t *stats)
+{
+    if((NULL == p) || (NULL == stats))
+    {
+        return(eores_NOK_nullpointer);
+    }
+
+    memcpy(stats, p->stats, sizeof(eOrunnerprofiler_statistics_t));
+
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_runnerprofiler_Reset(EOtheRunnerProfiler *p)
+{
+    if(NULL == p)
+    {
+        return(eores_NOK_nullpointer);
+    }
+
+    s_eo_runnerprofiler_statistics_clear();
+
+    return(eores_OK);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern hidden functions
+// --------------------------------------------------------------------------------------------------------------------
+// empty-section
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_eo_runnerprofiler_statistics_clear(void)
+{
+    memset(&s_eo_therunnerprofiler.runs, 0, sizeof(s_eo_therunnerprofiler.runs));
+    memset(s_eo_therunnerprofiler.stats, 0, sizeof(eOrunnerprofiler_statistics_t));
+}
+
+
+static uint8_t s_eo_runnerprofiler_bucket(uint32_t usec)
+{
+    // bucket 0 is for 0 usec, bucket k for [2^(k-1), 2^k) usec
+    uint8_t bucket = 0;
+
+    while((0 != usec) && (bucket < (EOK_RUNNERPROFILER_BUCKETS-1)))
+    {
+        usec >>= 1;
+        bucket++;
+    }
+
+    return(bucket);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
+
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// - include guard ----------------------------------------------------------------------------------------------------
+#ifndef _EOTHERUNNERPROFILER_H_
+#define _EOTHERUNNERPROFILER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @file       EOtheRunnerProfiler.h
+    @brief      This header file implements public interface to the profiler of the phases of the EMS runner
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+/** @defgroup eo_runnerprofiler Object EOtheRunnerProfiler
+    The EOtheRunnerProfiler is a singleton which measures the execution time of the RX, DO, TX phases of the runner and
+    of the whole cycle. For each of them it keeps min, max, mean, a histogram with log2 buckets and the number of times
+    the execution time went beyond its budget. It also keeps the time of the worst cycle.
+    The statistics can be kept in the ram of a network variable, so that the host reads them with an ask<> or with a
+    regular rop, and clears them with a set<> (see eoprot_fun_UPDT_mn_appl_runnerprofiler()).
+    The object uses only the time function given in its configuration, hence it can be used also in a host simulation
+    of the runner.
+
+    @{
+ **/
+
+
+// - external dependencies --------------------------------------------------------------------------------------------
+
+#include "EoCommon.h"
+
+
+// - public #define  --------------------------------------------------------------------------------------------------
+
+// number of buckets of the histogram. bucket 0 counts durations of less than 1 usec, bucket k counts durations in
+// [2^(k-1), 2^k) usec, and the last bucket counts also all the longer ones.
+#define EOK_RUNNERPROFILER_BUCKETS          16
+
+
+// - declaration of public user-defined types -------------------------------------------------------------------------
+
+
+/** @typedef    typedef enum eOrunnerprofiler_phase_t
+    @brief      The measured phases. The cycle goes from the start of RX to the end of TX.
+ **/
+typedef enum
+{
+    eo_runnerprofiler_phase_rx      = 0,
+    eo_runnerprofiler_phase_do      = 1,
+    eo_runnerprofiler_phase_tx      = 2,
+    eo_runnerprofiler_phase_cycle   = 3
+} eOrunnerprofiler_phase_t;
+
+enum { eo_runnerprofiler_phases_number = 4 };
+
+
+/** @typedef    typedef struct eOrunnerprofiler_phasestatistics_t
+    @brief      The statistics of a phase. The times are in usec.
+ **/
+typedef struct                      // size is 5*4+16*4 = 84 bytes
+{
+    uint32_t                        count;          /**< number of executions */
+    uint32_t                        min;
+    uint32_t                        max;
+    uint32_t                        mean;
+    uint32_t                        overruns;       /**< number of executions longer than the budget */
+    uint32_t                        histogram[EOK_RUNNERPROFILER_BUCKETS];  /**< it saturates after 49 days at 1 ms */
+} eOrunnerprofiler_phasestatistics_t;   EO_VERIFYsizeof(eOrunnerprofiler_phasestatistics_t, 84);
+
+
+/** @typedef    typedef struct eOrunnerprofiler_statistics_t
+    @brief      The statistics of the runner. It has a fixed layout so that it can be the value of a network variable
+                polled by the host.
+ **/
+typedef struct                      // size is 8+4*84 = 344 bytes
+{
+    uint64_t                            worstcycletime;     /**< the time in usec at which the longest cycle started */
+    eOrunnerprofiler_phasestatistics_t  phases[eo_runnerprofiler_phases_number];
+} eOrunnerprofiler_statistics_t;        EO_VERIFYsizeof(eOrunnerprofiler_statistics_t, 344);
+
+
+/** @typedef    typedef struct eOrunnerprofiler_cfg_t
+    @brief      The configuration of the profiler.
+ **/
+typedef struct
+{
+    uint64_t                        (*nanotime_get)(void);      /**< the time source. on the board it is oosiit_nanotime_get() */
+    uint32_t                        budgets[eo_runnerprofiler_phases_number];   /**< the budget of each phase in usec. 0 is no budget */
+    eOrunnerprofiler_statistics_t   *statistics;    /**< where the statistics are kept, e.g. the ram of a network variable. if NULL the object uses its own memory */
+} eOrunnerprofiler_cfg_t;
+
+
+/** @typedef    typedef struct EOtheRunnerProfiler_hid EOtheRunnerProfiler
+    @brief      EOtheRunnerProfiler is an opaque struct.
+ **/
+typedef struct EOtheRunnerProfiler_hid EOtheRunnerProfiler;
+
+
+
+// - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
+// empty-section
+
+
+// - declaration of extern public functions ---------------------------------------------------------------------------
+
+
+/** @fn         extern EOtheRunnerProfiler * eo_runnerprofiler_Initialise(const eOrunnerprofiler_cfg_t *cfg)
+    @brief      Initialise the singleton EOtheRunnerProfiler.
+    @param      cfg         The configuration. It must have a valid nanotime_get, otherwise the function returns NULL.
+    @return     A valid and not-NULL pointer to the EOtheRunnerProfiler singleton.
+ **/
+extern EOtheRunnerProfiler * eo_runnerprofiler_Initialise(const eOrunnerprofiler_cfg_t *cfg);
+
+
+/** @fn         extern EOtheRunnerProfiler * eo_runnerprofiler_GetHandle(void)
+    @brief      Gets the handle of the EOtheRunnerProfiler singleton
+    @return     Pointer to the singleton or NULL if not yet initialised.
+ **/
+extern EOtheRunnerProfiler * eo_runnerprofiler_GetHandle(void);
+
+
+/** @fn         extern eOresult_t eo_runnerprofiler_Start(EOtheRunnerProfiler *p, eOrunnerprofiler_phase_t phase)
+    @brief      Marks the start of a phase.
+    @param      p           The singleton
+    @param      phase       The phase
+    @return     eores_OK or eores_NOK_nullpointer if p is NULL.
+ **/
+extern eOresult_t eo_runnerprofiler_Start(EOtheRunnerProfiler *p, eOrunnerprofiler_phase_t phase);
+
+
+/** @fn         extern eOresult_t eo_runnerprofiler_Stop(EOtheRunnerProfiler *p, eOrunnerprofiler_phase_t phase)
+    @brief      Marks the end of a phase and adds its execution time to the statistics, whose mean is also updated. 
+                It does nothing if the phase was not started.
+    @param      p           The singleton
+    @param      phase       The phase
+    @return     eores_OK, eores_NOK_generic if the phase was not started, eores_NOK_nullpointer if p is NULL.
+ **/
+extern eOresult_t eo_runnerprofiler_Stop(EOtheRunnerProfiler *p, eOrunnerprofiler_phase_t phase);
+
+
+/** @fn         extern eOresult_t eo_runnerprofiler_GetStatistics(EOtheRunnerProfiler *p, eOrunnerprofiler_statistics_t *stats)
+    @brief      Copies the statistics collected so far.
+    @param      p           The singleton
+    @param      stats       The destination
+    @return     eores_OK or eores_NOK_nullpointer.
+ **/
+extern eOresult_t eo_runnerprofiler_GetStatistics(EOtheRunnerProfiler *p, eOrunnerprofiler_statistics_t *stats);
+
+
+/** @fn         extern eOresult_t eo_runnerprofiler_Reset(EOtheRunnerProfiler *p)
+    @brief      Clears the statistics but keeps the configuration. The phases which are running are not measured.
+    @param      p           The singleton
+    @return     eores_OK or eores_NOK_nullpointer if p is NULL.
+ **/
+extern eOresult_t eo_runnerprofiler_Reset(EOtheRunnerProfiler *p);
+
+
+
+/** @}
+    end of group eo_runnerprofiler
+ **/
+
+#ifdef __cplusplus
+}       // closing brace for extern "C"
+#endif
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
+
+
+
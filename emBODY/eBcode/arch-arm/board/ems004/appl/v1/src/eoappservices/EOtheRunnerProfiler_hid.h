@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// - include guard ----------------------------------------------------------------------------------------------------
+#ifndef _EOTHERUNNERPROFILER_HID_H_
+#define _EOTHERUNNERPROFILER_HID_H_
+
+
+/* @file       EOtheRunnerProfiler_hid.h
+    @brief      This header file implements hidden interface to the profiler of the EMS runner
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+
+// - external dependencies --------------------------------------------------------------------------------------------
+
+#include "EoCommon.h"
+
+
+// - declaration of extern public interface ---------------------------------------------------------------------------
+
+#include "EOtheRunnerProfiler.h"
+
+
+// - #define used with hidden struct ----------------------------------------------------------------------------------
+// empty-section
+
+
+// - definition of the hidden struct implementing the object ----------------------------------------------------------
+
+typedef struct
+{
+    uint64_t                        startedat;      // in usec
+    uint64_t                        sum;            // in usec. it is used to compute the mean
+    eObool_t                        running;
+} eOrunnerprofiler_phaserun_t;
+
+
+/** @struct     EOtheRunnerProfiler_hid
+    @brief      Hidden definition. Implements private data used only internally by the
+                public or private (static) functions of the object and protected data
+                used also by its derived objects.
+ **/
+
+struct EOtheRunnerProfiler_hid
+{
+    eObool_t                        initted;
+    eOrunnerprofiler_cfg_t          config;
+    eOrunnerprofiler_phaserun_t     runs[eo_runnerprofiler_phases_number];
+    eOrunnerprofiler_statistics_t   *stats;         // it is &statistics or the one given in the configuration
+    eOrunnerprofiler_statistics_t   statistics;
+};
+
+
+// - declaration of extern hidden functions ---------------------------------------------------------------------------
+// empty-section
+
+
+#endif  // include guard
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
+
+
+
+
@@ -136,6 +136,8 @@ extern EOappEncReader* eo_appEncReader_New(eOappEncReader_cfg_t *cfg)
 
     //save in obj its configuration
     memcpy(&(retptr->cfg), cfg, sizeof(eOappEncReader_cfg_t));
+    memset(&retptr->waitinfo, 0, sizeof(eOappEncReader_waitinfo_t));
+    retptr->semaphore = osal_semaphore_new(1, 0);
 		
     //check encoders connected and fill out the list of the two SPI streams    
     s_eo_appEncReader_prepareSPIEncodersList(retptr, &(retptr->configuredEnc_SPI_stream0), eo_appEncReader_stream0);
@@ -166,6 +168,9 @@ extern eOresult_t eo_appEncReader_StartRead(EOappEncReader *p)
 
     //s_eo_appEncReader_check(p);
 
+    // a token left by a previous reading which was not waited for (or whose wait timed out) must not end the next wait
+    osal_semaphore_set(p->semaphore, 0);
+
     if(ENCODER_NULL != p->configuredEnc_SPI_stream0.readSeq.first)
     { 
         memset(&p->times[0], 0, 4); // spi stream0
@@ -534,6 +539,60 @@ __inline extern eOboolvalues_t eo_appEncReader_isReadySPI_stream1(EOappEncReader
     }
     return(eobool_false);
 }
+
+extern eOboolvalues_t eo_appEncReader_WaitReady(EOappEncReader *p, eOreltime_t timeout)
+{
+    eOabstime_t start = 0;
+    eOabstime_t now = 0;
+    eOboolvalues_t ready = eobool_false;
+    uint32_t waited = 0;
+    osal_reltime_t tick = 0;
+    
+    if(NULL == p)
+    {
+        return(eobool_false);
+    }
+    
+    ready = eo_appEncReader_isReady(p);
+    
+    if(eobool_false == ready)
+    {   // the task blocks on the semaphore given by the isr of the last encoder of the chains, and meanwhile the cpu goes
+        // to the other tasks. osal truncates the timeout to whole ticks, thus a timeout shorter than a tick becomes one tick.
+        start = osal_system_abstime_get();
+        tick = osal_info_get_tick();
+        osal_semaphore_decrement(p->semaphore, ((0 != timeout) && (timeout < tick)) ? (tick) : (timeout));
+        ready = eo_appEncReader_isReady(p);
+        now = osal_system_abstime_get();
+        waited = (uint32_t)(now - start);
+    }
+    
+    p->waitinfo.last = waited;
+    if(waited > p->waitinfo.max)
+    {
+        p->waitinfo.max = waited;
+    }
+    if(eobool_false == ready)
+    {
+        p->waitinfo.timeouts ++;
+    }
+    
+    return(ready);
+}
+
+
+extern eOresult_t eo_appEncReader_GetWaitInfo(EOappEncReader *p, eOappEncReader_waitinfo_t *waitinfo)
+{
+    if((NULL == p) || (NULL == waitinfo))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    memcpy(waitinfo, &p->waitinfo, sizeof(eOappEncReader_waitinfo_t));
+    
+    return(eores_OK);
+}
+
+
 /*
 extern eOappEncReader_diagnosticsinfo_t* eo_appEncReader_GetDiagnosticsHandle(EOappEncReader *p)
 {
@@ -724,10 +783,14 @@ static void s_eo_appEncReader_isrCbk_onLastEncRead_SPI_stream0(void *arg)
    p->times[0][3] = osal_system_abstime_get(); 
  
    p->configuredEnc_SPI_stream0.st = eOEncReader_readSt__finished;
-   //if reading on spi stream1 are already finished and the user has configured a callback ==> then invoke it
-   if((eOEncReader_readSt__finished == p->configuredEnc_SPI_stream1.st) && (NULL != p->cfg.SPI_callbackOnLastRead))
+   //if the reading of all the configured chains is finished ==> wake up eo_appEncReader_WaitReady() and invoke the callback of the user
+   if(eobool_true == eo_appEncReader_isReady(p))
    {
-        p->cfg.SPI_callbackOnLastRead(p->cfg.SPI_callback_arg);
+        osal_semaphore_increment(p->semaphore, osal_callerISR);
+        if(NULL != p->cfg.SPI_callbackOnLastRead)
+        {
+            p->cfg.SPI_callbackOnLastRead(p->cfg.SPI_callback_arg);
+        }
    }
 }
 
@@ -740,10 +803,14 @@ static void s_eo_appEncReader_isrCbk_onLastEncRead_SPI_stream1(void *arg)
    //set status of reding on spi stream1
    p->configuredEnc_SPI_stream1.st = eOEncReader_readSt__finished;
 
-   //if reading on spi stream0 are already finished and the user has configured a callback ==> then invoke it
-   if((eOEncReader_readSt__finished == p->configuredEnc_SPI_stream0.st) && (NULL != p->cfg.SPI_callbackOnLastRead))
+   //if the reading of all the configured chains is finished ==> wake up eo_appEncReader_WaitReady() and invoke the callback of the user
+   if(eobool_true == eo_appEncReader_isReady(p))
    {
-        p->cfg.SPI_callbackOnLastRead(p->cfg.SPI_callback_arg);
+        osal_semaphore_increment(p->semaphore, osal_callerISR);
+        if(NULL != p->cfg.SPI_callbackOnLastRead)
+        {
+            p->cfg.SPI_callbackOnLastRead(p->cfg.SPI_callback_arg);
+        }
    }
 }
 
@@ -167,6 +167,17 @@ typedef struct
     uint16_t count;
 } eOappEncReader_diagnosticsinfo_t;
 
+/** @typedef    struct eOappEncReader_waitinfo_t
+    @brief      contains the time spent blocked inside eo_appEncReader_WaitReady() waiting for the end of the reading of the encoders.
+ **/
+typedef struct
+{
+    uint32_t    last;           /**< the time in usec spent in the last wait */
+    uint32_t    max;            /**< the max time in usec spent in a wait */
+    uint32_t    timeouts;       /**< the number of waits which reached the timeout */
+} eOappEncReader_waitinfo_t;
+
+
 // - declaration of extern public variables, ...deprecated: better using use _get/_set instead ------------------------
 // empty-section
 
@@ -193,6 +204,20 @@ extern eOresult_t  eo_appEncReader_GetValue(EOappEncReader *p, eOappEncReader_en
 
 //extern eOappEncReader_diagnosticsinfo_t* eo_appEncReader_GetDiagnosticsHandle(EOappEncReader *p);
 
+/** @fn         extern eOboolvalues_t eo_appEncReader_WaitReady(EOappEncReader *p, eOreltime_t timeout)
+    @brief      blocks the calling task until the reading of all the configured encoders is finished, which is signalled 
+                with a semaphore by the isr of the last encoder of the chains, or until @e timeout usec have elapsed. 
+                it returns immediately if the reading is already finished. while the task is blocked the cpu goes to the 
+                other tasks.
+    @param      p               the reader
+    @param      timeout         the max wait in usec. it is rounded up to the tick of osal, thus a chain whose isr never
+                                comes costs up to one tick.
+    @return     eobool_true if the reading is finished, eobool_false if the timeout has elapsed or p is NULL.
+ **/
+extern eOboolvalues_t eo_appEncReader_WaitReady(EOappEncReader *p, eOreltime_t timeout);
+
+extern eOresult_t eo_appEncReader_GetWaitInfo(EOappEncReader *p, eOappEncReader_waitinfo_t *waitinfo);
+
 /** @}            
     end of group eo_app_encodersReader
  **/
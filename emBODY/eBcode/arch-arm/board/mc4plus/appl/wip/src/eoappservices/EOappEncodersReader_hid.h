@@ -33,6 +33,7 @@
 // - external dependencies --------------------------------------------------------------------------------------------
 //abstlayaer
 #include "hal_encoder.h"
+#include "osal_semaphore.h"
 
 
 // - declaration of extern public interface ---------------------------------------------------------------------------
@@ -61,7 +62,7 @@ typedef enum
 typedef struct
 {
     EOappEncReader_configEncSPIXReadSequence_hid_t readSeq;  /**< contains the sequence of reading of encoders connected to SPIX (1 or 3)*/ 
-    eOappEncReader_readStatusSPIX_t                st;       /**< contains the status of reading on SPIX (1 or 3) */
+    volatile eOappEncReader_readStatusSPIX_t       st;       /**< contains the status of reading on SPIX (1 or 3). it is set to finished by the isr */
     eo_appEncReader_enc_type_t                     enc_type; /**< the type of the encoder to be read (AEA and AMO supported) */
     uint8_t                                        enc_numbers; //number of encoders associated
 } EOappEncReader_confEncDataPerSPI_hid_t;
@@ -74,6 +75,8 @@ struct EOappEncReader_hid
     EOappEncReader_confEncDataPerSPI_hid_t  configuredEnc_SPI_stream1;      /* Encoders configured on the second SPI stream */
     eOappEncReader_diagnosticsinfo_t        dgninfo;                        /* Diagnostics info, deprecated */
     uint64_t    times[2][4];
+    eOappEncReader_waitinfo_t               waitinfo;
+    osal_semaphore_t*                       semaphore;                      /* given by the isr when the reading of all the chains is finished */
 }; 
 
 
@@ -59,6 +59,7 @@
 // --------------------------------------------------------------------------------------------------------------------
 #define LOCAL_ENCODER(enc_type)     ((enc_type == 0) || (enc_type == 1) || (enc_type == 2) || (enc_type == 3)) // AEA, AMO, INC, ADH 
 #define SPI_ENCODER(enc_type)       ((enc_type == 0) || (enc_type == 1)) // AEA, AMO 
+#define TIMEOUT_ENCODERS_READING    150 // usec
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of extern variables. deprecated: better using _get(), _set() on static variables 
@@ -566,31 +567,9 @@ extern eOresult_t s_eo_mcserv_do_mc4plus(EOmcService *p)
     
     #warning TBD: add what is missing for do phase
       
-    // 1. wait some time until encoders are ready. if not ready by a timeout, then issue a diagnostics message and ... quit or continue?
-    /*
-    while(!eo_appEncReader_isReady(app_enc_reader))
-    {
-        //do nothing
-    }
-    //determine if the timeout is expired
-    */
-    
-    
-    uint8_t spi_stream0 = 0, spi_stream1 = 0;
-    for(uint8_t i=0; i<30; ++i)
-    {
-        if (eo_appEncReader_isReady(app_enc_reader))
-        {
-            break;
-        }
-        // it means that the SPI encoders are not ready yet...
-        else
-        {
-            if (!eo_appEncReader_isReadySPI_stream0(app_enc_reader)) ++spi_stream0;
-            if (!eo_appEncReader_isReadySPI_stream1(app_enc_reader)) ++spi_stream1;
-            hal_sys_delay(5);
-        }
-    }
+    // 1. wait until the encoders are ready, which is signalled by the isr of the last encoder of each chain, but not longer than a timeout.
+    //    if not ready by the timeout, the errormask tells it to the controller.
+    eo_appEncReader_WaitReady(app_enc_reader, TIMEOUT_ENCODERS_READING);
     
     // 2. read encoders and put result into p->valuesencoder[] and fill an errormask
     if (eo_appEncReader_isReady(app_enc_reader))
@@ -215,6 +215,21 @@ extern const hal_can_cfg_t hal_can_cfg_default;
 extern hal_result_t hal_can_init(hal_can_t id, const hal_can_cfg_t *cfg);
 
 
+/** @fn         extern hal_result_t hal_can_init_large(hal_can_t id, const hal_can_cfg_t *cfg, uint16_t capacityofrxfifoofframes, uint16_t capacityoftxfifoofframes)
+    @brief      This function configures CAN as hal_can_init() does but with rx and tx fifos of up to 65535 frames. The
+                capacities inside @e cfg are not used. The numbers of frames given by hal_can_received() and
+                hal_can_get() saturate at 255.
+    @param      id                          identifies CAN id 
+    @param      cfg                         the configuration of the can peripheral
+    @param      capacityofrxfifoofframes    the capacity of the rx fifo
+    @param      capacityoftxfifoofframes    the capacity of the tx fifo
+    @return     hal_res_OK in case of success, else hal_res_NOK_generic
+    @warning    as for hal_can_init(), a second call returns hal_res_OK only if @e cfg and the capacities are the same 
+                as the first time.
+  */
+extern hal_result_t hal_can_init_large(hal_can_t id, const hal_can_cfg_t *cfg, uint16_t capacityofrxfifoofframes, uint16_t capacityoftxfifoofframes);
+
+
 /** @fn         extern hal_result_t hal_can_enable(hal_can_t id)
     @brief      This function starts CAN. It must be invoked after hal_can_init.
     @param      id            identifies CAN id 
@@ -271,6 +286,18 @@ extern hal_result_t hal_can_received(hal_can_t id, uint8_t *numberof);
 extern hal_result_t hal_can_get(hal_can_t id, hal_can_frame_t *frame, uint8_t *remaining); 
 
 
+/** @fn         extern hal_result_t hal_can_get_many(hal_can_t id, hal_can_frame_t *frames, uint8_t max, uint8_t *read)
+    @brief      This function gets up to @e max frames from the rx queue, oldest first. the queue is drained with a single 
+                critical section, thus it is much cheaper than calling hal_can_get() once per frame.
+    @param      id              identifies CAN id  
+    @param      frames          pointer to memory which can hold @e max frames
+    @param      max             the maximum number of frames to get
+    @param      read            it returns the number of frames copied into @e frames. 
+    @return     hal_res_NOK_generic in case wrong id or NULL argument, hal_res_NOK_nodata in case of empty queue, else hal_res_OK.
+  */
+extern hal_result_t hal_can_get_many(hal_can_t id, hal_can_frame_t *frames, uint8_t max, uint8_t *read); 
+
+
 /** @fn         extern hal_result_t hal_can_receptionfilter_set(hal_can_t id, uint8_t mask_num, uint32_t mask_val, uint8_t identifier_num,
                                                 uint32_t identifier_val, hal_can_frameID_format_t idformat)
     @brief      This function configures reception filter.
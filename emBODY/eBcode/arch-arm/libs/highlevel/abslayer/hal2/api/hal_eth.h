@@ -207,6 +207,16 @@ extern hal_result_t hal_eth_sendframe(hal_eth_genericframe_t *genframe);
 extern hal_result_t hal_eth_sendframe(hal_eth_frame_t *frame);
 #endif
 
+
+/** @fn         extern hal_result_t hal_eth_rx_refill(void)
+    @brief      Fills the pool of spare frames which the ETH isr uses to receive without copying: the frame written by the
+                dma is given to the higher layer and replaced by a spare one. The spares are taken with frame_new() of
+                hal_eth_onframereception_t. When the pool is empty the isr copies the frame as usual.
+    @return     hal_res_OK if the pool is full, hal_res_NOK_nodata if frame_new() has no more memory.
+    @warning    It must be called outside the isr, generally by the TCP-IP stack before it processes the received frames.
+ **/
+extern hal_result_t hal_eth_rx_refill(void);
+
 /** @fn         extern const hal_eth_network_functions_t * hal_eth_get_network_functions(void)
     @brief      retrieves the network functions used by HAL
     @return     a pointer containing {hal_eth_init, hal_eth_enable, hal_eth_disable, hal_eth_sendframe}
@@ -139,6 +139,7 @@ typedef struct
     hal_callback_t          onframereceiv;      /**< if not NULL and direction is not hal_spi_dir_txonly it is called by the ISR when a frame is received */
     void*                   argonframereceiv;
 		hal_spi_cpolarity_t			cpolarity;					// if 0 SPI_CPOL_Low, if 1 SPI_CPOL_High
+    hal_bool_t              usedma;             /**< if hal_true the frames are moved by dma with one interrupt per frame and double buffering, otherwise by the rx isr one byte at a time */
 } hal_spi_cfg_t;
 
  
@@ -147,7 +148,8 @@ typedef struct
 extern const hal_spi_cfg_t hal_spi_cfg_default; /**< = { .ownership = hal_spi_ownership_master, .direction = hal_spi_dir_rxonly, .activity = hal_spi_act_framebased,
                                                          .prescaler = hal_spi_prescaler_64, .maxspeed = 0, .sizeofframe = 4, 
                                                          .capacityoftxfifoofframes = 0, .capacityofrxfifoofframes = 2, .dummytxvalue = 0, 
-                                                         .onframetransm = NULL, .argonframetransm = NULL, .onframereceiv = NULL, .argonframereceiv = NULL };
+                                                         .onframetransm = NULL, .argonframetransm = NULL, .onframereceiv = NULL, .argonframereceiv = NULL, 
+                                                         .cpolarity = hal_spi_cpolarity_high, .usedma = hal_false };
                                                  */
 
 // - declaration of extern public functions ---------------------------------------------------------------------------
@@ -208,6 +210,8 @@ extern hal_bool_t hal_spi_active_is(hal_spi_t id);
     @param  	id	                the id
     @param  	rxframe             the received frame
     @param  	remainingrxframes   if not NULL, it is filled with the number of frames remaining in the internal fifo.
+                                    in dma mode there is no fifo: it gets the last completed frame and it is always filled with 0.
+                                    a failed dma transfer still calls the callback, but then there is no frame.
     @return 	hal_res_OK if a valid frame is available, hal_res_NOK_nodata if no frame is available, or hal_res_NOK_generic on failure
   */
 extern hal_result_t hal_spi_get(hal_spi_t id, uint8_t* rxframe, uint8_t* remainingrxframes);
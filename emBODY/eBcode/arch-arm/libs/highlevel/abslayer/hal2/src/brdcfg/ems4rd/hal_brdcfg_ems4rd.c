@@ -865,6 +865,7 @@ static void s_hal_brdcfg_ems4rd_vaux_5v0_off(void);
     {
         .supportedmask              = (1 << hal_encoder1) | (1 << hal_encoder2) | (1 << hal_encoder3) | (1 << hal_encoder4) | (1 << hal_encoder5) | (1 << hal_encoder6), 
         .spimaxspeed                =  1000*1000, // not more than 1 mhz. actually on stm32f4 it is exactly 42m/64 = 0.65625 mhz
+        .spiusedma                  =  hal_true,  // spi2 and spi3 have their dma1 streams
         .spimap                     =
         {
             {   // hal_encoder1:    P6 on ems4rd
@@ -784,6 +784,7 @@ static void s_hal_brdcfg_mc4plus_vaux_5v0_off(void);
     {
         .supportedmask              =  (1 << hal_encoder1) | (1 << hal_encoder2) | (0 << hal_encoder3) | (0 << hal_encoder4) | (0 << hal_encoder5) | (0 << hal_encoder6),  
         .spimaxspeed                =  1000*1000, // not more than 1 mhz. actually on stm32f4 it is exactly 42m/64 = 0.65625 mhz
+        .spiusedma                  =  hal_false, // keep the isr mode until the dma mode is validated on this board
         .spimap                     =
         {
             {   // hal_encoder1:    P10 on mc4plus
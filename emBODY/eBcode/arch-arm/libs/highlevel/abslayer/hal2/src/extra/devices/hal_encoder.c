@@ -144,6 +144,7 @@ static const hal_spi_cfg_t s_hal_encoder_spicfg_master =
     .onframereceiv              = NULL,
     .argonframereceiv           = NULL,
 		.cpolarity									= hal_spi_cpolarity_high,
+    .usedma                     = hal_false
 };
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of static variables
@@ -228,6 +229,9 @@ extern hal_result_t hal_encoder_init(hal_encoder_t id, const hal_encoder_cfg_t *
 		
 		//we get the max speed of spi from what specified in hal_encoder__theboardconfig
 		spicfg.maxspeed = hal_encoder__theboardconfig.spimaxspeed;
+		
+		//we move the frames by dma if the board says so: one interrupt per frame rather than one per byte
+		spicfg.usedma = hal_encoder__theboardconfig.spiusedma;
     
 		//Initialize the SPI with the just set config
     res = hal_spi_init(intitem->spiid, &spicfg);
@@ -682,7 +686,11 @@ static void s_hal_encoder_onreceiv(void* p)
     
 		// hal_spi_get collects data directly from the fifo associated to the receveing packets
 		// gets all the items inside the fifo (in this case)
-    hal_spi_get(intitem->spiid, intitem->rxframes[1], NULL);
+		// no frame means a failed transfer: it is kept as an encoder which does not answer, so that hal_encoder_get_value() gives tx_error
+    if(hal_res_OK != hal_spi_get(intitem->spiid, intitem->rxframes[1], NULL))
+    {
+        memset(intitem->rxframes[1], 0xFF, sizeof(intitem->rxframes[1]));
+    }
     
 		// Formatting result and saving in position field
 		intitem->position = s_hal_encoder_frame2position_t1(intitem->rxframes[1]);
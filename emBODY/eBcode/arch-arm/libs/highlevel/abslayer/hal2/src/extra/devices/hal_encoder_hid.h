@@ -61,6 +61,7 @@ typedef struct
 {
     uint32_t                    supportedmask;
     uint32_t                    spimaxspeed;                    // in hz
+    hal_bool_t                  spiusedma;                      // if hal_true the frames of the encoders are moved by dma (see hal_spi_cfg_t::usedma)
     hal_encoder_spimap_t        spimap[hal_encoders_number];
 } hal_encoder_boardconfig_t;
 
@@ -96,6 +96,8 @@ const hal_can_cfg_t hal_can_cfg_default =
 typedef struct
 {
     hal_can_cfg_t               config;
+    uint16_t                    capacityofrxfifoofframes;
+    uint16_t                    capacityoftxfifoofframes;
 } hal_can_internal_item_t;
 
 
@@ -153,6 +155,17 @@ extern const hl_can_mapping_t* hl_can_map = NULL;
 
 
 extern hal_result_t hal_can_init(hal_can_t id, const hal_can_cfg_t *cfg)
+{
+    if(NULL == cfg)
+    {
+        cfg  = &hal_can_cfg_default;
+    }
+    
+    return(hal_can_init_large(id, cfg, cfg->capacityofrxfifoofframes, cfg->capacityoftxfifoofframes));
+}
+
+
+extern hal_result_t hal_can_init_large(hal_can_t id, const hal_can_cfg_t *cfg, uint16_t capacityofrxfifoofframes, uint16_t capacityoftxfifoofframes)
 {
     hal_can_internal_item_t* intitem = s_hal_can_theinternals.items[HAL_can_id2index(id)];
 
@@ -170,7 +183,8 @@ extern hal_result_t hal_can_init(hal_can_t id, const hal_can_cfg_t *cfg)
 
     if(hal_true == s_hal_can_initted_is(id))
     {
-        if(0 == memcmp(cfg, &intitem->config, sizeof(hal_can_cfg_t)))
+        if((0 == memcmp(cfg, &intitem->config, sizeof(hal_can_cfg_t))) && 
+           (capacityofrxfifoofframes == intitem->capacityofrxfifoofframes) && (capacityoftxfifoofframes == intitem->capacityoftxfifoofframes))
         {   // ok only if the previously used config is the same as the current one
             return(hal_res_OK);
         }
@@ -184,9 +198,6 @@ extern hal_result_t hal_can_init(hal_can_t id, const hal_can_cfg_t *cfg)
     // give memory to can internal item for this id ...   
     if(NULL == intitem)
     {
-        uint8_t capacityofrxfifoofframes = cfg->capacityofrxfifoofframes; 
-        uint8_t capacityoftxfifoofframes = cfg->capacityoftxfifoofframes; 
-        
         if((0 == capacityofrxfifoofframes) || (0 == capacityoftxfifoofframes))
         {
             hal_base_on_fatalerror(hal_fatalerror_incorrectparameter, "hal_can_init(): need non-zero tx and rx fifo sizes");
@@ -198,6 +209,8 @@ extern hal_result_t hal_can_init(hal_can_t id, const hal_can_cfg_t *cfg)
     
     // set config
     memcpy(&intitem->config, cfg, sizeof(hal_can_cfg_t));
+    intitem->capacityofrxfifoofframes = capacityofrxfifoofframes;
+    intitem->capacityoftxfifoofframes = capacityoftxfifoofframes;
     
            
     // init the phy of id
@@ -235,7 +248,7 @@ extern hal_result_t hal_can_init(hal_can_t id, const hal_can_cfg_t *cfg)
     cancomcfg.arg_cb_err                    = cfg->arg_cb_err;
     
 
-    r = hl_can_comm_init((hl_can_t)id, &cancomcfg);
+    r = hl_can_comm_init_large((hl_can_t)id, &cancomcfg, capacityofrxfifoofframes, capacityoftxfifoofframes);
 
     if(hl_res_OK != r)
     {
@@ -370,6 +383,27 @@ extern hal_result_t hal_can_get(hal_can_t id, hal_can_frame_t *frame, uint8_t *r
 }
 
 
+extern hal_result_t hal_can_get_many(hal_can_t id, hal_can_frame_t *frames, uint8_t max, uint8_t *read) 
+{
+#if     !defined(HAL_BEH_REMOVE_RUNTIME_VALIDITY_CHECK)
+    if(hal_false == s_hal_can_initted_is(id))
+    {
+        return(hal_res_NOK_generic);
+    }
+#endif
+    
+#if     !defined(HAL_BEH_REMOVE_RUNTIME_PARAMETER_CHECK)     
+    if((NULL == frames) || (NULL == read))
+    {
+        return(hal_res_NOK_generic);
+    }
+#endif
+    
+    hl_result_t r = hl_can_comm_get_many((hl_can_t)id, (hl_can_comm_frame_t*)frames, max, read);
+    return((hal_result_t)r);
+}
+
+
 extern hal_result_t hal_can_receptionfilter_set(hal_can_t id, uint8_t mask_num, uint32_t mask_val, uint8_t identifier_num,
                                                 uint32_t identifier_val, hal_can_frameID_format_t idformat)
 {
@@ -52,6 +52,14 @@
 #include "eventviewer.h"
 #include "hal_arch_arm.h"
 #endif 
+
+// if defined, the sent and received frames are recorded in the binary trace of the eventviewer. 
+// the application must then contain eventviewer.c
+//#define HAL_USE_EVENTVIEWER_TRACE_ETH
+
+#if defined(HAL_USE_EVENTVIEWER_TRACE_ETH)
+#include "eventviewer.h"
+#endif
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of extern public interface
 // --------------------------------------------------------------------------------------------------------------------
@@ -267,10 +275,22 @@ extern hal_result_t hal_eth_sendframe(hal_eth_genericframe_t *genframe)
 #else
 extern hal_result_t hal_eth_sendframe(hal_eth_frame_t *frame) 
 {
+#if defined(HAL_USE_EVENTVIEWER_TRACE_ETH)
+    eventviewer_trace_put(ev_TRACE_ID_eth_tx, frame->length);
+#endif
     return((hal_result_t)hl_eth_sendframe((hl_eth_frame_t*)frame));
 }
 #endif
 
+extern hal_result_t hal_eth_rx_refill(void)
+{
+#ifdef HAL_COMPATIBLE_LWIP
+    return(hal_res_NOK_unsupported);
+#else
+    return((hal_result_t)hl_eth_rx_refill());
+#endif
+}
+
 
 
 extern const hal_eth_network_functions_t * hal_eth_get_network_functions(void)
@@ -407,6 +427,9 @@ extern void hl_eth_on_frame_received(hl_eth_frame_t* frame)
     const hal_eth_t id = hal_eth1;
     hal_eth_internal_item_t* intitem = s_hal_eth_theinternals.items[HAL_eth_id2index(id)];   
 
+#if defined(HAL_USE_EVENTVIEWER_TRACE_ETH)
+    eventviewer_trace_put(ev_TRACE_ID_eth_rx, frame->length);
+#endif
     intitem->onframerx.frame_movetohigherlayer((hal_eth_frame_t*)frame);
 	
 	// acemor on 03mar2014: it is possible to move up more than one frame inside the ETH isr handler
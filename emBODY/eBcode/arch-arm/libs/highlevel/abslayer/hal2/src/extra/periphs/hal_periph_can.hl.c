@@ -63,6 +63,15 @@
 #include "hal_periph_can_hid.h" 
 
 
+// if defined, the sent and received frames are recorded in the binary trace of the eventviewer. 
+// the application must then contain eventviewer.c
+//#define HAL_USE_EVENTVIEWER_TRACE_CAN
+
+#if defined(HAL_USE_EVENTVIEWER_TRACE_CAN)
+#include "eventviewer.h"
+#endif
+
+
 // --------------------------------------------------------------------------------------------------------------------
 // - #define with internal scope
 // --------------------------------------------------------------------------------------------------------------------
@@ -742,6 +751,9 @@ static void s_hal_can_isr_sendframes_canx(hal_can_t id)
         // CAN_Transmit() returns the number of the mailbox used in transmission or CAN_TxStatus_NoMailBox if there is no empty mailbox
         if(CAN_TxStatus_NoMailBox != CAN_Transmit(HAL_can_port2peripheral(id), &TxMessage))
         {   // if the CAN_Transmit() was succesful ... remove the sent frame from from fifo-tx and call the user-defined callback
+#if defined(HAL_USE_EVENTVIEWER_TRACE_CAN)
+            eventviewer_trace_put(ev_TRACE_ID_can_tx, ((uint16_t)HAL_can_id2index(id) << 8) | pcanframe->size);
+#endif
         	hal_utility_fifo_pop(fifotx);
             if(NULL != intitem->config.callback_on_tx)
             {
@@ -872,6 +884,10 @@ static void s_hal_can_isr_recvframe_canx(hal_can_t id)
     canframe.size   = RxMessage.DLC;
     *data           = *((uint64_t*)RxMessage.Data);
     
+#if defined(HAL_USE_EVENTVIEWER_TRACE_CAN)
+    eventviewer_trace_put(ev_TRACE_ID_can_rx, ((uint16_t)HAL_can_id2index(id) << 8) | canframe.size);
+#endif
+    
     hal_utility_fifo_put16(fiforx, (uint8_t*)&canframe);
 
     // if a callback is set, invoke it
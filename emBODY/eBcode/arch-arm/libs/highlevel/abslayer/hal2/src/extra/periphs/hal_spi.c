@@ -32,7 +32,7 @@
 #ifdef HAL_USE_SPI
 
 
-//#warning --> BEWARE: HAL_USE_SPI supports only master mode, rx only, isr-mode, no dma, one frame at a time
+//#warning --> BEWARE: HAL_USE_SPI supports only master mode, rx only, isr-mode or dma-mode (stm32f4 only), one frame at a time
 
 // --------------------------------------------------------------------------------------------------------------------
 // - external dependencies
@@ -94,6 +94,7 @@ const hal_spi_cfg_t hal_spi_cfg_default =
     .onframereceiv              = NULL,
     .argonframereceiv           = NULL,
 		.cpolarity									= hal_spi_cpolarity_high,
+    .usedma                     = hal_false
 };
 
 
@@ -102,6 +103,20 @@ const hal_spi_cfg_t hal_spi_cfg_default =
 // --------------------------------------------------------------------------------------------------------------------
 // empty-section
 
+#if defined(HAL_USE_MPU_TYPE_STM32F4)
+typedef struct
+{
+    DMA_Stream_TypeDef* rxstream;
+    DMA_Stream_TypeDef* txstream;
+    uint32_t            channel;
+    IRQn_Type           rxirqn;
+    uint32_t            rxitdone;           // the DMA_IT_TCIFx of rxstream
+    uint32_t            rxiterror;          // the DMA_IT_TEIFx of rxstream
+    uint32_t            rxflags;            // all the DMA_FLAG_xxIFx of rxstream
+    uint32_t            txflags;            // all the DMA_FLAG_xxIFx of txstream
+} hal_spi_dmamap_t;
+#endif
+
 typedef struct
 {
     hal_spi_cfg_t       config;
@@ -114,6 +129,11 @@ typedef struct
     hal_spi_t           id;
     uint8_t             frameburstcountdown;
     hal_bool_t          isrisenabled;
+    hal_bool_t          dmaisused;
+    uint8_t             dmaframecapacity;
+    uint8_t*            dmarxframes[2];     // the dma writes into dmarxframes[dmarxwriting] while dmarxframes[1-dmarxwriting] holds the last frame
+    volatile uint8_t    dmarxwriting;
+    volatile hal_bool_t dmarxavailable;
 } hal_spi_internal_item_t;
 
 
@@ -154,12 +174,56 @@ static void s_hal_spi_periph_disable(hal_spi_t id);
 
 static void s_hal_spi_prepare_hl_spi_map(void);
 
+static hal_bool_t s_hal_spi_dma_supported_is(hal_spi_t id);
+static void s_hal_spi_dma_init(hal_spi_t id);
+static void s_hal_spi_dma_start(hal_spi_t id);
+static void s_hal_spi_dma_stop(hal_spi_t id);
+static void s_hal_spi_dma_rx_isr(hal_spi_t id);
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of static const variables
 // --------------------------------------------------------------------------------------------------------------------
 
 static SPI_TypeDef* const s_hal_spi_stmSPImap[] = { SPI1, SPI2, SPI3 };
 
+#if defined(HAL_USE_MPU_TYPE_STM32F4)
+// spi2 and spi3 use channel 0 of dma1 (table 42 of rm0090). spi1 could use dma2 streams 0/2 and 3/5 but streams 0 and 2 
+// are already taken by hal_adc, hence it keeps the isr mode.
+static const hal_spi_dmamap_t s_hal_spi_dmamap[] = 
+{
+    {   // hal_spi1
+        .rxstream   = NULL,
+        .txstream   = NULL,
+        .channel    = DMA_Channel_3,
+        .rxirqn     = DMA2_Stream2_IRQn,
+        .rxitdone   = 0,
+        .rxiterror  = 0,
+        .rxflags    = 0,
+        .txflags    = 0
+    },
+    {   // hal_spi2
+        .rxstream   = DMA1_Stream3,
+        .txstream   = DMA1_Stream4,
+        .channel    = DMA_Channel_0,
+        .rxirqn     = DMA1_Stream3_IRQn,
+        .rxitdone   = DMA_IT_TCIF3,
+        .rxiterror  = DMA_IT_TEIF3,
+        .rxflags    = DMA_FLAG_FEIF3 | DMA_FLAG_DMEIF3 | DMA_FLAG_TEIF3 | DMA_FLAG_HTIF3 | DMA_FLAG_TCIF3,
+        .txflags    = DMA_FLAG_FEIF4 | DMA_FLAG_DMEIF4 | DMA_FLAG_TEIF4 | DMA_FLAG_HTIF4 | DMA_FLAG_TCIF4
+    },
+    {   // hal_spi3
+        .rxstream   = DMA1_Stream0,
+        .txstream   = DMA1_Stream5,
+        .channel    = DMA_Channel_0,
+        .rxirqn     = DMA1_Stream0_IRQn,
+        .rxitdone   = DMA_IT_TCIF0,
+        .rxiterror  = DMA_IT_TEIF0,
+        .rxflags    = DMA_FLAG_FEIF0 | DMA_FLAG_DMEIF0 | DMA_FLAG_TEIF0 | DMA_FLAG_HTIF0 | DMA_FLAG_TCIF0,
+        .txflags    = DMA_FLAG_FEIF5 | DMA_FLAG_DMEIF5 | DMA_FLAG_TEIF5 | DMA_FLAG_HTIF5 | DMA_FLAG_TCIF5
+    }
+};
+#endif
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of static variables
 // --------------------------------------------------------------------------------------------------------------------
@@ -288,6 +352,19 @@ extern hal_result_t hal_spi_start(hal_spi_t id, uint8_t numberofframes)
     }    
 #endif
       
+    if(hal_true == intitem->dmaisused)
+    {
+        if(intitem->config.sizeofframe > intitem->dmaframecapacity)
+        {
+            return(hal_res_NOK_generic);
+        }
+        
+        // the whole frame is moved by the dma and the isr is called only once at the end of reception
+        intitem->frameburstcountdown = num2use;
+        s_hal_spi_dma_start(id);
+        return(hal_res_OK);
+    }
+      
     // protect ... may be not needed
     s_hal_spi_rx_isr_disable(id);       
     
@@ -469,6 +546,10 @@ extern hal_result_t hal_spi_deinit(hal_spi_t id){
 			}
 #endif
 			hl_result_t res;
+			if(hal_true == s_hal_spi_theinternals.items[HAL_spi_id2index(id)]->dmaisused)
+			{
+				s_hal_spi_dma_stop(id);
+			}
 			res = hl_spi_deinit((hl_spi_t)id);
 			if ( hl_res_NOK_generic == res )
 				return hal_res_NOK_generic;
@@ -504,6 +585,22 @@ void SPI3_IRQHandler(void)
 	s_hal_spi_read_isr(hal_spi3);
 }
 
+#if defined(HAL_USE_MPU_TYPE_STM32F4)
+
+// rx of spi2 in dma mode
+void DMA1_Stream3_IRQHandler(void)
+{
+    s_hal_spi_dma_rx_isr(hal_spi2);
+}
+
+// rx of spi3 in dma mode
+void DMA1_Stream0_IRQHandler(void)
+{
+    s_hal_spi_dma_rx_isr(hal_spi3);
+}
+
+#endif
+
 // ---- isr of the module: end ------
 
 
@@ -703,15 +800,38 @@ static hal_result_t s_hal_spi_init(hal_spi_t id, const hal_spi_cfg_t *cfg)
     
     // only frame-based
     
-    // - the isr rx frame (heap allocation)  
-    intitem->isrrxframe = (uint8_t*)hal_heap_new(usedcfg->sizeofframe);    
-    intitem->isrrxcounter = 0;
-		
-		// - the isr tx frame (heap allocation)
+    // - the dma is used only if required and if the spi port has its streams
+    intitem->dmaisused = ((hal_true == usedcfg->usedma) && (hal_true == s_hal_spi_dma_supported_is(id))) ? (hal_true) : (hal_false);
+    
+		// - the isr tx frame (heap allocation). in dma mode it is the source of the tx stream
     intitem->isrtxframe = (uint8_t*)hal_heap_new(usedcfg->sizeofframe);    
- 
-    // - the fifo of rx frames. but only if it is needed ... we dont need it if ...
-    intitem->fiforx = hl_fifo_new(usedcfg->capacityofrxfifoofframes, usedcfg->sizeofframe, NULL);
+    
+    if(hal_true == intitem->dmaisused)
+    {
+        // - the two rx frames used alternatively by the dma. no fifo and no isr rx frame are needed 
+        intitem->dmaframecapacity = usedcfg->sizeofframe;
+        intitem->dmarxframes[0] = (uint8_t*)hal_heap_new(usedcfg->sizeofframe);
+        intitem->dmarxframes[1] = (uint8_t*)hal_heap_new(usedcfg->sizeofframe);
+        intitem->dmarxwriting = 0;
+        intitem->dmarxavailable = hal_false;
+        intitem->isrrxframe = NULL;
+        intitem->isrrxcounter = 0;
+        intitem->fiforx = NULL;
+    }
+    else
+    {
+        // - the isr rx frame (heap allocation)  
+        intitem->isrrxframe = (uint8_t*)hal_heap_new(usedcfg->sizeofframe);    
+        intitem->isrrxcounter = 0;
+     
+        // - the fifo of rx frames. but only if it is needed ... we dont need it if ...
+        intitem->fiforx = hl_fifo_new(usedcfg->capacityofrxfifoofframes, usedcfg->sizeofframe, NULL);
+        
+        intitem->dmaframecapacity = 0;
+        intitem->dmarxframes[0] = intitem->dmarxframes[1] = NULL;
+        intitem->dmarxwriting = 0;
+        intitem->dmarxavailable = hal_false;
+    }
 		
     // - the id
     intitem->id = id;
@@ -722,8 +842,15 @@ static hal_result_t s_hal_spi_init(hal_spi_t id, const hal_spi_cfg_t *cfg)
     // -- locked
     intitem->isrisenabled = hal_false;
         
-    // now ... init the isr (only for frame-based activity)
-    s_hal_spi_isr_init(id, usedcfg);
+    // now ... init the isr (only for frame-based activity) or the dma streams and their isr
+    if(hal_true == intitem->dmaisused)
+    {
+        s_hal_spi_dma_init(id);
+    }
+    else
+    {
+        s_hal_spi_isr_init(id, usedcfg);
+    }
               
     // ok, it is initted
     s_hal_spi_initted_set(id);
@@ -831,6 +958,24 @@ static hal_result_t s_hal_spi_get(hal_spi_t id, uint8_t* rxframe, uint8_t* remai
 {
     hal_spi_internal_item_t* intitem = s_hal_spi_theinternals.items[HAL_spi_id2index(id)];
 
+    if(hal_true == intitem->dmaisused)
+    {
+        if(NULL != remainingrxframes)
+        {
+            *remainingrxframes = 0;
+        }
+        
+        if(hal_false == intitem->dmarxavailable)
+        {
+            return(hal_res_NOK_nodata);
+        }
+        
+        // the dma is not writing into this frame: it writes into the other one. 
+        memcpy(rxframe, intitem->dmarxframes[1-intitem->dmarxwriting], intitem->config.sizeofframe);
+        intitem->dmarxavailable = hal_false;
+        return(hal_res_OK);
+    }
+
     return((hal_result_t)hl_fifo_get(intitem->fiforx, rxframe, remainingrxframes));      
 }
 
@@ -878,6 +1023,176 @@ static void s_hal_spi_prepare_hl_spi_map(void)
     hl_spi_map = (hl_spi_mapping_t*)&hal_spi__theboardconfig;
 }
 
+
+#if defined(HAL_USE_MPU_TYPE_STM32F4)
+
+static hal_bool_t s_hal_spi_dma_supported_is(hal_spi_t id)
+{
+    return((NULL != s_hal_spi_dmamap[HAL_spi_id2index(id)].rxstream) ? (hal_true) : (hal_false));
+}
+
+
+static void s_hal_spi_dma_init(hal_spi_t id)
+{
+    hal_spi_internal_item_t* intitem = s_hal_spi_theinternals.items[HAL_spi_id2index(id)];
+    const hal_spi_dmamap_t* map = &s_hal_spi_dmamap[HAL_spi_id2index(id)];
+    SPI_TypeDef* SPIx = HAL_spi_id2stmSPI(id);
+    DMA_InitTypeDef dmainit;
+    
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_DMA1, ENABLE);
+    
+    // the common part. the size of transfer and the memory address are set again at every start
+    DMA_StructInit(&dmainit);
+    dmainit.DMA_Channel             = map->channel;
+    dmainit.DMA_PeripheralBaseAddr  = (uint32_t)&SPIx->DR;
+    dmainit.DMA_BufferSize          = intitem->dmaframecapacity;
+    dmainit.DMA_PeripheralInc       = DMA_PeripheralInc_Disable;
+    dmainit.DMA_MemoryInc           = DMA_MemoryInc_Enable;
+    dmainit.DMA_PeripheralDataSize  = DMA_PeripheralDataSize_Byte;
+    dmainit.DMA_MemoryDataSize      = DMA_MemoryDataSize_Byte;
+    dmainit.DMA_Mode                = DMA_Mode_Normal;
+    dmainit.DMA_FIFOMode            = DMA_FIFOMode_Disable;
+    dmainit.DMA_MemoryBurst         = DMA_MemoryBurst_Single;
+    dmainit.DMA_PeripheralBurst     = DMA_PeripheralBurst_Single;
+    
+    // rx: from the spi to the frame being written. it has higher priority so that no byte is lost
+    DMA_DeInit(map->rxstream);
+    dmainit.DMA_Memory0BaseAddr     = (uint32_t)intitem->dmarxframes[0];
+    dmainit.DMA_DIR                 = DMA_DIR_PeripheralToMemory;
+    dmainit.DMA_Priority            = DMA_Priority_VeryHigh;
+    DMA_Init(map->rxstream, &dmainit);
+    
+    // tx: from the isrtxframe to the spi
+    DMA_DeInit(map->txstream);
+    dmainit.DMA_Memory0BaseAddr     = (uint32_t)intitem->isrtxframe;
+    dmainit.DMA_DIR                 = DMA_DIR_MemoryToPeripheral;
+    dmainit.DMA_Priority            = DMA_Priority_High;
+    DMA_Init(map->txstream, &dmainit);
+    
+    // only the end of the rx transfer, or its failure, raises an interrupt: the tx has surely finished before 
+    DMA_ITConfig(map->rxstream, DMA_IT_TC | DMA_IT_TE, ENABLE);
+    
+    hal_sys_irqn_priority_set(map->rxirqn, hal_int_priority02);
+    hal_sys_irqn_enable(map->rxirqn);
+}
+
+
+static void s_hal_spi_dma_start(hal_spi_t id)
+{
+    hal_spi_internal_item_t* intitem = s_hal_spi_theinternals.items[HAL_spi_id2index(id)];
+    const hal_spi_dmamap_t* map = &s_hal_spi_dmamap[HAL_spi_id2index(id)];
+    SPI_TypeDef* SPIx = HAL_spi_id2stmSPI(id);
+    
+    // the streams are disabled at end of every transfer. but if the previous transfer never completed (the caller gave
+    // up waiting for it) they are still enabled, and their registers are write protected: we stop them first.
+    if(ENABLE == DMA_GetCmdStatus(map->rxstream))
+    {
+        s_hal_spi_dma_stop(id);
+    }
+    
+    // we clear their flags and load them again
+    DMA_ClearFlag(map->rxstream, map->rxflags);
+    DMA_ClearFlag(map->txstream, map->txflags);
+    
+    map->rxstream->M0AR = (uint32_t)intitem->dmarxframes[intitem->dmarxwriting];
+    DMA_SetCurrDataCounter(map->rxstream, intitem->config.sizeofframe);
+    DMA_SetCurrDataCounter(map->txstream, intitem->config.sizeofframe);
+    
+    // remove a stale byte, if any, so that it does not become the first byte of the frame
+    if(SET == SPI_I2S_GetFlagStatus(SPIx, SPI_I2S_FLAG_RXNE))
+    {
+        SPI_I2S_ReceiveData(SPIx);
+    }
+    
+    // rx must be ready before tx generates the clock
+    DMA_Cmd(map->rxstream, ENABLE);
+    DMA_Cmd(map->txstream, ENABLE);
+    SPI_I2S_DMACmd(SPIx, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, ENABLE);
+    
+    s_hal_spi_periph_enable(id);
+}
+
+
+static void s_hal_spi_dma_stop(hal_spi_t id)
+{
+    const hal_spi_dmamap_t* map = &s_hal_spi_dmamap[HAL_spi_id2index(id)];
+    SPI_TypeDef* SPIx = HAL_spi_id2stmSPI(id);
+    
+    s_hal_spi_periph_disable(id);
+    SPI_I2S_DMACmd(SPIx, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, DISABLE);
+    DMA_Cmd(map->rxstream, DISABLE);
+    DMA_Cmd(map->txstream, DISABLE);
+}
+
+
+static void s_hal_spi_dma_rx_isr(hal_spi_t id)
+{
+    hal_spi_internal_item_t* intitem = s_hal_spi_theinternals.items[HAL_spi_id2index(id)];
+    const hal_spi_dmamap_t* map = &s_hal_spi_dmamap[HAL_spi_id2index(id)];
+    
+    hal_bool_t failed = hal_false;
+    
+    if(SET == DMA_GetITStatus(map->rxstream, map->rxiterror))
+    {
+        DMA_ClearITPendingBit(map->rxstream, map->rxiterror);
+        failed = hal_true;
+    }
+    else if(SET == DMA_GetITStatus(map->rxstream, map->rxitdone))
+    {
+        DMA_ClearITPendingBit(map->rxstream, map->rxitdone);
+    }
+    else
+    {
+        return;
+    }
+    
+    if((NULL == intitem) || (hal_false == intitem->dmaisused))
+    {
+        return;
+    }
+    
+    // ok. the frame is finished (or the transfer has failed): stop spi and streams
+    s_hal_spi_dma_stop(id);
+    
+    if(hal_false == failed)
+    {   // the frame just written becomes the available one and the next transfer goes into the other buffer
+        intitem->dmarxwriting = 1 - intitem->dmarxwriting;
+        intitem->dmarxavailable = hal_true;
+    }
+    else
+    {   // no frame: the callback is called anyway, so that the chain of reads goes on, but hal_spi_get() gives nodata
+        intitem->dmarxavailable = hal_false;
+    }
+    
+    intitem->frameburstcountdown = 0;
+    
+    // erase the isrtxframe
+    memset(intitem->isrtxframe, 0, intitem->config.sizeofframe);
+    
+    // now manage the callback
+    hal_callback_t onframereceiv = intitem->config.onframereceiv;
+    void *arg = intitem->config.argonframereceiv;     
+    if(NULL != onframereceiv)
+    {
+        onframereceiv(arg);
+    }
+}
+
+#else//defined(HAL_USE_MPU_TYPE_STM32F4)
+
+// the dma streams are mapped only for the stm32f4: the other mpus keep the isr mode
+static hal_bool_t s_hal_spi_dma_supported_is(hal_spi_t id)
+{
+    return(hal_false);
+}
+
+static void s_hal_spi_dma_init(hal_spi_t id) {}
+static void s_hal_spi_dma_start(hal_spi_t id) {}
+static void s_hal_spi_dma_stop(hal_spi_t id) {}
+static void s_hal_spi_dma_rx_isr(hal_spi_t id) {}
+
+#endif//defined(HAL_USE_MPU_TYPE_STM32F4)
+
 #endif//HAL_USE_SPI
 
 // --------------------------------------------------------------------------------------------------------------------
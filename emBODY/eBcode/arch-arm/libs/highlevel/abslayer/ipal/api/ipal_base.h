@@ -261,6 +261,11 @@ typedef struct
     const char * usr_tnet_welcome_msg;
     /** The string contains the prompt of telnet. If NULL the default is used */
     const char * usr_tnet_prompt;
+
+    /** The function is executed before the received frames are processed so that the ETH ISR has spare frames to
+        receive without copying. Use the HAL version hal_eth_rx_refill(). If NULL the ETH ISR copies every frame.
+        It is the last field so that the layout of the fields before it is the one of the libraries built before it. */
+    ipal_result_t  (*hal_eth_rxrefill)(void);
     
 
 
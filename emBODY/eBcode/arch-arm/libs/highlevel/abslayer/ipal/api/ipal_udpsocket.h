@@ -190,6 +190,35 @@ extern ipal_result_t ipal_udpsocket_sendto(ipal_udpsocket_t* skt, ipal_packet_t
 extern ipal_result_t ipal_udpsocket_send(ipal_udpsocket_t* skt, ipal_packet_t *pckt);
 
 
+/** @fn         extern uint8_t* ipal_udpsocket_getbuffer(ipal_udpsocket_t* skt, uint16_t capacity)
+    @brief      Borrows from the IP stack a transmission buffer able to contain @e capacity bytes of UDP payload, so that
+                the user can form the datagram directly inside it without the copy done by ipal_udpsocket_sendto().
+                The buffer must always be given back with ipal_udpsocket_commit() or by deleting the socket with
+                ipal_udpsocket_delete(). A socket can borrow only one buffer at a time.
+    @param      skt             The pointer to a valid UDP socket already bound to a local address.
+    @param      capacity        The maximum size of the datagram which will be formed in the buffer.
+    @return     The pointer to the buffer or NULL upon failure (not bound socket, buffer already borrowed, no memory).
+ **/
+extern uint8_t* ipal_udpsocket_getbuffer(ipal_udpsocket_t* skt, uint16_t capacity);
+
+
+/** @fn         extern ipal_result_t ipal_udpsocket_commit(ipal_udpsocket_t* skt, uint8_t *buffer, uint16_t size, 
+                                                               ipal_ipv4addr_t remaddr, ipal_port_t remport)
+    @brief      Sends to a remote host the first @e size bytes of a buffer borrowed with ipal_udpsocket_getbuffer() and
+                gives the buffer back to the IP stack. The buffer cannot be used anymore after this call, also in case of
+                failure.
+    @param      skt             The pointer to the UDP socket which has borrowed the buffer.
+    @param      buffer          The buffer returned by ipal_udpsocket_getbuffer().
+    @param      size            The size of the datagram. It must be non zero and not higher than the borrowed capacity.
+    @param      remaddr         The destination IP address.
+    @param      remport         The destination IP port.
+    @return     ipal_res_OK on success or ipal_res_NOK_generic upon failure.
+    @warning    The transmission may fail if the MAC address associated to the remote IP has not been discovered yet
+                with a previous call to ipal_arp_request().
+ **/
+extern ipal_result_t ipal_udpsocket_commit(ipal_udpsocket_t* skt, uint8_t *buffer, uint16_t size, ipal_ipv4addr_t remaddr, ipal_port_t remport);
+
+
 /** @fn         extern ipal_result_t ipal_udpsocket_recv(ipal_udpsocket_t* skt, ipal_udp_recv_fn recv, void *arg) 
     @brief      It specifies a callback function to be used upon reception of a packet on the a UDP socket bound to a
                 local IP address and port. The callback is internally called by IPAL only if the received packet is 
@@ -49,7 +49,7 @@
 // - declaration of extern hidden interface 
 // --------------------------------------------------------------------------------------------------------------------
 
-//#include "ipal_f_udp_hid.h"
+#include "ipal_f_udp_hid.h"
 
 // --------------------------------------------------------------------------------------------------------------------
 // - #define with internal scope
@@ -81,6 +81,7 @@ struct ipal_udpsocket_opaque_t
 // - declaration of static functions
 // --------------------------------------------------------------------------------------------------------------------
 
+static uint8_t s_ipal_f_udp_loss_now(void);
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -89,6 +90,16 @@ struct ipal_udpsocket_opaque_t
 
 static struct ipal_udpsocket_opaque_t s_ipal_f_udp_socket = {0};
 
+// the fake stack has a single transmission buffer which holds the last datagram
+static uint8_t s_ipal_f_udp_txbuffer[IPAL_F_UDP_TXBUFFERSIZE] = {0};
+static uint16_t s_ipal_f_udp_txsize = 0;
+static uint8_t s_ipal_f_udp_txborrowed = 0;
+
+static ipal_f_udp_hid_statistics_t s_ipal_f_udp_statistics = {0};
+
+static uint32_t s_ipal_f_udp_loss_oneevery = 0;
+static uint32_t s_ipal_f_udp_loss_counter = 0;
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern public functions
 // --------------------------------------------------------------------------------------------------------------------
@@ -102,6 +113,8 @@ extern ipal_udpsocket_t* ipal_udpsocket_new(ipal_tos_t tos)
 
 extern ipal_result_t ipal_udpsocket_delete(ipal_udpsocket_t* skt)
 {  
+    // as the real stacks, it gives back the buffer borrowed with ipal_udpsocket_getbuffer()
+    s_ipal_f_udp_txborrowed = 0;
     return(ipal_res_OK);
 } 
 
@@ -126,15 +139,77 @@ extern ipal_result_t ipal_udpsocket_disconnect(ipal_udpsocket_t* skt)
 
 extern ipal_result_t ipal_udpsocket_send(ipal_udpsocket_t* skt, ipal_packet_t *pckt)
 {
-    return(ipal_res_OK);
+    return(ipal_udpsocket_sendto(skt, pckt, skt->remaddr, skt->remport));
 } 
 
 extern ipal_result_t ipal_udpsocket_sendto(ipal_udpsocket_t* skt, ipal_packet_t *pckt, ipal_ipv4addr_t remaddr, ipal_port_t remport)
 {
+    if((NULL == skt) || (NULL == pckt) || (NULL == pckt->data) || (0 == pckt->size) || (pckt->size > IPAL_F_UDP_TXBUFFERSIZE) || (0 != s_ipal_f_udp_txborrowed))
+    {
+        return(ipal_res_NOK_generic);
+    }
+    
+    s_ipal_f_udp_statistics.datagrams ++;
+    s_ipal_f_udp_statistics.bytes += pckt->size;
+    
+    if(1 == s_ipal_f_udp_loss_now())
+    {
+        s_ipal_f_udp_statistics.dropped ++;
+        return(ipal_res_OK);
+    }
+    
+    // as the real stacks do, we copy the payload into the buffer of the stack
+    memcpy(s_ipal_f_udp_txbuffer, pckt->data, pckt->size);
+    s_ipal_f_udp_txsize = pckt->size;
+    
+    s_ipal_f_udp_statistics.copiedbytes += pckt->size;
+    
     return(ipal_res_OK);
 } 
 
 
+extern uint8_t* ipal_udpsocket_getbuffer(ipal_udpsocket_t* skt, uint16_t capacity)
+{
+    if((NULL == skt) || (0 == capacity) || (capacity > IPAL_F_UDP_TXBUFFERSIZE) || (0 != s_ipal_f_udp_txborrowed))
+    {
+        return(NULL);
+    }
+    
+    s_ipal_f_udp_txborrowed = 1;
+    return(s_ipal_f_udp_txbuffer);
+}
+
+
+extern ipal_result_t ipal_udpsocket_commit(ipal_udpsocket_t* skt, uint8_t *buffer, uint16_t size, ipal_ipv4addr_t remaddr, ipal_port_t remport)
+{
+    if((NULL == skt) || (s_ipal_f_udp_txbuffer != buffer) || (0 == s_ipal_f_udp_txborrowed))
+    {
+        return(ipal_res_NOK_generic);
+    }
+    
+    s_ipal_f_udp_txborrowed = 0;
+    
+    if((0 == size) || (size > IPAL_F_UDP_TXBUFFERSIZE))
+    {
+        return(ipal_res_NOK_generic);
+    }
+    
+    s_ipal_f_udp_statistics.datagrams ++;
+    s_ipal_f_udp_statistics.bytes += size;
+    
+    if(1 == s_ipal_f_udp_loss_now())
+    {
+        s_ipal_f_udp_statistics.dropped ++;
+        return(ipal_res_OK);
+    }
+    
+    // the datagram is already inside the buffer of the stack: no copy
+    s_ipal_f_udp_txsize = size;
+    
+    return(ipal_res_OK);
+}
+
+
 extern ipal_result_t ipal_udpsocket_recv(ipal_udpsocket_t* skt, ipal_udp_recv_fn recv, void *arg)
 {
     return(ipal_res_OK); 
@@ -145,6 +220,37 @@ extern ipal_result_t ipal_udpsocket_recv(ipal_udpsocket_t* skt, ipal_udp_recv_fn
 // - definition of extern hidden functions 
 // --------------------------------------------------------------------------------------------------------------------
 
+extern void ipal_f_udp_hid_statistics_get(ipal_f_udp_hid_statistics_t *stats)
+{
+    if(NULL != stats)
+    {
+        memcpy(stats, &s_ipal_f_udp_statistics, sizeof(ipal_f_udp_hid_statistics_t));
+    }
+}
+
+
+extern void ipal_f_udp_hid_statistics_reset(void)
+{
+    memset(&s_ipal_f_udp_statistics, 0, sizeof(ipal_f_udp_hid_statistics_t));
+}
+
+
+extern const uint8_t * ipal_f_udp_hid_lastdatagram_get(uint16_t *size)
+{
+    if(NULL != size)
+    {
+        *size = s_ipal_f_udp_txsize;
+    }
+    return(s_ipal_f_udp_txbuffer);
+}
+
+
+extern void ipal_f_udp_hid_loss_set(uint32_t oneevery)
+{
+    s_ipal_f_udp_loss_oneevery = oneevery;
+    s_ipal_f_udp_loss_counter = 0;
+}
+
 
 
 
@@ -152,6 +258,21 @@ extern ipal_result_t ipal_udpsocket_recv(ipal_udpsocket_t* skt, ipal_udp_recv_fn
 // - definition of static functions 
 // --------------------------------------------------------------------------------------------------------------------
 
+static uint8_t s_ipal_f_udp_loss_now(void)
+{
+    if(0 == s_ipal_f_udp_loss_oneevery)
+    {
+        return(0);
+    }
+    
+    if(++s_ipal_f_udp_loss_counter < s_ipal_f_udp_loss_oneevery)
+    {
+        return(0);
+    }
+    
+    s_ipal_f_udp_loss_counter = 0;
+    return(1);
+}
 
 
 #endif//IPAL_USE_UDP
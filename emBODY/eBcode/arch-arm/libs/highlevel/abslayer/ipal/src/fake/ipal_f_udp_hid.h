@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// - include guard ----------------------------------------------------------------------------------------------------
+#ifndef _IPAL_F_UDP_HID_H_
+#define _IPAL_F_UDP_HID_H_
+
+
+/* @file       ipal_f_udp_hid.h
+	@brief      This file implements hidden interface of the fake ipal udp module
+	@author     agent@local
+    @date       10/18/2026
+**/
+
+
+// - external dependencies --------------------------------------------------------------------------------------------
+// empty-section
+
+
+
+// - declaration of extern public interface ---------------------------------------------------------------------------
+
+#include "ipal.h"
+
+
+
+// - #define used with hidden struct ----------------------------------------------------------------------------------
+
+// the size of the transmission buffer of the fake stack. it is the max udp payload in a non fragmented eth frame
+#define IPAL_F_UDP_TXBUFFERSIZE     1472
+
+
+// - definition of the hidden struct implementing the object ----------------------------------------------------------
+
+/* @typedef    typedef struct ipal_f_udp_hid_statistics_t
+    @brief      It counts what the fake stack does in transmission, so that a test can measure how many times the
+                payload is copied on its way to the wire.
+ **/
+typedef struct
+{
+    uint32_t    datagrams;      // number of datagrams given to the fake stack
+    uint32_t    bytes;          // their total size
+    uint32_t    copiedbytes;    // bytes copied by ipal into the buffer of the stack. zero if only ipal_udpsocket_commit() is used
+    uint32_t    dropped;        // datagrams accepted but lost on purpose. see ipal_f_udp_hid_loss_set()
+} ipal_f_udp_hid_statistics_t;
+
+
+// - declaration of extern hidden variables ---------------------------------------------------------------------------
+// empty-section
+
+// - declaration of extern hidden functions ---------------------------------------------------------------------------
+
+extern void ipal_f_udp_hid_statistics_get(ipal_f_udp_hid_statistics_t *stats);
+
+extern void ipal_f_udp_hid_statistics_reset(void);
+
+// it gives the last datagram given to the fake stack. a dropped datagram does not change it
+extern const uint8_t * ipal_f_udp_hid_lastdatagram_get(uint16_t *size);
+
+// it makes the fake stack lose one datagram every oneevery of them, as a lossy network would do. the transmission
+// functions still return ipal_res_OK for the lost datagrams. zero disables the losses, which is the default
+extern void ipal_f_udp_hid_loss_set(uint32_t oneevery);
+
+
+
+#endif  // include guard
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
+
+
+
+
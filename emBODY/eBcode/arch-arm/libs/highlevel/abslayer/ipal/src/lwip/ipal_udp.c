@@ -92,6 +92,7 @@ struct ipal_udpsocket_opaque_t
     ipal_udp_recv_fn    recv;
     void*               arg;
     struct udp_pcb      *pcb_ptr;
+    struct pbuf         *txpbuf;        // the pbuf borrowed with ipal_udpsocket_getbuffer() or NULL
 };
 
 struct  s_ipal_arrayofudpsocket
@@ -176,6 +177,7 @@ extern ipal_udpsocket_t* ipal_udpsocket_new(ipal_tos_t tos)
     s_ipal_udp_udpsockets[id].recv      = NULL;
     s_ipal_udp_udpsockets[id].arg       = NULL;
     s_ipal_udp_udpsockets[id].pcb_ptr   = pcb;
+    s_ipal_udp_udpsockets[id].txpbuf    = NULL;
     
     
     if(NULL == receive_buff)
@@ -202,6 +204,10 @@ extern ipal_result_t ipal_udpsocket_delete(ipal_udpsocket_t* skt)
 
     udp_remove(skt->pcb_ptr);
     
+    if(NULL != skt->txpbuf)
+    {
+        pbuf_free(skt->txpbuf);
+    }
 
     skt->id         = SOCKET_ID_NULL;
     skt->locport    = 0;
@@ -211,6 +217,7 @@ extern ipal_result_t ipal_udpsocket_delete(ipal_udpsocket_t* skt)
     skt->recv       = NULL;
     skt->arg        = NULL;
     skt->pcb_ptr    = NULL;
+    skt->txpbuf     = NULL;
 
     ipal_base_hid_threadsafety_unlock();
     
@@ -396,6 +403,58 @@ extern ipal_result_t ipal_udpsocket_sendto(ipal_udpsocket_t* skt, ipal_packet_t
 } 
 
 
+extern uint8_t* ipal_udpsocket_getbuffer(ipal_udpsocket_t* skt, uint16_t capacity)
+{
+    struct pbuf *internalbuffer;
+    
+    if((NULL == skt) || (SOCKET_ID_NULL == skt->id) || (0 == skt->locport) || (NULL != skt->txpbuf) || (0 == capacity))
+    {   // fails also if no bind has been done before or if a buffer is already borrowed
+        return(NULL);
+    }
+
+    ipal_base_hid_threadsafety_lock();
+
+    // PBUF_RAM gives a single pbuf w/ contiguous payload, whereas PBUF_POOL may give a chain
+    internalbuffer = pbuf_alloc(PBUF_TRANSPORT, capacity, PBUF_RAM);
+    skt->txpbuf = internalbuffer;
+    
+    ipal_base_hid_threadsafety_unlock();
+    
+    return((NULL == internalbuffer) ? (NULL) : ((uint8_t*)internalbuffer->payload));
+}
+
+
+extern ipal_result_t ipal_udpsocket_commit(ipal_udpsocket_t* skt, uint8_t *buffer, uint16_t size, ipal_ipv4addr_t remaddr, ipal_port_t remport)
+{
+    struct pbuf *internalbuffer;
+    struct ip_addr ipaddr;
+    err_t err = ERR_VAL;
+    
+    if((NULL == skt) || (SOCKET_ID_NULL == skt->id) || (NULL == buffer) || (NULL == skt->txpbuf) || (buffer != skt->txpbuf->payload))
+    {   
+        return(ipal_res_NOK_generic);
+    }
+
+    ipal_base_hid_threadsafety_lock();
+    
+    internalbuffer = skt->txpbuf;
+    skt->txpbuf = NULL;
+    
+    if((0 != size) && (size <= internalbuffer->tot_len))
+    {
+        pbuf_realloc(internalbuffer, size);
+        ipaddr.addr = ipal2lwip_ipv4addr(remaddr);
+        err = udp_sendto(skt->pcb_ptr, internalbuffer, &ipaddr, remport);
+    }
+    
+    pbuf_free(internalbuffer);
+    
+    ipal_base_hid_threadsafety_unlock();
+
+    return( (ERR_OK != err) ? ipal_res_NOK_generic : ipal_res_OK );
+}
+
+
 extern ipal_result_t ipal_udpsocket_recv(ipal_udpsocket_t* skt, ipal_udp_recv_fn recv, void *arg)
 {
     if((NULL == skt) || (NULL == recv))
@@ -130,6 +130,11 @@ extern void ipal_sys_process_communication(void)
 {                           
     ipal_base_hid_threadsafety_lock();
     
+    if(NULL != ipal_base_hid_cfg.extfn.hal_eth_rxrefill)
+    {
+        ipal_base_hid_cfg.extfn.hal_eth_rxrefill();
+    }
+    
     main_TcpNet();
     
     ipal_base_hid_threadsafety_unlock();
@@ -83,6 +83,8 @@ struct ipal_udpsocket_opaque_t
     uint32_t            remaddr;
     ipal_udp_recv_fn    recv;
     void*               arg;
+    uint8_t*            txbuffer;       // the buffer borrowed with ipal_udpsocket_getbuffer() or NULL
+    uint16_t            txcapacity;
 };
 
 
@@ -139,6 +141,8 @@ extern ipal_udpsocket_t* ipal_udpsocket_new(ipal_tos_t tos)
     s_ipal_udp_udpsockets[n-1].remaddr   = 0;
     s_ipal_udp_udpsockets[n-1].recv      = NULL;
     s_ipal_udp_udpsockets[n-1].arg       = NULL;
+    s_ipal_udp_udpsockets[n-1].txbuffer  = NULL;
+    s_ipal_udp_udpsockets[n-1].txcapacity= 0;
 
     ipal_base_hid_threadsafety_unlock();
 
@@ -158,6 +162,14 @@ extern ipal_result_t ipal_udpsocket_delete(ipal_udpsocket_t* skt)
 
     ipal_base_hid_threadsafety_lock();
 
+    if(NULL != skt->txbuffer)
+    {   // give back the buffer borrowed with ipal_udpsocket_getbuffer(). tcpnet has no function to free it, but
+        // udp_send() releases it also when it fails, thus we make it fail with zero length as ipal_udpsocket_commit() does
+        uint8_t noaddr[4] = {0};
+        udp_send(skt->id, noaddr, 0, skt->txbuffer, 0);
+        skt->txbuffer = NULL;
+    }
+
     if(0 != skt->locport)
     {   // need to close the socket first
         udp_close(skt->id);
@@ -175,6 +187,8 @@ extern ipal_result_t ipal_udpsocket_delete(ipal_udpsocket_t* skt)
     skt->remaddr  = 0;
     skt->recv       = NULL;
     skt->arg        = NULL;
+    skt->txbuffer   = NULL;
+    skt->txcapacity = 0;
 
     ipal_base_hid_threadsafety_unlock();
     
@@ -332,6 +346,60 @@ extern ipal_result_t ipal_udpsocket_sendto(ipal_udpsocket_t* skt, ipal_packet_t
 } 
 
 
+extern uint8_t* ipal_udpsocket_getbuffer(ipal_udpsocket_t* skt, uint16_t capacity)
+{
+    uint8_t *internalbuffer = NULL;
+
+    if((NULL == skt) || (0 == skt->id) || (0 == skt->locport) || (NULL != skt->txbuffer) || (0 == capacity))
+    {   // fails also if no bind has been done before or if a buffer is already borrowed
+        return(NULL);
+    }
+
+    ipal_base_hid_threadsafety_lock();
+
+    // the buffer of tcpnet is ours until udp_send() is called, thus we dont keep the lock in the meantime
+    internalbuffer = udp_get_buf(capacity);
+    
+    if(NULL != internalbuffer)
+    {
+        skt->txbuffer   = internalbuffer;
+        skt->txcapacity = capacity;
+    }
+
+    ipal_base_hid_threadsafety_unlock();
+
+    return(internalbuffer);
+}
+
+
+extern ipal_result_t ipal_udpsocket_commit(ipal_udpsocket_t* skt, uint8_t *buffer, uint16_t size, ipal_ipv4addr_t remaddr, ipal_port_t remport)
+{
+    uint8_t *toiparray = (uint8_t*)&remaddr;
+    ipal_result_t res;
+
+    if((NULL == skt) || (0 == skt->id) || (NULL == buffer) || (buffer != skt->txbuffer))
+    {   
+        return(ipal_res_NOK_generic);
+    }
+
+    ipal_base_hid_threadsafety_lock();
+    
+    skt->txbuffer = NULL;
+    
+    // tcpnet releases the buffer inside udp_send() also when it fails, thus with a wrong size we make it fail with zero length
+    if(size > skt->txcapacity)
+    {
+        size = 0;
+    }
+    
+    res = (__FALSE == udp_send(skt->id, toiparray, remport, buffer, size)) ? (ipal_res_NOK_generic) : (ipal_res_OK); 
+
+    ipal_base_hid_threadsafety_unlock();
+
+    return(res);
+}
+
+
 extern ipal_result_t ipal_udpsocket_recv(ipal_udpsocket_t* skt, ipal_udp_recv_fn recv, void *arg)
 {
     if((NULL == skt) || (NULL == recv))
@@ -45,6 +45,13 @@
     
     The content of window depends on the used calls of this SW package. 
     
+    The event viewer can also keep a binary trace in a ring of RAM which does not need any debugger. Each item of the
+    trace has a 32-bit timestamp, a 16-bit id and a 16-bit argument. When the trace is enabled, every call of
+    eventviewer_switch_to() adds an item whose id is the new entity and whose arg is the previous one, so that task
+    switches and ISRs are recorded. Other events (phases of the runner, can and eth traffic, etc.) are added with
+    eventviewer_trace_put(). The ring is read in chunks with eventviewer_trace_dump(), which can be sent over udp and
+    decoded on the host with tools/eventviewer-decode.c.
+    
     @{        
  **/
 
@@ -56,7 +63,9 @@
 
 
 // - public #define  --------------------------------------------------------------------------------------------------
-// empty-section
+
+#define EVENTVIEWER_TRACE_MAGIC         0x52545645      /**< it is "EVTR" in little endian */
+#define EVENTVIEWER_TRACE_VERSION       1
   
 
 // - declaration of public user-defined types ------------------------------------------------------------------------- 
@@ -97,6 +106,71 @@ typedef uint8_t evEntityId_t;
     @brief      the type used for the name to be displayed on uv4.               
  **/
 typedef void (*evEntityName_t)(void); 
+
+
+/** @typedef    typedef uint16_t evTraceId_t
+    @brief      contains the id of an item of the trace. the values from 0 to 255 are the evEntityId_t values used by 
+                eventviewer_switch_to(), the others are in @e ev_TRACE_IDs_t.               
+ **/
+typedef uint16_t evTraceId_t;
+
+
+/** @typedef    typedef enum ev_TRACE_IDs_t
+    @brief      contains the IDs of the trace items which are not an entity switch. The phases of the runner use a
+                begin id and an end id equal to begin + 1.
+ **/
+typedef enum
+{
+    ev_TRACE_ID_runner_rx_begin     = 0x0100,   /**< arg is the number of the cycle */
+    ev_TRACE_ID_runner_rx_end       = 0x0101,
+    ev_TRACE_ID_runner_do_begin     = 0x0102,
+    ev_TRACE_ID_runner_do_end       = 0x0103,
+    ev_TRACE_ID_runner_tx_begin     = 0x0104,
+    ev_TRACE_ID_runner_tx_end       = 0x0105,
+    ev_TRACE_ID_can_rx              = 0x0110,   /**< arg is the can port in the msb and the size in the lsb */
+    ev_TRACE_ID_can_tx              = 0x0111,   /**< arg is the can port in the msb and the size in the lsb */
+    ev_TRACE_ID_eth_rx              = 0x0120,   /**< arg is the size of the frame */
+    ev_TRACE_ID_eth_tx              = 0x0121,   /**< arg is the size of the frame */
+    ev_TRACE_ID_first_usrdef        = 0x1000    /**< use this and successive for user-defined events */
+} ev_TRACE_IDs_t;
+
+
+/** @typedef    typedef struct evTraceItem_t
+    @brief      an item of the trace.               
+ **/
+typedef struct
+{
+    uint32_t        time;       /**< the timestamp in ticks of the timestamp function */
+    uint16_t        id;         /**< an evTraceId_t */
+    uint16_t        arg;        /**< its argument */
+} evTraceItem_t;
+
+
+/** @typedef    typedef struct evTraceCfg_t
+    @brief      the configuration of the trace.               
+ **/
+typedef struct
+{
+    evTraceItem_t*  ring;               /**< the memory of the ring */
+    uint16_t        capacity;           /**< the number of items in the ring. it must be a power of two */
+    uint32_t        (*timestamp)(void); /**< the time source. if NULL it is used the cycle counter of the DWT */
+    uint32_t        tickspersecond;     /**< the frequency of the time source, typically the core clock */
+} evTraceCfg_t;
+
+
+/** @typedef    typedef struct evTraceDumpHeader_t
+    @brief      the header of a chunk produced by eventviewer_trace_dump(). it is followed by @e number items. all the
+                fields are little endian.
+ **/
+typedef struct
+{
+    uint32_t        magic;              /**< EVENTVIEWER_TRACE_MAGIC */
+    uint8_t         version;            /**< EVENTVIEWER_TRACE_VERSION */
+    uint8_t         sizeofitem;         /**< sizeof(evTraceItem_t) */
+    uint16_t        number;             /**< the number of items which follow */
+    uint32_t        tickspersecond;     /**< the frequency of the timestamps */
+    uint32_t        sequence;           /**< the sequence number of the first item since the init of the trace */
+} evTraceDumpHeader_t;
  
 // - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
 // empty-section
@@ -138,6 +212,42 @@ extern void eventviewer_unload(evEntityId_t id, evEntityName_t name);
     @return     the previous ID 
  **/
 extern evEntityId_t eventviewer_switch_to(evEntityId_t id);
+
+
+/** @fn         extern evResult_t eventviewer_trace_init(const evTraceCfg_t *cfg)
+    @brief      initialises the binary trace in RAM. it does not need the debugger. the trace starts disabled.
+    @param      cfg         the configuration. the ring must be not NULL and its capacity a power of two.
+    @return     ev_res_OK upon success or ev_res_NOK_generic if the configuration is wrong.
+ **/
+extern evResult_t eventviewer_trace_init(const evTraceCfg_t *cfg);
+
+
+/** @fn         extern void eventviewer_trace_enable(uint8_t on)
+    @brief      enables or disables the recording of the trace. if not initted it does nothing.
+    @param      on          1 to enable, 0 to disable.
+ **/
+extern void eventviewer_trace_enable(uint8_t on);
+
+
+/** @fn         extern void eventviewer_trace_put(evTraceId_t id, uint16_t arg)
+    @brief      adds an item to the trace. when the ring is full it overwrites the oldest item. it can be called by 
+                tasks and by ISRs. if not initted or not enabled it does nothing.
+    @param      id          the id of the event
+    @param      arg         its argument
+ **/
+extern void eventviewer_trace_put(evTraceId_t id, uint16_t arg);
+
+
+/** @fn         extern uint16_t eventviewer_trace_dump(uint8_t *buffer, uint16_t capacity, uint32_t *cursor)
+    @brief      copies into a buffer a chunk of the trace made of an evTraceDumpHeader_t and of the items which follow 
+                @e cursor. the items already overwritten are skipped, and the decoder sees that by the sequence in
+                the header. to read the whole ring, start with cursor at zero and call it until it returns 0.
+    @param      buffer      the destination, for instance the payload of a udp datagram.
+    @param      capacity    the size of the buffer. it must be able to contain the header and at least one item.
+    @param      cursor      the sequence number of the next item to read. it is updated by the function.
+    @return     the number of bytes written in buffer. it is 0 if there are no new items.
+ **/
+extern uint16_t eventviewer_trace_dump(uint8_t *buffer, uint16_t capacity, uint32_t *cursor);
  
  
  
@@ -30,6 +30,7 @@
 // --------------------------------------------------------------------------------------------------------------------
 
 #include "stdlib.h"
+#include "string.h"
 
  
 // --------------------------------------------------------------------------------------------------------------------
@@ -75,6 +76,11 @@ extern void evIDLE(void);
 #define ITM_PORT31_U16  (*((volatile uint16_t *)0xE000007C))
 #define ITM_PORT31_U8   (*((volatile uint8_t  *)0xE000007C))
 
+/* DWT registers */
+#define DWT_CTRL            (*((volatile uint32_t *)0xE0001000))
+#define DWT_CYCCNT          (*((volatile uint32_t *)0xE0001004))
+#define DWT_CTRL_CYCCNTENA  0x00000001
+
 #endif
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -87,11 +93,25 @@ extern void evIDLE(void);
 // - typedef with internal scope
 // --------------------------------------------------------------------------------------------------------------------
 
+typedef struct
+{
+    evTraceCfg_t        config;
+    uint32_t            mask;
+    volatile uint32_t   written;    // number of items written since init. it wraps around
+    volatile uint32_t   filled;     // number of valid items in the ring. it saturates at capacity
+    uint8_t             initted;
+    volatile uint8_t    enabled;
+} evTrace_t;
 
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of static functions
 // --------------------------------------------------------------------------------------------------------------------
 
+static uint32_t s_eventviewer_trace_cyclecounter_get(void);
+
+static uint32_t s_eventviewer_trace_lock(void);
+
+static void s_eventviewer_trace_unlock(uint32_t key);
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -101,6 +121,8 @@ extern void evIDLE(void);
 static evEntityId_t s_eventviewer_currentid = ev_ID_idle;
 static uint8_t s_eventviewer_initted = 0;
 
+static evTrace_t s_eventviewer_trace = { {NULL, 0, NULL, 0}, 0, 0, 0, 0, 0 };
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern public functions
@@ -162,6 +184,9 @@ extern evEntityId_t eventviewer_switch_to(evEntityId_t id)
     evEntityId_t prev = s_eventviewer_currentid;
     s_eventviewer_currentid = id;
     
+    // the trace does not need the debugger, hence it is filled also if the itm is not initted
+    eventviewer_trace_put(id, prev);
+    
     if(0 == s_eventviewer_initted)
     {
         return(prev);
@@ -174,8 +199,147 @@ extern evEntityId_t eventviewer_switch_to(evEntityId_t id)
 }
 
 
+extern evResult_t eventviewer_trace_init(const evTraceCfg_t *cfg)
+{
+    if((NULL == cfg) || (NULL == cfg->ring) || (0 == cfg->capacity) || (0 != (cfg->capacity & (cfg->capacity - 1))))
+    {
+        return(ev_res_NOK_generic);
+    }
+    
+    s_eventviewer_trace.enabled = 0;
+    
+    memcpy(&s_eventviewer_trace.config, cfg, sizeof(evTraceCfg_t));
+    s_eventviewer_trace.mask = cfg->capacity - 1;
+    s_eventviewer_trace.written = 0;
+    s_eventviewer_trace.filled = 0;
+    
+    if(NULL == s_eventviewer_trace.config.timestamp)
+    {
+#if defined(EVENTVIEWER_USE_CORTEX_M3M4)        
+        DEMCR |= DEMCR_TRCENA;
+        DWT_CYCCNT = 0;
+        DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+#endif        
+        s_eventviewer_trace.config.timestamp = s_eventviewer_trace_cyclecounter_get;
+    }
+    
+    s_eventviewer_trace.initted = 1;
+    
+    return(ev_res_OK);
+}
 
 
+extern void eventviewer_trace_enable(uint8_t on)
+{
+    if(0 == s_eventviewer_trace.initted)
+    {
+        return;
+    }
+    
+    s_eventviewer_trace.enabled = (0 == on) ? (0) : (1);
+}
+
+
+extern void eventviewer_trace_put(evTraceId_t id, uint16_t arg)
+{
+    evTraceItem_t *item = NULL;
+    uint32_t key = 0;
+    
+    if(0 == s_eventviewer_trace.enabled)
+    {
+        return;
+    }
+    
+    // the timestamp is taken inside the lock, so that the items in the ring are ordered in time also when an isr 
+    // preempts a task which is in here
+    key = s_eventviewer_trace_lock();
+    
+    item = &s_eventviewer_trace.config.ring[s_eventviewer_trace.written & s_eventviewer_trace.mask];
+    item->time = s_eventviewer_trace.config.timestamp();
+    item->id = id;
+    item->arg = arg;
+    
+    s_eventviewer_trace.written++;
+    if(s_eventviewer_trace.filled < s_eventviewer_trace.config.capacity)
+    {
+        s_eventviewer_trace.filled++;
+    }
+    
+    s_eventviewer_trace_unlock(key);
+}
+
+
+extern uint16_t eventviewer_trace_dump(uint8_t *buffer, uint16_t capacity, uint32_t *cursor)
+{
+    evTraceDumpHeader_t header;
+    uint8_t *items = NULL;
+    uint32_t written = 0;
+    uint32_t filled = 0;
+    uint32_t first = 0;
+    uint32_t number = 0;
+    uint32_t lost = 0;
+    uint32_t i = 0;
+    uint32_t key = 0;
+    
+    if((0 == s_eventviewer_trace.initted) || (NULL == buffer) || (NULL == cursor) || (capacity < (sizeof(evTraceDumpHeader_t) + sizeof(evTraceItem_t))))
+    {
+        return(0);
+    }
+    
+    key = s_eventviewer_trace_lock();
+    written = s_eventviewer_trace.written;
+    filled = s_eventviewer_trace.filled;
+    s_eventviewer_trace_unlock(key);
+    
+    // the arithmetic is modulo 2^32, so that it works also when the sequence number wraps around 
+    first = *cursor;
+    if((written - first) > filled)
+    {   // the items from first on were overwritten (or the cursor is beyond the written items): start from the oldest
+        first = written - filled;
+    }
+    
+    number = written - first;
+    if(number > ((capacity - sizeof(evTraceDumpHeader_t)) / sizeof(evTraceItem_t)))
+    {
+        number = (capacity - sizeof(evTraceDumpHeader_t)) / sizeof(evTraceItem_t);
+    }
+    
+    if(0 == number)
+    {
+        return(0);
+    }
+    
+    // the copy is done without the lock, so that the isrs are never delayed by the dump. the items overwritten
+    // during the copy are the oldest ones, hence we discard them at the end.
+    // the buffer may be not aligned, hence we use only memcpy() on it
+    items = buffer + sizeof(evTraceDumpHeader_t);
+    for(i=0; i<number; i++)
+    {
+        memcpy(&items[i*sizeof(evTraceItem_t)], &s_eventviewer_trace.config.ring[(first + i) & s_eventviewer_trace.mask], sizeof(evTraceItem_t));
+    }
+    
+    written = s_eventviewer_trace.written;
+    if((written - first) > s_eventviewer_trace.config.capacity)
+    {
+        lost = (written - first) - s_eventviewer_trace.config.capacity;
+        lost = (lost > number) ? (number) : (lost);
+        memmove(&items[0], &items[lost*sizeof(evTraceItem_t)], (number - lost) * sizeof(evTraceItem_t));
+        first += lost;
+        number -= lost;
+    }
+    
+    header.magic = EVENTVIEWER_TRACE_MAGIC;
+    header.version = EVENTVIEWER_TRACE_VERSION;
+    header.sizeofitem = sizeof(evTraceItem_t);
+    header.number = (uint16_t)number;
+    header.tickspersecond = s_eventviewer_trace.config.tickspersecond;
+    header.sequence = first;
+    memcpy(buffer, &header, sizeof(evTraceDumpHeader_t));
+    
+    *cursor = first + number;
+    
+    return((uint16_t)(sizeof(evTraceDumpHeader_t) + number * sizeof(evTraceItem_t)));
+}
 
 
 
@@ -197,7 +361,41 @@ extern void evIDLE(void)
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of static functions 
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+static uint32_t s_eventviewer_trace_cyclecounter_get(void)
+{
+#if defined(EVENTVIEWER_USE_CORTEX_M3M4)
+    return(DWT_CYCCNT);
+#else
+    return(0);
+#endif    
+}
+
+// the lock disables the isrs and restores the previous state, so that it can be used also inside an isr or inside
+// a critical section. __disable_irq() and __enable_irq() are proper of armcc compiler.
+static uint32_t s_eventviewer_trace_lock(void)
+{
+#if defined(EVENTVIEWER_USE_CORTEX_M3M4)
+    register uint32_t primask __asm("primask");
+    uint32_t key = primask;
+    __disable_irq();
+    return(key);
+#else
+    return(0);
+#endif    
+}
+
+static void s_eventviewer_trace_unlock(uint32_t key)
+{
+#if defined(EVENTVIEWER_USE_CORTEX_M3M4)
+    if(0 == key)
+    {
+        __enable_irq();
+    }
+#else
+    key = key;
+#endif    
+}
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,449 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+
+/* @file       eventviewer-decode.c
+    @brief      This file implements a linux command line tool which decodes the binary trace of the event viewer into
+                the json format of chrome://tracing and of https://ui.perfetto.dev
+    @author     agent@local
+    @date       10/18/2026
+    
+    build:      gcc -O2 -Wall -I../api -o eventviewer-decode eventviewer-decode.c
+    
+    usage:      eventviewer-decode [-o out.json] file1.bin [file2.bin ...]
+                eventviewer-decode [-o out.json] -u port [-t seconds]
+    
+    the input is a sequence of chunks produced by eventviewer_trace_dump(), either stored in files or received as 
+    udp datagrams on the given port until nothing arrives for the given seconds (default 2). the chunks can be 
+    duplicated or in any order because the items are sorted by their sequence number.
+**/
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+
+#include "eventviewer.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    int64_t         sequence;       // relative to the first received chunk
+    evTraceItem_t   item;
+} decodeItem_t;
+
+typedef struct
+{
+    decodeItem_t*   items;
+    size_t          number;
+    size_t          capacity;
+    uint32_t        tickspersecond;
+    uint32_t        base;           // the sequence of the first received chunk
+    int             based;
+} decodeTrace_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static int s_decode_chunk(decodeTrace_t *trace, const uint8_t *data, size_t size);
+static int s_decode_file(decodeTrace_t *trace, const char *filename);
+static int s_decode_udp(decodeTrace_t *trace, uint16_t port, int seconds);
+static int s_compare(const void *a, const void *b);
+static void s_entity_name(uint16_t id, char *name, size_t size);
+static void s_json_write(decodeTrace_t *trace, FILE *out);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    decodeTrace_t trace;
+    FILE *out = stdout;
+    const char *outname = NULL;
+    int port = -1;
+    int seconds = 2;
+    int opt = 0;
+    int i = 0;
+    
+    memset(&trace, 0, sizeof(trace));
+    
+    while(-1 != (opt = getopt(argc, argv, "o:u:t:h")))
+    {
+        switch(opt)
+        {
+            case 'o':   outname = optarg;           break;
+            case 'u':   port = atoi(optarg);        break;
+            case 't':   seconds = atoi(optarg);     break;
+            default:
+            {
+                fprintf(stderr, "usage: %s [-o out.json] file.bin [...]\n", argv[0]);
+                fprintf(stderr, "       %s [-o out.json] -u port [-t seconds]\n", argv[0]);
+                return(1);
+            }
+        }
+    }
+    
+    if(port > 0)
+    {
+        if(0 != s_decode_udp(&trace, (uint16_t)port, seconds))
+        {
+            return(1);
+        }
+    }
+    else if(optind >= argc)
+    {
+        fprintf(stderr, "%s: no input\n", argv[0]);
+        return(1);
+    }
+    
+    for(i=optind; i<argc; i++)
+    {
+        if(0 != s_decode_file(&trace, argv[i]))
+        {
+            return(1);
+        }
+    }
+    
+    if(0 == trace.number)
+    {
+        fprintf(stderr, "%s: no items in the trace\n", argv[0]);
+        return(1);
+    }
+    
+    if(NULL != outname)
+    {
+        if(NULL == (out = fopen(outname, "w")))
+        {
+            perror(outname);
+            return(1);
+        }
+    }
+    
+    qsort(trace.items, trace.number, sizeof(decodeItem_t), s_compare);
+    s_json_write(&trace, out);
+    
+    if(stdout != out)
+    {
+        fclose(out);
+    }
+    
+    free(trace.items);
+    
+    return(0);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+// it returns the number of bytes used by the chunk or -1 if it is not a valid chunk
+static int s_decode_chunk(decodeTrace_t *trace, const uint8_t *data, size_t size)
+{
+    evTraceDumpHeader_t header;
+    size_t i = 0;
+    
+    if(size < sizeof(evTraceDumpHeader_t))
+    {
+        return(-1);
+    }
+    
+    memcpy(&header, data, sizeof(evTraceDumpHeader_t));
+    
+    if((EVENTVIEWER_TRACE_MAGIC != header.magic) || (EVENTVIEWER_TRACE_VERSION != header.version) || 
+       (sizeof(evTraceItem_t) != header.sizeofitem) || 
+       (size < (sizeof(evTraceDumpHeader_t) + (size_t)header.number * sizeof(evTraceItem_t))))
+    {
+        return(-1);
+    }
+    
+    trace->tickspersecond = header.tickspersecond;
+    
+    // the sequence of the board is 32 bits and wraps around: we make it relative to the first chunk, assuming that
+    // no chunk is more than 2^31 items apart from it
+    if(0 == trace->based)
+    {
+        trace->base = header.sequence;
+        trace->based = 1;
+    }
+    
+    if((trace->number + header.number) > trace->capacity)
+    {
+        trace->capacity = 2 * (trace->number + header.number);
+        trace->items = realloc(trace->items, trace->capacity * sizeof(decodeItem_t));
+        if(NULL == trace->items)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+    
+    for(i=0; i<header.number; i++)
+    {
+        trace->items[trace->number].sequence = (int32_t)(header.sequence - trace->base) + (int64_t)i;
+        memcpy(&trace->items[trace->number].item, data + sizeof(evTraceDumpHeader_t) + i*sizeof(evTraceItem_t), sizeof(evTraceItem_t));
+        trace->number++;
+    }
+    
+    return((int)(sizeof(evTraceDumpHeader_t) + header.number * sizeof(evTraceItem_t)));
+}
+
+
+static int s_decode_file(decodeTrace_t *trace, const char *filename)
+{
+    FILE *f = NULL;
+    uint8_t *data = NULL;
+    long size = 0;
+    long pos = 0;
+    int used = 0;
+    
+    if(NULL == (f = fopen(filename, "rb")))
+    {
+        perror(filename);
+        return(-1);
+    }
+    
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    
+    data = malloc((size > 0) ? size : 1);
+    if((NULL == data) || (size != (long)fread(data, 1, size, f)))
+    {
+        fprintf(stderr, "%s: cannot read\n", filename);
+        fclose(f);
+        free(data);
+        return(-1);
+    }
+    fclose(f);
+    
+    while(pos < size)
+    {
+        if((used = s_decode_chunk(trace, data + pos, size - pos)) < 0)
+        {
+            fprintf(stderr, "%s: invalid chunk at offset %ld\n", filename, pos);
+            free(data);
+            return(-1);
+        }
+        pos += used;
+    }
+    
+    free(data);
+    return(0);
+}
+
+
+static int s_decode_udp(decodeTrace_t *trace, uint16_t port, int seconds)
+{
+    struct sockaddr_in addr;
+    struct timeval tout;
+    uint8_t datagram[2048];
+    ssize_t size = 0;
+    unsigned long chunks = 0;
+    int s = socket(AF_INET, SOCK_DGRAM, 0);
+    
+    if(s < 0)
+    {
+        perror("socket");
+        return(-1);
+    }
+    
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    
+    if(0 != bind(s, (struct sockaddr*)&addr, sizeof(addr)))
+    {
+        perror("bind");
+        close(s);
+        return(-1);
+    }
+    
+    tout.tv_sec = seconds;
+    tout.tv_usec = 0;
+    
+    // we wait forever for the first chunk, then we stop after seconds of silence
+    while((size = recv(s, datagram, sizeof(datagram), 0)) > 0)
+    {
+        if(s_decode_chunk(trace, datagram, size) < 0)
+        {
+            fprintf(stderr, "discarded a datagram of %zd bytes which is not a trace chunk\n", size);
+            continue;
+        }
+        if(0 == chunks++)
+        {
+            setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &tout, sizeof(tout));
+        }
+    }
+    
+    fprintf(stderr, "received %lu chunks\n", chunks);
+    close(s);
+    return(0);
+}
+
+
+static int s_compare(const void *a, const void *b)
+{
+    const decodeItem_t *ia = (const decodeItem_t*)a;
+    const decodeItem_t *ib = (const decodeItem_t*)b;
+    return((ia->sequence < ib->sequence) ? (-1) : ((ia->sequence > ib->sequence) ? (1) : (0)));
+}
+
+
+static void s_entity_name(uint16_t id, char *name, size_t size)
+{
+    if(ev_ID_idle == id)                { snprintf(name, size, "idle"); }
+    else if(id < ev_ID_first_usrdef)    { snprintf(name, size, "task %d", id - ev_ID_first_ostask + 1); }
+    else if(id < ev_ID_pendsv)          { snprintf(name, size, "user %d", id - ev_ID_first_usrdef); }
+    else if(ev_ID_pendsv == id)         { snprintf(name, size, "pendsv"); }
+    else if(ev_ID_systick == id)        { snprintf(name, size, "systick"); }
+    else if(ev_ID_svc == id)            { snprintf(name, size, "svc"); }
+    else                                { snprintf(name, size, "isr %d", id - ev_ID_first_isr); }
+}
+
+
+// the entities of eventviewer_switch_to() are threads of process 1, each one with slices for the time it runs.
+// the phases of the runner are slices of a thread of process 2, and the can and eth events are instant events of 
+// other threads of process 2. a gap in the sequence is shown as an instant event named "lost".
+static void s_json_write(decodeTrace_t *trace, FILE *out)
+{
+    static const char * const phases[] = {"rx", "rx", "do", "do", "tx", "tx"};
+    uint8_t used[256] = {0};
+    char name[32];
+    uint64_t time = 0;
+    uint64_t runningsince = 0;
+    uint16_t running = 0xffff;
+    uint32_t lasttime = 0;
+    int64_t lastsequence = 0;
+    double tickspermicro = (0 == trace->tickspersecond) ? (1.0) : ((double)trace->tickspersecond / 1000000.0);
+    const char *sep = "";
+    size_t i = 0;
+    
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    
+    for(i=0; i<trace->number; i++)
+    {
+        const evTraceItem_t *it = &trace->items[i].item;
+        
+        if((i > 0) && (trace->items[i].sequence == lastsequence))
+        {   // a duplicated chunk
+            continue;
+        }
+        
+        // the 32-bit timestamps are unwrapped assuming that two consecutive items are less than 2^32 ticks apart
+        if(0 == i)
+        {
+            time = it->time;
+        }
+        else
+        {
+            time += (uint32_t)(it->time - lasttime);
+            if(trace->items[i].sequence != (lastsequence + 1))
+            {
+                fprintf(out, "%s{\"name\":\"lost\",\"ph\":\"i\",\"s\":\"g\",\"pid\":2,\"tid\":0,\"ts\":%.3f,\"args\":{\"items\":%llu}}", 
+                        sep, time / tickspermicro, (unsigned long long)(trace->items[i].sequence - lastsequence - 1));
+                sep = ",\n";
+                running = 0xffff;
+            }
+        }
+        lasttime = it->time;
+        lastsequence = trace->items[i].sequence;
+        
+        if(it->id < 256)
+        {   // a switch of entity: close the slice of the previous one
+            if(0xffff != running)
+            {
+                s_entity_name(running, name, sizeof(name));
+                fprintf(out, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", 
+                        sep, name, running, runningsince / tickspermicro, (time - runningsince) / tickspermicro);
+                sep = ",\n";
+            }
+            running = it->id;
+            runningsince = time;
+            used[it->id] = 1;
+        }
+        else if((it->id >= ev_TRACE_ID_runner_rx_begin) && (it->id <= ev_TRACE_ID_runner_tx_end))
+        {
+            fprintf(out, "%s{\"name\":\"%s\",\"ph\":\"%s\",\"pid\":2,\"tid\":1,\"ts\":%.3f,\"args\":{\"cycle\":%u}}", 
+                    sep, phases[it->id - ev_TRACE_ID_runner_rx_begin], (0 == (it->id & 1)) ? "B" : "E", time / tickspermicro, it->arg);
+            sep = ",\n";
+        }
+        else if((ev_TRACE_ID_can_rx == it->id) || (ev_TRACE_ID_can_tx == it->id))
+        {
+            fprintf(out, "%s{\"name\":\"can%u %s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":2,\"tid\":2,\"ts\":%.3f,\"args\":{\"size\":%u}}", 
+                    sep, (it->arg >> 8) + 1, (ev_TRACE_ID_can_rx == it->id) ? "rx" : "tx", time / tickspermicro, it->arg & 0xff);
+            sep = ",\n";
+        }
+        else if((ev_TRACE_ID_eth_rx == it->id) || (ev_TRACE_ID_eth_tx == it->id))
+        {
+            fprintf(out, "%s{\"name\":\"eth %s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":2,\"tid\":3,\"ts\":%.3f,\"args\":{\"size\":%u}}", 
+                    sep, (ev_TRACE_ID_eth_rx == it->id) ? "rx" : "tx", time / tickspermicro, it->arg);
+            sep = ",\n";
+        }
+        else
+        {
+            fprintf(out, "%s{\"name\":\"0x%04x\",\"ph\":\"i\",\"s\":\"t\",\"pid\":2,\"tid\":4,\"ts\":%.3f,\"args\":{\"arg\":%u}}", 
+                    sep, it->id, time / tickspermicro, it->arg);
+            sep = ",\n";
+        }
+    }
+    
+    // the names of processes and threads
+    fprintf(out, "%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"cpu\"}}", sep);
+    fprintf(out, ",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"events\"}}");
+    fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":2,\"tid\":1,\"args\":{\"name\":\"runner\"}}");
+    fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":2,\"tid\":2,\"args\":{\"name\":\"can\"}}");
+    fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":2,\"tid\":3,\"args\":{\"name\":\"eth\"}}");
+    fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":2,\"tid\":4,\"args\":{\"name\":\"user\"}}");
+    for(i=0; i<256; i++)
+    {
+        if(1 == used[i])
+        {
+            s_entity_name((uint16_t)i, name, sizeof(name));
+            fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":\"%s\"}}", i, name);
+        }
+    }
+    
+    fprintf(out, "\n]}\n");
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
+
+
@@ -173,6 +173,19 @@ typedef struct
 extern hl_result_t hl_can_comm_init(hl_can_t id, const hl_can_comm_cfg_t *cfg);
 
 
+/** @fn         extern hl_result_t hl_can_comm_init_large(hl_can_t id, const hl_can_comm_cfg_t *cfg, uint16_t capacityofrxfifoofframes, uint16_t capacityoftxfifoofframes)
+    @brief      This function does what hl_can_comm_init() does but with rx and tx fifos of up to 65535 frames. The 
+                capacities inside @e cfg are not used. The numbers of frames given by hl_can_comm_received(), 
+                hl_can_comm_outgoing() and hl_can_comm_get() saturate at 255.
+    @param      id                          identifies CAN id   (CAN1 or CAN2)
+    @param      cfg                         the configuration of the can communication
+    @param      capacityofrxfifoofframes    the capacity of the rx fifo
+    @param      capacityoftxfifoofframes    the capacity of the tx fifo
+    @return     hl_res_NOK_generic in case of error, else hl_res_OK
+  */
+extern hl_result_t hl_can_comm_init_large(hl_can_t id, const hl_can_comm_cfg_t *cfg, uint16_t capacityofrxfifoofframes, uint16_t capacityoftxfifoofframes);
+
+
 /** @fn         extern hl_result_t hl_can_comm_deinit(hl_can_t id)
     @brief      This function de-inits communication over CAN and reverts what is done in hl_can_comm_init().
     @param      id              identifies CAN id   (CAN1 or CAN2)
@@ -220,7 +233,7 @@ extern hl_result_t hl_can_comm_transmit(hl_can_t id);
 /** @fn         extern hl_result_t hl_can_comm_received(hl_can_t id, uint8_t *numberof)
     @brief      This function gets number of frames in rx queue.
     @param      id              identifies CAN id (CAN1 or CAN2)
-    @param      numberof        contains numbers of frames.
+    @param      numberof        contains numbers of frames. it is saturated to 255.
     @return     hl_res_NOK_generic in case wrong id or NULL argument, else hl_res_OK.
   */
 extern hl_result_t hl_can_comm_received(hl_can_t id, uint8_t *numberof);
@@ -243,6 +256,18 @@ extern hl_result_t hl_can_comm_outgoing(hl_can_t id, uint8_t *numberof);
 extern hl_result_t hl_can_comm_get(hl_can_t id, hl_can_comm_frame_t *frame, uint8_t *remaining); 
 
 
+/** @fn         extern hl_result_t hl_can_comm_get_many(hl_can_t id, hl_can_comm_frame_t *frames, uint8_t max, uint8_t *read)
+    @brief      This function gets up to @e max frames from the rx queue, oldest first, with a single disable/enable of the
+                rx interrupt.
+    @param      id              identifies CAN id  CAN1 or CAN2)
+    @param      frames          pointer to memory where the function copies the received frames. it must hold max frames
+    @param      max             the maximum number of frames to get
+    @param      read            it returns the number of frames copied into frames. 
+    @return     hl_res_NOK_generic in case wrong id or NULL argument, hl_res_NOK_nodata in case of empty queue, else hl_res_OK.
+  */
+extern hl_result_t hl_can_comm_get_many(hl_can_t id, hl_can_comm_frame_t *frames, uint8_t max, uint8_t *read); 
+
+
 extern hl_result_t hl_can_comm_getstatus(hl_can_t id, hl_can_comm_status_t *status);
 
 /** @}            
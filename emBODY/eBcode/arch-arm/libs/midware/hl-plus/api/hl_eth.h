@@ -242,6 +242,19 @@ extern void hl_eth_on_frame_received(hl_eth_frame_t* frame);
 
 
 extern hl_result_t hl_eth_sendframe(hl_eth_frame_t *frame);
+
+
+/** @fn         extern hl_result_t hl_eth_rx_refill(void)
+    @brief      this function fills the pool of spare frames used by the ETH isr for zero-copy reception. the frames are
+                taken from the higher layer with hl_eth_frame_new(). when a frame is received, the isr exchanges the frame
+                just written by the dma with a spare one and moves it up with hl_eth_on_frame_received() without any copy.
+                if the pool is empty, the isr copies the received frame into a new one as it does when this function is
+                never called. it must be called outside the isr, typically by the task which processes the received frames.
+                the frames given by hl_eth_frame_new() must have their data 4-byte aligned.
+    @return     hl_res_OK if the pool is full, hl_res_NOK_nodata if the higher layer did not give enough frames,
+                hl_res_NOK_generic if the eth is not initted.
+  */
+extern hl_result_t hl_eth_rx_refill(void);
 #endif
 
 extern void hl_eth_alert(void);
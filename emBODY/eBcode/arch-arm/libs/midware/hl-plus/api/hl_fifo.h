@@ -64,16 +64,18 @@ typedef struct hl_fifo_hid_t hl_fifo_t;
 
 /** @typedef    struct hl_fifo_hid_t 
     @brief      contains implementation of data structure able to hold generic items in a fifo with the limitation 
-                of maximum 255 items of maximum size 255.   
+                of maximum 65535 items of maximum size 255. a capacity which is a power of two is slightly faster.
+                the struct keeps the 16 bytes it always had, so that the memory which the users give to hl_fifo_init()
+                is still enough. its fields must not be accessed outside hl_fifo.c.
  **/ 
 struct hl_fifo_hid_t
 {
-    uint8_t capacity;                   /**< the max possible number of items which can be store inside the fifo */
-    uint8_t size;                       /**< the number of items inside the fifo at a given time */
-    uint8_t index;                      /**< internals: keeps the ordinal number of next item that can be put inside */
+    uint16_t capacity;                  /**< the max possible number of items which can be store inside the fifo */
+    uint16_t size;                      /**< the number of items inside the fifo at a given time */
+    uint16_t index;                     /**< internals: keeps the ordinal number of next item that can be put inside */
     uint8_t sizeofitem;                 /**< the size in bytes of the item type stored inside teh fifo */
+    uint8_t pow2;                       /**< internals: 1 if capacity is a power of two, else 0 */
     uint8_t *data;                      /**< the data of the fifo: capacity * sizeofitem bytes which must be passed at construction */
-    hl_fifo_fn_itemaddr_t itemaddr;
     hl_fifo_fn_itemcopy_t itemcopy;     /**< internals: function which copies an item in and out from the fifo. */
 };  // 16 bytes
 
@@ -99,6 +101,17 @@ struct hl_fifo_hid_t
 extern hl_fifo_t* hl_fifo_new(uint8_t capacity, uint8_t sizeofitem, uint8_t *iteminitval);
 
 
+/** @fn         extern hl_fifo_t* hl_fifo_new_large(uint16_t capacity, uint8_t sizeofitem, uint8_t *iteminitval)
+    @brief      It does what hl_fifo_new() does but for a capacity of up to 65535 items. Use hl_fifo_size_large() to
+                get its size, as hl_fifo_size() and the remaining items of the hl_fifo_get*() functions saturate at 255.
+    @param      capacity    The capacity of the fifo.
+    @param      sizeofitem  The size in bytes of the item contained in the fifo.
+    @param      iteminitval Pointer to a default value with which the items are initialised. It can be NULL.
+    @return     The fifo pointer or NULL in case of failure.
+ **/
+extern hl_fifo_t* hl_fifo_new_large(uint16_t capacity, uint8_t sizeofitem, uint8_t *iteminitval);
+
+
 /** @fn         extern void hl_fifo_delete(hl_fifo_t *fifo)
     @brief      It releases all memory related to the fifo.
     @param      fifo        The fifo
@@ -122,6 +135,18 @@ extern void hl_fifo_delete(hl_fifo_t *fifo);
 extern hl_result_t hl_fifo_init(hl_fifo_t *fifo, uint8_t capacity, uint8_t sizeofitem, uint8_t *dataforfifo, uint8_t *iteminitval);
 
 
+/** @fn         extern hl_result_t hl_fifo_init_large(hl_fifo_t *fifo, uint16_t capacity, uint8_t sizeofitem, uint8_t *dataforfifo, uint8_t *iteminitval)
+    @brief      It does what hl_fifo_init() does but for a capacity of up to 65535 items.
+    @param      fifo        The fifo pointer.           
+    @param      capacity    The capacity of the fifo.
+    @param      sizeofitem  The size in bytes of the item contained in the fifo.
+    @param      dataforfifo Pointer to externally allocated memory which is able to contain capacity items of size sizeofitem.
+    @param      iteminitval Pointer to a default value with which the items are initialised. It can be NULL.
+    @return     hl_res_OK in case of success.
+ **/
+extern hl_result_t hl_fifo_init_large(hl_fifo_t *fifo, uint16_t capacity, uint8_t sizeofitem, uint8_t *dataforfifo, uint8_t *iteminitval);
+
+
 /** @fn         extern void hl_fifo_reset(hl_fifo_t *fifo)
     @brief      It resets the fifo by setting its size to zero.
     @param      fifo        The fifo
@@ -154,7 +179,7 @@ extern hl_result_t hl_fifo_put(hl_fifo_t *fifo, uint8_t *data);
     @param      fifo        The fifo
     @param      data        The pointer where to copy the item.
     @param      remaining   If not NULL it contains the number of items remaining inside the fifo 
-                            at the return of the function.
+                            at the return of the function, saturated at 255.
     @return     hl_res_OK on success and hl_res_NOK_nodata if the fifo is empty.
  **/
 extern hl_result_t hl_fifo_get(hl_fifo_t *fifo, uint8_t *data, uint8_t *remaining);
@@ -188,13 +213,21 @@ extern void hl_fifo_pop(hl_fifo_t *fifo);
 
 
 /** @fn         extern uint8_t hl_fifo_size(hl_fifo_t *fifo)
-    @brief      It returns the size of the fifo.   
+    @brief      It returns the size of the fifo saturated at 255.   
     @param      fifo        The fifo
     @return     size of fifo.
  **/
 extern uint8_t hl_fifo_size(hl_fifo_t *fifo);
 
 
+/** @fn         extern uint16_t hl_fifo_size_large(hl_fifo_t *fifo)
+    @brief      It returns the size of the fifo, also when it is bigger than 255.   
+    @param      fifo        The fifo
+    @return     size of fifo.
+ **/
+extern uint16_t hl_fifo_size_large(hl_fifo_t *fifo);
+
+
 /** @fn         extern hl_bool_t hl_fifo_full(hl_fifo_t *fifo)
     @brief      It tells if fifo is full.   
     @param      fifo        The fifo
@@ -203,6 +236,30 @@ extern uint8_t hl_fifo_size(hl_fifo_t *fifo);
 extern hl_bool_t hl_fifo_full(hl_fifo_t *fifo);
 
 
+/** @fn         extern hl_result_t hl_fifo_put_many(hl_fifo_t *fifo, const uint8_t *data, uint16_t number, uint16_t *put)
+    @brief      It copies inside the fifo as many as possible of the @e number contiguous items pointed by data. It uses 
+                at most two memcpy() whatever the number of items.
+    @param      fifo        The fifo
+    @param      data        The pointer to the items to be copied inside.
+    @param      number      The number of items in data.
+    @param      put         If not NULL it contains the number of items effectively copied inside.
+    @return     hl_res_OK on success and hl_res_NOK_generic if the fifo is full.
+ **/
+extern hl_result_t hl_fifo_put_many(hl_fifo_t *fifo, const uint8_t *data, uint16_t number, uint16_t *put);
+
+
+/** @fn         extern hl_result_t hl_fifo_get_many(hl_fifo_t *fifo, uint8_t *data, uint16_t max, uint16_t *got)
+    @brief      It copies inside data up to @e max items from the front of the fifo and removes them. It uses 
+                at most two memcpy() whatever the number of items.
+    @param      fifo        The fifo
+    @param      data        The pointer where to copy the items. It must be able to hold max items.
+    @param      max         The maximum number of items to get.
+    @param      got         If not NULL it contains the number of items effectively copied into data.
+    @return     hl_res_OK on success and hl_res_NOK_nodata if the fifo is empty.
+ **/
+extern hl_result_t hl_fifo_get_many(hl_fifo_t *fifo, uint8_t *data, uint16_t max, uint16_t *got);
+
+
 // other fifo functions for a specific item size.
 
 extern uint8_t * hl_fifo_front01(hl_fifo_t *fifo);
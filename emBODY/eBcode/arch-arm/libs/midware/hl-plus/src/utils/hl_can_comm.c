@@ -183,6 +183,17 @@ extern hl_result_t hl_can_comm_deinit(hl_can_t id)
 }
 
 extern hl_result_t hl_can_comm_init(hl_can_t id, const hl_can_comm_cfg_t *cfg)
+{
+    if(NULL == cfg)
+    {
+        return(hl_res_NOK_generic);
+    }
+    
+    return(hl_can_comm_init_large(id, cfg, cfg->capacityofrxfifoofframes, cfg->capacityoftxfifoofframes));
+}
+
+
+extern hl_result_t hl_can_comm_init_large(hl_can_t id, const hl_can_comm_cfg_t *cfg, uint16_t capacityofrxfifoofframes, uint16_t capacityoftxfifoofframes)
 {
     hl_can_comm_internal_item_t* intitem = s_hl_can_comm_theinternals.items[HL_can_id2index(id)];
 
@@ -205,9 +216,6 @@ extern hl_result_t hl_can_comm_init(hl_can_t id, const hl_can_comm_cfg_t *cfg)
     // give memory to can internal item for this id ... 
     if(NULL == intitem)
     {
-        uint8_t capacityofrxfifoofframes = cfg->capacityofrxfifoofframes; 
-        uint8_t capacityoftxfifoofframes = cfg->capacityoftxfifoofframes; 
-        
         if((0 == capacityofrxfifoofframes) || (0 == capacityoftxfifoofframes))
         {
             hl_sys_on_error(hl_error_incorrectparameter, "hl_can_init(): need non-zero tx and rx fifo sizes");
@@ -216,9 +224,9 @@ extern hl_result_t hl_can_comm_init(hl_can_t id, const hl_can_comm_cfg_t *cfg)
         // the internal item
         intitem = s_hl_can_comm_theinternals.items[HL_can_id2index(id)] = hl_sys_heap_new(sizeof(hl_can_comm_internal_item_t));   
         // create the txfifo
-        intitem->txfifo = hl_fifo_new(capacityoftxfifoofframes, sizeof(hl_can_comm_frame_t), (uint8_t*)&s_hl_can_comm_defcanframe);
+        intitem->txfifo = hl_fifo_new_large(capacityoftxfifoofframes, sizeof(hl_can_comm_frame_t), (uint8_t*)&s_hl_can_comm_defcanframe);
         // create the rxfifo
-        intitem->rxfifo = hl_fifo_new(capacityofrxfifoofframes, sizeof(hl_can_comm_frame_t), (uint8_t*)&s_hl_can_comm_defcanframe);       
+        intitem->rxfifo = hl_fifo_new_large(capacityofrxfifoofframes, sizeof(hl_can_comm_frame_t), (uint8_t*)&s_hl_can_comm_defcanframe);       
     }
     
     // copy config
@@ -460,6 +468,38 @@ extern hl_result_t hl_can_comm_get(hl_can_t id, hl_can_comm_frame_t *frame, uint
 }
 
 
+extern hl_result_t hl_can_comm_get_many(hl_can_t id, hl_can_comm_frame_t *frames, uint8_t max, uint8_t *read)
+{
+    hl_can_comm_internal_item_t* intitem = s_hl_can_comm_theinternals.items[HL_can_id2index(id)];
+    hl_result_t res = hl_res_NOK_nodata;
+    uint16_t n = 0;
+
+#if     !defined(HL_BEH_REMOVE_RUNTIME_VALIDITY_CHECK)
+    if(hl_false == s_hl_can_comm_initted_is(id))
+    {
+        return(hl_res_NOK_generic);
+    }
+    
+    if((NULL == frames) || (NULL == read))
+    {
+        return(hl_res_NOK_generic);
+    }
+#endif 
+    
+    // disable interrupt rx only once for the whole batch
+    s_hl_can_comm_nvic_rx_disable(id);
+    
+    res = hl_fifo_get_many(intitem->rxfifo, (uint8_t*)frames, max, &n);
+
+    // enable interrupt rx
+    s_hl_can_comm_nvic_rx_enable(id);
+    
+    *read = (uint8_t)n;
+    
+    return(res);
+}
+
+
 extern hl_result_t hl_can_comm_getstatus(hl_can_t id, hl_can_comm_status_t *status)
 {
 //    hl_can_comm_internal_item_t* intitem = s_hl_can_comm_theinternals.items[HL_can_id2index(id)];
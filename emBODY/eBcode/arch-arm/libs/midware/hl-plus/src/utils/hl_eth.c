@@ -76,6 +76,7 @@
 
 #define ETH_BUF_SIZE        1536        /* ETH Receive/Transmit buffer size  */
 #define ETH_MTU             1514        /* Eth Maximum Transmission Unit */
+#define ETH_RXFRAME_SIZE    1520        /* size of the rx frames of the higher layer: ETH_MTU + crc, multiple of 4 */
 
 /* MAC Configuration Register */
 #define MCR_WD              0x00800000  /* Watchdog disable                  */
@@ -416,6 +417,12 @@ typedef struct
     hl_tx_desc_t*               tx_desc;
     hl_eth_array_of_buffers_t   rx_buffers;
     hl_eth_array_of_buffers_t   tx_buffers;
+#if     !defined(HAL_COMPATIBLE_LWIP)
+    hl_eth_frame_t**            rxframes;       // the frame of the higher layer used by each rx descriptor, or NULL if it uses rx_buffers
+    hl_eth_frame_t**            rxspares;       // ring of capacityofrxfifoofframes+1 spare frames: hl_eth_rx_refill() puts, the isr gets
+    volatile uint8_t            rxsparesput;    // written only by hl_eth_rx_refill()
+    volatile uint8_t            rxsparesget;    // written only by the isr
+#endif
 } hl_eth_internal_item_t;
 
 
@@ -440,6 +447,12 @@ static hl_bool_t s_hl_eth_initted_is(void);
 static void s_hl_eth_rx_descr_init(void);
 static void s_hl_eth_tx_descr_init(void);
 
+#if     !defined(HAL_COMPATIBLE_LWIP)
+static hl_eth_frame_t* s_hl_eth_rx_spare_get(hl_eth_internal_item_t* intitem);
+static hl_eth_frame_t* s_hl_eth_rx_frame_exchange(hl_eth_internal_item_t* intitem, uint32_t i, uint32_t len);
+static void s_hl_eth_rx_descr_attach(hl_eth_internal_item_t* intitem, uint32_t i);
+#endif
+
 static void s_hl_eth_rmii_init(void);
 
 
@@ -449,7 +462,7 @@ static void s_hl_eth_mac_init(const hl_eth_cfg_t *cfg, hl_ethtrans_phymode_t phy
 
 static void s_hl_eth_rmii_prepare(void);
 static void s_hl_eth_rmii_rx_init(void);
-extern void s_hl_eth_rmii_tx_init(void);
+static void s_hl_eth_rmii_tx_init(void);
 
 
 
@@ -595,6 +608,19 @@ extern hl_result_t hl_eth_init(const hl_eth_cfg_t *cfg)
         hl_sys_on_error(hl_error_generic, "hl_eth_init() did get enough heap");
     }
     
+#if     !defined(HAL_COMPATIBLE_LWIP)
+    // the rx descriptors begin with rx_buffers and move to frames of the higher layer only if hl_eth_rx_refill() is called 
+    intitem->rxframes = (hl_eth_frame_t**) hl_sys_heap_new(sizeof(hl_eth_frame_t*) * capacityofrxfifoofframes);
+    intitem->rxspares = (hl_eth_frame_t**) hl_sys_heap_new(sizeof(hl_eth_frame_t*) * (capacityofrxfifoofframes+1));
+    intitem->rxsparesput = 0;
+    intitem->rxsparesget = 0;
+    
+    if((NULL == intitem->rxframes) || (NULL == intitem->rxspares))
+    {
+        hl_sys_on_error(hl_error_generic, "hl_eth_init() did get enough heap");
+    }
+#endif
+    
    
     // in here we allow a specific board to init all what is related to the phy.
     // in case of a phy accessed through the smi, this function must: a. init the smi, b. reset the phy, ... that's it.
@@ -944,6 +970,49 @@ extern hl_result_t hl_eth_sendframe(hl_eth_frame_t *frame)
 #endif    
     return(hl_res_OK);    
 }
+
+
+extern hl_result_t hl_eth_rx_refill(void)
+{
+    hl_eth_internal_item_t* intitem = s_hl_eth_theinternals.items[0];
+    hl_eth_frame_t* frame = NULL;
+    uint8_t put = 0;
+
+#if     !defined(HL_BEH_REMOVE_RUNTIME_VALIDITY_CHECK)  
+    if(hl_true != s_hl_eth_initted_is())
+    {
+        return(hl_res_NOK_generic);
+    }
+#endif  
+
+    // only this function writes rxsparesput and only the isr writes rxsparesget, thus we dont need to disable the isr
+    put = intitem->rxsparesput;
+    for(;;)
+    {
+        uint8_t next = put + 1;
+        if(next > intitem->config.capacityofrxfifoofframes)
+        {
+            next = 0;
+        }
+        if(next == intitem->rxsparesget)
+        {   // the ring is full
+            return(hl_res_OK);
+        }
+        
+        // flag 0x80000000 to skip the error of the higher layer when out of memory
+        frame = hl_eth_frame_new(ETH_RXFRAME_SIZE | 0x80000000);
+        if(NULL == frame)
+        {
+            return(hl_res_NOK_nodata);
+        }
+        
+        // the frame must be in the ring before the isr can see the new rxsparesput: volatile alone does not order
+        // the store of rxspares[put], which is not volatile, thus the barrier
+        intitem->rxspares[put] = frame;
+        __DMB();
+        intitem->rxsparesput = put = next;
+    }
+}
 #endif
 
 
@@ -1401,16 +1470,22 @@ void ETH_IRQHandler (void) {
 //       put_in_queue (frame);
 //     }
 ///====> .... this code
-      /* Flag 0x80000000 to skip sys_error() call when out of memory. */
-      frame =  hl_eth_frame_new(RxLen | 0x80000000);
       size = (RxLen | 0x80000000);
-      /* if 'alloc_mem()' has failed, ignore this packet. */
-      if (frame != NULL) {
-        sp = (U32 *)(intitem->rx_desc[i].Addr & ~3);
-        dp = (U32 *)&frame->datafirstbyte[0];
-        for (RxLen = (RxLen + 3) >> 2; RxLen; RxLen--) {
-          *dp++ = *sp++;
+      // in zero-copy we just exchange the frame written by the dma with a spare one
+      frame = s_hl_eth_rx_frame_exchange(intitem, i, RxLen);
+      if (frame == NULL) {
+        /* Flag 0x80000000 to skip sys_error() call when out of memory. */
+        frame =  hl_eth_frame_new(RxLen | 0x80000000);
+        /* if 'alloc_mem()' has failed, ignore this packet. */
+        if (frame != NULL) {
+          sp = (U32 *)(intitem->rx_desc[i].Addr & ~3);
+          dp = (U32 *)&frame->datafirstbyte[0];
+          for (RxLen = (RxLen + 3) >> 2; RxLen; RxLen--) {
+            *dp++ = *sp++;
+          }
         }
+      }
+      if (frame != NULL) {
 
 
         if(hal_eth_lowLevelUsePacket_ptr != NULL)
@@ -1444,7 +1519,8 @@ void ETH_IRQHandler (void) {
     }
 
         /* Release this frame from ETH IO buffer. */
-rel:intitem->rx_desc[i].Stat = DMA_RX_OWN;
+rel:s_hl_eth_rx_descr_attach(intitem, i);
+    intitem->rx_desc[i].Stat = DMA_RX_OWN;
 
 #if defined(HL_ETH_EXTRA_DEBUG)
 #else
@@ -1692,11 +1768,91 @@ static void s_hl_eth_rx_descr_init(void)
         intitem->rx_desc[i].Ctrl = DMA_RX_RCH | ETH_BUF_SIZE;
         intitem->rx_desc[i].Addr = (uint32_t)&intitem->rx_buffers[i];
         intitem->rx_desc[i].Next = (uint32_t)&intitem->rx_desc[next];
+#if     !defined(HAL_COMPATIBLE_LWIP)
+        intitem->rxframes[i] = NULL;
+#endif
     }
     ETH->DMARDLAR = (uint32_t)&intitem->rx_desc[0];
 }
 
 
+#if     !defined(HAL_COMPATIBLE_LWIP)
+
+// the following functions manage the rx descriptors and the ring of spares in zero-copy reception. they never access 
+// the registers of the mac, thus they can be verified also with a simulated rx descriptor ring.
+
+static hl_eth_frame_t* s_hl_eth_rx_spare_get(hl_eth_internal_item_t* intitem)
+{
+    hl_eth_frame_t* spare = NULL;
+    uint8_t get = intitem->rxsparesget;
+    
+    if(get == intitem->rxsparesput)
+    {   // the ring is empty
+        return(NULL);
+    }
+    
+    spare = intitem->rxspares[get];
+    if(++get > intitem->config.capacityofrxfifoofframes)
+    {
+        get = 0;
+    }
+    intitem->rxsparesget = get;
+    
+    return(spare);
+}
+
+
+// it returns the frame of the higher layer just written by the dma in descriptor i after it has given a spare frame to
+// the descriptor. it returns NULL if the descriptor does not use a frame of the higher layer or if there are no spares.
+static hl_eth_frame_t* s_hl_eth_rx_frame_exchange(hl_eth_internal_item_t* intitem, uint32_t i, uint32_t len)
+{
+    hl_eth_frame_t* frame = intitem->rxframes[i];
+    hl_eth_frame_t* spare = NULL;
+    
+    if(NULL == frame)
+    {
+        return(NULL);
+    }
+    
+    spare = s_hl_eth_rx_spare_get(intitem);
+    if(NULL == spare)
+    {
+        return(NULL);
+    }
+    
+    intitem->rxframes[i] = spare;
+    intitem->rx_desc[i].Addr = (uint32_t)&spare->datafirstbyte[0];
+    
+    frame->length = len;
+    return(frame);
+}
+
+
+// it moves descriptor i from rx_buffers to a spare frame of the higher layer, if any. it must be called when the cpu 
+// owns the descriptor and after its content has been used.
+static void s_hl_eth_rx_descr_attach(hl_eth_internal_item_t* intitem, uint32_t i)
+{
+    hl_eth_frame_t* spare = NULL;
+    
+    if(NULL != intitem->rxframes[i])
+    {
+        return;
+    }
+    
+    spare = s_hl_eth_rx_spare_get(intitem);
+    if(NULL == spare)
+    {
+        return;
+    }
+    
+    intitem->rxframes[i] = spare;
+    intitem->rx_desc[i].Ctrl = DMA_RX_RCH | ETH_RXFRAME_SIZE;
+    intitem->rx_desc[i].Addr = (uint32_t)&spare->datafirstbyte[0];
+}
+
+#endif//!defined(HAL_COMPATIBLE_LWIP)
+
+
 static void s_hl_eth_tx_descr_init(void) 
 {
     uint32_t i,next;
@@ -77,20 +77,19 @@
 // - declaration of static functions
 // --------------------------------------------------------------------------------------------------------------------
 
+static uint32_t s_hl_fifo_wrap(hl_fifo_t *fifo, uint32_t pos);
+static uint32_t s_hl_fifo_first(hl_fifo_t *fifo);
+static uint8_t s_hl_fifo_saturated(uint16_t value);
+
 static void s_hl_fifo_itemofsize01copy(uint8_t* dst, uint32_t offsetdst, uint8_t* src, uint32_t offsetsrc);
-static uint8_t* s_hl_fifo_itemofsize01addr(uint8_t* pool, uint32_t pos);
 
 static void s_hl_fifo_itemofsize02copy(uint16_t* dst, uint32_t offsetdst, uint16_t* src, uint32_t offsetsrc);
-static uint8_t* s_hl_fifo_itemofsize02addr(uint16_t* pool, uint32_t pos);
 
 static void s_hl_fifo_itemofsize04copy(uint32_t* dst, uint32_t offsetdst, uint32_t* src, uint32_t offsetsrc);
-static uint8_t* s_hl_fifo_itemofsize04addr(uint32_t* pool, uint32_t pos);
 
 static void s_hl_fifo_itemofsize08copy(uint64_t* dst, uint32_t offsetdst, uint64_t* src, uint32_t offsetsrc);
-static uint8_t* s_hl_fifo_itemofsize08addr(uint64_t* pool, uint32_t pos);
 
 static void s_hl_fifo_itemofsize16copy(uint64_t* dst, uint32_t offsetdst, uint64_t* src, uint32_t offsetsrc);
-static uint8_t* s_hl_fifo_itemofsize16addr(uint64_t* pool, uint32_t pos);
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of static const variables
@@ -108,6 +107,12 @@ static uint8_t* s_hl_fifo_itemofsize16addr(uint64_t* pool, uint32_t pos);
 
 
 extern hl_fifo_t* hl_fifo_new(uint8_t capacity, uint8_t sizeofitem, uint8_t *iteminitval)
+{
+    return(hl_fifo_new_large(capacity, sizeofitem, iteminitval));
+}
+
+
+extern hl_fifo_t* hl_fifo_new_large(uint16_t capacity, uint8_t sizeofitem, uint8_t *iteminitval)
 {
     if((0 == capacity) || (0 == sizeofitem))
     {
@@ -121,14 +126,14 @@ extern hl_fifo_t* hl_fifo_new(uint8_t capacity, uint8_t sizeofitem, uint8_t *ite
         return(NULL);
     }
     
-    uint8_t *dataforfifo = hl_sys_heap_new(sizeofitem*capacity);
+    uint8_t *dataforfifo = hl_sys_heap_new((uint32_t)sizeofitem*capacity);
 
     if(NULL == dataforfifo)
     {
         return(NULL);
     } 
 
-    hl_fifo_init(fifo, capacity, sizeofitem, dataforfifo, iteminitval);
+    hl_fifo_init_large(fifo, capacity, sizeofitem, dataforfifo, iteminitval);
     
     return(fifo);    
 }
@@ -150,6 +155,12 @@ extern void hl_fifo_delete(hl_fifo_t *fifo)
 
 
 extern hl_result_t hl_fifo_init(hl_fifo_t *fifo, uint8_t capacity, uint8_t sizeofitem, uint8_t *dataforfifo, uint8_t *iteminitval)
+{
+    return(hl_fifo_init_large(fifo, capacity, sizeofitem, dataforfifo, iteminitval));
+}
+
+
+extern hl_result_t hl_fifo_init_large(hl_fifo_t *fifo, uint16_t capacity, uint8_t sizeofitem, uint8_t *dataforfifo, uint8_t *iteminitval)
 {
     if((NULL == fifo) || (NULL == dataforfifo) || (0 == capacity) || (0 == sizeofitem))
     {
@@ -157,6 +168,7 @@ extern hl_result_t hl_fifo_init(hl_fifo_t *fifo, uint8_t capacity, uint8_t sizeo
     }
     
     fifo->capacity      = capacity;
+    fifo->pow2          = (0 == (capacity & (capacity-1))) ? (1) : (0);
     fifo->sizeofitem    = sizeofitem;
     fifo->data          = dataforfifo;
     
@@ -164,47 +176,41 @@ extern hl_result_t hl_fifo_init(hl_fifo_t *fifo, uint8_t capacity, uint8_t sizeo
     {
         case 16:
         {   
-            fifo->itemaddr  = (hl_fifo_fn_itemaddr_t)s_hl_fifo_itemofsize16addr;
             fifo->itemcopy  = (hl_fifo_fn_itemcopy_t)s_hl_fifo_itemofsize16copy;
         } break;
         
         case 8:
         {   
-            fifo->itemaddr  = (hl_fifo_fn_itemaddr_t)s_hl_fifo_itemofsize08addr;
             fifo->itemcopy  = (hl_fifo_fn_itemcopy_t)s_hl_fifo_itemofsize08copy;
         } break;
  
         case 4:
         {   
-            fifo->itemaddr  = (hl_fifo_fn_itemaddr_t)s_hl_fifo_itemofsize04addr;
             fifo->itemcopy  = (hl_fifo_fn_itemcopy_t)s_hl_fifo_itemofsize04copy;
         } break;
  
         case 2:
         {   
-            fifo->itemaddr  = (hl_fifo_fn_itemaddr_t)s_hl_fifo_itemofsize02addr;
             fifo->itemcopy  = (hl_fifo_fn_itemcopy_t)s_hl_fifo_itemofsize02copy;
         } break;
 
         case 1:
         {   
-            fifo->itemaddr  = (hl_fifo_fn_itemaddr_t)s_hl_fifo_itemofsize01addr;
             fifo->itemcopy  = (hl_fifo_fn_itemcopy_t)s_hl_fifo_itemofsize01copy;
         } break;
         
         default:
         {	// prefer using NULL rather than a standard function to avoid adding a 5-th argument which uses stack
-            fifo->itemaddr  = NULL;  
             fifo->itemcopy  = NULL;            
         } break;
     }
     
     if((NULL != iteminitval) && (NULL != fifo->data))
     {
-        uint8_t i = 0;
+        uint16_t i = 0;
         for(i=0; i<fifo->capacity; i++)
         {
-            memcpy(&fifo->data[i*fifo->sizeofitem], iteminitval, fifo->sizeofitem);
+            memcpy(&fifo->data[(uint32_t)i*fifo->sizeofitem], iteminitval, fifo->sizeofitem);
         }
     }
     
@@ -239,7 +245,7 @@ extern void hl_fifo_clear(hl_fifo_t *fifo)
 #endif 
     
     // avoid checks .... be careful in calling   
-    memset(fifo->data, 0, fifo->capacity * fifo->sizeofitem);
+    memset(fifo->data, 0, (uint32_t)fifo->capacity * fifo->sizeofitem);
     
     fifo->size = 0;
     fifo->index = 0;
@@ -271,17 +277,13 @@ extern hl_result_t hl_fifo_put(hl_fifo_t *fifo, uint8_t *data)
         }
         else
         {
-            memcpy(&(fifo->data[fifo->index * fifo->sizeofitem]), data, fifo->sizeofitem);
+            memcpy(&(fifo->data[(uint32_t)fifo->index * fifo->sizeofitem]), data, fifo->sizeofitem);
         }
     }
     // else just advance the index and size
        
     fifo->size ++;
-    fifo->index ++;
-    if(fifo->index == fifo->capacity)
-    {
-        fifo->index = 0;
-    }
+    fifo->index = s_hl_fifo_wrap(fifo, fifo->index + 1);
     
     return(hl_res_OK);
 }
@@ -303,7 +305,7 @@ extern uint8_t * hl_fifo_end(hl_fifo_t *fifo)
         return(NULL);
     }
         
-    return(&(fifo->data[fifo->index * fifo->sizeofitem]));    
+    return(&(fifo->data[(uint32_t)fifo->index * fifo->sizeofitem]));    
 }
 
 
@@ -329,11 +331,7 @@ extern hl_result_t hl_fifo_get(hl_fifo_t *fifo, uint8_t *data, uint8_t *remainin
         return(hl_res_NOK_nodata);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
  
     if(NULL != fifo->itemcopy)
     {
@@ -347,7 +345,7 @@ extern hl_result_t hl_fifo_get(hl_fifo_t *fifo, uint8_t *data, uint8_t *remainin
     fifo->size --;
     if(NULL != remaining)
     {
-        *remaining = fifo->size;
+        *remaining = s_hl_fifo_saturated(fifo->size);
     }
     
     return(hl_res_OK);
@@ -372,20 +370,9 @@ extern uint8_t * hl_fifo_front(hl_fifo_t *fifo)
         return(NULL);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
     
-    if(NULL != fifo->itemaddr)
-    {
-        return(fifo->itemaddr(fifo->data, start));  
-    }
-    else
-    {
-        return(&(fifo->data[start * fifo->sizeofitem]));
-    }
+    return(&(fifo->data[start * fifo->sizeofitem]));
 }
 
 
@@ -411,6 +398,19 @@ extern void hl_fifo_pop(hl_fifo_t *fifo)
 
 extern uint8_t hl_fifo_size(hl_fifo_t *fifo)
 {
+#if     !defined(HL_BEH_REMOVE_RUNTIME_PARAMETER_CHECK)  
+    if(NULL == fifo)
+    {
+        return(0);
+    }
+#endif   
+    
+    return(s_hl_fifo_saturated(fifo->size));
+}
+
+
+extern uint16_t hl_fifo_size_large(hl_fifo_t *fifo)
+{
 #if     !defined(HL_BEH_REMOVE_RUNTIME_PARAMETER_CHECK)  
     if(NULL == fifo)
     {
@@ -435,6 +435,103 @@ extern hl_bool_t hl_fifo_full(hl_fifo_t *fifo)
 }
 
 
+extern hl_result_t hl_fifo_put_many(hl_fifo_t *fifo, const uint8_t *data, uint16_t number, uint16_t *put)
+{
+#if     !defined(HL_BEH_REMOVE_RUNTIME_PARAMETER_CHECK)  
+    if((NULL == fifo) || (NULL == data))
+    {
+        return(hl_res_NOK_generic);
+    }
+#endif 
+
+    // avoid checks .... be careful in calling
+    
+    uint32_t n = fifo->capacity - fifo->size;
+    uint32_t n1 = 0;
+    
+    if(number < n)
+    {
+        n = number;
+    }
+    
+    if(NULL != put)
+    {
+        *put = n;
+    }
+    
+    if(0 == n)
+    {
+        return((0 == number) ? (hl_res_OK) : (hl_res_NOK_generic));
+    }
+    
+    // at most two copies: from index up to the end of the buffer and then from its beginning
+    n1 = fifo->capacity - fifo->index;
+    if(n1 > n)
+    {
+        n1 = n;
+    }
+    memcpy(&(fifo->data[(uint32_t)fifo->index * fifo->sizeofitem]), data, n1 * fifo->sizeofitem);
+    if(n > n1)
+    {
+        memcpy(fifo->data, &data[n1 * fifo->sizeofitem], (n - n1) * fifo->sizeofitem);
+    }
+    
+    fifo->size += n;
+    fifo->index = s_hl_fifo_wrap(fifo, fifo->index + n);
+    
+    return(hl_res_OK);
+}
+
+
+extern hl_result_t hl_fifo_get_many(hl_fifo_t *fifo, uint8_t *data, uint16_t max, uint16_t *got)
+{
+#if     !defined(HL_BEH_REMOVE_RUNTIME_PARAMETER_CHECK)  
+    if((NULL == fifo) || (NULL == data))
+    {
+        return(hl_res_NOK_generic);
+    }
+#endif 
+
+    // avoid checks .... be careful in calling
+    
+    uint32_t n = fifo->size;
+    uint32_t n1 = 0;
+    uint32_t start = 0;
+    
+    if(max < n)
+    {
+        n = max;
+    }
+    
+    if(NULL != got)
+    {
+        *got = n;
+    }
+    
+    if(0 == n)
+    {
+        return((0 == fifo->size) ? (hl_res_NOK_nodata) : (hl_res_OK));
+    }
+    
+    // at most two copies: from the first item up to the end of the buffer and then from its beginning
+    start = s_hl_fifo_first(fifo);
+    n1 = fifo->capacity - start;
+    if(n1 > n)
+    {
+        n1 = n;
+    }
+    memcpy(data, &(fifo->data[start * fifo->sizeofitem]), n1 * fifo->sizeofitem);
+    if(n > n1)
+    {
+        memcpy(&data[n1 * fifo->sizeofitem], fifo->data, (n - n1) * fifo->sizeofitem);
+    }
+    
+    fifo->size -= n;
+    
+    return(hl_res_OK);
+}
+
+
 // -- fast version: size 16
 
 extern uint8_t * hl_fifo_front16(hl_fifo_t *fifo)
@@ -453,13 +550,9 @@ extern uint8_t * hl_fifo_front16(hl_fifo_t *fifo)
         return(NULL);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
 
-    return(s_hl_fifo_itemofsize16addr((uint64_t*)fifo->data, start));   
+    return((uint8_t*)&(((uint64_t*)fifo->data)[start<<1]));   
 }
 
 
@@ -479,11 +572,7 @@ extern hl_result_t hl_fifo_get16(hl_fifo_t *fifo, uint8_t *data, uint8_t *remain
         return(hl_res_NOK_nodata);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
     
     
     s_hl_fifo_itemofsize16copy((uint64_t*)data, 0, (uint64_t*)fifo->data, start);
@@ -492,7 +581,7 @@ extern hl_result_t hl_fifo_get16(hl_fifo_t *fifo, uint8_t *data, uint8_t *remain
     fifo->size --;
     if(NULL != remaining)
     {
-        *remaining = fifo->size;
+        *remaining = s_hl_fifo_saturated(fifo->size);
     }
     
     return(hl_res_OK);
@@ -521,11 +610,7 @@ extern hl_result_t hl_fifo_put16(hl_fifo_t *fifo, uint8_t *data)
     // else just advance the index and size
     
     fifo->size ++;
-    fifo->index ++;
-    if(fifo->index == fifo->capacity)
-    {
-        fifo->index = 0;
-    }
+    fifo->index = s_hl_fifo_wrap(fifo, fifo->index + 1);
     
     return(hl_res_OK);
 }
@@ -549,13 +634,9 @@ extern uint8_t * hl_fifo_front08(hl_fifo_t *fifo)
         return(NULL);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
 
-    return(s_hl_fifo_itemofsize08addr((uint64_t*)fifo->data, start));   
+    return((uint8_t*)&(((uint64_t*)fifo->data)[start]));   
 }
 
 
@@ -575,11 +656,7 @@ extern hl_result_t hl_fifo_get08(hl_fifo_t *fifo, uint8_t *data, uint8_t *remain
         return(hl_res_NOK_nodata);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
        
     s_hl_fifo_itemofsize08copy((uint64_t*)data, 0, (uint64_t*)fifo->data, start);
 
@@ -587,7 +664,7 @@ extern hl_result_t hl_fifo_get08(hl_fifo_t *fifo, uint8_t *data, uint8_t *remain
     fifo->size --;
     if(NULL != remaining)
     {
-        *remaining = fifo->size;
+        *remaining = s_hl_fifo_saturated(fifo->size);
     }
     
     return(hl_res_OK);
@@ -616,11 +693,7 @@ extern hl_result_t hl_fifo_put08(hl_fifo_t *fifo, uint8_t *data)
     // else just advance the index and size
    
     fifo->size ++;
-    fifo->index ++;
-    if(fifo->index == fifo->capacity)
-    {
-        fifo->index = 0;
-    }
+    fifo->index = s_hl_fifo_wrap(fifo, fifo->index + 1);
     
     return(hl_res_OK);
 }
@@ -644,13 +717,9 @@ extern uint8_t * hl_fifo_front04(hl_fifo_t *fifo)
         return(NULL);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
 
-    return(s_hl_fifo_itemofsize04addr((uint32_t*)fifo->data, start));   
+    return((uint8_t*)&(((uint32_t*)fifo->data)[start]));   
 }
 
 
@@ -670,11 +739,7 @@ extern hl_result_t hl_fifo_get04(hl_fifo_t *fifo, uint8_t *data, uint8_t *remain
         return(hl_res_NOK_nodata);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
     
     
     s_hl_fifo_itemofsize04copy((uint32_t*)data, 0, (uint32_t*)fifo->data, start);
@@ -683,7 +748,7 @@ extern hl_result_t hl_fifo_get04(hl_fifo_t *fifo, uint8_t *data, uint8_t *remain
     fifo->size --;
     if(NULL != remaining)
     {
-        *remaining = fifo->size;
+        *remaining = s_hl_fifo_saturated(fifo->size);
     }
     
     return(hl_res_OK);
@@ -712,11 +777,7 @@ extern hl_result_t hl_fifo_put04(hl_fifo_t *fifo, uint8_t *data)
     // else just advance the index and size
     
     fifo->size ++;
-    fifo->index ++;
-    if(fifo->index == fifo->capacity)
-    {
-        fifo->index = 0;
-    }
+    fifo->index = s_hl_fifo_wrap(fifo, fifo->index + 1);
     
     return(hl_res_OK);
 }
@@ -741,13 +802,9 @@ extern uint8_t * hl_fifo_front02(hl_fifo_t *fifo)
         return(NULL);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
 
-    return(s_hl_fifo_itemofsize02addr((uint16_t*)fifo->data, start));   
+    return((uint8_t*)&(((uint16_t*)fifo->data)[start]));   
 }
 
 
@@ -767,11 +824,7 @@ extern hl_result_t hl_fifo_get02(hl_fifo_t *fifo, uint8_t *data, uint8_t *remain
         return(hl_res_NOK_nodata);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
     
     
     s_hl_fifo_itemofsize02copy((uint16_t*)data, 0, (uint16_t*)fifo->data, start);
@@ -780,7 +833,7 @@ extern hl_result_t hl_fifo_get02(hl_fifo_t *fifo, uint8_t *data, uint8_t *remain
     fifo->size --;
     if(NULL != remaining)
     {
-        *remaining = fifo->size;
+        *remaining = s_hl_fifo_saturated(fifo->size);
     }
     
     return(hl_res_OK);
@@ -809,11 +862,7 @@ extern hl_result_t hl_fifo_put02(hl_fifo_t *fifo, uint8_t *data)
     // else just advance the index and size
    
     fifo->size ++;
-    fifo->index ++;
-    if(fifo->index == fifo->capacity)
-    {
-        fifo->index = 0;
-    }
+    fifo->index = s_hl_fifo_wrap(fifo, fifo->index + 1);
     
     return(hl_res_OK);
 }
@@ -837,13 +886,9 @@ extern uint8_t * hl_fifo_front01(hl_fifo_t *fifo)
         return(NULL);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
 
-    return(s_hl_fifo_itemofsize01addr((uint8_t*)fifo->data, start));   
+    return((uint8_t*)&(((uint8_t*)fifo->data)[start]));   
 }
 
 
@@ -863,11 +908,7 @@ extern hl_result_t hl_fifo_get01(hl_fifo_t *fifo, uint8_t *data, uint8_t *remain
         return(hl_res_NOK_nodata);
     }
     
-    start = (fifo->capacity + fifo->index - fifo->size);
-    if(start >= fifo->capacity)
-    {
-        start -= fifo->capacity;
-    }
+    start = s_hl_fifo_first(fifo);
     
     
     s_hl_fifo_itemofsize01copy((uint8_t*)data, 0, (uint8_t*)fifo->data, start);
@@ -876,7 +917,7 @@ extern hl_result_t hl_fifo_get01(hl_fifo_t *fifo, uint8_t *data, uint8_t *remain
     fifo->size --;
     if(NULL != remaining)
     {
-        *remaining = fifo->size;
+        *remaining = s_hl_fifo_saturated(fifo->size);
     }
     
     return(hl_res_OK);
@@ -905,11 +946,7 @@ extern hl_result_t hl_fifo_put01(hl_fifo_t *fifo, uint8_t *data)
     // else just advance the index and size
    
     fifo->size ++;
-    fifo->index ++;
-    if(fifo->index == fifo->capacity)
-    {
-        fifo->index = 0;
-    }
+    fifo->index = s_hl_fifo_wrap(fifo, fifo->index + 1);
     
     return(hl_res_OK);
 }
@@ -932,21 +969,33 @@ extern hl_result_t hl_fifo_put01(hl_fifo_t *fifo, uint8_t *data)
 // --------------------------------------------------------------------------------------------------------------------
 
 
-static void s_hl_fifo_itemofsize01copy(uint8_t* dst, uint32_t offsetdst, uint8_t* src, uint32_t offsetsrc)
+// it brings back into [0, capacity) a position which is lower than 2*capacity 
+static uint32_t s_hl_fifo_wrap(hl_fifo_t *fifo, uint32_t pos)
 {
-    dst   += (offsetdst);
-    src   += (offsetsrc);
-    *dst   = *src; 
+    if(1 == fifo->pow2)
+    {   // mask with capacity-1
+        return(pos & (fifo->capacity - 1));
+    }
+    
+    return((pos >= fifo->capacity) ? (pos - fifo->capacity) : (pos));
 }
 
 
-static uint8_t* s_hl_fifo_itemofsize01addr(uint8_t* pool, uint32_t pos)
+// the position of the first item, valid only if size is not zero
+static uint32_t s_hl_fifo_first(hl_fifo_t *fifo)
 {
-    return((uint8_t*)&(pool[pos]));
+    return(s_hl_fifo_wrap(fifo, (uint32_t)fifo->capacity + fifo->index - fifo->size));
 }
 
 
-static void s_hl_fifo_itemofsize02copy(uint16_t* dst, uint32_t offsetdst, uint16_t* src, uint32_t offsetsrc)
+// the sizes of the old api with uint8_t
+static uint8_t s_hl_fifo_saturated(uint16_t value)
+{
+    return((value > 255) ? (255) : ((uint8_t)value));
+}
+
+
+static void s_hl_fifo_itemofsize01copy(uint8_t* dst, uint32_t offsetdst, uint8_t* src, uint32_t offsetsrc)
 {
     dst   += (offsetdst);
     src   += (offsetsrc);
@@ -954,12 +1003,16 @@ static void s_hl_fifo_itemofsize02copy(uint16_t* dst, uint32_t offsetdst, uint16
 }
 
 
-static uint8_t* s_hl_fifo_itemofsize02addr(uint16_t* pool, uint32_t pos)
+
+static void s_hl_fifo_itemofsize02copy(uint16_t* dst, uint32_t offsetdst, uint16_t* src, uint32_t offsetsrc)
 {
-    return((uint8_t*)&(pool[pos]));
+    dst   += (offsetdst);
+    src   += (offsetsrc);
+    *dst   = *src; 
 }
 
 
+
 static void s_hl_fifo_itemofsize04copy(uint32_t* dst, uint32_t offsetdst, uint32_t* src, uint32_t offsetsrc)
 {
     dst   += (offsetdst);
@@ -968,11 +1021,6 @@ static void s_hl_fifo_itemofsize04copy(uint32_t* dst, uint32_t offsetdst, uint32
 }
 
 
-static uint8_t* s_hl_fifo_itemofsize04addr(uint32_t* pool, uint32_t pos)
-{
-    return((uint8_t*)&(pool[pos]));
-}
-
 
 static void s_hl_fifo_itemofsize08copy(uint64_t* dst, uint32_t offsetdst, uint64_t* src, uint32_t offsetsrc)
 {
@@ -982,11 +1030,6 @@ static void s_hl_fifo_itemofsize08copy(uint64_t* dst, uint32_t offsetdst, uint64
 }
 
 
-static uint8_t* s_hl_fifo_itemofsize08addr(uint64_t* pool, uint32_t pos)
-{
-    return((uint8_t*)&(pool[pos]));
-}
-
 
 static void s_hl_fifo_itemofsize16copy(uint64_t* dst, uint32_t offsetdst, uint64_t* src, uint32_t offsetsrc)
 {
@@ -997,11 +1040,6 @@ static void s_hl_fifo_itemofsize16copy(uint64_t* dst, uint32_t offsetdst, uint64
 }
 
 
-static uint8_t* s_hl_fifo_itemofsize16addr(uint64_t* pool, uint32_t pos)
-{
-    return((uint8_t*)&(pool[pos<<1]));
-}
-
 
 
 #endif//defined(HL_USE_UTIL_FIFO)
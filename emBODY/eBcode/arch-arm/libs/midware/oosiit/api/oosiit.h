@@ -720,6 +720,36 @@ extern oosiit_result_t oosiit_advtmr_isactive(oosiit_objptr_t timer);
 extern oosiit_result_t oosiit_advtmr_delete(oosiit_objptr_t timer);
 
 
+/** @fn         extern oosiit_result_t oosiit_advtmr_defer(oosiit_objptr_t timer, uint8_t on)
+    @brief      Tells if the callback of an advanced timer is executed by the scheduler at expiry (on = 0, the default) or 
+                is queued for the timer task configured with oosiit_advtmr_deferred_config() (on = 1). A deferred callback 
+                runs in the context of a task, hence it may be long and may call any oosiit function. If there is no timer
+                task or if its queue is full, the callback is executed by the scheduler. The setting survives stop and expiry. 
+                The function can be called also from within an ISR.
+    @param      timer           the advanced timer.
+    @param      on              1 to defer the callback, 0 to execute it at expiry.
+    @return     oosiit_res_OK or oosiit_res_NOK if the timer is not valid.
+ **/
+extern oosiit_result_t oosiit_advtmr_defer(oosiit_objptr_t timer, uint8_t on);
+
+
+/** @fn         extern oosiit_result_t oosiit_advtmr_deferred_config(oosiit_tskptr_t tp, uint32_t flags)
+    @brief      Sets the timer task which executes the deferred callbacks. When at least one deferred callback is queued, 
+                the scheduler sends the event flags to the task, which then must call oosiit_advtmr_deferred_process().
+    @param      tp              the timer task. If NULL, all callbacks are executed by the scheduler.
+    @param      flags           the event flags sent to the timer task.
+    @return     oosiit_res_OK or oosiit_res_NOK if the task is not valid.
+ **/
+extern oosiit_result_t oosiit_advtmr_deferred_config(oosiit_tskptr_t tp, uint32_t flags);
+
+
+/** @fn         extern uint16_t oosiit_advtmr_deferred_process(void)
+    @brief      Executes the deferred callbacks queued so far. It must be called only by the timer task.
+    @return     The number of executed callbacks.
+ **/
+extern uint16_t oosiit_advtmr_deferred_process(void);
+
+
 
 /* @}            
     end of group oosiit  
@@ -75,6 +75,28 @@ extern void oosiit_ext_free(void* m)
 }
 
 
+// the deferred callbacks of the advanced timers are in the oosiit library only since the timer wheel. these fallbacks let
+// an application which uses them link also with an older library, where every callback is executed by the scheduler.
+// the linker prefers the definitions of the library when it has them.
+
+__weak extern oosiit_result_t oosiit_advtmr_defer(oosiit_objptr_t timer, uint8_t on)
+{
+    return((0 == on) ? (oosiit_res_OK) : (oosiit_res_NOK));
+}
+
+
+__weak extern oosiit_result_t oosiit_advtmr_deferred_config(oosiit_tskptr_t tp, uint32_t flags)
+{
+    return((NULL == tp) ? (oosiit_res_OK) : (oosiit_res_NOK));
+}
+
+
+__weak extern uint16_t oosiit_advtmr_deferred_process(void)
+{
+    return(0);
+}
+
+
 // --------------------------------------------------------------------------------------------------------------------
 // --------------------------------------------------------------------------------------------------------------------
 // - storage and some other function definitions for IIT extension and for RL-RTX. 
@@ -1287,6 +1287,36 @@ extern oosiit_result_t oosiit_advtmr_delete(oosiit_objptr_t timer)
     }
 }
 
+extern oosiit_result_t oosiit_advtmr_defer(oosiit_objptr_t timer, uint8_t on)
+{
+    if(oosiit_res_NOK == s_oosiit_advtmr_valid(timer))
+    {
+        return(oosiit_res_NOK);
+    }  
+    
+    return((OS_R_OK == rt_iit_advtmr_defer(timer, on)) ? (oosiit_res_OK) : (oosiit_res_NOK));
+}
+
+extern oosiit_result_t oosiit_advtmr_deferred_config(oosiit_tskptr_t tp, uint32_t flags)
+{
+    if((NULL != tp) && (oosiit_res_NOK == s_oosiit_tsk_valid(tp)))
+    {
+        return(oosiit_res_NOK);
+    }
+    
+    return((OS_R_OK == rt_iit_advtmr_deferred_config(tp, flags)) ? (oosiit_res_OK) : (oosiit_res_NOK));
+}
+
+extern uint16_t oosiit_advtmr_deferred_process(void)
+{
+    if(0 != __get_IPSR()) 
+    {   // only the timer task can execute the deferred callbacks
+        return(0);
+    } 
+    
+    return(rt_iit_advtmr_deferred_process());
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern hidden functions 
 // --------------------------------------------------------------------------------------------------------------------
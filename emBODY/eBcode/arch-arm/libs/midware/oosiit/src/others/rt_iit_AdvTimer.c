@@ -73,6 +73,7 @@
 #include "rt_MemBox.h"
 #include "rt_List.h"
 #include "rt_System.h"
+#include "rt_iit_changes.h"
 
 #include "rt_iit_AdvTimer.h"
 #include "oosiit_hid.h"         
@@ -107,6 +108,12 @@
 #define ISRCMD_START        2
 #define ISRCMD_DELETE       3
 
+#define WHEELMASK           (OOSIIT_ADVTMR_WHEELSIZE-1)
+
+#if (0 != (OOSIIT_ADVTMR_WHEELSIZE & WHEELMASK))
+    #error OOSIIT_ADVTMR_WHEELSIZE must be a power of two
+#endif
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of extern variables, but better using _get(), _set() 
 // --------------------------------------------------------------------------------------------------------------------
@@ -117,6 +124,34 @@
 // --------------------------------------------------------------------------------------------------------------------
 // - typedef with internal scope
 // --------------------------------------------------------------------------------------------------------------------
+
+// the active timers are kept in a hashed wheel: the timer which expires at tick t is in slot[t & WHEELMASK], in a 
+// doubly linked list which is unsorted. insertion and removal are O(1) and the tick scans only one slot.
+typedef struct
+{
+    PIIT_ADVTMR             slot[OOSIIT_ADVTMR_WHEELSIZE];
+    WIDETIME_t              tick;           // ticks processed by the wheel. it does not change with oosiit_time_set()
+    U16                     numactive;
+} iit_advtmr_wheel_t;
+
+// an expired callback which waits for the timer task. we keep cbk and par because a one-shot timer is cleared at expiry 
+typedef struct
+{
+    PIIT_ADVTMR             tmr;
+    void_fp_voidp_voidp     cbk;
+    void                    *par;
+} iit_advtmr_deferred_item_t;
+
+// single-producer (the systick) single-consumer (the timer task) queue
+typedef struct
+{
+    void                            *task;
+    U32                             flags;
+    volatile U8                     put;
+    volatile U8                     get;
+    U32                             overflows;
+    iit_advtmr_deferred_item_t      items[OOSIIT_ADVTMR_DEFERREDCAPACITY+1];
+} iit_advtmr_deferred_t;
  
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -129,11 +164,13 @@ static OS_ID s_rt_iit_advtmr_delete (OS_ID timer);
 
 static void s_rt_iit_advtmr_insert(PIIT_ADVTMR p_tmr, WIDETIME_t itcnt);
 
+static void s_rt_iit_advtmr_remove(PIIT_ADVTMR p_tmr);
+
 static void s_rt_iit_advtmr_clear(PIIT_ADVTMR p_tmr);
 
-static void s_rt_iit_advtmr_synchronise_staticversion(U64 oldtime);
+static void s_rt_iit_advtmr_expire(PIIT_ADVTMR p_tmr);
 
-static void s_rt_iit_advtmr_synchronise_dynamicversion(U64 oldtime); 
+static U8 s_rt_iit_advtmr_deferred_put(PIIT_ADVTMR p_tmr);
 
 
 
@@ -141,8 +178,9 @@ static void s_rt_iit_advtmr_synchronise_dynamicversion(U64 oldtime);
 // - definition (and initialisation) of static variables
 // --------------------------------------------------------------------------------------------------------------------
 
-/* User Timer list pointer */
-static struct OSIIT_XADVTMR os_iit_advtmr;
+static iit_advtmr_wheel_t os_iit_advtmr;
+
+static iit_advtmr_deferred_t os_iit_advtmr_deferred;
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -173,6 +211,7 @@ OS_ID rt_iit_advtmr_new (void)
 
    // reset fields
    s_rt_iit_advtmr_clear(p_tmr);
+   p_tmr->isdeferred = 0;
 
    
    return (p_tmr);
@@ -217,8 +256,8 @@ void rt_iit_advtmr_init(void)
 {
    // init iit advanced timers
    
-   os_iit_advtmr.next = NULL;
-   os_iit_advtmr.tcnt = 0;
+   memset(&os_iit_advtmr, 0, sizeof(os_iit_advtmr));
+   memset(&os_iit_advtmr_deferred, 0, sizeof(os_iit_advtmr_deferred));
 
    if(NULL != oosiit_cfg_advtmr_ptrs)
    {
@@ -231,79 +270,187 @@ void rt_iit_advtmr_init(void)
    }
 }
 
-void rt_iit_advtmr_tick (void) {
-   /* Decrement delta count of timer list head. Timers having the value of   */
-   /* zero are removed from the list and the callback function is called.    */
-   PIIT_ADVTMR p;
-   void_fp_voidp_voidp fn_cback;
+void rt_iit_advtmr_tick (void) 
+{
+    // advance the wheel and scan only the slot of the current tick. the slot also holds timers which expire 
+    // one or more turns later: they have a different expiry and are skipped.
+    PIIT_ADVTMR p, next;
+    U8 signal = 0;
+
+    os_iit_advtmr.tick++;
 
-   if (os_iit_advtmr.next == NULL) {
-      return;
-   }
-   os_iit_advtmr.tcnt--;
+    if(0 == os_iit_advtmr.numactive) 
+    {
+        return;
+    }
 
 #ifdef  _DEBUG_THE_TIME_SHIFT_	
-   s_rt_iit_advtmr_debug_read_list_of_active_timers();
+    s_rt_iit_advtmr_debug_read_list_of_active_timers();
 #endif//_DEBUG_THE_TIME_SHIFT_
 
-   while ((os_iit_advtmr.tcnt == 0) && ((p = os_iit_advtmr.next) != NULL)) {
+    p = os_iit_advtmr.slot[os_iit_advtmr.tick & WHEELMASK];
 
-      // compute for next timer
-      os_iit_advtmr.tcnt = p->tcnt;
-      os_iit_advtmr.next = p->next;
+    while(NULL != p)
+    {
+        // the expiry may put p back at the head of this same slot, hence we get its next now 
+        next = p->next;
 
-      // treat the one just expired ... only if it is NOT being processed by a post-isr 
+        if(p->expiry == os_iit_advtmr.tick)
+        {
+            s_rt_iit_advtmr_remove(p);
 
-      if(0 == p->isrbusy)
-      { 
-          // 1. call a user provided function
-          fn_cback = p->cbk;
-          if(NULL != fn_cback)
-          {
-                fn_cback(p, p->par);
-          }
-    
-          // 2. evaluate if it is periodic or oneshot
-          if(0 != p->period_iit) 
-          {  // periodic
-             if(OOSIIT_ASAPTIME != p->abstime_iit)
-             {  // absolute
-                p->abstime_iit += p->period_iit;
-                s_rt_iit_advtmr_insert(p, p->abstime_iit - oosiit_time);
-             }
-             else
-             {  // relative
-                s_rt_iit_advtmr_insert(p, p->period_iit);
-             }
-          }
-          else 
-          {  // one-shot
-             // dont delete the one-shot expired timer
-             // rt_free_box ((U32 *)oosiit_cfg_advtmr, p);
-             // just reset it
-             s_rt_iit_advtmr_clear(p);
-          }
-
-      }
+            // treat the one just expired ... only if it is NOT being processed by a post-isr
+            if(0 == p->isrbusy)
+            {
+                if((1 == p->isdeferred) && (NULL != p->cbk) && (1 == s_rt_iit_advtmr_deferred_put(p)))
+                {
+                    signal = 1;
+                }
+                else if(NULL != p->cbk)
+                {
+                    p->cbk(p, p->par);
+                }
 
-   }
+                s_rt_iit_advtmr_expire(p);
+            }
+            else
+            {   // the post-isr will start, stop or delete it: it must find it inactive and out of the wheel
+                p->isactive = 0;
+            }
+        }
+
+        p = next;
+    }
+
+    if(1 == signal)
+    {
+        iitchanged_isr_evt_set(os_iit_advtmr_deferred.flags, os_iit_advtmr_deferred.task);
+    }
    
 #ifdef _DEBUG_THE_TIME_SHIFT_ 
-   s_rt_iit_advtmr_debug_read_list_of_active_timers();
+    s_rt_iit_advtmr_debug_read_list_of_active_timers();
 #endif
 
 } 
 
 void rt_iit_advtmr_synchronise(U64 oldtime) 
 {
-    if(NULL != oosiit_cfg_advtmr_ptrs)
-    {        
-        s_rt_iit_advtmr_synchronise_staticversion(oldtime);
+    // remove the absolute timers from the wheel and chain them in a temporary list.
+    // then start them again vs the new oosiit_time. the incremental timers are not affected.
+    U16 i;
+    PIIT_ADVTMR p, next;
+    PIIT_ADVTMR absolutes = NULL;
+    oosiit_advtmr_timing_t timing;
+    oosiit_advtmr_action_t action;
+
+#ifdef _DEBUG_THE_TIME_SHIFT_
+    s_rt_iit_advtmr_debug_read_list_of_active_timers();
+#endif
+
+    // stage 1: remove from the wheel every absolute timer
+    for(i=0; i<OOSIIT_ADVTMR_WHEELSIZE; i++)
+    {
+        p = os_iit_advtmr.slot[i];
+        while(NULL != p)
+        {
+            next = p->next;
+            if(OOSIIT_ASAPTIME != p->abstime_iit)
+            {   // found an absolute timer: remove the timer but dont destroy it.
+                s_rt_iit_advtmr_remove(p);
+                p->next = absolutes;
+                absolutes = p;
+            }
+            p = next;
+        }
+    }
+
+    // stage 2: start them again
+    while(NULL != absolutes)
+    {
+        p = absolutes;
+        absolutes = p->next;
+
+        // fill action
+        action.cbk          = p->cbk;
+        action.par          = p->par;
+
+        // fill timing. 
+        // if periodic it is easy: we leave the same values. if singleshot in the future ok. if in the past we set curtime+1.
+
+        if(0 != p->period_iit)
+        {   // periodic: easy as we leave the same values
+            timing.startat      = p->startat_iit - p->period_iit;
+            timing.firstshot    = p->period_iit;
+            timing.othershots   = p->period_iit;
+        }
+        else if(p->abstime_iit > oosiit_time)
+        {   // singleshot in the future: we set startat with the desired expiry time
+            timing.startat      = p->abstime_iit;
+            timing.firstshot    = 0;
+            timing.othershots   = 0;
+        }
+        else
+        {   // singleshot in the past: we execute it at next tick
+            timing.startat      = oosiit_time + 1;
+            timing.firstshot    = 0;
+            timing.othershots   = 0;
+        }
+
+        // now clear the timer and start it. the clear does not change the isdeferred flag 
+        s_rt_iit_advtmr_clear(p);
+        s_rt_iit_advtmr_start(p, &timing, &action);
+    }
+
+#ifdef _DEBUG_THE_TIME_SHIFT_
+    s_rt_iit_advtmr_debug_read_list_of_active_timers();
+#endif
+}
+
+
+OS_RESULT rt_iit_advtmr_defer(OS_ID timer, U8 on)
+{
+    PIIT_ADVTMR p_tmr = (PIIT_ADVTMR)timer;
+
+    if(NULL == p_tmr)
+    {
+        return(OS_R_NOK);
     }
-    else
+
+    p_tmr->isdeferred = (0 == on) ? (0) : (1);
+
+    return(OS_R_OK);
+}
+
+
+OS_RESULT rt_iit_advtmr_deferred_config(void* task, U32 flags)
+{
+    // the flags first, so that the systick never signals the new task with the old flags
+    os_iit_advtmr_deferred.task = NULL;
+    os_iit_advtmr_deferred.flags = flags;
+    os_iit_advtmr_deferred.task = task;
+
+    return(OS_R_OK);
+}
+
+
+U16 rt_iit_advtmr_deferred_process(void)
+{
+    // executed by the timer task: it is the only consumer of the queue
+    U16 n = 0;
+    U8 get = os_iit_advtmr_deferred.get;
+    iit_advtmr_deferred_item_t *item;
+
+    while(get != os_iit_advtmr_deferred.put)
     {
-        s_rt_iit_advtmr_synchronise_dynamicversion(oldtime);
+        item = &os_iit_advtmr_deferred.items[get];
+        item->cbk(item->tmr, item->par);
+        n++;
+
+        get = (OOSIIT_ADVTMR_DEFERREDCAPACITY == get) ? (0) : (get+1);
+        os_iit_advtmr_deferred.get = get;
     }
+
+    return(n);
 }
 
 
@@ -544,8 +691,8 @@ static OS_RESULT s_rt_iit_advtmr_start (OS_ID timer, void* timing, void* action)
 }
 
 static OS_RESULT s_rt_iit_advtmr_stop (OS_ID timer)  {
-   /* Remove user timer from the chained timer list. */
-   PIIT_ADVTMR p, p_tmr;
+   /* Remove user timer from its slot of the wheel. */
+   PIIT_ADVTMR p_tmr;
 
    p_tmr = (PIIT_ADVTMR)timer;
 
@@ -554,18 +701,7 @@ static OS_RESULT s_rt_iit_advtmr_stop (OS_ID timer)  {
        return(OS_R_OK);
    }
 
-   p = (PIIT_ADVTMR)&os_iit_advtmr;
-   /* Search timer list for requested timer */
-   while (p->next != p_tmr)  {
-      if (p->next == NULL) {
-         /* Failed, "timer" is not in the timer list */
-         return (OS_R_NOK);
-      }
-      p = p->next;
-   }
-   /* Timer was found, remove it from the list */
-   p->next = p_tmr->next;
-   p->tcnt += p_tmr->tcnt;
+   s_rt_iit_advtmr_remove(p_tmr);
    
    // reset fields
    s_rt_iit_advtmr_clear(p_tmr);
@@ -602,29 +738,62 @@ static OS_ID s_rt_iit_advtmr_delete (OS_ID timer)  {
 
 static void s_rt_iit_advtmr_insert(PIIT_ADVTMR p_tmr, WIDETIME_t itcnt) 
 {  
-   PIIT_ADVTMR p;  
-   WIDETIME_t delta;
-
-   p = (PIIT_ADVTMR)&os_iit_advtmr;
-   delta = p->tcnt;
-   while (delta < itcnt && p->next != NULL) {
-      p = p->next;
-      delta += p->tcnt;
+   PIIT_ADVTMR *head;
+
+   // an expiry in the current tick or in the past would be missed by the wheel: we use the next tick
+   if(0 == itcnt)
+   {
+      itcnt = 1;
+   }
+
+   p_tmr->expiry = os_iit_advtmr.tick + itcnt;
+
+   // put it at the head of the slot
+   head = &os_iit_advtmr.slot[p_tmr->expiry & WHEELMASK];
+   p_tmr->prev = NULL;
+   p_tmr->next = *head;
+   if(NULL != *head)
+   {
+      (*head)->prev = p_tmr;
+   }
+   *head = p_tmr;
+
+   os_iit_advtmr.numactive++;
+}
+
+
+static void s_rt_iit_advtmr_remove(PIIT_ADVTMR p_tmr)
+{
+   if(NULL != p_tmr->prev)
+   {
+      p_tmr->prev->next = p_tmr->next;
+   }
+   else
+   {
+      os_iit_advtmr.slot[p_tmr->expiry & WHEELMASK] = p_tmr->next;
+   }
+
+   if(NULL != p_tmr->next)
+   {
+      p_tmr->next->prev = p_tmr->prev;
    }
-   /* Right place found, insert timer into the list */
-   p_tmr->next = p->next;
-   p_tmr->tcnt = (TIME_t)(delta - itcnt);
-   p->next = p_tmr;
-   p->tcnt -= p_tmr->tcnt;
+
+   p_tmr->next = NULL;
+   p_tmr->prev = NULL;
+
+   os_iit_advtmr.numactive--;
 }
 
 
 static void s_rt_iit_advtmr_clear(PIIT_ADVTMR p_tmr)
 {
+    // the isdeferred flag is a property of the timer which survives its stop and expiry: rt_iit_advtmr_new() sets it
     p_tmr->cb_type          = ATCB; 
     p_tmr->isrbusy          = 0;
     p_tmr->isactive         = 0;
     p_tmr->next             = NULL;
+    p_tmr->prev             = NULL;
+    p_tmr->expiry           = 0;
     p_tmr->tcnt             = 0;
     p_tmr->period_iit       = 0; 
     p_tmr->startat_iit      = 0;
@@ -633,215 +802,53 @@ static void s_rt_iit_advtmr_clear(PIIT_ADVTMR p_tmr)
     p_tmr->par              = NULL;
 }
 
-static void s_rt_iit_advtmr_synchronise_staticversion(U64 oldtime) 
-{
-    // remove the absolute timers and put them in a temporary array.
-    // then reinsert them again in the list.
-    U8 i;
-    PIIT_ADVTMR prev, p_tmr;
-    oosiit_advtmr_timing_t timing;
-    oosiit_advtmr_action_t action;
-    
-
-    memset(&((oosiit_arrayhead_t*)oosiit_cfg_advtmr_ptrs)->data[0], 0, 4*((oosiit_arrayhead_t*)oosiit_cfg_advtmr_ptrs)->capacity);
-    ((oosiit_arrayhead_t*)oosiit_cfg_advtmr_ptrs)->size = 0;
-
-
-#ifdef _DEBUG_THE_TIME_SHIFT_
-    s_rt_iit_advtmr_debug_read_list_of_active_timers();
-#endif
 
-    // stage 1: remove from the list every absolute timer
-    prev = (PIIT_ADVTMR)&os_iit_advtmr;
-    while(NULL != prev->next)  
-    {
-        // work on its next.
-        p_tmr = prev->next;
-#ifdef _DEBUG_THE_TIME_SHIFT_
-        s_rt_iit_advtmr_debug_read_list_of_active_timers();
-#endif
-        if(OOSIIT_ASAPTIME == p_tmr->abstime_iit) 
-        {   // the timer is an incremental one
-            prev = p_tmr;
-            continue;        
+static void s_rt_iit_advtmr_expire(PIIT_ADVTMR p_tmr)
+{
+    // the timer is already out of the wheel: evaluate if it is periodic or oneshot
+    if(0 != p_tmr->period_iit) 
+    {   // periodic
+        if(OOSIIT_ASAPTIME != p_tmr->abstime_iit)
+        {   // absolute
+            p_tmr->abstime_iit += p_tmr->period_iit;
+            s_rt_iit_advtmr_insert(p_tmr, (p_tmr->abstime_iit > oosiit_time) ? (p_tmr->abstime_iit - oosiit_time) : (1));
         }
         else
-        {   // found an absolute timer
-
-            // remove the timer but dont destroy it.
-            prev->next = p_tmr->next;
-            prev->tcnt += p_tmr->tcnt;
-#ifdef _DEBUG_THE_TIME_SHIFT_
-            s_rt_iit_advtmr_debug_read_list_of_active_timers();
-#endif
-            // put the timer inside the array
-            ((oosiit_arrayhead_t*)oosiit_cfg_advtmr_ptrs)->data[((oosiit_arrayhead_t*)oosiit_cfg_advtmr_ptrs)->size++] = (U32)p_tmr;
-
+        {   // relative
+            s_rt_iit_advtmr_insert(p_tmr, p_tmr->period_iit);
         }
-
     }
-
-    // stage 2: insert them back in the list
-#ifdef _DEBUG_THE_TIME_SHIFT_
-    s_rt_iit_advtmr_debug_read_list_of_active_timers();
-#endif
-    for(i=0; i<((oosiit_arrayhead_t*)oosiit_cfg_advtmr_ptrs)->size; i++)
-    {
-        p_tmr = (PIIT_ADVTMR) ((oosiit_arrayhead_t*)oosiit_cfg_advtmr_ptrs)->data[i];
-
-        // fill action
-        action.cbk          = p_tmr->cbk;
-        action.par          = p_tmr->par;
-
-        // fill timing. 
-        // if periodic it is easy: we leave the same values. if singleshot in the future ok. if in the past we set curtime+1.
-
-        if(0 != p_tmr->period_iit)
-        {   // periodic: easy as we leave the same values
-            timing.startat      = p_tmr->startat_iit - p_tmr->period_iit;
-            timing.firstshot    = p_tmr->period_iit;
-            timing.othershots   = p_tmr->period_iit;
-        }
-        else if(p_tmr->abstime_iit > oosiit_time)
-        {   // singleshot in the future: we set startat with the desired expiry time
-            timing.startat      = p_tmr->abstime_iit;
-            timing.firstshot    = 0;
-            timing.othershots   = 0;
-        }
-        else
-        {   // singleshot in the past: we execute it at next tick
-            timing.startat      = oosiit_time + 1;
-            timing.firstshot    = 0;
-            timing.othershots   = 0;
-        }
-
-
-        // now clear the timer and start it
+    else 
+    {   // one-shot
+        // dont delete the one-shot expired timer
+        // rt_free_box ((U32 *)oosiit_cfg_advtmr, p);
+        // just reset it
         s_rt_iit_advtmr_clear(p_tmr);
-        s_rt_iit_advtmr_start(p_tmr, &timing, &action);
-#ifdef _DEBUG_THE_TIME_SHIFT_
-        s_rt_iit_advtmr_debug_read_list_of_active_timers();
-#endif
     }
-
 }
 
-static void s_rt_iit_advtmr_synchronise_dynamicversion(U64 oldtime) 
-{
-    // remove the absolute timers and put them in a temporary array.
-    // then reinsert them again in the list.
-    PIIT_ADVTMR prev, p_tmr;
-    oosiit_advtmr_timing_t timing;
-    oosiit_advtmr_action_t action;
-    
-    PIIT_ADVTMR* storedabsolutetimers = NULL;
-    uint16_t numberofstoredabsolutetimers = 0;
-    uint16_t i=0;
-    
-    
-
-#ifdef _DEBUG_THE_TIME_SHIFT_
-    s_rt_iit_advtmr_debug_read_list_of_active_timers();
-#endif
-    
-    // stage 0: count int the list every absolute timer
-    prev = (PIIT_ADVTMR)&os_iit_advtmr;
-    while(NULL != prev->next)  
-    {
-        // work on its next.
-        p_tmr = prev->next;
-
-        if(OOSIIT_ASAPTIME == p_tmr->abstime_iit) 
-        {   // the timer is an incremental one
-            prev = p_tmr;
-            continue;        
-        }
-        else
-        {   // found an absolute timer
-            numberofstoredabsolutetimers++;
-        }
-    }  
-
-    if(numberofstoredabsolutetimers > 0)
-    {
-        storedabsolutetimers = oosiit_ext_calloc(sizeof(PIIT_ADVTMR), numberofstoredabsolutetimers);
-    }
 
-    // stage 1: remove from the list every absolute timer
-    prev = (PIIT_ADVTMR)&os_iit_advtmr;
-    while(NULL != prev->next)  
-    {
-        // work on its next.
-        p_tmr = prev->next;
-#ifdef _DEBUG_THE_TIME_SHIFT_
-        s_rt_iit_advtmr_debug_read_list_of_active_timers();
-#endif
-        if(OOSIIT_ASAPTIME == p_tmr->abstime_iit) 
-        {   // the timer is an incremental one
-            prev = p_tmr;
-            continue;        
-        }
-        else
-        {   // found an absolute timer
+static U8 s_rt_iit_advtmr_deferred_put(PIIT_ADVTMR p_tmr)
+{
+    // executed by the systick: it is the only producer of the queue
+    U8 put = os_iit_advtmr_deferred.put;
+    U8 nxt = (OOSIIT_ADVTMR_DEFERREDCAPACITY == put) ? (0) : (put+1);
 
-            // remove the timer but dont destroy it.
-            prev->next = p_tmr->next;
-            prev->tcnt += p_tmr->tcnt;
-#ifdef _DEBUG_THE_TIME_SHIFT_
-            s_rt_iit_advtmr_debug_read_list_of_active_timers();
-#endif
-            // put the timer inside the array
-            storedabsolutetimers[i++] = p_tmr;
+    if((NULL == os_iit_advtmr_deferred.task) || (nxt == os_iit_advtmr_deferred.get))
+    {   // no timer task or queue full: the callback is executed by the systick
+        if(NULL != os_iit_advtmr_deferred.task)
+        {
+            os_iit_advtmr_deferred.overflows++;
         }
-
+        return(0);
     }
 
-    // stage 2: insert them back in the list
-#ifdef _DEBUG_THE_TIME_SHIFT_
-    s_rt_iit_advtmr_debug_read_list_of_active_timers();
-#endif
-    for(i=0; i<numberofstoredabsolutetimers; i++)
-    {
-        p_tmr = storedabsolutetimers[i];
+    os_iit_advtmr_deferred.items[put].tmr = p_tmr;
+    os_iit_advtmr_deferred.items[put].cbk = p_tmr->cbk;
+    os_iit_advtmr_deferred.items[put].par = p_tmr->par;
+    os_iit_advtmr_deferred.put = nxt;
 
-        // fill action
-        action.cbk          = p_tmr->cbk;
-        action.par          = p_tmr->par;
-
-        // fill timing. 
-        // if periodic it is easy: we leave the same values. if singleshot in the future ok. if in the past we set curtime+1.
-
-        if(0 != p_tmr->period_iit)
-        {   // periodic: easy as we leave the same values
-            timing.startat      = p_tmr->startat_iit - p_tmr->period_iit;
-            timing.firstshot    = p_tmr->period_iit;
-            timing.othershots   = p_tmr->period_iit;
-        }
-        else if(p_tmr->abstime_iit > oosiit_time)
-        {   // singleshot in the future: we set startat with the desired expiry time
-            timing.startat      = p_tmr->abstime_iit;
-            timing.firstshot    = 0;
-            timing.othershots   = 0;
-        }
-        else
-        {   // singleshot in the past: we execute it at next tick
-            timing.startat      = oosiit_time + 1;
-            timing.firstshot    = 0;
-            timing.othershots   = 0;
-        }
-
-
-        // now clear the timer and start it
-        s_rt_iit_advtmr_clear(p_tmr);
-        s_rt_iit_advtmr_start(p_tmr, &timing, &action);
-#ifdef _DEBUG_THE_TIME_SHIFT_
-        s_rt_iit_advtmr_debug_read_list_of_active_timers();
-#endif
-    }
-    
-    
-    // finally delete the temporary memory
-    oosiit_ext_free(storedabsolutetimers);
+    return(1);
 }
 
 
@@ -861,25 +868,23 @@ U8 debug_tmrs[6];
 
 static void s_rt_iit_advtmr_debug_read_list_of_active_timers(void)
 {
-    struct OSIIT_XADVTMR my_iit_advtmr;
     PIIT_ADVTMR pp;
+    U16 i;
 
     debug_linfo_size = 0;
-    my_iit_advtmr.next = os_iit_advtmr.next;
-    my_iit_advtmr.tcnt = os_iit_advtmr.tcnt;
-    while((pp = my_iit_advtmr.next) != NULL)
+    for(i=0; i<OOSIIT_ADVTMR_WHEELSIZE; i++)
     {
-        debug_tmrs[debug_linfo_size]                = (((U32)pp->par) & 0xFF00)>>8;
-        if(0 == debug_tmrs[debug_linfo_size])       debug_tmrs[debug_linfo_size] = 1;
-        debug_linfo_data[debug_linfo_size].tmr      = (U32)pp;
-        debug_linfo_data[debug_linfo_size].delta    = pp->tcnt;
-        debug_linfo_data[debug_linfo_size].abstime  = pp->abstime_iit;
-        debug_linfo_data[debug_linfo_size].tid      = (((U32)pp->par) & 0xFFFF);
-
-        debug_linfo_size++;
-
-        my_iit_advtmr.tcnt = pp->tcnt;
-        my_iit_advtmr.next = pp->next;
+        for(pp = os_iit_advtmr.slot[i]; (NULL != pp) && (debug_linfo_size < 6); pp = pp->next)
+        {
+            debug_tmrs[debug_linfo_size]                = (((U32)pp->par) & 0xFF00)>>8;
+            if(0 == debug_tmrs[debug_linfo_size])       debug_tmrs[debug_linfo_size] = 1;
+            debug_linfo_data[debug_linfo_size].tmr      = (U32)pp;
+            debug_linfo_data[debug_linfo_size].delta    = (U32)(pp->expiry - os_iit_advtmr.tick);
+            debug_linfo_data[debug_linfo_size].abstime  = pp->abstime_iit;
+            debug_linfo_data[debug_linfo_size].tid      = (((U32)pp->par) & 0xFFFF);
+
+            debug_linfo_size++;
+        }
     }
 
     debug_linfo_data[0].tmr = debug_linfo_data[0].tmr;
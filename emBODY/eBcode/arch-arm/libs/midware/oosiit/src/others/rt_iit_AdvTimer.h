@@ -76,24 +76,33 @@
 
 
 // - public #define  --------------------------------------------------------------------------------------------------
+
+// number of slots of the timer wheel. it must be a power of two. a timer is kept in the slot given by its expiry tick,
+// hence every tick scans only the timers of one slot.
+#if !defined(OOSIIT_ADVTMR_WHEELSIZE)
+#define OOSIIT_ADVTMR_WHEELSIZE             64
+#endif
+
+// capacity of the queue of expired callbacks which are executed by the timer task rather than by the systick.
+// if the queue is full the callback is executed by the systick as for a normal timer.
+#if !defined(OOSIIT_ADVTMR_DEFERREDCAPACITY)
+#define OOSIIT_ADVTMR_DEFERREDCAPACITY      32
+#endif
   
 
 // - declaration of public user-defined types ------------------------------------------------------------------------- 
 
 typedef void (*void_fp_voidp_voidp)               (void*, void*);
 
-typedef struct OSIIT_XADVTMR {
-   U8                   cb_type;
-   struct OSIIT_ADVTMR  *next;
-   TIME_t               tcnt;  
-} *PIIT_XADVTMR;
-
 typedef struct OSIIT_ADVTMR {
    U8                   cb_type;
    U8                   isrbusy;
    U8                   isactive;
-   struct OSIIT_ADVTMR  *next;          /* Link pointer to Next timer              */
-   TIME_t               tcnt;                   /* Timer delay count               */   // acemor: was U16
+   U8                   isdeferred;    // if 1 the callback is executed by the timer task
+   struct OSIIT_ADVTMR  *next;          /* Link pointer to Next timer in the same wheel slot */
+   struct OSIIT_ADVTMR  *prev;          /* Link pointer to Prev timer in the same wheel slot */
+   WIDETIME_t           expiry;        // tick of the wheel at which the timer expires
+   TIME_t               tcnt;          // used only to pass the firstshot to the post-isr   // acemor: was U16
    TIME_t               period_iit;    // acemor added
    WIDETIME_t           startat_iit;   // acemor added
    WIDETIME_t           abstime_iit;   // acemor added 
@@ -134,6 +143,12 @@ extern void  rt_iit_advtmr_tick(void);
 
 extern void rt_iit_advtmr_synchronise(U64 oldtime); 
 
+extern OS_RESULT rt_iit_advtmr_defer(OS_ID timer, U8 on);
+
+extern OS_RESULT rt_iit_advtmr_deferred_config(void* task, U32 flags);
+
+extern U16 rt_iit_advtmr_deferred_process(void);
+
 
 extern void rt_advtmr_psh (OS_ID timer, U32 mode);
 
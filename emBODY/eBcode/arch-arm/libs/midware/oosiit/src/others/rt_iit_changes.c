@@ -2053,11 +2053,20 @@ extern void rt_iit_dbg_task_notify(void* ptcb, BOOL create)
     }
 }
 
+// if defined, the task switches go into the binary trace of the eventviewer also when the debugger is not attached
+//#define OOSIIT_USE_EVENTVIEWER_TRACE
+
 extern void rt_iit_dbg_task_switch(U32 task_id)
 {
     U8 id = (255==task_id) ? (ev_ID_idle) : (ev_ID_first_ostask+(U8)task_id-1);
     
+#if defined(OOSIIT_USE_EVENTVIEWER_TRACE)    
+    // we call eventviewer_switch_to() also if the itm is not initted, so that the switch goes into the binary trace
+    // of the eventviewer, which does not need the debugger. if the itm is not initted it does nothing else.
+    if(os_tsk.new == os_tsk.run)
+#else
     if((0 == oosiit_dbg_initted) || (os_tsk.new == os_tsk.run))
+#endif
     {
         return;
     }
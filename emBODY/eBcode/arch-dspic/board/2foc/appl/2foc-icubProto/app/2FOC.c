@@ -780,15 +780,9 @@ void __attribute__((__interrupt__,no_auto_psv)) _DMA0Interrupt(void)
       //   tantovale farlo ad ogni ciclo!
       //      if(speed_undersample++ == VELOCITY_CALCULATION_UNDERSAMPLE)
       {
-        int idx;
-
-        // speed_undersample = 0;
-        // increment index for velocity calculation ring buffer
-        idx = (VelocityParm.positions_buffer_index+1) % POSITIONS_BUFFER_NUM;
-        // fill the ring buffer for velocity calculation
-        VelocityParm.positions_buffer[idx] = (position);
-        // never write VelocityParm.positions_buffer_index before filled that location
-        VelocityParm.positions_buffer_index = idx;
+        // fill the ring buffer for velocity calculation. it is O(1): the
+        // estimator keeps its running sums updated
+        VelEstPush(&VelocityEstimator, Current_position);
       }
 #else
       // simple velocity calculation method no buffering used
@@ -556,6 +556,16 @@
 // for 40Khz Pwm it should be about 8K (five point, as up to 4 points might be repeated)
 #define W_COMPLEX_CALCULATION_FREQ  1000      
 
+// Estimator used by the complex speed calculation (see velest.h):
+// VELEST_MEAN, VELEST_ADAPTIVE (better resolution at low speed) or VELEST_LSQ
+#define VELOCITY_ESTIMATOR VELEST_ADAPTIVE
+// log2 of the number of FOC loops used by the estimator (for adaptive it is the max).
+// it can be at most 5 (32 loops)
+#define VELOCITY_WINDOW_LOG2 5
+// the adaptive estimator stops enlarging the window when the encoder moved at 
+// least these counts
+#define VELOCITY_ADAPTIVE_MINCOUNTS 16
+
 // Velocity PID loop undersampling, how many current loops for each W PID loop
 #define W_PID_UNDERSAMPLE W_SIMPLE_CALCULATION_UNDERSAMPLE // 200
 
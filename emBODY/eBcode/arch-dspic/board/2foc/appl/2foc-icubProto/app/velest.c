@@ -0,0 +1,185 @@
+//
+// O(1) velocity estimators working on a power-of-two ring buffer of positions.
+// See velest.h
+//
+// All the estimators see the newest positions p[last], p[last-1], ... and 
+// use windows of n = 2^k samples, so that the index wraps with a mask and
+// the divisions of the mean are shifts.
+//
+// mean:     v = (p[last] - p[last-n]) * scale / n
+//           i.e. the sum of the last n deltas, which telescopes.
+// adaptive: the same with the smallest n such that |p[last] - p[last-n]| is
+//           at least mincounts (or the max window)
+// lsq:      v = (12*S1 - 6*(n-1)*S0) * scale / (n*(n*n-1)),
+//           where S0 = sum(p), S1 = sum(w*p), w = 0 for the oldest position
+//           of the window and n-1 for the newest. when the window slides, 
+//           S1 += (n-1)*p_new - (S0 - p_old) and S0 += p_new - p_old
+//
+
+#include "velest.h"
+
+typedef struct 
+{
+  unsigned int last;
+  unsigned int nonzero;
+  int64_t s0;
+  int64_t s1;
+} tVelEstSnapshot;
+
+static int32_t VelEstDivPow2(int32_t x, unsigned int k);
+static int32_t VelEstMean(volatile tVelEst *ve, const tVelEstSnapshot *snap, unsigned int k);
+
+
+void VelEstInit(volatile tVelEst *ve, tVelEstKind kind, unsigned int window_log2, 
+                int32_t mincounts, int16_t scale, unsigned int skipzeros, int32_t position)
+// fill the buffer with the current position: the velocity is zero
+{
+  unsigned int i;
+  int64_t n;
+
+  // the window must leave room in the buffer for the oldest position
+  while((1u << window_log2) > (VELEST_BUFFER_NUM / 2))
+  {
+    window_log2--;
+  }
+
+  ve->kind = kind;
+  ve->window_log2 = window_log2;
+  ve->mincounts = (mincounts < 1) ? 1 : mincounts;
+  ve->scale = scale;
+  ve->skipzeros = skipzeros;
+
+  for(i = 0; i < VELEST_BUFFER_NUM; i++)
+  {
+    ve->positions[i] = position;
+  }
+  ve->last = 0;
+
+  // no delta is different from zero. and the sums of a window of equal positions
+  n = 1 << window_log2;
+  ve->nonzero = 0;
+  ve->s0 = n * position;
+  ve->s1 = ((n * (n - 1)) / 2) * position;
+
+  ve->pushes = 0;
+}
+
+
+void VelEstPush(volatile tVelEst *ve, int32_t position)
+// store the new position and update the running sums
+{
+  unsigned int n = 1u << ve->window_log2;
+  unsigned int idx = (ve->last + 1) & VELEST_BUFFER_MASK;
+  // the position which leaves the window, and the one before it
+  int32_t oldest = ve->positions[(idx - n) & VELEST_BUFFER_MASK];
+  int32_t beforeoldest = ve->positions[(idx - n - 1) & VELEST_BUFFER_MASK];
+
+  // number of non zero deltas in the window: add the newest, remove the oldest
+  if(position != ve->positions[ve->last])
+  {
+    ve->nonzero++;
+  }
+  if(oldest != beforeoldest)
+  {
+    ve->nonzero--;
+  }
+
+  if(VELEST_LSQ == ve->kind)
+  {
+    ve->s1 += (int64_t)(n - 1) * position - (ve->s0 - oldest);
+    ve->s0 += (int64_t)position - oldest;
+  }
+
+  // never write the index before the location is filled
+  ve->positions[idx] = position;
+  ve->last = idx;
+  ve->pushes++;
+}
+
+
+int32_t VelEstGet(volatile tVelEst *ve)
+// compute the velocity from a consistent copy of the state
+{
+  tVelEstSnapshot snap;
+  uint16_t pushes;
+  unsigned int k;
+  int64_t n;
+  int64_t num;
+
+  // the push is done by an isr of higher priority: if it happened while we were
+  // copying, copy again. the positions in the window are not overwritten for 
+  // VELEST_BUFFER_NUM/2 pushes, so we read them outside of the loop
+  do
+  {
+    pushes = ve->pushes;
+    snap.last = ve->last;
+    snap.nonzero = ve->nonzero;
+    snap.s0 = ve->s0;
+    snap.s1 = ve->s1;
+  } while(pushes != ve->pushes);
+
+  switch(ve->kind)
+  {
+    case VELEST_ADAPTIVE:
+    {
+      // grow the window until the encoder has moved enough
+      for(k = VELEST_ADAPTIVE_MIN_WINDOW_LOG2; k < ve->window_log2; k++)
+      {
+        int32_t space = ve->positions[snap.last] - ve->positions[(snap.last - (1u << k)) & VELEST_BUFFER_MASK];
+        if((space >= ve->mincounts) || (space <= -ve->mincounts))
+        {
+          break;
+        }
+      }
+      return VelEstMean(ve, &snap, k);
+    }
+
+    case VELEST_LSQ:
+    {
+      n = 1 << ve->window_log2;
+      if(n < 2)
+      {
+        return VelEstMean(ve, &snap, ve->window_log2);
+      }
+      num = (12 * snap.s1 - 6 * (n - 1) * snap.s0) * ve->scale;
+      n = n * (n * n - 1);
+      // round to the nearest
+      num += (num >= 0) ? (n / 2) : -(n / 2);
+      return (int32_t)(num / n);
+    }
+
+    case VELEST_MEAN:
+    default:
+    {
+      return VelEstMean(ve, &snap, ve->window_log2);
+    }
+  }
+}
+
+
+static int32_t VelEstMean(volatile tVelEst *ve, const tVelEstSnapshot *snap, unsigned int k)
+// mean of the last 2^k deltas, i.e. their running sum divided by their number
+{
+  int32_t space = ve->positions[snap->last] - ve->positions[(snap->last - (1u << k)) & VELEST_BUFFER_MASK];
+  int32_t cnt;
+
+  space *= ve->scale;
+
+  // the number of non zero deltas is kept only for the full window
+  if((0 != ve->skipzeros) && (k == ve->window_log2) && (snap->nonzero > 1))
+  {
+    cnt = snap->nonzero;
+    return (space >= 0) ? ((space + cnt / 2) / cnt) : -((-space + cnt / 2) / cnt);
+  }
+
+  return VelEstDivPow2(space, k);
+}
+
+
+static int32_t VelEstDivPow2(int32_t x, unsigned int k)
+// division by 2^k rounded to the nearest, symmetric around zero
+{
+  int32_t half = (k > 0) ? (1L << (k - 1)) : 0;
+
+  return (x >= 0) ? ((x + half) >> k) : -((-x + half) >> k);
+}
@@ -0,0 +1,83 @@
+//
+// O(1) velocity estimators working on a power-of-two ring buffer of positions.
+// The positions are pushed by the FOC loop and the velocity is read by the
+// velocity isr. This file is plain C without any dsPIC header, so that the
+// estimators can be built and compared also on a PC.
+//
+
+#ifndef __VELEST_H
+#define __VELEST_H
+
+#include <stdint.h>
+
+// Number of positions kept in the ring buffer. It must be a power of two,
+// and the window of the estimators can be at most half of it
+#ifndef VELEST_BUFFER_NUM
+#define VELEST_BUFFER_NUM 64
+#endif
+
+#define VELEST_BUFFER_MASK (VELEST_BUFFER_NUM - 1)
+
+#if (VELEST_BUFFER_NUM & VELEST_BUFFER_MASK) != 0
+#error VELEST_BUFFER_NUM must be a power of two
+#endif
+
+// Smallest window used by the adaptive estimator (log2)
+#define VELEST_ADAPTIVE_MIN_WINDOW_LOG2 1
+
+typedef enum 
+{
+  // mean of the position deltas over a fixed window. the running sum of the
+  // deltas and the number of non zero deltas are updated at each push
+  VELEST_MEAN = 0,
+  // mean of the position deltas over the shortest power-of-two window where
+  // the encoder moved at least mincounts. good for high and low speed
+  VELEST_ADAPTIVE = 1,
+  // least squares slope of the positions over a fixed window. the sums needed
+  // are updated at each push
+  VELEST_LSQ = 2
+} tVelEstKind;
+
+typedef struct 
+{
+  // settings
+  tVelEstKind kind;
+  // log2 of the number of samples of the window (for adaptive it is the max)
+  unsigned int window_log2;
+  // adaptive: movement in encoder counts which stops the window growing
+  int32_t mincounts;
+  // the velocity is given in encoder counts per scale samples
+  int16_t scale;
+  // when not zero, the mean divides by the number of non zero deltas instead
+  // of the window. it is needed by encoders which repeat the last sample
+  unsigned int skipzeros;
+
+  // ring buffer of the positions and index of the newest one
+  int32_t positions[VELEST_BUFFER_NUM];
+  unsigned int last;
+
+  // running sums for mean and lsq. the sum of the deltas is not needed as it
+  // is the difference between the newest and the oldest position of the window
+  unsigned int nonzero;
+  int64_t s0;
+  int64_t s1;
+
+  // incremented by each push, so that the reader detects a push which
+  // interrupted it
+  uint16_t pushes;
+} tVelEst;
+
+// initialize the estimator. all the buffer is filled with the given position
+// so that the velocity is zero until the motor moves.
+// window_log2 is limited to log2(VELEST_BUFFER_NUM/2)
+extern void VelEstInit(volatile tVelEst *ve, tVelEstKind kind, unsigned int window_log2, 
+                       int32_t mincounts, int16_t scale, unsigned int skipzeros, int32_t position);
+
+// add a new position. it is O(1) and it is meant to be called by the FOC loop
+extern void VelEstPush(volatile tVelEst *ve, int32_t position);
+
+// get the velocity in encoder counts per scale samples. it is O(1) for mean and
+// lsq and O(log2 window) for adaptive. it can be interrupted by VelEstPush()
+extern int32_t VelEstGet(volatile tVelEst *ve);
+
+#endif
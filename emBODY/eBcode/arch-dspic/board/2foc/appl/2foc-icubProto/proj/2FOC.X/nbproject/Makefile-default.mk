@@ -45,17 +45,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../../app/2FOC.c ../../app/ADC.c ../../app/as5045.c ../../app/Controller.c ../../app/DCLink.c ../../app/ecan.c ../../app/Encoder.c ../../app/Faults.c ../../app/HES.c ../../app/PWM.c ../../app/qep.c ../../app/System.c ../../app/tle5012.c ../../app/traps.c ../../app/velocity.c ../../app/CalcRef.s ../../app/clrkpark.s ../../app/I2T.s ../../app/InvPark.s ../../app/MeasCurr.s ../../app/pi.s ../../app/pid.s ../../app/pid2.s ../../app/SVGen.s ../../app/trig.s ../../app-added/can_icubProto.c ../../app-added/can_icubProto_parser.c ../../app-added/can_icubProto_trasmitter.c ../../../../../body/embenv/envshalib/eEbasicStorage.c
+SOURCEFILES_QUOTED_IF_SPACED=../../app/2FOC.c ../../app/ADC.c ../../app/as5045.c ../../app/Controller.c ../../app/DCLink.c ../../app/ecan.c ../../app/Encoder.c ../../app/Faults.c ../../app/HES.c ../../app/PWM.c ../../app/qep.c ../../app/System.c ../../app/tle5012.c ../../app/traps.c ../../app/velocity.c ../../app/velest.c ../../app/CalcRef.s ../../app/clrkpark.s ../../app/I2T.s ../../app/InvPark.s ../../app/MeasCurr.s ../../app/pi.s ../../app/pid.s ../../app/pid2.s ../../app/SVGen.s ../../app/trig.s ../../app-added/can_icubProto.c ../../app-added/can_icubProto_parser.c ../../app-added/can_icubProto_trasmitter.c ../../../../../body/embenv/envshalib/eEbasicStorage.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1445257345/2FOC.o ${OBJECTDIR}/_ext/1445257345/ADC.o ${OBJECTDIR}/_ext/1445257345/as5045.o ${OBJECTDIR}/_ext/1445257345/Controller.o ${OBJECTDIR}/_ext/1445257345/DCLink.o ${OBJECTDIR}/_ext/1445257345/ecan.o ${OBJECTDIR}/_ext/1445257345/Encoder.o ${OBJECTDIR}/_ext/1445257345/Faults.o ${OBJECTDIR}/_ext/1445257345/HES.o ${OBJECTDIR}/_ext/1445257345/PWM.o ${OBJECTDIR}/_ext/1445257345/qep.o ${OBJECTDIR}/_ext/1445257345/System.o ${OBJECTDIR}/_ext/1445257345/tle5012.o ${OBJECTDIR}/_ext/1445257345/traps.o ${OBJECTDIR}/_ext/1445257345/velocity.o ${OBJECTDIR}/_ext/1445257345/CalcRef.o ${OBJECTDIR}/_ext/1445257345/clrkpark.o ${OBJECTDIR}/_ext/1445257345/I2T.o ${OBJECTDIR}/_ext/1445257345/InvPark.o ${OBJECTDIR}/_ext/1445257345/MeasCurr.o ${OBJECTDIR}/_ext/1445257345/pi.o ${OBJECTDIR}/_ext/1445257345/pid.o ${OBJECTDIR}/_ext/1445257345/pid2.o ${OBJECTDIR}/_ext/1445257345/SVGen.o ${OBJECTDIR}/_ext/1445257345/trig.o ${OBJECTDIR}/_ext/1722765132/can_icubProto.o ${OBJECTDIR}/_ext/1722765132/can_icubProto_parser.o ${OBJECTDIR}/_ext/1722765132/can_icubProto_trasmitter.o ${OBJECTDIR}/_ext/1266031256/eEbasicStorage.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1445257345/2FOC.o.d ${OBJECTDIR}/_ext/1445257345/ADC.o.d ${OBJECTDIR}/_ext/1445257345/as5045.o.d ${OBJECTDIR}/_ext/1445257345/Controller.o.d ${OBJECTDIR}/_ext/1445257345/DCLink.o.d ${OBJECTDIR}/_ext/1445257345/ecan.o.d ${OBJECTDIR}/_ext/1445257345/Encoder.o.d ${OBJECTDIR}/_ext/1445257345/Faults.o.d ${OBJECTDIR}/_ext/1445257345/HES.o.d ${OBJECTDIR}/_ext/1445257345/PWM.o.d ${OBJECTDIR}/_ext/1445257345/qep.o.d ${OBJECTDIR}/_ext/1445257345/System.o.d ${OBJECTDIR}/_ext/1445257345/tle5012.o.d ${OBJECTDIR}/_ext/1445257345/traps.o.d ${OBJECTDIR}/_ext/1445257345/velocity.o.d ${OBJECTDIR}/_ext/1445257345/CalcRef.o.d ${OBJECTDIR}/_ext/1445257345/clrkpark.o.d ${OBJECTDIR}/_ext/1445257345/I2T.o.d ${OBJECTDIR}/_ext/1445257345/InvPark.o.d ${OBJECTDIR}/_ext/1445257345/MeasCurr.o.d ${OBJECTDIR}/_ext/1445257345/pi.o.d ${OBJECTDIR}/_ext/1445257345/pid.o.d ${OBJECTDIR}/_ext/1445257345/pid2.o.d ${OBJECTDIR}/_ext/1445257345/SVGen.o.d ${OBJECTDIR}/_ext/1445257345/trig.o.d ${OBJECTDIR}/_ext/1722765132/can_icubProto.o.d ${OBJECTDIR}/_ext/1722765132/can_icubProto_parser.o.d ${OBJECTDIR}/_ext/1722765132/can_icubProto_trasmitter.o.d ${OBJECTDIR}/_ext/1266031256/eEbasicStorage.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1445257345/2FOC.o ${OBJECTDIR}/_ext/1445257345/ADC.o ${OBJECTDIR}/_ext/1445257345/as5045.o ${OBJECTDIR}/_ext/1445257345/Controller.o ${OBJECTDIR}/_ext/1445257345/DCLink.o ${OBJECTDIR}/_ext/1445257345/ecan.o ${OBJECTDIR}/_ext/1445257345/Encoder.o ${OBJECTDIR}/_ext/1445257345/Faults.o ${OBJECTDIR}/_ext/1445257345/HES.o ${OBJECTDIR}/_ext/1445257345/PWM.o ${OBJECTDIR}/_ext/1445257345/qep.o ${OBJECTDIR}/_ext/1445257345/System.o ${OBJECTDIR}/_ext/1445257345/tle5012.o ${OBJECTDIR}/_ext/1445257345/traps.o ${OBJECTDIR}/_ext/1445257345/velocity.o ${OBJECTDIR}/_ext/1445257345/velest.o ${OBJECTDIR}/_ext/1445257345/CalcRef.o ${OBJECTDIR}/_ext/1445257345/clrkpark.o ${OBJECTDIR}/_ext/1445257345/I2T.o ${OBJECTDIR}/_ext/1445257345/InvPark.o ${OBJECTDIR}/_ext/1445257345/MeasCurr.o ${OBJECTDIR}/_ext/1445257345/pi.o ${OBJECTDIR}/_ext/1445257345/pid.o ${OBJECTDIR}/_ext/1445257345/pid2.o ${OBJECTDIR}/_ext/1445257345/SVGen.o ${OBJECTDIR}/_ext/1445257345/trig.o ${OBJECTDIR}/_ext/1722765132/can_icubProto.o ${OBJECTDIR}/_ext/1722765132/can_icubProto_parser.o ${OBJECTDIR}/_ext/1722765132/can_icubProto_trasmitter.o ${OBJECTDIR}/_ext/1266031256/eEbasicStorage.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1445257345/2FOC.o.d ${OBJECTDIR}/_ext/1445257345/ADC.o.d ${OBJECTDIR}/_ext/1445257345/as5045.o.d ${OBJECTDIR}/_ext/1445257345/Controller.o.d ${OBJECTDIR}/_ext/1445257345/DCLink.o.d ${OBJECTDIR}/_ext/1445257345/ecan.o.d ${OBJECTDIR}/_ext/1445257345/Encoder.o.d ${OBJECTDIR}/_ext/1445257345/Faults.o.d ${OBJECTDIR}/_ext/1445257345/HES.o.d ${OBJECTDIR}/_ext/1445257345/PWM.o.d ${OBJECTDIR}/_ext/1445257345/qep.o.d ${OBJECTDIR}/_ext/1445257345/System.o.d ${OBJECTDIR}/_ext/1445257345/tle5012.o.d ${OBJECTDIR}/_ext/1445257345/traps.o.d ${OBJECTDIR}/_ext/1445257345/velocity.o.d ${OBJECTDIR}/_ext/1445257345/velest.o.d ${OBJECTDIR}/_ext/1445257345/CalcRef.o.d ${OBJECTDIR}/_ext/1445257345/clrkpark.o.d ${OBJECTDIR}/_ext/1445257345/I2T.o.d ${OBJECTDIR}/_ext/1445257345/InvPark.o.d ${OBJECTDIR}/_ext/1445257345/MeasCurr.o.d ${OBJECTDIR}/_ext/1445257345/pi.o.d ${OBJECTDIR}/_ext/1445257345/pid.o.d ${OBJECTDIR}/_ext/1445257345/pid2.o.d ${OBJECTDIR}/_ext/1445257345/SVGen.o.d ${OBJECTDIR}/_ext/1445257345/trig.o.d ${OBJECTDIR}/_ext/1722765132/can_icubProto.o.d ${OBJECTDIR}/_ext/1722765132/can_icubProto_parser.o.d ${OBJECTDIR}/_ext/1722765132/can_icubProto_trasmitter.o.d ${OBJECTDIR}/_ext/1266031256/eEbasicStorage.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/1445257345/2FOC.o ${OBJECTDIR}/_ext/1445257345/ADC.o ${OBJECTDIR}/_ext/1445257345/as5045.o ${OBJECTDIR}/_ext/1445257345/Controller.o ${OBJECTDIR}/_ext/1445257345/DCLink.o ${OBJECTDIR}/_ext/1445257345/ecan.o ${OBJECTDIR}/_ext/1445257345/Encoder.o ${OBJECTDIR}/_ext/1445257345/Faults.o ${OBJECTDIR}/_ext/1445257345/HES.o ${OBJECTDIR}/_ext/1445257345/PWM.o ${OBJECTDIR}/_ext/1445257345/qep.o ${OBJECTDIR}/_ext/1445257345/System.o ${OBJECTDIR}/_ext/1445257345/tle5012.o ${OBJECTDIR}/_ext/1445257345/traps.o ${OBJECTDIR}/_ext/1445257345/velocity.o ${OBJECTDIR}/_ext/1445257345/CalcRef.o ${OBJECTDIR}/_ext/1445257345/clrkpark.o ${OBJECTDIR}/_ext/1445257345/I2T.o ${OBJECTDIR}/_ext/1445257345/InvPark.o ${OBJECTDIR}/_ext/1445257345/MeasCurr.o ${OBJECTDIR}/_ext/1445257345/pi.o ${OBJECTDIR}/_ext/1445257345/pid.o ${OBJECTDIR}/_ext/1445257345/pid2.o ${OBJECTDIR}/_ext/1445257345/SVGen.o ${OBJECTDIR}/_ext/1445257345/trig.o ${OBJECTDIR}/_ext/1722765132/can_icubProto.o ${OBJECTDIR}/_ext/1722765132/can_icubProto_parser.o ${OBJECTDIR}/_ext/1722765132/can_icubProto_trasmitter.o ${OBJECTDIR}/_ext/1266031256/eEbasicStorage.o
+OBJECTFILES=${OBJECTDIR}/_ext/1445257345/2FOC.o ${OBJECTDIR}/_ext/1445257345/ADC.o ${OBJECTDIR}/_ext/1445257345/as5045.o ${OBJECTDIR}/_ext/1445257345/Controller.o ${OBJECTDIR}/_ext/1445257345/DCLink.o ${OBJECTDIR}/_ext/1445257345/ecan.o ${OBJECTDIR}/_ext/1445257345/Encoder.o ${OBJECTDIR}/_ext/1445257345/Faults.o ${OBJECTDIR}/_ext/1445257345/HES.o ${OBJECTDIR}/_ext/1445257345/PWM.o ${OBJECTDIR}/_ext/1445257345/qep.o ${OBJECTDIR}/_ext/1445257345/System.o ${OBJECTDIR}/_ext/1445257345/tle5012.o ${OBJECTDIR}/_ext/1445257345/traps.o ${OBJECTDIR}/_ext/1445257345/velocity.o ${OBJECTDIR}/_ext/1445257345/velest.o ${OBJECTDIR}/_ext/1445257345/CalcRef.o ${OBJECTDIR}/_ext/1445257345/clrkpark.o ${OBJECTDIR}/_ext/1445257345/I2T.o ${OBJECTDIR}/_ext/1445257345/InvPark.o ${OBJECTDIR}/_ext/1445257345/MeasCurr.o ${OBJECTDIR}/_ext/1445257345/pi.o ${OBJECTDIR}/_ext/1445257345/pid.o ${OBJECTDIR}/_ext/1445257345/pid2.o ${OBJECTDIR}/_ext/1445257345/SVGen.o ${OBJECTDIR}/_ext/1445257345/trig.o ${OBJECTDIR}/_ext/1722765132/can_icubProto.o ${OBJECTDIR}/_ext/1722765132/can_icubProto_parser.o ${OBJECTDIR}/_ext/1722765132/can_icubProto_trasmitter.o ${OBJECTDIR}/_ext/1266031256/eEbasicStorage.o
 
 # Source Files
-SOURCEFILES=../../app/2FOC.c ../../app/ADC.c ../../app/as5045.c ../../app/Controller.c ../../app/DCLink.c ../../app/ecan.c ../../app/Encoder.c ../../app/Faults.c ../../app/HES.c ../../app/PWM.c ../../app/qep.c ../../app/System.c ../../app/tle5012.c ../../app/traps.c ../../app/velocity.c ../../app/CalcRef.s ../../app/clrkpark.s ../../app/I2T.s ../../app/InvPark.s ../../app/MeasCurr.s ../../app/pi.s ../../app/pid.s ../../app/pid2.s ../../app/SVGen.s ../../app/trig.s ../../app-added/can_icubProto.c ../../app-added/can_icubProto_parser.c ../../app-added/can_icubProto_trasmitter.c ../../../../../body/embenv/envshalib/eEbasicStorage.c
+SOURCEFILES=../../app/2FOC.c ../../app/ADC.c ../../app/as5045.c ../../app/Controller.c ../../app/DCLink.c ../../app/ecan.c ../../app/Encoder.c ../../app/Faults.c ../../app/HES.c ../../app/PWM.c ../../app/qep.c ../../app/System.c ../../app/tle5012.c ../../app/traps.c ../../app/velocity.c ../../app/velest.c ../../app/CalcRef.s ../../app/clrkpark.s ../../app/I2T.s ../../app/InvPark.s ../../app/MeasCurr.s ../../app/pi.s ../../app/pid.s ../../app/pid2.s ../../app/SVGen.s ../../app/trig.s ../../app-added/can_icubProto.c ../../app-added/can_icubProto_parser.c ../../app-added/can_icubProto_trasmitter.c ../../../../../body/embenv/envshalib/eEbasicStorage.c
 
 
 CFLAGS=
@@ -184,6 +184,13 @@ ${OBJECTDIR}/_ext/1445257345/velocity.o: ../../app/velocity.c  nbproject/Makefil
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../app/velocity.c  -o ${OBJECTDIR}/_ext/1445257345/velocity.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1445257345/velocity.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-data -O3 -I"../../app" -I"../../app-added" -I"../../envcom" -I"../../../../../body/embenv/envcom" -I"../../../../../body/embenv/envshalib" -I".." -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1445257345/velocity.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1445257345/velest.o: ../../app/velest.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1445257345 
+	@${RM} ${OBJECTDIR}/_ext/1445257345/velest.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1445257345/velest.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../app/velest.c  -o ${OBJECTDIR}/_ext/1445257345/velest.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1445257345/velest.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -omf=elf -mlarge-data -O3 -I"../../app" -I"../../app-added" -I"../../envcom" -I"../../../../../body/embenv/envcom" -I"../../../../../body/embenv/envshalib" -I".." -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1445257345/velest.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/1722765132/can_icubProto.o: ../../app-added/can_icubProto.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/_ext/1722765132 
 	@${RM} ${OBJECTDIR}/_ext/1722765132/can_icubProto.o.d 
@@ -318,6 +325,13 @@ ${OBJECTDIR}/_ext/1445257345/velocity.o: ../../app/velocity.c  nbproject/Makefil
 	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../app/velocity.c  -o ${OBJECTDIR}/_ext/1445257345/velocity.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1445257345/velocity.o.d"      -g -omf=elf -mlarge-data -O3 -I"../../app" -I"../../app-added" -I"../../envcom" -I"../../../../../body/embenv/envcom" -I"../../../../../body/embenv/envshalib" -I".." -msmart-io=1 -Wall -msfr-warn=off
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1445257345/velocity.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1445257345/velest.o: ../../app/velest.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} ${OBJECTDIR}/_ext/1445257345 
+	@${RM} ${OBJECTDIR}/_ext/1445257345/velest.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1445257345/velest.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  ../../app/velest.c  -o ${OBJECTDIR}/_ext/1445257345/velest.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/_ext/1445257345/velest.o.d"      -g -omf=elf -mlarge-data -O3 -I"../../app" -I"../../app-added" -I"../../envcom" -I"../../../../../body/embenv/envcom" -I"../../../../../body/embenv/envshalib" -I".." -msmart-io=1 -Wall -msfr-warn=off
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1445257345/velest.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/1722765132/can_icubProto.o: ../../app-added/can_icubProto.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} ${OBJECTDIR}/_ext/1722765132 
 	@${RM} ${OBJECTDIR}/_ext/1722765132/can_icubProto.o.d 
@@ -124,6 +124,27 @@ typedef struct              // size is 124+1+3 = 128 bytes
     uint8_t                         filler03[3];
 } eOmn_ropsigcfg_command_t;         EO_VERIFYsizeof(eOmn_ropsigcfg_command_t, 128);
 
+
+/** @typedef    typedef struct eOmn_comm_rxstatistics_t;
+    @brief      contains the statistics of reception of the ropframes which the board receives from the remote host. 
+                it has the same layout of the eo_receiver_statistics_t used by the EOreceiver, which keeps it updated.
+                lossbursts[] is the histogram of the ropframes lost in a single gap, with bins 1, 2, 3-4, 5-8, 9-16,
+                17-32, 33-64, 65+. jitter and jittermax are expressed in microseconds.
+ **/
+typedef struct              // size is 7*4+2*2+8*4 = 64 bytes
+{
+    uint32_t                        received;
+    uint32_t                        lost;
+    uint32_t                        duplicated;
+    uint32_t                        outoforder;
+    uint32_t                        invalid;
+    uint32_t                        jitter;
+    uint32_t                        jittermax;
+    uint16_t                        longestburst;
+    uint16_t                        resyncs;
+    uint32_t                        lossbursts[8];
+} eOmn_comm_rxstatistics_t;         EO_VERIFYsizeof(eOmn_comm_rxstatistics_t, 64);
+
 /** @typedef    typedef enum eOmn_appl_runMode_t;
     @brief      contains ems application's run mode.
                 Currently runMode is not set to ems by pc104, but application itself understands its runmode
@@ -75,6 +75,9 @@
 
 
 EO_VERIFYproposition(xxx, commNVindex__ropsigcfgcommand                   == EOK_cfg_nvsEP_mn_comm_con_nvindex__ropsigcfgcommand);
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+EO_VERIFYproposition(xxx, commNVindex__rxstatistics                       == EOK_cfg_nvsEP_mn_comm_con_nvindex__rxstatistics);
+#endif
 
 EO_VERIFYproposition(xxx, commNVindex_TOTALnumber                         == EOK_cfg_nvsEP_mn_comm_con_NUMofVARS);
 
@@ -146,6 +149,17 @@ __weak extern void eo_cfg_nvsEP_mn_comm_hid_INIT__ropsigcfgcommand(uint16_t n, c
 }
 #endif
 
+#if !defined(OVERRIDE_eo_cfg_nvsEP_mn_comm_hid_INIT__rxstatistics)
+__weak extern void eo_cfg_nvsEP_mn_comm_hid_INIT__rxstatistics(uint16_t n, const EOnv* nv)
+{   // n is always 0
+    eObool_t theOwnershipIsLocal = (NULL == nv->rem) ? eobool_true : eobool_false;
+    eOnvEP_t ep = nv->ep;
+    
+    theOwnershipIsLocal = theOwnershipIsLocal;
+    ep = ep;
+}
+#endif
+
 // updt:    n is not used
 
 
@@ -160,6 +174,17 @@ __weak extern void eo_cfg_nvsEP_mn_comm_hid_UPDT__ropsigcfgcommand(uint16_t n, c
 }
 #endif
 
+#if !defined(OVERRIDE_eo_cfg_nvsEP_mn_comm_hid_UPDT__rxstatistics)
+__weak extern void eo_cfg_nvsEP_mn_comm_hid_UPDT__rxstatistics(uint16_t n, const EOnv* nv, const eOabstime_t time, const uint32_t sign)
+{   // n is always 0
+    eObool_t theOwnershipIsLocal = (NULL == nv->rem) ? eobool_true : eobool_false;
+    eOnvEP_t ep = nv->ep;
+    
+    theOwnershipIsLocal = theOwnershipIsLocal;
+    ep = ep;
+}
+#endif
+
 
 // - appl
 
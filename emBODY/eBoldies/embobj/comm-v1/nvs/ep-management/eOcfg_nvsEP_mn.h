@@ -49,7 +49,11 @@ extern "C" {
  
 
 // - public #define  --------------------------------------------------------------------------------------------------
-// empty-section
+
+// the nv rxstatistics grows the mn comm endpoint from 128 to 192 bytes and adds a nv to it. board and host must agree
+// on the layout of the endpoint, thus the nv is there only if both are built with EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS
+// defined. without it the endpoint is the same as before and the boards keep talking to the hosts which are not rebuilt.
+//#define EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS
 
 
 
@@ -82,9 +86,17 @@ enum { mnCommNumberMAX = 1};
 typedef enum
 {
     commNVindex__ropsigcfgcommand                         =  0
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+    ,
+    commNVindex__rxstatistics                             =  1
+#endif
 } eOcfg_nvsEP_mn_commNVindex_t;
 
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+enum { commNVindex_TOTALnumber = 2};
+#else
 enum { commNVindex_TOTALnumber = 1};
+#endif
 
 
 
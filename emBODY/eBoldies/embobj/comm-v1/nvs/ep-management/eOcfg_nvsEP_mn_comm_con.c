@@ -99,6 +99,10 @@ const eo_cfg_nvsEP_mn_comm_t eo_cfg_nvsEP_mn_comm_default =
         EO_INIT(.cmmnd)                 ropsigcfg_cmd_none,
         EO_INIT(.filler03)              {0xf1, 0xf2, 0xf3}
     }
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+    ,
+    EO_INIT(.rxstatistics)              {0}
+#endif
 }; 
 
   
@@ -121,10 +125,28 @@ EOnv_con_t eo_cfg_nvsEP_mn_comm__ropsigcfgcommand =
 #define OFFSETafter__ropsigcfgcommand              (OFFSETof__ropsigcfgcommand + CAPACITY__ropsigcfgcommand)
 
 
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+#define OFFSETof__rxstatistics                     (OFFSETafter__ropsigcfgcommand) 
+#define CAPACITY__rxstatistics                     sizeof(eOmn_comm_rxstatistics_t)
+EOnv_con_t eo_cfg_nvsEP_mn_comm__rxstatistics =
+{   // pos =  01
+    EO_INIT(.id)        EOK_cfg_nvsEP_mn_comm_NVID__rxstatistics,
+    EO_INIT(.capacity)  CAPACITY__rxstatistics,
+    EO_INIT(.resetval)  (const void*)&eo_cfg_nvsEP_mn_comm_default.rxstatistics,
+    EO_INIT(.offset)    OFFSETof__rxstatistics,
+    EO_INIT(.typ)       EO_nv_TYP(EOK_cfg_nvsEP_mn_comm_NVFUNTYP__rxstatistics),
+    EO_INIT(.fun)       EO_nv_FUN(EOK_cfg_nvsEP_mn_comm_NVFUNTYP__rxstatistics)
+};
+#define OFFSETafter__rxstatistics                  (OFFSETof__rxstatistics + CAPACITY__rxstatistics)
+#else
+#define OFFSETafter__rxstatistics                  (OFFSETafter__ropsigcfgcommand)
+#endif
+
+
 
 // guard on alignment of variables. if it doesnt compile then ... the compiler has surely inserted some holes
 
-EO_VERIFYproposition(eocfg_nvsep_mn_comm, ( (OFFSETafter__ropsigcfgcommand) == sizeof(eo_cfg_nvsEP_mn_comm_t) ) );
+EO_VERIFYproposition(eocfg_nvsep_mn_comm, ( (OFFSETafter__rxstatistics) == sizeof(eo_cfg_nvsEP_mn_comm_t) ) );
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -143,6 +165,15 @@ EOtreenode eo_cfg_nvsEP_mn_comm_tree_con[] =
         EO_INIT(.nchildren) 0,
         EO_INIT(.dchildren) NULL
     }
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+    ,
+    {   // 01
+        EO_INIT(.data)      (void*)&eo_cfg_nvsEP_mn_comm__rxstatistics,
+        EO_INIT(.index)     1,
+        EO_INIT(.nchildren) 0,
+        EO_INIT(.dchildren) NULL
+    }
+#endif
 };  EO_VERIFYsizeof(eo_cfg_nvsEP_mn_comm_tree_con, sizeof(EOtreenode)*(EOK_cfg_nvsEP_mn_comm_con_NUMofVARS));
 
 
@@ -170,6 +201,9 @@ extern eOnvID_t eo_cfg_nvsEP_mn_comm_comm_NVID_Get(eOcfg_nvsEP_mn_commNVindex_t
     static const uint8_t s_eo_cfg_nvsEP_mn_comm_con_nvs_funtyp[] =
     {
         EOK_cfg_nvsEP_mn_comm_NVFUNTYP__ropsigcfgcommand
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+        ,  EOK_cfg_nvsEP_mn_comm_NVFUNTYP__rxstatistics
+#endif
         
     };  EO_VERIFYsizeof(s_eo_cfg_nvsEP_mn_comm_con_nvs_funtyp, EOK_cfg_nvsEP_mn_comm_con_NUMofVARS);
 
@@ -183,7 +217,7 @@ extern eOnvID_t eo_cfg_nvsEP_mn_comm_comm_NVID_Get(eOcfg_nvsEP_mn_commNVindex_t
 
 extern uint16_t eo_cfg_nvsEP_mn_comm_hashfunction_id2index(uint16_t id)
 {
-    #define IDTABLESIZE     1
+    #define IDTABLESIZE     EOK_cfg_nvsEP_mn_comm_con_NUMofVARS
 
     // in order to always have a hit the table s_idtable[] it must be of size equal to max{ s_hash(id) }, thus if we
     // use an id of value 16 and s_hash() just keeps the lsb, then the size must be 17 
@@ -196,6 +230,9 @@ extern uint16_t eo_cfg_nvsEP_mn_comm_hashfunction_id2index(uint16_t id)
     static const uint16_t s_idtable[] = 
     { 
         EOK_cfg_nvsEP_mn_comm_NVID__ropsigcfgcommand
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+        ,  EOK_cfg_nvsEP_mn_comm_NVID__rxstatistics
+#endif
         
     };  EO_VERIFYsizeof(s_idtable, sizeof(uint16_t)*(IDTABLESIZE));
 
@@ -76,10 +76,18 @@ enum { mngmntNVindex_TOTALnumber = 2};
 /** @typedef    typedef struct eo_cfg_nvsEP_mn_comm_t;
     @brief      contains all the variables in the mn comm endpoint which is used to configure communication 
  **/
-typedef struct                  // size is 1128+0 = 128 bytes
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+typedef struct                  // size is 128+64 = 192 bytes
+{
+    eOmn_ropsigcfg_command_t    ropsigcfgcommand;        
+    eOmn_comm_rxstatistics_t    rxstatistics;
+} eo_cfg_nvsEP_mn_comm_t;       EO_VERIFYsizeof(eo_cfg_nvsEP_mn_comm_t, 192)
+#else
+typedef struct                  // size is 128+0 = 128 bytes
 {
     eOmn_ropsigcfg_command_t    ropsigcfgcommand;        
 } eo_cfg_nvsEP_mn_comm_t;       EO_VERIFYsizeof(eo_cfg_nvsEP_mn_comm_t, 128)
+#endif
 
     
 // - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
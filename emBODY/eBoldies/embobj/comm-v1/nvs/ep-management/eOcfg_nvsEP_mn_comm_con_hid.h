@@ -41,10 +41,15 @@
 
 // - the indices of the nv in the endpoint
 #define EOK_cfg_nvsEP_mn_comm_con_nvindex__ropsigcfgcommand                      (0)
+#define EOK_cfg_nvsEP_mn_comm_con_nvindex__rxstatistics                          (1)
 
 
 // - the total number of nvs
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+#define EOK_cfg_nvsEP_mn_comm_con_NUMofVARS                                      2
+#else
 #define EOK_cfg_nvsEP_mn_comm_con_NUMofVARS                                      1
+#endif
 
 // -  macros whcih transforms the index in nvid-offset and the nvid-offset in index
 #define EOK_cfg_nvsEP_mn_comm_con_NVIDoff(nvindex)                               (nvindex)
@@ -52,10 +57,12 @@
 
 // -- the fun and typ of all the nv in the endpoint
 #define EOK_cfg_nvsEP_mn_comm_NVFUNTYP__ropsigcfgcommand                         EO_nv_FUNTYP(eo_nv_FUN_beh, eo_nv_TYP_pkd)
+#define EOK_cfg_nvsEP_mn_comm_NVFUNTYP__rxstatistics                             EO_nv_FUNTYP(eo_nv_FUN_inp, eo_nv_TYP_pkd)
 
 
 // -- the nvid of all the nv in the endpoint
 #define EOK_cfg_nvsEP_mn_comm_NVID__ropsigcfgcommand                             EO_nv_ID(EOK_cfg_nvsEP_mn_comm_NVFUNTYP__ropsigcfgcommand, EOK_cfg_nvsEP_mn_comm_con_NVIDoff(EOK_cfg_nvsEP_mn_comm_con_nvindex__ropsigcfgcommand))
+#define EOK_cfg_nvsEP_mn_comm_NVID__rxstatistics                                 EO_nv_ID(EOK_cfg_nvsEP_mn_comm_NVFUNTYP__rxstatistics, EOK_cfg_nvsEP_mn_comm_con_NVIDoff(EOK_cfg_nvsEP_mn_comm_con_nvindex__rxstatistics))
 
 
    
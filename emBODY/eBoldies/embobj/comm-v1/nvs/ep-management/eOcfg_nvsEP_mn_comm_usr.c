@@ -76,6 +76,11 @@ static void s_eo_cfg_nvsEP_mn_comm_INIT__ropsigcfgcommand(const EOnv* nv);
 
 static void s_eo_cfg_nvsEP_mn_comm_UPDT__ropsigcfgcommand(const EOnv* nv, const eOabstime_t time, const uint32_t sign);
 
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+static void s_eo_cfg_nvsEP_mn_comm_INIT__rxstatistics(const EOnv* nv);
+static void s_eo_cfg_nvsEP_mn_comm_UPDT__rxstatistics(const EOnv* nv, const eOabstime_t time, const uint32_t sign);
+#endif
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of static variables
@@ -88,6 +93,14 @@ static const eOnv_fn_peripheral_t s_eo_cfg_nvsEP_mn_comm_ebx__ropsigcfgcommand =
     EO_INIT(.update)    s_eo_cfg_nvsEP_mn_comm_UPDT__ropsigcfgcommand
 };
 
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+static const eOnv_fn_peripheral_t s_eo_cfg_nvsEP_mn_comm_ebx__rxstatistics =
+{
+    EO_INIT(.init)      s_eo_cfg_nvsEP_mn_comm_INIT__rxstatistics,
+    EO_INIT(.update)    s_eo_cfg_nvsEP_mn_comm_UPDT__rxstatistics
+};
+#endif
+
 
 static EOnv_usr_t s_eo_cfg_nvsEP_mn_comm_array_of_EOnv_usr[] =
 {
@@ -95,7 +108,15 @@ static EOnv_usr_t s_eo_cfg_nvsEP_mn_comm_array_of_EOnv_usr[] =
         EO_INIT(.peripheralinterface)   &s_eo_cfg_nvsEP_mn_comm_ebx__ropsigcfgcommand,    
         EONV_ONROPRECEPTION_IS_NULL   
         EO_INIT(.stg_address)           EOK_uint32dummy       
-    }   
+    }
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+    ,
+    {   // 01 
+        EO_INIT(.peripheralinterface)   &s_eo_cfg_nvsEP_mn_comm_ebx__rxstatistics,    
+        EONV_ONROPRECEPTION_IS_NULL   
+        EO_INIT(.stg_address)           EOK_uint32dummy       
+    }
+#endif
 };  EO_VERIFYsizeof(s_eo_cfg_nvsEP_mn_comm_array_of_EOnv_usr, sizeof(EOnv_usr_t)*(EOK_cfg_nvsEP_mn_comm_con_NUMofVARS)); 
 
 
@@ -166,6 +187,13 @@ __weak extern void eo_cfg_nvsEP_mn_comm_usr_hid_INIT__ropsigcfgcommand(uint16_t
     eo_cfg_nvsEP_mn_comm_hid_INIT__ropsigcfgcommand(n, nv);
 }
 
+__weak extern void eo_cfg_nvsEP_mn_comm_usr_hid_INIT__rxstatistics(uint16_t n, const EOnv* nv)
+{   // n is always 0
+    eObool_t theOwnershipIsLocal = (NULL == nv->rem) ? eobool_true : eobool_false;
+    theOwnershipIsLocal = theOwnershipIsLocal;
+    eo_cfg_nvsEP_mn_comm_hid_INIT__rxstatistics(n, nv);
+}
+
 
 // updt:
 __weak extern void eo_cfg_nvsEP_mn_comm_usr_hid_UPDT__ropsigcfgcommand(uint16_t n, const EOnv* nv, const eOabstime_t time, const uint32_t sign)
@@ -175,6 +203,13 @@ __weak extern void eo_cfg_nvsEP_mn_comm_usr_hid_UPDT__ropsigcfgcommand(uint16_t
     eo_cfg_nvsEP_mn_comm_hid_UPDT__ropsigcfgcommand(n, nv, time, sign);    
 }
 
+__weak extern void eo_cfg_nvsEP_mn_comm_usr_hid_UPDT__rxstatistics(uint16_t n, const EOnv* nv, const eOabstime_t time, const uint32_t sign)
+{   // n is always 0
+    eObool_t theOwnershipIsLocal = (NULL == nv->rem) ? eobool_true : eobool_false;
+    theOwnershipIsLocal = theOwnershipIsLocal;
+    eo_cfg_nvsEP_mn_comm_hid_UPDT__rxstatistics(n, nv, time, sign);    
+}
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of static functions 
@@ -194,6 +229,20 @@ static void s_eo_cfg_nvsEP_mn_comm_UPDT__ropsigcfgcommand(const EOnv* nv, const
 }
 
 
+#if defined(EO_CFG_NVSEP_MN_COMM_USE_RXSTATISTICS)
+static void s_eo_cfg_nvsEP_mn_comm_INIT__rxstatistics(const EOnv* nv)
+{   
+    eo_cfg_nvsEP_mn_comm_usr_hid_INIT__rxstatistics(0, nv);
+}
+
+
+static void s_eo_cfg_nvsEP_mn_comm_UPDT__rxstatistics(const EOnv* nv, const eOabstime_t time, const uint32_t sign)
+{   
+    eo_cfg_nvsEP_mn_comm_usr_hid_UPDT__rxstatistics(0, nv, time, sign);
+}
+#endif
+
+
 
 
 
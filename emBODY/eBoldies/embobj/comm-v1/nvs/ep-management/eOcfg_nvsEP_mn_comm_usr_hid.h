@@ -52,10 +52,12 @@ extern void eo_cfg_nvsEP_mn_comm_usr_hid_INITIALISE(eOnvEP_t ep, void *loc, void
 
 // init:    n is not used
 extern void eo_cfg_nvsEP_mn_comm_usr_hid_INIT__ropsigcfgcommand(uint16_t n, const EOnv* nv);
+extern void eo_cfg_nvsEP_mn_comm_usr_hid_INIT__rxstatistics(uint16_t n, const EOnv* nv);
 
 
 // updt:    n is not used
 extern void eo_cfg_nvsEP_mn_comm_usr_hid_UPDT__ropsigcfgcommand(uint16_t n, const EOnv* nv, const eOabstime_t time, const uint32_t sign);
+extern void eo_cfg_nvsEP_mn_comm_usr_hid_UPDT__rxstatistics(uint16_t n, const EOnv* nv, const eOabstime_t time, const uint32_t sign);
 
 
 
@@ -59,11 +59,13 @@
 // init:   
 #define OVERRIDE_eo_cfg_nvsEP_mn_hid_INIT__ropsigcfgassign
 //#define OVERRIDE_eo_cfg_nvsEP_mn_comm_hid_INIT__ropsigcfgcommand
+//#define OVERRIDE_eo_cfg_nvsEP_mn_comm_hid_INIT__rxstatistics
 
 
 // updt:    
 #define OVERRIDE_eo_cfg_nvsEP_mn_hid_UPDT__ropsigcfgassign
 //#define OVERRIDE_eo_cfg_nvsEP_mn_comm_hid_UPDT__ropsigcfgcommand
+//#define OVERRIDE_eo_cfg_nvsEP_mn_comm_hid_UPDT__rxstatistics
 
 
 
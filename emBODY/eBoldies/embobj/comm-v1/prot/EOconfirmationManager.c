@@ -54,6 +54,10 @@
 // - #define with internal scope
 // --------------------------------------------------------------------------------------------------------------------
 
+// the shift of the gains of the estimator of RFC 6298: alpha = 1/8, beta = 1/4
+#define EOCONFMAN_SRTT_SHIFT        3
+#define EOCONFMAN_RTTVAR_SHIFT      2
+
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -76,6 +80,13 @@
 static void s_eo_confman_default_rop_conf_requested(EOrop *rop, eOipv4addr_t toipaddr);
 static void s_eo_confman_default_rop_conf_received(EOrop *rop, eOipv4addr_t fromipaddr);
 
+static eOabstime_t s_eo_confman_now(EOconfirmationManager *p);
+static eOconfman_entry_t * s_eo_confman_find(EOconfirmationManager *p, eOipv4addr_t ipaddr, eOropcode_t ropc, eOnvEP_t ep, eOnvID_t id, uint32_t sign);
+static uint32_t s_eo_confman_timeout(EOconfirmationManager *p, uint8_t retransmissions);
+static void s_eo_confman_rtt_update(EOconfirmationManager *p, uint32_t rtt);
+static void s_eo_confman_confirmed(EOconfirmationManager *p, eOconfman_entry_t *entry, eOropconfinfo_t confinfo, eOabstime_t now);
+static eOresult_t s_eo_confman_request(EOconfirmationManager *p, const eOropdescriptor_t *ropdes, eOipv4addr_t toipaddr);
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of static variables
@@ -86,7 +97,17 @@ static void s_eo_confman_default_rop_conf_received(EOrop *rop, eOipv4addr_t from
 const eOconfman_cfg_t eOconfman_cfg_default = 
 {
     EO_INIT(.on_rop_conf_requested)         s_eo_confman_default_rop_conf_requested, 
-    EO_INIT(.on_rop_conf_received)          s_eo_confman_default_rop_conf_received
+    EO_INIT(.on_rop_conf_received)          s_eo_confman_default_rop_conf_received,
+    EO_INIT(.capacity)                      16,
+    EO_INIT(.maxretransmissions)            3,
+    EO_INIT(.filler)                        0,
+    EO_INIT(.rtoinitial)                    50000,
+    EO_INIT(.rtomin)                        5000,
+    EO_INIT(.rtomax)                        1000000,
+    EO_INIT(.time_get)                      NULL,
+    EO_INIT(.on_rop_retransmit)             NULL,
+    EO_INIT(.on_rop_lost)                   NULL,
+    EO_INIT(.arg)                           NULL
 };
 
 
@@ -109,6 +130,20 @@ extern EOconfirmationManager* eo_confman_New(const eOconfman_cfg_t *cfg)
     retptr = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(EOconfirmationManager), 1);
     
     memcpy(&retptr->config, cfg, sizeof(eOconfman_cfg_t));
+    
+    retptr->table = NULL;
+    if(0 != cfg->capacity)
+    {
+        retptr->table = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_auto, sizeof(eOconfman_entry_t), cfg->capacity);
+        memset(retptr->table, 0, cfg->capacity*sizeof(eOconfman_entry_t));
+    }
+    
+    retptr->srtt        = 0;
+    retptr->rttvar      = 0;
+    retptr->rto         = cfg->rtoinitial;
+    retptr->latencysum  = 0;
+    memset(&retptr->stats, 0, sizeof(eOconfman_statistics_t));
+    retptr->stats.rto   = retptr->rto;
 
     
     return(retptr);
@@ -117,6 +152,8 @@ extern EOconfirmationManager* eo_confman_New(const eOconfman_cfg_t *cfg)
 
 extern eOresult_t eo_confman_Confirmation_Requested(EOconfirmationManager *p, EOrop *rop, eOipv4addr_t toipaddr)
 {
+    eOropdescriptor_t ropdes;
+    
     if((NULL == p) || (NULL == rop))
     {
         return(eores_NOK_generic);  
@@ -128,7 +165,22 @@ extern eOresult_t eo_confman_Confirmation_Requested(EOconfirmationManager *p, EO
         {
             p->config.on_rop_conf_requested(rop, toipaddr);
         }
-        return(eores_OK);
+        
+        if(NULL == p->table)
+        {
+            return(eores_OK);
+        }
+        
+        ropdes.configuration.confrqst   = rop->stream.head.ctrl.rqstconf;
+        ropdes.configuration.timerqst   = rop->stream.head.ctrl.rqsttime;
+        ropdes.configuration.plussign   = rop->stream.head.ctrl.plussign;
+        ropdes.configuration.plustime   = rop->stream.head.ctrl.plustime;
+        ropdes.ropcode                  = (eOropcode_t)rop->stream.head.ropc;
+        ropdes.ep                       = rop->stream.head.endp;
+        ropdes.id                       = rop->stream.head.nvid;
+        ropdes.signature                = rop->stream.sign;
+        
+        return(s_eo_confman_request(p, &ropdes, toipaddr));
     }
 
     return(eores_NOK_generic);   
@@ -136,6 +188,27 @@ extern eOresult_t eo_confman_Confirmation_Requested(EOconfirmationManager *p, EO
 }
 
 
+extern eOresult_t eo_confman_Confirmation_Requested_with_ropdes(EOconfirmationManager *p, const eOropdescriptor_t *ropdes, eOipv4addr_t toipaddr)
+{
+    if((NULL == p) || (NULL == ropdes))
+    {
+        return(eores_NOK_generic);  
+    }
+    
+    if(1 != ropdes->configuration.confrqst)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    if(NULL == p->table)
+    {
+        return(eores_OK);
+    }
+    
+    return(s_eo_confman_request(p, ropdes, toipaddr));
+}
+
+
 
 extern eOresult_t eo_confman_Confirmation_Received(EOconfirmationManager *p, EOrop *rop, eOipv4addr_t fromipaddr)
 {
@@ -145,6 +218,9 @@ extern eOresult_t eo_confman_Confirmation_Received(EOconfirmationManager *p, EOr
     }
     
     eOropconfinfo_t confinfo = (eOropconfinfo_t)rop->stream.head.ctrl.confinfo;
+    eOropcode_t ropc = (eOropcode_t)rop->stream.head.ropc;
+    uint32_t sign = (1 == rop->stream.head.ctrl.plussign) ? (rop->stream.sign) : (EOK_uint32dummy);
+    eOconfman_entry_t *entry = NULL;
 
     if(eo_ropconf_none != confinfo)
     {
@@ -153,15 +229,132 @@ extern eOresult_t eo_confman_Confirmation_Received(EOconfirmationManager *p, EOr
         {
             p->config.on_rop_conf_received(rop, fromipaddr);
         }
+        
+        if(NULL != p->table)
+        {   // an ask<> is confirmed by a say<>. the nak of an ask<> keeps the ropcode of the say<>.
+            entry = s_eo_confman_find(p, fromipaddr, (eo_ropcode_say == ropc) ? (eo_ropcode_ask) : (ropc), rop->stream.head.endp, rop->stream.head.nvid, sign);
+            if(NULL != entry)
+            {
+                s_eo_confman_confirmed(p, entry, confinfo, s_eo_confman_now(p));
+            }
+            else
+            {
+                p->stats.unexpected++;
+            }
+        }
 
         return(eores_OK); 
     } 
+    
+    if((NULL != p->table) && (0 != p->stats.outstanding) && (eo_ropcode_say == ropc))
+    {   // a successful ask<> with confirmation request is replied by a say<> without confinfo: it is an ack 
+        entry = s_eo_confman_find(p, fromipaddr, eo_ropcode_ask, rop->stream.head.endp, rop->stream.head.nvid, sign);
+        if(NULL != entry)
+        {
+            s_eo_confman_confirmed(p, entry, eo_ropconf_ack, s_eo_confman_now(p));
+            return(eores_OK);
+        }
+    }
 
     return(eores_NOK_generic);      
 
 }
 
 
+extern eOresult_t eo_confman_Tick(EOconfirmationManager *p)
+{
+    eOconfman_entry_t *entry = NULL;
+    eOabstime_t now = 0;
+    uint16_t i = 0;
+    
+    if(NULL == p)
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(NULL == p->table)
+    {
+        return(eores_OK);
+    }
+    
+    now = s_eo_confman_now(p);
+    
+    for(i=0; i<p->config.capacity; i++)
+    {
+        entry = &p->table[i];
+        
+        if((eobool_false == entry->used) || (now < entry->deadline))
+        {
+            continue;
+        }
+        
+        if((NULL != p->config.on_rop_retransmit) && (entry->request.retransmissions < p->config.maxretransmissions))
+        {   // the retransmission is counted here. if the callback passes the rop to eo_confman_Confirmation_Requested()
+            // again, the flag tells it not to count it twice
+            entry->request.retransmissions++;
+            entry->sentat   = now;
+            entry->deadline = now + s_eo_confman_timeout(p, entry->request.retransmissions);
+            p->stats.retransmitted++;
+            entry->retransmitting = eobool_true;
+            p->config.on_rop_retransmit(p->config.arg, &entry->request);
+            entry->retransmitting = eobool_false;
+        }
+        else
+        {
+            entry->used = eobool_false;
+            p->stats.outstanding--;
+            p->stats.lost++;
+            if(NULL != p->config.on_rop_lost)
+            {
+                p->config.on_rop_lost(p->config.arg, &entry->request);
+            }
+        }
+    }
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_confman_Statistics_Get(EOconfirmationManager *p, eOconfman_statistics_t *stats)
+{
+    uint32_t confirmed = 0;
+    
+    if((NULL == p) || (NULL == stats)) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    // the mean is computed only here, so that the reception of a confirmation does not pay a division
+    confirmed = p->stats.acked + p->stats.nakked;
+    p->stats.latencymean = (0 == confirmed) ? (0) : ((uint32_t)(p->latencysum / confirmed));
+    
+    memcpy(stats, &p->stats, sizeof(eOconfman_statistics_t));
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_confman_Statistics_Reset(EOconfirmationManager *p)
+{
+    uint32_t outstanding = 0;
+    
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    outstanding = p->stats.outstanding;
+    memset(&p->stats, 0, sizeof(eOconfman_statistics_t));
+    p->latencysum           = 0;
+    p->stats.outstanding    = outstanding;
+    p->stats.srtt           = p->srtt;
+    p->stats.rttvar         = p->rttvar;
+    p->stats.rto            = p->rto;
+    
+    return(eores_OK);
+}
+
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern hidden functions 
@@ -207,6 +400,191 @@ static void s_eo_confman_default_rop_conf_received(EOrop *rop, eOipv4addr_t from
 }
 
 
+static eOabstime_t s_eo_confman_now(EOconfirmationManager *p)
+{
+    if(NULL != p->config.time_get)
+    {
+        return(p->config.time_get());
+    }
+    
+    return(eov_sys_LifeTimeGet(eov_sys_GetHandle()));
+}
+
+
+static eOconfman_entry_t * s_eo_confman_find(EOconfirmationManager *p, eOipv4addr_t ipaddr, eOropcode_t ropc, eOnvEP_t ep, eOnvID_t id, uint32_t sign)
+{
+    // the table is small: a linear search which stops at the first match is enough
+    eOconfman_entry_t *entry = NULL;
+    uint16_t i = 0;
+    
+    for(i=0; i<p->config.capacity; i++)
+    {
+        entry = &p->table[i];
+        if( (eobool_true == entry->used) && (id == entry->request.ropdes.id) && (ep == entry->request.ropdes.ep) && 
+            (ropc == entry->request.ropdes.ropcode) && (sign == entry->request.ropdes.signature) && (ipaddr == entry->request.ipaddr) )
+        {
+            return(entry);
+        }
+    }
+    
+    return(NULL);
+}
+
+
+static uint32_t s_eo_confman_timeout(EOconfirmationManager *p, uint8_t retransmissions)
+{
+    // exponential backoff of the retransmissions
+    uint32_t timeout = p->rto;
+    
+    while((retransmissions > 0) && (timeout < p->config.rtomax))
+    {
+        timeout <<= 1;
+        retransmissions--;
+    }
+    
+    return((timeout > p->config.rtomax) ? (p->config.rtomax) : (timeout));
+}
+
+
+static void s_eo_confman_rtt_update(EOconfirmationManager *p, uint32_t rtt)
+{
+    // as in RFC 6298: rttvar = 3/4 rttvar + 1/4 |srtt - rtt|, srtt = 7/8 srtt + 1/8 rtt, rto = srtt + 4 rttvar
+    uint32_t delta = 0;
+    
+    if(0 == p->srtt)
+    {
+        p->srtt     = rtt;
+        p->rttvar   = rtt / 2;
+    }
+    else
+    {
+        delta       = (p->srtt > rtt) ? (p->srtt - rtt) : (rtt - p->srtt);
+        p->rttvar   = p->rttvar - (p->rttvar >> EOCONFMAN_RTTVAR_SHIFT) + (delta >> EOCONFMAN_RTTVAR_SHIFT);
+        p->srtt     = p->srtt - (p->srtt >> EOCONFMAN_SRTT_SHIFT) + (rtt >> EOCONFMAN_SRTT_SHIFT);
+        if(0 == p->srtt)
+        {   // zero means not measured yet
+            p->srtt = 1;
+        }
+    }
+    
+    p->rto = p->srtt + 4*p->rttvar;
+    if(p->rto < p->config.rtomin)
+    {
+        p->rto = p->config.rtomin;
+    }
+    else if(p->rto > p->config.rtomax)
+    {
+        p->rto = p->config.rtomax;
+    }
+    
+    p->stats.srtt   = p->srtt;
+    p->stats.rttvar = p->rttvar;
+    p->stats.rto    = p->rto;
+}
+
+
+static void s_eo_confman_confirmed(EOconfirmationManager *p, eOconfman_entry_t *entry, eOropconfinfo_t confinfo, eOabstime_t now)
+{
+    uint64_t elapsed = now - entry->firstsentat;
+    uint32_t latency = (elapsed > 0xffffffff) ? (0xffffffff) : ((uint32_t)elapsed);
+    uint32_t confirmed = p->stats.acked + p->stats.nakked;
+    
+    // as in the algorithm of karn, a retransmitted request does not give a round trip time because we do not know 
+    // which transmission the confirmation refers to
+    if(0 == entry->request.retransmissions)
+    {
+        elapsed = now - entry->sentat;
+        s_eo_confman_rtt_update(p, (elapsed > 0xffffffff) ? (0xffffffff) : ((uint32_t)elapsed));
+    }
+    
+    if((0 == confirmed) || (latency < p->stats.latencymin))
+    {
+        p->stats.latencymin = latency;
+    }
+    if((0 == confirmed) || (latency > p->stats.latencymax))
+    {
+        p->stats.latencymax = latency;
+    }
+    p->latencysum += latency;
+    
+    if(eo_ropconf_ack == confinfo)
+    {
+        p->stats.acked++;
+    }
+    else
+    {
+        p->stats.nakked++;
+    }
+    
+    entry->used = eobool_false;
+    p->stats.outstanding--;
+}
+
+
+static eOresult_t s_eo_confman_request(EOconfirmationManager *p, const eOropdescriptor_t *ropdes, eOipv4addr_t toipaddr)
+{
+    eOconfman_entry_t *entry = NULL;
+    eOabstime_t now = s_eo_confman_now(p);
+    uint32_t sign = (1 == ropdes->configuration.plussign) ? (ropdes->signature) : (EOK_uint32dummy);
+    uint16_t i = 0;
+    
+    entry = s_eo_confman_find(p, toipaddr, ropdes->ropcode, ropdes->ep, ropdes->id, sign);
+    if(NULL != entry)
+    {   // the user sends again an outstanding request. it is a retransmission: as in the algorithm of karn its
+        // confirmation does not give a round trip time. eo_confman_Tick() has already counted its own ones
+        if(eobool_false == entry->retransmitting)
+        {
+            entry->request.retransmissions++;
+            entry->sentat   = now;
+            entry->deadline = now + s_eo_confman_timeout(p, entry->request.retransmissions);
+            p->stats.retransmitted++;
+        }
+        return(eores_OK);
+    }
+    
+    for(i=0; i<p->config.capacity; i++)
+    {
+        if(eobool_false == p->table[i].used)
+        {
+            entry = &p->table[i];
+            break;
+        }
+    }
+    
+    if(NULL == entry)
+    {
+        p->stats.overflows++;
+        return(eores_NOK_generic);
+    }
+    
+    entry->used                                     = eobool_true;
+    entry->retransmitting                           = eobool_false;
+    entry->request.ipaddr                           = toipaddr;
+    entry->request.ropdes.configuration.confrqst    = ropdes->configuration.confrqst;
+    entry->request.ropdes.configuration.timerqst    = ropdes->configuration.timerqst;
+    entry->request.ropdes.configuration.plussign    = ropdes->configuration.plussign;
+    entry->request.ropdes.configuration.plustime    = ropdes->configuration.plustime;
+    entry->request.ropdes.configuration.confirm     = 0;
+    entry->request.ropdes.configuration.onchange    = 0;
+    entry->request.ropdes.configuration.notused     = 0;
+    entry->request.ropdes.ropcode                   = ropdes->ropcode;
+    entry->request.ropdes.ep                        = ropdes->ep;
+    entry->request.ropdes.id                        = ropdes->id;
+    entry->request.ropdes.size                      = 0;
+    entry->request.ropdes.data                      = NULL;
+    entry->request.ropdes.signature                 = sign;
+    entry->request.retransmissions                  = 0;
+    entry->firstsentat                              = now;
+    entry->sentat                                   = now;
+    entry->deadline                                 = now + s_eo_confman_timeout(p, 0);
+    
+    p->stats.requested++;
+    p->stats.outstanding++;
+    
+    return(eores_OK);
+}
+
+
 
 
 
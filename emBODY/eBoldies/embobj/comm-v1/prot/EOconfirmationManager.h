@@ -31,7 +31,13 @@ extern "C" {
 **/
 
 /** @defgroup eo_confman Object EOconfirmationManager
-    The EOconfirmationManager object is used as ...
+    The EOconfirmationManager object is used to follow the rops which ask for a confirmation. If its configuration has a 
+    non-zero capacity, every rop passed to eo_confman_Confirmation_Requested() is kept inside a bounded table of outstanding
+    requests with a deadline until its ack/nak comes back to eo_confman_Confirmation_Received(). The function eo_confman_Tick()
+    retransmits the requests whose deadline is expired via the on_rop_retransmit() callback and declares them lost after 
+    maxretransmissions attempts. The timeout is adapted on the measured round trip times as in RFC 6298.
+    The object is not protected vs concurrent access: its functions must be called by the same task or by the user
+    under the same mutex.
          
     @{        
  **/
@@ -60,11 +66,58 @@ extern "C" {
 typedef struct EOconfirmationManager_hid EOconfirmationManager;
 
 
+/** @typedef    typedef struct eOconfman_request_t
+    @brief      Describes an outstanding request. The ropdes has no data, so that a set<> reloaded with it in the 
+                transmitter takes the current value of the netvar.
+ **/
+typedef struct
+{
+    eOipv4addr_t            ipaddr;             /**< the destination of the rop */
+    eOropdescriptor_t       ropdes;             /**< the rop. its signature is EOK_uint32dummy if the rop does not have one */
+    uint8_t                 retransmissions;    /**< the number of retransmissions done so far */
+} eOconfman_request_t;
+
+
 typedef struct
 {
     void (*on_rop_conf_requested)(EOrop *rop, eOipv4addr_t toipaddr);
     void (*on_rop_conf_received)(EOrop *rop, eOipv4addr_t fromipaddr);
+    uint16_t                capacity;           /**< the size of the table of outstanding requests. if zero, they are not tracked */
+    uint8_t                 maxretransmissions; /**< after them an expired request is lost */
+    uint8_t                 filler;
+    uint32_t                rtoinitial;         /**< the timeout in usec before any round trip time is measured */
+    uint32_t                rtomin;             /**< the min timeout in usec */
+    uint32_t                rtomax;             /**< the max timeout in usec, also after the exponential backoff */
+    eOabstime_t             (*time_get)(void);  /**< the time source in usec. if NULL it is used eov_sys_LifeTimeGet() */
+    void (*on_rop_retransmit)(void *arg, const eOconfman_request_t *req);   /**< it must load the rop again. if NULL, no retransmission */
+    void (*on_rop_lost)(void *arg, const eOconfman_request_t *req);         /**< called when a request is given up */
+    void*                   arg;                /**< the first argument of on_rop_retransmit() and on_rop_lost() */
 } eOconfman_cfg_t;
+
+
+/** @typedef    typedef struct eOconfman_statistics_t
+    @brief      Contains the statistics of the confirmations. The latency goes from the first transmission of the request 
+                to its confirmation, hence it includes the retransmissions. The srtt, rttvar and rto are the current 
+                values of the estimator of RFC 6298, which uses only the requests confirmed without retransmissions.
+                All times are in usec.
+ **/
+typedef struct                  // size is 14*4 = 56 bytes
+{
+    uint32_t        requested;      /**< the requests put in the table */
+    uint32_t        acked;          /**< the requests confirmed with an ack */
+    uint32_t        nakked;         /**< the requests confirmed with a nak. they are not retransmitted */
+    uint32_t        retransmitted;  /**< the retransmissions */
+    uint32_t        lost;           /**< the requests given up */
+    uint32_t        overflows;      /**< the requests not tracked because the table was full */
+    uint32_t        unexpected;     /**< the confirmations without a request, as the late ones after a retransmission */
+    uint32_t        outstanding;    /**< the requests currently in the table */
+    uint32_t        latencymin;
+    uint32_t        latencymax;
+    uint32_t        latencymean;
+    uint32_t        srtt;
+    uint32_t        rttvar;
+    uint32_t        rto;
+} eOconfman_statistics_t;       EO_VERIFYsizeof(eOconfman_statistics_t, 56);
  
 
     
@@ -88,11 +141,57 @@ extern const eOconfman_cfg_t eOconfman_cfg_default;
 extern EOconfirmationManager* eo_confman_New(const eOconfman_cfg_t *cfg);
 
 
+/** @fn         extern eOresult_t eo_confman_Confirmation_Requested(EOconfirmationManager *p, EOrop *rop, eOipv4addr_t toipaddr)
+    @brief      Calls on_rop_conf_requested() and puts the rop in the table of outstanding requests, if the rop asks for a 
+                confirmation. If the rop is already outstanding, it is a retransmission done by the user: it is counted
+                as such and its confirmation will not be used for the round trip time.
+    @param      p               the confirmation manager.
+    @param      rop             the rop just loaded for transmission.
+    @param      toipaddr        its destination.
+    @return     eores_OK if the request is tracked (or the table is not used), eores_NOK_generic if the rop does not ask for
+                a confirmation or the table is full.
+ **/
 extern eOresult_t eo_confman_Confirmation_Requested(EOconfirmationManager *p, EOrop *rop, eOipv4addr_t toipaddr);
+
+
+/** @fn         extern eOresult_t eo_confman_Confirmation_Requested_with_ropdes(EOconfirmationManager *p, const eOropdescriptor_t *ropdes, eOipv4addr_t toipaddr)
+    @brief      As eo_confman_Confirmation_Requested() for a rop loaded by its descriptor, as the transceiver does. The 
+                on_rop_conf_requested() is not called because there is no EOrop.
+ **/
+extern eOresult_t eo_confman_Confirmation_Requested_with_ropdes(EOconfirmationManager *p, const eOropdescriptor_t *ropdes, eOipv4addr_t toipaddr);
                                                    
                                                    
 extern eOresult_t eo_confman_Confirmation_Received(EOconfirmationManager *p, EOrop *rop, eOipv4addr_t fromipaddr);
 
+
+/** @fn         extern eOresult_t eo_confman_Tick(EOconfirmationManager *p)
+    @brief      Checks the deadlines of the outstanding requests. An expired request is given to on_rop_retransmit() 
+                with a doubled timeout or, after maxretransmissions, it is removed and given to on_rop_lost(). The rop
+                that on_rop_retransmit() loads is already counted, so passing it to eo_confman_Confirmation_Requested()
+                does not count it twice.
+                It must be called regularly, for instance before preparing every packet to transmit.
+    @param      p               the confirmation manager.
+    @return     eores_OK or eores_NOK_nullpointer.
+ **/
+extern eOresult_t eo_confman_Tick(EOconfirmationManager *p);
+
+
+/** @fn         extern eOresult_t eo_confman_Statistics_Get(EOconfirmationManager *p, eOconfman_statistics_t *stats)
+    @brief      copies the statistics of the confirmations.
+    @param      p               the confirmation manager.
+    @param      stats           the destination.
+    @return     eores_OK or eores_NOK_nullpointer.
+ **/
+extern eOresult_t eo_confman_Statistics_Get(EOconfirmationManager *p, eOconfman_statistics_t *stats);
+
+
+/** @fn         extern eOresult_t eo_confman_Statistics_Reset(EOconfirmationManager *p)
+    @brief      sets to zero the counters and the latencies. the outstanding requests and the estimator are kept.
+    @param      p               the confirmation manager.
+    @return     eores_OK or eores_NOK_nullpointer.
+ **/
+extern eOresult_t eo_confman_Statistics_Reset(EOconfirmationManager *p);
+
                                                    
 
 
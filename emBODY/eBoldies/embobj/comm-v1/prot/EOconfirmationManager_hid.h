@@ -52,6 +52,16 @@ extern "C" {
 
 // - definition of the hidden struct implementing the object ----------------------------------------------------------
 
+typedef struct
+{
+    eOconfman_request_t     request;
+    eOabstime_t             firstsentat;        // used for the latency
+    eOabstime_t             sentat;             // used for the round trip time
+    eOabstime_t             deadline;
+    eObool_t                used;
+    eObool_t                retransmitting;     // true while the entry is given to on_rop_retransmit()
+} eOconfman_entry_t;
+
 
 
 /** @struct     EOconfirmationManager_hid
@@ -62,7 +72,13 @@ extern "C" {
  
 struct EOconfirmationManager_hid 
 {
-    eOconfman_cfg_t     config;
+    eOconfman_cfg_t         config;
+    eOconfman_entry_t*      table;              // config.capacity entries
+    uint32_t                srtt;               // in usec. zero until the first round trip time is measured
+    uint32_t                rttvar;
+    uint32_t                rto;
+    uint64_t                latencysum;
+    eOconfman_statistics_t  stats;
 }; 
 
 
@@ -96,7 +96,10 @@ const eOhosttransceiver_cfg_t eo_hosttransceiver_cfg_default =
     },    
     EO_INIT(.mutex_fn_new)              NULL,
     EO_INIT(.transprotection)           eo_trans_protection_none,
-    EO_INIT(.nvscfgprotection)          eo_nvscfg_protection_none
+    EO_INIT(.nvscfgprotection)          eo_nvscfg_protection_none,
+    EO_INIT(.ropframeformat)            eo_trans_ropframeformat_standard,
+    EO_INIT(.confmancfg)                NULL,
+    EO_INIT(.maxnumberofropsinbatch)    0
 
 };
 
@@ -141,6 +144,9 @@ extern EOhostTransceiver * eo_hosttransceiver_New(const eOhosttransceiver_cfg_t
     txrxcfg.nvscfg                          = retptr->nvscfg;
     txrxcfg.mutex_fn_new                    = cfg->mutex_fn_new;
     txrxcfg.protection                      = cfg->transprotection;
+    txrxcfg.ropframeformat                  = cfg->ropframeformat;
+    txrxcfg.confmancfg                      = cfg->confmancfg;
+    txrxcfg.maxnumberofropsinbatch          = cfg->maxnumberofropsinbatch;
     
     
     retptr->transceiver = eo_transceiver_New(&txrxcfg);
@@ -73,6 +73,9 @@ typedef struct
     eov_mutex_fn_mutexderived_new   mutex_fn_new;    
     eOtransceiver_protection_t      transprotection;
     eOnvscfg_protection_t           nvscfgprotection; 
+    eOtransceiver_ropframeformat_t  ropframeformat;
+    const eOconfman_cfg_t*          confmancfg;     // if not NULL, the confirmations of the occasional rops are followed. see eo_transceiver_confstatistics_Get()
+    uint16_t                        maxnumberofropsinbatch; // if not 0, the received rops are processed in batches (see eOtransceiver_cfg_t)
 } eOhosttransceiver_cfg_t;
 
 
@@ -134,6 +134,7 @@ extern eOresult_t eo_nv_Clear(EOnv *nv)
     nv->rem         = NULL; 
     nv->mtx         = NULL;
     nv->stg         = NULL;
+    nv->changed     = NULL;
       
     return(eores_OK);
 }
@@ -222,6 +223,24 @@ extern eOresult_t eo_nv_ResetTS(const EOnv *nv, eObool_t forcerst, eOnvUpdate_t
 }
 
 
+extern eOresult_t eo_nv_Touch(const EOnv *nv)
+{
+    if(NULL == nv)
+    {
+        return(eores_NOK_nullpointer);
+    }
+
+    if(NULL != nv->changed)
+    {
+        eov_mutex_Take(nv->mtx, eok_reltimeINFINITE);
+        *nv->changed = 1;
+        eov_mutex_Release(nv->mtx);
+    }
+
+    return(eores_OK);
+}
+
+
 extern uint16_t eo_nv_Capacity(const EOnv *nv)
 {
     if(NULL == nv)
@@ -458,7 +477,7 @@ extern eOnvType_t eo_nv_GetTYP(const EOnv *netvar)
 // --------------------------------------------------------------------------------------------------------------------
 
 
-extern eOresult_t eo_nv_hid_Load(EOnv *nv, EOtreenode* treenode, eOipv4addr_t ip, eOnvEP_t ep, EOnv_con_t* con, EOnv_usr_t* usr, void* loc, void* rem, EOVmutexDerived* mtx, EOVstorageDerived* stg)
+extern eOresult_t eo_nv_hid_Load(EOnv *nv, EOtreenode* treenode, eOipv4addr_t ip, eOnvEP_t ep, EOnv_con_t* con, EOnv_usr_t* usr, void* loc, void* rem, EOVmutexDerived* mtx, EOVstorageDerived* stg, uint8_t* changed)
 {
     nv->treenode    = treenode;
     nv->ip          = ip;
@@ -470,6 +489,7 @@ extern eOresult_t eo_nv_hid_Load(EOnv *nv, EOtreenode* treenode, eOipv4addr_t ip
     nv->rem         = rem;   
     nv->mtx         = mtx;
     nv->stg         = stg;
+    nv->changed     = changed;
            
     return(eores_OK);
 }
@@ -481,6 +501,26 @@ extern void eo_nv_hid_Fast_LocalMemoryGet(EOnv *nv, void* dest)
     eov_mutex_Release(nv->mtx);    
 }
 
+extern eObool_t eo_nv_hid_Fast_LocalMemoryRefresh(EOnv *nv, void* dest)
+{
+    eObool_t changed = eobool_false;
+    
+    // the flag is set by every write of the local value (see eo_nv_Touch() for the direct writes of the application).
+    eov_mutex_Take(nv->mtx, eok_reltimeINFINITE);
+    if((NULL == nv->changed) || (0 != *nv->changed))
+    {
+        memcpy(dest, nv->loc, nv->con->capacity);
+        changed = eobool_true;
+        if(NULL != nv->changed)
+        {
+            *nv->changed = 0;
+        }
+    }
+    eov_mutex_Release(nv->mtx);
+    
+    return(changed);
+}
+
 #if !defined(EO_NV_DONT_USE_ONROPRECEPTION)
 extern eObool_t eo_nv_hid_OnBefore_ROP(const EOnv *nv, eOropcode_t ropcode, eOabstime_t roptime, uint32_t ropsign)
 {
@@ -744,6 +784,11 @@ static eOresult_t s_eo_nv_Set(const EOnv *nv, const void *dat, void *dst, eOnvUp
 
     memcpy(dst, dat, size);
 
+    if((dst == nv->loc) && (NULL != nv->changed))
+    {
+        *nv->changed = 1;
+    }
+
 
     if(eobool_true == eo_nv_hid_isPermanent(nv)) 
     {
@@ -786,6 +831,11 @@ static eOresult_t s_eo_nv_SetTS(const EOnv *nv, const void *dat, void *dst, eOnv
 
     memcpy(dst, dat, size);
 
+    if((dst == nv->loc) && (NULL != nv->changed))
+    {
+        *nv->changed = 1;
+    }
+
     if(eobool_true == eo_nv_hid_isPermanent(nv)) 
     {
         if((EOK_uint32dummy != nv->usr->stg_address) && (NULL != nv->stg))
@@ -173,6 +173,10 @@ extern eOresult_t eo_nv_ResetTS(const EOnv *netvar, eObool_t forcerst, eOnvUpdat
 
 extern eOresult_t eo_nv_Get(const EOnv *netvar, eOnvStorage_t strg, void *data, uint16_t *size);
 
+// eo_nv_Set() and eo_nv_Reset() mark the local value as changed. the application which writes the local ram of the nv directly
+// through its pointer must call eo_nv_Touch() afterwards, else a regular rop sent on change does not see the new value.
+extern eOresult_t eo_nv_Touch(const EOnv *netvar);
+
 extern eOresult_t eo_nv_remoteGet(const EOnv *netvar, void *data, uint16_t *size);
 
 extern uint16_t eo_nv_Size(const EOnv *netvar, const void *data);
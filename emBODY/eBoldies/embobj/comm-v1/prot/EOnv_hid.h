@@ -151,6 +151,7 @@ struct EOnv_hid
     void*                           rem;        // the volatile part which keeps REMOTE value of nv, when signalled or said
     EOVmutexDerived*                mtx;        // the mutex which protects concurrent access to this nv 
     EOVstorageDerived*              stg;
+    uint8_t*                        changed;    // flag of the nv kept by EOnvsCfg: 1 after a write of loc, 0 after a refresh. it can be NULL
 };   
  
 
@@ -165,10 +166,14 @@ struct EOnv_hid
 //extern EOnv * eo_nv_hid_New(uint8_t fun, uint8_t typ, uint32_t otherthingsmaybe);
 
 
-extern eOresult_t eo_nv_hid_Load(EOnv *nv,  EOtreenode* treenode, eOipv4addr_t ip, eOnvEP_t ep, EOnv_con_t* con, EOnv_usr_t* usr, void* loc, void* rem, EOVmutexDerived* mtx, EOVstorageDerived* stg);
+extern eOresult_t eo_nv_hid_Load(EOnv *nv,  EOtreenode* treenode, eOipv4addr_t ip, eOnvEP_t ep, EOnv_con_t* con, EOnv_usr_t* usr, void* loc, void* rem, EOVmutexDerived* mtx, EOVstorageDerived* stg, uint8_t* changed);
 
 extern void eo_nv_hid_Fast_LocalMemoryGet(EOnv *nv, void* dest);
 
+// as eo_nv_hid_Fast_LocalMemoryGet() but it copies only if the local value was written since the previous refresh (or if the nv
+// has no changed flag). it returns eobool_true if it has copied.
+extern eObool_t eo_nv_hid_Fast_LocalMemoryRefresh(EOnv *nv, void* dest);
+
 #if     !defined(EO_NV_DONT_USE_ONROPRECEPTION)
 extern eObool_t eo_nv_hid_OnBefore_ROP(const EOnv *nv, eOropcode_t ropcode, eOabstime_t roptime, uint32_t ropsign);
 #endif
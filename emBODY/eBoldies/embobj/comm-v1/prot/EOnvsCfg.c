@@ -94,6 +94,15 @@ static void s_eo_nvscfg_devicesowneship_change(EOnvsCfg *p,  eOnvscfgOwnership_t
 static uint16_t s_eo_nvscfg_ondevice_endpoint2index(EOnvsCfg* p, uint16_t ondevindex, eOnvEP_t endpoint);
 static uint16_t s_eo_nvscfg_ondevice_onendpoint_id2index(EOnvsCfg* p, uint16_t ondevindex, uint16_t onendpointindex, eOnvID_t id);
 
+static uint16_t s_eo_nvscfg_hashtable_size(uint16_t capacity);
+static uint16_t s_eo_nvscfg_hash(uint16_t key, uint16_t mask);
+static eOnvsCfg_hashentry_t* s_eo_nvscfg_hashtable_New(uint16_t capacity, uint16_t *mask);
+static eOresult_t s_eo_nvscfg_hashtable_Insert(eOnvsCfg_hashentry_t *table, uint16_t mask, uint16_t key, uint16_t index);
+static uint16_t s_eo_nvscfg_hashtable_Find(const eOnvsCfg_hashentry_t *table, uint16_t mask, uint16_t key);
+static eOnvsCfg_iphashentry_t* s_eo_nvscfg_iphashtable_New(uint16_t capacity, uint16_t *mask);
+static eOresult_t s_eo_nvscfg_iphashtable_Insert(eOnvsCfg_iphashentry_t *table, uint16_t mask, eOipv4addr_t ipaddress, uint16_t index);
+static uint16_t s_eo_nvscfg_iphashtable_Find(const eOnvsCfg_iphashentry_t *table, uint16_t mask, eOipv4addr_t ipaddress);
+
 #if defined(EO_NVSCFG_USE_HASHTABLE)
 static uint16_t s_nvscfg_hashing(uint16_t ep, uint16_t sizeofhashtable);
 #endif
@@ -122,6 +131,7 @@ extern EOnvsCfg* eo_nvscfg_New(uint16_t ndevices, EOVstorageDerived* stg, eOnvsc
     
     p->thedevices           = eo_vector_New(sizeof(EOnvsCfg_device_t*), ndevices, NULL, 0, NULL, NULL);
     p->ip2index             = eo_vector_New(sizeof(eOipv4addr_t), ndevices, NULL, 0, NULL, NULL);
+    p->ip2indextable        = s_eo_nvscfg_iphashtable_New(ndevices, &p->ip2indexmask);
     p->indexoflocaldevice   = EOK_uint16dummy;
     p->devicesowneship      = eo_nvscfg_devicesownership_none;
     p->storage              = stg;
@@ -166,7 +176,7 @@ extern eOresult_t eo_nvscfg_PushBackDevice(EOnvsCfg* p, eOnvscfgOwnership_t owne
     
     eo_errman_Assert(eo_errman_GetHandle(), (eobool_false == eo_vector_Full(p->thedevices)), s_eobj_ownname, "->thedevices is full");
 
-    eo_errman_Assert(eo_errman_GetHandle(), (eobool_true != eo_vector_Find(p->ip2index, &ipaddress, NULL)), s_eobj_ownname, "ip already inside");
+    eo_errman_Assert(eo_errman_GetHandle(), (EOK_uint16dummy == s_eo_nvscfg_iphashtable_Find(p->ip2indextable, p->ip2indexmask, ipaddress)), s_eobj_ownname, "ip already inside");
 
     s_eo_nvscfg_devicesowneship_change(p, ownership);
 
@@ -183,12 +193,19 @@ extern eOresult_t eo_nvscfg_PushBackDevice(EOnvsCfg* p, eOnvscfgOwnership_t owne
     dev->theendpoints_numberof  = nendpoints;
     dev->hashfn_ep2index        = hashfn_ep2index;
     dev->mtx_device             = (eo_nvscfg_protection_one_per_device == p->protection) ? p->mtxderived_new() : NULL;
+    dev->ep2indextable          = s_eo_nvscfg_hashtable_New(nendpoints, &dev->ep2indexmask);
 #if defined(EO_NVSCFG_USE_HASHTABLE)
     dev->ephashtable            = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(eOnvsCfgEPhash_t), nendpoints);
     // teh entries of teh hastable are all {0xffff, 0xffff} to tell that they are still invalid.
     memset(dev->ephashtable, 0xff,  sizeof(eOnvsCfgEPhash_t)*nendpoints); 
 #endif
 
+    if(eores_OK != s_eo_nvscfg_iphashtable_Insert(p->ip2indextable, p->ip2indexmask, ipaddress, eo_vector_Size(p->thedevices)))
+    {
+        eo_errman_Error(eo_errman_GetHandle(), eo_errortype_fatal, s_eobj_ownname, "ip2indextable is full");
+        return(eores_NOK_generic);
+    }
+
     eo_vector_PushBack(p->thedevices, &dev);
 
     eo_vector_PushBack(p->ip2index, &ipaddress);
@@ -261,6 +278,15 @@ extern eOresult_t eo_nvscfg_ondevice_PushBackEP(EOnvsCfg* p, uint16_t ondevindex
     {
         theendpoint->thenvs_rem     = NULL;
     }
+    if(eo_nvscfg_ownership_local == (*thedev)->ownership)
+    {   // the values are all new, thus the first refresh of every nv copies it
+        theendpoint->thenvs_changed = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_08bit, sizeof(uint8_t), nnvs);
+        memset(theendpoint->thenvs_changed, 1, nnvs);
+    }
+    else
+    {
+        theendpoint->thenvs_changed = NULL;
+    }
     theendpoint->thenvs_initialise  = datanvs_init;
     theendpoint->thenvs_ramretrieve = datanvs_retrieve;
     theendpoint->thenvs_sizeof      = datanvs_size;
@@ -296,6 +322,32 @@ extern eOresult_t eo_nvscfg_ondevice_PushBackEP(EOnvsCfg* p, uint16_t ondevindex
         }
     }
 #endif    
+
+    if(eores_OK != s_eo_nvscfg_hashtable_Insert((*thedev)->ep2indextable, (*thedev)->ep2indexmask, endpoint, eo_vector_Size((*thedev)->theendpoints)))
+    {
+        eo_errman_Error(eo_errman_GetHandle(), eo_errortype_fatal, s_eobj_ownname, "ep2indextable is full");
+        return(eores_NOK_generic);
+    }
+
+    // the id->index table is built for every endpoint of a remote device, so that the host side does not depend on
+    // the hash functions of the configuration. a local endpoint with its hash function does not need it.
+    theendpoint->id2indextable      = NULL;
+    theendpoint->id2indexmask       = 0;
+    if((NULL == hashfn_id2index) || (eo_nvscfg_ownership_remote == (*thedev)->ownership))
+    {
+        uint16_t k;
+        theendpoint->id2indextable  = s_eo_nvscfg_hashtable_New(nnvs, &theendpoint->id2indexmask);
+        for(k=0; k<nnvs; k++)
+        {
+            EOnv_con_t* nvcon = (EOnv_con_t*) eo_treenode_GetData((EOtreenode*) eo_constvector_At(treeofnvs_con, k));
+            eo_errman_Assert(eo_errman_GetHandle(), (EOK_uint16dummy == s_eo_nvscfg_hashtable_Find(theendpoint->id2indextable, theendpoint->id2indexmask, nvcon->id)), s_eobj_ownname, "id already inside");
+            if(eores_OK != s_eo_nvscfg_hashtable_Insert(theendpoint->id2indextable, theendpoint->id2indexmask, nvcon->id, k))
+            {
+                eo_errman_Error(eo_errman_GetHandle(), eo_errortype_fatal, s_eobj_ownname, "id2indextable is full");
+                return(eores_NOK_generic);
+            }
+        }
+    }
     
     eo_vector_PushBack((*thedev)->theendpoints, &theendpoint);
 
@@ -403,7 +455,8 @@ extern eOresult_t eo_nvscfg_data_Initialise(EOnvsCfg* p)
                                     (eo_nvscfg_ownership_remote == (*thedev)->ownership) ? ( (void*) (&u8ptrrem[tmpnvcon->offset]) ) : (NULL),
                                     //(eo_nvscfg_ownership_remote == (*thedev)->ownership) ? ((void*) ((uint32_t)((*theendpoint)->thenvs_rem) + tmpnvcon->offset)) : (NULL),
                                     mtx2use, // was : (*theendpoint)->mtx_endpoint,
-                                    p->storage
+                                    p->storage,
+                                    (NULL == (*theendpoint)->thenvs_changed) ? (NULL) : (&(*theendpoint)->thenvs_changed[k])
                               );
                 
 //                 tmpnv.ep  = (*theendpoint)->endpoint;
@@ -652,7 +705,8 @@ extern EOnv* eo_nvscfg_GetNV(EOnvsCfg* p, uint16_t ondevindex, uint16_t onendpoi
                         (void*) ((uint32_t)((*theendpoint)->thenvs_vol) + tmpnvcon->offset),
                         (eo_nvscfg_ownership_remote == (*thedev)->ownership) ? ((void*) ((uint32_t)((*theendpoint)->thenvs_rem) + tmpnvcon->offset)) : (NULL),
                         mtx2use, // was: (*theendpoint)->mtx_endpoint,
-                        p->storage
+                        p->storage,
+                        (NULL == (*theendpoint)->thenvs_changed) ? (NULL) : (&(*theendpoint)->thenvs_changed[k])
                   );    
 
 //    nv->ep  = (*theendpoint)->endpoint;
@@ -687,19 +741,12 @@ extern EOnv* eo_nvscfg_GetNV(EOnvsCfg* p, uint16_t ondevindex, uint16_t onendpoi
 
 extern uint16_t eo_nvscfg_hid_ip2index(EOnvsCfg* p, eOipv4addr_t ipaddress)
 {
-    uint16_t index = 0;
-
     if(NULL == p)
     {
         return(EOK_uint16dummy);
     }
 
-    if(eobool_true == eo_vector_Find(p->ip2index, &ipaddress, &index))
-    {
-        return(index);  
-    }
-
-    return(EOK_uint16dummy);
+    return(s_eo_nvscfg_iphashtable_Find(p->ip2indextable, p->ip2indexmask, ipaddress));
 }
 
 extern uint16_t eo_nvscfg_hid_ondevice_endpoint2index(EOnvsCfg* p, uint16_t ondevindex, eOnvEP_t endpoint)
@@ -741,6 +788,12 @@ extern EOtreenode* eo_nvscfg_hid_ondevice_onendpoint_withID_GetTreeNode(EOnvsCfg
         return(NULL);
     }
 
+    if(NULL != (*theendpoint)->id2indextable)
+    {   // the table contains every id of the endpoint: a miss is final
+        uint16_t index = s_eo_nvscfg_hashtable_Find((*theendpoint)->id2indextable, (*theendpoint)->id2indexmask, id);
+        return((EOK_uint16dummy == index) ? (NULL) : ((EOtreenode*) eo_constvector_At((*theendpoint)->thetreeofnvs_con, index)));
+    }
+
     if((NULL != (*theendpoint)->hashfn_id2index))
     {
         uint16_t index = (*theendpoint)->hashfn_id2index(id);
@@ -777,6 +830,63 @@ extern EOtreenode* eo_nvscfg_hid_ondevice_onendpoint_withID_GetTreeNode(EOnvsCfg
 
 
 
+extern eOresult_t eo_nvscfg_hid_ondevice_onendpoint_GetMutex(EOnvsCfg* p, uint16_t ondevindex, uint16_t onendpointindex, EOVmutexDerived** mtx)
+{
+    EOnvsCfg_device_t** thedev = NULL;
+    EOnvsCfg_ep_t **theendpoint = NULL;
+
+    if((NULL == p) || (NULL == mtx))
+    {
+        return(eores_NOK_nullpointer);
+    }
+
+    *mtx = NULL;
+
+    thedev = (EOnvsCfg_device_t**) eo_vector_At(p->thedevices, ondevindex);
+    if(NULL == thedev)
+    {
+        return(eores_NOK_generic);
+    }
+    theendpoint = (EOnvsCfg_ep_t**) eo_vector_At((*thedev)->theendpoints, onendpointindex);
+    if(NULL == theendpoint)
+    {
+        return(eores_NOK_generic);
+    }
+
+    switch(p->protection)
+    {
+        case eo_nvscfg_protection_none:
+        {
+            *mtx = NULL;
+        } break;
+
+        case eo_nvscfg_protection_one_per_object:
+        {
+            *mtx = p->mtx_object;
+        } break;
+
+        case eo_nvscfg_protection_one_per_device:
+        {
+            *mtx = (*thedev)->mtx_device;
+        } break;
+
+        case eo_nvscfg_protection_one_per_endpoint:
+        {
+            *mtx = (*theendpoint)->mtx_endpoint;
+        } break;
+
+        default:
+        {   // eo_nvscfg_protection_one_per_netvar: there is not a single mutex
+            return(eores_NOK_generic);
+        } 
+
+    }
+
+    return(eores_OK);
+}
+
+
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of static functions 
 // --------------------------------------------------------------------------------------------------------------------
@@ -879,6 +989,11 @@ static uint16_t s_eo_nvscfg_ondevice_endpoint2index(EOnvsCfg* p, uint16_t ondevi
     }
 #else
 
+    if(NULL != (*thedev)->ep2indextable)
+    {   // the table contains every endpoint of the device: a miss is final
+        return(s_eo_nvscfg_hashtable_Find((*thedev)->ep2indextable, (*thedev)->ep2indexmask, endpoint));
+    }
+
     if((NULL != (*thedev)->hashfn_ep2index))
     {
         uint16_t index = (*thedev)->hashfn_ep2index(endpoint);
@@ -928,6 +1043,11 @@ static uint16_t s_eo_nvscfg_ondevice_onendpoint_id2index(EOnvsCfg* p, uint16_t o
     }
 
  
+    if(NULL != (*theendpoint)->id2indextable)
+    {   // the table contains every id of the endpoint: a miss is final
+        return(s_eo_nvscfg_hashtable_Find((*theendpoint)->id2indextable, (*theendpoint)->id2indexmask, id));
+    }
+
     if((NULL != (*theendpoint)->hashfn_id2index))
     {
         uint16_t index = (*theendpoint)->hashfn_id2index(id);
@@ -957,6 +1077,139 @@ static uint16_t s_eo_nvscfg_ondevice_onendpoint_id2index(EOnvsCfg* p, uint16_t o
     return(EOK_uint16dummy);
 }
 
+
+static uint16_t s_eo_nvscfg_hashtable_size(uint16_t capacity)
+{
+    // a power of two at least twice the capacity keeps the probe sequences short
+    uint32_t size = 4;
+    while(size < (2*(uint32_t)capacity))
+    {
+        size <<= 1;
+    }
+    return((uint16_t)((size > 0x8000) ? (0x8000) : (size)));
+}
+
+
+static uint16_t s_eo_nvscfg_hash(uint16_t key, uint16_t mask)
+{
+    return(EO_NVSCFG_HASH(key, mask));
+}
+
+
+static eOnvsCfg_hashentry_t* s_eo_nvscfg_hashtable_New(uint16_t capacity, uint16_t *mask)
+{
+    eOnvsCfg_hashentry_t *table = NULL;
+    uint16_t size = s_eo_nvscfg_hashtable_size(capacity);
+
+    table = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(eOnvsCfg_hashentry_t), size);
+    // every entry has index = EOK_uint16dummy, thus it is free
+    memset(table, 0xff, sizeof(eOnvsCfg_hashentry_t)*size);
+    *mask = size - 1;
+
+    return(table);
+}
+
+
+static eOresult_t s_eo_nvscfg_hashtable_Insert(eOnvsCfg_hashentry_t *table, uint16_t mask, uint16_t key, uint16_t index)
+{
+    uint16_t pos = s_eo_nvscfg_hash(key, mask);
+    uint32_t probes = 0;
+
+    // the size of the table is capped to 0x8000, thus with more keys it can be full: the probe visits every entry once
+    while(EOK_uint16dummy != table[pos].index)
+    {
+        if(++probes > (uint32_t)mask)
+        {
+            return(eores_NOK_generic);
+        }
+        pos = (pos + 1) & mask;
+    }
+
+    table[pos].key      = key;
+    table[pos].index    = index;
+
+    return(eores_OK);
+}
+
+
+static uint16_t s_eo_nvscfg_hashtable_Find(const eOnvsCfg_hashentry_t *table, uint16_t mask, uint16_t key)
+{
+    uint16_t pos = s_eo_nvscfg_hash(key, mask);
+    uint32_t probes = 0;
+
+    // the probe stops at a free entry or after it has visited every entry of a full table
+    while(EOK_uint16dummy != table[pos].index)
+    {
+        if(key == table[pos].key)
+        {
+            return(table[pos].index);
+        }
+        if(++probes > (uint32_t)mask)
+        {
+            break;
+        }
+        pos = (pos + 1) & mask;
+    }
+
+    return(EOK_uint16dummy);
+}
+
+
+static eOnvsCfg_iphashentry_t* s_eo_nvscfg_iphashtable_New(uint16_t capacity, uint16_t *mask)
+{
+    eOnvsCfg_iphashentry_t *table = NULL;
+    uint16_t size = s_eo_nvscfg_hashtable_size(capacity);
+
+    table = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(eOnvsCfg_iphashentry_t), size);
+    memset(table, 0xff, sizeof(eOnvsCfg_iphashentry_t)*size);
+    *mask = size - 1;
+
+    return(table);
+}
+
+
+static eOresult_t s_eo_nvscfg_iphashtable_Insert(eOnvsCfg_iphashentry_t *table, uint16_t mask, eOipv4addr_t ipaddress, uint16_t index)
+{
+    uint16_t pos = s_eo_nvscfg_hash(EO_NVSCFG_IPV4FOLD(ipaddress), mask);
+    uint32_t probes = 0;
+
+    while(EOK_uint16dummy != table[pos].index)
+    {
+        if(++probes > (uint32_t)mask)
+        {
+            return(eores_NOK_generic);
+        }
+        pos = (pos + 1) & mask;
+    }
+
+    table[pos].ipaddress    = ipaddress;
+    table[pos].index        = index;
+
+    return(eores_OK);
+}
+
+
+static uint16_t s_eo_nvscfg_iphashtable_Find(const eOnvsCfg_iphashentry_t *table, uint16_t mask, eOipv4addr_t ipaddress)
+{
+    uint16_t pos = s_eo_nvscfg_hash(EO_NVSCFG_IPV4FOLD(ipaddress), mask);
+    uint32_t probes = 0;
+
+    while(EOK_uint16dummy != table[pos].index)
+    {
+        if(ipaddress == table[pos].ipaddress)
+        {
+            return(table[pos].index);
+        }
+        if(++probes > (uint32_t)mask)
+        {
+            break;
+        }
+        pos = (pos + 1) & mask;
+    }
+
+    return(EOK_uint16dummy);
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // - end-of-file (leave a blank line after)
 // --------------------------------------------------------------------------------------------------------------------
@@ -47,9 +47,32 @@ extern "C" {
 
 // - #define used with hidden struct ----------------------------------------------------------------------------------
 
+// multiplicative hashing of a key into a position of a table of mask+1 entries: every bit of the key reaches the
+// bits used as position.
+#define EO_NVSCFG_HASH(key, mask)       ((uint16_t)((((uint32_t)(uint16_t)(key)) * 2654435761UL) >> 16) & (mask))
+
+// the ip addresses are folded into 16 bits before they are hashed. the two halves are xor-ed, thus the addresses
+// which differ only in one half (e.g., all the boards of a /16 subnet) never give the same key.
+#define EO_NVSCFG_IPV4FOLD(ip)          ((uint16_t)((ip) ^ ((ip) >> 16)))
+
 
 // - definition of the hidden struct implementing the object ----------------------------------------------------------
 
+// entry of the open-addressing tables which map an id or an endpoint into its index. an entry is free if its
+// index is EOK_uint16dummy. the tables are filled when the configuration is pushed back and never change later.
+typedef struct
+{
+    uint16_t                        key;
+    uint16_t                        index;
+} eOnvsCfg_hashentry_t;
+
+typedef struct
+{
+    eOipv4addr_t                    ipaddress;
+    uint16_t                        index;
+    uint16_t                        filler;
+} eOnvsCfg_iphashentry_t;
+
 typedef struct
 {
     eOnvEP_t                        endpoint;
@@ -59,12 +82,15 @@ typedef struct
     const EOconstvector*            thenvs_usr;
     void*                           thenvs_vol;
     void*                           thenvs_rem;
+    uint8_t*                        thenvs_changed;     // one flag per nv of a local endpoint (see eo_nv_Touch()), else NULL
     eOvoid_fp_uint16_voidp_voidp_t  thenvs_initialise;  // ep, vol_local, vol_remote
     eOvoid_fp_uint16_voidp_voidp_t  thenvs_ramretrieve; // ep, vol_local, vol_remote
     uint32_t                        thenvs_sizeof;   
     eOuint16_fp_uint16_t            hashfn_id2index; 
     EOVmutexDerived*                mtx_endpoint;    
     EOvector*                       themtxofthenvs;    
+    eOnvsCfg_hashentry_t*           id2indextable;      // NULL if hashfn_id2index is used on a local endpoint
+    uint16_t                        id2indexmask;
 } EOnvsCfg_ep_t;
 
 typedef struct
@@ -82,6 +108,8 @@ typedef struct
     eOnvsCfgEPhash_t*               ephashtable;  
     eOuint16_fp_uint16_t            hashfn_ep2index;   
     EOVmutexDerived*                mtx_device;      
+    eOnvsCfg_hashentry_t*           ep2indextable;
+    uint16_t                        ep2indexmask;
 } EOnvsCfg_device_t;
 
 
@@ -95,6 +123,8 @@ struct EOnvsCfg_hid
 {
     EOvector*                       thedevices;
     EOvector*                       ip2index;
+    eOnvsCfg_iphashentry_t*         ip2indextable;
+    uint16_t                        ip2indexmask;
     uint16_t                        indexoflocaldevice;
     eOnvscfgDevicesOwnership_t      devicesowneship;
     EOVstorageDerived*              storage;
@@ -117,6 +147,11 @@ extern uint16_t eo_nvscfg_hid_ondevice_onendpoint_id2index(EOnvsCfg* p, uint16_t
 
 extern EOtreenode* eo_nvscfg_hid_ondevice_onendpoint_withID_GetTreeNode(EOnvsCfg* p, uint16_t ondevindex, uint16_t onendpointindex, eOnvID_t id);
 
+// it gives back in mtx the mutex which protects every nv of the endpoint (NULL if there is no protection). it returns
+// eores_NOK_generic if the nvs of the endpoint have one mutex each, as it happens with eo_nvscfg_protection_one_per_netvar.
+extern eOresult_t eo_nvscfg_hid_ondevice_onendpoint_GetMutex(EOnvsCfg* p, uint16_t ondevindex, uint16_t onendpointindex, EOVmutexDerived** mtx);
+
+
 
 
  
@@ -26,6 +26,11 @@
 #include "EOtheMemoryPool.h"
 #include "EOtheParser.h"
 #include "EOtheFormer.h"
+#include "EOVtheSystem.h"
+#include "EOropframe_hid.h"
+#include "EOrop_hid.h"
+#include "EOnvsCfg_hid.h"
+#include "EOtheAgent_hid.h"
 
 
 
@@ -48,6 +53,10 @@
 // - #define with internal scope
 // --------------------------------------------------------------------------------------------------------------------
 
+// a sequence number lower than the last one by at most this value is counted as out of order, else as a restart of
+// the remote host
+#define EORECEIVER_SEQNUM_REORDERWINDOW         64
+
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -66,7 +75,16 @@
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of static functions
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section
+
+static void s_eo_receiver_addreply(EOreceiver *p);
+static void s_eo_receiver_sequencenumber_check(EOreceiver *p, uint64_t rec_seqnum, eOipv4addr_t remipv4addr);
+static void s_eo_receiver_lossburst_add(eo_receiver_statistics_t *stats, uint64_t lost);
+static void s_eo_receiver_jitter_update(EOreceiver *p, eOabstime_t arrival, eOabstime_t age);
+static void s_eo_receiver_process_onebyone(EOreceiver *p, uint16_t nrops, EOnvsCfg *nvscfg, eOipv4addr_t remipv4addr);
+static void s_eo_receiver_process_batched(EOreceiver *p, uint16_t nrops, EOnvsCfg *nvscfg, eOipv4addr_t remipv4addr);
+static uint16_t s_eo_receiver_batch_decodeheads(EOreceiver *p, uint16_t maxrops);
+static eOresult_t s_eo_receiver_batch_processrun(EOreceiver *p, EOreceiverBATCHitem_t *items, uint16_t nitems, EOnvsCfg *nvscfg, eOipv4addr_t remipv4addr);
+static void s_eo_receiver_confirmation_check(EOreceiver *p, eOipv4addr_t remipv4addr);
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -80,7 +98,11 @@ const eo_receiver_cfg_t eo_receiver_cfg_default =
     EO_INIT(.capacityofropframereply)   256, 
     EO_INIT(.capacityofropinput)        128, 
     EO_INIT(.capacityofropreply)        128, 
-    EO_INIT(.nvscfg)                    NULL
+    EO_INIT(.maxnumberofropsinbatch)    0,
+    EO_INIT(.capacityofcompactexpansion) 0,
+    EO_INIT(.nvscfg)                    NULL,
+    EO_INIT(.confmanager)               NULL,
+    EO_INIT(.confmanmutex)              NULL
 };
 
 
@@ -108,10 +130,23 @@ extern EOreceiver* eo_receiver_New(const eo_receiver_cfg_t *cfg)
     retptr->ropreply            = eo_rop_New(cfg->capacityofropreply);
     retptr->nvscfg              = cfg->nvscfg;
     retptr->theagent            = eo_agent_Initialise(NULL);
+    retptr->confmanager         = cfg->confmanager;
+    retptr->confmanmutex        = cfg->confmanmutex;
     retptr->ipv4addr            = 0;
     retptr->ipv4port            = 0;
     retptr->bufferropframereply = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, cfg->capacityofropframereply, 1);
     retptr->rx_seqnum           = eok_uint64dummy;
+    retptr->batchcapacity       = cfg->maxnumberofropsinbatch;
+    retptr->batch               = (0 == cfg->maxnumberofropsinbatch) ? (NULL) : (eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(EOreceiverBATCHitem_t), cfg->maxnumberofropsinbatch));
+    retptr->prevtransitisvalid  = eobool_false;
+    retptr->jitterx16           = 0;
+    retptr->prevtransit         = 0;
+    retptr->stats               = &retptr->statsram;
+    memset(&retptr->statsram, 0, sizeof(eo_receiver_statistics_t));
+    retptr->capacityofexpansion = cfg->capacityofcompactexpansion;
+    retptr->bufferexpansion     = (0 == cfg->capacityofcompactexpansion) ? (NULL) : (eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, cfg->capacityofcompactexpansion, 1));
+    retptr->ropframeformat      = eo_ropframe_format_standard;
+    eo_ropframe_compact_Reset(&retptr->compactstate, 0);
     // now we need to allocate the buffer for the ropframereply
 
 #if defined(USE_DEBUG_EORECEIVER)    
@@ -127,18 +162,16 @@ extern EOreceiver* eo_receiver_New(const eo_receiver_cfg_t *cfg)
 
 extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, EOnvsCfg *nvscfg, uint16_t *numberofrops, eObool_t *thereisareply, eOabstime_t *transmittedtime)
 {
-    uint16_t rxremainingbytes = 0;
-    uint16_t txremainingbytes = 0;
     uint8_t* payload;
     uint16_t size;
     uint16_t capacity;
     uint16_t nrops;
-    uint16_t i;
-    eOresult_t res;
     EOnvsCfg *nvs2use = NULL;
     eOipv4addr_t remipv4addr;
     eOipv4port_t remipv4port;
     uint64_t rec_seqnum;
+    eOabstime_t arrival;
+    eOropframeFormat_t format;
 
     
     if((NULL == p) || (NULL == packet)) 
@@ -169,6 +202,8 @@ extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, EOnvsCfg
     // the remaddr can be any. however, if the eo_receiver_Process() is called by the EOtransceiver, it will be only the one of the remotehost
     eo_packet_Addressing_Get(packet, &remipv4addr, &remipv4port);
     
+    arrival = eov_sys_LifeTimeGet(eov_sys_GetHandle());
+    
    
     // then we assign them to the ones of the EOreceiver. by doing so we force the receive to accept packets from everyboby.
 
@@ -178,7 +213,28 @@ extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, EOnvsCfg
     // retrieve payload from the incoming packet and load the ropframe with it
     eo_packet_Payload_Get(packet, &payload, &size);
     eo_packet_Capacity_Get(packet, &capacity);
-    eo_ropframe_Load(p->ropframeinput, payload, size, capacity);
+    
+    if(eobool_true == eo_ropframe_compact_IsCompact(payload, size))
+    {   // the ropframe in compact format is expanded into the standard one. if it cannot be, the ropframeinput is unloaded so that it is invalid
+        format = eo_ropframe_format_compact;
+        if(NULL != p->bufferexpansion)
+        {
+            eo_ropframe_Load(p->ropframeinput, p->bufferexpansion, eo_ropframe_sizeforZEROrops, p->capacityofexpansion);
+            if(eores_OK != eo_ropframe_compact_Decode(&p->compactstate, payload, size, p->ropframeinput))
+            {
+                eo_ropframe_Unload(p->ropframeinput);
+            }
+        }
+        else
+        {
+            eo_ropframe_Unload(p->ropframeinput);
+        }
+    }
+    else
+    {
+        format = eo_ropframe_format_standard;
+        eo_ropframe_Load(p->ropframeinput, payload, size, capacity);
+    }
     
     // verify if the ropframeinput is valid w/ eo_ropframe_IsValid()
     if(eobool_false == eo_ropframe_IsValid(p->ropframeinput))
@@ -188,6 +244,7 @@ extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, EOnvsCfg
             p->debug.rxinvalidropframes ++;
         }
 #endif       
+        p->stats->invalid ++;
         if(NULL != thereisareply)
         {
             *thereisareply = eobool_false;
@@ -195,70 +252,26 @@ extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, EOnvsCfg
         return(eores_NOK_generic);
     }
     
-    //check sequence number
+    p->ropframeformat = format;
+    
+    //check sequence number and keep the statistics
     rec_seqnum = eo_ropframe_seqnum_Get(p->ropframeinput);
     
-    if(p->rx_seqnum == eok_uint64dummy)
-    {
-        //this is the first received ropframe or ... the sender uses dummy seqnum
-        p->rx_seqnum = rec_seqnum;
-    }
-    else
-    {
-        if(rec_seqnum != (p->rx_seqnum+1))
-        {
-#if defined(USE_DEBUG_EORECEIVER)             
-            {   // DEBUG
-                p->debug.errorsinsequencenumber ++;
-            }
-#endif            
-            eo_receiver_callback_incaseoferror_in_sequencenumberReceived(remipv4addr, rec_seqnum, p->rx_seqnum+1);
-        }
-        p->rx_seqnum = rec_seqnum;
-    }
+    s_eo_receiver_sequencenumber_check(p, rec_seqnum, remipv4addr);
+    s_eo_receiver_jitter_update(p, arrival, eo_ropframe_age_Get(p->ropframeinput));
+    
     // for every rop inside with eo_ropframe_ROP_NumberOf() :
     //nrops = eo_ropframe_ROP_NumberOf(p->ropframeinput);
     // i have already verified validity of p->ropframeinput, thus i can use the quickversion
     nrops = eo_ropframe_ROP_NumberOf_quickversion(p->ropframeinput);
     
-    for(i=0; i<nrops; i++)
+    if(NULL != p->batch)
     {
-        // - get teh rop w/ eo_ropframe_ROP_Parse()
-        
-        res = eo_ropframe_ROP_Parse(p->ropframeinput, p->ropinput, &rxremainingbytes);
-        
-        if(eores_OK != res)
-        {
-            break;
-        }        
-        
-        // - use the agent w/ eo_agent_InpROPprocess() and retrieve the ropreply. 
-        //   we need to tell the agent what nvs database we are using and from where the rop is coming 
-        
-        eo_agent_InpROPprocess(p->theagent, p->ropinput, nvs2use, remipv4addr, p->ropreply);
-        
-        // - if ropreply is ok w/ eo_rop_GetROPcode() then add it to ropframereply w/ eo_ropframe_ROP_Add()
-        
-        if(eo_ropcode_none != eo_rop_GetROPcode(p->ropreply))
-        {
-            res = eo_ropframe_ROP_Add(p->ropframereply, p->ropreply, NULL, NULL, &txremainingbytes);
-            
-#if defined(USE_DEBUG_EORECEIVER)             
-            {   // DEBUG
-                if(eores_OK != res)
-                {
-                    p->debug.lostreplies ++;
-                }
-            }
-#endif            
-        }
-        
-        // we keep on decoding eve if we cannot put a reply into the ropframe 
-        //if(0 == rxremainingbytes)
-        //{
-        //    break;
-        //}
-        
+        s_eo_receiver_process_batched(p, nrops, nvs2use, remipv4addr);
+    }
+    else
+    {
+        s_eo_receiver_process_onebyone(p, nrops, nvs2use, remipv4addr);
     }
 
     
@@ -310,6 +323,77 @@ extern eOresult_t eo_receiver_GetReply(EOreceiver *p, EOropframe **ropframereply
 }    
 
 
+extern eOresult_t eo_receiver_Statistics_Get(EOreceiver *p, eo_receiver_statistics_t *stats)
+{
+    if((NULL == p) || (NULL == stats)) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    memcpy(stats, p->stats, sizeof(eo_receiver_statistics_t));
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_receiver_Statistics_Reset(EOreceiver *p)
+{
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    memset(p->stats, 0, sizeof(eo_receiver_statistics_t));
+    p->jitterx16            = 0;
+    p->prevtransitisvalid   = eobool_false;
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_receiver_Statistics_Bind(EOreceiver *p, void *ram, uint16_t capacity)
+{
+    eo_receiver_statistics_t *newstats = NULL;
+    
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(NULL == ram)
+    {   // go back to the internal ram
+        newstats = &p->statsram;
+    }
+    else if(capacity < sizeof(eo_receiver_statistics_t))
+    {
+        return(eores_NOK_generic);
+    }
+    else
+    {
+        newstats = (eo_receiver_statistics_t*)ram;
+    }
+    
+    if(newstats != p->stats)
+    {
+        memcpy(newstats, p->stats, sizeof(eo_receiver_statistics_t));
+        p->stats = newstats;
+    }
+    
+    return(eores_OK);
+}
+
+
+extern eOropframeFormat_t eo_receiver_ropframeformat_Get(EOreceiver *p)
+{
+    if(NULL == p)
+    {
+        return(eo_ropframe_format_standard);
+    }
+    
+    return(p->ropframeformat);
+}
+
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern hidden functions 
@@ -323,6 +407,373 @@ extern eOresult_t eo_receiver_GetReply(EOreceiver *p, EOropframe **ropframereply
 // - definition of static functions 
 // --------------------------------------------------------------------------------------------------------------------
 
+static void s_eo_receiver_addreply(EOreceiver *p)
+{
+    uint16_t txremainingbytes = 0;
+    eOresult_t res;
+
+    // - if ropreply is ok w/ eo_rop_GetROPcode() then add it to ropframereply w/ eo_ropframe_ROP_Add()
+    
+    if(eo_ropcode_none != eo_rop_GetROPcode(p->ropreply))
+    {
+        res = eo_ropframe_ROP_Add(p->ropframereply, p->ropreply, NULL, NULL, &txremainingbytes);
+        res = res;
+        
+#if defined(USE_DEBUG_EORECEIVER)             
+        {   // DEBUG
+            if(eores_OK != res)
+            {
+                p->debug.lostreplies ++;
+            }
+        }
+#endif            
+    }
+}
+
+
+static void s_eo_receiver_sequencenumber_check(EOreceiver *p, uint64_t rec_seqnum, eOipv4addr_t remipv4addr)
+{
+    eo_receiver_statistics_t *stats = p->stats;
+    uint64_t expected_seqnum;
+    uint64_t distance;
+    
+    stats->received ++;
+    
+    if(p->rx_seqnum == eok_uint64dummy)
+    {
+        //this is the first received ropframe or ... the sender uses dummy seqnum
+        p->rx_seqnum = rec_seqnum;
+        return;
+    }
+    
+    expected_seqnum = p->rx_seqnum + 1;
+    
+    if(rec_seqnum == expected_seqnum)
+    {   // the normal case
+        p->rx_seqnum = rec_seqnum;
+        return;
+    }
+
+#if defined(USE_DEBUG_EORECEIVER)             
+    {   // DEBUG
+        p->debug.errorsinsequencenumber ++;
+    }
+#endif            
+    eo_receiver_callback_incaseoferror_in_sequencenumberReceived(remipv4addr, rec_seqnum, expected_seqnum);
+    
+    if(rec_seqnum > expected_seqnum)
+    {   // a gap: the ropframes in between are lost
+        s_eo_receiver_lossburst_add(stats, rec_seqnum - expected_seqnum);
+        p->rx_seqnum = rec_seqnum;
+        return;
+    }
+    
+    // the sequence number went backwards. we keep rx_seqnum so that a late ropframe does not count as another gap 
+    distance = p->rx_seqnum - rec_seqnum;
+    
+    if(0 == distance)
+    {
+        stats->duplicated ++;
+    }
+    else if(distance <= EORECEIVER_SEQNUM_REORDERWINDOW)
+    {
+        stats->outoforder ++;
+    }
+    else
+    {   // the remote host has restarted its sequence 
+        if(EOK_uint16dummy != stats->resyncs)
+        {
+            stats->resyncs ++;
+        }
+        p->rx_seqnum = rec_seqnum;
+    }
+}
+
+
+static void s_eo_receiver_lossburst_add(eo_receiver_statistics_t *stats, uint64_t lost)
+{
+    uint64_t n = lost - 1;
+    uint8_t bin = 0;
+    
+    // bin 0 is for 1 lost ropframe, bin 1 for 2, bin 2 for 3-4, ... bin 7 for 65 and more
+    while((0 != n) && (bin < (eo_receiver_lossbursts_numberof-1)))
+    {
+        n >>= 1;
+        bin ++;
+    }
+    
+    stats->lossbursts[bin] ++;
+    stats->lost += (lost > EOK_uint32dummy) ? (EOK_uint32dummy) : ((uint32_t)lost);
+    
+    if(lost > stats->longestburst)
+    {
+        stats->longestburst = (lost > EOK_uint16dummy) ? (EOK_uint16dummy) : ((uint16_t)lost);
+    }
+}
+
+
+static void s_eo_receiver_jitter_update(EOreceiver *p, eOabstime_t arrival, eOabstime_t age)
+{
+    int64_t transit = (int64_t)(arrival - age);
+    int64_t d;
+    uint32_t ad;
+    
+    if(eobool_false == p->prevtransitisvalid)
+    {
+        p->prevtransit          = transit;
+        p->prevtransitisvalid   = eobool_true;
+        return;
+    }
+    
+    d = transit - p->prevtransit;
+    p->prevtransit = transit;
+    
+    if(d < 0)
+    {
+        d = -d;
+    }
+    // clip so that the scaled jitter never overflows
+    ad = (d > 0x0fffffff) ? (0x0fffffff) : ((uint32_t)d);
+    
+    // J = J + (|D| - J)/16, as in RFC 3550 sec A.8
+    p->jitterx16 += ad - ((p->jitterx16 + 8) >> 4);
+    
+    p->stats->jitter = p->jitterx16 >> 4;
+    if(p->stats->jitter > p->stats->jittermax)
+    {
+        p->stats->jittermax = p->stats->jitter;
+    }
+}
+
+
+static void s_eo_receiver_process_onebyone(EOreceiver *p, uint16_t nrops, EOnvsCfg *nvscfg, eOipv4addr_t remipv4addr)
+{
+    uint16_t rxremainingbytes = 0;
+    uint16_t i;
+    eOresult_t res;
+
+    for(i=0; i<nrops; i++)
+    {
+        // - get teh rop w/ eo_ropframe_ROP_Parse()
+        
+        res = eo_ropframe_ROP_Parse(p->ropframeinput, p->ropinput, &rxremainingbytes);
+        
+        if(eores_OK != res)
+        {
+            break;
+        }        
+        
+        s_eo_receiver_confirmation_check(p, remipv4addr);
+        
+        // - use the agent w/ eo_agent_InpROPprocess() and retrieve the ropreply. 
+        //   we need to tell the agent what nvs database we are using and from where the rop is coming 
+        
+        eo_agent_InpROPprocess(p->theagent, p->ropinput, nvscfg, remipv4addr, p->ropreply);
+        
+        // we keep on decoding eve if we cannot put a reply into the ropframe 
+        s_eo_receiver_addreply(p);
+    }
+}
+
+
+static void s_eo_receiver_process_batched(EOreceiver *p, uint16_t nrops, EOnvsCfg *nvscfg, eOipv4addr_t remipv4addr)
+{
+    uint16_t done = 0;
+    uint16_t n = 0;
+    uint16_t i = 0;
+    uint16_t k = 0;
+
+    while(done < nrops)
+    {
+        // 1. decode the heads of the next rops w/out copying them
+        n = s_eo_receiver_batch_decodeheads(p, nrops - done);
+
+        if(0 == n)
+        {   // the next rop does not go in a batch: it goes through the agent as usual. if it is not complete the parser
+            // detects it and stops
+            if(eores_OK != eo_ropframe_ROP_Parse(p->ropframeinput, p->ropinput, NULL))
+            {
+                return;
+            }
+            s_eo_receiver_confirmation_check(p, remipv4addr);
+            eo_agent_InpROPprocess(p->theagent, p->ropinput, nvscfg, remipv4addr, p->ropreply);
+            s_eo_receiver_addreply(p);
+            done ++;
+            continue;
+        }
+
+        // 2. process in order the runs of consecutive rops on the same endpoint
+        for(i=0; i<n; i=k)
+        {
+            k = i + 1;
+
+            while((k < n) && (p->batch[k].endp == p->batch[i].endp) && (p->batch[k].ownership == p->batch[i].ownership))
+            {
+                k++;
+            }
+
+            if(eores_OK != s_eo_receiver_batch_processrun(p, &p->batch[i], k - i, nvscfg, remipv4addr))
+            {
+                return;
+            }
+        }
+
+        done += n;
+    }
+}
+
+
+static uint16_t s_eo_receiver_batch_decodeheads(EOreceiver *p, uint16_t maxrops)
+{
+    uint8_t *rops = eo_ropframe_hid_get_pointer_offset(p->ropframeinput, 0);
+    uint16_t sizeofrops = p->ropframeinput->headropsfooter->header.ropssizeof;
+    uint16_t position = p->ropframeinput->index2nextrop2beparsed;
+    eOrophead_t *head = NULL;
+    eOropconfig_t ropcfg;
+    uint16_t size = 0;
+    uint16_t n = 0;
+
+    if(maxrops > p->batchcapacity)
+    {
+        maxrops = p->batchcapacity;
+    }
+
+    for(n=0; n<maxrops; n++)
+    {
+        if((position + sizeof(eOrophead_t)) > sizeofrops)
+        {
+            break;
+        }
+
+        head = (eOrophead_t*) &rops[position];
+
+        // the confirmations and the invalid rops end the batch and go through eo_agent_InpROPprocess(), which rejects
+        // the latter. so does a rop with a data field which its ropcode does not have (or vice versa), as its size is
+        // not the one given by eo_rop_ComputeSize().
+        if((eo_ropconf_none != head->ctrl.confinfo) || (eo_ropcode_none == head->ropc) || (eo_ropcode_usr == head->ropc) ||
+           (eo_rop_hid_DataField_is_Present(head) != eo_rop_hid_DataField_is_Required(head)))
+        {
+            break;
+        }
+
+        ropcfg.confrqst = (1 == head->ctrl.rqstconf) ? (eobool_true) : (eobool_false);
+        ropcfg.timerqst = (1 == head->ctrl.rqsttime) ? (eobool_true) : (eobool_false);
+        ropcfg.plussign = (1 == head->ctrl.plussign) ? (eobool_true) : (eobool_false);
+        ropcfg.plustime = (1 == head->ctrl.plustime) ? (eobool_true) : (eobool_false);
+        size = eo_rop_ComputeSize(ropcfg, (eOropcode_t)head->ropc, head->dsiz);
+
+        if((position + size) > sizeofrops)
+        {
+            break;
+        }
+
+        p->batch[n].endp        = head->endp;
+        p->batch[n].nvid        = head->nvid;
+        p->batch[n].onidindex   = EOK_uint16dummy;
+        p->batch[n].ownership   = (uint8_t) eo_rop_hid_GetOwnership((eOropcode_t)head->ropc, eo_ropconf_none, eo_rop_dir_received);
+
+        position += size;
+    }
+
+    return(n);
+}
+
+
+static eOresult_t s_eo_receiver_batch_processrun(EOreceiver *p, EOreceiverBATCHitem_t *items, uint16_t nitems, EOnvsCfg *nvscfg, eOipv4addr_t remipv4addr)
+{
+    uint16_t ondevindex = EOK_uint16dummy;
+    uint16_t onendpointindex = EOK_uint16dummy;
+    uint16_t onidindex = EOK_uint16dummy;
+    EOVmutexDerived *mtx = NULL;
+    eObool_t locked = eobool_false;
+    eObool_t isleaf = eobool_true;
+    eOresult_t res = eores_OK;
+    uint16_t j;
+
+    // the device and the endpoint are the same for the whole run: they are searched only once, with the first rop.
+    eo_nvscfg_GetIndices(nvscfg, (eo_nv_ownership_local == items[0].ownership) ? (eok_ipv4addr_localhost) : (remipv4addr),
+                         items[0].endp, items[0].nvid, &ondevindex, &onendpointindex, &onidindex);
+
+    if((EOK_uint16dummy != ondevindex) && (EOK_uint16dummy != onendpointindex))
+    {
+        items[0].onidindex = onidindex;
+        for(j=1; j<nitems; j++)
+        {
+            items[j].onidindex = eo_nvscfg_hid_ondevice_onendpoint_id2index(nvscfg, ondevindex, onendpointindex, items[j].nvid);
+        }
+
+        // if a single mutex protects all the nvs of the endpoint, the run takes it once
+        if(eores_OK != eo_nvscfg_hid_ondevice_onendpoint_GetMutex(nvscfg, ondevindex, onendpointindex, &mtx))
+        {
+            mtx = NULL;
+        }
+    }
+
+    for(j=0; j<nitems; j++)
+    {
+        res = eo_ropframe_ROP_Parse(p->ropframeinput, p->ropinput, NULL);
+
+        if(eores_OK != res)
+        {
+            break;
+        }
+
+        s_eo_receiver_confirmation_check(p, remipv4addr);
+
+        if(NULL != mtx)
+        {   // a non-leaf nv reaches its leaves with eo_nvscfg_GetNV() and sets them with their own mutex, which is the
+            // mutex of the run. as the mutexes are not recursive, it is processed with the mutex released.
+            isleaf = (EOK_uint16dummy == items[j].onidindex) ? (eobool_true) : 
+                     eo_treenode_isLeaf(eo_nvscfg_GetTreeNode(nvscfg, ondevindex, onendpointindex, items[j].onidindex));
+
+            if((eobool_true == isleaf) && (eobool_false == locked))
+            {
+                eov_mutex_Take(mtx, eok_reltimeINFINITE);
+                locked = eobool_true;
+            }
+            else if((eobool_false == isleaf) && (eobool_true == locked))
+            {
+                eov_mutex_Release(mtx);
+                locked = eobool_false;
+            }
+        }
+
+        eo_agent_hid_InpROPprocessOnIndices(p->theagent, p->ropinput, nvscfg, ondevindex, onendpointindex, items[j].onidindex, locked, p->ropreply);
+
+        s_eo_receiver_addreply(p);
+    }
+
+    if(eobool_true == locked)
+    {
+        eov_mutex_Release(mtx);
+    }
+
+    return(res);
+}
+
+
+// the acks and naks close the outstanding requests, and so does the say<> which replies to an ask<>
+static void s_eo_receiver_confirmation_check(EOreceiver *p, eOipv4addr_t remipv4addr)
+{
+    if(NULL == p->confmanager)
+    {
+        return;
+    }
+
+    if((eo_ropconf_none != p->ropinput->stream.head.ctrl.confinfo) || (eo_ropcode_say == p->ropinput->stream.head.ropc))
+    {   // the transceiver uses the confmanager also from the task which transmits and from the user
+        if(NULL != p->confmanmutex)
+        {
+            eov_mutex_Take(p->confmanmutex, eok_reltimeINFINITE);
+        }
+        eo_confman_Confirmation_Received(p->confmanager, p->ropinput, remipv4addr);
+        if(NULL != p->confmanmutex)
+        {
+            eov_mutex_Release(p->confmanmutex);
+        }
+    }
+}
+
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -44,6 +44,7 @@ extern "C" {
 #include "EOropframe.h"
 #include "EOpacket.h"
 #include "EOnvsCfg.h"
+#include "EOconfirmationManager.h"
 
 
 
@@ -69,14 +70,41 @@ typedef struct
     uint16_t        capacityofropframereply; // or of packetreply in case we want to use a apcket whcih also has ipaddr and port  
     uint16_t        capacityofropinput;
     uint16_t        capacityofropreply;
+    uint16_t        maxnumberofropsinbatch;     // if not zero, the rops are processed in batches of consecutive rops on the same endpoint. default is 0
+    uint16_t        capacityofcompactexpansion; // if not zero, the ropframes in compact format are expanded in a buffer of this size, else they are invalid
     EOnvsCfg*       nvscfg;
+    EOconfirmationManager* confmanager;     // if not NULL, it is given the confirmations and the say<> received
+    EOVmutexDerived*       confmanmutex;    // if not NULL, it is taken around every call of the confmanager
 } eo_receiver_cfg_t;
 
 
+enum { eo_receiver_lossbursts_numberof = 8 };
+
+/** @typedef    typedef struct eo_receiver_statistics_t
+    @brief      Contains the statistics of reception of the ropframes coming from the remote host. They are always kept
+                by the receiver. The lossbursts[] is a histogram of the number of consecutive ropframes lost in a single gap
+                of the sequence number, with bins of length 1, 2, 3-4, 5-8, 9-16, 17-32, 33-64, 65+. The jitter is the 
+                interarrival jitter as in RFC 3550, computed with the age of the ropframe and the local lifetime.
+ **/
+typedef struct                  // size is 7*4+2*2+8*4 = 64 bytes
+{
+    uint32_t        received;       /**< the valid ropframes */
+    uint32_t        lost;           /**< the ropframes missing in the sequence when a successive one arrives */
+    uint32_t        duplicated;     /**< the ropframes with the same sequence number of the last one */
+    uint32_t        outoforder;     /**< the ropframes arrived after a successive one. they are also counted in lost */
+    uint32_t        invalid;        /**< the ropframes discarded because not valid */
+    uint32_t        jitter;         /**< the interarrival jitter in microseconds */
+    uint32_t        jittermax;      /**< the highest value reached by jitter */
+    uint16_t        longestburst;   /**< the highest number of ropframes lost in a single gap */
+    uint16_t        resyncs;        /**< the times the sequence number jumped backwards too much, as when the remote host restarts */
+    uint32_t        lossbursts[eo_receiver_lossbursts_numberof];
+} eo_receiver_statistics_t;     EO_VERIFYsizeof(eo_receiver_statistics_t, 64);
+
+
     
 // - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
 
-extern const eo_receiver_cfg_t eo_receiver_cfg_default; //= {256, 128, 128, NULL};
+extern const eo_receiver_cfg_t eo_receiver_cfg_default; //= {256, 128, 128, 16, 0, NULL};
 
 
 // - declaration of extern public functions ---------------------------------------------------------------------------
@@ -95,6 +123,11 @@ extern EOreceiver* eo_receiver_New(const eo_receiver_cfg_t *cfg);
                 the ropframe contained inside the packet (if valid). For each ROP it searches the NV(endpoint, id) if local operation
                 or the NV(remoteip, endpoint, id) if remote operation and if found it processes it.
                 If there are any reply ROPs it sets the return boolean.   
+                If the receiver was created with a non-zero maxnumberofropsinbatch, the heads of the ROPs are decoded
+                in advance and the device and endpoint of every group of consecutive ROPs on the same endpoint are resolved
+                only once. If a single mutex protects all the NVs of the endpoint, it is also taken only once for the leaf
+                NVs of the group, thus their callbacks must not operate with the EOnv functions on other NVs protected
+                by the same mutex. The ROPs are always processed in the order they have in the ropframe.
     @param      p               the object.
     @param      packet          teh received packet
     @param      nvscfg          if not NULL it is the NVs configuration to use, else it is used teh one passed to teh eo_receiver_New() method.
@@ -116,6 +149,42 @@ extern eOresult_t eo_receiver_Process(EOreceiver *p, EOpacket *packet, EOnvsCfg
 extern eOresult_t eo_receiver_GetReply(EOreceiver *p, EOropframe **ropframereply);
 
 
+/** @fn         extern eOresult_t eo_receiver_Statistics_Get(EOreceiver *p, eo_receiver_statistics_t *stats)
+    @brief      copies the statistics of reception.
+    @param      p               the object.
+    @param      stats           the destination.
+    @return     eores_OK or eores_NOK_nullpointer.
+ **/
+extern eOresult_t eo_receiver_Statistics_Get(EOreceiver *p, eo_receiver_statistics_t *stats);
+
+
+/** @fn         extern eOresult_t eo_receiver_Statistics_Reset(EOreceiver *p)
+    @brief      sets to zero the statistics of reception.
+    @param      p               the object.
+    @return     eores_OK or eores_NOK_nullpointer.
+ **/
+extern eOresult_t eo_receiver_Statistics_Reset(EOreceiver *p);
+
+
+/** @fn         extern eOresult_t eo_receiver_Statistics_Bind(EOreceiver *p, void *ram, uint16_t capacity)
+    @brief      tells the receiver to keep its statistics inside an external ram, typically the ram of a network variable,
+                so that they can be read without any copy. The current values are copied into the ram.
+    @param      p               the object.
+    @param      ram             the external ram. if NULL, the receiver goes back to its internal ram.
+    @param      capacity        the size of ram. it must be at least sizeof(eo_receiver_statistics_t).
+    @return     eores_OK, eores_NOK_nullpointer or eores_NOK_generic if capacity is too small.
+ **/
+extern eOresult_t eo_receiver_Statistics_Bind(EOreceiver *p, void *ram, uint16_t capacity);
+
+
+/** @fn         extern eOropframeFormat_t eo_receiver_ropframeformat_Get(EOreceiver *p)
+    @brief      tells the format of the last valid ropframe received, so that the transmission can use the same one.
+    @param      p               the receiver
+    @return     eo_ropframe_format_compact or eo_ropframe_format_standard (also if no valid ropframe was received yet).
+ **/
+extern eOropframeFormat_t eo_receiver_ropframeformat_Get(EOreceiver *p);
+
+
 /** @}            
     end of group eo_receiver  
  **/
@@ -59,6 +59,15 @@ typedef struct
     uint32_t    lostreplies;
 } EOreceiverDEBUG_t;
 
+typedef struct
+{
+    eOnvEP_t    endp;
+    eOnvID_t    nvid;
+    uint16_t    onidindex;      // the index of the nv inside its endpoint. it is EOK_uint16dummy if the nv is not found
+    uint8_t     ownership;      // use eOnvOwnership_t
+    uint8_t     filler[1];
+} EOreceiverBATCHitem_t;
+
 /** @struct     EOreceiver_hid
     @brief      Hidden definition. Implements private data used only internally by the 
                 public or private (static) functions of the object and protected data
@@ -74,10 +83,23 @@ struct EOreceiver_hid
     EOrop*                      ropreply;
     EOnvsCfg*                   nvscfg;
     EOtheAgent*                 theagent;
+    EOconfirmationManager*      confmanager;
+    EOVmutexDerived*            confmanmutex;
     eOipv4addr_t                ipv4addr;
     eOipv4port_t                ipv4port;
     uint8_t*                    bufferropframereply;
     uint64_t                    rx_seqnum;
+    EOreceiverBATCHitem_t*      batch;
+    uint16_t                    batchcapacity;
+    eObool_t                    prevtransitisvalid;
+    uint32_t                    jitterx16;          // the jitter in usec scaled by 16 as in RFC 3550
+    int64_t                     prevtransit;        // lifetime of arrival minus age of the previous ropframe
+    eo_receiver_statistics_t*   stats;              // it points to statsram or to the ram passed with eo_receiver_Statistics_Bind()
+    eo_receiver_statistics_t    statsram;
+    uint8_t*                    bufferexpansion;    // where a ropframe in compact format is expanded. NULL if they are not accepted
+    uint16_t                    capacityofexpansion;
+    eOropframeFormat_t          ropframeformat;     // the format of the last valid ropframe
+    eOropframeCompactState_t    compactstate;
 #if defined(USE_DEBUG_EORECEIVER)      
     EOreceiverDEBUG_t           debug;
 #endif    
@@ -71,6 +71,7 @@ const eOropconfiguration_t eok_ropconfiguration_basic =
     EO_INIT(.plussign)      0,
     EO_INIT(.plustime)      0,
     EO_INIT(.confirm)       eo_ropconf_none,
+    EO_INIT(.onchange)      0,
     EO_INIT(.notused)       0
 };
 
@@ -359,6 +360,28 @@ extern eObool_t eo_rop_hid_DataField_is_Required(const eOrophead_t *head)
     return(ret);
 }
 
+extern uint16_t eo_rop_hid_Stream_Size(const eOrophead_t *head)
+{
+    uint16_t size = sizeof(eOrophead_t);
+
+    if(eobool_true == eo_rop_hid_DataField_is_Present(head))
+    {
+        size += eo_rop_hid_DataField_EffectiveSize(head->dsiz);
+    }
+
+    if(1 == head->ctrl.plussign)
+    {
+        size += 4;
+    }
+
+    if(1 == head->ctrl.plustime)
+    {
+        size += 8;
+    }
+
+    return(size);
+}
+
 // normal commands
 // a simple node who only knows about its own netvars must use eo_nv_ownership_local
 // when receives ask<>, set<>, rst<>, upd<>.
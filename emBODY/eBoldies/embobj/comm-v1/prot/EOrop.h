@@ -135,7 +135,8 @@ typedef struct
     uint8_t         plussign    :1;
     uint8_t         plustime    :1;
     uint8_t         confirm     :2;
-    uint8_t         notused     :2;
+    uint8_t         onchange    :1;     // used only by regular rops with data: the rop is transmitted only if its value has changed
+    uint8_t         notused     :1;
 } eOropconfiguration_t;
 
 typedef struct      // 16 bytes
@@ -132,6 +132,9 @@ extern eObool_t eo_rop_hid_DataField_is_Present(const eOrophead_t *head);
 
 extern eObool_t eo_rop_hid_DataField_is_Required(const eOrophead_t *head);
 
+// it returns the number of bytes of a rop stream which begins with head: head + data + sign + time
+extern uint16_t eo_rop_hid_Stream_Size(const eOrophead_t *head);
+
 EO_extern_inline uint16_t eo_rop_hid_DataField_EffectiveSize(uint16_t ropdatasize)
 {
     return(((ropdatasize + 3) >> 2) << 2);
@@ -26,6 +26,7 @@
 #include "EOtheMemoryPool.h"
 #include "EOtheParser.h"
 #include "EOtheFormer.h"
+#include "EOrop_hid.h"
 
 
 
@@ -101,6 +102,7 @@ static void s_eo_ropframe_header_remrop(EOropframe *p, uint16_t sizeofrop);
 static void s_eo_ropframe_header_addrops(EOropframe *p, uint16_t numofrops, uint16_t sizeofrops);
 static void s_eo_ropframe_header_clr(EOropframe *p);
 static void s_eo_ropframe_footer_adjust(EOropframe *p);
+static uint16_t s_eo_ropframe_compact_overhead(uint8_t flags);
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -555,6 +557,281 @@ extern uint64_t eo_ropframe_seqnum_Get(EOropframe *p)
     return(header->sequencenumber);
 }
 
+
+extern void eo_ropframe_compact_Reset(eOropframeCompactState_t *state, uint16_t keyperiod)
+{
+    if(NULL == state)
+    {
+        return;
+    }
+    
+    state->lastage          = 0;
+    state->lastseqnum       = 0;
+    state->keyperiod        = keyperiod;
+    state->tillnextkey      = 0;
+    state->synchronised     = eobool_false;
+}
+
+
+extern eObool_t eo_ropframe_compact_IsCompact(const uint8_t *framedata, uint16_t framesize)
+{
+    uint16_t startofframe = 0;
+    
+    if((NULL == framedata) || (framesize < sizeof(EOropframeCompactHeader_t)))
+    {
+        return(eobool_false);
+    }
+    
+    memcpy(&startofframe, framedata, 2);
+    
+    return((EOFRAME_COMPACT_START == startofframe) ? (eobool_true) : (eobool_false));
+}
+
+
+extern eOresult_t eo_ropframe_compact_Encode(EOropframe *p, eOropframeCompactState_t *state, uint8_t *dest, uint16_t capacity, uint16_t *framesize)
+{
+    EOropframeHeader_t header;
+    EOropframeCompactHeader_t compactheader;
+    eOrophead_t *rophead = NULL;
+    uint8_t *frame = NULL;
+    uint8_t *rops = NULL;
+    eOnvEP_t ep = EOK_uint16dummy;
+    eObool_t implicitep = eobool_true;
+    uint8_t flags = 0;
+    uint16_t i = 0;
+    uint16_t r = 0;
+    uint16_t w = 0;
+    uint16_t consumedbytes = 0;
+    uint16_t compactsize = 0;
+    uint32_t age32 = 0;
+    uint16_t seqnum16 = 0;
+    
+    if((NULL == p) || (NULL == state) || (NULL == dest) || (NULL == framesize))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(eobool_false == eo_ropframe_IsValid(p))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    memcpy(&header, s_eo_ropframe_header_get(p), sizeof(EOropframeHeader_t));
+    
+    // the compact ropframe is never larger than the standard one, thus this check is enough for the writes below
+    if((header.ropsnumberof > 255) || (capacity < (eo_ropframe_sizeforZEROrops + header.ropssizeof)))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    // first pass: verify the rops and see if they all have the same endpoint. nothing is changed yet.
+    rops = s_eo_ropframe_rops_get(p);
+    
+    for(i=0; i<header.ropsnumberof; i++)
+    {
+        if((header.ropssizeof - r) < sizeof(eOrophead_t))
+        {
+            return(eores_NOK_generic);
+        }
+        
+        rophead = (eOrophead_t*) &rops[r];
+        
+        if(rophead->dsiz > 0x7fff)
+        {
+            return(eores_NOK_generic);
+        }
+        
+        if(0 == i)
+        {
+            ep = rophead->endp;
+        }
+        else if(ep != rophead->endp)
+        {
+            implicitep = eobool_false;
+        }
+        
+        r += eo_rop_hid_Stream_Size(rophead);
+        
+        if(r > header.ropssizeof)
+        {
+            return(eores_NOK_generic);
+        }
+    }
+    
+    if(r != header.ropssizeof)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    if(0 == header.ropsnumberof)
+    {
+        implicitep = eobool_false;
+    }
+    
+    // the flags
+    if(0 == state->tillnextkey)
+    {
+        flags |= EOFRAME_COMPACT_FLAG_KEY;
+        state->tillnextkey = (0 == state->keyperiod) ? (0) : (state->keyperiod - 1);
+    }
+    else
+    {
+        state->tillnextkey--;
+    }
+    
+    if(eobool_true == implicitep)
+    {
+        flags |= EOFRAME_COMPACT_FLAG_IMPLICITEP;
+    }
+    
+    // second pass: the compact ropframe is written into dest, so that the ropframe is still valid after the encoding.
+    frame = dest;
+    w = sizeof(EOropframeCompactHeader_t);
+    
+    if(0 != (flags & EOFRAME_COMPACT_FLAG_KEY))
+    {
+        memcpy(&frame[w], &header.ageofframe, 8);
+        w += 8;
+        memcpy(&frame[w], &header.sequencenumber, 8);
+        w += 8;
+    }
+    else
+    {
+        age32 = (uint32_t) header.ageofframe;
+        memcpy(&frame[w], &age32, 4);
+        w += 4;
+        seqnum16 = (uint16_t) header.sequencenumber;
+        memcpy(&frame[w], &seqnum16, 2);
+        w += 2;
+    }
+    
+    if(eobool_true == implicitep)
+    {
+        memcpy(&frame[w], &ep, 2);
+        w += 2;
+    }
+    
+    r = 0;
+    for(i=0; i<header.ropsnumberof; i++)
+    {
+        if(eores_OK != eo_former_GetCompactStream(eo_former_GetHandle(), &rops[r], header.ropssizeof - r, implicitep, header.ageofframe, &frame[w], &consumedbytes, &compactsize))
+        {   // cannot happen after the first pass
+            return(eores_NOK_generic);
+        }
+        r += consumedbytes;
+        w += compactsize;
+    }
+    
+    compactheader.startofframe  = EOFRAME_COMPACT_START;
+    compactheader.flags         = flags;
+    compactheader.ropsnumberof  = (uint8_t) header.ropsnumberof;
+    compactheader.ropssizeof    = w - s_eo_ropframe_compact_overhead(flags);
+    memcpy(&frame[0], &compactheader, sizeof(EOropframeCompactHeader_t));
+    
+    *framesize = w;
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_ropframe_compact_Decode(eOropframeCompactState_t *state, const uint8_t *framedata, uint16_t framesize, EOropframe *target)
+{
+    EOropframeCompactHeader_t compactheader;
+    uint8_t *rops = NULL;
+    eObool_t implicitep = eobool_false;
+    eOnvEP_t ep = 0;
+    uint64_t age = 0;
+    uint64_t seqnum = 0;
+    uint32_t age32 = 0;
+    uint16_t seqnum16 = 0;
+    uint16_t i = 0;
+    uint16_t n = 0;
+    uint16_t w = 0;
+    uint16_t capacityofrops = 0;
+    uint16_t consumedbytes = 0;
+    uint16_t streamsize = 0;
+    
+    if((NULL == state) || (NULL == framedata) || (NULL == target) || (NULL == target->headropsfooter))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if((eobool_false == eo_ropframe_compact_IsCompact(framedata, framesize)) || (target->capacity < eo_ropframe_sizeforZEROrops))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    memcpy(&compactheader, framedata, sizeof(EOropframeCompactHeader_t));
+    n = sizeof(EOropframeCompactHeader_t);
+    
+    if((0 != (compactheader.flags & ~EOFRAME_COMPACT_FLAGS_ALL)) || (framesize != (s_eo_ropframe_compact_overhead(compactheader.flags) + compactheader.ropssizeof)))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    // age and sequence number. the ones of a non-key ropframe are the closest values to those of the previous ropframe
+    if(0 != (compactheader.flags & EOFRAME_COMPACT_FLAG_KEY))
+    {
+        memcpy(&age, &framedata[n], 8);
+        n += 8;
+        memcpy(&seqnum, &framedata[n], 8);
+        n += 8;
+    }
+    else
+    {
+        if(eobool_false == state->synchronised)
+        {
+            return(eores_NOK_generic);
+        }
+        
+        memcpy(&age32, &framedata[n], 4);
+        n += 4;
+        age = state->lastage + (int32_t)(age32 - (uint32_t)state->lastage);
+        
+        memcpy(&seqnum16, &framedata[n], 2);
+        n += 2;
+        seqnum = state->lastseqnum + (int16_t)(seqnum16 - (uint16_t)state->lastseqnum);
+    }
+    
+    if(0 != (compactheader.flags & EOFRAME_COMPACT_FLAG_IMPLICITEP))
+    {
+        memcpy(&ep, &framedata[n], 2);
+        n += 2;
+        implicitep = eobool_true;
+    }
+    
+    // the rops
+    eo_ropframe_Clear(target);
+    rops = s_eo_ropframe_rops_get(target);
+    capacityofrops = target->capacity - eo_ropframe_sizeforZEROrops;
+    
+    for(i=0; i<compactheader.ropsnumberof; i++)
+    {
+        if(eores_OK != eo_parser_GetStreamFromCompact(eo_parser_GetHandle(), &framedata[n], framesize - n, implicitep, ep, age, &rops[w], capacityofrops - w, &consumedbytes, &streamsize))
+        {
+            eo_ropframe_Clear(target);
+            return(eores_NOK_generic);
+        }
+        n += consumedbytes;
+        w += streamsize;
+    }
+    
+    if((n != framesize) || (eores_OK != eo_ropframe_hid_rops_Set(target, compactheader.ropsnumberof, w)))
+    {
+        eo_ropframe_Clear(target);
+        return(eores_NOK_generic);
+    }
+    
+    eo_ropframe_age_Set(target, age);
+    eo_ropframe_seqnum_Set(target, seqnum);
+    
+    state->lastage          = age;
+    state->lastseqnum       = seqnum;
+    state->synchronised     = eobool_true;
+    
+    return(eores_OK);
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern hidden functions 
 // --------------------------------------------------------------------------------------------------------------------
@@ -569,6 +846,64 @@ uint8_t* eo_ropframe_hid_get_pointer_offset(EOropframe *p, uint16_t offset)
     return(s_eo_ropframe_rops_get(p) + offset);
 }
 
+eOresult_t eo_ropframe_hid_rops_Set(EOropframe *p, uint16_t numberofrops, uint16_t sizeofrops)
+{
+    EOropframeHeader_t* header = NULL;
+
+    if((NULL == p) || (NULL == p->headropsfooter))
+    {
+        return(eores_NOK_nullpointer);
+    }
+
+    if(p->capacity < (eo_ropframe_sizeforZEROrops+sizeofrops))
+    {
+        return(eores_NOK_generic);
+    }
+
+    header = s_eo_ropframe_header_get(p);
+
+    header->ropssizeof              = sizeofrops;
+    header->ropsnumberof            = numberofrops;
+
+    p->size                         = eo_ropframe_sizeforZEROrops + sizeofrops;
+
+    s_eo_ropframe_footer_adjust(p);
+
+    return(eores_OK);
+}
+
+eOresult_t eo_ropframe_hid_rops_Append(EOropframe *p, const uint8_t *rops, uint16_t numberofrops, uint16_t sizeofrops)
+{
+    uint16_t p_sizeofrops;
+    
+    if((NULL == p) || (NULL == p->headropsfooter) || (NULL == rops))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(0 == sizeofrops)
+    {
+        return(eores_OK);
+    }
+    
+    p_sizeofrops = s_eo_ropframe_sizeofrops_get(p);
+    
+    if(p->capacity < (eo_ropframe_sizeforZEROrops+p_sizeofrops+sizeofrops))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    memcpy(s_eo_ropframe_rops_get(p)+p_sizeofrops, rops, sizeofrops);
+    
+    p->size  += sizeofrops;
+    
+    s_eo_ropframe_header_addrops(p, numberofrops, sizeofrops);
+    
+    s_eo_ropframe_footer_adjust(p);
+    
+    return(eores_OK);
+}
+
 
 
 
@@ -620,6 +955,28 @@ static void s_eo_ropframe_footer_adjust(EOropframe *p)
     footer->endoframe               = EOFRAME_END;
 }
 
+// the bytes of a compact ropframe which are not rops
+static uint16_t s_eo_ropframe_compact_overhead(uint8_t flags)
+{
+    uint16_t size = sizeof(EOropframeCompactHeader_t);
+    
+    if(0 != (flags & EOFRAME_COMPACT_FLAG_KEY))
+    {
+        size += 16;
+    }
+    else
+    {
+        size += 6;
+    }
+    
+    if(0 != (flags & EOFRAME_COMPACT_FLAG_IMPLICITEP))
+    {
+        size += 2;
+    }
+    
+    return(size);
+}
+
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -56,6 +56,36 @@ extern "C" {
 enum { eo_ropframe_sizeforZEROrops = 28 };
 
 
+/** @typedef    typedef enum eOropframeFormat_t
+    @brief      contains the formats of a ropframe on the wire. the compact format has a shorter header, no footer, 
+                age and sequence number on 32 and 16 bits (but in key ropframes), an implicit endpoint if all the rops 
+                share it, data without padding and the time of each rop as a 16 bits delta from the age of the ropframe.
+                in memory the ropframe is always in standard format: the compact one is used only in transmission and 
+                reception with eo_ropframe_compact_Encode() and eo_ropframe_compact_Decode().
+ **/
+typedef enum
+{
+    eo_ropframe_format_standard     = 0,
+    eo_ropframe_format_compact      = 1
+} eOropframeFormat_t;
+
+
+/** @typedef    typedef struct eOropframeCompactState_t
+    @brief      keeps the state of the compact format for a stream of ropframes between two hosts. The encoder emits a
+                key ropframe (with full age and sequence number) every keyperiod ropframes and the decoder uses the last
+                received ropframe to recover the most significant bits of age and sequence number of the others.
+ **/
+typedef struct
+{
+    uint64_t            lastage;            // decoder: the age of the last decoded ropframe
+    uint64_t            lastseqnum;         // decoder: the sequence number of the last decoded ropframe
+    uint16_t            keyperiod;          // encoder: a key ropframe every keyperiod ropframes
+    uint16_t            tillnextkey;        // encoder: the ropframes still to be sent before the next key
+    eObool_t            synchronised;       // decoder: eobool_true after the first key ropframe 
+    uint8_t             filler[3];
+} eOropframeCompactState_t;
+
+
 /** @typedef    typedef struct EOropframe_hid EOropframe
     @brief      EOropframe is an opaque struct. It is used to implement data abstraction for the datagram 
                 object so that the user cannot see its private fields and he/she is forced to manipulate the
@@ -113,6 +143,49 @@ extern eOresult_t eo_ropframe_seqnum_Set(EOropframe *p, uint64_t seqnum);
 extern uint64_t eo_ropframe_seqnum_Get(EOropframe *p);
 
 
+/** @fn         extern void eo_ropframe_compact_Reset(eOropframeCompactState_t *state, uint16_t keyperiod)
+    @brief      initialises the state of the compact format so that the next encoded ropframe is a key one and the
+                decoder waits for a key ropframe.
+    @param      state       the state
+    @param      keyperiod   the number of ropframes between two key ropframes. if 0 every ropframe is a key one.
+ **/
+extern void eo_ropframe_compact_Reset(eOropframeCompactState_t *state, uint16_t keyperiod);
+
+
+/** @fn         extern eObool_t eo_ropframe_compact_IsCompact(const uint8_t *framedata, uint16_t framesize)
+    @brief      tells if a received buffer contains a ropframe in compact format.
+    @return     eobool_true if the buffer begins as a compact ropframe.
+ **/
+extern eObool_t eo_ropframe_compact_IsCompact(const uint8_t *framedata, uint16_t framesize);
+
+
+/** @fn         extern eOresult_t eo_ropframe_compact_Encode(EOropframe *p, eOropframeCompactState_t *state, uint8_t *dest, uint16_t capacity, uint16_t *framesize)
+    @brief      writes a valid ropframe in compact format into a separate buffer. the ropframe is not changed, thus it can 
+                be encoded again (e.g., to retransmit it). if the ropframe cannot be expressed in compact format (more than 
+                255 rops) or capacity is smaller than its standard size, the function returns eores_NOK_generic, so that it 
+                can be sent in standard format. the compact ropframe is never larger than the standard one.
+    @param      p           the ropframe, already stamped with age and sequence number
+    @param      state       the state of the encoder
+    @param      dest        the buffer where to write the compact ropframe. it must not overlap the ropframe.
+    @param      capacity    the size of dest
+    @param      framesize   in output the number of bytes of the compact ropframe
+    @return     eores_OK, eores_NOK_nullpointer or eores_NOK_generic.
+ **/
+extern eOresult_t eo_ropframe_compact_Encode(EOropframe *p, eOropframeCompactState_t *state, uint8_t *dest, uint16_t capacity, uint16_t *framesize);
+
+
+/** @fn         extern eOresult_t eo_ropframe_compact_Decode(eOropframeCompactState_t *state, const uint8_t *framedata, uint16_t framesize, EOropframe *target)
+    @brief      expands a compact ropframe into a ropframe in standard format.
+    @param      state       the state of the decoder
+    @param      framedata   the compact ropframe
+    @param      framesize   its size
+    @param      target      a ropframe already loaded with a buffer. it is cleared and filled.
+    @return     eores_OK, eores_NOK_nullpointer or eores_NOK_generic if the compact ropframe is not valid, does not fit 
+                inside target or is not a key one and the decoder is not yet synchronised.
+ **/
+extern eOresult_t eo_ropframe_compact_Decode(eOropframeCompactState_t *state, const uint8_t *framedata, uint16_t framesize, EOropframe *target);
+
+
 
 /** @}            
     end of group eo_ropframe  
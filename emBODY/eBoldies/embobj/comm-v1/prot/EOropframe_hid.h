@@ -72,6 +72,23 @@ typedef struct  // 28 bytes ...
 // the following is used to guarantee that eo_ropframe_sizeforZEROrops is equal to size of EOropframeEmpty_t.
 EO_VERIFYproposition(EOropframe_hid_verifyzerorops, sizeof(EOropframeEmpty_t) == eo_ropframe_sizeforZEROrops);
 
+// the compact ropframe begins with this header, which is followed by the age and the sequence number (u64 + u64 if 
+// key, else u32 + u16), by the endpoint (u16) if implicit, and by the rops in compact form. there is no footer.
+#define EOFRAME_COMPACT_START               0x5AC3
+
+#define EOFRAME_COMPACT_FLAG_KEY            0x01
+#define EOFRAME_COMPACT_FLAG_IMPLICITEP     0x04
+#define EOFRAME_COMPACT_FLAGS_ALL           (EOFRAME_COMPACT_FLAG_KEY | EOFRAME_COMPACT_FLAG_IMPLICITEP)
+
+typedef struct  // 6 bytes
+{
+    uint16_t            startofframe;
+    uint8_t             flags;
+    uint8_t             ropsnumberof;
+    uint16_t            ropssizeof;
+} EOropframeCompactHeader_t;    EO_VERIFYsizeof(EOropframeCompactHeader_t, 6);
+
+
 typedef struct  // 32 bytes
 {
     EOropframeHeader_t          header;
@@ -104,6 +121,14 @@ struct EOropframe_hid
 
 uint8_t* eo_ropframe_hid_get_pointer_offset(EOropframe *p, uint16_t offset);
 
+// it forces the ropframe to contain numberofrops rops in its first sizeofrops bytes. it is used by whoever rearranges
+// the rops directly in memory (e.g., the EOtransmitter when it compacts its regular rops)
+eOresult_t eo_ropframe_hid_rops_Set(EOropframe *p, uint16_t numberofrops, uint16_t sizeofrops);
+
+// it appends to the ropframe a stream of numberofrops rops which is sizeofrops bytes long. it is used to select only some
+// of the rops of another ropframe.
+eOresult_t eo_ropframe_hid_rops_Append(EOropframe *p, const uint8_t *rops, uint16_t numberofrops, uint16_t sizeofrops);
+
 
 
 #ifdef __cplusplus
@@ -609,6 +609,47 @@ extern eOresult_t eo_agent_OutROPfromNV(EOtheAgent* p, EOnv* nv, eOropdescriptor
 // --------------------------------------------------------------------------------------------------------------------
 
 
+extern eOresult_t eo_agent_hid_InpROPprocessOnIndices(EOtheAgent *p, EOrop *ropin, EOnvsCfg* nvscfg, uint16_t ondevindex, uint16_t onendpointindex, uint16_t onidindex, eObool_t nvislocked, EOrop *replyrop)
+{
+    eOropcode_t ropc;
+
+    if((NULL == p) || (NULL == nvscfg) || (NULL == ropin) || (NULL == replyrop))
+    {
+        return(eores_NOK_nullpointer);
+    }
+
+    // it is the same as the normal path of eo_agent_InpROPprocess() with the indices already retrieved by the caller
+    eo_rop_Reset(replyrop);
+
+    ropc = ropin->stream.head.ropc;
+
+    // can process only valid commands
+    if( (eo_ropcode_none == ropc) || (eo_ropcode_usr == ropc) )
+    {
+        return(eores_NOK_generic); 
+    }
+
+    ropin->tmpdata.nvscfg           = nvscfg;
+    ropin->tmpdata.nvownership      = eo_rop_hid_GetOwnership(ropc, eo_ropconf_none, eo_rop_dir_received);
+    ropin->tmpdata.ondevindex       = ondevindex;
+    ropin->tmpdata.onendpointindex  = onendpointindex;
+    ropin->tmpdata.onidindex        = onidindex;
+
+    if((EOK_uint16dummy == onidindex) || (NULL == eo_nvscfg_GetNV(nvscfg, ondevindex, onendpointindex, onidindex, NULL, &ropin->netvar)))
+    {
+        eo_nv_Clear(&ropin->netvar);
+    }
+    else if(eobool_true == nvislocked)
+    {   // the local copy of the nv does not take the mutex already held by the caller
+        ropin->netvar.mtx = NULL;
+    }
+
+    eo_rop_Process(ropin, replyrop);
+
+    return(eores_OK);
+}
+
+
 extern eOresult_t eo_agent_hid_OutROPonTransmission(EOtheAgent *p, EOrop *rop)
 {
     if(1 == rop->stream.head.ctrl.rqstconf)
@@ -66,6 +66,11 @@ struct EOtheAgent_hid
 // to be called only once just before transmission
 extern eOresult_t eo_agent_hid_OutROPonTransmission(EOtheAgent *p, EOrop *rop);
 
+// it processes a received rop w/out confirmation whose indices inside nvscfg are already known, as eo_agent_InpROPprocess()
+// would do after eo_nvscfg_GetIndices(). onidindex is EOK_uint16dummy if the nv does not exist. if nvislocked is eobool_true
+// the caller already holds the mutex of the nv, thus the nv is processed without taking it again.
+extern eOresult_t eo_agent_hid_InpROPprocessOnIndices(EOtheAgent *p, EOrop *ropin, EOnvsCfg* nvscfg, uint16_t ondevindex, uint16_t onendpointindex, uint16_t onidindex, eObool_t nvislocked, EOrop *replyrop);
+
 #ifdef __cplusplus
 }       // closing brace for extern "C"
 #endif 
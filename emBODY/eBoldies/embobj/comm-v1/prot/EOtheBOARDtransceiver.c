@@ -70,6 +70,7 @@
 // --------------------------------------------------------------------------------------------------------------------
 
 static EOnvsCfg* s_eo_boardtransceiver_nvscfg_get(const eOboardtransceiver_cfg_t *cfg);
+static void s_eo_boardtransceiver_rxstatistics_bind(const eOboardtransceiver_cfg_t *cfg);
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -94,7 +95,12 @@ const eOboardtransceiver_cfg_t eo_boardtransceiver_cfg_default =
     EO_INIT(.sizes)                     {0},
     EO_INIT(.mutex_fn_new)              NULL,
     EO_INIT(.transprotection)           eo_trans_protection_none,
-    EO_INIT(.nvscfgprotection)          eo_nvscfg_protection_none
+    EO_INIT(.nvscfgprotection)          eo_nvscfg_protection_none,
+    EO_INIT(.rxstatisticsendpoint)      EOK_uint16dummy,
+    EO_INIT(.rxstatisticsid)            EOK_BOARDTRANSCEIVER_rxstatisticsid_none,
+    EO_INIT(.ropframeformat)            eo_trans_ropframeformat_standard,
+    EO_INIT(.txbuffer)                  {NULL, NULL, NULL},
+    EO_INIT(.maxnumberofropsinbatch)    0
 };
 
 
@@ -147,9 +153,16 @@ extern EOtransceiver * eo_boardtransceiver_Initialise(const eOboardtransceiver_c
     txrxcfg.nvscfg                         = s_eo_theboardtrans.nvscfg;
     txrxcfg.mutex_fn_new                   = cfg->mutex_fn_new;
     txrxcfg.protection                     = cfg->transprotection;
+    txrxcfg.ropframeformat                 = cfg->ropframeformat;
+    txrxcfg.txbuffer                       = cfg->txbuffer;
+    txrxcfg.maxnumberofropsinbatch         = cfg->maxnumberofropsinbatch;
     
     s_eo_theboardtrans.transceiver = eo_transceiver_New(&txrxcfg);
     
+    // 2. if required, the statistics of reception are kept inside a local nv
+    
+    s_eo_boardtransceiver_rxstatistics_bind(cfg);
+    
     
     return(s_eo_theboardtrans.transceiver);        
 }    
@@ -224,10 +237,43 @@ static EOnvsCfg* s_eo_boardtransceiver_nvscfg_get(const eOboardtransceiver_cfg_t
 }
 
 
-// --------------------------------------------------------------------------------------------------------------------
-// - end-of-file (leave a blank line after)
-// --------------------------------------------------------------------------------------------------------------------
-
+static void s_eo_boardtransceiver_rxstatistics_bind(const eOboardtransceiver_cfg_t *cfg)
+{
+    uint16_t ondevindex = 0;
+    uint16_t onendpointindex = 0;
+    uint16_t onidindex = 0;
+    EOnv nv;
+    eOresult_t res;
 
+    if(EOK_BOARDTRANSCEIVER_rxstatisticsid_none == cfg->rxstatisticsid)
+    {
+        return;
+    }
+    
+    res = eo_nvscfg_GetIndices(s_eo_theboardtrans.nvscfg, EO_COMMON_IPV4ADDR_LOCALHOST, cfg->rxstatisticsendpoint, cfg->rxstatisticsid, 
+                               &ondevindex, &onendpointindex, &onidindex);
+    
+    if(eores_OK != res)
+    {
+        eo_errman_Error(eo_errman_GetHandle(), eo_errortype_weak, s_eobj_ownname, "the nv for rx statistics is not found");
+        return;
+    }
+    
+    eo_nvscfg_GetNV(s_eo_theboardtrans.nvscfg, ondevindex, onendpointindex, onidindex, NULL, &nv);
+    
+    if(eo_nv_FUN_inp != eo_nv_GetFUN(&nv))
+    {   // the receiver writes the nv behind the back of the nvscfg: it must be a read-only nv
+        eo_errman_Error(eo_errman_GetHandle(), eo_errortype_weak, s_eobj_ownname, "the nv for rx statistics is not an inp");
+        return;
+    }
+    
+    if(eores_OK != eo_transceiver_rxstatistics_Bind(s_eo_theboardtrans.transceiver, nv.loc, eo_nv_Capacity(&nv)))
+    {
+        eo_errman_Error(eo_errman_GetHandle(), eo_errortype_weak, s_eobj_ownname, "the nv for rx statistics is too small");
+    }
+}
 
 
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
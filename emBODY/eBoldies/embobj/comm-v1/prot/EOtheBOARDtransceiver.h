@@ -40,6 +40,7 @@ extern "C" {
 // - external dependencies --------------------------------------------------------------------------------------------
 
 #include "EoCommon.h"
+#include "EOnv.h"
 #include "EOtransceiver.h"
 
 
@@ -52,6 +53,10 @@ extern "C" {
 //#define EOK_BOARDTRANSCEIVER_capacityofropframereplies          128 
 //#define EOK_BOARDTRANSCEIVER_maxnumberofregularrops             16 
 
+// the value of rxstatisticsid which binds the statistics of reception to no nv. the id of every nv carries its fun
+// (see EO_nv_ID()), and eo_nv_FUN_NO0 is never used, thus this id cannot match a real variable whatever the endpoint.
+#define EOK_BOARDTRANSCEIVER_rxstatisticsid_none                EO_nv_ID(EO_nv_FUNTYP(eo_nv_FUN_NO0, eo_nv_TYP_NO4), 0x3ff)
+
 // - declaration of public user-defined types ------------------------------------------------------------------------- 
 
 
@@ -65,6 +70,11 @@ typedef struct
     eov_mutex_fn_mutexderived_new   mutex_fn_new;    
     eOtransceiver_protection_t      transprotection;
     eOnvscfg_protection_t           nvscfgprotection;
+    eOnvEP_t                        rxstatisticsendpoint;   // if rxstatisticsid is not EOK_BOARDTRANSCEIVER_rxstatisticsid_none, the local nv 
+    eOnvID_t                        rxstatisticsid;         // (rxstatisticsendpoint, rxstatisticsid) keeps the statistics of reception (see eo_receiver_statistics_t)
+    eOtransceiver_ropframeformat_t  ropframeformat;
+    eOtransceiver_txbuffer_t        txbuffer;               // if its getbuffer is not NULL, the board transmits with eo_transceiver_Transmit()
+    uint16_t                        maxnumberofropsinbatch; // if not 0, the received rops are processed in batches (see eOtransceiver_cfg_t)
 } eOboardtransceiver_cfg_t;
 
 
@@ -220,6 +220,114 @@ extern eOresult_t eo_former_GetStream(EOtheFormer *p, const EOrop *rop, const ui
 }
 
 
+extern eOresult_t eo_former_GetCompactStream(EOtheFormer *p, const uint8_t *streamdata, uint16_t streamsize, eObool_t implicitep, eOabstime_t ageofframe, uint8_t *compactdata, uint16_t *consumedbytes, uint16_t *compactsize)
+{
+    eOrophead_t head;
+    uint16_t dataeffectivesize = 0;
+    uint16_t size = 0;
+    uint32_t sign = 0;
+    uint64_t time = 0;
+    uint16_t delta = 0;
+    
+    if((NULL == p) || (NULL == streamdata) || (NULL == compactdata) || (NULL == consumedbytes) || (NULL == compactsize))
+    {    
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(streamsize < sizeof(eOrophead_t))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    // we read all the fields before writing because compactdata may overlap streamdata
+    memcpy(&head, streamdata, sizeof(eOrophead_t));
+    
+    if((streamsize < eo_rop_hid_Stream_Size(&head)) || (head.dsiz > 0x7fff))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    if(eobool_true == eo_rop_hid_DataField_is_Present(&head))
+    {
+        dataeffectivesize = eo_rop_hid_DataField_EffectiveSize(head.dsiz);
+    }
+    
+    if(1 == head.ctrl.plussign)
+    {
+        memcpy(&sign, &streamdata[sizeof(eOrophead_t) + dataeffectivesize], 4);
+    }
+    
+    head.ctrl.ffu = 0;
+    if(1 == head.ctrl.plustime)
+    {
+        memcpy(&time, &streamdata[sizeof(eOrophead_t) + dataeffectivesize + 4*head.ctrl.plussign], 8);
+        if((time <= ageofframe) && ((ageofframe - time) <= EOK_uint16dummy))
+        {   // the time goes on two bytes only
+            head.ctrl.ffu = 1;
+            delta = (uint16_t)(ageofframe - time);
+        }
+    }
+    
+    *consumedbytes = sizeof(eOrophead_t) + dataeffectivesize + 4*head.ctrl.plussign + 8*head.ctrl.plustime;
+    
+    // ctrl and ropc
+    memcpy(&compactdata[size], &head.ctrl, 1);
+    size += 1;
+    compactdata[size++] = head.ropc;
+    
+    if(eobool_false == implicitep)
+    {
+        memcpy(&compactdata[size], &head.endp, 2);
+        size += 2;
+    }
+    
+    memcpy(&compactdata[size], &head.nvid, 2);
+    size += 2;
+    
+    // dsiz on one byte if lower than 128
+    if(head.dsiz < 0x80)
+    {
+        compactdata[size++] = (uint8_t)head.dsiz;
+    }
+    else
+    {
+        compactdata[size++] = 0x80 | (uint8_t)(head.dsiz >> 8);
+        compactdata[size++] = (uint8_t)(head.dsiz & 0xff);
+    }
+    
+    // data without padding. it is a memmove because it can overlap
+    if(0 != head.dsiz)
+    {
+        memmove(&compactdata[size], &streamdata[sizeof(eOrophead_t)], head.dsiz);
+        size += head.dsiz;
+    }
+    
+    if(1 == head.ctrl.plussign)
+    {
+        memcpy(&compactdata[size], &sign, 4);
+        size += 4;
+    }
+    
+    if(1 == head.ctrl.plustime)
+    {
+        if(1 == head.ctrl.ffu)
+        {
+            memcpy(&compactdata[size], &delta, 2);
+            size += 2;
+        }
+        else
+        {
+            memcpy(&compactdata[size], &time, 8);
+            size += 8;
+        }
+    }
+    
+    *compactsize = size;
+    
+    return(eores_OK);
+}
+
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern hidden functions 
 // --------------------------------------------------------------------------------------------------------------------
@@ -96,6 +96,25 @@ extern uint16_t eo_former_GetSizeOfStream(EOtheFormer *p, const EOrop *rop);
 extern eOresult_t eo_former_GetStream(EOtheFormer *p, const EOrop *rop, const uint16_t streamcapacity, uint8_t *streamdata, uint16_t *streamsize);//, eOipv4addr_t *ipaddr);
 
 
+/** @fn         extern eOresult_t eo_former_GetCompactStream(EOtheFormer *p, const uint8_t *streamdata, uint16_t streamsize, eObool_t implicitep, eOabstime_t ageofframe, uint8_t *compactdata, uint16_t *consumedbytes, uint16_t *compactsize)
+    @brief      Converts the first rop of a stream in standard form into the compact form used by the compact ropframe:
+                ctrl, ropc, endp (only if not implicit), nvid, dsiz on one or two bytes, data without padding, sign, and
+                time on two bytes as a delta from the age of the ropframe (ctrl.ffu is then 1) or on eight bytes.
+                The compact form is never longer than the standard one, thus compactdata can be the same memory of
+                streamdata or can precede it.
+    @param      p               The former.
+    @param      streamdata      The rop in standard form.
+    @param      streamsize      The bytes available in streamdata.
+    @param      implicitep      If eobool_true the endpoint is not put in the compact form.
+    @param      ageofframe      The age of the ropframe which contains the rop.
+    @param      compactdata     Where to write the compact form.
+    @param      consumedbytes   The bytes of the rop in standard form.
+    @param      compactsize     The bytes of the rop in compact form.
+    @return     Normally eores_OK, eores_NOK_generic if the stream does not contain a whole rop.
+ **/
+extern eOresult_t eo_former_GetCompactStream(EOtheFormer *p, const uint8_t *streamdata, uint16_t streamsize, eObool_t implicitep, eOabstime_t ageofframe, uint8_t *compactdata, uint16_t *consumedbytes, uint16_t *compactsize);
+
+
 
 
 /** @}            
@@ -258,7 +258,117 @@ extern eOresult_t eo_parser_GetROP(EOtheParser *p, const uint8_t *streamdata, co
 }
 
 
-
+extern eOresult_t eo_parser_GetStreamFromCompact(EOtheParser *p, const uint8_t *compactdata, uint16_t compactsize, eObool_t implicitep, eOnvEP_t ep, eOabstime_t ageofframe, uint8_t *streamdata, uint16_t streamcapacity, uint16_t *consumedbytes, uint16_t *streamsize)
+{
+    eOrophead_t head;
+    uint16_t n = 0;
+    uint16_t dataeffectivesize = 0;
+    uint16_t timeinsize = 0;
+    uint16_t delta = 0;
+    uint64_t time = 0;
+    uint16_t pos = 0;
+
+    if((NULL == p) || (NULL == compactdata) || (NULL == streamdata) || (NULL == consumedbytes) || (NULL == streamsize))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    // at least ctrl, ropc, endp (if not implicit), nvid and one byte of dsiz
+    if(compactsize < ((eobool_false == implicitep) ? (7) : (5)))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    memcpy(&head.ctrl, &compactdata[n], 1);
+    n += 1;
+    head.ropc = compactdata[n++];
+    
+    if(eobool_false == implicitep)
+    {
+        memcpy(&head.endp, &compactdata[n], 2);
+        n += 2;
+    }
+    else
+    {
+        head.endp = ep;
+    }
+    
+    memcpy(&head.nvid, &compactdata[n], 2);
+    n += 2;
+    
+    head.dsiz = compactdata[n++];
+    if(0 != (head.dsiz & 0x80))
+    {
+        if(n >= compactsize)
+        {
+            return(eores_NOK_generic);
+        }
+        head.dsiz = ((head.dsiz & 0x7f) << 8) | compactdata[n++];
+    }
+    
+    if(1 == head.ctrl.plustime)
+    {
+        timeinsize = (1 == head.ctrl.ffu) ? (2) : (8);
+    }
+    
+    // the ffu bit is used only by the compact form
+    head.ctrl.ffu = 0;
+    
+    if(compactsize < (n + head.dsiz + 4*head.ctrl.plussign + timeinsize))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    if(eobool_true == eo_rop_hid_DataField_is_Present(&head))
+    {
+        dataeffectivesize = eo_rop_hid_DataField_EffectiveSize(head.dsiz);
+    }
+    
+    if(streamcapacity < eo_rop_hid_Stream_Size(&head))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    // head
+    memcpy(&streamdata[0], &head, sizeof(eOrophead_t));
+    pos = sizeof(eOrophead_t);
+    
+    // data with its padding
+    if(0 != dataeffectivesize)
+    {
+        memcpy(&streamdata[pos], &compactdata[n], head.dsiz);
+        memset(&streamdata[pos+head.dsiz], 0, dataeffectivesize - head.dsiz);
+        n += head.dsiz;
+        pos += dataeffectivesize;
+    }
+    
+    if(1 == head.ctrl.plussign)
+    {
+        memcpy(&streamdata[pos], &compactdata[n], 4);
+        n += 4;
+        pos += 4;
+    }
+    
+    if(2 == timeinsize)
+    {
+        memcpy(&delta, &compactdata[n], 2);
+        time = ageofframe - delta;
+        memcpy(&streamdata[pos], &time, 8);
+        n += 2;
+        pos += 8;
+    }
+    else if(8 == timeinsize)
+    {
+        memcpy(&streamdata[pos], &compactdata[n], 8);
+        n += 8;
+        pos += 8;
+    }
+    
+    *consumedbytes  = n;
+    *streamsize     = pos;
+    
+    return(eores_OK);
+}
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -97,6 +97,24 @@ extern EOtheParser * eo_parser_GetHandle(void);
 extern eOresult_t eo_parser_GetROP(EOtheParser *p, const uint8_t *streamdata, const uint16_t streamsize, EOrop *rop, uint16_t *consumedbytes);
 
 
+/** @fn         extern eOresult_t eo_parser_GetStreamFromCompact(EOtheParser *p, const uint8_t *compactdata, uint16_t compactsize, eObool_t implicitep, eOnvEP_t ep, eOabstime_t ageofframe, uint8_t *streamdata, uint16_t streamcapacity, uint16_t *consumedbytes, uint16_t *streamsize)
+    @brief      Expands the first rop of a stream in the compact form (see eo_former_GetCompactStream()) into the standard
+                form, which can then be parsed with eo_parser_GetROP().
+    @param      compactdata     The input data in compact form
+    @param      compactsize     The size of the input data
+    @param      implicitep      If eobool_true the endpoint is not inside the compact form and the rop takes ep.
+    @param      ep              The endpoint of the rop when implicitep is eobool_true, else it is not used.
+    @param      ageofframe      The age of the ropframe which contains the rop.
+    @param      streamdata      Where to write the rop in standard form.
+    @param      streamcapacity  The capacity of streamdata.
+    @param      consumedbytes   The number of bytes used by the rop in compact form.
+    @param      streamsize      The number of bytes of the rop in standard form.
+    @return     The value eores_NOK_nullpointer if any is a NULL pointer, eores_NOK_generic if compactdata does not have a 
+                whole rop or if streamdata is too small, eores_OK otherwise.
+ **/
+extern eOresult_t eo_parser_GetStreamFromCompact(EOtheParser *p, const uint8_t *compactdata, uint16_t compactsize, eObool_t implicitep, eOnvEP_t ep, eOabstime_t ageofframe, uint8_t *streamdata, uint16_t streamcapacity, uint16_t *consumedbytes, uint16_t *streamsize);
+
+
 
 
 
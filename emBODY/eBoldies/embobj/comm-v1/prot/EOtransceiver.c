@@ -51,6 +51,8 @@
 // --------------------------------------------------------------------------------------------------------------------
 // - #define with internal scope
 
+// the capacity of the buffer where a received ropframe in compact format is expanded into the standard one
+#define EOK_TRANSCEIVER_capacityofexpandedropframe      1536
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -68,7 +70,11 @@
 // --------------------------------------------------------------------------------------------------------------------
 // - declaration of static functions
 // --------------------------------------------------------------------------------------------------------------------
-// empty-section    
+
+static void s_eo_transceiver_confman_retransmit(void *arg, const eOconfman_request_t *req);
+static void s_eo_transceiver_confman_requested(EOtransceiver *p, eOresult_t res, eOropdescriptor_t *ropdesc);
+static void s_eo_transceiver_confman_tick(EOtransceiver *p);
+static uint16_t s_eo_transceiver_retransmissions_load(EOtransceiver *p);
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -89,7 +95,11 @@ const eOtransceiver_cfg_t eo_transceiver_cfg_default =
     EO_INIT(.remipv4port)                   10001,
     EO_INIT(.nvscfg)                        NULL,
     EO_INIT(.mutex_fn_new)                  NULL,
-    EO_INIT(.protection)                    eo_trans_protection_none
+    EO_INIT(.protection)                    eo_trans_protection_none,
+    EO_INIT(.ropframeformat)                eo_trans_ropframeformat_standard,
+    EO_INIT(.confmancfg)                    NULL,
+    EO_INIT(.txbuffer)                      {NULL, NULL, NULL},
+    EO_INIT(.maxnumberofropsinbatch)        0
 };
 
 
@@ -106,6 +116,7 @@ extern EOtransceiver* eo_transceiver_New(const eOtransceiver_cfg_t *cfg)
     EOtransceiver *retptr = NULL;  
     eo_receiver_cfg_t rec_cfg;
     eo_transmitter_cfg_t tra_cfg;
+    eOconfman_cfg_t cm_cfg;
 
 
     if(NULL == cfg)
@@ -117,7 +128,9 @@ extern EOtransceiver* eo_transceiver_New(const eOtransceiver_cfg_t *cfg)
     rec_cfg.capacityofropframereply         = cfg->capacityofropframereplies;
     rec_cfg.capacityofropinput              = cfg->capacityofrop;
     rec_cfg.capacityofropreply              = cfg->capacityofrop;
+    rec_cfg.capacityofcompactexpansion      = (eo_trans_ropframeformat_standard == cfg->ropframeformat) ? (0) : (EOK_TRANSCEIVER_capacityofexpandedropframe);
     rec_cfg.nvscfg                          = cfg->nvscfg;
+    rec_cfg.maxnumberofropsinbatch          = cfg->maxnumberofropsinbatch;
 
     
     memcpy(&tra_cfg, &eo_transmitter_cfg_default, sizeof(eo_transmitter_cfg_t));
@@ -131,7 +144,25 @@ extern EOtransceiver* eo_transceiver_New(const eOtransceiver_cfg_t *cfg)
     tra_cfg.ipv4port                        = cfg->remipv4port;     // it is the remote port where to send packets
     tra_cfg.nvscfg                          = cfg->nvscfg;
     tra_cfg.mutex_fn_new                    = cfg->mutex_fn_new;
-    tra_cfg.protection                      = (eo_trans_protection_none == cfg->protection) ? (eo_transmitter_protection_none) : (eo_transmitter_protection_total);
+    tra_cfg.ropframeformat                  = (eo_trans_ropframeformat_compact == cfg->ropframeformat) ? (eo_ropframe_format_compact) : (eo_ropframe_format_standard);
+    tra_cfg.compactallowed                  = (eo_trans_ropframeformat_standard == cfg->ropframeformat) ? (eobool_false) : (eobool_true);
+    switch(cfg->protection)
+    {
+        case eo_trans_protection_none:
+        {
+            tra_cfg.protection              = eo_transmitter_protection_none;
+        } break;
+        
+        case eo_trans_protection_spsc:
+        {
+            tra_cfg.protection              = eo_transmitter_protection_spsc;
+        } break;
+        
+        default:
+        {
+            tra_cfg.protection              = eo_transmitter_protection_total;
+        } break;
+    }
     
     
     
@@ -141,6 +172,35 @@ extern EOtransceiver* eo_transceiver_New(const eOtransceiver_cfg_t *cfg)
     
     memcpy(&retptr->cfg, cfg, sizeof(eOtransceiver_cfg_t)); 
     
+    retptr->confmanager = NULL;
+    retptr->mtx_confman = NULL;
+    retptr->rtxqueue    = NULL;
+    retptr->rtxcapacity = 0;
+    retptr->rtxfirst    = 0;
+    retptr->rtxsize     = 0;
+    if(NULL != cfg->confmancfg)
+    {   // the retransmissions are done by the transceiver itself
+        memcpy(&cm_cfg, cfg->confmancfg, sizeof(eOconfman_cfg_t));
+        cm_cfg.on_rop_retransmit    = s_eo_transceiver_confman_retransmit;
+        cm_cfg.arg                  = retptr;
+        retptr->confmanager = eo_confman_New(&cm_cfg);
+        
+        // the confmanager is used by the task which receives, by the one which transmits and by the user
+        if((eo_trans_protection_none != cfg->protection) && (NULL != cfg->mutex_fn_new))
+        {
+            retptr->mtx_confman = cfg->mutex_fn_new();
+        }
+        
+        // with spsc only the producer loads the occasionals: the task which transmits queues the retransmissions
+        if((eo_trans_protection_spsc == cfg->protection) && (0 != cm_cfg.capacity))
+        {
+            retptr->rtxcapacity = cm_cfg.capacity;
+            retptr->rtxqueue    = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(eOropdescriptor_t), cm_cfg.capacity);
+        }
+    }
+    rec_cfg.confmanager     = retptr->confmanager;
+    rec_cfg.confmanmutex    = retptr->mtx_confman;
+    
     retptr->receiver = eo_receiver_New(&rec_cfg);
     
     retptr->transmitter = eo_transmitter_New(&tra_cfg);
@@ -183,6 +243,11 @@ extern eOresult_t eo_transceiver_Receive(EOtransceiver *p, EOpacket *pkt, uint16
     {
         return(res);
     }  
+    
+    if(eo_trans_ropframeformat_negotiated == p->cfg.ropframeformat)
+    {   // we answer with the same format used by the remote host
+        eo_transmitter_ropframeformat_Set(p->transmitter, eo_receiver_ropframeformat_Get(p->receiver));
+    }
 
     if(eobool_true == thereisareply)
     {
@@ -227,6 +292,9 @@ extern eOresult_t eo_transceiver_outpacket_Prepare(EOtransceiver *p, uint16_t *n
         return(eores_NOK_nullpointer);
     }
     
+    // load again the occasional rops whose confirmation is late, so that they go in this packet
+    s_eo_transceiver_confman_tick(p);
+    
     // refresh regulars ...    
     //eov_mutex_Take(p->mtx_tx_regulars, eok_reltimeINFINITE); 
     eo_transmitter_regular_rops_Refresh(p->transmitter);
@@ -240,6 +308,63 @@ extern eOresult_t eo_transceiver_outpacket_Prepare(EOtransceiver *p, uint16_t *n
 
 
 
+extern eOresult_t eo_transceiver_outpacket_PrepareInto(EOtransceiver *p, uint8_t *buffer, uint16_t capacity, uint16_t *size, uint16_t *numberofrops)
+{
+    
+    if((NULL == p) || (NULL == numberofrops))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    s_eo_transceiver_confman_tick(p);
+    
+    // refresh regulars ...    
+    eo_transmitter_regular_rops_Refresh(p->transmitter);
+    
+    return(eo_transmitter_outpacket_PrepareInto(p->transmitter, buffer, capacity, size, numberofrops));
+ 
+}
+
+
+extern eOresult_t eo_transceiver_Transmit(EOtransceiver *p, uint16_t *numberofrops)
+{
+    const eOtransceiver_txbuffer_t *txbuffer = NULL;
+    uint8_t *buffer = NULL;
+    uint16_t size = 0;
+    eOresult_t res;
+    
+    if((NULL == p) || (NULL == numberofrops))
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    *numberofrops = 0;
+    
+    txbuffer = &p->cfg.txbuffer;
+    
+    if((NULL == txbuffer->getbuffer) || (NULL == txbuffer->commit))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    // the buffer is taken before the rops are removed from the transmitter, so that they are not lost if there is none
+    if(NULL == (buffer = txbuffer->getbuffer(txbuffer->arg, p->cfg.capacityoftxpacket)))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    res = eo_transceiver_outpacket_PrepareInto(p, buffer, p->cfg.capacityoftxpacket, &size, numberofrops);
+    
+    if((eores_OK != res) || (0 == *numberofrops))
+    {   // just give the buffer back
+        txbuffer->commit(txbuffer->arg, buffer, 0, p->cfg.remipv4addr, p->cfg.remipv4port);
+        return(res);
+    }
+    
+    return(txbuffer->commit(txbuffer->arg, buffer, size, p->cfg.remipv4addr, p->cfg.remipv4port));
+}
+
+
 extern eOresult_t eo_transceiver_outpacket_Get(EOtransceiver *p, EOpacket **pkt)
 {
     
@@ -319,9 +444,14 @@ extern eOresult_t eo_transceiver_rop_occasional_Load_without_data(EOtransceiver
         return(eores_NOK_nullpointer);
     }
 
+    // the retransmissions go before the new rops
+    s_eo_transceiver_retransmissions_load(p);
+
     //eov_mutex_Take(p->mtx_tx_occasionals, eok_reltimeINFINITE);
     res = eo_transmitter_occasional_rops_Load_without_data(p->transmitter, ropdesc, itisobsolete);
     //eov_mutex_Release(p->mtx_tx_occasionals);
+    
+    s_eo_transceiver_confman_requested(p, res, ropdesc);
 
 #if defined(USE_DEBUG_EOTRANSCEIVER) 
     {   // DEBUG    
@@ -366,7 +496,12 @@ extern eOresult_t eo_transceiver_rop_occasional_Load(EOtransceiver *p, eOropdesc
 //         
 //     }   
 
+    // the retransmissions go before the new rops
+    s_eo_transceiver_retransmissions_load(p);
+
     res = eo_transmitter_occasional_rops_Load(p->transmitter, ropdesc);
+    
+    s_eo_transceiver_confman_requested(p, res, ropdesc);
  
 #if defined(USE_DEBUG_EOTRANSCEIVER)  
     {   // DEBUG    
@@ -426,6 +561,76 @@ extern eOresult_t eo_transceiver_rop_occasional_Load(EOtransceiver *p, eOropdesc
 }    
 
 
+extern eOresult_t eo_transceiver_rop_occasional_Retransmit(EOtransceiver *p, uint16_t *numberofrops)
+{
+    uint16_t n = 0;
+    
+    if(NULL == p)
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    n = s_eo_transceiver_retransmissions_load(p);
+    
+    if(NULL != numberofrops)
+    {
+        *numberofrops = n;
+    }
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_transceiver_confstatistics_Get(EOtransceiver *p, eOconfman_statistics_t *stats)
+{
+    eOresult_t res;
+    
+    if(NULL == p)
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(NULL == p->confmanager)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    if(NULL != p->mtx_confman)
+    {
+        eov_mutex_Take(p->mtx_confman, eok_reltimeINFINITE);
+    }
+    res = eo_confman_Statistics_Get(p->confmanager, stats);
+    if(NULL != p->mtx_confman)
+    {
+        eov_mutex_Release(p->mtx_confman);
+    }
+    
+    return(res);
+}
+
+
+extern eOresult_t eo_transceiver_rxstatistics_Get(EOtransceiver *p, eo_receiver_statistics_t *stats)
+{
+    if(NULL == p)
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    return(eo_receiver_Statistics_Get(p->receiver, stats));
+}
+
+
+extern eOresult_t eo_transceiver_rxstatistics_Bind(EOtransceiver *p, void *ram, uint16_t capacity)
+{
+    if(NULL == p)
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    return(eo_receiver_Statistics_Bind(p->receiver, ram, capacity));
+}
+
+
 // --------------------------------------------------------------------------------------------------------------------
 // - definition of extern hidden functions 
 // --------------------------------------------------------------------------------------------------------------------
@@ -438,6 +643,135 @@ extern eOresult_t eo_transceiver_rop_occasional_Load(EOtransceiver *p, eOropdesc
 // - definition of static functions 
 // --------------------------------------------------------------------------------------------------------------------
 
+// it is called by eo_confman_Tick() with mtx_confman taken. the request has no data: a set<> takes again the current 
+// value of its netvar
+static void s_eo_transceiver_confman_retransmit(void *arg, const eOconfman_request_t *req)
+{
+    EOtransceiver *p = (EOtransceiver*)arg;
+    eOropdescriptor_t ropdesc;
+    uint16_t i;
+    
+    if(NULL == p->rtxqueue)
+    {   // the occasionals are protected by a mutex or are used by a single task
+        memcpy(&ropdesc, &req->ropdes, sizeof(eOropdescriptor_t));
+        if(eores_OK != eo_transmitter_occasional_rops_Load(p->transmitter, &ropdesc))
+        {
+#if defined(USE_DEBUG_EOTRANSCEIVER)  
+            p->debug.cannotloadropinoccasionals ++;
+#endif
+        }
+        return;
+    }
+    
+    // spsc: the task which transmits must not load the occasionals. the rop waits for the producer, only once
+    for(i=0; i<p->rtxsize; i++)
+    {
+        const eOropdescriptor_t *queued = &p->rtxqueue[(p->rtxfirst + i) % p->rtxcapacity];
+        if((queued->ep == req->ropdes.ep) && (queued->id == req->ropdes.id) && (queued->ropcode == req->ropdes.ropcode))
+        {
+            return;
+        }
+    }
+    
+    if(p->rtxsize == p->rtxcapacity)
+    {   // it is retransmitted at its next timeout
+#if defined(USE_DEBUG_EOTRANSCEIVER)  
+        p->debug.cannotloadropinoccasionals ++;
+#endif
+        return;
+    }
+    
+    memcpy(&p->rtxqueue[(p->rtxfirst + p->rtxsize) % p->rtxcapacity], &req->ropdes, sizeof(eOropdescriptor_t));
+    p->rtxsize++;
+}
+
+
+static void s_eo_transceiver_confman_requested(EOtransceiver *p, eOresult_t res, eOropdescriptor_t *ropdesc)
+{
+    if((eores_OK == res) && (NULL != p->confmanager) && (1 == ropdesc->configuration.confrqst))
+    {
+        if(NULL != p->mtx_confman)
+        {
+            eov_mutex_Take(p->mtx_confman, eok_reltimeINFINITE);
+        }
+        eo_confman_Confirmation_Requested_with_ropdes(p->confmanager, ropdesc, p->cfg.remipv4addr);
+        if(NULL != p->mtx_confman)
+        {
+            eov_mutex_Release(p->mtx_confman);
+        }
+    }
+}
+
+
+static void s_eo_transceiver_confman_tick(EOtransceiver *p)
+{
+    if(NULL == p->confmanager)
+    {
+        return;
+    }
+    
+    if(NULL != p->mtx_confman)
+    {
+        eov_mutex_Take(p->mtx_confman, eok_reltimeINFINITE);
+    }
+    eo_confman_Tick(p->confmanager);
+    if(NULL != p->mtx_confman)
+    {
+        eov_mutex_Release(p->mtx_confman);
+    }
+}
+
+
+// it is called by the producer of the occasionals. the rops are taken one at a time, so that the mutex is not held
+// while loading them
+static uint16_t s_eo_transceiver_retransmissions_load(EOtransceiver *p)
+{
+    eOropdescriptor_t ropdesc;
+    eObool_t thereisone = eobool_true;
+    uint16_t n = 0;
+    
+    if(NULL == p->rtxqueue)
+    {
+        return(0);
+    }
+    
+    while(eobool_true == thereisone)
+    {
+        if(NULL != p->mtx_confman)
+        {
+            eov_mutex_Take(p->mtx_confman, eok_reltimeINFINITE);
+        }
+        thereisone = (0 == p->rtxsize) ? (eobool_false) : (eobool_true);
+        if(eobool_true == thereisone)
+        {
+            memcpy(&ropdesc, &p->rtxqueue[p->rtxfirst], sizeof(eOropdescriptor_t));
+            p->rtxfirst = (p->rtxfirst + 1) % p->rtxcapacity;
+            p->rtxsize--;
+        }
+        if(NULL != p->mtx_confman)
+        {
+            eov_mutex_Release(p->mtx_confman);
+        }
+        
+        if(eobool_false == thereisone)
+        {
+            break;
+        }
+        
+        if(eores_OK == eo_transmitter_occasional_rops_Load(p->transmitter, &ropdesc))
+        {
+            n++;
+        }
+        else
+        {
+#if defined(USE_DEBUG_EOTRANSCEIVER)  
+            p->debug.cannotloadropinoccasionals ++;
+#endif
+        }
+    }
+    
+    return(n);
+}
 
 
 
@@ -45,6 +45,8 @@ extern "C" {
 #include "EOnvsCfg.h"
 #include "EOrop.h"
 #include "EOVmutex.h"
+#include "EOreceiver.h"
+#include "EOconfirmationManager.h"
 
 
 
@@ -67,10 +69,21 @@ typedef struct EOtransceiver_hid EOtransceiver;
 typedef enum
 {
     eo_trans_protection_none                    = 0,
-    eo_trans_protection_enabled                 = 1       
+    eo_trans_protection_enabled                 = 1,
+    eo_trans_protection_spsc                    = 2     /**< the rops are loaded by a single task and the packet is prepared by a single other task */
 } eOtransceiver_protection_t;
 
 
+// compact and negotiated cost a second tx packet of capacityoftxpacket bytes and a buffer of 1536 bytes where the received
+// compact ropframes are expanded. standard does not use them.
+typedef enum
+{
+    eo_trans_ropframeformat_standard            = 0,
+    eo_trans_ropframeformat_compact             = 1,
+    eo_trans_ropframeformat_negotiated          = 2     /**< it accepts both formats and transmits with the format of the last ropframe received */
+} eOtransceiver_ropframeformat_t;
+
+
 typedef struct   
 {
     uint16_t        capacityoftxpacket; 
@@ -82,6 +95,20 @@ typedef struct
 } eOtransceiver_sizes_t; 
 
 
+/** @typedef    typedef struct eOtransceiver_txbuffer_t
+    @brief      The transmission buffer of the IP stack. If getbuffer is not NULL, eo_transceiver_Transmit() borrows a buffer
+                of capacityoftxpacket bytes with getbuffer(), forms the ropframe inside it with eo_transceiver_outpacket_PrepareInto()
+                and sends it with commit(). A commit() of zero bytes must only give the buffer back. They are typically 
+                ipal_udpsocket_getbuffer() and ipal_udpsocket_commit() called on the socket in arg.
+ **/
+typedef struct
+{
+    uint8_t*    (*getbuffer)(void *arg, uint16_t capacity);
+    eOresult_t  (*commit)(void *arg, uint8_t *buffer, uint16_t size, eOipv4addr_t remaddr, eOipv4port_t remport);
+    void*       arg;
+} eOtransceiver_txbuffer_t;
+
+
 typedef struct
 {
     uint16_t                        capacityoftxpacket; 
@@ -95,6 +122,10 @@ typedef struct
     EOnvsCfg*                       nvscfg;         // later on we could split it into a locnvscfg and a remnvscfg
     eov_mutex_fn_mutexderived_new   mutex_fn_new;
     eOtransceiver_protection_t      protection;
+    eOtransceiver_ropframeformat_t  ropframeformat;
+    const eOconfman_cfg_t*          confmancfg;     // if not NULL, the occasional rops which ask for a confirmation are followed by a EOconfirmationManager
+    eOtransceiver_txbuffer_t        txbuffer;       // used by eo_transceiver_Transmit(). if txbuffer.getbuffer is NULL, the packet is taken with eo_transceiver_outpacket_Get()
+    uint16_t                        maxnumberofropsinbatch; // if not 0, the receiver processes up to so many contiguous rops of an endpoint in a batch (see eOreceiver_cfg_t)
 } eOtransceiver_cfg_t;
 
 
@@ -120,7 +151,7 @@ typedef struct
     
 // - declaration of extern public variables, ... but better using use _get/_set instead -------------------------------
 
-extern const eOtransceiver_cfg_t eo_transceiver_cfg_default; //= {512, 128, 256, 128, 128, 16, EO_COMMON_IPV4ADDR_LOCALHOST, 10001, NULL, NULL};
+extern const eOtransceiver_cfg_t eo_transceiver_cfg_default; //= {512, 128, 256, 128, 128, 16, EO_COMMON_IPV4ADDR_LOCALHOST, 10001, NULL, NULL, eo_trans_protection_none, eo_trans_ropframeformat_standard, NULL, {NULL, NULL, NULL}, 0};
 
 
 // - declaration of extern public functions ---------------------------------------------------------------------------
@@ -160,6 +191,33 @@ extern eOresult_t eo_transceiver_outpacket_Prepare(EOtransceiver *p, uint16_t *n
  **/
 extern eOresult_t eo_transceiver_outpacket_Get(EOtransceiver *p, EOpacket **pkt);
 
+
+/** @fn         extern eOresult_t eo_transceiver_outpacket_PrepareInto(EOtransceiver *p, uint8_t *buffer, uint16_t capacity, uint16_t *size, uint16_t *numberofrops)
+    @brief      refreshes the regular rops and forms the outgoing ropframe directly inside @e buffer, typically the transmission
+                buffer of the IP stack, so that the rops are copied only once. it replaces the pair eo_transceiver_outpacket_Prepare()
+                and eo_transceiver_outpacket_Get().
+    @param      p               poiter to transceiver        
+    @param      buffer          the memory where to form the ropframe
+    @param      capacity        the size of buffer
+    @param      size            in output will contain the size of the formed ropframe
+    @param      numberofrops    in output will contain number of rops contained in the ropframe
+    @return     eores_OK, eores_NOK_nullpointer or eores_NOK_generic
+ **/
+extern eOresult_t eo_transceiver_outpacket_PrepareInto(EOtransceiver *p, uint8_t *buffer, uint16_t capacity, uint16_t *size, uint16_t *numberofrops);
+
+
+/** @fn         extern eOresult_t eo_transceiver_Transmit(EOtransceiver *p, uint16_t *numberofrops)
+    @brief      forms the outgoing ropframe directly inside a buffer borrowed from the IP stack with cfg->txbuffer and sends it
+                to the remote host. the rops are copied only once, whereas eo_transceiver_outpacket_Prepare() and 
+                eo_transceiver_outpacket_Get() form the ropframe inside the txpacket, which the IP stack copies again. 
+                a ropframe without rops is not sent.
+    @param      p               poiter to transceiver        
+    @param      numberofrops    in output will contain number of rops sent
+    @return     eores_OK, eores_NOK_nullpointer, or eores_NOK_generic if the transceiver has no txbuffer, if the IP stack
+                has no buffer (the rops stay in the transceiver for the next call) or if commit() fails.
+ **/
+extern eOresult_t eo_transceiver_Transmit(EOtransceiver *p, uint16_t *numberofrops);
+
 extern eOresult_t eo_transceiver_rop_regular_Clear(EOtransceiver *p);
 extern eOresult_t eo_transceiver_rop_regular_Load(EOtransceiver *p, eOropdescriptor_t *ropdes); 
 extern eOresult_t eo_transceiver_rop_regular_Unload(EOtransceiver *p, eOropdescriptor_t *ropdes); 
@@ -169,6 +227,55 @@ extern eOresult_t eo_transceiver_rop_occasional_Load_without_data(EOtransceiver
 extern eOresult_t eo_transceiver_rop_occasional_Load(EOtransceiver *p, eOropdescriptor_t *ropdes);
 
 
+/** @fn         extern eOresult_t eo_transceiver_rop_occasional_Retransmit(EOtransceiver *p, uint16_t *numberofrops)
+    @brief      loads the occasional rops which the confirmation manager wants to send again. with eo_trans_protection_spsc
+                the task which prepares the packet only queues them, because it cannot load the occasionals: they are
+                loaded by eo_transceiver_rop_occasional_Load() and eo_transceiver_rop_occasional_Load_without_data() 
+                before their rop, and the producer must call this function when it has no new rops to load. with the other
+                protections the retransmissions are loaded directly and this function does nothing.
+    @param      p               poiter to transceiver        
+    @param      numberofrops    if not NULL, in output will contain the number of rops loaded
+    @return     eores_OK or eores_NOK_nullpointer
+ **/
+extern eOresult_t eo_transceiver_rop_occasional_Retransmit(EOtransceiver *p, uint16_t *numberofrops);
+
+
+/** @fn         extern eOresult_t eo_transceiver_confstatistics_Get(EOtransceiver *p, eOconfman_statistics_t *stats)
+    @brief      copies the statistics of the confirmations of the occasional rops. they are kept only if the transceiver
+                was created with a confmancfg: the transceiver gives its confirmation manager every occasional rop which
+                asks for a confirmation and every ack, nak or say<> received. eo_transceiver_outpacket_Prepare() and 
+                eo_transceiver_outpacket_PrepareInto() load again the rops not confirmed in time (see also
+                eo_transceiver_rop_occasional_Retransmit()), and the on_rop_lost() of confmancfg receives the EOtransceiver
+                as its arg. its on_rop_retransmit() and arg are not used. if cfg->mutex_fn_new is not NULL and the
+                protection is not eo_trans_protection_none, a mutex is taken around every use of the confirmation
+                manager, so on_rop_lost() is called with it and must not call the functions of the transceiver.
+    @param      p               poiter to transceiver        
+    @param      stats           the destination
+    @return     eores_OK, eores_NOK_nullpointer or eores_NOK_generic if there is no confirmation manager
+ **/
+extern eOresult_t eo_transceiver_confstatistics_Get(EOtransceiver *p, eOconfman_statistics_t *stats);
+
+
+/** @fn         extern eOresult_t eo_transceiver_rxstatistics_Get(EOtransceiver *p, eo_receiver_statistics_t *stats)
+    @brief      copies the statistics of reception of the ropframes coming from the remote host. 
+    @param      p               poiter to transceiver        
+    @param      stats           the destination
+    @return     eores_OK or eores_NOK_nullpointer
+ **/
+extern eOresult_t eo_transceiver_rxstatistics_Get(EOtransceiver *p, eo_receiver_statistics_t *stats);
+
+
+/** @fn         extern eOresult_t eo_transceiver_rxstatistics_Bind(EOtransceiver *p, void *ram, uint16_t capacity)
+    @brief      keeps the statistics of reception inside @e ram, typically the ram of a management network variable, so
+                that the remote host can read them with an ask<>. see eo_receiver_Statistics_Bind().
+    @param      p               poiter to transceiver        
+    @param      ram             the external ram or NULL to use the internal one
+    @param      capacity        the size of ram
+    @return     eores_OK, eores_NOK_nullpointer or eores_NOK_generic
+ **/
+extern eOresult_t eo_transceiver_rxstatistics_Bind(EOtransceiver *p, void *ram, uint16_t capacity);
+
+
 
 
 /** @}            
@@ -68,6 +68,12 @@ struct EOtransceiver_hid
     eOtransceiver_cfg_t         cfg;
     EOreceiver*                 receiver;
     EOtransmitter*              transmitter;   
+    EOconfirmationManager*      confmanager;    // NULL if cfg.confmancfg is NULL
+    EOVmutexDerived*            mtx_confman;    // taken around every call of confmanager and around the queue below
+    eOropdescriptor_t*          rtxqueue;       // with eo_trans_protection_spsc, the retransmissions wait here for the producer
+    uint16_t                    rtxcapacity;
+    uint16_t                    rtxfirst;
+    uint16_t                    rtxsize;
 #if defined(USE_DEBUG_EOTRANSCEIVER)    
     EOtransceiverDEBUG_t        debug;
 #endif    
@@ -63,6 +63,20 @@
 #endif
 
 
+// with eo_transmitter_protection_spsc the producer and the consumer share only writebank and producerbusy. on a
+// single-core mcu the volatile accesses are enough, on a multi-core host we need a full memory barrier.
+#if defined(EO_TAILOR_CODE_FOR_LINUX)
+    #define EOTRANSMITTER_SPSC_BARRIER()        __sync_synchronize()
+#else
+    #define EOTRANSMITTER_SPSC_BARRIER()
+#endif
+
+
+// values of an entry of the hashtable of regular rops which does not contain the index of a slot
+#define EOTRANSMITTER_REGROPS_HASH_EMPTY        EOK_uint16dummy
+#define EOTRANSMITTER_REGROPS_HASH_DELETED      (EOK_uint16dummy-1)
+
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - definition (and initialisation) of extern variables, but better using _get(), _set() 
@@ -81,13 +95,33 @@
 // - declaration of static functions
 // --------------------------------------------------------------------------------------------------------------------
 
-//static eOresult_t s_eo_transmitter_listmatching_rule(void *item, void *param);
+static eo_transm_regrops_table_t* s_eo_transmitter_regrops_New(uint16_t capacity);
+
+static void s_eo_transmitter_regrops_reset(eo_transm_regrops_table_t *t);
+
+static uint16_t s_eo_transmitter_regrops_find(eo_transm_regrops_table_t *t, eOropcode_t ropcode, eOnvEP_t ep, eOnvID_t id, uint16_t *hashpos);
+
+static void s_eo_transmitter_regrops_rehash(eo_transm_regrops_table_t *t);
+
+static void s_eo_transmitter_regrops_compact(EOtransmitter *p);
 
-static eOresult_t s_eo_transmitter_ropmatchingrule_rule(void *item, void *param);
+static void s_eo_transmitter_regrops_updaterop_in_ropframe(EOtransmitter *p, eo_transm_regrop_info_t *inside);
 
-static void s_eo_transmitter_list_updaterop_in_ropframe(void *item, void *param);
+static void s_eo_transmitter_regrops_append_changed(EOtransmitter *p, EOropframe *target);
+static void s_eo_transmitter_regrops_append_run(EOtransmitter *p, EOropframe *target, uint16_t firstslot, uint16_t runstart, uint16_t runrops, uint16_t runsize);
 
-static void s_eo_transmitter_list_shiftdownropinfo(void *item, void *param);
+static uint16_t s_eo_transmitter_ropframe_compose(EOtransmitter *p, EOropframe *target);
+
+static void s_eo_transmitter_ropframe_stamp(EOtransmitter *p, EOropframe *target);
+static eOresult_t s_eo_transmitter_ropframe_encode(EOtransmitter *p, EOropframe *source, uint8_t *dest, uint16_t capacity, uint16_t *size);
+
+static eo_transm_spsc_t* s_eo_transmitter_spsc_New(EOropframe *ropframe, uint16_t capacity);
+
+static EOropframe* s_eo_transmitter_producer_begin(EOVmutexDerived *mtx, eo_transm_spsc_t *spsc, EOropframe *ropframe);
+
+static void s_eo_transmitter_producer_end(EOVmutexDerived *mtx, eo_transm_spsc_t *spsc);
+
+static void s_eo_transmitter_consumer_take(EOtransmitter *p, EOVmutexDerived *mtx, eo_transm_spsc_t *spsc, EOropframe *ropframe, EOropframe *target);
 
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -129,10 +163,12 @@ extern EOtransmitter* eo_transmitter_New(const eo_transmitter_cfg_t *cfg)
     retptr = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(EOtransmitter), 1);
     
     retptr->txpacket                = eo_packet_New(cfg->capacityoftxpacket);
+    retptr->txpacketcompact         = ((eobool_true == cfg->compactallowed) || (eo_ropframe_format_compact == cfg->ropframeformat)) ? (eo_packet_New(cfg->capacityoftxpacket)) : (NULL);
     retptr->ropframereadytotx       = eo_ropframe_New();
     retptr->ropframeregulars        = eo_ropframe_New();
     retptr->ropframeoccasionals     = eo_ropframe_New();
     retptr->ropframereplies         = eo_ropframe_New();
+    retptr->ropframeinplace         = eo_ropframe_New();
     retptr->roptmp                  = eo_rop_New(cfg->capacityofrop);
     retptr->nvscfg                  = cfg->nvscfg;
     retptr->theagent                = eo_agent_Initialise(NULL);
@@ -141,7 +177,7 @@ extern EOtransmitter* eo_transmitter_New(const eo_transmitter_cfg_t *cfg)
     retptr->bufferropframeregulars  = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, cfg->capacityofropframeregulars, 1);
     retptr->bufferropframeoccasionals = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, cfg->capacityofropframeoccasionals, 1);
     retptr->bufferropframereplies   = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, cfg->capacityofropframereplies, 1);
-    retptr->listofregropinfo        = (0 == cfg->maxnumberofregularrops) ? (NULL) : (eo_list_New(sizeof(eo_transm_regrop_info_t), cfg->maxnumberofregularrops, NULL, 0, NULL, NULL));
+    retptr->regropstable            = (0 == cfg->maxnumberofregularrops) ? (NULL) : (s_eo_transmitter_regrops_New(cfg->maxnumberofregularrops));
     retptr->currenttime             = 0;
     retptr->tx_seqnum               = 0;
 
@@ -172,6 +208,10 @@ extern EOtransmitter* eo_transmitter_New(const eo_transmitter_cfg_t *cfg)
 
         // the destination ipv4addr and ipv4port are constant and are the ones passed through configuration
         eo_packet_Addressing_Set(retptr->txpacket, retptr->ipv4addr, retptr->ipv4port);
+        if(NULL != retptr->txpacketcompact)
+        {
+            eo_packet_Addressing_Set(retptr->txpacketcompact, retptr->ipv4addr, retptr->ipv4port);
+        }
     } 
 
     if((NULL != cfg->mutex_fn_new) && (eo_transmitter_protection_total == cfg->protection))
@@ -180,17 +220,40 @@ extern EOtransmitter* eo_transmitter_New(const eo_transmitter_cfg_t *cfg)
         retptr->mtx_regulars    = cfg->mutex_fn_new();
         retptr->mtx_occasionals = cfg->mutex_fn_new();        
     }
+    else if(eo_transmitter_protection_spsc == cfg->protection)
+    {   // the regulars are loaded rarely and keep their mutex (if any). occasionals and replies use a double buffer.
+        retptr->mtx_replies     = NULL;
+        retptr->mtx_regulars    = (NULL != cfg->mutex_fn_new) ? (cfg->mutex_fn_new()) : (NULL);
+        retptr->mtx_occasionals = NULL;
+    }
     else
     {
         retptr->mtx_replies     = NULL;
         retptr->mtx_regulars    = NULL;
         retptr->mtx_occasionals = NULL;
     }
+
+    if(eo_transmitter_protection_spsc == cfg->protection)
+    {
+        retptr->spsc_occasionals    = s_eo_transmitter_spsc_New(retptr->ropframeoccasionals, cfg->capacityofropframeoccasionals);
+        retptr->spsc_replies        = s_eo_transmitter_spsc_New(retptr->ropframereplies, cfg->capacityofropframereplies);
+    }
+    else
+    {
+        retptr->spsc_occasionals    = NULL;
+        retptr->spsc_replies        = NULL;
+    }
     
 #if defined(USE_DEBUG_EOTRANSMITTER)
     // DEBUG
     retptr->debug.txropframeistoobigforthepacket = 0;
+    retptr->debug.spscdeferred = 0;
+    retptr->debug.txbytesstandard = 0;
+    retptr->debug.txbytescompact = 0;
 #endif
+
+    retptr->ropframeformat          = cfg->ropframeformat;
+    eo_ropframe_compact_Reset(&retptr->compactstate, EOTRANSMITTER_COMPACT_KEYPERIOD);
     
     return(retptr);
 }
@@ -202,13 +265,15 @@ extern EOtransmitter* eo_transmitter_New(const eo_transmitter_cfg_t *cfg)
 
 extern eOresult_t eo_transmitter_regular_rops_Load(EOtransmitter *p, eOropdescriptor_t* ropdesc)//eOropcode_t ropcode, eOnvEP_t nvep, eOnvID_t nvid, eOropconfig_t ropcfg)
 {
-    eo_transm_regrop_info_t regropinfo;
-    eOropdescriptor_t ropdescriptor;
+    eo_transm_regrops_table_t *table = NULL;
+    eo_transm_regrop_info_t *regropinfo = NULL;
     eOresult_t res;
     uint16_t usedbytes;
     uint16_t remainingbytes;
     uint16_t ropstarthere;
     uint16_t ropsize;
+    uint16_t hashpos;
+    uint16_t slot;
     EOnv* tmpnvptr = NULL;
 
     if((NULL == p) || (NULL == ropdesc)) 
@@ -216,39 +281,33 @@ extern eOresult_t eo_transmitter_regular_rops_Load(EOtransmitter *p, eOropdescri
         return(eores_NOK_nullpointer);
     }  
 
-    if(NULL == p->listofregropinfo)
+    if(NULL == p->regropstable)
     {
         // in such a case there is room for regular rops (for instance because the cfg->maxnumberofregularrops is zero)
         return(eores_NOK_generic);
     }
     
+    table = p->regropstable;
     
     eov_mutex_Take(p->mtx_regulars, eok_reltimeINFINITE);
 
-    // work on the list ... 
+    // work on the table ... 
     
-    if(eobool_true == eo_list_Full(p->listofregropinfo))
+    if(table->numberof == table->capacity)
     {
         eov_mutex_Release(p->mtx_regulars);
         return(eores_NOK_generic);
     }
     
-
-    // for searching inside listofregropinfo we need only those three fields: ropcode, id, ep
-    ropdescriptor.ropcode   = ropdesc->ropcode;
-    ropdescriptor.ep        = ropdesc->ep;
-    ropdescriptor.id        = ropdesc->id;
-
-    
-    // search for ropcode+ep+id. if found, then ... return OK and dont do anything because it means that the rop is already inside
-    if(NULL != eo_list_Find(p->listofregropinfo, s_eo_transmitter_ropmatchingrule_rule, &ropdescriptor))
+    // search for ropcode+ep+id. if found, then ... return NOK and dont do anything because it means that the rop is already inside.
+    // if not found, hashpos is the entry of the hashtable where to put it.
+    if(EOK_uint16dummy != s_eo_transmitter_regrops_find(table, ropdesc->ropcode, ropdesc->ep, ropdesc->id, &hashpos))
     {   // it is already inside ...
         eov_mutex_Release(p->mtx_regulars);
         return(eores_NOK_generic);
     }    
     
-    // else ... prepare a temporary variable eo_transm_regrop_info_t to be put inside the list.
-    // and wait success of rop + insetrtion in frame
+    // else ... prepare the rop and fill a free slot only after success of rop + insertion in frame
     
     // 1. prepare the rop to be put inside the ropframe. the rop contains also a reference to the associated netvar   
     res = eo_agent_OutROPinit(p->theagent, p->nvscfg, 
@@ -264,8 +323,13 @@ extern eOresult_t eo_transmitter_regular_rops_Load(EOtransmitter *p, eOropdescri
     tmpnvptr = eo_rop_hid_NV_Get(p->roptmp);
     
 
-    // 2. put the rop inside the ropframe
+    // 2. put the rop inside the ropframe. if there is no room, we try again after removal of the unloaded rops 
     res = eo_ropframe_ROP_Add(p->ropframeregulars, p->roptmp, &ropstarthere, &ropsize, &remainingbytes);
+    if((eores_OK != res) && (0 != table->garbagebytes))
+    {
+        s_eo_transmitter_regrops_compact(p);
+        res = eo_ropframe_ROP_Add(p->ropframeregulars, p->roptmp, &ropstarthere, &ropsize, &remainingbytes);
+    }
     // if we cannot add the rop we quit
     if(eores_OK != res)
     {
@@ -274,18 +338,46 @@ extern eOresult_t eo_transmitter_regular_rops_Load(EOtransmitter *p, eOropdescri
     }
     
     
-    // 3. prepare a regropinfo variable to be put inside the list    
+    // 3. fill a free slot
+    
+    slot = table->firstfree;
+    regropinfo = &table->slots[slot];
+    table->firstfree = regropinfo->next;
     
-    regropinfo.ropcode                  = ropdesc->ropcode;    
-    regropinfo.hasdata2update           = eo_rop_hid_DataField_is_Present(&(p->roptmp->stream.head)); 
-    regropinfo.ropstarthere             = ropstarthere;
-    regropinfo.ropsize                  = ropsize;
-    regropinfo.timeoffsetinsiderop      = (0 == p->roptmp->stream.head.ctrl.plustime) ? (EOK_uint16dummy) : (ropsize - 8); //if we have time, then it is in teh last 8 bytes
-    memcpy(&regropinfo.thenv, tmpnvptr, sizeof(EOnv));
+    regropinfo->ropcode                 = ropdesc->ropcode;    
+    regropinfo->hasdata2update          = eo_rop_hid_DataField_is_Present(&(p->roptmp->stream.head)); 
+    regropinfo->ropstarthere            = ropstarthere;
+    regropinfo->ropsize                 = ropsize;
+    regropinfo->timeoffsetinsiderop     = (0 == p->roptmp->stream.head.ctrl.plustime) ? (EOK_uint16dummy) : (ropsize - 8); //if we have time, then it is in teh last 8 bytes
+    memcpy(&regropinfo->thenv, tmpnvptr, sizeof(EOnv));
+    // a rop is transmitted on change only if it carries data. anyway it is transmitted the first time
+    regropinfo->onchange                = ((1 == ropdesc->configuration.onchange) && (eobool_true == regropinfo->hasdata2update)) ? (eobool_true) : (eobool_false);
+    regropinfo->changed                 = eobool_true;
 
 
-    // 4. finally push back regropinfo inside the list.
-    eo_list_PushBack(p->listofregropinfo, &regropinfo);
+    // 4. finally link the slot after the last one, as its rop is the last inside the ropframe, and index it in the hashtable.
+    regropinfo->next = EOK_uint16dummy;
+    regropinfo->prev = table->last;
+    if(EOK_uint16dummy == table->last)
+    {
+        table->first = slot;
+    }
+    else
+    {
+        table->slots[table->last].next = slot;
+    }
+    table->last = slot;
+    
+    if(EOTRANSMITTER_REGROPS_HASH_DELETED == table->hashtable[hashpos])
+    {
+        table->tombstones --;
+    }
+    table->hashtable[hashpos] = slot;
+    table->numberof ++;
+    if(eobool_true == regropinfo->onchange)
+    {
+        table->numberofonchange ++;
+    }
     
     eov_mutex_Release(p->mtx_regulars);    
     return(eores_OK);   
@@ -294,60 +386,82 @@ extern eOresult_t eo_transmitter_regular_rops_Load(EOtransmitter *p, eOropdescri
 
 extern eOresult_t eo_transmitter_regular_rops_Unload(EOtransmitter *p, eOropdescriptor_t* ropdesc)//eOropcode_t ropcode, eOnvEP_t nvep, eOnvID_t nvid)
 {
-    eo_transm_regrop_info_t regropinfo;
-    eOropdescriptor_t ropdescriptor;
-    EOlistIter *li = NULL;
+    eo_transm_regrops_table_t *table = NULL;
+    eo_transm_regrop_info_t *regropinfo = NULL;
+    uint16_t hashpos;
+    uint16_t slot;
 
-    if(NULL == p) 
+    if((NULL == p) || (NULL == ropdesc)) 
     {
         return(eores_NOK_nullpointer);
     }  
 
-    if(NULL == p->listofregropinfo)
+    if(NULL == p->regropstable)
     {
         // in such a case there is room for regular rops (for instance because the cfg->maxnumberofregularrops is zero)
         return(eores_NOK_generic);
     }
+    
+    table = p->regropstable;
 
-    // work on the list ... 
+    // work on the table ... 
     
     eov_mutex_Take(p->mtx_regulars, eok_reltimeINFINITE);
     
-    if(eobool_true == eo_list_Empty(p->listofregropinfo))
+    if(0 == table->numberof)
     {
         eov_mutex_Release(p->mtx_regulars);
         return(eores_NOK_generic);
     }
-    
-    // need only ropcode, ep and id to search for inside the list listofregropinfo
-    ropdescriptor.ropcode       = ropdesc->ropcode;
-    ropdescriptor.ep            = ropdesc->ep;
-    ropdescriptor.id            = ropdesc->id;
-
       
-    // search for ropcode+nvep+nvid. if not found, then ... return OK and dont do anything.
-    li = eo_list_Find(p->listofregropinfo, s_eo_transmitter_ropmatchingrule_rule, &ropdescriptor);
-    if(NULL == li)
+    // search for ropcode+nvep+nvid. if not found, then ... return NOK and dont do anything.
+    slot = s_eo_transmitter_regrops_find(table, ropdesc->ropcode, ropdesc->ep, ropdesc->id, &hashpos);
+    if(EOK_uint16dummy == slot)
     {   // it is not inside ...
         eov_mutex_Release(p->mtx_regulars);
         return(eores_NOK_generic);
     }
     
-    // copy what is inside the list into a temporary variable
-    memcpy(&regropinfo, eo_list_At(p->listofregropinfo, li), sizeof(eo_transm_regrop_info_t));
+    regropinfo = &table->slots[slot];
+    
+    // the rop stays inside p->ropframeregulars as garbage until the next compaction, which is done at latest
+    // by eo_transmitter_outpacket_Prepare(). by doing so we dont memmove the tail of the ropframe at every unload.
+    table->garbagebytes += regropinfo->ropsize;
     
-    // for each element after li: (name is afterli) retrieve it and modify its content so that ropstarthere is decremented by regropinfo.ropsize ...
-    eo_list_FromIterForEach(p->listofregropinfo, eo_list_Next(p->listofregropinfo, li), s_eo_transmitter_list_shiftdownropinfo, &regropinfo);
+    // mark the entry of the hashtable as deleted, so that the search of the other rops keeps on working
+    table->hashtable[hashpos] = EOTRANSMITTER_REGROPS_HASH_DELETED;
+    table->tombstones ++;
+    
+    // unlink the slot ...
+    if(EOK_uint16dummy == regropinfo->prev)
+    {
+        table->first = regropinfo->next;
+    }
+    else
+    {
+        table->slots[regropinfo->prev].next = regropinfo->next;
+    }
     
-    // remove the element indexedby li
-    eo_list_Erase(p->listofregropinfo, li);
+    if(EOK_uint16dummy == regropinfo->next)
+    {
+        table->last = regropinfo->prev;
+    }
+    else
+    {
+        table->slots[regropinfo->next].prev = regropinfo->prev;
+    }
     
-    // inside the p->ropframeregulars: remove a rop of regropinfo.ropsize whcih starts at regropinfo.ropstartshere. use a _friend method in here defined.
-    //                                  you must: decrement the nrops by 1, decrement the size by regropinfo.ropsize, ... else in header and private variable ...
-    //                                            and finally make a memmove down by regropinfo.ropsize.
+    if(eobool_true == regropinfo->onchange)
+    {
+        table->numberofonchange --;
+    }
     
-    eo_ropframe_ROP_Rem(p->ropframeregulars, regropinfo.ropstarthere, regropinfo.ropsize);
-  
+    // ... and put it amongst the free ones
+    regropinfo->ropcode = eo_ropcode_none;
+    regropinfo->prev    = EOK_uint16dummy;
+    regropinfo->next    = table->firstfree;
+    table->firstfree    = slot;
+    table->numberof --;    
 
     eov_mutex_Release(p->mtx_regulars);
     
@@ -362,7 +476,7 @@ extern eOresult_t eo_transmitter_regular_rops_Clear(EOtransmitter *p)
         return(eores_NOK_nullpointer);
     }  
 
-    if(NULL == p->listofregropinfo)
+    if(NULL == p->regropstable)
     {
         // in such a case there is room for regular rops (for instance because the cfg->maxnumberofregularrops is zero)
         return(eores_OK);
@@ -370,13 +484,13 @@ extern eOresult_t eo_transmitter_regular_rops_Clear(EOtransmitter *p)
     
     eov_mutex_Take(p->mtx_regulars, eok_reltimeINFINITE);
     
-    if(eobool_true == eo_list_Empty(p->listofregropinfo))
+    if((0 == p->regropstable->numberof) && (0 == p->regropstable->garbagebytes))
     {
         eov_mutex_Release(p->mtx_regulars);
         return(eores_OK);
     } 
     
-    eo_list_Clear(p->listofregropinfo);
+    s_eo_transmitter_regrops_reset(p->regropstable);
     
     eo_ropframe_Clear(p->ropframeregulars);
 
@@ -387,20 +501,25 @@ extern eOresult_t eo_transmitter_regular_rops_Clear(EOtransmitter *p)
 
 extern eOresult_t eo_transmitter_regular_rops_Refresh(EOtransmitter *p)
 {
+    eo_transm_regrops_table_t *table = NULL;
+    uint16_t slot;
+    
     if(NULL == p) 
     {
         return(eores_NOK_nullpointer);
     }  
 
-    if(NULL == p->listofregropinfo)
+    if(NULL == p->regropstable)
     {
         // in such a case there is room for regular rops (for instance because the cfg->maxnumberofregularrops is zero)
         return(eores_OK);
     }
     
+    table = p->regropstable;
+    
     eov_mutex_Take(p->mtx_regulars, eok_reltimeINFINITE);
     
-    if(eobool_true == eo_list_Empty(p->listofregropinfo))
+    if(0 == table->numberof)
     {
         eov_mutex_Release(p->mtx_regulars);
         return(eores_OK);
@@ -408,8 +527,11 @@ extern eOresult_t eo_transmitter_regular_rops_Refresh(EOtransmitter *p)
     
     p->currenttime = eov_sys_LifeTimeGet(eov_sys_GetHandle());
     
-    // for each element in the list ... i do: ... see function
-    eo_list_ForEach(p->listofregropinfo, s_eo_transmitter_list_updaterop_in_ropframe, p);
+    // for each used slot ... i do: ... see function
+    for(slot = table->first; EOK_uint16dummy != slot; slot = table->slots[slot].next)
+    {
+        s_eo_transmitter_regrops_updaterop_in_ropframe(p, &table->slots[slot]);
+    }
 
     eov_mutex_Release(p->mtx_regulars);
     
@@ -421,36 +543,16 @@ extern eOresult_t eo_transmitter_regular_rops_Refresh(EOtransmitter *p)
 
 extern eOresult_t eo_transmitter_outpacket_Prepare(EOtransmitter *p, uint16_t *numberofrops)
 {
-    uint16_t remainingbytes;
-
-
     if((NULL == p) || (NULL == numberofrops)) 
     {
         return(eores_NOK_nullpointer);
     }
 
-    
     // clear the content of the ropframe to transmit which uses the same storage of the packet ...
     eo_ropframe_Clear(p->ropframereadytotx);
     
-    // add to it the ropframe of regulars. keep it afterwards. dont clear it !!!
-    eov_mutex_Take(p->mtx_regulars, eok_reltimeINFINITE);
-    eo_ropframe_Append(p->ropframereadytotx, p->ropframeregulars, &remainingbytes);
-    eov_mutex_Release(p->mtx_regulars);
-
-    // add the ropframe of occasionals ... and then clear it
-    eov_mutex_Take(p->mtx_occasionals, eok_reltimeINFINITE);
-    eo_ropframe_Append(p->ropframereadytotx, p->ropframeoccasionals, &remainingbytes);
-    eo_ropframe_Clear(p->ropframeoccasionals);
-    eov_mutex_Release(p->mtx_occasionals);
-
-    // add the ropframe of replies ... and then clear it
-    eov_mutex_Take(p->mtx_replies, eok_reltimeINFINITE);
-    eo_ropframe_Append(p->ropframereadytotx, p->ropframereplies, &remainingbytes);
-    eo_ropframe_Clear(p->ropframereplies);
-    eov_mutex_Release(p->mtx_replies);
-
-    *numberofrops = eo_ropframe_ROP_NumberOf(p->ropframereadytotx);
+    // ... and fill it with regulars, occasionals and replies
+    *numberofrops = s_eo_transmitter_ropframe_compose(p, p->ropframereadytotx);
     
     return(eores_OK);   
 }
@@ -459,29 +561,41 @@ extern eOresult_t eo_transmitter_outpacket_Prepare(EOtransmitter *p, uint16_t *n
 
 extern eOresult_t eo_transmitter_outpacket_Get(EOtransmitter *p, EOpacket **outpkt)
 {
-    uint16_t size;
+    EOpacket *pkt = NULL;
+    uint8_t *data = NULL;
+    uint16_t size = 0;
+    uint16_t capacity = 0;
 
     if((NULL == p) || (NULL == outpkt)) 
     {
         return(eores_NOK_nullpointer);
     }
 
-    // now add the age of the frame
-    eo_ropframe_age_Set(p->ropframereadytotx, eov_sys_LifeTimeGet(eov_sys_GetHandle()));
-    
-    // add sequence number
-
-    p->tx_seqnum++;
-    eo_ropframe_seqnum_Set(p->ropframereadytotx, p->tx_seqnum);
+    // now add the age of the frame and the sequence number
+    s_eo_transmitter_ropframe_stamp(p, p->ropframereadytotx);
 
-    // now set the size of the packet according to what is inside the ropframe.
-    eo_ropframe_Size_Get(p->ropframereadytotx, &size);
-    eo_packet_Size_Set(p->txpacket, size);
+    // in compact format the ropframe is encoded into txpacketcompact, so that ropframereadytotx stays in standard 
+    // format and a second call (e.g., to retransmit) encodes it again. 
+    pkt = p->txpacket;
+    if((eo_ropframe_format_compact == p->ropframeformat) && (NULL != p->txpacketcompact))
+    {
+        eo_packet_Payload_Get(p->txpacketcompact, &data, &size);
+        eo_packet_Capacity_Get(p->txpacketcompact, &capacity);
+        if(eores_OK == s_eo_transmitter_ropframe_encode(p, p->ropframereadytotx, data, capacity, &size))
+        {
+            pkt = p->txpacketcompact;
+        }
+    }
+    
+    if(p->txpacket == pkt)
+    {   // the size of the packet is what is inside the ropframe, which uses the same memory
+        eo_ropframe_Size_Get(p->ropframereadytotx, &size);
+    }
+    eo_packet_Size_Set(pkt, size);
 
 #if defined(USE_DEBUG_EOTRANSMITTER)    
     {   // DEBUG    
-        uint16_t capacity = 0;
-        eo_packet_Capacity_Get(p->txpacket, &capacity);   
+        eo_packet_Capacity_Get(pkt, &capacity);   
         if(size > capacity)
         {
             p->debug.txropframeistoobigforthepacket ++;
@@ -490,12 +604,91 @@ extern eOresult_t eo_transmitter_outpacket_Get(EOtransmitter *p, EOpacket **outp
 #endif
     
     // finally gives back the packet
-    *outpkt = p->txpacket;
+    *outpkt = pkt;
     
     return(eores_OK);   
 }
 
 
+extern eOresult_t eo_transmitter_outpacket_PrepareInto(EOtransmitter *p, uint8_t *buffer, uint16_t capacity, uint16_t *size, uint16_t *numberofrops)
+{
+    if((NULL == p) || (NULL == buffer) || (NULL == size) || (NULL == numberofrops)) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if(capacity < eo_ropframe_sizeforZEROrops)
+    {
+        return(eores_NOK_generic);
+    }
+    
+    if((eo_ropframe_format_compact == p->ropframeformat) && (NULL != p->txpacketcompact))
+    {   // the ropframe is formed inside ropframereadytotx and encoded into the buffer of the caller (or copied as it is 
+        // if it cannot be encoded). thus the rops are copied twice, which is one copy less than eo_transmitter_outpacket_Get()
+        // followed by the copy into the buffer of the ip stack.
+        eo_ropframe_Clear(p->ropframereadytotx);
+        *numberofrops = s_eo_transmitter_ropframe_compose(p, p->ropframereadytotx);
+        s_eo_transmitter_ropframe_stamp(p, p->ropframereadytotx);
+        
+        if(eores_OK != s_eo_transmitter_ropframe_encode(p, p->ropframereadytotx, buffer, capacity, size))
+        {
+            uint8_t *framedata = NULL;
+            uint16_t framecapacity = 0;
+            eo_ropframe_Get(p->ropframereadytotx, &framedata, size, &framecapacity);
+            if(*size > capacity)
+            {
+                *size = 0;
+                return(eores_NOK_generic);
+            }
+            memcpy(buffer, framedata, *size);
+        }
+        
+        return(eores_OK);
+    }
+    
+    // the ropframe is formed directly inside the buffer of the caller, thus we dont use the txpacket at all
+    if(eores_OK != eo_ropframe_Load(p->ropframeinplace, buffer, eo_ropframe_sizeforZEROrops, capacity))
+    {
+        return(eores_NOK_generic);
+    }
+    eo_ropframe_Clear(p->ropframeinplace);
+    
+    *numberofrops = s_eo_transmitter_ropframe_compose(p, p->ropframeinplace);
+    
+    s_eo_transmitter_ropframe_stamp(p, p->ropframeinplace);
+    
+    eo_ropframe_Size_Get(p->ropframeinplace, size);
+    
+    eo_ropframe_Unload(p->ropframeinplace);
+    
+    return(eores_OK);
+}
+
+
+extern eOresult_t eo_transmitter_ropframeformat_Set(EOtransmitter *p, eOropframeFormat_t format)
+{
+    if(NULL == p) 
+    {
+        return(eores_NOK_nullpointer);
+    }
+    
+    if((eo_ropframe_format_compact == format) && (NULL == p->txpacketcompact))
+    {
+        return(eores_NOK_generic);
+    }
+    
+    if(format != p->ropframeformat)
+    {
+        p->ropframeformat = format;
+        // the first compact ropframe must be a key one
+        eo_ropframe_compact_Reset(&p->compactstate, EOTRANSMITTER_COMPACT_KEYPERIOD);
+    }
+    
+    return(eores_OK);
+}
+
+
+
 
 
 
@@ -523,13 +716,14 @@ extern eOresult_t eo_transmitter_occasional_rops_Load_without_data(EOtransmitter
     uint16_t usedbytes;
     uint16_t ropsize;
     uint16_t remainingbytes;
+    EOropframe *occasionals = NULL;
 
     if(NULL == p) 
     {
         return(eores_NOK_nullpointer);
     }  
 
-    eov_mutex_Take(p->mtx_occasionals, eok_reltimeINFINITE);
+    occasionals = s_eo_transmitter_producer_begin(p->mtx_occasionals, p->spsc_occasionals, p->ropframeoccasionals);
    
     // prepare the rop in p->roptmp
     
@@ -539,15 +733,15 @@ extern eOresult_t eo_transmitter_occasional_rops_Load_without_data(EOtransmitter
                               
     if(eores_OK != res)
     {
-        eov_mutex_Release(p->mtx_occasionals);
+        s_eo_transmitter_producer_end(p->mtx_occasionals, p->spsc_occasionals);
         return(res);
     }
 
     // put the rop inside the ropframe
-    res = eo_ropframe_ROP_Add(p->ropframeoccasionals, p->roptmp, NULL, &ropsize, &remainingbytes);
+    res = eo_ropframe_ROP_Add(occasionals, p->roptmp, NULL, &ropsize, &remainingbytes);
     
     
-    eov_mutex_Release(p->mtx_occasionals);
+    s_eo_transmitter_producer_end(p->mtx_occasionals, p->spsc_occasionals);
     
     return(res);   
 }
@@ -568,6 +762,7 @@ extern eOresult_t eo_transmitter_occasional_rops_Load(EOtransmitter *p, eOropdes
     
     EOtreenode* treenode;
     EOnv nv;
+    EOropframe *occasionals = NULL;
     
     eObool_t hasdata2send = eobool_false;    
 
@@ -619,7 +814,7 @@ extern eOresult_t eo_transmitter_occasional_rops_Load(EOtransmitter *p, eOropdes
     }
 
 
-    eov_mutex_Take(p->mtx_occasionals, eok_reltimeINFINITE);
+    occasionals = s_eo_transmitter_producer_begin(p->mtx_occasionals, p->spsc_occasionals, p->ropframeoccasionals);
     
     // prepare the rop in p->roptmp
 //     eOropconfig_t ropcfg;
@@ -632,15 +827,15 @@ extern eOresult_t eo_transmitter_occasional_rops_Load(EOtransmitter *p, eOropdes
     
     if(eores_OK != res)
     {
-        eov_mutex_Release(p->mtx_occasionals);
+        s_eo_transmitter_producer_end(p->mtx_occasionals, p->spsc_occasionals);
         return(res);
     }
 
     // put the rop inside the ropframe
-    res = eo_ropframe_ROP_Add(p->ropframeoccasionals, p->roptmp, NULL, &ropsize, &remainingbytes);
+    res = eo_ropframe_ROP_Add(occasionals, p->roptmp, NULL, &ropsize, &remainingbytes);
     
     
-    eov_mutex_Release(p->mtx_occasionals);
+    s_eo_transmitter_producer_end(p->mtx_occasionals, p->spsc_occasionals);
    
     
     return(res);   
@@ -651,15 +846,16 @@ extern eOresult_t eo_transmitter_reply_ropframe_Load(EOtransmitter *p, EOropfram
 {
     eOresult_t res;
     uint16_t remainingbytes;
+    EOropframe *replies = NULL;
 
     if(NULL == p) 
     {
         return(eores_NOK_nullpointer);
     }  
 
-    eov_mutex_Take(p->mtx_replies, eok_reltimeINFINITE);
-    res = eo_ropframe_Append(p->ropframereplies, ropframe, &remainingbytes);
-    eov_mutex_Release(p->mtx_replies);
+    replies = s_eo_transmitter_producer_begin(p->mtx_replies, p->spsc_replies, p->ropframereplies);
+    res = eo_ropframe_Append(replies, ropframe, &remainingbytes);
+    s_eo_transmitter_producer_end(p->mtx_replies, p->spsc_replies);
 
     return(res);     
 }
@@ -678,43 +874,303 @@ extern eOresult_t eo_transmitter_reply_ropframe_Load(EOtransmitter *p, EOropfram
 // --------------------------------------------------------------------------------------------------------------------
 
 
-// static eOresult_t s_eo_transmitter_listmatching_rule(void *item, void *param)
-// {
-//     eo_transm_regrop_info_t *inside = (eo_transm_regrop_info_t*)item;
-//     eo_transm_regrop_info_t *target = (eo_transm_regrop_info_t*)param;
-//     
-//     if((inside->nvid == target->nvid) && (inside->nvep == target->nvep) && (inside->ropcode == target->ropcode))
-//     {
-//         return(eores_OK);
-//     }
-//     else
-//     {
-//         return(eores_NOK_generic);
-//     }
-// }
+static eo_transm_regrops_table_t* s_eo_transmitter_regrops_New(uint16_t capacity)
+{
+    eo_transm_regrops_table_t *t = NULL;
+    uint32_t hashsize = 4;
+    
+    // the hashtable has at least twice the entries of the slots, so that a search stops soon on an empty entry
+    while(hashsize < (2*(uint32_t)capacity))
+    {
+        hashsize <<= 1;
+    }
+    
+    t = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(eo_transm_regrops_table_t), 1);
+    
+    t->slots        = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(eo_transm_regrop_info_t), capacity);
+    t->hashtable    = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(uint16_t), hashsize);
+    t->capacity     = capacity;
+    t->hashmask     = (uint16_t)(hashsize - 1);
+    
+    s_eo_transmitter_regrops_reset(t);
+    
+    return(t);
+}
 
 
-static eOresult_t s_eo_transmitter_ropmatchingrule_rule(void *item, void *param)
+static void s_eo_transmitter_regrops_reset(eo_transm_regrops_table_t *t)
 {
-    eo_transm_regrop_info_t *inside = (eo_transm_regrop_info_t*)item;
-    eOropdescriptor_t *targetrop = (eOropdescriptor_t*)param;
+    uint16_t i;
     
-    if((inside->thenv.con->id == targetrop->id) && (inside->thenv.ep == targetrop->ep) && (inside->ropcode == targetrop->ropcode))
+    for(i=0; i<t->capacity; i++)
     {
-        return(eores_OK);
+        t->slots[i].ropcode = eo_ropcode_none;
+        t->slots[i].prev    = EOK_uint16dummy;
+        t->slots[i].next    = ((i+1) == t->capacity) ? (EOK_uint16dummy) : (i+1);
+    }
+    
+    for(i=0; i<=t->hashmask; i++)
+    {
+        t->hashtable[i] = EOTRANSMITTER_REGROPS_HASH_EMPTY;
+    }
+    
+    t->numberof     = 0;
+    t->first        = EOK_uint16dummy;
+    t->last         = EOK_uint16dummy;
+    t->firstfree    = (0 == t->capacity) ? (EOK_uint16dummy) : (0);
+    t->tombstones   = 0;
+    t->garbagebytes = 0;
+    t->numberofonchange = 0;
+}
+
+
+EO_static_inline uint16_t s_eo_transmitter_regrops_hash(eo_transm_regrops_table_t *t, eOropcode_t ropcode, eOnvEP_t ep, eOnvID_t id)
+{
+    // multiplicative hashing of ep+id, with the ropcode in the bits which id does not use in practice
+    uint32_t key = ((uint32_t)ep << 16) | ((uint32_t)id);
+    key ^= ((uint32_t)ropcode << 13);
+    key *= 2654435761UL;
+    return((uint16_t)(key >> 16) & t->hashmask);
+}
+
+
+// returns the slot which contains ropcode+ep+id, or EOK_uint16dummy if not found. if hashpos is not NULL it contains 
+// the entry of the hashtable which holds the slot or, if not found, the entry where to place it.
+static uint16_t s_eo_transmitter_regrops_find(eo_transm_regrops_table_t *t, eOropcode_t ropcode, eOnvEP_t ep, eOnvID_t id, uint16_t *hashpos)
+{
+    uint16_t pos = s_eo_transmitter_regrops_hash(t, ropcode, ep, id);
+    uint16_t firstdeleted = EOK_uint16dummy;
+    uint16_t entry;
+    uint32_t n;
+    eo_transm_regrop_info_t *inside = NULL;
+    
+    // linear probing. the entries marked as deleted do not stop the search but can be reused for an insertion
+    for(n=0; n<=t->hashmask; n++)
+    {
+        entry = t->hashtable[pos];
+        
+        if(EOTRANSMITTER_REGROPS_HASH_EMPTY == entry)
+        {
+            break;
+        }
+        else if(EOTRANSMITTER_REGROPS_HASH_DELETED == entry)
+        {
+            if(EOK_uint16dummy == firstdeleted)
+            {
+                firstdeleted = pos;
+            }
+        }
+        else
+        {
+            inside = &t->slots[entry];
+            if((inside->thenv.con->id == id) && (inside->thenv.ep == ep) && (inside->ropcode == ropcode))
+            {
+                if(NULL != hashpos)
+                {
+                    *hashpos = pos;
+                }
+                return(entry);
+            }
+        }
+        
+        pos = (pos + 1) & t->hashmask;
+    }
+    
+    if(NULL != hashpos)
+    {
+        // the hashtable is twice the slots, thus we always have either an empty or a deleted entry
+        *hashpos = (EOK_uint16dummy != firstdeleted) ? (firstdeleted) : (pos);
+    }
+    
+    return(EOK_uint16dummy);
+}
+
+
+static void s_eo_transmitter_regrops_rehash(eo_transm_regrops_table_t *t)
+{
+    uint16_t i;
+    uint16_t slot;
+    uint16_t hashpos;
+    eo_transm_regrop_info_t *inside = NULL;
+    
+    for(i=0; i<=t->hashmask; i++)
+    {
+        t->hashtable[i] = EOTRANSMITTER_REGROPS_HASH_EMPTY;
+    }
+    
+    for(slot = t->first; EOK_uint16dummy != slot; slot = inside->next)
+    {
+        inside = &t->slots[slot];
+        s_eo_transmitter_regrops_find(t, inside->ropcode, inside->thenv.ep, inside->thenv.con->id, &hashpos);
+        t->hashtable[hashpos] = slot;
+    }
+    
+    t->tombstones = 0;
+}
+
+
+static void s_eo_transmitter_regrops_compact(EOtransmitter *p)
+{
+    eo_transm_regrops_table_t *t = p->regropstable;
+    eo_transm_regrop_info_t *inside = NULL;
+    uint16_t writepos = 0;
+    uint16_t slot;
+    
+    // the slots are linked in the same order as their rops inside the ropframe, thus every rop is moved down 
+    // at most once and never over a rop which has not been moved yet.
+    for(slot = t->first; EOK_uint16dummy != slot; slot = inside->next)
+    {
+        inside = &t->slots[slot];
+        
+        if(inside->ropstarthere != writepos)
+        {
+            memmove(eo_ropframe_hid_get_pointer_offset(p->ropframeregulars, writepos), 
+                    eo_ropframe_hid_get_pointer_offset(p->ropframeregulars, inside->ropstarthere), 
+                    inside->ropsize);
+            inside->ropstarthere = writepos;
+        }
+        
+        writepos += inside->ropsize;
+    }
+    
+    eo_ropframe_hid_rops_Set(p->ropframeregulars, t->numberof, writepos);
+    
+    t->garbagebytes = 0;
+}
+
+
+static uint16_t s_eo_transmitter_ropframe_compose(EOtransmitter *p, EOropframe *target)
+{
+    uint16_t remainingbytes;
+    
+    // add to target the ropframe of regulars. keep it afterwards. dont clear it !!!
+    // but before remove from it the rops unloaded since last time.
+    eov_mutex_Take(p->mtx_regulars, eok_reltimeINFINITE);
+    if(NULL != p->regropstable)
+    {
+        if(0 != p->regropstable->garbagebytes)
+        {
+            s_eo_transmitter_regrops_compact(p);
+        }
+        if(p->regropstable->tombstones > (p->regropstable->capacity / 2))
+        {
+            s_eo_transmitter_regrops_rehash(p->regropstable);
+        }
+    }
+    if((NULL == p->regropstable) || (0 == p->regropstable->numberofonchange))
+    {
+        eo_ropframe_Append(target, p->ropframeregulars, &remainingbytes);
     }
     else
+    {   // some rops must be skipped because their value has not changed
+        s_eo_transmitter_regrops_append_changed(p, target);
+    }
+    eov_mutex_Release(p->mtx_regulars);
+
+    // add the ropframe of occasionals ... and then clear it
+    s_eo_transmitter_consumer_take(p, p->mtx_occasionals, p->spsc_occasionals, p->ropframeoccasionals, target);
+
+    // add the ropframe of replies ... and then clear it
+    s_eo_transmitter_consumer_take(p, p->mtx_replies, p->spsc_replies, p->ropframereplies, target);
+
+    return(eo_ropframe_ROP_NumberOf(target));
+}
+
+
+static void s_eo_transmitter_regrops_append_changed(EOtransmitter *p, EOropframe *target)
+{
+    eo_transm_regrops_table_t *t = p->regropstable;
+    eo_transm_regrop_info_t *inside = NULL;
+    uint16_t slot;
+    uint16_t firstslot = EOK_uint16dummy;
+    uint16_t runstart = 0;
+    uint16_t runsize = 0;
+    uint16_t runrops = 0;
+    
+    // the rops to transmit are grouped in runs of contiguous rops inside ropframeregulars, so that a memcpy is done 
+    // for each run and not for each rop. the ropframe is compact because this function is called after compaction.
+    for(slot = t->first; EOK_uint16dummy != slot; slot = inside->next)
     {
-        return(eores_NOK_generic);
+        inside = &t->slots[slot];
+        
+        if((eobool_false == inside->onchange) || (eobool_true == inside->changed))
+        {
+            if(0 == runrops)
+            {
+                firstslot = slot;
+                runstart = inside->ropstarthere;
+            }
+            runsize += inside->ropsize;
+            runrops ++;
+        }
+        else if(0 != runrops)
+        {
+            s_eo_transmitter_regrops_append_run(p, target, firstslot, runstart, runrops, runsize);
+            runsize = 0;
+            runrops = 0;
+        }
+    }
+    
+    if(0 != runrops)
+    {
+        s_eo_transmitter_regrops_append_run(p, target, firstslot, runstart, runrops, runsize);
+    }
+}
+
+
+static void s_eo_transmitter_regrops_append_run(EOtransmitter *p, EOropframe *target, uint16_t firstslot, uint16_t runstart, uint16_t runrops, uint16_t runsize)
+{
+    eo_transm_regrops_table_t *t = p->regropstable;
+    uint16_t slot = firstslot;
+    uint16_t i;
+    
+    if(eores_OK != eo_ropframe_hid_rops_Append(target, eo_ropframe_hid_get_pointer_offset(p->ropframeregulars, runstart), runrops, runsize))
+    {   // the rops did not go out: they keep their changed flag so that they are sent at next cycle
+        return;
+    }
+    
+    // the run is made of runrops consecutive slots of the list starting from firstslot 
+    for(i=0; i<runrops; i++)
+    {
+        t->slots[slot].changed = eobool_false;
+        slot = t->slots[slot].next;
     }
 }
 
 
-static void s_eo_transmitter_list_updaterop_in_ropframe(void *item, void *param)
+static void s_eo_transmitter_ropframe_stamp(EOtransmitter *p, EOropframe *target)
 {
-    eo_transm_regrop_info_t *inside = (eo_transm_regrop_info_t*)item;
-    EOtransmitter *p = (EOtransmitter*)param;
+    // add the age of the frame
+    eo_ropframe_age_Set(target, eov_sys_LifeTimeGet(eov_sys_GetHandle()));
+    
+    // add sequence number
+    p->tx_seqnum++;
+    eo_ropframe_seqnum_Set(target, p->tx_seqnum);
+}
+
+
+// encodes the stamped ropframe in compact format into dest. the ropframe is not changed. if it returns an error the 
+// ropframe must be sent in standard format.
+static eOresult_t s_eo_transmitter_ropframe_encode(EOtransmitter *p, EOropframe *source, uint8_t *dest, uint16_t capacity, uint16_t *size)
+{
+    eOresult_t res = eo_ropframe_compact_Encode(source, &p->compactstate, dest, capacity, size);
+    
+#if defined(USE_DEBUG_EOTRANSMITTER)
+    if(eores_OK == res)
+    {
+        uint16_t standardsize = 0;
+        eo_ropframe_Size_Get(source, &standardsize);
+        p->debug.txbytesstandard += standardsize;
+        p->debug.txbytescompact += *size;
+    }
+#endif
     
+    return(res);
+}
+
+
+static void s_eo_transmitter_regrops_updaterop_in_ropframe(EOtransmitter *p, eo_transm_regrop_info_t *inside)
+{
     uint8_t *origofrop;
     uint8_t *dest;
     
@@ -725,10 +1181,17 @@ static void s_eo_transmitter_list_updaterop_in_ropframe(void *item, void *param)
     // if it has a data field ... copy from the nv to the ropstream
     if(eobool_true == inside->hasdata2update)
     {
-        // by using eo_nv_hid_Fast_LocalMemoryGet() we use the protection which is configured
+        // by using eo_nv_hid_Fast_LocalMemory*() we use the protection which is configured
         // by the EOnvscfg object, and the concurrent access to the netvar is managed
-        // internally the nv object.
-        eo_nv_hid_Fast_LocalMemoryGet(&inside->thenv, dest);
+        // internally the nv object. only the rops sent on change need to know if the value has changed.
+        if(eobool_false == inside->onchange)
+        {
+            eo_nv_hid_Fast_LocalMemoryGet(&inside->thenv, dest);
+        }
+        else if(eobool_true == eo_nv_hid_Fast_LocalMemoryRefresh(&inside->thenv, dest))
+        {
+            inside->changed = eobool_true;
+        }
         
         // with memcpy the copy from local buffer to dest is not protected, thus data format may be corrupt
         // in case any concurrent task is in the process of writing the local buffer.
@@ -748,17 +1211,92 @@ static void s_eo_transmitter_list_updaterop_in_ropframe(void *item, void *param)
 }
 
 
-static void s_eo_transmitter_list_shiftdownropinfo(void *item, void *param)
+
+
+static eo_transm_spsc_t* s_eo_transmitter_spsc_New(EOropframe *ropframe, uint16_t capacity)
+{
+    eo_transm_spsc_t *spsc = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(eo_transm_spsc_t), 1);
+    uint8_t *buffer = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, capacity, 1);
+
+    // the first bank is the ropframe already used w/out spsc. the second one has the same capacity
+    spsc->ropframe[0]   = ropframe;
+    spsc->ropframe[1]   = eo_ropframe_New();
+    eo_ropframe_Load(spsc->ropframe[1], buffer, eo_ropframe_sizeforZEROrops, capacity);
+    eo_ropframe_Clear(spsc->ropframe[1]);
+
+    spsc->writebank     = 0;
+    spsc->producerbusy  = 0;
+    spsc->pendingbank   = EOK_uint08dummy;
+
+    return(spsc);
+}
+
+
+static EOropframe* s_eo_transmitter_producer_begin(EOVmutexDerived *mtx, eo_transm_spsc_t *spsc, EOropframe *ropframe)
 {
-    eo_transm_regrop_info_t *after = (eo_transm_regrop_info_t*)item;
-    eo_transm_regrop_info_t *theone2beremoved = (eo_transm_regrop_info_t*)param;
+    if(NULL == spsc)
+    {
+        eov_mutex_Take(mtx, eok_reltimeINFINITE);
+        return(ropframe);
+    }
 
-    // for each element after: modify its content so that ropstarthere is decremented by theone2beremoved.ropsize
+    // we must declare to be busy before reading writebank: the consumer writes writebank before reading producerbusy.
+    // thus, either we read the bank after the change, or the consumer sees us busy.
+    spsc->producerbusy = 1;
+    EOTRANSMITTER_SPSC_BARRIER();
 
-    after->ropstarthere -= theone2beremoved->ropsize;
+    return(spsc->ropframe[spsc->writebank]);
 }
 
 
+static void s_eo_transmitter_producer_end(EOVmutexDerived *mtx, eo_transm_spsc_t *spsc)
+{
+    if(NULL == spsc)
+    {
+        eov_mutex_Release(mtx);
+        return;
+    }
+
+    EOTRANSMITTER_SPSC_BARRIER();
+    spsc->producerbusy = 0;
+}
+
+
+static void s_eo_transmitter_consumer_take(EOtransmitter *p, EOVmutexDerived *mtx, eo_transm_spsc_t *spsc, EOropframe *ropframe, EOropframe *target)
+{
+    uint16_t remainingbytes;
+
+    if(NULL == spsc)
+    {
+        eov_mutex_Take(mtx, eok_reltimeINFINITE);
+        eo_ropframe_Append(target, ropframe, &remainingbytes);
+        eo_ropframe_Clear(ropframe);
+        eov_mutex_Release(mtx);
+        return;
+    }
+
+    if(EOK_uint08dummy == spsc->pendingbank)
+    {   // the producer shall add its next rops to the other bank
+        spsc->pendingbank   = spsc->writebank;
+        spsc->writebank     = 1 - spsc->pendingbank;
+        EOTRANSMITTER_SPSC_BARRIER();
+    }
+
+    if(0 != spsc->producerbusy)
+    {   // the producer may be still adding a rop to the pending bank: we keep it for next time, so that the order of
+        // the rops is preserved. we dont wait because the producer may have lower priority.
+#if defined(USE_DEBUG_EOTRANSMITTER)
+        p->debug.spscdeferred ++;
+#endif
+        return;
+    }
+
+    EOTRANSMITTER_SPSC_BARRIER();
+    eo_ropframe_Append(target, spsc->ropframe[spsc->pendingbank], &remainingbytes);
+    eo_ropframe_Clear(spsc->ropframe[spsc->pendingbank]);
+    spsc->pendingbank = EOK_uint08dummy;
+}
+
 
 // --------------------------------------------------------------------------------------------------------------------
 // - end-of-file (leave a blank line after)
@@ -67,7 +67,10 @@ typedef struct EOtransmitter_hid EOtransmitter;
 typedef enum
 {
     eo_transmitter_protection_none      = 0,
-    eo_transmitter_protection_total     = 1
+    eo_transmitter_protection_total     = 1,
+    eo_transmitter_protection_spsc      = 2     /**< only one task loads occasionals and replies and only one task prepares the packet:
+                                                     the occasionals and the replies are double-buffered and are exchanged w/out mutex.
+                                                     the regulars are still protected by a mutex. */
 } eOtransmitter_protection_t;
 
 typedef struct
@@ -83,6 +86,9 @@ typedef struct
     eOipv4port_t                    ipv4port;
     eov_mutex_fn_mutexderived_new   mutex_fn_new;
     eOtransmitter_protection_t      protection;    
+    eOropframeFormat_t              ropframeformat;     // the format of the ropframes on the wire. it can be changed with eo_transmitter_ropframeformat_Set()
+    eObool_t                        compactallowed;     // if eobool_true (or if ropframeformat is compact) a second packet of capacityoftxpacket bytes
+                                                        // holds the ropframes encoded in compact format, so that they can be sent in that format
 } eo_transmitter_cfg_t;
 
 
@@ -135,7 +141,31 @@ extern eOresult_t eo_transmitter_outpacket_Prepare(EOtransmitter *p, uint16_t *n
 extern eOresult_t eo_transmitter_outpacket_Get(EOtransmitter *p, EOpacket **outpkt);
 
 
+/** @fn         extern eOresult_t eo_transmitter_outpacket_PrepareInto(EOtransmitter *p, uint8_t *buffer, uint16_t capacity, uint16_t *size, uint16_t *numberofrops)
+    @brief      it does what eo_transmitter_outpacket_Prepare() and eo_transmitter_outpacket_Get() do, but the ropframe is formed 
+                directly inside a buffer given by the caller, typically the transmission buffer of the IP stack. by doing so, the 
+                rops of regulars, occasionals and replies are copied only once on their way to the network (twice in compact
+                format, where they are first formed in standard format and then encoded into the buffer). the txpacket is 
+                not used and the buffer can be given back to the IP stack as soon as the function returns.
+    @param      p               poiter to transmitter        
+    @param      buffer          the memory where to form the ropframe
+    @param      capacity        the size of buffer
+    @param      size            in output will contain the size of the formed ropframe
+    @param      numberofrops    in output will contain number of rops contained in the ropframe
+    @return     eores_OK, eores_NOK_nullpointer or eores_NOK_generic if capacity is too small even for an empty ropframe.
+ **/
+extern eOresult_t eo_transmitter_outpacket_PrepareInto(EOtransmitter *p, uint8_t *buffer, uint16_t capacity, uint16_t *size, uint16_t *numberofrops);
+
 
+/** @fn         extern eOresult_t eo_transmitter_ropframeformat_Set(EOtransmitter *p, eOropframeFormat_t format)
+    @brief      sets the format of the next transmitted ropframes. when the format becomes compact the first ropframe is a key one.
+                a ropframe which cannot be expressed in compact format is sent in standard format.
+    @param      p               poiter to transmitter        
+    @param      format          the format
+    @return     eores_OK, eores_NOK_nullpointer or eores_NOK_generic if the format is compact and the transmitter was not
+                created with compactallowed.
+ **/
+extern eOresult_t eo_transmitter_ropframeformat_Set(EOtransmitter *p, eOropframeFormat_t format);
 
 
 
@@ -39,7 +39,6 @@ extern "C" {
 #include "EOrop.h"
 #include "EOnvsCfg.h"
 #include "EOtheAgent.h"
-#include "EOlist.h"
 #include "EOVmutex.h"
 #include "EOnv_hid.h"
 
@@ -52,23 +51,65 @@ extern "C" {
 
 #define USE_DEBUG_EOTRANSMITTER
 
+// in compact format a key ropframe (with full age and sequence number) is sent every so many ropframes. the receiver
+// cannot decode the other ones until it gets its first key ropframe, thus the period is also the max number of ropframes
+// lost at the start of a stream (or after a restart of the transmitter) if the key is lost.
+#define EOTRANSMITTER_COMPACT_KEYPERIOD     16
+
 // - definition of the hidden struct implementing the object ----------------------------------------------------------
 
 
-typedef struct      // 40 bytes on arm .... 
+typedef struct      // 48 bytes on arm .... 
 {
-    eOropcode_t     ropcode;
+    eOropcode_t     ropcode;        // if eo_ropcode_none the slot is free
     eObool_t        hasdata2update;       
     uint16_t        ropstarthere;   // the index where the rop starts inside teh ropframe. if data is available, then it is placed at ropstarthere+8
     uint16_t        ropsize;
     uint16_t        timeoffsetinsiderop;     // if time is not present its value is 0xffff 
     EOnv            thenv;
-} eo_transm_regrop_info_t; //EO_VERIFYsizeof(eo_transm_regrop_info_t, (10*4));
+    uint16_t        next;           // slot of the rop which follows inside the ropframe (or next free slot). EOK_uint16dummy if none
+    uint16_t        prev;           // slot of the rop which precedes inside the ropframe. EOK_uint16dummy if none
+    eObool_t        onchange;       // if eobool_true the rop is transmitted only when its value has changed
+    eObool_t        changed;        // the value has changed since last transmission
+    uint8_t         filler[2];
+} eo_transm_regrop_info_t; //EO_VERIFYsizeof(eo_transm_regrop_info_t, (12*4));
+
+
+typedef struct
+{
+    eo_transm_regrop_info_t*    slots;          // the regular rops. they are linked in the order they have inside ropframeregulars
+    uint16_t*                   hashtable;      // maps ropcode+ep+id into the index of a slot. it has hashmask+1 entries
+    uint16_t                    capacity;       // number of slots
+    uint16_t                    hashmask;       // number of entries of hashtable minus 1. it is a power of two minus 1
+    uint16_t                    numberof;       // number of used slots
+    uint16_t                    first;          // slot of the first rop inside ropframeregulars
+    uint16_t                    last;           // slot of the last rop inside ropframeregulars
+    uint16_t                    firstfree;      // head of the free slots, linked by their .next field
+    uint16_t                    tombstones;     // number of entries of hashtable marked as deleted
+    uint16_t                    garbagebytes;   // bytes of unloaded rops still inside ropframeregulars: they are removed by compaction
+    uint16_t                    numberofonchange;   // number of used slots whose rop is transmitted only on change
+    uint16_t                    filler;
+} eo_transm_regrops_table_t;
+
+
+// double buffer used with eo_transmitter_protection_spsc. the producer adds its rops into ropframe[writebank]. the
+// consumer moves writebank onto the other bank and empties the former one only if the producer is not busy on it.
+typedef struct
+{
+    EOropframe*                 ropframe[2];
+    volatile uint8_t            writebank;      // the bank where the producer adds its rops. it is changed only by the consumer
+    volatile uint8_t            producerbusy;   // not zero while the producer is adding a rop
+    uint8_t                     pendingbank;    // the bank which the consumer must still empty, or EOK_uint08dummy
+    uint8_t                     filler[1];
+} eo_transm_spsc_t;
 
 
 typedef struct
 {
     uint32_t    txropframeistoobigforthepacket;
+    uint32_t    spscdeferred;   // times the consumer has found the producer busy and has postponed a bank
+    uint32_t    txbytesstandard;    // bytes of the ropframes sent in compact format, as if they were in standard format
+    uint32_t    txbytescompact;     // bytes of the ropframes sent in compact format
 } EOtransmitterDEBUG_t;
 
 
@@ -81,10 +122,12 @@ typedef struct
 struct EOtransmitter_hid 
 {
     EOpacket*                   txpacket;
+    EOpacket*                   txpacketcompact;        // where ropframereadytotx is encoded in compact format. NULL if compact is not allowed
     EOropframe*                 ropframereadytotx;
     EOropframe*                 ropframeregulars;
     EOropframe*                 ropframeoccasionals;    
     EOropframe*                 ropframereplies;
+    EOropframe*                 ropframeinplace;        // used to form the outgoing ropframe inside a buffer given by the caller
     EOrop*                      roptmp;
     EOnvsCfg*                   nvscfg;
     EOtheAgent*                 theagent;
@@ -93,12 +136,16 @@ struct EOtransmitter_hid
     uint8_t*                    bufferropframeregulars;
     uint8_t*                    bufferropframeoccasionals;
     uint8_t*                    bufferropframereplies;
-    EOlist*                     listofregropinfo; 
+    eo_transm_regrops_table_t*  regropstable; 
     eOabstime_t                 currenttime;   
     EOVmutexDerived*            mtx_replies;
     EOVmutexDerived*            mtx_regulars;
     EOVmutexDerived*            mtx_occasionals;
+    eo_transm_spsc_t*           spsc_occasionals;       // not NULL only with eo_transmitter_protection_spsc
+    eo_transm_spsc_t*           spsc_replies;           // not NULL only with eo_transmitter_protection_spsc
     uint64_t                    tx_seqnum;
+    eOropframeFormat_t          ropframeformat;
+    eOropframeCompactState_t    compactstate;
 #if defined(USE_DEBUG_EOTRANSMITTER)    
     EOtransmitterDEBUG_t        debug;
 #endif    
@@ -0,0 +1,532 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       velest-test.c
+    @brief      host test of the velocity estimators of velest.c of the 2foc, compared with the complex velocity
+                calculation which was in velocity.c before them. both are fed by the same trace of positions, which is
+                pushed at the rate of the foc loop (PWMFREQUENCY) while the velocity is read at W_COMPLEX_CALCULATION_FREQ.
+                it prints for each of them the mean and rms error against the true velocity and the nanoseconds spent
+                in one velocity period (the pushes of the foc loop plus one read). it checks that:
+                - each estimator is more accurate than the old calculation on a slow noisy trace and on a fast one.
+                - mean and lsq are exact at constant velocity.
+                - skipzeros ignores the samples repeated by the absolute encoder.
+                - the adaptive window gives a non zero velocity at a speed where the old calculation gives zero.
+                usage: velest-test [-n velocity periods of the benchmark]
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "math.h"
+#include "time.h"
+#include "velest.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)    s_test_check((cond), #cond, __LINE__)
+
+// as in UserParms.h and System.h of 2foc-icubProto with a high resolution encoder
+#define PWMFREQUENCY                        40000
+#define W_COMPLEX_CALCULATION_FREQ          1000
+#define W_SIMPLE_CALCULATION_UNDERSAMPLE    19
+#define VELOCITY_WINDOW_LOG2                5
+#define VELOCITY_ADAPTIVE_MINCOUNTS         16
+#define IRP_PERCALC                         (PWMFREQUENCY/W_COMPLEX_CALCULATION_FREQ)
+
+// as in velocity.h before velest.c
+#define POSITIONS_BUFFER_PAST_HISTORY       5
+#define VELOCITY_SAMPLE_COUNT_THRESHOLD     10
+#define POSITIONS_BUFFER_SAFETY_MARGIN      20
+#define POSITIONS_BUFFER_NUM                (IRP_PERCALC + POSITIONS_BUFFER_SAFETY_MARGIN + POSITIONS_BUFFER_PAST_HISTORY)
+
+// the velocity is compared in counts per W_SIMPLE_CALCULATION_UNDERSAMPLE+1 foc loops, as velocity.c gives it
+#define TEST_SCALE                          (W_SIMPLE_CALCULATION_UNDERSAMPLE + 1)
+
+// the old calculation plus the three estimators
+#define TEST_ESTIMATORS                     4
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    unsigned long positions_buffer[POSITIONS_BUFFER_NUM];
+    unsigned int positions_buffer_index;
+    unsigned int positions_buffer_index_r;
+    int last_velocity;
+} test_oldvelocity_t;
+
+typedef struct
+{
+    double  abserror;
+    double  sqerror;
+    double  nanosecs;
+} test_result_t;
+
+// the velocity in counts per foc loop at a given time in seconds
+typedef double (*test_profile_t)(double sec);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+
+static void s_old_init(long position);
+static void s_old_push(long position);
+static int s_old_get(void);
+
+static void s_test_init_all(long position);
+static void s_test_push(int e, long position);
+static long s_test_get(int e);
+
+static double s_test_profile_slow(double sec);
+static double s_test_profile_fast(double sec);
+static void s_test_trace(const char *name, test_profile_t profile, double seconds, test_result_t *results);
+static void s_test_cost(uint32_t periods, test_result_t *results);
+static void s_test_print(const char *name, const test_result_t *results);
+
+static void s_test_accuracy(uint32_t periods);
+static void s_test_constant(void);
+static void s_test_skipzeros(void);
+static void s_test_lowspeed(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static const char * const s_test_names[TEST_ESTIMATORS] = { "old", "mean", "adaptive", "lsq" };
+static const tVelEstKind s_test_kinds[TEST_ESTIMATORS] = { VELEST_MEAN, VELEST_MEAN, VELEST_ADAPTIVE, VELEST_LSQ };
+
+static test_oldvelocity_t s_old;
+static tVelEst s_test_estimators[TEST_ESTIMATORS];
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    uint32_t periods = 200000;
+    int i;
+
+    for(i=1; i<argc; i++)
+    {
+        if((0 == strcmp(argv[i], "-n")) && (i+1 < argc))
+        {
+            periods = (uint32_t)atoi(argv[++i]);
+        }
+        else
+        {
+            printf("usage: velest-test [-n velocity periods of the benchmark]\n");
+            return(EXIT_FAILURE);
+        }
+    }
+
+    s_test_accuracy(periods);
+    s_test_constant();
+    s_test_skipzeros();
+    s_test_lowspeed();
+
+    if(0 != s_test_failures)
+    {
+        printf("velest-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("velest-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        printf("velest-test: line %d: %s failed\n", line, str);
+        s_test_failures++;
+    }
+}
+
+
+static void s_old_init(long position)
+{
+    int i;
+
+    for(i=0; i<POSITIONS_BUFFER_NUM; i++)
+    {
+        s_old.positions_buffer[i] = position;
+    }
+    s_old.positions_buffer_index = 0;
+    s_old.positions_buffer_index_r = 0;
+    s_old.last_velocity = 0;
+}
+
+
+// as the foc loop of 2FOC.c filled the ring buffer
+static void s_old_push(long position)
+{
+    int idx;
+
+    idx = (s_old.positions_buffer_index+1) % POSITIONS_BUFFER_NUM;
+    s_old.positions_buffer[idx] = (position);
+    s_old.positions_buffer_index = idx;
+}
+
+
+// the _T2Interrupt() of velocity.c for an incremental encoder. it gives counts per foc loop
+static int s_old_get(void)
+{
+    int vel;
+    int space = 0;
+    long time;
+    int last_idx, start_idx, stop_idx, r_idx;
+    int i,cnt;
+    long mean;
+
+    last_idx = s_old.positions_buffer_index;
+    start_idx = (last_idx - IRP_PERCALC );
+    stop_idx = (last_idx - 1);
+
+    if(start_idx < 0)
+    {
+        start_idx += POSITIONS_BUFFER_NUM;
+    }
+
+    if(stop_idx < 0)
+    {
+        stop_idx += POSITIONS_BUFFER_NUM;
+    }
+
+    mean = 0;
+    cnt = 0;
+
+    for(i=start_idx; i!=stop_idx; i = (i+1) % POSITIONS_BUFFER_NUM)
+    {
+        space = s_old.positions_buffer[(i+1) % POSITIONS_BUFFER_NUM] - s_old.positions_buffer[i];
+        mean += space;
+        cnt++;
+        if(mean > 0x7FFFFFFF)
+            break;
+    }
+
+    if((cnt < VELOCITY_SAMPLE_COUNT_THRESHOLD) && (mean <= 0x7FFFFFFF) )
+    {
+        stop_idx = (start_idx - 1);
+
+        if(stop_idx < 0)
+        {
+            stop_idx += POSITIONS_BUFFER_NUM;
+        }
+
+        start_idx = (stop_idx - POSITIONS_BUFFER_PAST_HISTORY);
+
+        if(start_idx < 0)
+        {
+            start_idx += POSITIONS_BUFFER_NUM;
+        }
+
+        for(i=stop_idx; i!=start_idx; i = i-3)
+        {
+            if(i < 0)
+            {
+                i += POSITIONS_BUFFER_NUM;
+            }
+            space = s_old.positions_buffer[(i+3) % POSITIONS_BUFFER_NUM] - s_old.positions_buffer[i];
+            mean += space;
+            cnt+=3;
+            if(cnt >= VELOCITY_SAMPLE_COUNT_THRESHOLD)
+                break;
+        }
+    }
+
+    if(cnt > 1)
+        mean /= cnt;
+
+    time = 1;
+    vel = mean / time;
+
+    r_idx = last_idx - POSITIONS_BUFFER_PAST_HISTORY;
+    if(r_idx < 0)
+    {
+        r_idx += POSITIONS_BUFFER_NUM;
+    }
+    s_old.positions_buffer_index_r = r_idx;
+
+    s_old.last_velocity = (vel + s_old.last_velocity)/2;
+
+    return(s_old.last_velocity);
+}
+
+
+static void s_test_init_all(long position)
+{
+    int e;
+
+    s_old_init(position);
+
+    for(e=1; e<TEST_ESTIMATORS; e++)
+    {
+        VelEstInit(&s_test_estimators[e], s_test_kinds[e], VELOCITY_WINDOW_LOG2, VELOCITY_ADAPTIVE_MINCOUNTS,
+                   TEST_SCALE, 0, position);
+    }
+}
+
+
+static void s_test_push(int e, long position)
+{
+    if(0 == e)
+    {
+        s_old_push(position);
+    }
+    else
+    {
+        VelEstPush(&s_test_estimators[e], position);
+    }
+}
+
+
+// in counts per TEST_SCALE foc loops
+static long s_test_get(int e)
+{
+    return((0 == e) ? ((long)s_old_get() * TEST_SCALE) : (long)VelEstGet(&s_test_estimators[e]));
+}
+
+
+// a slow sine up to 0.3 counts per foc loop, as a joint which moves slowly back and forth
+static double s_test_profile_slow(double sec)
+{
+    return(0.3 * sin(2.0 * M_PI * sec));
+}
+
+
+// a ramp from 0 to 40 counts per foc loop in half a second and then a constant speed
+static double s_test_profile_fast(double sec)
+{
+    return((sec < 0.5) ? (80.0 * sec) : 40.0);
+}
+
+
+// the positions are those of a real motor plus a noise of one count, quantised as the encoder does
+static void s_test_trace(const char *name, test_profile_t profile, double seconds, test_result_t *results)
+{
+    uint32_t loops = (uint32_t)(seconds * PWMFREQUENCY);
+    uint32_t reads = 0;
+    double position = 0.0;
+    double velocity = 0.0;
+    uint32_t t;
+    int e;
+
+    memset(results, 0, TEST_ESTIMATORS * sizeof(test_result_t));
+    s_test_init_all(0);
+    srand(1);
+
+    for(t=0; t<loops; t++)
+    {
+        long sample;
+
+        velocity = profile((double)t / PWMFREQUENCY);
+        position += velocity;
+        sample = (long)floor(position + (double)(rand() % 3 - 1));
+
+        for(e=0; e<TEST_ESTIMATORS; e++)
+        {
+            s_test_push(e, sample);
+        }
+
+        // skip the first reads, when the windows still see the initial position
+        if((IRP_PERCALC - 1 == t % IRP_PERCALC) && (t >= 10 * IRP_PERCALC))
+        {
+            double truev = velocity * TEST_SCALE;
+
+            for(e=0; e<TEST_ESTIMATORS; e++)
+            {
+                double error = (double)s_test_get(e) - truev;
+                results[e].abserror += fabs(error);
+                results[e].sqerror += error * error;
+            }
+            reads++;
+        }
+    }
+
+    for(e=0; e<TEST_ESTIMATORS; e++)
+    {
+        results[e].abserror /= (double)reads;
+        results[e].sqerror = sqrt(results[e].sqerror / (double)reads);
+    }
+
+    s_test_print(name, results);
+}
+
+
+static void s_test_cost(uint32_t periods, test_result_t *results)
+{
+    volatile long sink = 0;
+    struct timespec start;
+    struct timespec stop;
+    long position = 0;
+    uint32_t p;
+    uint32_t i;
+    int e;
+
+    for(e=0; e<TEST_ESTIMATORS; e++)
+    {
+        s_test_init_all(0);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for(p=0; p<periods; p++)
+        {
+            for(i=0; i<IRP_PERCALC; i++)
+            {
+                position += 3;
+                s_test_push(e, position);
+            }
+            sink += s_test_get(e);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &stop);
+        results[e].nanosecs = ((double)(stop.tv_sec - start.tv_sec) * 1e9 + (double)(stop.tv_nsec - start.tv_nsec)) / (double)periods;
+    }
+}
+
+
+static void s_test_print(const char *name, const test_result_t *results)
+{
+    int e;
+
+    for(e=0; e<TEST_ESTIMATORS; e++)
+    {
+        printf("%-5s %-9s mean|err| %7.2f rms %7.2f counts/%d loops\n", name, s_test_names[e],
+               results[e].abserror, results[e].sqerror, TEST_SCALE);
+    }
+}
+
+
+static void s_test_accuracy(uint32_t periods)
+{
+    test_result_t slow[TEST_ESTIMATORS];
+    test_result_t fast[TEST_ESTIMATORS];
+    test_result_t cost[TEST_ESTIMATORS];
+    int e;
+
+    s_test_trace("slow", s_test_profile_slow, 2.0, slow);
+    s_test_trace("fast", s_test_profile_fast, 2.0, fast);
+    s_test_cost(periods, cost);
+
+    for(e=0; e<TEST_ESTIMATORS; e++)
+    {
+        printf("%-9s %8.1f ns per velocity period (%d pushes and one read)\n", s_test_names[e], cost[e].nanosecs, IRP_PERCALC);
+    }
+
+    for(e=1; e<TEST_ESTIMATORS; e++)
+    {
+        TEST_CHECK(slow[e].abserror < slow[0].abserror);
+        TEST_CHECK(fast[e].abserror < fast[0].abserror);
+    }
+}
+
+
+// 7 counts per foc loop are 140 counts per TEST_SCALE loops
+static void s_test_constant(void)
+{
+    tVelEst ve;
+    int i;
+
+    VelEstInit(&ve, VELEST_MEAN, VELOCITY_WINDOW_LOG2, VELOCITY_ADAPTIVE_MINCOUNTS, TEST_SCALE, 0, 1000);
+    for(i=1; i<100; i++)
+    {
+        VelEstPush(&ve, 1000 + 7*i);
+    }
+    TEST_CHECK(140 == VelEstGet(&ve));
+
+    VelEstInit(&ve, VELEST_LSQ, VELOCITY_WINDOW_LOG2, VELOCITY_ADAPTIVE_MINCOUNTS, TEST_SCALE, 0, 1000);
+    for(i=1; i<100; i++)
+    {
+        VelEstPush(&ve, 1000 - 7*i);
+    }
+    TEST_CHECK(-140 == VelEstGet(&ve));
+
+    // the init gives zero velocity
+    VelEstInit(&ve, VELEST_ADAPTIVE, VELOCITY_WINDOW_LOG2, VELOCITY_ADAPTIVE_MINCOUNTS, TEST_SCALE, 0, 1000);
+    TEST_CHECK(0 == VelEstGet(&ve));
+}
+
+
+// the absolute encoder repeats each sample once: 6 counts per new sample are 120 counts per TEST_SCALE samples
+static void s_test_skipzeros(void)
+{
+    tVelEst ve;
+    int i;
+
+    VelEstInit(&ve, VELEST_MEAN, VELOCITY_WINDOW_LOG2, VELOCITY_ADAPTIVE_MINCOUNTS, TEST_SCALE, 1, 0);
+    for(i=1; i<100; i++)
+    {
+        VelEstPush(&ve, (i/2) * 6);
+    }
+    TEST_CHECK(120 == VelEstGet(&ve));
+}
+
+
+// one count every 50 foc loops: the old calculation sees at most one count in its 40 loops and gives zero after the
+// integer division, the adaptive window still sees it
+static void s_test_lowspeed(void)
+{
+    long olds = 0;
+    long adaptive = 0;
+    uint32_t t;
+
+    s_test_init_all(0);
+
+    for(t=1; t<=50*IRP_PERCALC; t++)
+    {
+        s_test_push(0, t / 50);
+        s_test_push(2, t / 50);
+        if(0 == t % IRP_PERCALC)
+        {
+            olds += labs(s_test_get(0));
+            adaptive += labs(s_test_get(2));
+        }
+    }
+
+    TEST_CHECK(0 == olds);
+    TEST_CHECK(0 != adaptive);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
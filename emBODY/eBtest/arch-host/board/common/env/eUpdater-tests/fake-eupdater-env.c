@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       fake-eupdater-env.c
+    @brief      host replacement of what updater-core.c uses besides hal_flash: the shared services, osal, the other
+                parts of hal and the rest of the eUpdater. they do nothing, as the tests look only at the flash.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "string.h"
+#include "hal.h"
+#include "osal.h"
+#include "eEsharedServices.h"
+#include "eupdater_parser.h"
+#include "eupdater_cangtw.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static const eEipnetwork_t s_fake_ipnetwork = { 0 };
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+// hal
+
+extern void hal_sys_irq_disable(void)
+{
+}
+
+
+extern void hal_sys_irq_enable(void)
+{
+}
+
+
+extern hal_result_t hal_sys_systemreset(void)
+{
+    return(hal_res_OK);
+}
+
+
+extern hal_result_t hal_gpio_init(hal_gpio_t gpio, const hal_gpio_cfg_t* cfg)
+{
+    return(hal_res_OK);
+}
+
+
+extern hal_result_t hal_led_toggle(hal_led_t id)
+{
+    return(hal_res_OK);
+}
+
+
+extern hal_result_t hal_eeprom_erase(hal_eeprom_t id, uint32_t addr, uint32_t size)
+{
+    return(hal_res_OK);
+}
+
+
+extern hal_result_t hal_eeprom_read(hal_eeprom_t id, uint32_t addr, uint32_t size, void *data)
+{
+    memset(data, 0xFF, size);
+    return(hal_res_OK);
+}
+
+
+extern int hal_trace_puts(const char * str)
+{
+    return(0);
+}
+
+
+// osal
+
+extern void osal_system_scheduling_suspend(void)
+{
+}
+
+
+extern void osal_system_scheduling_restart(void)
+{
+}
+
+
+extern osal_result_t osal_task_wait(osal_reltime_t time)
+{
+    return(osal_res_OK);
+}
+
+
+// the shared services
+
+extern eEresult_t ee_sharserv_info_deviceinfo_item_get(ee_sharserv_info_deviceinfo_item_t item, const void** data)
+{
+    *data = &s_fake_ipnetwork;
+    return(ee_res_OK);
+}
+
+
+extern eEresult_t ee_sharserv_info_deviceinfo_item_set(ee_sharserv_info_deviceinfo_item_t item, const void* data)
+{
+    return(ee_res_OK);
+}
+
+
+extern eEresult_t ee_sharserv_ipc_gotoproc_set(eEprocess_t pr)
+{
+    return(ee_res_OK);
+}
+
+
+extern const eEmoduleInfo_t * ee_sharserv_moduleinfo_get(void)
+{
+    return(NULL);
+}
+
+
+extern eEresult_t ee_sharserv_part_proc_allavailable_get(const eEprocess_t **table, uint8_t *size)
+{
+    *size = 0;
+    return(ee_res_NOK_generic);
+}
+
+
+extern eEresult_t ee_sharserv_part_proc_def2run_get(eEprocess_t *proc)
+{
+    *proc = ee_procApplication;
+    return(ee_res_OK);
+}
+
+
+extern eEresult_t ee_sharserv_part_proc_def2run_set(eEprocess_t proc)
+{
+    return(ee_res_OK);
+}
+
+
+extern eEresult_t ee_sharserv_part_proc_get(eEprocess_t proc, const eEmoduleInfo_t **moduleinfo)
+{
+    return(ee_res_NOK_generic);
+}
+
+
+extern eEresult_t ee_sharserv_part_proc_rem(eEprocess_t proc)
+{
+    return(ee_res_OK);
+}
+
+
+extern eEresult_t ee_sharserv_part_proc_startup_get(eEprocess_t *proc)
+{
+    *proc = ee_procUpdater;
+    return(ee_res_OK);
+}
+
+
+extern eEresult_t ee_sharserv_part_proc_startup_set(eEprocess_t proc)
+{
+    return(ee_res_OK);
+}
+
+
+extern eEresult_t ee_sharserv_part_proc_synchronise(eEprocess_t proc, const eEmoduleInfo_t *moduleinfo)
+{
+    return(ee_res_OK);
+}
+
+
+extern eEresult_t ee_sharserv_storage_isvalid(void)
+{
+    return(ee_res_NOK_generic);
+}
+
+
+extern const eEmoduleInfo_t * ee_sharserv_storage_moduleinfo_get(void)
+{
+    return(NULL);
+}
+
+
+extern eEresult_t ee_sharserv_sys_restart(void)
+{
+    return(ee_res_OK);
+}
+
+
+extern eEresult_t ee_sharserv_sys_storage_clr(const eEstorage_t *strg, const uint32_t size)
+{
+    return(ee_res_OK);
+}
+
+
+// the rest of the eUpdater
+
+extern void eupdater_parser_download_blinkled_start(void)
+{
+}
+
+
+extern void eupdater_parser_download_toggleled(void)
+{
+}
+
+
+extern void eupdater_parser_download_blinkled_stop(void)
+{
+}
+
+
+extern void eupdater_cangtw_start(eOipv4addr_t remipaddr)
+{
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
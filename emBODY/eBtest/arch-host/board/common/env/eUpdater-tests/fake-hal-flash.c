@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#define _GNU_SOURCE
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "sys/mman.h"
+#include "hal.h"
+#include "eEmemorymap.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of extern public interface
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "fake-hal-flash.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint8_t s_fake_flash_isvalid(uint32_t addr, uint32_t size);
+static uint32_t s_fake_flash_sector_get(uint32_t addr);
+static hal_result_t s_fake_flash_program(uint32_t addr, const uint8_t *data, uint32_t size);
+static hal_result_t s_fake_flash_rejected(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint8_t *s_fake_flash = NULL;
+
+static fake_hal_flash_counters_t s_fake_flash_counters = { 0 };
+
+static uint32_t s_fake_flash_sectorerases[12] = { 0 };
+
+// the sectors of the stm32f4 with 1M of flash
+static const uint32_t s_fake_flash_sectors[] = 
+{
+    0x00000, 0x04000, 0x08000, 0x0C000, 0x10000, 0x20000, 0x40000, 0x60000, 0x80000, 0xA0000, 0xC0000, 0xE0000, 0x100000
+};
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+extern void fake_hal_flash_Reset(void)
+{
+    if(NULL == s_fake_flash)
+    {
+        void *p = mmap((void*)(uintptr_t)EENV_ROMSTART, EENV_ROMSIZE, PROT_READ | PROT_WRITE, 
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        
+        if((MAP_FAILED == p) || ((void*)(uintptr_t)EENV_ROMSTART != p))
+        {
+            fprintf(stderr, "fake-hal-flash: cannot map the flash at 0x%08x\n", (unsigned)EENV_ROMSTART);
+            abort();
+        }
+        s_fake_flash = p;
+    }
+    
+    memset(s_fake_flash, 0xFF, EENV_ROMSIZE);
+    fake_hal_flash_counters_Reset();
+}
+
+
+extern uint8_t* fake_hal_flash_Get(uint32_t address)
+{
+    return(s_fake_flash + (address - EENV_ROMSTART));
+}
+
+
+extern uint32_t fake_hal_flash_sector_erases(uint32_t address)
+{
+    uint32_t i = s_fake_flash_sector_get(address);
+
+    return((hal_NA32 == i) ? (0) : (s_fake_flash_sectorerases[i]));
+}
+
+
+extern void fake_hal_flash_counters_Get(fake_hal_flash_counters_t *counters)
+{
+    *counters = s_fake_flash_counters;
+}
+
+
+extern void fake_hal_flash_counters_Reset(void)
+{
+    memset(&s_fake_flash_counters, 0, sizeof(s_fake_flash_counters));
+    memset(s_fake_flash_sectorerases, 0, sizeof(s_fake_flash_sectorerases));
+}
+
+
+// the functions of hal_flash used by updater-core.c
+
+extern hal_boolval_t hal_flash_address_isvalid(uint32_t addr)
+{
+    return((1 == s_fake_flash_isvalid(addr, 1)) ? (hal_true) : (hal_false));
+}
+
+
+extern uint32_t hal_flash_get_pagesize(uint32_t addr)
+{
+    uint32_t i = s_fake_flash_sector_get(addr);
+    
+    return((hal_NA32 == i) ? (hal_NA32) : (s_fake_flash_sectors[i+1] - s_fake_flash_sectors[i]));
+}
+
+
+extern uint32_t hal_flash_get_pageaddr(uint32_t addr)
+{
+    uint32_t i = s_fake_flash_sector_get(addr);
+    
+    return((hal_NA32 == i) ? (hal_NA32) : (EENV_ROMSTART + s_fake_flash_sectors[i]));
+}
+
+
+// as hal2: the size is counted from the start of the sector of addr, and every sector it touches is erased
+extern hal_result_t hal_flash_erase(uint32_t addr, uint32_t size)
+{
+    uint32_t pagesize = 0;
+    
+    if((0 == s_fake_flash_isvalid(addr, 1)) || (0 == size))
+    {
+        return(s_fake_flash_rejected());
+    }
+    
+    size += addr - hal_flash_get_pageaddr(addr);
+    
+    while(size > 0)
+    {
+        if(0 == s_fake_flash_isvalid(addr, 1))
+        {
+            return(s_fake_flash_rejected());
+        }
+        
+        memset(fake_hal_flash_Get(hal_flash_get_pageaddr(addr)), 0xFF, hal_flash_get_pagesize(addr));
+        s_fake_flash_counters.erases++;
+        s_fake_flash_sectorerases[s_fake_flash_sector_get(addr)]++;
+        
+        pagesize = hal_flash_get_pagesize(addr);
+        addr += pagesize;
+        size = (size >= pagesize) ? (size - pagesize) : (0);
+    }
+    
+    return(hal_res_OK);
+}
+
+
+// as hal2. it writes by words if addr is a multiple of 4, otherwise by half words. when addr is a multiple of 4 and 
+// size is not, the last half word goes to addr - (size - 2) instead of addr + (size - 2): the bug is kept, so that the
+// code which calls hal_flash_write() in such a way fails here as it does on the board.
+extern hal_result_t hal_flash_write(uint32_t addr, uint32_t size, void *data)
+{
+    const uint8_t *dd = data;
+    hal_result_t res = hal_res_OK;
+    
+    if((0 == s_fake_flash_isvalid(addr, size)) || (0 == size) || (NULL == data))
+    {
+        return(s_fake_flash_rejected());
+    }
+    
+    if((0 != (addr & 1)) || (0 != (size & 1)))
+    {
+        return(s_fake_flash_rejected());
+    }
+    
+    if((0 == (addr & 3)) && (0 != (size & 3)))
+    {
+        uint32_t ss = size - 2;
+        if(ss > 0)
+        {
+            if(hal_res_OK != s_fake_flash_program(addr, dd, ss))
+            {
+                return(s_fake_flash_rejected());
+            }
+            addr -= ss;
+            dd += ss;
+        }
+        res = s_fake_flash_program(addr, dd, 2);
+    }
+    else
+    {
+        res = s_fake_flash_program(addr, dd, size);
+    }
+    
+    if(hal_res_OK != res)
+    {
+        return(s_fake_flash_rejected());
+    }
+    
+    s_fake_flash_counters.writes++;
+    s_fake_flash_counters.bytes += size;
+    
+    return(hal_res_OK);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint8_t s_fake_flash_isvalid(uint32_t addr, uint32_t size)
+{
+    return(((addr >= EENV_ROMSTART) && (size <= EENV_ROMSIZE) && (addr - EENV_ROMSTART <= EENV_ROMSIZE - size)) ? (1) : (0));
+}
+
+
+static uint32_t s_fake_flash_sector_get(uint32_t addr)
+{
+    uint32_t i = 0;
+    
+    if(0 == s_fake_flash_isvalid(addr, 1))
+    {
+        return(hal_NA32);
+    }
+    
+    addr -= EENV_ROMSTART;
+    while(addr >= s_fake_flash_sectors[i+1])
+    {
+        i++;
+    }
+    
+    return(i);
+}
+
+
+// the flash of the stm32f4 programs bits from 1 to 0 only, and hal2 refuses to program what is not erased
+static hal_result_t s_fake_flash_program(uint32_t addr, const uint8_t *data, uint32_t size)
+{
+    uint8_t *flash = NULL;
+    uint32_t i = 0;
+    
+    if(0 == s_fake_flash_isvalid(addr, size))
+    {
+        return(hal_res_NOK_generic);
+    }
+    
+    flash = fake_hal_flash_Get(addr);
+    
+    for(i=0; i<size; i++)
+    {
+        if(0xFF != flash[i])
+        {
+            return(hal_res_NOK_generic);
+        }
+    }
+    
+    for(i=0; i<size; i++)
+    {
+        flash[i] &= data[i];
+    }
+    
+    return(hal_res_OK);
+}
+
+
+static hal_result_t s_fake_flash_rejected(void)
+{
+    s_fake_flash_counters.rejects++;
+    return(hal_res_NOK_generic);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// - include guard ----------------------------------------------------------------------------------------------------
+#ifndef _FAKE_HAL_FLASH_H_
+#define _FAKE_HAL_FLASH_H_
+
+
+/** @file       fake-hal-flash.h
+    @brief      This header file gives the control of a host replacement of hal_flash used to run updater-core.c on 
+                linux. the flash is ram mapped at the address of the rom of the stm32f4 (EENV_ROMSTART), so that the 
+                code which reads the flash through a pointer runs as it is. the writes follow the rules of
+                hal_flash_write() of hal2: odd addresses and odd sizes are rejected, the bytes must be erased before
+                they are programmed, and the erase works by whole sectors of the stm32f4 (4 x 16K, 64K, 7 x 128K).
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+
+// - external dependencies --------------------------------------------------------------------------------------------
+
+#include "stdint.h"
+
+
+// - declaration of public user-defined types -------------------------------------------------------------------------
+
+typedef struct
+{
+    uint32_t    erases;         /**< the sectors erased */
+    uint32_t    writes;         /**< the calls of hal_flash_write() which succeed */
+    uint32_t    bytes;          /**< the bytes given to those calls */
+    uint32_t    rejects;        /**< the calls of hal_flash_write() or hal_flash_erase() which fail */
+} fake_hal_flash_counters_t;
+
+
+// - declaration of extern public functions ---------------------------------------------------------------------------
+
+/** @fn         extern void fake_hal_flash_Reset(void)
+    @brief      Maps the flash at its first call, then it erases it all and clears the counters.
+ **/
+extern void fake_hal_flash_Reset(void);
+
+
+/** @fn         extern uint8_t* fake_hal_flash_Get(uint32_t address)
+    @brief      Gets the host pointer of an @e address of the flash.
+ **/
+extern uint8_t* fake_hal_flash_Get(uint32_t address);
+
+
+/** @fn         extern uint32_t fake_hal_flash_sector_erases(uint32_t address)
+    @brief      Gets how many times the sector which holds @e address has been erased since the counters were cleared.
+ **/
+extern uint32_t fake_hal_flash_sector_erases(uint32_t address);
+
+
+extern void fake_hal_flash_counters_Get(fake_hal_flash_counters_t *counters);
+
+extern void fake_hal_flash_counters_Reset(void);
+
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
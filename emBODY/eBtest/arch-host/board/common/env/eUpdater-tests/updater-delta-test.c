@@ -0,0 +1,406 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       updater-delta-test.c
+    @brief      host test of the download of a delta of the application against the installed one. the delta is made
+                with the tool eupdater-delta, and compressed with eupdater-compress for UPD_CODEC_DELTA_LZ4. then it is
+                sent to updater-core.c, which builds the new image in the scratch space of the ram flash of 
+                fake-hal-flash.c and installs it at CMD_END. the flash counts the erases of each sector and the bytes
+                written. it checks that:
+                - a release which changes a few bytes rewrites only the sector which holds them.
+                - the same image erases and writes nothing of the application.
+                - a delta with moved code, compressed, builds an image of odd size.
+                - a delta made against another image is refused and the installed one is left as it is.
+                usage: updater-delta-test path/of/eupdater-delta path/of/eupdater-compress
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "unistd.h"
+#include "EoCommon.h"
+#include "eEmemorymap.h"
+#include "updater-core.h"
+
+#include "fake-hal-flash.h"
+#include "updater-host.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)    s_test_check((cond), #cond, __LINE__)
+
+#define TEST_ADDRESS        EENV_MEMMAP_EAPPLICATION_ROMADDR
+
+// the application of the ems004 takes the sectors 5 and 6 of the stm32f4, of 128K each
+#define TEST_SECTOR         (128*1024)
+
+#define TEST_IMAGE_SIZE     (200*1024)
+
+#define TEST_IMAGE_MAXSIZE  (EENV_MEMMAP_EAPPLICATION_ROMSIZE)
+
+#define TEST_CHUNK          1000
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static uint32_t s_test_random(void);
+static void s_test_old_make(uint32_t size);
+static void s_test_install(void);
+static uint32_t s_test_delta_make(uint8_t codec);
+static int s_test_file_write(const char *filename, const uint8_t *data, uint32_t size);
+static uint8_t s_test_download(uint8_t codec, uint32_t streamsize, uint8_t *firstfailure);
+
+static void s_test_few_bytes(void);
+static void s_test_same_image(void);
+static void s_test_moved_code(void);
+static void s_test_wrong_base(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static uint32_t s_test_seed = 777;
+
+static const char *s_test_tooldelta = NULL;
+static const char *s_test_toolcompress = NULL;
+
+static char s_test_fileold[64] = { 0 };
+static char s_test_filenew[64] = { 0 };
+static char s_test_filedelta[64] = { 0 };
+static char s_test_filelz4[64] = { 0 };
+
+static uint8_t s_test_old[TEST_IMAGE_MAXSIZE] = { 0 };
+static uint32_t s_test_oldsize = 0;
+
+static uint8_t s_test_new[TEST_IMAGE_MAXSIZE] = { 0 };
+static uint32_t s_test_newsize = 0;
+
+static uint8_t s_test_stream[2*TEST_IMAGE_MAXSIZE] = { 0 };
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    if(3 != argc)
+    {
+        printf("usage: updater-delta-test path/of/eupdater-delta path/of/eupdater-compress\n");
+        return(EXIT_FAILURE);
+    }
+
+    s_test_tooldelta = argv[1];
+    s_test_toolcompress = argv[2];
+    snprintf(s_test_fileold, sizeof(s_test_fileold), "updater-delta-test-%d.old", (int)getpid());
+    snprintf(s_test_filenew, sizeof(s_test_filenew), "updater-delta-test-%d.new", (int)getpid());
+    snprintf(s_test_filedelta, sizeof(s_test_filedelta), "updater-delta-test-%d.delta", (int)getpid());
+    snprintf(s_test_filelz4, sizeof(s_test_filelz4), "updater-delta-test-%d.lz4", (int)getpid());
+
+    upd_core_init();
+
+    s_test_few_bytes();
+    s_test_same_image();
+    s_test_moved_code();
+    s_test_wrong_base();
+
+    remove(s_test_fileold);
+    remove(s_test_filenew);
+    remove(s_test_filedelta);
+    remove(s_test_filelz4);
+
+    if(0 != s_test_failures)
+    {
+        printf("updater-delta-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("updater-delta-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        printf("updater-delta-test: line %d: %s failed\n", line, str);
+        s_test_failures++;
+    }
+}
+
+
+static uint32_t s_test_random(void)
+{
+    s_test_seed = s_test_seed * 1103515245 + 12345;
+    return((s_test_seed >> 16) & 0x7FFF);
+}
+
+
+// as a firmware: random code mixed with tables of small values. the new image starts as a copy of the old one
+static void s_test_old_make(uint32_t size)
+{
+    uint32_t i = 0;
+
+    for(i=0; i<size; i++)
+    {
+        s_test_old[i] = (0 == ((i >> 9) & 1)) ? (s_test_random() & 0xFF) : (s_test_random() % 4);
+    }
+    s_test_oldsize = size;
+
+    memcpy(s_test_new, s_test_old, size);
+    s_test_newsize = size;
+}
+
+
+// the old image is the installed one
+static void s_test_install(void)
+{
+    fake_hal_flash_Reset();
+    memcpy(fake_hal_flash_Get(TEST_ADDRESS), s_test_old, s_test_oldsize);
+}
+
+
+// it runs the tools and returns the size of the stream, or 0
+static uint32_t s_test_delta_make(uint8_t codec)
+{
+    char command[512];
+    const char *filestream = (UPDATER_HOST_CODEC_DELTA_LZ4 == codec) ? (s_test_filelz4) : (s_test_filedelta);
+    FILE *f = NULL;
+    long length = 0;
+
+    if((0 != s_test_file_write(s_test_fileold, s_test_old, s_test_oldsize)) || 
+       (0 != s_test_file_write(s_test_filenew, s_test_new, s_test_newsize)))
+    {
+        return(0);
+    }
+
+    snprintf(command, sizeof(command), "\"%s\" %s %s %s > /dev/null", s_test_tooldelta, s_test_fileold, s_test_filenew, s_test_filedelta);
+    if(0 != system(command))
+    {
+        return(0);
+    }
+
+    if(UPDATER_HOST_CODEC_DELTA_LZ4 == codec)
+    {
+        snprintf(command, sizeof(command), "\"%s\" %s %s > /dev/null", s_test_toolcompress, s_test_filedelta, s_test_filelz4);
+        if(0 != system(command))
+        {
+            return(0);
+        }
+    }
+
+    f = fopen(filestream, "rb");
+    if(NULL == f)
+    {
+        return(0);
+    }
+    length = (long)fread(s_test_stream, 1, sizeof(s_test_stream), f);
+    fclose(f);
+
+    return((length > 0) ? ((uint32_t)length) : (0));
+}
+
+
+static int s_test_file_write(const char *filename, const uint8_t *data, uint32_t size)
+{
+    FILE *f = fopen(filename, "wb");
+    int r = 0;
+
+    if(NULL == f)
+    {
+        return(-1);
+    }
+    r = (size == fwrite(data, 1, size, f)) ? (0) : (-1);
+    fclose(f);
+
+    return(r);
+}
+
+
+// the stream is sent in order after the counters are cleared. it returns the result of CMD_END and in firstfailure 
+// the first result of CMD_DATAWIN which is not UPDATER_HOST_OK
+static uint8_t s_test_download(uint8_t codec, uint32_t streamsize, uint8_t *firstfailure)
+{
+    uint32_t offset = 0;
+    uint16_t seq = 0;
+    uint16_t n = 0;
+    uint8_t res = UPDATER_HOST_OK;
+
+    *firstfailure = UPDATER_HOST_OK;
+    fake_hal_flash_counters_Reset();
+
+    TEST_CHECK(UPDATER_HOST_OK == updater_host_start_ext(UPDATER_HOST_PROGRAM_APP, codec, s_test_newsize, updater_host_crc32(s_test_new, s_test_newsize)));
+
+    for(offset=0; offset<streamsize; offset+=n, seq++)
+    {
+        n = ((streamsize - offset) > TEST_CHUNK) ? (TEST_CHUNK) : (streamsize - offset);
+        res = updater_host_datawin(seq, TEST_ADDRESS + offset, &s_test_stream[offset], n);
+        if((UPDATER_HOST_OK != res) && (UPDATER_HOST_OK == *firstfailure))
+        {
+            *firstfailure = res;
+        }
+    }
+
+    return(updater_host_end(seq));
+}
+
+
+// 1K of the second sector of the application changes: the first sector is neither erased nor written
+static void s_test_few_bytes(void)
+{
+    fake_hal_flash_counters_t counters;
+    uint32_t streamsize = 0;
+    uint8_t failure = 0;
+    uint32_t i = 0;
+
+    s_test_old_make(TEST_IMAGE_SIZE);
+    for(i=0; i<1024; i++)
+    {
+        s_test_new[150*1024 + i] ^= 0x5A;
+    }
+    s_test_install();
+
+    streamsize = s_test_delta_make(UPDATER_HOST_CODEC_DELTA);
+    TEST_CHECK((0 != streamsize) && (streamsize < s_test_newsize/10));
+
+    TEST_CHECK(UPDATER_HOST_OK == s_test_download(UPDATER_HOST_CODEC_DELTA, streamsize, &failure));
+    TEST_CHECK(UPDATER_HOST_OK == failure);
+    TEST_CHECK(0 == memcmp(fake_hal_flash_Get(TEST_ADDRESS), s_test_new, s_test_newsize));
+
+    TEST_CHECK(0 == fake_hal_flash_sector_erases(TEST_ADDRESS));
+    TEST_CHECK(1 == fake_hal_flash_sector_erases(TEST_ADDRESS + TEST_SECTOR));
+
+    // the new image in the scratch space, then only its part in the second sector
+    fake_hal_flash_counters_Get(&counters);
+    TEST_CHECK(0 == counters.rejects);
+    TEST_CHECK(s_test_newsize + (s_test_newsize - TEST_SECTOR) == counters.bytes);
+}
+
+
+static void s_test_same_image(void)
+{
+    fake_hal_flash_counters_t counters;
+    uint32_t streamsize = 0;
+    uint8_t failure = 0;
+
+    s_test_old_make(TEST_IMAGE_SIZE);
+    s_test_install();
+
+    streamsize = s_test_delta_make(UPDATER_HOST_CODEC_DELTA_LZ4);
+    TEST_CHECK((0 != streamsize) && (streamsize < 1024));
+
+    TEST_CHECK(UPDATER_HOST_OK == s_test_download(UPDATER_HOST_CODEC_DELTA_LZ4, streamsize, &failure));
+    TEST_CHECK(UPDATER_HOST_OK == failure);
+    TEST_CHECK(0 == memcmp(fake_hal_flash_Get(TEST_ADDRESS), s_test_new, s_test_newsize));
+
+    TEST_CHECK(0 == fake_hal_flash_sector_erases(TEST_ADDRESS));
+    TEST_CHECK(0 == fake_hal_flash_sector_erases(TEST_ADDRESS + TEST_SECTOR));
+
+    // the decompressed delta and the new image in the scratch space, and nothing else
+    fake_hal_flash_counters_Get(&counters);
+    TEST_CHECK(0 == counters.rejects);
+    TEST_CHECK(counters.bytes < s_test_newsize + 1024);
+}
+
+
+// 7 bytes are inserted near the start, as when a function grows, thus all the code after them moves
+static void s_test_moved_code(void)
+{
+    fake_hal_flash_counters_t counters;
+    uint32_t streamsize = 0;
+    uint8_t failure = 0;
+
+    s_test_old_make(TEST_IMAGE_SIZE);
+    memmove(&s_test_new[1007], &s_test_new[1000], s_test_oldsize - 1000);
+    memset(&s_test_new[1000], 0xC3, 7);
+    s_test_newsize = s_test_oldsize + 7;
+    s_test_install();
+
+    streamsize = s_test_delta_make(UPDATER_HOST_CODEC_DELTA_LZ4);
+    TEST_CHECK((0 != streamsize) && (streamsize < s_test_newsize/10));
+
+    TEST_CHECK(UPDATER_HOST_OK == s_test_download(UPDATER_HOST_CODEC_DELTA_LZ4, streamsize, &failure));
+    TEST_CHECK(UPDATER_HOST_OK == failure);
+    TEST_CHECK(0 == memcmp(fake_hal_flash_Get(TEST_ADDRESS), s_test_new, s_test_newsize));
+    TEST_CHECK(0xFF == fake_hal_flash_Get(TEST_ADDRESS)[s_test_newsize]);
+
+    TEST_CHECK(1 == fake_hal_flash_sector_erases(TEST_ADDRESS));
+    TEST_CHECK(1 == fake_hal_flash_sector_erases(TEST_ADDRESS + TEST_SECTOR));
+
+    fake_hal_flash_counters_Get(&counters);
+    TEST_CHECK(0 == counters.rejects);
+}
+
+
+// the installed image is not the one the delta is made against: the download fails and the installed image stays
+static void s_test_wrong_base(void)
+{
+    uint32_t streamsize = 0;
+    uint8_t failure = 0;
+    uint32_t i = 0;
+
+    s_test_old_make(TEST_IMAGE_SIZE);
+    for(i=0; i<100; i++)
+    {
+        s_test_new[5000 + i] ^= 0x33;
+    }
+
+    streamsize = s_test_delta_make(UPDATER_HOST_CODEC_DELTA);
+    s_test_old[7] ^= 1;
+    s_test_install();
+    TEST_CHECK(UPDATER_HOST_ERR_LOST == s_test_download(UPDATER_HOST_CODEC_DELTA, streamsize, &failure));
+    TEST_CHECK(UPDATER_HOST_ERR_FLASH == failure);
+    TEST_CHECK(0 == memcmp(fake_hal_flash_Get(TEST_ADDRESS), s_test_old, s_test_oldsize));
+    TEST_CHECK(0 == fake_hal_flash_sector_erases(TEST_ADDRESS));
+
+    // compressed, the delta is applied only at CMD_END
+    s_test_old[7] ^= 1;
+    streamsize = s_test_delta_make(UPDATER_HOST_CODEC_DELTA_LZ4);
+    s_test_old[7] ^= 1;
+    s_test_install();
+    TEST_CHECK(UPDATER_HOST_ERR_LOST == s_test_download(UPDATER_HOST_CODEC_DELTA_LZ4, streamsize, &failure));
+    TEST_CHECK(UPDATER_HOST_OK == failure);
+    TEST_CHECK(0 == memcmp(fake_hal_flash_Get(TEST_ADDRESS), s_test_old, s_test_oldsize));
+    TEST_CHECK(0 == fake_hal_flash_sector_erases(TEST_ADDRESS));
+    TEST_CHECK(0 == fake_hal_flash_sector_erases(TEST_ADDRESS + TEST_SECTOR));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "string.h"
+#include "EoCommon.h"
+#include "updater-core.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of extern public interface
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "updater-host.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define UPDATER_HOST_CMD_START          0x01
+#define UPDATER_HOST_CMD_END            0x04
+#define UPDATER_HOST_CMD_DATAWIN        0x0D
+#define UPDATER_HOST_CMD_START_EXT      0x0E
+
+#define UPDATER_HOST_WIN_HEADERSIZE     13
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint8_t s_updater_host_send(uint8_t opc, uint16_t sizein);
+static void s_updater_host_put32(uint8_t *p, uint32_t value);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint8_t s_updater_host_pktin[UPDATER_HOST_WIN_HEADERSIZE + UPDATER_HOST_CHUNK_MAXSIZE] = { 0 };
+static uint8_t s_updater_host_pktout[64] = { 0 };
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+extern uint8_t updater_host_start(uint8_t what)
+{
+    s_updater_host_pktin[0] = UPDATER_HOST_CMD_START;
+    s_updater_host_pktin[1] = what;
+    
+    return(s_updater_host_send(UPDATER_HOST_CMD_START, 2));
+}
+
+
+extern uint8_t updater_host_start_ext(uint8_t what, uint8_t codec, uint32_t size, uint32_t crc)
+{
+    s_updater_host_pktin[0] = UPDATER_HOST_CMD_START_EXT;
+    s_updater_host_pktin[1] = what;
+    s_updater_host_pktin[2] = codec;
+    s_updater_host_put32(&s_updater_host_pktin[3], size);
+    s_updater_host_put32(&s_updater_host_pktin[7], crc);
+    
+    return(s_updater_host_send(UPDATER_HOST_CMD_START_EXT, 11));
+}
+
+
+extern uint8_t updater_host_datawin(uint16_t seq, uint32_t address, const uint8_t *data, uint16_t size)
+{
+    return(updater_host_datawin_sized(seq, address, data, size, UPDATER_HOST_WIN_HEADERSIZE + size));
+}
+
+
+extern uint8_t updater_host_datawin_sized(uint16_t seq, uint32_t address, const uint8_t *data, uint16_t size, uint16_t sizein)
+{
+    if(size > UPDATER_HOST_CHUNK_MAXSIZE)
+    {
+        return(UPDATER_HOST_ERR_UNK);
+    }
+    
+    s_updater_host_pktin[0] = UPDATER_HOST_CMD_DATAWIN;
+    s_updater_host_pktin[1] = seq & 0xFF;
+    s_updater_host_pktin[2] = (seq >> 8) & 0xFF;
+    s_updater_host_put32(&s_updater_host_pktin[3], address);
+    s_updater_host_pktin[7] = size & 0xFF;
+    s_updater_host_pktin[8] = (size >> 8) & 0xFF;
+    s_updater_host_put32(&s_updater_host_pktin[9], updater_host_crc32(data, size));
+    memcpy(&s_updater_host_pktin[UPDATER_HOST_WIN_HEADERSIZE], data, size);
+    
+    return(s_updater_host_send(UPDATER_HOST_CMD_DATAWIN, sizein));
+}
+
+
+extern uint8_t updater_host_end(uint16_t packets)
+{
+    // the updater counts the packets from one
+    packets++;
+    s_updater_host_pktin[0] = UPDATER_HOST_CMD_END;
+    s_updater_host_pktin[1] = packets & 0xFF;
+    s_updater_host_pktin[2] = (packets >> 8) & 0xFF;
+    
+    return(s_updater_host_send(UPDATER_HOST_CMD_END, 3));
+}
+
+
+extern uint32_t updater_host_crc32(const uint8_t *data, uint32_t size)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    uint32_t i = 0;
+    uint8_t b = 0;
+    
+    for(i=0; i<size; i++)
+    {
+        crc ^= data[i];
+        for(b=0; b<8; b++)
+        {
+            crc = (crc >> 1) ^ ((0 != (crc & 1)) ? (0xEDB88320) : (0));
+        }
+    }
+    
+    return(~crc);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+// sizein is the size of the datagram received by the updater
+static uint8_t s_updater_host_send(uint8_t opc, uint16_t sizein)
+{
+    uint16_t sizeout = 0;
+    
+    memset(s_updater_host_pktout, 0, sizeof(s_updater_host_pktout));
+    
+    if((1 != upd_core_manage_cmd(s_updater_host_pktin, sizein, 0, s_updater_host_pktout, sizeof(s_updater_host_pktout), &sizeout)) ||
+       (sizeout < 2) || (opc != s_updater_host_pktout[0]))
+    {
+        return(UPDATER_HOST_ERR_UNK);
+    }
+    
+    return(s_updater_host_pktout[1]);
+}
+
+
+static void s_updater_host_put32(uint8_t *p, uint32_t value)
+{
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+    p[2] = (value >> 16) & 0xFF;
+    p[3] = (value >> 24) & 0xFF;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// - include guard ----------------------------------------------------------------------------------------------------
+#ifndef _UPDATER_HOST_H_
+#define _UPDATER_HOST_H_
+
+
+/** @file       updater-host.h
+    @brief      This header file gives the host side of the download protocol of the eUpdater: each function builds a
+                request as the tool of the pc does, passes it to upd_core_manage_cmd() and returns the result of the
+                reply (UPDATER_HOST_OK, ...).
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+
+// - external dependencies --------------------------------------------------------------------------------------------
+
+#include "stdint.h"
+
+
+// - public #define  --------------------------------------------------------------------------------------------------
+
+// as in updater-core.c
+#define UPDATER_HOST_PROGRAM_LOADER     0x55
+#define UPDATER_HOST_PROGRAM_APP        0x5A
+
+#define UPDATER_HOST_CODEC_RAW          0
+#define UPDATER_HOST_CODEC_LZ4          1
+#define UPDATER_HOST_CODEC_DELTA        2
+#define UPDATER_HOST_CODEC_DELTA_LZ4    3
+
+#define UPDATER_HOST_OK                 0
+#define UPDATER_HOST_ERR_PROT           1
+#define UPDATER_HOST_ERR_FLASH          2
+#define UPDATER_HOST_ERR_LOST           3
+#define UPDATER_HOST_ERR_UNK            4
+
+// the biggest chunk of CMD_DATAWIN which can be sent. it is bigger than the staging of updater-core.c, which writes
+// such a chunk directly
+#define UPDATER_HOST_CHUNK_MAXSIZE      4096
+
+
+// - declaration of extern public functions ---------------------------------------------------------------------------
+
+/** @fn         extern uint8_t updater_host_start(uint8_t what)
+    @brief      Sends CMD_START for the memory space @e what (UPDATER_HOST_PROGRAM_*).
+ **/
+extern uint8_t updater_host_start(uint8_t what);
+
+
+/** @fn         extern uint8_t updater_host_start_ext(uint8_t what, uint8_t codec, uint32_t size, uint32_t crc)
+    @brief      Sends CMD_START_EXT with the @e codec, the @e size and the @e crc of the image.
+ **/
+extern uint8_t updater_host_start_ext(uint8_t what, uint8_t codec, uint32_t size, uint32_t crc);
+
+
+/** @fn         extern uint8_t updater_host_datawin(uint16_t seq, uint32_t address, const uint8_t *data, uint16_t size)
+    @brief      Sends the chunk @e seq of CMD_DATAWIN, with the crc32 of its data.
+ **/
+extern uint8_t updater_host_datawin(uint16_t seq, uint32_t address, const uint8_t *data, uint16_t size);
+
+
+/** @fn         extern uint8_t updater_host_datawin_sized(uint16_t seq, uint32_t address, const uint8_t *data, uint16_t size, uint16_t sizein)
+    @brief      As updater_host_datawin(), but the updater receives a datagram of @e sizein bytes, as if it was truncated.
+ **/
+extern uint8_t updater_host_datawin_sized(uint16_t seq, uint32_t address, const uint8_t *data, uint16_t size, uint16_t sizein);
+
+
+/** @fn         extern uint8_t updater_host_end(uint16_t packets)
+    @brief      Sends CMD_END with the count of the packets sent plus one, as the tool of the pc does.
+ **/
+extern uint8_t updater_host_end(uint16_t packets);
+
+
+/** @fn         extern uint32_t updater_host_crc32(const uint8_t *data, uint32_t size)
+    @brief      Computes the crc32 of zlib, bit by bit, so that it does not share the code of updater-core.c.
+ **/
+extern uint32_t updater_host_crc32(const uint8_t *data, uint32_t size);
+
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
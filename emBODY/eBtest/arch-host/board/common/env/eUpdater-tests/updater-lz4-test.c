@@ -0,0 +1,428 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       updater-lz4-test.c
+    @brief      round trip test of the download of compressed images: the image is compressed with the tool 
+                eupdater-compress, then the stream is sent with CMD_START_EXT and CMD_DATAWIN to updater-core.c, which 
+                decompresses it into the ram flash of fake-hal-flash.c. it checks that:
+                - an image with matches farther than the staging, and up to the 64K of lz4, is programmed as it is.
+                - so is an image of odd size, and an image of the loader, which is built in ram.
+                - an image whose crc32 is not the declared one is not accepted at CMD_END.
+                - a match which points before the start of the image breaks the download.
+                usage: updater-lz4-test path/of/eupdater-compress
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "unistd.h"
+#include "EoCommon.h"
+#include "eEmemorymap.h"
+#include "updater-core.h"
+
+#include "fake-hal-flash.h"
+#include "updater-host.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)    s_test_check((cond), #cond, __LINE__)
+
+#define TEST_IMAGE_MAXSIZE  (EENV_MEMMAP_EAPPLICATION_ROMSIZE)
+
+#define TEST_CHUNK          1000
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static uint32_t s_test_random(void);
+static void s_test_image_make(uint32_t size);
+static uint32_t s_test_compress(uint32_t size);
+static uint32_t s_test_offset_max(uint32_t size);
+static uint8_t s_test_download(uint8_t what, uint32_t size, uint32_t crc, uint32_t streamsize, uint8_t *firstfailure);
+
+static void s_test_far_matches(void);
+static void s_test_odd_size(void);
+static void s_test_loader(void);
+static void s_test_wrong_crc(void);
+static void s_test_broken_stream(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static uint32_t s_test_seed = 4321;
+
+static const char *s_test_tool = NULL;
+
+static char s_test_filein[64] = { 0 };
+static char s_test_fileout[64] = { 0 };
+
+static uint8_t s_test_image[TEST_IMAGE_MAXSIZE] = { 0 };
+
+static uint8_t s_test_stream[TEST_IMAGE_MAXSIZE + TEST_IMAGE_MAXSIZE/255 + 16] = { 0 };
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    if(2 != argc)
+    {
+        printf("usage: updater-lz4-test path/of/eupdater-compress\n");
+        return(EXIT_FAILURE);
+    }
+
+    s_test_tool = argv[1];
+    snprintf(s_test_filein, sizeof(s_test_filein), "updater-lz4-test-%d.bin", (int)getpid());
+    snprintf(s_test_fileout, sizeof(s_test_fileout), "updater-lz4-test-%d.lz4", (int)getpid());
+
+    upd_core_init();
+
+    s_test_far_matches();
+    s_test_odd_size();
+    s_test_loader();
+    s_test_wrong_crc();
+    s_test_broken_stream();
+
+    remove(s_test_filein);
+    remove(s_test_fileout);
+
+    if(0 != s_test_failures)
+    {
+        printf("updater-lz4-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("updater-lz4-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        printf("updater-lz4-test: line %d: %s failed\n", line, str);
+        s_test_failures++;
+    }
+}
+
+
+static uint32_t s_test_random(void)
+{
+    s_test_seed = s_test_seed * 1103515245 + 12345;
+    return((s_test_seed >> 16) & 0x7FFF);
+}
+
+
+// as a firmware: tables of small values, code with repeated patterns and some blocks which come again far after
+// their first copy, so that the matches reach beyond the staging and the 4K of the old history
+static void s_test_image_make(uint32_t size)
+{
+    uint32_t i = 0;
+    uint32_t n = 0;
+    uint32_t k = 0;
+    uint32_t distance = 0;
+
+    while(i < size)
+    {
+        n = 64 + s_test_random() % 2048;
+        if(n > size - i)
+        {
+            n = size - i;
+        }
+
+        switch(s_test_random() % 4)
+        {
+            case 0:
+            {   // random bytes
+                for(k=0; k<n; k++)
+                {
+                    s_test_image[i+k] = s_test_random() & 0xFF;
+                }
+            } break;
+
+            case 1:
+            {   // small values
+                for(k=0; k<n; k++)
+                {
+                    s_test_image[i+k] = s_test_random() % 8;
+                }
+            } break;
+
+            case 2:
+            {   // a short pattern
+                for(k=0; k<n; k++)
+                {
+                    s_test_image[i+k] = (uint8_t)(0xB5 + (k % 6) * 0x11);
+                }
+            } break;
+
+            default:
+            {   // a copy of a block from up to 60K before
+                if(i < 8192)
+                {
+                    memset(&s_test_image[i], 0, n);
+                    break;
+                }
+                distance = 4096 + s_test_random() * 4 % (((i < 61440) ? (i) : (61440)) - 4096);
+                for(k=0; k<n; k++)
+                {
+                    s_test_image[i+k] = s_test_image[i-distance+k];
+                }
+            } break;
+        }
+
+        i += n;
+    }
+}
+
+
+// it runs the tool and returns the size of the stream, or 0
+static uint32_t s_test_compress(uint32_t size)
+{
+    char command[512];
+    FILE *f = NULL;
+    long length = 0;
+
+    f = fopen(s_test_filein, "wb");
+    if(NULL == f)
+    {
+        return(0);
+    }
+    fwrite(s_test_image, 1, size, f);
+    fclose(f);
+
+    snprintf(command, sizeof(command), "\"%s\" %s %s > /dev/null", s_test_tool, s_test_filein, s_test_fileout);
+    if(0 != system(command))
+    {
+        return(0);
+    }
+
+    f = fopen(s_test_fileout, "rb");
+    if(NULL == f)
+    {
+        return(0);
+    }
+    length = (long)fread(s_test_stream, 1, sizeof(s_test_stream), f);
+    fclose(f);
+
+    return((length > 0) ? ((uint32_t)length) : (0));
+}
+
+
+// the biggest match offset inside the stream
+static uint32_t s_test_offset_max(uint32_t size)
+{
+    uint32_t ip = 0;
+    uint32_t len = 0;
+    uint32_t offset = 0;
+    uint32_t max = 0;
+    uint8_t token = 0;
+
+    while(ip < size)
+    {
+        token = s_test_stream[ip++];
+        len = token >> 4;
+        if(15 == len)
+        {
+            while(255 == s_test_stream[ip])
+            {
+                len += s_test_stream[ip++];
+            }
+            len += s_test_stream[ip++];
+        }
+        ip += len;
+        if(ip >= size)
+        {
+            break;
+        }
+        offset = s_test_stream[ip] | (s_test_stream[ip+1] << 8);
+        ip += 2;
+        max = (offset > max) ? (offset) : (max);
+        if(15 == (token & 0x0F))
+        {
+            while(255 == s_test_stream[ip])
+            {
+                ip++;
+            }
+            ip++;
+        }
+    }
+
+    return(max);
+}
+
+
+// the stream is sent in order, as the updater requires. it returns the result of CMD_END and in firstfailure the first
+// result of CMD_DATAWIN which is not UPDATER_HOST_OK
+static uint8_t s_test_download(uint8_t what, uint32_t size, uint32_t crc, uint32_t streamsize, uint8_t *firstfailure)
+{
+    uint32_t start = (UPDATER_HOST_PROGRAM_LOADER == what) ? (EENV_MEMMAP_ELOADER_ROMADDR) : (EENV_MEMMAP_EAPPLICATION_ROMADDR);
+    uint32_t offset = 0;
+    uint16_t seq = 0;
+    uint16_t n = 0;
+    uint8_t res = UPDATER_HOST_OK;
+
+    *firstfailure = UPDATER_HOST_OK;
+
+    TEST_CHECK(UPDATER_HOST_OK == updater_host_start_ext(what, UPDATER_HOST_CODEC_LZ4, size, crc));
+
+    for(offset=0; offset<streamsize; offset+=n, seq++)
+    {
+        n = ((streamsize - offset) > TEST_CHUNK) ? (TEST_CHUNK) : (streamsize - offset);
+        res = updater_host_datawin(seq, start + offset, &s_test_stream[offset], n);
+        if((UPDATER_HOST_OK != res) && (UPDATER_HOST_OK == *firstfailure))
+        {
+            *firstfailure = res;
+        }
+    }
+
+    return(updater_host_end(seq));
+}
+
+
+static void s_test_far_matches(void)
+{
+    const uint8_t *flash = NULL;
+    fake_hal_flash_counters_t counters;
+    uint32_t size = 200*1024;
+    uint32_t streamsize = 0;
+    uint8_t failure = 0;
+
+    fake_hal_flash_Reset();
+    flash = fake_hal_flash_Get(EENV_MEMMAP_EAPPLICATION_ROMADDR);
+    s_test_image_make(size);
+    streamsize = s_test_compress(size);
+    TEST_CHECK((0 != streamsize) && (streamsize < 3*size/4));
+    TEST_CHECK(s_test_offset_max(streamsize) > 4096);
+    TEST_CHECK(s_test_offset_max(streamsize) <= 65535);
+
+    TEST_CHECK(UPDATER_HOST_OK == s_test_download(UPDATER_HOST_PROGRAM_APP, size, updater_host_crc32(s_test_image, size), streamsize, &failure));
+    TEST_CHECK(UPDATER_HOST_OK == failure);
+    TEST_CHECK(0 == memcmp(flash, s_test_image, size));
+    TEST_CHECK(0xFF == flash[size]);
+
+    fake_hal_flash_counters_Get(&counters);
+    TEST_CHECK(0 == counters.rejects);
+    TEST_CHECK(size == counters.bytes);
+}
+
+
+static void s_test_odd_size(void)
+{
+    const uint8_t *flash = NULL;
+    uint32_t size = 77777;
+    uint32_t streamsize = 0;
+    uint8_t failure = 0;
+
+    fake_hal_flash_Reset();
+    flash = fake_hal_flash_Get(EENV_MEMMAP_EAPPLICATION_ROMADDR);
+    s_test_image_make(size);
+    streamsize = s_test_compress(size);
+
+    TEST_CHECK(UPDATER_HOST_OK == s_test_download(UPDATER_HOST_PROGRAM_APP, size, updater_host_crc32(s_test_image, size), streamsize, &failure));
+    TEST_CHECK(UPDATER_HOST_OK == failure);
+    TEST_CHECK(0 == memcmp(flash, s_test_image, size));
+    TEST_CHECK(0xFF == flash[size]);
+}
+
+
+// the loader is decompressed in ram and written at CMD_END
+static void s_test_loader(void)
+{
+    const uint8_t *flash = NULL;
+    uint32_t size = 30001;
+    uint32_t streamsize = 0;
+    uint8_t failure = 0;
+
+    fake_hal_flash_Reset();
+    flash = fake_hal_flash_Get(EENV_MEMMAP_ELOADER_ROMADDR);
+    s_test_image_make(size);
+    streamsize = s_test_compress(size);
+    TEST_CHECK(s_test_offset_max(streamsize) > 4096);
+
+    TEST_CHECK(UPDATER_HOST_OK == s_test_download(UPDATER_HOST_PROGRAM_LOADER, size, updater_host_crc32(s_test_image, size), streamsize, &failure));
+    TEST_CHECK(UPDATER_HOST_OK == failure);
+    TEST_CHECK(0 == memcmp(flash, s_test_image, size));
+}
+
+
+static void s_test_wrong_crc(void)
+{
+    uint32_t size = 50000;
+    uint32_t streamsize = 0;
+    uint8_t failure = 0;
+
+    fake_hal_flash_Reset();
+    s_test_image_make(size);
+    streamsize = s_test_compress(size);
+
+    TEST_CHECK(UPDATER_HOST_ERR_LOST == s_test_download(UPDATER_HOST_PROGRAM_APP, size, updater_host_crc32(s_test_image, size) ^ 1, streamsize, &failure));
+    TEST_CHECK(UPDATER_HOST_OK == failure);
+    // the partial image is erased
+    TEST_CHECK(0xFF == fake_hal_flash_Get(EENV_MEMMAP_EAPPLICATION_ROMADDR)[0]);
+}
+
+
+static void s_test_broken_stream(void)
+{
+    uint32_t size = 50000;
+    uint32_t streamsize = 0;
+    uint8_t failure = 0;
+
+    fake_hal_flash_Reset();
+    s_test_image_make(size);
+    streamsize = s_test_compress(size);
+
+    // the first sequence has 16 literals and then a match at offset 17, one before the start
+    memset(s_test_stream, 0xA5, 16);
+    s_test_stream[0] = 0xF0;
+    s_test_stream[1] = 0x01;
+    s_test_stream[18] = 17;
+    s_test_stream[19] = 0;
+
+    TEST_CHECK(UPDATER_HOST_ERR_LOST == s_test_download(UPDATER_HOST_PROGRAM_APP, size, updater_host_crc32(s_test_image, size), streamsize, &failure));
+    TEST_CHECK(UPDATER_HOST_ERR_FLASH == failure);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       updater-staging-test.c
+    @brief      host test of the writes of the data of CMD_DATAWIN done by updater-core.c, which is compiled as it is
+                and runs over the ram flash of fake-hal-flash.c. the flash rejects odd addresses and odd sizes and it
+                does not program twice the same byte, as hal_flash_write() of hal2 on the stm32f4. it checks that:
+                - an image of odd size made of chunks of odd sizes is written in full, and what follows stays erased.
+                - the chunks which begin at odd addresses are written also when they arrive out of order.
+                - a chunk bigger than the staging and a chunk sent twice are written once.
+                - a flush of 4*n+2 bytes at a word aligned address does not hit the bug of hal_flash_write().
+                - a datagram shorter than the header plus the data is rejected, and so is a chunk past the end of the
+                  memory space, while a chunk which ends exactly there is written.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "EoCommon.h"
+#include "eEmemorymap.h"
+#include "updater-core.h"
+
+#include "fake-hal-flash.h"
+#include "updater-host.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)    s_test_check((cond), #cond, __LINE__)
+
+#define TEST_ADDRESS        EENV_MEMMAP_EAPPLICATION_ROMADDR
+
+// as UPD_WIN_SIZE in updater-core.c
+#define TEST_WINDOW         32
+
+#define TEST_IMAGE_MAXSIZE  (64*1024)
+
+#define TEST_CHUNKS_MAX     512
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    uint32_t    offset;
+    uint16_t    size;
+} test_chunk_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static uint32_t s_test_random(void);
+static void s_test_image_make(uint32_t size);
+static uint16_t s_test_chunks_make(uint32_t size, const uint16_t *sizes, uint16_t numberofsizes);
+static void s_test_download(uint32_t size, uint16_t numberofchunks, const uint16_t *order);
+static void s_test_flash_verify(uint32_t size);
+
+static void s_test_odd_sizes(void);
+static void s_test_out_of_order(void);
+static void s_test_big_and_twice(void);
+static void s_test_word_and_halfword(void);
+static void s_test_bounds(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static uint32_t s_test_seed = 12345;
+
+static uint8_t s_test_image[TEST_IMAGE_MAXSIZE] = { 0 };
+
+static test_chunk_t s_test_chunks[TEST_CHUNKS_MAX] = { 0 };
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    upd_core_init();
+
+    s_test_odd_sizes();
+    s_test_out_of_order();
+    s_test_big_and_twice();
+    s_test_word_and_halfword();
+    s_test_bounds();
+
+    if(0 != s_test_failures)
+    {
+        printf("updater-staging-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("updater-staging-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        printf("updater-staging-test: line %d: %s failed\n", line, str);
+        s_test_failures++;
+    }
+}
+
+
+static uint32_t s_test_random(void)
+{
+    s_test_seed = s_test_seed * 1103515245 + 12345;
+    return((s_test_seed >> 16) & 0x7FFF);
+}
+
+
+// no byte is 0xFF, so that a byte left erased is seen
+static void s_test_image_make(uint32_t size)
+{
+    uint32_t i = 0;
+
+    for(i=0; i<size; i++)
+    {
+        s_test_image[i] = s_test_random() % 255;
+    }
+}
+
+
+// the image is cut in chunks whose sizes are taken in turn from sizes[]. it returns the number of chunks
+static uint16_t s_test_chunks_make(uint32_t size, const uint16_t *sizes, uint16_t numberofsizes)
+{
+    uint32_t offset = 0;
+    uint16_t n = 0;
+
+    for(n=0; (offset < size) && (n < TEST_CHUNKS_MAX); n++)
+    {
+        s_test_chunks[n].offset = offset;
+        s_test_chunks[n].size = sizes[n % numberofsizes];
+        if(s_test_chunks[n].size > size - offset)
+        {
+            s_test_chunks[n].size = size - offset;
+        }
+        offset += s_test_chunks[n].size;
+    }
+
+    return(n);
+}
+
+
+// the chunks are sent in the given order, which must keep each of them inside the window of the updater
+static void s_test_download(uint32_t size, uint16_t numberofchunks, const uint16_t *order)
+{
+    fake_hal_flash_counters_t counters;
+    uint16_t i = 0;
+    uint16_t seq = 0;
+
+    fake_hal_flash_Reset();
+
+    TEST_CHECK(UPDATER_HOST_OK == updater_host_start(UPDATER_HOST_PROGRAM_APP));
+
+    for(i=0; i<numberofchunks; i++)
+    {
+        seq = (NULL == order) ? (i) : (order[i]);
+        TEST_CHECK(UPDATER_HOST_OK == updater_host_datawin(seq, TEST_ADDRESS + s_test_chunks[seq].offset,
+                                                           &s_test_image[s_test_chunks[seq].offset], s_test_chunks[seq].size));
+    }
+
+    TEST_CHECK(UPDATER_HOST_OK == updater_host_end(numberofchunks));
+
+    fake_hal_flash_counters_Get(&counters);
+    TEST_CHECK(0 == counters.rejects);
+
+    s_test_flash_verify(size);
+}
+
+
+static void s_test_flash_verify(uint32_t size)
+{
+    const uint8_t *flash = fake_hal_flash_Get(TEST_ADDRESS);
+    uint32_t i = 0;
+    uint32_t wrong = 0;
+
+    for(i=0; i<size; i++)
+    {
+        wrong += (flash[i] != s_test_image[i]) ? (1) : (0);
+    }
+    TEST_CHECK(0 == wrong);
+
+    // the half word and the word which hold the last byte are not written beyond the image
+    for(i=size; i<size+8; i++)
+    {
+        TEST_CHECK(0xFF == flash[i]);
+    }
+}
+
+
+static void s_test_odd_sizes(void)
+{
+    static const uint16_t sizes[] = { 333, 1, 1023, 7, 2, 5, 999, 3 };
+    uint16_t n = 0;
+
+    s_test_image_make(10001);
+    n = s_test_chunks_make(10001, sizes, sizeof(sizes)/sizeof(sizes[0]));
+    s_test_download(10001, n, NULL);
+}
+
+
+// the chunks of each window are sent backwards, so that every chunk which begins at an odd address arrives before the
+// one which holds the other byte of its first half word
+static void s_test_out_of_order(void)
+{
+    static const uint16_t sizes[] = { 101, 57, 1, 3, 250, 77, 9, 1000, 11 };
+    uint16_t order[TEST_CHUNKS_MAX];
+    uint16_t n = 0;
+    uint16_t i = 0;
+    uint16_t w = 0;
+    uint16_t k = 0;
+
+    s_test_image_make(30001);
+    n = s_test_chunks_make(30001, sizes, sizeof(sizes)/sizeof(sizes[0]));
+
+    for(w=0; w<n; w+=TEST_WINDOW)
+    {
+        k = ((n - w) < TEST_WINDOW) ? (n - w) : (TEST_WINDOW);
+        for(i=0; i<k; i++)
+        {
+            order[w+i] = w + k - 1 - i;
+        }
+    }
+
+    s_test_download(30001, n, order);
+
+    // and two at a time swapped, so that the staging is flushed at odd addresses
+    for(i=0; i<n; i++)
+    {
+        order[i] = ((i+1) < n) ? (i ^ 1) : (i);
+    }
+
+    s_test_download(30001, n, order);
+}
+
+
+static void s_test_big_and_twice(void)
+{
+    static const uint16_t sizes[] = { 3001, 1, 4095, 2, 2051 };
+    uint16_t n = 0;
+    uint16_t i = 0;
+
+    s_test_image_make(20000);
+    n = s_test_chunks_make(20000, sizes, sizeof(sizes)/sizeof(sizes[0]));
+    s_test_download(20000, n, NULL);
+
+    // chunk 2 is sent twice: the second time it is only acked
+    fake_hal_flash_Reset();
+    TEST_CHECK(UPDATER_HOST_OK == updater_host_start(UPDATER_HOST_PROGRAM_APP));
+    for(i=0; i<n; i++)
+    {
+        TEST_CHECK(UPDATER_HOST_OK == updater_host_datawin(i, TEST_ADDRESS + s_test_chunks[i].offset,
+                                                           &s_test_image[s_test_chunks[i].offset], s_test_chunks[i].size));
+        if(2 == i)
+        {
+            TEST_CHECK(UPDATER_HOST_OK == updater_host_datawin(1, TEST_ADDRESS + s_test_chunks[1].offset,
+                                                               &s_test_image[s_test_chunks[1].offset], s_test_chunks[1].size));
+        }
+    }
+    TEST_CHECK(UPDATER_HOST_OK == updater_host_end(n));
+    s_test_flash_verify(20000);
+}
+
+
+// images of 6 and of 4*n+2 bytes are flushed with a single write at a word aligned address, which hal_flash_write()
+// splits into words plus the last half word. also 4*n+2 bytes at an address which is only half word aligned.
+static void s_test_word_and_halfword(void)
+{
+    static const uint16_t sizes6[] = { 6 };
+    static const uint16_t sizes[] = { 2, 4094, 2, 1026 };
+    uint16_t n = 0;
+
+    s_test_image_make(6);
+    n = s_test_chunks_make(6, sizes6, 1);
+    s_test_download(6, n, NULL);
+
+    s_test_image_make(5126);
+    n = s_test_chunks_make(5126, sizes, sizeof(sizes)/sizeof(sizes[0]));
+    s_test_download(5126, n, NULL);
+}
+
+
+static void s_test_bounds(void)
+{
+    const uint32_t end = TEST_ADDRESS + EENV_MEMMAP_EAPPLICATION_ROMSIZE;
+
+    s_test_image_make(256);
+    fake_hal_flash_Reset();
+    TEST_CHECK(UPDATER_HOST_OK == updater_host_start(UPDATER_HOST_PROGRAM_APP));
+
+    // the last byte of the data or the whole data and part of the header are not in the datagram
+    TEST_CHECK(UPDATER_HOST_ERR_PROT == updater_host_datawin_sized(0, end - 256, s_test_image, 256, 13 + 255));
+    TEST_CHECK(UPDATER_HOST_ERR_PROT == updater_host_datawin_sized(0, end - 256, s_test_image, 256, 12));
+    // one byte past the end
+    TEST_CHECK(UPDATER_HOST_ERR_PROT == updater_host_datawin(0, end - 255, s_test_image, 256));
+
+    // the rejected ones are not marked as received
+    TEST_CHECK(UPDATER_HOST_OK == updater_host_datawin(0, end - 256, s_test_image, 256));
+    TEST_CHECK(UPDATER_HOST_OK == updater_host_end(1));
+    TEST_CHECK(0 == memcmp(fake_hal_flash_Get(end - 256), s_test_image, 256));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       runnerprofiler-test.c
+    @brief      host test of EOtheRunnerProfiler of the ems004 application, run against a stub clock which the test
+                moves by hand. it checks that:
+                - min, max, mean, overruns, the log2 buckets and the start of the worst cycle match the durations given.
+                - the statistics are kept in the memory given in the configuration, as in the ram of the nv 
+                  mn-appl-runnerprofiler, and they are valid there without calling eo_runnerprofiler_GetStatistics().
+                - the histogram saturates instead of wrapping, and eo_runnerprofiler_Reset() clears it.
+                - a runner of RX, DO, TX counts as overruns exactly the phases which went beyond their budget.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "EoCommon.h"
+#include "EOtheRunnerProfiler.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)        s_test_check((cond), #cond, __LINE__)
+
+// the windows of the runner of the ems: DO after 400 usec, TX after 700 usec, period of 1000 usec
+#define TEST_BUDGET_RX          400
+#define TEST_BUDGET_DO          300
+#define TEST_BUDGET_TX          300
+#define TEST_BUDGET_CYCLE       1000
+
+#define TEST_CYCLES             10000
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static uint64_t s_test_nanotime_get(void);
+static void s_test_elapse(uint32_t usec);
+static void s_test_phase(EOtheRunnerProfiler *p, eOrunnerprofiler_phase_t phase, uint32_t usec);
+
+static void s_test_initialise(void);
+static void s_test_values(void);
+static void s_test_saturation_and_reset(void);
+static void s_test_runner(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static uint64_t s_test_now = 0;
+
+// as the ram of the nv mn-appl-runnerprofiler
+static eOrunnerprofiler_statistics_t s_test_nvram;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    s_test_initialise();
+    s_test_values();
+    s_test_saturation_and_reset();
+    s_test_runner();
+
+    if(0 != s_test_failures)
+    {
+        printf("runnerprofiler-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("runnerprofiler-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        printf("runnerprofiler-test: line %d: %s failed\n", line, str);
+        s_test_failures++;
+    }
+}
+
+
+static uint64_t s_test_nanotime_get(void)
+{
+    return(s_test_now);
+}
+
+
+static void s_test_elapse(uint32_t usec)
+{
+    s_test_now += 1000ULL * usec;
+}
+
+
+static void s_test_phase(EOtheRunnerProfiler *p, eOrunnerprofiler_phase_t phase, uint32_t usec)
+{
+    TEST_CHECK(eores_OK == eo_runnerprofiler_Start(p, phase));
+    s_test_elapse(usec);
+    TEST_CHECK(eores_OK == eo_runnerprofiler_Stop(p, phase));
+}
+
+
+static void s_test_initialise(void)
+{
+    eOrunnerprofiler_cfg_t config = { .nanotime_get = NULL };
+    eOrunnerprofiler_statistics_t stats;
+
+    TEST_CHECK(sizeof(eOrunnerprofiler_phasestatistics_t) == 84);
+    TEST_CHECK(sizeof(eOrunnerprofiler_statistics_t) == 344);
+
+    TEST_CHECK(NULL == eo_runnerprofiler_Initialise(NULL));
+    TEST_CHECK(NULL == eo_runnerprofiler_Initialise(&config));
+    TEST_CHECK(NULL == eo_runnerprofiler_GetHandle());
+    TEST_CHECK(eores_NOK_nullpointer == eo_runnerprofiler_Start(NULL, eo_runnerprofiler_phase_rx));
+    TEST_CHECK(eores_NOK_nullpointer == eo_runnerprofiler_Stop(NULL, eo_runnerprofiler_phase_rx));
+    TEST_CHECK(eores_NOK_nullpointer == eo_runnerprofiler_GetStatistics(NULL, &stats));
+    TEST_CHECK(eores_NOK_nullpointer == eo_runnerprofiler_Reset(NULL));
+
+    // the nv has some garbage before the profiler starts
+    memset(&s_test_nvram, 0xa5, sizeof(s_test_nvram));
+
+    config.nanotime_get                                 = s_test_nanotime_get;
+    config.budgets[eo_runnerprofiler_phase_rx]          = TEST_BUDGET_RX;
+    config.budgets[eo_runnerprofiler_phase_do]          = TEST_BUDGET_DO;
+    config.budgets[eo_runnerprofiler_phase_tx]          = TEST_BUDGET_TX;
+    config.budgets[eo_runnerprofiler_phase_cycle]       = TEST_BUDGET_CYCLE;
+    config.statistics                                   = &s_test_nvram;
+
+    TEST_CHECK(NULL != eo_runnerprofiler_Initialise(&config));
+    TEST_CHECK(eo_runnerprofiler_GetHandle() == eo_runnerprofiler_Initialise(&config));
+    TEST_CHECK(0 == s_test_nvram.phases[eo_runnerprofiler_phase_cycle].count);
+    TEST_CHECK(0 == s_test_nvram.phases[eo_runnerprofiler_phase_rx].histogram[0]);
+}
+
+
+static void s_test_values(void)
+{
+    static const uint32_t durations[] = { 0, 1, 3, 250, 500, 2000, 70000 };
+    static const uint8_t buckets[] = { 0, 1, 2, 8, 9, 11, EOK_RUNNERPROFILER_BUCKETS-1 };
+    EOtheRunnerProfiler *p = eo_runnerprofiler_GetHandle();
+    const eOrunnerprofiler_phasestatistics_t *cycle = &s_test_nvram.phases[eo_runnerprofiler_phase_cycle];
+    eOrunnerprofiler_statistics_t stats;
+    uint64_t worststart = 0;
+    uint32_t sum = 0;
+    uint8_t i;
+
+    TEST_CHECK(eores_NOK_generic == eo_runnerprofiler_Stop(p, eo_runnerprofiler_phase_cycle));
+
+    s_test_now = 5000000;
+    for(i=0; i<sizeof(durations)/sizeof(durations[0]); i++)
+    {
+        if(70000 == durations[i])
+        {
+            worststart = s_test_now / 1000;
+        }
+        s_test_phase(p, eo_runnerprofiler_phase_cycle, durations[i]);
+        s_test_elapse(5000);
+        sum += durations[i];
+
+        // the nv is valid at every stop
+        TEST_CHECK(i + 1 == cycle->count);
+        TEST_CHECK(sum / (i + 1) == cycle->mean);
+    }
+
+    TEST_CHECK(eores_NOK_generic == eo_runnerprofiler_Stop(p, eo_runnerprofiler_phase_cycle));
+
+    TEST_CHECK(eores_OK == eo_runnerprofiler_GetStatistics(p, &stats));
+    TEST_CHECK(0 == memcmp(&stats, &s_test_nvram, sizeof(stats)));
+    TEST_CHECK(7 == stats.phases[eo_runnerprofiler_phase_cycle].count);
+    TEST_CHECK(0 == stats.phases[eo_runnerprofiler_phase_cycle].min);
+    TEST_CHECK(70000 == stats.phases[eo_runnerprofiler_phase_cycle].max);
+    TEST_CHECK(72754 / 7 == stats.phases[eo_runnerprofiler_phase_cycle].mean);
+    TEST_CHECK(2 == stats.phases[eo_runnerprofiler_phase_cycle].overruns);
+    TEST_CHECK(worststart == stats.worstcycletime);
+    for(i=0; i<sizeof(buckets)/sizeof(buckets[0]); i++)
+    {
+        TEST_CHECK(1 == stats.phases[eo_runnerprofiler_phase_cycle].histogram[buckets[i]]);
+    }
+    // the other phases are untouched
+    TEST_CHECK(0 == stats.phases[eo_runnerprofiler_phase_rx].count);
+}
+
+
+static void s_test_saturation_and_reset(void)
+{
+    EOtheRunnerProfiler *p = eo_runnerprofiler_GetHandle();
+    uint32_t *bucket = &s_test_nvram.phases[eo_runnerprofiler_phase_do].histogram[9];
+
+    // a bucket counts well beyond the 65535 of a uint16_t
+    *bucket = 70000;
+    s_test_phase(p, eo_runnerprofiler_phase_do, 300);
+    TEST_CHECK(70001 == *bucket);
+
+    *bucket = 0xfffffffe;
+    s_test_phase(p, eo_runnerprofiler_phase_do, 300);
+    s_test_phase(p, eo_runnerprofiler_phase_do, 300);
+    TEST_CHECK(0xffffffff == *bucket);
+
+    // the reset clears the nv and the phases in progress
+    TEST_CHECK(eores_OK == eo_runnerprofiler_Start(p, eo_runnerprofiler_phase_tx));
+    TEST_CHECK(eores_OK == eo_runnerprofiler_Reset(p));
+    TEST_CHECK(0 == *bucket);
+    TEST_CHECK(0 == s_test_nvram.phases[eo_runnerprofiler_phase_cycle].count);
+    TEST_CHECK(0 == s_test_nvram.worstcycletime);
+    TEST_CHECK(eores_NOK_generic == eo_runnerprofiler_Stop(p, eo_runnerprofiler_phase_tx));
+}
+
+
+// the phases as the userdef hooks of overridden_runner.c mark them. one cycle in 10 has a DO of 350 usec, one cycle
+// in 100 has a RX of 450 usec: the cycle goes beyond its period only when both happen.
+static void s_test_runner(void)
+{
+    EOtheRunnerProfiler *p = eo_runnerprofiler_GetHandle();
+    eOrunnerprofiler_statistics_t stats;
+    uint32_t k;
+
+    eo_runnerprofiler_Reset(p);
+
+    for(k=0; k<TEST_CYCLES; k++)
+    {
+        uint32_t rx = (0 == k % 100) ? (450) : (120);
+        uint32_t dx = (0 == k % 10) ? (350) : (200);
+
+        TEST_CHECK(eores_OK == eo_runnerprofiler_Start(p, eo_runnerprofiler_phase_cycle));
+        s_test_phase(p, eo_runnerprofiler_phase_rx, rx);
+        s_test_elapse(10);
+        s_test_phase(p, eo_runnerprofiler_phase_do, dx);
+        s_test_elapse(10);
+        s_test_phase(p, eo_runnerprofiler_phase_tx, 200);
+        TEST_CHECK(eores_OK == eo_runnerprofiler_Stop(p, eo_runnerprofiler_phase_cycle));
+        s_test_elapse(1000 - (rx + dx + 220) % 1000);
+    }
+
+    eo_runnerprofiler_GetStatistics(p, &stats);
+    TEST_CHECK(TEST_CYCLES == stats.phases[eo_runnerprofiler_phase_cycle].count);
+    TEST_CHECK(TEST_CYCLES/100 == stats.phases[eo_runnerprofiler_phase_rx].overruns);
+    TEST_CHECK(TEST_CYCLES/10 == stats.phases[eo_runnerprofiler_phase_do].overruns);
+    TEST_CHECK(0 == stats.phases[eo_runnerprofiler_phase_tx].overruns);
+    TEST_CHECK(TEST_CYCLES/100 == stats.phases[eo_runnerprofiler_phase_cycle].overruns);
+    TEST_CHECK(450 + 350 + 220 == stats.phases[eo_runnerprofiler_phase_cycle].max);
+    TEST_CHECK(120 + 200 + 220 == stats.phases[eo_runnerprofiler_phase_cycle].min);
+    TEST_CHECK(200 == stats.phases[eo_runnerprofiler_phase_tx].mean);
+
+    printf("runnerprofiler-test: %u cycles: cycle mean %u usec max %u usec, %u overruns of the period\n", 
+           (unsigned)stats.phases[eo_runnerprofiler_phase_cycle].count, (unsigned)stats.phases[eo_runnerprofiler_phase_cycle].mean, 
+           (unsigned)stats.phases[eo_runnerprofiler_phase_cycle].max, (unsigned)stats.phases[eo_runnerprofiler_phase_cycle].overruns);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       encreader-test.c
+    @brief      host test of eo_appEncReader_WaitReady() and of the isr of the last encoder of a chain of the
+                EOappEncodersReader of the mc4plus, run over the fake hal_encoder of fake-hal-encoder.c.
+                it checks that:
+                - the wait ends when the last isr of the slowest chain arrives, and not at the timeout.
+                - the task is blocked on the semaphore during the wait, and the time it gives back to the other
+                  tasks is printed.
+                - the wait returns at once if the reading is already finished.
+                - a chain whose isr never comes makes the wait end at the timeout, rounded up to the tick, and
+                  counts it.
+                - the callbackOnLastRead is called once per reading also when a single chain is configured.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "EoCommon.h"
+#include "EOappEncodersReader.h"
+#include "osal_system.h"
+
+#include "fake-hal-encoder.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)    s_test_check((cond), #cond, __LINE__)
+
+// the timeout used by the DO phase of the mc4plus
+#define TEST_TIMEOUT        150
+
+// the tick of osal in the fake, to which the wait rounds up the timeout
+#define TEST_TICK           1000
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static void s_test_cfg_aea(eOappEncReader_cfg_t *cfg, uint8_t numjoints);
+static void s_test_on_lastread(void *arg);
+
+static void s_test_both_chains(void);
+static void s_test_already_ready(void);
+static void s_test_broken_chain(void);
+static void s_test_single_chain(void);
+static void s_test_nullpointer(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static uint32_t s_test_lastreads = 0;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    s_test_both_chains();
+    s_test_already_ready();
+    s_test_broken_chain();
+    s_test_single_chain();
+    s_test_nullpointer();
+
+    if(0 != s_test_failures)
+    {
+        printf("encreader-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("encreader-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        printf("encreader-test: line %d: %s failed\n", line, str);
+        s_test_failures++;
+    }
+}
+
+
+// one aea encoder per joint in the positions 0, 1, 2, ... : positions 0, 2, 4 are on stream0 and 1, 3, 5 on stream1
+static void s_test_cfg_aea(eOappEncReader_cfg_t *cfg, uint8_t numjoints)
+{
+    uint8_t i;
+
+    memset(cfg, 0, sizeof(eOappEncReader_cfg_t));
+
+    for(i=0; i<eOappEncReader_joint_numberof; i++)
+    {
+        cfg->joints[i].primary_encoder      = (i < numjoints) ? eo_appEncReader_enc_type_AEA : eo_appEncReader_enc_type_NONE;
+        cfg->joints[i].primary_enc_position = (i < numjoints) ? (eo_appEncReader_encoder_position_t)i : eo_appEncReader_encoder_positionNONE;
+        cfg->joints[i].extra_encoder        = eo_appEncReader_enc_type_NONE;
+        cfg->joints[i].extra_enc_position   = eo_appEncReader_encoder_positionNONE;
+    }
+
+    cfg->SPI_streams[eo_appEncReader_stream0].type      = hal_encoder_t1;
+    cfg->SPI_streams[eo_appEncReader_stream0].numberof  = (numjoints + 1) / 2;
+    cfg->SPI_streams[eo_appEncReader_stream1].type      = hal_encoder_t1;
+    cfg->SPI_streams[eo_appEncReader_stream1].numberof  = numjoints / 2;
+
+    cfg->SPI_callbackOnLastRead = s_test_on_lastread;
+    cfg->SPI_callback_arg       = NULL;
+
+    s_test_lastreads = 0;
+}
+
+
+static void s_test_on_lastread(void *arg)
+{
+    s_test_lastreads++;
+}
+
+
+// three encoders on stream0 (60 usec + 30 usec + 30 usec) and three on stream1 (30 usec each): the wait must end when
+// the last isr of stream0 arrives, 120 usec after the start.
+static void s_test_both_chains(void)
+{
+    eOappEncReader_cfg_t cfg;
+    eOappEncReader_waitinfo_t waitinfo;
+    EOappEncReader *reader = NULL;
+    fake_hal_encoder_counters_t before;
+    fake_hal_encoder_counters_t after;
+    uint32_t cycle;
+
+    fake_hal_encoder_Reset(1);
+    fake_hal_encoder_SetTransferTime(hal_encoder1, 60);
+    s_test_cfg_aea(&cfg, 6);
+
+    reader = eo_appEncReader_New(&cfg);
+    TEST_CHECK(NULL != reader);
+
+    for(cycle=0; cycle<3; cycle++)
+    {
+        uint64_t start = fake_hal_encoder_Now();
+
+        TEST_CHECK(eores_OK == eo_appEncReader_StartRead(reader));
+        TEST_CHECK(eobool_false == eo_appEncReader_isReady(reader));
+
+        fake_hal_encoder_counters_Get(&before);
+        TEST_CHECK(eobool_true == eo_appEncReader_WaitReady(reader, TEST_TIMEOUT));
+        fake_hal_encoder_counters_Get(&after);
+        TEST_CHECK(eobool_true == eo_appEncReader_isReady(reader));
+
+        TEST_CHECK(eores_OK == eo_appEncReader_GetWaitInfo(reader, &waitinfo));
+        // the clock is read twice by StartRead() before the wait starts and once by the isr of the last encoder
+        TEST_CHECK((waitinfo.last >= 120 - 3) && (waitinfo.last <= 120 + 3));
+        TEST_CHECK(fake_hal_encoder_Now() - start < 120 + 8);
+        TEST_CHECK(0 == waitinfo.timeouts);
+        TEST_CHECK(cycle + 1 == s_test_lastreads);
+
+        // the task does not spin: it reads the clock at the start and at the end of the wait, and the isrs of the two
+        // chains read it once each. the time of the wait goes to the other tasks.
+        TEST_CHECK(after.clockreads - before.clockreads <= 4);
+        TEST_CHECK(after.blocked - before.blocked + 3 >= waitinfo.last);
+    }
+
+    printf("encreader-test: a wait of %u usec reads the clock %u times (once per usec when it spun) and gives %u usec back to the other tasks\n",
+           (unsigned)waitinfo.last, (unsigned)(after.clockreads - before.clockreads), (unsigned)(after.blocked - before.blocked));
+
+    TEST_CHECK(waitinfo.max >= waitinfo.last);
+}
+
+
+static void s_test_already_ready(void)
+{
+    eOappEncReader_cfg_t cfg;
+    eOappEncReader_waitinfo_t waitinfo;
+    EOappEncReader *reader = NULL;
+    fake_hal_encoder_counters_t before;
+    fake_hal_encoder_counters_t after;
+    uint32_t i;
+
+    fake_hal_encoder_Reset(1);
+    s_test_cfg_aea(&cfg, 4);
+    reader = eo_appEncReader_New(&cfg);
+
+    eo_appEncReader_StartRead(reader);
+    // the application does something else meanwhile, which takes time
+    for(i=0; i<200; i++)
+    {
+        osal_system_abstime_get();
+    }
+
+    fake_hal_encoder_counters_Get(&before);
+    TEST_CHECK(eobool_true == eo_appEncReader_WaitReady(reader, TEST_TIMEOUT));
+    fake_hal_encoder_counters_Get(&after);
+
+    eo_appEncReader_GetWaitInfo(reader, &waitinfo);
+    TEST_CHECK(0 == waitinfo.last);
+    TEST_CHECK(0 == waitinfo.timeouts);
+    // no spin at all
+    TEST_CHECK(before.clockreads == after.clockreads);
+    TEST_CHECK(1 == s_test_lastreads);
+}
+
+
+static void s_test_broken_chain(void)
+{
+    eOappEncReader_cfg_t cfg;
+    eOappEncReader_waitinfo_t waitinfo;
+    EOappEncReader *reader = NULL;
+
+    fake_hal_encoder_Reset(1);
+    // the second encoder of stream1 never answers
+    fake_hal_encoder_SetTransferTime(hal_encoder4, FAKE_HAL_ENCODER_NEVER);
+    s_test_cfg_aea(&cfg, 6);
+    reader = eo_appEncReader_New(&cfg);
+
+    eo_appEncReader_StartRead(reader);
+    TEST_CHECK(eobool_false == eo_appEncReader_WaitReady(reader, TEST_TIMEOUT));
+    TEST_CHECK(eobool_true == eo_appEncReader_isReadySPI_stream0(reader));
+    TEST_CHECK(eobool_false == eo_appEncReader_isReadySPI_stream1(reader));
+
+    // the timeout shorter than a tick is rounded up to a tick, else osal would not block at all
+    eo_appEncReader_GetWaitInfo(reader, &waitinfo);
+    TEST_CHECK(waitinfo.last >= TEST_TICK);
+    TEST_CHECK(waitinfo.last <= TEST_TICK + 2);
+    TEST_CHECK(1 == waitinfo.timeouts);
+    TEST_CHECK(0 == s_test_lastreads);
+
+    // the next cycle with the chain repaired: the max keeps the timeout
+    fake_hal_encoder_SetTransferTime(hal_encoder4, 30);
+    eo_appEncReader_StartRead(reader);
+    TEST_CHECK(eobool_true == eo_appEncReader_WaitReady(reader, TEST_TIMEOUT));
+    eo_appEncReader_GetWaitInfo(reader, &waitinfo);
+    TEST_CHECK(waitinfo.last < TEST_TIMEOUT);
+    TEST_CHECK(waitinfo.max >= TEST_TIMEOUT);
+    TEST_CHECK(1 == waitinfo.timeouts);
+    TEST_CHECK(1 == s_test_lastreads);
+}
+
+
+// before, the callbackOnLastRead was called only when both chains were configured
+static void s_test_single_chain(void)
+{
+    eOappEncReader_cfg_t cfg;
+    EOappEncReader *reader = NULL;
+
+    fake_hal_encoder_Reset(1);
+    s_test_cfg_aea(&cfg, 1);
+    reader = eo_appEncReader_New(&cfg);
+
+    eo_appEncReader_StartRead(reader);
+    TEST_CHECK(eobool_true == eo_appEncReader_WaitReady(reader, TEST_TIMEOUT));
+    TEST_CHECK(1 == s_test_lastreads);
+
+    eo_appEncReader_StartRead(reader);
+    TEST_CHECK(eobool_true == eo_appEncReader_WaitReady(reader, TEST_TIMEOUT));
+    TEST_CHECK(2 == s_test_lastreads);
+}
+
+
+static void s_test_nullpointer(void)
+{
+    eOappEncReader_waitinfo_t waitinfo;
+
+    TEST_CHECK(eobool_false == eo_appEncReader_WaitReady(NULL, TEST_TIMEOUT));
+    TEST_CHECK(eores_NOK_nullpointer == eo_appEncReader_GetWaitInfo(NULL, &waitinfo));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "string.h"
+#include "EoCommon.h"
+#include "EOtheMemoryPool.h"
+#include "hal_encoder.h"
+#include "hal_quad_enc.h"
+#include "osal_system.h"
+#include "osal_info.h"
+#include "osal_semaphore.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of extern public interface
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "fake-hal-encoder.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define FAKE_TRANSFERTIME_DEFAULT   30
+#define FAKE_TIME_START             1000
+#define FAKE_TICK                   1000
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    hal_encoder_cfg_t   cfg;
+    uint8_t             initted;
+    uint8_t             pending;
+    uint64_t            completeat;
+    uint32_t            transfertime;
+} fake_encoder_t;
+
+typedef struct
+{
+    uint8_t             maxtokens;
+    uint8_t             tokens;
+} fake_semaphore_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_fake_isrs_run(void);
+static fake_encoder_t* s_fake_isrs_next(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static fake_encoder_t s_fake_encoders[hal_encoders_number];
+
+static uint64_t s_fake_now = FAKE_TIME_START;
+
+static uint32_t s_fake_step = 1;
+
+static uint8_t s_fake_inisr = 0;
+
+static fake_hal_encoder_counters_t s_fake_counters = { 0 };
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+extern void fake_hal_encoder_Reset(uint32_t step)
+{
+    uint8_t i;
+
+    memset(s_fake_encoders, 0, sizeof(s_fake_encoders));
+    for(i=0; i<hal_encoders_number; i++)
+    {
+        s_fake_encoders[i].transfertime = FAKE_TRANSFERTIME_DEFAULT;
+    }
+
+    memset(&s_fake_counters, 0, sizeof(s_fake_counters));
+    s_fake_now = FAKE_TIME_START;
+    s_fake_step = step;
+    s_fake_inisr = 0;
+}
+
+
+extern void fake_hal_encoder_SetTransferTime(hal_encoder_t id, uint32_t usec)
+{
+    if(id < hal_encoders_number)
+    {
+        s_fake_encoders[id].transfertime = usec;
+    }
+}
+
+
+extern uint64_t fake_hal_encoder_Now(void)
+{
+    return(s_fake_now);
+}
+
+
+extern void fake_hal_encoder_counters_Get(fake_hal_encoder_counters_t *counters)
+{
+    *counters = s_fake_counters;
+}
+
+
+// the functions of the hal, of osal and of the memory pool used by EOappEncodersReader.c
+
+extern hal_result_t hal_encoder_init(hal_encoder_t id, const hal_encoder_cfg_t *cfg)
+{
+    if((id >= hal_encoders_number) || (NULL == cfg))
+    {
+        return(hal_res_NOK_generic);
+    }
+
+    s_fake_encoders[id].cfg = *cfg;
+    s_fake_encoders[id].initted = 1;
+    s_fake_encoders[id].pending = 0;
+    s_fake_counters.inits++;
+
+    return(hal_res_OK);
+}
+
+
+extern hal_result_t hal_encoder_read_start(hal_encoder_t id)
+{
+    if((id >= hal_encoders_number) || (0 == s_fake_encoders[id].initted))
+    {
+        return(hal_res_NOK_generic);
+    }
+
+    s_fake_counters.starts++;
+
+    if(FAKE_HAL_ENCODER_NEVER == s_fake_encoders[id].transfertime)
+    {   // the read starts but its isr never comes
+        s_fake_encoders[id].pending = 0;
+        return(hal_res_OK);
+    }
+
+    s_fake_encoders[id].pending = 1;
+    s_fake_encoders[id].completeat = s_fake_now + s_fake_encoders[id].transfertime;
+
+    return(hal_res_OK);
+}
+
+
+extern hal_result_t hal_encoder_get_value(hal_encoder_t id, hal_encoder_position_t* pos, hal_encoder_errors_flags* e_flags)
+{
+    if((id >= hal_encoders_number) || (NULL == pos) || (NULL == e_flags))
+    {
+        return(hal_res_NOK_generic);
+    }
+
+    // a valid aea frame: status bits 0x20 and even parity over 18 bits
+    *pos = 0x20;
+    memset(e_flags, 0, sizeof(hal_encoder_errors_flags));
+
+    return(hal_res_OK);
+}
+
+
+extern void hal_quad_enc_single_init(uint8_t encoder_number)
+{
+}
+
+
+extern uint32_t hal_quad_enc_getCounter(uint8_t encoder_number)
+{
+    return(0);
+}
+
+
+extern osal_abstime_t osal_system_abstime_get(void)
+{
+    osal_abstime_t t = s_fake_now;
+
+    s_fake_counters.clockreads++;
+    s_fake_now += s_fake_step;
+
+    s_fake_isrs_run();
+
+    return(t);
+}
+
+
+extern osal_reltime_t osal_info_get_tick(void)
+{
+    return(FAKE_TICK);
+}
+
+
+extern osal_semaphore_t * osal_semaphore_new(uint8_t maxtokens, uint8_t tokens)
+{
+    fake_semaphore_t *s = calloc(1, sizeof(fake_semaphore_t));
+
+    s->maxtokens = maxtokens;
+    s->tokens = tokens;
+
+    return((osal_semaphore_t*)s);
+}
+
+
+extern osal_result_t osal_semaphore_set(osal_semaphore_t *sem, uint8_t tokens)
+{
+    fake_semaphore_t *s = (fake_semaphore_t*)sem;
+
+    if(NULL == s)
+    {
+        return(osal_res_NOK_nullpointer);
+    }
+
+    s->tokens = tokens;
+
+    return(osal_res_OK);
+}
+
+
+extern osal_result_t osal_semaphore_increment(osal_semaphore_t *sem, osal_caller_t caller)
+{
+    fake_semaphore_t *s = (fake_semaphore_t*)sem;
+
+    if(NULL == s)
+    {
+        return(osal_res_NOK_nullpointer);
+    }
+
+    if(s->tokens >= s->maxtokens)
+    {
+        return(osal_res_NOK_generic);
+    }
+
+    s->tokens++;
+
+    return(osal_res_OK);
+}
+
+
+// the calling task is blocked: the time jumps to the next isr (or to the timeout) without reading the clock, and the
+// isrs run there. as in osal, the timeout is truncated to whole ticks.
+extern osal_result_t osal_semaphore_decrement(osal_semaphore_t *sem, osal_reltime_t tout)
+{
+    fake_semaphore_t *s = (fake_semaphore_t*)sem;
+    uint64_t deadline = 0;
+    uint64_t next = 0;
+    fake_encoder_t *e = NULL;
+
+    if(NULL == s)
+    {
+        return(osal_res_NOK_nullpointer);
+    }
+
+    deadline = s_fake_now + (tout / FAKE_TICK) * FAKE_TICK;
+
+    while((0 == s->tokens) && (s_fake_now < deadline))
+    {
+        e = s_fake_isrs_next();
+        next = ((NULL == e) || (e->completeat > deadline)) ? (deadline) : (e->completeat);
+        if(next > s_fake_now)
+        {
+            s_fake_counters.blocked += (uint32_t)(next - s_fake_now);
+            s_fake_now = next;
+        }
+        s_fake_isrs_run();
+    }
+
+    if(0 == s->tokens)
+    {
+        return(osal_res_NOK_timeout);
+    }
+
+    s->tokens--;
+
+    return(osal_res_OK);
+}
+
+
+extern EOtheMemoryPool* eo_mempool_GetHandle(void)
+{
+    return(NULL);
+}
+
+
+extern void* eo_mempool_GetMemory(EOtheMemoryPool *p, eOmempool_alignment_t alignmode, uint16_t size, uint16_t number)
+{   // as the pool in dynamic mode: zeroed memory which is never released
+    return(calloc(number, size));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+// the isrs of the reads which are complete at the current time are executed in order of completion. an isr may start
+// the read of the next encoder of the chain, and it may read the time, thus we do not enter in here recursively.
+static void s_fake_isrs_run(void)
+{
+    fake_encoder_t *next = NULL;
+
+    if(0 != s_fake_inisr)
+    {
+        return;
+    }
+
+    s_fake_inisr = 1;
+
+    for(;;)
+    {
+        next = s_fake_isrs_next();
+
+        if((NULL == next) || (next->completeat > s_fake_now))
+        {
+            break;
+        }
+
+        next->pending = 0;
+        s_fake_counters.isrs++;
+        if(NULL != next->cfg.callback_on_rx)
+        {
+            next->cfg.callback_on_rx(next->cfg.arg);
+        }
+    }
+
+    s_fake_inisr = 0;
+}
+
+
+// the pending read which completes first, or NULL
+static fake_encoder_t* s_fake_isrs_next(void)
+{
+    fake_encoder_t *next = NULL;
+    uint8_t i;
+
+    for(i=0; i<hal_encoders_number; i++)
+    {
+        fake_encoder_t *e = &s_fake_encoders[i];
+        if((0 != e->pending) && ((NULL == next) || (e->completeat < next->completeat)))
+        {
+            next = e;
+        }
+    }
+
+    return(next);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// - include guard ----------------------------------------------------------------------------------------------------
+#ifndef _FAKE_HAL_ENCODER_H_
+#define _FAKE_HAL_ENCODER_H_
+
+
+/** @file       fake-hal-encoder.h
+    @brief      This header file gives the control of a host replacement of hal_encoder, hal_quad_enc and of the time and
+                the semaphores of osal used to run EOappEncodersReader on linux.
+                the time is simulated in usec: every call of osal_system_abstime_get() advances it by one step, as the
+                code which runs on the board does. a read of an encoder started with hal_encoder_read_start() completes
+                after its transfer time, and then its callback_on_rx is called from inside osal_system_abstime_get(),
+                as the isr of the spi would do. a task blocked in osal_semaphore_decrement() does not read the time: the
+                time jumps to the next isr or to the timeout, and it is counted as given back to the other tasks.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+
+// - external dependencies --------------------------------------------------------------------------------------------
+
+#include "stdint.h"
+#include "hal_encoder.h"
+
+
+// - public #define  --------------------------------------------------------------------------------------------------
+
+#define FAKE_HAL_ENCODER_NEVER      0xffffffff
+
+
+// - declaration of public user-defined types -------------------------------------------------------------------------
+
+typedef struct
+{
+    uint32_t    inits;          /**< the calls of hal_encoder_init() */
+    uint32_t    starts;         /**< the calls of hal_encoder_read_start() */
+    uint32_t    isrs;           /**< the calls of the callback_on_rx */
+    uint32_t    clockreads;     /**< the calls of osal_system_abstime_get() */
+    uint32_t    blocked;        /**< the usec spent blocked in osal_semaphore_decrement(), which go to the other tasks */
+} fake_hal_encoder_counters_t;
+
+
+// - declaration of extern public functions ---------------------------------------------------------------------------
+
+/** @fn         extern void fake_hal_encoder_Reset(uint32_t step)
+    @brief      Forgets the configuration of all the encoders, the pending reads and the counters and it restarts the
+                time from 1000 usec. The tick of osal is 1000 usec, as on the boards.
+    @param      step        the usec added to the time by each call of osal_system_abstime_get()
+ **/
+extern void fake_hal_encoder_Reset(uint32_t step);
+
+
+/** @fn         extern void fake_hal_encoder_SetTransferTime(hal_encoder_t id, uint32_t usec)
+    @brief      Sets the time a read of encoder @e id takes before its isr. FAKE_HAL_ENCODER_NEVER keeps the read
+                pending forever, as for a broken chain. The default is 30 usec.
+ **/
+extern void fake_hal_encoder_SetTransferTime(hal_encoder_t id, uint32_t usec);
+
+
+extern uint64_t fake_hal_encoder_Now(void);
+
+extern void fake_hal_encoder_counters_Get(fake_hal_encoder_counters_t *counters);
+
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
@@ -0,0 +1 @@
+// EOappEncodersReader.c includes OPCprotocolManager_Cfg.h but it does not use anything of it
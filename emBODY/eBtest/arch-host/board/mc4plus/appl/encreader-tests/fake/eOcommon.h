@@ -0,0 +1,2 @@
+// EOappEncodersReader.h includes eOcommon.h, which on windows is the EoCommon.h of the embobj core
+#include "EoCommon.h"
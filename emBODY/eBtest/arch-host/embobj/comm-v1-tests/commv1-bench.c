@@ -0,0 +1,819 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       commv1-bench.c
+    @brief      host benchmark of the comm-v1 protocol stack.
+                it builds the board eb1 (EOtheBOARDtransceiver, local nvs) and its host (EOhostTransceiver, remote nvs)
+                and it measures:
+                - board tx: eo_transceiver_outpacket_Prepare() + _Get() of the regular rops of the joints and motors.
+                - host rx: eo_transceiver_Receive() of those packets (eo_receiver_Process() + eo_agent_InpROPprocess()).
+                - host tx / board rx: a burst of set<> of the pids of all joints, as in a reconfiguration.
+                - parse: eo_ropframe_ROP_Parse() alone over the same burst.
+                - board tx copies: the same regular rops sent over the fake ipal, once with eo_transceiver_outpacket_Prepare() +
+                  _Get() + ipal_udpsocket_sendto() and once with eo_transceiver_Transmit(), which forms the ropframe inside
+                  the buffer of the stack.
+                - board tx on change: the same regular rops loaded with the onchange bit, when at every cycle the application
+                  writes only the status of one joint.
+                - replay: eo_transceiver_Receive() on the host of the ropframes in the files given on the command line,
+                  each one the payload of a udp packet sent by eb1 (as captured from the network).
+                for each one it prints ns/rop, rops/s, allocations, mutex takes and bytes copied per packet.
+                usage: commv1-bench [-n iterations] [ropframe.bin ...]
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "EoCommon.h"
+#include "EOpacket.h"
+#include "EOropframe.h"
+#include "EOropframe_hid.h"
+#include "EOrop.h"
+#include "EOrop_hid.h"
+#include "EOtransceiver.h"
+#include "EOtheBOARDtransceiver.h"
+#include "EOhostTransceiver.h"
+#include "EOtheBOARDtransceiver_hid.h"
+#include "EOnvsCfg.h"
+#include "EOnv_hid.h"
+
+#include "eOcfg_EPs_eb1.h"
+#include "eOcfg_nvsEP_mc.h"
+#include "eOcfg_nvsEP_mc_upperarm_con.h"
+
+#include "ipal.h"
+#include "ipal_f_udp_hid.h"
+
+#include "commv1-shims.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    const char          *name;
+    uint64_t            nanosecs;
+    uint64_t            packets;
+    uint64_t            rops;
+    uint64_t            bytes;
+    commv1_shims_counters_t counters;
+} commv1_bench_result_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_bench_start(commv1_bench_result_t *r, const char *name);
+static void s_bench_stop(commv1_bench_result_t *r, uint64_t start);
+static void s_bench_print(const commv1_bench_result_t *r);
+
+static void s_packet_copy(EOpacket *dst, EOpacket *src, eOipv4addr_t from);
+static uint16_t s_packet_load(EOpacket *dst, const uint8_t *data, uint16_t size, eOipv4addr_t from);
+
+static uint16_t s_board_load_regulars(EOtransceiver *board, uint8_t onchange);
+static uint16_t s_host_load_burst(EOtransceiver *host);
+
+static void s_bench_board_tx_host_rx(EOtransceiver *board, EOtransceiver *host, uint32_t iterations);
+static void s_bench_host_tx_board_rx(EOtransceiver *host, EOtransceiver *board, uint32_t iterations);
+static void s_bench_board_tx_copies(EOtransceiver *board, uint32_t iterations);
+static void s_bench_board_tx_onchange(EOtransceiver *board, uint32_t iterations);
+static void s_bench_host_rx_batched(EOtransceiver *board, EOtransceiver *host, EOtransceiver *hostbatched, uint32_t iterations);
+static void s_bench_compact(EOtransceiver *board, uint32_t iterations);
+static uint16_t s_compact_roundtrip(EOropframe *frame, EOropframe *expanded, uint8_t *compact, uint16_t capacity);
+static void s_bench_replay(EOtransceiver *host, const char *filename, uint32_t iterations);
+
+static uint8_t* s_ipal_getbuffer(void *arg, uint16_t capacity);
+static eOresult_t s_ipal_commit(void *arg, uint8_t *buffer, uint16_t size, eOipv4addr_t remaddr, eOipv4port_t remport);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static const eOipv4addr_t s_boardipaddr = EO_COMMON_IPV4ADDR(10, 0, 1, 1);
+static const eOipv4addr_t s_hostipaddr = EO_COMMON_IPV4ADDR(10, 0, 1, 104);
+static const eOipv4port_t s_port = 12345;
+static const ipal_tos_t s_tos = { .precedence = ipal_prec_priority, .lowdelay = 1, .highthroughput = 1, .highreliability = 1, .unused = 0 };
+
+static ipal_udpsocket_t *s_socket = NULL;
+
+static EOpacket *s_rxpacket = NULL;
+
+static const eOcfg_nvsEP_mc_jointNVindex_t s_burst_joint_nvs[] =
+{
+    jointNVindex_jconfig__pidposition, jointNVindex_jconfig__pidvelocity, jointNVindex_jconfig__pidtorque,
+    jointNVindex_jconfig__impedance
+};
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of main
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = 10000;
+    int i = 1;
+    eOboardtransceiver_cfg_t boardcfg;
+    eOhosttransceiver_cfg_t hostcfg;
+    EOtransceiver *board = NULL;
+    EOhostTransceiver *host = NULL;
+    EOhostTransceiver *hostbatched = NULL;
+
+    if((argc > 2) && (0 == strcmp(argv[1], "-n")))
+    {
+        iterations = strtoul(argv[2], NULL, 0);
+        i = 3;
+    }
+
+    commv1_shims_Initialise();
+
+    // the board eb1 as configured on the ems
+
+    memcpy(&boardcfg, &eo_boardtransceiver_cfg_default, sizeof(boardcfg));
+    boardcfg.vectorof_endpoint_cfg                  = eo_cfg_EPs_vectorof_eb1;
+    boardcfg.hashfunction_ep2index                  = eo_cfg_nvsEP_eb1_fptr_hashfunction_ep2index;
+    boardcfg.remotehostipv4addr                     = s_hostipaddr;
+    boardcfg.remotehostipv4port                     = s_port;
+    boardcfg.sizes.capacityoftxpacket               = 1024;
+    boardcfg.sizes.capacityofrop                    = 192;
+    boardcfg.sizes.capacityofropframeregulars       = 768;
+    boardcfg.sizes.capacityofropframeoccasionals    = 128;
+    boardcfg.sizes.capacityofropframereplies        = 128;
+    boardcfg.sizes.maxnumberofregularrops           = 32;
+    boardcfg.mutex_fn_new                           = commv1_shims_mutex_New;
+    boardcfg.transprotection                        = eo_trans_protection_enabled;
+    boardcfg.nvscfgprotection                       = eo_nvscfg_protection_one_per_endpoint;
+    boardcfg.txbuffer.getbuffer                     = s_ipal_getbuffer;
+    boardcfg.txbuffer.commit                        = s_ipal_commit;
+    boardcfg.txbuffer.arg                           = NULL;
+
+    s_socket = ipal_udpsocket_new(s_tos);
+
+    board = eo_boardtransceiver_Initialise(&boardcfg);
+
+    // its host
+
+    memcpy(&hostcfg, &eo_hosttransceiver_cfg_default, sizeof(hostcfg));
+    hostcfg.vectorof_endpoint_cfg                   = eo_cfg_EPs_vectorof_eb1;
+    hostcfg.hashfunction_ep2index                   = eo_cfg_nvsEP_eb1_fptr_hashfunction_ep2index;
+    hostcfg.remoteboardipv4addr                     = s_boardipaddr;
+    hostcfg.remoteboardipv4port                     = s_port;
+    hostcfg.mutex_fn_new                            = commv1_shims_mutex_New;
+    hostcfg.transprotection                         = eo_trans_protection_enabled;
+    hostcfg.nvscfgprotection                        = eo_nvscfg_protection_one_per_endpoint;
+
+    host = eo_hosttransceiver_New(&hostcfg);
+
+    // the same host which processes the rops of an endpoint in batches
+
+    hostcfg.maxnumberofropsinbatch                  = 32;
+
+    hostbatched = eo_hosttransceiver_New(&hostcfg);
+
+    s_rxpacket = eo_packet_New(EOK_HOSTTRANSCEIVER_capacityofrxpacket);
+
+    printf("%-24s %10s %12s %12s %14s %14s %14s\n", "test", "rops/pkt", "ns/rop", "rops/s", "allocs/pkt", "mtxtakes/pkt", "copiedB/pkt");
+
+    s_bench_board_tx_host_rx(board, eo_hosttransceiver_Transceiver(host), iterations);
+    s_bench_host_tx_board_rx(eo_hosttransceiver_Transceiver(host), board, iterations);
+    s_bench_board_tx_copies(board, iterations);
+    s_bench_board_tx_onchange(board, iterations);
+    s_bench_host_rx_batched(board, eo_hosttransceiver_Transceiver(host), eo_hosttransceiver_Transceiver(hostbatched), iterations);
+    s_bench_compact(board, iterations);
+
+    for(; i<argc; i++)
+    {
+        s_bench_replay(eo_hosttransceiver_Transceiver(host), argv[i], iterations);
+    }
+
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_bench_start(commv1_bench_result_t *r, const char *name)
+{
+    memset(r, 0, sizeof(*r));
+    r->name = name;
+    commv1_shims_counters_Reset();
+}
+
+static void s_bench_stop(commv1_bench_result_t *r, uint64_t start)
+{
+    r->nanosecs = commv1_shims_nanotime() - start;
+    commv1_shims_counters_Get(&r->counters);
+}
+
+static void s_bench_print(const commv1_bench_result_t *r)
+{
+    double rops = (0 == r->rops) ? (1.0) : ((double)r->rops);
+    double pkts = (0 == r->packets) ? (1.0) : ((double)r->packets);
+
+    printf("%-24s %10.1f %12.1f %12.0f %14.2f %14.2f %14.1f\n", r->name,
+           (double)r->rops / pkts,
+           (double)r->nanosecs / rops,
+           (0 == r->nanosecs) ? (0.0) : (1.0e9 * (double)r->rops / (double)r->nanosecs),
+           (double)r->counters.allocations / pkts,
+           (double)r->counters.mutextakes / pkts,
+           (double)r->counters.copiedbytes / pkts);
+}
+
+
+static void s_packet_copy(EOpacket *dst, EOpacket *src, eOipv4addr_t from)
+{
+    uint8_t *data = NULL;
+    uint16_t size = 0;
+
+    eo_packet_Payload_Get(src, &data, &size);
+    s_packet_load(dst, data, size, from);
+}
+
+static uint16_t s_packet_load(EOpacket *dst, const uint8_t *data, uint16_t size, eOipv4addr_t from)
+{
+    uint8_t *payload = NULL;
+    uint16_t capacity = 0;
+    uint16_t tmp = 0;
+
+    eo_packet_Capacity_Get(dst, &capacity);
+    if(size > capacity)
+    {
+        size = capacity;
+    }
+
+    eo_packet_Payload_Get(dst, &payload, &tmp);
+    memcpy(payload, data, size);
+    eo_packet_Size_Set(dst, size);
+    // the transceiver accepts only packets coming from its remote
+    eo_packet_Addressing_Set(dst, from, s_port);
+
+    return(size);
+}
+
+
+static uint16_t s_board_load_regulars(EOtransceiver *board, uint8_t onchange)
+{   // the status of every joint and motor of the upperarm, as signalled by eb1 at every cycle
+    eOropdescriptor_t ropdes;
+    uint16_t n = 0;
+    uint8_t j = 0;
+
+    memset(&ropdes, 0, sizeof(ropdes));
+    ropdes.configuration    = eok_ropconfiguration_basic;
+    ropdes.configuration.onchange = onchange;
+    ropdes.ropcode          = eo_ropcode_sig;
+    ropdes.ep               = endpoint_mc_leftupperarm;
+
+    for(j=0; j<jointUpperArm_TOTALnumber; j++)
+    {
+        ropdes.id = eo_cfg_nvsEP_mc_upperarm_joint_NVID_Get((eo_cfg_nvsEP_mc_upperarm_con_jointNumber_t)j, jointNVindex_jstatus);
+        n += (eores_OK == eo_transceiver_rop_regular_Load(board, &ropdes)) ? (1) : (0);
+        ropdes.id = eo_cfg_nvsEP_mc_upperarm_motor_NVID_Get((eo_cfg_nvsEP_mc_upperarm_con_motorNumber_t)j, motorNVindex_mstatus);
+        n += (eores_OK == eo_transceiver_rop_regular_Load(board, &ropdes)) ? (1) : (0);
+    }
+
+    return(n);
+}
+
+
+static uint16_t s_host_load_burst(EOtransceiver *host)
+{   // set<> of the pids of every joint, as when the host configures the board
+    eOropdescriptor_t ropdes;
+    uint16_t n = 0;
+    uint8_t j = 0;
+    uint8_t k = 0;
+
+    memset(&ropdes, 0, sizeof(ropdes));
+    ropdes.configuration    = eok_ropconfiguration_basic;
+    ropdes.ropcode          = eo_ropcode_set;
+    ropdes.ep               = endpoint_mc_leftupperarm;
+
+    for(j=0; j<jointUpperArm_TOTALnumber; j++)
+    {
+        for(k=0; k<sizeof(s_burst_joint_nvs)/sizeof(s_burst_joint_nvs[0]); k++)
+        {
+            ropdes.id = eo_cfg_nvsEP_mc_upperarm_joint_NVID_Get((eo_cfg_nvsEP_mc_upperarm_con_jointNumber_t)j, s_burst_joint_nvs[k]);
+            if(eores_OK == eo_transceiver_rop_occasional_Load_without_data(host, &ropdes, 0))
+            {
+                n++;
+            }
+        }
+    }
+
+    return(n);
+}
+
+
+static void s_bench_board_tx_host_rx(EOtransceiver *board, EOtransceiver *host, uint32_t iterations)
+{
+    commv1_bench_result_t tx;
+    commv1_bench_result_t rx;
+    EOpacket *pkt = NULL;
+    uint16_t nrops = 0;
+    uint64_t start = 0;
+    uint64_t t[2] = {0, 0};
+    uint64_t a[2] = {0, 0};
+    uint64_t m[2] = {0, 0};
+    uint64_t c[2] = {0, 0};
+    uint32_t i = 0;
+    eOabstime_t time = 0;
+
+    if(0 == s_board_load_regulars(board, 0))
+    {
+        printf("board-tx: no regular rop could be loaded\n");
+        exit(EXIT_FAILURE);
+    }
+
+    s_bench_start(&tx, "board-tx-regulars");
+    s_bench_start(&rx, "host-rx-regulars");
+
+    for(i=0; i<iterations; i++)
+    {
+        commv1_shims_counters_Reset();
+        start = commv1_shims_nanotime();
+        eo_transceiver_outpacket_Prepare(board, &nrops);
+        eo_transceiver_outpacket_Get(board, &pkt);
+        s_bench_stop(&tx, start);
+        t[0] += tx.nanosecs; a[0] += tx.counters.allocations; m[0] += tx.counters.mutextakes; c[0] += tx.counters.copiedbytes;
+        tx.rops += nrops;
+        tx.packets++;
+
+        s_packet_copy(s_rxpacket, pkt, s_boardipaddr);
+
+        commv1_shims_counters_Reset();
+        start = commv1_shims_nanotime();
+        eo_transceiver_Receive(host, s_rxpacket, &nrops, &time);
+        s_bench_stop(&rx, start);
+        t[1] += rx.nanosecs; a[1] += rx.counters.allocations; m[1] += rx.counters.mutextakes; c[1] += rx.counters.copiedbytes;
+        rx.rops += nrops;
+        rx.packets++;
+    }
+
+    tx.nanosecs = t[0];     tx.counters.allocations = a[0];     tx.counters.mutextakes = m[0];     tx.counters.copiedbytes = c[0];
+    rx.nanosecs = t[1];     rx.counters.allocations = a[1];     rx.counters.mutextakes = m[1];     rx.counters.copiedbytes = c[1];
+
+    s_bench_print(&tx);
+    s_bench_print(&rx);
+}
+
+
+static void s_bench_host_tx_board_rx(EOtransceiver *host, EOtransceiver *board, uint32_t iterations)
+{
+    commv1_bench_result_t tx;
+    commv1_bench_result_t rx;
+    commv1_bench_result_t parse;
+    EOpacket *pkt = NULL;
+    EOropframe *ropframe = eo_ropframe_New();
+    EOrop *rop = eo_rop_New(256);
+    uint8_t *data = NULL;
+    uint16_t size = 0;
+    uint16_t capacity = 0;
+    uint16_t nrops = 0;
+    uint16_t unparsed = 0;
+    uint64_t start = 0;
+    uint64_t t[3] = {0, 0, 0};
+    uint64_t a[3] = {0, 0, 0};
+    uint64_t m[3] = {0, 0, 0};
+    uint64_t c[3] = {0, 0, 0};
+    uint32_t i = 0;
+    eOabstime_t time = 0;
+
+    s_bench_start(&tx, "host-tx-pidburst");
+    s_bench_start(&rx, "board-rx-pidburst");
+    s_bench_start(&parse, "parse-pidburst");
+
+    for(i=0; i<iterations; i++)
+    {
+        commv1_shims_counters_Reset();
+        start = commv1_shims_nanotime();
+        tx.rops += s_host_load_burst(host);
+        eo_transceiver_outpacket_Prepare(host, &nrops);
+        eo_transceiver_outpacket_Get(host, &pkt);
+        s_bench_stop(&tx, start);
+        t[0] += tx.nanosecs; a[0] += tx.counters.allocations; m[0] += tx.counters.mutextakes; c[0] += tx.counters.copiedbytes;
+        tx.packets++;
+
+        // the parse alone
+        eo_packet_Payload_Get(pkt, &data, &size);
+        eo_packet_Capacity_Get(pkt, &capacity);
+        commv1_shims_counters_Reset();
+        start = commv1_shims_nanotime();
+        eo_ropframe_Load(ropframe, data, size, capacity);
+        while(eores_OK == eo_ropframe_ROP_Parse(ropframe, rop, &unparsed))
+        {
+            parse.rops++;
+        }
+        s_bench_stop(&parse, start);
+        t[1] += parse.nanosecs; a[1] += parse.counters.allocations; m[1] += parse.counters.mutextakes; c[1] += parse.counters.copiedbytes;
+        parse.packets++;
+
+        s_packet_copy(s_rxpacket, pkt, s_hostipaddr);
+
+        commv1_shims_counters_Reset();
+        start = commv1_shims_nanotime();
+        eo_transceiver_Receive(board, s_rxpacket, &nrops, &time);
+        s_bench_stop(&rx, start);
+        t[2] += rx.nanosecs; a[2] += rx.counters.allocations; m[2] += rx.counters.mutextakes; c[2] += rx.counters.copiedbytes;
+        rx.rops += nrops;
+        rx.packets++;
+    }
+
+    tx.nanosecs = t[0];     tx.counters.allocations = a[0];     tx.counters.mutextakes = m[0];     tx.counters.copiedbytes = c[0];
+    parse.nanosecs = t[1];  parse.counters.allocations = a[1];  parse.counters.mutextakes = m[1];  parse.counters.copiedbytes = c[1];
+    rx.nanosecs = t[2];     rx.counters.allocations = a[2];     rx.counters.mutextakes = m[2];     rx.counters.copiedbytes = c[2];
+
+    s_bench_print(&tx);
+    s_bench_print(&parse);
+    s_bench_print(&rx);
+}
+
+
+// the regular rops of s_board_load_regulars() go to the fake ipal. the bytes copied per packet are those of the stack
+// (the refresh of the regulars and the forming of the ropframe) plus the copy of ipal_udpsocket_sendto() if it is used.
+static void s_bench_board_tx_copies(EOtransceiver *board, uint32_t iterations)
+{
+    commv1_bench_result_t sendto;
+    commv1_bench_result_t transmit;
+    ipal_f_udp_hid_statistics_t ipalstats;
+    ipal_packet_t ipalpkt;
+    EOpacket *pkt = NULL;
+    uint16_t nrops = 0;
+    uint64_t start = 0;
+    uint32_t i = 0;
+
+    ipal_f_udp_hid_statistics_reset();
+    s_bench_start(&sendto, "board-tx-sendto");
+    start = commv1_shims_nanotime();
+
+    for(i=0; i<iterations; i++)
+    {
+        eo_transceiver_outpacket_Prepare(board, &nrops);
+        eo_transceiver_outpacket_Get(board, &pkt);
+        eo_packet_Payload_Get(pkt, &ipalpkt.data, &ipalpkt.size);
+        ipal_udpsocket_sendto(s_socket, &ipalpkt, s_hostipaddr, s_port);
+        sendto.rops += nrops;
+        sendto.packets++;
+    }
+
+    s_bench_stop(&sendto, start);
+    ipal_f_udp_hid_statistics_get(&ipalstats);
+    sendto.bytes = ipalstats.bytes;
+
+    ipal_f_udp_hid_statistics_reset();
+    s_bench_start(&transmit, "board-tx-transmit");
+    start = commv1_shims_nanotime();
+
+    for(i=0; i<iterations; i++)
+    {
+        eo_transceiver_Transmit(board, &nrops);
+        transmit.rops += nrops;
+        transmit.packets++;
+    }
+
+    s_bench_stop(&transmit, start);
+    ipal_f_udp_hid_statistics_get(&ipalstats);
+    transmit.bytes = ipalstats.bytes;
+
+    if((sendto.packets != ipalstats.datagrams) || (sendto.bytes != transmit.bytes))
+    {
+        printf("board-tx: eo_transceiver_Transmit() did not send the same datagrams\n");
+        exit(EXIT_FAILURE);
+    }
+
+    s_bench_print(&sendto);
+    s_bench_print(&transmit);
+}
+
+
+// the regular rops are loaded with the onchange bit and at every cycle eo_nv_Set() writes the status of joint 0 only:
+// the packet holds that rop alone and the other values are neither compared nor copied.
+static void s_bench_board_tx_onchange(EOtransceiver *board, uint32_t iterations)
+{
+    commv1_bench_result_t tx;
+    EOnvsCfg *nvscfg = eo_boardtransceiver_hid_GetNvsCfg();
+    EOpacket *pkt = NULL;
+    EOnv nv;
+    uint8_t value[256];
+    uint16_t size = 0;
+    uint16_t ondevindex = 0;
+    uint16_t onendpointindex = 0;
+    uint16_t onidindex = 0;
+    uint16_t nrops = 0;
+    uint64_t start = 0;
+    uint32_t i = 0;
+
+    eo_transceiver_rop_regular_Clear(board);
+    s_board_load_regulars(board, 1);
+
+    eo_nvscfg_GetIndices(nvscfg, EO_COMMON_IPV4ADDR_LOCALHOST, endpoint_mc_leftupperarm,
+                         eo_cfg_nvsEP_mc_upperarm_joint_NVID_Get(jointUpperArm_00, jointNVindex_jstatus),
+                         &ondevindex, &onendpointindex, &onidindex);
+    eo_nvscfg_GetNV(nvscfg, ondevindex, onendpointindex, onidindex, NULL, &nv);
+    eo_nv_Get(&nv, eo_nv_strg_volatile, value, &size);
+
+    // the first packet holds every rop, then only the changed ones
+    eo_transceiver_outpacket_Prepare(board, &nrops);
+    eo_transceiver_outpacket_Get(board, &pkt);
+
+    s_bench_start(&tx, "board-tx-onchange");
+    start = commv1_shims_nanotime();
+
+    for(i=0; i<iterations; i++)
+    {
+        value[0]++;
+        eo_nv_Set(&nv, value, eobool_true, eo_nv_upd_dontdo);
+        eo_transceiver_outpacket_Prepare(board, &nrops);
+        eo_transceiver_outpacket_Get(board, &pkt);
+        if(1 != nrops)
+        {
+            printf("board-tx-onchange: %d rops instead of the one which has changed\n", nrops);
+            exit(EXIT_FAILURE);
+        }
+        tx.rops += nrops;
+        tx.packets++;
+    }
+
+    s_bench_stop(&tx, start);
+
+    eo_transceiver_outpacket_Prepare(board, &nrops);
+    eo_transceiver_outpacket_Get(board, &pkt);
+    if(0 != nrops)
+    {
+        printf("board-tx-onchange: %d rops sent without any change\n", nrops);
+        exit(EXIT_FAILURE);
+    }
+
+    s_bench_print(&tx);
+
+    eo_transceiver_rop_regular_Clear(board);
+    s_board_load_regulars(board, 0);
+}
+
+
+// the same packet of regulars is received rop by rop and in batches: the batched host takes the mutex of
+// the endpoint once per packet instead of once per rop.
+static void s_bench_host_rx_batched(EOtransceiver *board, EOtransceiver *host, EOtransceiver *hostbatched, uint32_t iterations)
+{
+    commv1_bench_result_t rx[2];
+    EOtransceiver *hosts[2] = {host, hostbatched};
+    EOpacket *pkt = NULL;
+    uint16_t nrops = 0;
+    uint64_t start = 0;
+    uint64_t t = 0;
+    uint64_t a = 0;
+    uint64_t m = 0;
+    uint64_t c = 0;
+    uint32_t i = 0;
+    uint8_t h = 0;
+    eOabstime_t time = 0;
+
+    eo_transceiver_outpacket_Prepare(board, &nrops);
+    eo_transceiver_outpacket_Get(board, &pkt);
+
+    s_bench_start(&rx[0], "host-rx-perrop");
+    s_bench_start(&rx[1], "host-rx-batched");
+
+    for(h=0; h<2; h++)
+    {
+        t = 0; a = 0; m = 0; c = 0;
+        for(i=0; i<iterations; i++)
+        {
+            s_packet_copy(s_rxpacket, pkt, s_boardipaddr);
+
+            commv1_shims_counters_Reset();
+            start = commv1_shims_nanotime();
+            eo_transceiver_Receive(hosts[h], s_rxpacket, &nrops, &time);
+            s_bench_stop(&rx[h], start);
+            t += rx[h].nanosecs; a += rx[h].counters.allocations; m += rx[h].counters.mutextakes; c += rx[h].counters.copiedbytes;
+            rx[h].rops += nrops;
+            rx[h].packets++;
+        }
+        rx[h].nanosecs = t;     rx[h].counters.allocations = a;     rx[h].counters.mutextakes = m;     rx[h].counters.copiedbytes = c;
+    }
+
+    if(rx[0].rops != rx[1].rops)
+    {
+        printf("host-rx-batched: %u rops instead of %u\n", (unsigned)rx[1].rops, (unsigned)rx[0].rops);
+        exit(EXIT_FAILURE);
+    }
+
+    s_bench_print(&rx[0]);
+    s_bench_print(&rx[1]);
+}
+
+
+// the packet of regulars of the board is encoded in compact format and decoded back. the bytes saved on the wire are
+// given at the rate of the ems, which sends a packet every millisecond. the same rops with endpoint 0xffff check that
+// such an endpoint is carried as the implicit one.
+static void s_bench_compact(EOtransceiver *board, uint32_t iterations)
+{
+    static uint8_t standard[1024];
+    static uint8_t compact[1024];
+    static uint8_t expandeddata[1024];
+    commv1_bench_result_t enc;
+    commv1_bench_result_t dec;
+    eOropframeCompactState_t encstate;
+    eOropframeCompactState_t decstate;
+    EOropframe *frame = eo_ropframe_New();
+    EOropframe *expanded = eo_ropframe_New();
+    EOpacket *pkt = NULL;
+    eOrophead_t *head = NULL;
+    uint8_t *data = NULL;
+    uint16_t size = 0;
+    uint16_t compactsize = 0;
+    uint16_t nrops = 0;
+    uint16_t pos = 0;
+    uint64_t compactbytes = 0;
+    uint64_t start = 0;
+    uint32_t failures = 0;
+    uint32_t i = 0;
+
+    eo_transceiver_outpacket_Prepare(board, &nrops);
+    eo_transceiver_outpacket_Get(board, &pkt);
+    eo_packet_Payload_Get(pkt, &data, &size);
+    memcpy(standard, data, size);
+
+    eo_ropframe_Load(frame, standard, size, sizeof(standard));
+    eo_ropframe_Load(expanded, expandeddata, eo_ropframe_sizeforZEROrops, sizeof(expandeddata));
+
+    eo_ropframe_compact_Reset(&encstate, 16);
+    eo_ropframe_compact_Reset(&decstate, 0);
+
+    s_bench_start(&enc, "compact-encode");
+    start = commv1_shims_nanotime();
+    for(i=0; i<iterations; i++)
+    {
+        eo_ropframe_compact_Encode(frame, &encstate, compact, sizeof(compact), &compactsize);
+        compactbytes += compactsize;
+        enc.rops += nrops;
+        enc.packets++;
+    }
+    s_bench_stop(&enc, start);
+
+    // the decoder gets a key ropframe and then decodes the non-key ones which follow it
+    eo_ropframe_compact_Reset(&encstate, 16);
+    eo_ropframe_compact_Encode(frame, &encstate, compact, sizeof(compact), &compactsize);
+    eo_ropframe_compact_Decode(&decstate, compact, compactsize, expanded);
+    eo_ropframe_compact_Encode(frame, &encstate, compact, sizeof(compact), &compactsize);
+
+    s_bench_start(&dec, "compact-decode");
+    start = commv1_shims_nanotime();
+    for(i=0; i<iterations; i++)
+    {
+        if(eores_OK != eo_ropframe_compact_Decode(&decstate, compact, compactsize, expanded))
+        {
+            failures++;
+        }
+        dec.rops += nrops;
+        dec.packets++;
+    }
+    s_bench_stop(&dec, start);
+
+    s_bench_print(&enc);
+    s_bench_print(&dec);
+
+    if(0 != failures)
+    {
+        printf("compact: %u ropframes not decoded\n", (unsigned)failures);
+        exit(EXIT_FAILURE);
+    }
+
+    if(size != s_compact_roundtrip(frame, expanded, compact, sizeof(compact)))
+    {
+        printf("compact: the ropframe of %d rops is not decoded as it was\n", nrops);
+        exit(EXIT_FAILURE);
+    }
+
+    // the key ropframes are included in the average size of the compact ones
+    printf("compact: %u B/pkt in standard format, %.1f B/pkt in compact format: %.0f B/s saved at 1000 pkt/s\n",
+           (unsigned)size, (double)compactbytes / (double)iterations, 1000.0 * ((double)size - (double)compactbytes / (double)iterations));
+
+    // every rop on the endpoint 0xffff
+    pos = sizeof(EOropframeHeader_t);
+    for(i=0; i<nrops; i++)
+    {
+        head = (eOrophead_t*) &standard[pos];
+        head->endp = 0xffff;
+        pos += eo_rop_hid_Stream_Size(head);
+    }
+
+    if(size != s_compact_roundtrip(frame, expanded, compact, sizeof(compact)))
+    {
+        printf("compact: the ropframe of %d rops on the endpoint 0xffff is not decoded as it was\n", nrops);
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+// encodes frame in compact format with the implicit endpoint, decodes it into expanded and returns the size of the
+// expanded ropframe if it is equal to frame, else 0.
+static uint16_t s_compact_roundtrip(EOropframe *frame, EOropframe *expanded, uint8_t *compact, uint16_t capacity)
+{
+    eOropframeCompactState_t state;
+    uint8_t *data[2] = {NULL, NULL};
+    uint16_t size[2] = {0, 0};
+    uint16_t framecapacity = 0;
+    uint16_t compactsize = 0;
+    EOropframeCompactHeader_t compactheader;
+
+    eo_ropframe_compact_Reset(&state, 0);
+    if(eores_OK != eo_ropframe_compact_Encode(frame, &state, compact, capacity, &compactsize))
+    {
+        return(0);
+    }
+
+    memcpy(&compactheader, compact, sizeof(compactheader));
+    if(0 == (compactheader.flags & EOFRAME_COMPACT_FLAG_IMPLICITEP))
+    {
+        return(0);
+    }
+
+    eo_ropframe_compact_Reset(&state, 0);
+    if(eores_OK != eo_ropframe_compact_Decode(&state, compact, compactsize, expanded))
+    {
+        return(0);
+    }
+
+    eo_ropframe_Get(frame, &data[0], &size[0], &framecapacity);
+    eo_ropframe_Get(expanded, &data[1], &size[1], &framecapacity);
+
+    return(((size[0] == size[1]) && (0 == memcmp(data[0], data[1], size[0]))) ? (size[0]) : (0));
+}
+
+
+static void s_bench_replay(EOtransceiver *host, const char *filename, uint32_t iterations)
+{
+    commv1_bench_result_t rx;
+    uint8_t buffer[EOK_HOSTTRANSCEIVER_capacityofrxpacket];
+    uint16_t size = 0;
+    uint16_t nrops = 0;
+    uint64_t start = 0;
+    uint32_t i = 0;
+    eOabstime_t time = 0;
+    FILE *f = fopen(filename, "rb");
+
+    if(NULL == f)
+    {
+        printf("cannot open %s\n", filename);
+        return;
+    }
+
+    size = (uint16_t)fread(buffer, 1, sizeof(buffer), f);
+    fclose(f);
+
+    s_bench_start(&rx, filename);
+    start = commv1_shims_nanotime();
+
+    for(i=0; i<iterations; i++)
+    {
+        s_packet_load(s_rxpacket, buffer, size, s_boardipaddr);
+        eo_transceiver_Receive(host, s_rxpacket, &nrops, &time);
+        rx.rops += nrops;
+        rx.packets++;
+    }
+
+    s_bench_stop(&rx, start);
+    s_bench_print(&rx);
+}
+
+
+static uint8_t* s_ipal_getbuffer(void *arg, uint16_t capacity)
+{
+    return(ipal_udpsocket_getbuffer(s_socket, capacity));
+}
+
+
+static eOresult_t s_ipal_commit(void *arg, uint8_t *buffer, uint16_t size, eOipv4addr_t remaddr, eOipv4port_t remport)
+{
+    return((ipal_res_OK == ipal_udpsocket_commit(s_socket, buffer, size, remaddr, remport)) ? (eores_OK) : (eores_NOK_generic));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
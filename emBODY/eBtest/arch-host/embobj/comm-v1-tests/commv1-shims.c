@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "time.h"
+#include "EoCommon.h"
+#include "EOtheMemoryPool.h"
+#include "EOtheErrorManager.h"
+#include "EOVtheSystem_hid.h"
+#include "EOVmutex_hid.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of extern public interface
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "commv1-shims.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+// the derived objects of embobj keep the pointer to their base object as first field
+
+typedef struct
+{
+    EOVtheSystem    *thevsys;
+} commv1_system_t;
+
+typedef struct
+{
+    EOVmutex        *mutex;
+    uint32_t        taken;
+} commv1_mutex_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static eOresult_t s_commv1_sys_start(void (*init_fn)(void));
+static void* s_commv1_sys_gettask(void);
+static uint64_t s_commv1_sys_lifetime_get(void);
+static void s_commv1_sys_lifetime_set(uint64_t ltime);
+static uint64_t s_commv1_sys_nanotime_get(void);
+static void s_commv1_sys_stop(void);
+
+static eOresult_t s_commv1_mutex_take(void *p, eOreltime_t tout);
+static eOresult_t s_commv1_mutex_release(void *p);
+static eOresult_t s_commv1_mutex_delete(void *p);
+
+static void s_commv1_on_error(eOerrmanErrorType_t errtype, eOid08_t taskid, const char *eobjstr, const char *info);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static commv1_system_t s_commv1_system = { NULL };
+
+static uint64_t s_commv1_lifetime_offset = 0;
+
+static commv1_shims_counters_t s_commv1_counters = { 0 };
+
+static const eOmempool_cfg_t s_commv1_mempool_cfg =
+{
+    .mode   = eo_mempool_alloc_dynamic
+};
+
+static const eOerrman_cfg_t s_commv1_errman_cfg =
+{
+    .extfn  =
+    {
+        .usr_on_error   = s_commv1_on_error
+    }
+};
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+extern void commv1_shims_Initialise(void)
+{
+    if(NULL != s_commv1_system.thevsys)
+    {
+        return;
+    }
+
+    s_commv1_lifetime_offset = s_commv1_sys_nanotime_get();
+
+    s_commv1_system.thevsys = eov_sys_hid_Initialise(&s_commv1_mempool_cfg, &s_commv1_errman_cfg,
+                                                     (eOres_fp_voidfpvoid_t)s_commv1_sys_start, s_commv1_sys_gettask,
+                                                     s_commv1_sys_lifetime_get, s_commv1_sys_lifetime_set,
+                                                     s_commv1_sys_nanotime_get, s_commv1_sys_stop);
+}
+
+
+extern EOVmutexDerived* commv1_shims_mutex_New(void)
+{
+    commv1_mutex_t *retptr = eo_mempool_GetMemory(eo_mempool_GetHandle(), eo_mempool_align_32bit, sizeof(commv1_mutex_t), 1);
+
+    retptr->mutex = eov_mutex_hid_New();
+    retptr->taken = 0;
+    eov_mutex_hid_SetVTABLE(retptr->mutex, s_commv1_mutex_take, s_commv1_mutex_release, s_commv1_mutex_delete);
+
+    return(retptr);
+}
+
+
+extern uint64_t commv1_shims_nanotime(void)
+{
+    return(s_commv1_sys_nanotime_get());
+}
+
+
+extern void commv1_shims_counters_Get(commv1_shims_counters_t *counters)
+{
+    *counters = s_commv1_counters;
+}
+
+
+extern void commv1_shims_counters_Reset(void)
+{
+    memset(&s_commv1_counters, 0, sizeof(s_commv1_counters));
+}
+
+
+// the stack allocates through the EOtheMemoryPool in dynamic mode, which uses the heap of the c library. the build
+// links with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc so that every allocation passes from here.
+
+extern void* __real_malloc(size_t size);
+extern void* __real_calloc(size_t n, size_t size);
+extern void* __real_realloc(void *p, size_t size);
+
+extern void* __wrap_malloc(size_t size)
+{
+    s_commv1_counters.allocations++;
+    s_commv1_counters.allocatedbytes += size;
+    return(__real_malloc(size));
+}
+
+extern void* __wrap_calloc(size_t n, size_t size)
+{
+    s_commv1_counters.allocations++;
+    s_commv1_counters.allocatedbytes += n*size;
+    return(__real_calloc(n, size));
+}
+
+extern void* __wrap_realloc(void *p, size_t size)
+{
+    s_commv1_counters.allocations++;
+    s_commv1_counters.allocatedbytes += size;
+    return(__real_realloc(p, size));
+}
+
+
+// in the same way, the build links with -Wl,--wrap=memcpy,--wrap=memmove and compiles with -fno-builtin-memcpy and
+// -fno-builtin-memmove, so that every copy of the stack (and of the fake ipal) is counted.
+
+extern void* __real_memcpy(void *dst, const void *src, size_t size);
+extern void* __real_memmove(void *dst, const void *src, size_t size);
+
+extern void* __wrap_memcpy(void *dst, const void *src, size_t size)
+{
+    s_commv1_counters.copiedbytes += size;
+    return(__real_memcpy(dst, src, size));
+}
+
+extern void* __wrap_memmove(void *dst, const void *src, size_t size)
+{
+    s_commv1_counters.copiedbytes += size;
+    return(__real_memmove(dst, src, size));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static eOresult_t s_commv1_sys_start(void (*init_fn)(void))
+{
+    if(NULL != init_fn)
+    {
+        init_fn();
+    }
+    return(eores_OK);
+}
+
+static void* s_commv1_sys_gettask(void)
+{   // there are no tasks
+    return(NULL);
+}
+
+static uint64_t s_commv1_sys_lifetime_get(void)
+{   // the eOabstime_t is in usec
+    return((s_commv1_sys_nanotime_get() - s_commv1_lifetime_offset) / 1000);
+}
+
+static void s_commv1_sys_lifetime_set(uint64_t ltime)
+{
+    s_commv1_lifetime_offset = s_commv1_sys_nanotime_get() - 1000*ltime;
+}
+
+static uint64_t s_commv1_sys_nanotime_get(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+static void s_commv1_sys_stop(void)
+{
+    exit(EXIT_FAILURE);
+}
+
+
+static eOresult_t s_commv1_mutex_take(void *p, eOreltime_t tout)
+{
+    commv1_mutex_t *m = (commv1_mutex_t*)p;
+
+    if(0 != m->taken)
+    {   // the mutexes of the board are not recursive: a second take from the same thread is a deadlock
+        fprintf(stderr, "commv1-shims: mutex %p taken twice\n", p);
+        abort();
+    }
+
+    m->taken = 1;
+    s_commv1_counters.mutextakes++;
+    return(eores_OK);
+}
+
+static eOresult_t s_commv1_mutex_release(void *p)
+{
+    commv1_mutex_t *m = (commv1_mutex_t*)p;
+    m->taken = 0;
+    return(eores_OK);
+}
+
+static eOresult_t s_commv1_mutex_delete(void *p)
+{
+    return(eores_OK);
+}
+
+
+static void s_commv1_on_error(eOerrmanErrorType_t errtype, eOid08_t taskid, const char *eobjstr, const char *info)
+{
+    fprintf(stderr, "commv1-shims: error %d from %s: %s\n", (int)errtype, (NULL != eobjstr) ? eobjstr : "?", (NULL != info) ? info : "");
+
+    if(eo_errortype_fatal == errtype)
+    {
+        abort();
+    }
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// - include guard ----------------------------------------------------------------------------------------------------
+#ifndef _COMMV1_SHIMS_H_
+#define _COMMV1_SHIMS_H_
+
+
+/** @file       commv1-shims.h
+    @brief      This header file gives the host replacements of the derived objects of the embobj system (time and
+                mutex) used to run the comm-v1 protocol stack on linux, plus the counters the benchmarks read.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+
+// - external dependencies --------------------------------------------------------------------------------------------
+
+#include "EoCommon.h"
+#include "EOVmutex.h"
+
+
+// - declaration of public user-defined types -------------------------------------------------------------------------
+
+typedef struct
+{
+    uint64_t    allocations;    /**< the calls of malloc, calloc and realloc */
+    uint64_t    allocatedbytes;
+    uint64_t    mutextakes;     /**< the calls of eov_mutex_Take() on a mutex given by commv1_shims_mutex_New() */
+    uint64_t    copiedbytes;    /**< the bytes copied with memcpy and memmove */
+} commv1_shims_counters_t;
+
+
+// - declaration of extern public functions ---------------------------------------------------------------------------
+
+/** @fn         extern void commv1_shims_Initialise(void)
+    @brief      Initialises the host system: the memory pool in dynamic mode, the error manager and the lifetime,
+                which is the CLOCK_MONOTONIC in microseconds since this call. It must be called before any object of
+                comm-v1 is created.
+ **/
+extern void commv1_shims_Initialise(void);
+
+
+/** @fn         extern EOVmutexDerived* commv1_shims_mutex_New(void)
+    @brief      The function to put in the mutex_fn_new field of the configurations of comm-v1. The mutex does not
+                block (the benchmarks are single thread) but it counts the takes.
+ **/
+extern EOVmutexDerived* commv1_shims_mutex_New(void);
+
+
+/** @fn         extern uint64_t commv1_shims_nanotime(void)
+    @brief      Gets the CLOCK_MONOTONIC in nanoseconds.
+ **/
+extern uint64_t commv1_shims_nanotime(void);
+
+
+extern void commv1_shims_counters_Get(commv1_shims_counters_t *counters);
+
+extern void commv1_shims_counters_Reset(void);
+
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
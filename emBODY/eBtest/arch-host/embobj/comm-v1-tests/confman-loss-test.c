@@ -0,0 +1,513 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       confman-loss-test.c
+    @brief      host test of the EOconfirmationManager inside the EOtransceiver of the host, over the fake ipal which
+                loses datagrams on purpose (ipal_f_udp_hid_loss_set()).
+                the host of eb1 sends set<> with confirmation request to the board eb1 and the board replies with the
+                acks. the host transmits with ipal_udpsocket_getbuffer() + eo_transceiver_outpacket_PrepareInto() + 
+                ipal_udpsocket_commit() and the board with eo_transceiver_outpacket_Prepare() + ipal_udpsocket_sendto(),
+                and a datagram reaches the other side only if the fake ipal has not dropped it. the time of the 
+                confirmation manager is simulated: 300 usec per direction, a packet per side every 1000 usec.
+                it checks that:
+                - without losses every request is acked at once and nothing is retransmitted.
+                - with losses in both directions every request is acked in the end, thanks to the retransmissions 
+                  done by the transceiver, and none is lost.
+                - a request sent again by the user while it is outstanding is counted as a retransmission and its 
+                  ack does not give a round trip time (algorithm of karn), while the ack of a new request does.
+                - with a dead link the requests are given up after maxretransmissions.
+                - with eo_trans_protection_spsc the retransmissions wait in the transceiver until the producer of the 
+                  occasionals loads them with eo_transceiver_rop_occasional_Retransmit().
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "EoCommon.h"
+#include "EOpacket.h"
+#include "EOtransceiver.h"
+#include "EOtheBOARDtransceiver.h"
+#include "EOhostTransceiver.h"
+#include "EOconfirmationManager.h"
+
+#include "eOcfg_EPs_eb1.h"
+#include "eOcfg_nvsEP_mc.h"
+#include "eOcfg_nvsEP_mc_upperarm_con.h"
+
+#include "ipal.h"
+#include "ipal_f_udp_hid.h"
+
+#include "commv1-shims.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)    s_test_check((cond), #cond, __LINE__)
+
+// the simulated one way delay and the period of transmission, in usec
+#define TEST_DELAY          300
+#define TEST_PERIOD         1000
+
+#define TEST_MAXRETRANSMISSIONS     8
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static eOabstime_t s_test_time_get(void);
+static void s_test_on_rop_lost(void *arg, const eOconfman_request_t *req);
+
+static void s_test_packet_load(EOpacket *dst, const uint8_t *data, uint16_t size, eOipv4addr_t from);
+static void s_test_host_new(eOtransceiver_protection_t protection);
+static uint16_t s_test_host_load(uint8_t joint, uint8_t numberof);
+static void s_test_cycle(uint8_t linkisup);
+static void s_test_run(uint32_t cycles, uint8_t linkisup);
+
+static void s_test_no_losses(void);
+static void s_test_losses(void);
+static void s_test_karn(void);
+static void s_test_dead_link(void);
+static void s_test_spsc(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static const eOipv4addr_t s_boardipaddr = EO_COMMON_IPV4ADDR(10, 0, 1, 1);
+static const eOipv4addr_t s_hostipaddr = EO_COMMON_IPV4ADDR(10, 0, 1, 104);
+static const eOipv4port_t s_port = 12345;
+static const ipal_tos_t s_tos = { .precedence = ipal_prec_priority, .lowdelay = 1, .highthroughput = 1, .highreliability = 1, .unused = 0 };
+
+static eOabstime_t s_test_now = 0;
+static uint32_t s_test_lost = 0;
+
+static eOconfman_cfg_t s_test_confmancfg;
+static EOtransceiver *s_board = NULL;
+static EOtransceiver *s_host = NULL;
+static ipal_udpsocket_t *s_socket = NULL;
+static EOpacket *s_rxpacket = NULL;
+// with spsc the producer of the host gives the retransmissions to the transceiver at every cycle
+static uint8_t s_test_producer_retransmits = 0;
+
+static const eOcfg_nvsEP_mc_jointNVindex_t s_test_joint_nvs[] =
+{
+    jointNVindex_jconfig__pidposition, jointNVindex_jconfig__pidvelocity, jointNVindex_jconfig__pidtorque,
+    jointNVindex_jconfig__impedance
+};
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of main
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    eOboardtransceiver_cfg_t boardcfg;
+
+    commv1_shims_Initialise();
+
+    s_socket = ipal_udpsocket_new(s_tos);
+    s_rxpacket = eo_packet_New(EOK_HOSTTRANSCEIVER_capacityofrxpacket);
+
+    memcpy(&boardcfg, &eo_boardtransceiver_cfg_default, sizeof(boardcfg));
+    boardcfg.vectorof_endpoint_cfg                  = eo_cfg_EPs_vectorof_eb1;
+    boardcfg.hashfunction_ep2index                  = eo_cfg_nvsEP_eb1_fptr_hashfunction_ep2index;
+    boardcfg.remotehostipv4addr                     = s_hostipaddr;
+    boardcfg.remotehostipv4port                     = s_port;
+    boardcfg.sizes.capacityoftxpacket               = 1024;
+    boardcfg.sizes.capacityofrop                    = 192;
+    boardcfg.sizes.capacityofropframeregulars       = 768;
+    boardcfg.sizes.capacityofropframeoccasionals    = 128;
+    boardcfg.sizes.capacityofropframereplies        = 256;
+    boardcfg.sizes.maxnumberofregularrops           = 32;
+    boardcfg.mutex_fn_new                           = commv1_shims_mutex_New;
+    boardcfg.transprotection                        = eo_trans_protection_enabled;
+    boardcfg.nvscfgprotection                       = eo_nvscfg_protection_one_per_endpoint;
+
+    s_board = eo_boardtransceiver_Initialise(&boardcfg);
+
+    s_test_no_losses();
+    s_test_losses();
+    s_test_karn();
+    s_test_dead_link();
+    s_test_spsc();
+
+    if(0 != s_test_failures)
+    {
+        printf("confman-loss-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("confman-loss-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        printf("confman-loss-test: line %d: %s failed\n", line, str);
+        s_test_failures++;
+    }
+}
+
+
+static eOabstime_t s_test_time_get(void)
+{
+    return(s_test_now);
+}
+
+
+static void s_test_on_rop_lost(void *arg, const eOconfman_request_t *req)
+{
+    if((s_host == (EOtransceiver*)arg) && (s_boardipaddr == req->ipaddr))
+    {
+        s_test_lost++;
+    }
+}
+
+
+static void s_test_packet_load(EOpacket *dst, const uint8_t *data, uint16_t size, eOipv4addr_t from)
+{
+    uint8_t *payload = NULL;
+    uint16_t tmp = 0;
+
+    eo_packet_Payload_Get(dst, &payload, &tmp);
+    memcpy(payload, data, size);
+    eo_packet_Size_Set(dst, size);
+    // the transceiver accepts only packets coming from its remote
+    eo_packet_Addressing_Set(dst, from, s_port);
+}
+
+
+// a new host for every test, so that the estimator of the round trip time starts from scratch
+static void s_test_host_new(eOtransceiver_protection_t protection)
+{
+    eOhosttransceiver_cfg_t hostcfg;
+    EOhostTransceiver *host = NULL;
+
+    memcpy(&s_test_confmancfg, &eOconfman_cfg_default, sizeof(s_test_confmancfg));
+    s_test_confmancfg.capacity              = 32;
+    s_test_confmancfg.maxretransmissions    = TEST_MAXRETRANSMISSIONS;
+    s_test_confmancfg.rtoinitial            = 5*TEST_PERIOD;
+    s_test_confmancfg.rtomin                = 2*TEST_PERIOD;
+    s_test_confmancfg.rtomax                = 50*TEST_PERIOD;
+    s_test_confmancfg.time_get              = s_test_time_get;
+    s_test_confmancfg.on_rop_lost           = s_test_on_rop_lost;
+    // the transceiver replaces them with its own
+    s_test_confmancfg.on_rop_retransmit     = NULL;
+    s_test_confmancfg.arg                   = NULL;
+
+    memcpy(&hostcfg, &eo_hosttransceiver_cfg_default, sizeof(hostcfg));
+    hostcfg.vectorof_endpoint_cfg                   = eo_cfg_EPs_vectorof_eb1;
+    hostcfg.hashfunction_ep2index                   = eo_cfg_nvsEP_eb1_fptr_hashfunction_ep2index;
+    hostcfg.remoteboardipv4addr                     = s_boardipaddr;
+    hostcfg.remoteboardipv4port                     = s_port;
+    hostcfg.mutex_fn_new                            = commv1_shims_mutex_New;
+    hostcfg.transprotection                         = protection;
+    hostcfg.nvscfgprotection                        = eo_nvscfg_protection_one_per_endpoint;
+    hostcfg.confmancfg                              = &s_test_confmancfg;
+
+    host = eo_hosttransceiver_New(&hostcfg);
+    s_host = eo_hosttransceiver_Transceiver(host);
+
+    s_test_lost = 0;
+    s_test_producer_retransmits = 0;
+    ipal_f_udp_hid_loss_set(0);
+    ipal_f_udp_hid_statistics_reset();
+}
+
+
+// set<> with confirmation request of the pids of numberof joints of the upperarm starting from joint
+static uint16_t s_test_host_load(uint8_t joint, uint8_t numberof)
+{
+    eOropdescriptor_t ropdes;
+    uint16_t n = 0;
+    uint8_t j = 0;
+    uint8_t k = 0;
+
+    memset(&ropdes, 0, sizeof(ropdes));
+    ropdes.configuration            = eok_ropconfiguration_basic;
+    ropdes.configuration.confrqst   = 1;
+    ropdes.ropcode                  = eo_ropcode_set;
+    ropdes.ep                       = endpoint_mc_leftupperarm;
+
+    for(j=joint; (j<joint+numberof) && (j<jointUpperArm_TOTALnumber); j++)
+    {
+        for(k=0; k<sizeof(s_test_joint_nvs)/sizeof(s_test_joint_nvs[0]); k++)
+        {
+            ropdes.id = eo_cfg_nvsEP_mc_upperarm_joint_NVID_Get((eo_cfg_nvsEP_mc_upperarm_con_jointNumber_t)j, s_test_joint_nvs[k]);
+            if(eores_OK == eo_transceiver_rop_occasional_Load_without_data(s_host, &ropdes, 0))
+            {
+                n++;
+            }
+        }
+    }
+
+    return(n);
+}
+
+
+// one packet from the host to the board and one back. a datagram dropped by the fake ipal does not arrive
+static void s_test_cycle(uint8_t linkisup)
+{
+    ipal_f_udp_hid_statistics_t before;
+    ipal_f_udp_hid_statistics_t after;
+    ipal_packet_t ipalpkt;
+    const uint8_t *datagram = NULL;
+    uint8_t *buffer = NULL;
+    EOpacket *pkt = NULL;
+    uint16_t size = 0;
+    uint16_t nrops = 0;
+    eOabstime_t time = 0;
+
+    if(1 == s_test_producer_retransmits)
+    {
+        eo_transceiver_rop_occasional_Retransmit(s_host, NULL);
+    }
+
+    // host -> board
+    buffer = ipal_udpsocket_getbuffer(s_socket, IPAL_F_UDP_TXBUFFERSIZE);
+    TEST_CHECK(NULL != buffer);
+    eo_transceiver_outpacket_PrepareInto(s_host, buffer, IPAL_F_UDP_TXBUFFERSIZE, &size, &nrops);
+    ipal_f_udp_hid_statistics_get(&before);
+    // a commit of zero bytes only gives the buffer back
+    ipal_udpsocket_commit(s_socket, buffer, (0 == nrops) ? (0) : (size), s_boardipaddr, s_port);
+    ipal_f_udp_hid_statistics_get(&after);
+
+    s_test_now += TEST_DELAY;
+
+    if((0 != nrops) && (1 == linkisup) && (before.dropped == after.dropped))
+    {
+        datagram = ipal_f_udp_hid_lastdatagram_get(&size);
+        s_test_packet_load(s_rxpacket, datagram, size, s_hostipaddr);
+        eo_transceiver_Receive(s_board, s_rxpacket, &nrops, &time);
+    }
+
+    // board -> host
+    eo_transceiver_outpacket_Prepare(s_board, &nrops);
+    eo_transceiver_outpacket_Get(s_board, &pkt);
+    if(0 != nrops)
+    {
+        eo_packet_Payload_Get(pkt, &ipalpkt.data, &ipalpkt.size);
+        ipal_f_udp_hid_statistics_get(&before);
+        ipal_udpsocket_sendto(s_socket, &ipalpkt, s_hostipaddr, s_port);
+        ipal_f_udp_hid_statistics_get(&after);
+
+        s_test_now += TEST_DELAY;
+
+        if((1 == linkisup) && (before.dropped == after.dropped))
+        {
+            datagram = ipal_f_udp_hid_lastdatagram_get(&size);
+            s_test_packet_load(s_rxpacket, datagram, size, s_boardipaddr);
+            eo_transceiver_Receive(s_host, s_rxpacket, &nrops, &time);
+        }
+        
+        s_test_now += TEST_PERIOD - 2*TEST_DELAY;
+    }
+    else
+    {
+        s_test_now += TEST_PERIOD - TEST_DELAY;
+    }
+}
+
+
+static void s_test_run(uint32_t cycles, uint8_t linkisup)
+{
+    uint32_t i;
+
+    for(i=0; i<cycles; i++)
+    {
+        s_test_cycle(linkisup);
+    }
+}
+
+
+static void s_test_no_losses(void)
+{
+    eOconfman_statistics_t stats;
+    uint16_t n = 0;
+
+    s_test_host_new(eo_trans_protection_enabled);
+
+    n = s_test_host_load(0, jointUpperArm_TOTALnumber);
+    TEST_CHECK(0 != n);
+    s_test_run(100, 1);
+
+    TEST_CHECK(eores_OK == eo_transceiver_confstatistics_Get(s_host, &stats));
+    TEST_CHECK(n == stats.requested);
+    TEST_CHECK(n == stats.acked);
+    TEST_CHECK(0 == stats.retransmitted);
+    TEST_CHECK(0 == stats.lost);
+    TEST_CHECK(0 == stats.outstanding);
+    TEST_CHECK(0 == stats.unexpected);
+    TEST_CHECK(2*TEST_DELAY == stats.latencymax);
+    TEST_CHECK(2*TEST_DELAY == stats.srtt);
+}
+
+
+static void s_test_losses(void)
+{
+    eOconfman_statistics_t stats;
+    ipal_f_udp_hid_statistics_t ipalstats;
+    uint16_t n = 0;
+    uint8_t j = 0;
+
+    s_test_host_new(eo_trans_protection_enabled);
+    // one datagram every three is lost, in both directions
+    ipal_f_udp_hid_loss_set(3);
+
+    for(j=0; j<jointUpperArm_TOTALnumber; j++)
+    {   // a joint per packet
+        n += s_test_host_load(j, 1);
+        s_test_run(1, 1);
+    }
+    s_test_run(500, 1);
+
+    ipal_f_udp_hid_statistics_get(&ipalstats);
+    TEST_CHECK(0 != ipalstats.dropped);
+
+    TEST_CHECK(eores_OK == eo_transceiver_confstatistics_Get(s_host, &stats));
+    TEST_CHECK(n == stats.requested);
+    TEST_CHECK(n == stats.acked);
+    TEST_CHECK(0 != stats.retransmitted);
+    TEST_CHECK(0 == stats.lost);
+    TEST_CHECK(0 == stats.outstanding);
+    TEST_CHECK(0 == s_test_lost);
+    TEST_CHECK(stats.latencymax > stats.latencymin);
+    TEST_CHECK(stats.rto >= s_test_confmancfg.rtomin);
+}
+
+
+static void s_test_karn(void)
+{
+    eOconfman_statistics_t stats;
+
+    s_test_host_new(eo_trans_protection_enabled);
+
+    // the first transmission is lost by the link, then the user sends the rops again before the timeout
+    TEST_CHECK(0 != s_test_host_load(0, 1));
+    s_test_run(1, 0);
+    TEST_CHECK(0 != s_test_host_load(0, 1));
+    s_test_run(1, 1);
+
+    eo_transceiver_confstatistics_Get(s_host, &stats);
+    TEST_CHECK(stats.acked == stats.requested);
+    TEST_CHECK(stats.retransmitted == stats.requested);
+    TEST_CHECK(0 == stats.outstanding);
+    // the ack may refer to either transmission: no round trip time
+    TEST_CHECK(0 == stats.srtt);
+    TEST_CHECK(s_test_confmancfg.rtoinitial == stats.rto);
+
+    // a new request acked without retransmissions gives it
+    TEST_CHECK(0 != s_test_host_load(1, 1));
+    s_test_run(1, 1);
+    eo_transceiver_confstatistics_Get(s_host, &stats);
+    TEST_CHECK(0 == stats.outstanding);
+    TEST_CHECK(2*TEST_DELAY == stats.srtt);
+}
+
+
+static void s_test_dead_link(void)
+{
+    eOconfman_statistics_t stats;
+    uint16_t n = 0;
+
+    s_test_host_new(eo_trans_protection_enabled);
+
+    n = s_test_host_load(0, 1);
+    // longer than the sum of the timeouts with backoff
+    s_test_run(TEST_MAXRETRANSMISSIONS*50 + 100, 0);
+
+    eo_transceiver_confstatistics_Get(s_host, &stats);
+    TEST_CHECK(n == stats.requested);
+    TEST_CHECK(0 == stats.acked);
+    TEST_CHECK(n*TEST_MAXRETRANSMISSIONS == stats.retransmitted);
+    TEST_CHECK(n == stats.lost);
+    TEST_CHECK(n == s_test_lost);
+    TEST_CHECK(0 == stats.outstanding);
+}
+
+
+static void s_test_spsc(void)
+{
+    eOconfman_statistics_t stats;
+    uint16_t nrops = 0;
+    uint16_t n = 0;
+    uint8_t j = 0;
+
+    s_test_host_new(eo_trans_protection_spsc);
+
+    // the first transmission is lost. the timeout expires, but the task which transmits only queues the retransmission
+    n = s_test_host_load(0, 1);
+    s_test_run(1, 0);
+    s_test_run(10, 1);
+    eo_transceiver_confstatistics_Get(s_host, &stats);
+    TEST_CHECK(n == stats.retransmitted);
+    TEST_CHECK(0 == stats.acked);
+    TEST_CHECK(n == stats.outstanding);
+
+    // the producer loads them, each only once
+    TEST_CHECK(eores_OK == eo_transceiver_rop_occasional_Retransmit(s_host, &nrops));
+    TEST_CHECK(n == nrops);
+    TEST_CHECK(eores_OK == eo_transceiver_rop_occasional_Retransmit(s_host, &nrops));
+    TEST_CHECK(0 == nrops);
+    s_test_run(1, 1);
+    eo_transceiver_confstatistics_Get(s_host, &stats);
+    TEST_CHECK(n == stats.acked);
+    TEST_CHECK(0 == stats.outstanding);
+
+    // with losses and a producer which gives the retransmissions at every cycle, as with the mutex
+    s_test_producer_retransmits = 1;
+    ipal_f_udp_hid_loss_set(3);
+    for(j=1; j<jointUpperArm_TOTALnumber; j++)
+    {
+        n += s_test_host_load(j, 1);
+        s_test_run(1, 1);
+    }
+    s_test_run(500, 1);
+
+    eo_transceiver_confstatistics_Get(s_host, &stats);
+    TEST_CHECK(n == stats.requested);
+    TEST_CHECK(n == stats.acked);
+    TEST_CHECK(0 == stats.lost);
+    TEST_CHECK(0 == stats.outstanding);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
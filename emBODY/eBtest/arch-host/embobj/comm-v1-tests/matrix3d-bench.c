@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       matrix3d-bench.c
+    @brief      host benchmark of eo_matrix3d_At(), which eo_nvscfg_GetNV() uses to get the cached nv of a (device,
+                endpoint, id). the matrix is built as eo_nvscfg_data_Initialise() does, with items of the size of an
+                EOnv, for some configurations of ems004 boards:
+                - the board eb1: one device with its endpoints.
+                - a host with 12 boards and a host with 28 boards, one device each.
+                the matrix is read with random and with sequential indices, and every item and the out of range
+                indices of each level are checked. it is the baseline against which a change of the layout of
+                EOmatrix3d must be measured: the lookup must stay behind the call of eo_matrix3d_At(), as in
+                eo_nvscfg_GetNV(), because a copy of the lookup inlined in the loop of the benchmark is faster only
+                for the inlining.
+                usage: matrix3d-bench [-n accesses per run]
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "EoCommon.h"
+#include "EOmatrix3d.h"
+#include "EOnv_hid.h"
+
+#include "commv1-shims.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define BENCH_ENDPOINTS_MAX     16
+
+// the best of these runs is kept
+#define BENCH_RUNS              5
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    const char      *name;
+    uint16_t        devices;
+    uint16_t        endpoints;
+    uint16_t        nvs[BENCH_ENDPOINTS_MAX];   // the nvs of each endpoint, the same on every device
+} matrix3d_bench_cfg_t;
+
+// an item as big as an EOnv, which keeps its own indices
+typedef struct
+{
+    uint16_t        i1;
+    uint16_t        i2;
+    uint16_t        i3;
+    uint8_t         filler[sizeof(EOnv) - 3*sizeof(uint16_t)];
+} matrix3d_bench_item_t;
+
+typedef struct
+{
+    uint16_t        i1;
+    uint16_t        i2;
+    uint16_t        i3;
+} matrix3d_bench_index_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static EOmatrix3d* s_bench_build(const matrix3d_bench_cfg_t *cfg, uint32_t *items);
+static uint32_t s_bench_check(EOmatrix3d *m, const matrix3d_bench_cfg_t *cfg);
+static double s_bench_random(EOmatrix3d *m, const matrix3d_bench_index_t *indices, uint32_t n);
+static double s_bench_sequential(EOmatrix3d *m, const matrix3d_bench_cfg_t *cfg, uint32_t n);
+static uint32_t s_bench_run(const matrix3d_bench_cfg_t *cfg, uint32_t n);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+// eb1 has the endpoints of management, of the motion control of the upper arm, of the analog sensors and of the skin
+static const matrix3d_bench_cfg_t s_bench_cfgs[] =
+{
+    { "board eb1",       1,  8, { 4, 12, 40, 40, 40, 40, 20, 8 } },
+    { "host 12 boards", 12, 12, { 4, 12, 40, 40, 40, 40, 20, 8, 30, 30, 30, 30 } },
+    { "host 28 boards", 28, 16, { 4, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60 } }
+};
+
+static volatile uint32_t s_bench_sink = 0;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of main
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    uint32_t n = 1000000;
+    uint32_t errors = 0;
+    uint32_t i;
+
+    if((argc > 2) && (0 == strcmp(argv[1], "-n")))
+    {
+        n = strtoul(argv[2], NULL, 0);
+    }
+    else if(argc > 1)
+    {
+        printf("usage: matrix3d-bench [-n accesses per run]\n");
+        return(EXIT_FAILURE);
+    }
+
+    commv1_shims_Initialise();
+
+    printf("%-16s %8s %14s %14s\n", "matrix", "items", "random", "sequential");
+
+    for(i=0; i<sizeof(s_bench_cfgs)/sizeof(s_bench_cfgs[0]); i++)
+    {
+        errors += s_bench_run(&s_bench_cfgs[i], n);
+    }
+
+    if(0 != errors)
+    {
+        printf("matrix3d-bench: %u items are wrong\n", (unsigned)errors);
+        return(EXIT_FAILURE);
+    }
+
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+// as eo_nvscfg_data_Initialise() does
+static EOmatrix3d* s_bench_build(const matrix3d_bench_cfg_t *cfg, uint32_t *items)
+{
+    EOmatrix3d *m = eo_matrix3d_New(sizeof(matrix3d_bench_item_t), cfg->devices);
+    matrix3d_bench_item_t item;
+    uint16_t i, j, k;
+
+    *items = 0;
+
+    for(i=0; i<cfg->devices; i++)
+    {
+        eo_matrix3d_Level1_PushBack(m, cfg->endpoints);
+        for(j=0; j<cfg->endpoints; j++)
+        {
+            eo_matrix3d_Level2_PushBack(m, i, cfg->nvs[j]);
+            for(k=0; k<cfg->nvs[j]; k++)
+            {
+                memset(&item, 0, sizeof(item));
+                item.i1 = i;
+                item.i2 = j;
+                item.i3 = k;
+                eo_matrix3d_Level3_PushBack(m, i, j, &item);
+                (*items)++;
+            }
+        }
+    }
+
+    return(m);
+}
+
+
+static uint32_t s_bench_check(EOmatrix3d *m, const matrix3d_bench_cfg_t *cfg)
+{
+    matrix3d_bench_item_t *t = NULL;
+    uint32_t errors = 0;
+    uint16_t i, j, k;
+
+    for(i=0; i<cfg->devices; i++)
+    {
+        for(j=0; j<cfg->endpoints; j++)
+        {
+            for(k=0; k<cfg->nvs[j]; k++)
+            {
+                t = eo_matrix3d_At(m, i, j, k);
+                if((NULL == t) || (t->i1 != i) || (t->i2 != j) || (t->i3 != k))
+                {
+                    errors++;
+                }
+            }
+        }
+    }
+
+    // out of range on each level
+    if(NULL != eo_matrix3d_At(m, cfg->devices, 0, 0))
+    {
+        errors++;
+    }
+    if(NULL != eo_matrix3d_At(m, 0, cfg->endpoints, 0))
+    {
+        errors++;
+    }
+    if(NULL != eo_matrix3d_At(m, 0, 0, cfg->nvs[0]))
+    {
+        errors++;
+    }
+
+    return(errors);
+}
+
+
+// ns per access
+static double s_bench_random(EOmatrix3d *m, const matrix3d_bench_index_t *indices, uint32_t n)
+{
+    matrix3d_bench_item_t *item = NULL;
+    uint32_t sink = 0;
+    uint64_t start = commv1_shims_nanotime();
+    uint32_t i;
+
+    for(i=0; i<n; i++)
+    {
+        item = (matrix3d_bench_item_t*)eo_matrix3d_At(m, indices[i].i1, indices[i].i2, indices[i].i3);
+        sink += item->i3;
+    }
+
+    s_bench_sink += sink;
+    return((double)(commv1_shims_nanotime() - start) / (double)n);
+}
+
+
+// ns per access, over all the nvs of all the devices as a host which reads all the boards
+static double s_bench_sequential(EOmatrix3d *m, const matrix3d_bench_cfg_t *cfg, uint32_t n)
+{
+    matrix3d_bench_item_t *item = NULL;
+    uint32_t sink = 0;
+    uint32_t done = 0;
+    uint64_t start = commv1_shims_nanotime();
+    uint16_t i, j, k;
+
+    while(done < n)
+    {
+        for(i=0; i<cfg->devices; i++)
+        {
+            for(j=0; j<cfg->endpoints; j++)
+            {
+                for(k=0; k<cfg->nvs[j]; k++)
+                {
+                    item = (matrix3d_bench_item_t*)eo_matrix3d_At(m, i, j, k);
+                    sink += item->i3;
+                }
+                done += cfg->nvs[j];
+            }
+        }
+    }
+
+    s_bench_sink += sink;
+    return((double)(commv1_shims_nanotime() - start) / (double)done);
+}
+
+
+static uint32_t s_bench_run(const matrix3d_bench_cfg_t *cfg, uint32_t n)
+{
+    matrix3d_bench_index_t *indices = NULL;
+    EOmatrix3d *m = NULL;
+    uint32_t items = 0;
+    uint32_t errors = 0;
+    double best[2] = { 1e9, 1e9 };
+    double ns = 0;
+    uint32_t i;
+    int r;
+
+    m = s_bench_build(cfg, &items);
+    errors = s_bench_check(m, cfg);
+
+    indices = calloc(n, sizeof(matrix3d_bench_index_t));
+    srand(1);
+    for(i=0; i<n; i++)
+    {
+        indices[i].i1 = rand() % cfg->devices;
+        indices[i].i2 = rand() % cfg->endpoints;
+        indices[i].i3 = rand() % cfg->nvs[indices[i].i2];
+    }
+
+    for(r=0; r<BENCH_RUNS; r++)
+    {
+        if((ns = s_bench_random(m, indices, n)) < best[0])
+        {
+            best[0] = ns;
+        }
+        if((ns = s_bench_sequential(m, cfg, n)) < best[1])
+        {
+            best[1] = ns;
+        }
+    }
+
+    printf("%-16s %8u %11.2f ns %11.2f ns\n", cfg->name, (unsigned)items, best[0], best[1]);
+
+    free(indices);
+
+    return(errors);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
@@ -0,0 +1,397 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       nvscfg-bench.c
+    @brief      host benchmark of the lookup of the index of an nv from its id in EOnvsCfg. an endpoint of a remote
+                device is built with a sweep of numbers of nvs, whose ids are scattered over the 16 bits, and the
+                id->index table of EOnvsCfg (eo_nvscfg_hid_ondevice_onendpoint_id2index()) is compared with:
+                - the linear scan of the treenodes of the endpoint, which EOnvsCfg used before the table.
+                - a binary search over the ids sorted once.
+                the ids are looked up in random order and every result of the three is checked.
+                usage: nvscfg-bench [-n lookups per run]
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "EoCommon.h"
+#include "EOconstvector_hid.h"
+#include "EOtreenode_hid.h"
+#include "EOnv_hid.h"
+#include "EOnvsCfg_hid.h"
+
+#include "commv1-shims.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+// the best of these runs is kept
+#define BENCH_RUNS              5
+
+#define BENCH_ENDPOINT          0x0010
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    eOnvID_t        id;
+    uint16_t        index;
+} nvscfg_bench_sorted_t;
+
+typedef struct
+{
+    EOnvsCfg                *nvscfg;
+    EOtreenode              *tree;
+    EOnv_con_t              *con;
+    EOnv_usr_t              *usr;
+    EOconstvector           *treevector;
+    EOconstvector           *usrvector;
+    nvscfg_bench_sorted_t   *sorted;
+    uint16_t                nvs;
+} nvscfg_bench_endpoint_t;
+
+typedef enum
+{
+    nvscfg_bench_hash   = 0,
+    nvscfg_bench_linear = 1,
+    nvscfg_bench_binary = 2
+} nvscfg_bench_method_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static eOnvID_t s_bench_id(uint16_t k);
+static void s_bench_build(nvscfg_bench_endpoint_t *e, uint16_t nvs);
+static void s_bench_destroy(nvscfg_bench_endpoint_t *e);
+static int s_bench_compare(const void *a, const void *b);
+static uint16_t s_bench_linear(const nvscfg_bench_endpoint_t *e, eOnvID_t id);
+static uint16_t s_bench_binary(const nvscfg_bench_endpoint_t *e, eOnvID_t id);
+static uint16_t s_bench_lookup(const nvscfg_bench_endpoint_t *e, nvscfg_bench_method_t method, eOnvID_t id);
+static uint32_t s_bench_check(const nvscfg_bench_endpoint_t *e);
+static double s_bench_time(const nvscfg_bench_endpoint_t *e, nvscfg_bench_method_t method, const eOnvID_t *ids, uint32_t n);
+static uint32_t s_bench_run(uint16_t nvs, uint32_t n);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+// from the endpoints of management (some nvs) to the whole body in one endpoint
+static const uint16_t s_bench_sweep[] = { 8, 16, 32, 64, 128, 256, 512, 1024, 4096 };
+
+static volatile uint32_t s_bench_sink = 0;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of main
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    uint32_t n = 100000;
+    uint32_t errors = 0;
+    uint32_t i;
+
+    if((argc > 2) && (0 == strcmp(argv[1], "-n")))
+    {
+        n = strtoul(argv[2], NULL, 0);
+    }
+    else if(argc > 1)
+    {
+        printf("usage: nvscfg-bench [-n lookups per run]\n");
+        return(EXIT_FAILURE);
+    }
+
+    commv1_shims_Initialise();
+
+    printf("%8s %14s %14s %14s\n", "nvs", "hash", "linear", "binary");
+
+    for(i=0; i<sizeof(s_bench_sweep)/sizeof(s_bench_sweep[0]); i++)
+    {
+        errors += s_bench_run(s_bench_sweep[i], n);
+    }
+
+    if(0 != errors)
+    {
+        printf("nvscfg-bench: %u lookups are wrong\n", (unsigned)errors);
+        return(EXIT_FAILURE);
+    }
+
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+// the multiplier is odd, thus the ids of k in [0, 65535] are all different
+static eOnvID_t s_bench_id(uint16_t k)
+{
+    return((eOnvID_t)(((uint32_t)k * 40503UL + 7) & 0xffff));
+}
+
+
+// an endpoint of a remote device, thus EOnvsCfg builds its id->index table
+static void s_bench_build(nvscfg_bench_endpoint_t *e, uint16_t nvs)
+{
+    uint16_t k;
+
+    e->nvs      = nvs;
+    e->tree     = calloc(nvs, sizeof(EOtreenode));
+    e->con      = calloc(nvs, sizeof(EOnv_con_t));
+    e->usr      = calloc(nvs, sizeof(EOnv_usr_t));
+    e->sorted   = calloc(nvs, sizeof(nvscfg_bench_sorted_t));
+
+    for(k=0; k<nvs; k++)
+    {
+        EOnv_con_t con =
+        {
+            EO_INIT(.id)        s_bench_id(k),
+            EO_INIT(.capacity)  4,
+            EO_INIT(.resetval)  NULL,
+            EO_INIT(.offset)    (uint16_t)(4*k),
+            EO_INIT(.typ)       eo_nv_TYP_u32,
+            EO_INIT(.fun)       eo_nv_FUN_inp
+        };
+        EOtreenode node =
+        {
+            EO_INIT(.data)      (void*)&e->con[k],
+            EO_INIT(.index)     k,
+            EO_INIT(.nchildren) 0,
+            EO_INIT(.dchildren) NULL
+        };
+        // the con and the treenodes are const as in the configurations of the endpoints, thus they are copied in
+        memcpy((void*)&e->con[k], &con, sizeof(con));
+        memcpy((void*)&e->tree[k], &node, sizeof(node));
+
+        e->sorted[k].id         = con.id;
+        e->sorted[k].index      = k;
+    }
+
+    qsort(e->sorted, nvs, sizeof(nvscfg_bench_sorted_t), s_bench_compare);
+
+    {
+        const EOconstvector treevector =
+        {
+            EO_INIT(.size)              nvs,
+            EO_INIT(.item_size)         sizeof(EOtreenode),
+            EO_INIT(.item_array_data)   e->tree
+        };
+        const EOconstvector usrvector =
+        {
+            EO_INIT(.size)              nvs,
+            EO_INIT(.item_size)         sizeof(EOnv_usr_t),
+            EO_INIT(.item_array_data)   e->usr
+        };
+        e->treevector = malloc(sizeof(EOconstvector));
+        e->usrvector = malloc(sizeof(EOconstvector));
+        memcpy((void*)e->treevector, &treevector, sizeof(EOconstvector));
+        memcpy((void*)e->usrvector, &usrvector, sizeof(EOconstvector));
+    }
+
+    {
+        eOnvscfg_EP_t epcfg =
+        {
+            EO_INIT(.endpoint)                          BENCH_ENDPOINT,
+            EO_INIT(.sizeof_endpoint_data)              (uint16_t)(4*nvs),
+            EO_INIT(.hashfunction_id2index)             NULL,
+            EO_INIT(.constvector_of_treenodes_EOnv_con) e->treevector,
+            EO_INIT(.constvector_of_EOnv_usr)           e->usrvector,
+            EO_INIT(.endpoint_data_init)                NULL,
+            EO_INIT(.endpoint_data_retrieve)            NULL
+        };
+
+        e->nvscfg = eo_nvscfg_New(1, NULL, eo_nvscfg_protection_none, NULL);
+        eo_nvscfg_PushBackDevice(e->nvscfg, eo_nvscfg_ownership_remote, EO_COMMON_IPV4ADDR(10, 0, 1, 1), NULL, 1);
+        eo_nvscfg_ondevice_PushBackEP(e->nvscfg, 0, &epcfg);
+    }
+}
+
+
+// the EOnvsCfg has no destructor: only what the bench has allocated goes back
+static void s_bench_destroy(nvscfg_bench_endpoint_t *e)
+{
+    free((void*)e->tree);
+    free((void*)e->con);
+    free((void*)e->usr);
+    free((void*)e->sorted);
+    free((void*)e->treevector);
+    free((void*)e->usrvector);
+}
+
+
+static int s_bench_compare(const void *a, const void *b)
+{
+    return((int)((const nvscfg_bench_sorted_t*)a)->id - (int)((const nvscfg_bench_sorted_t*)b)->id);
+}
+
+
+// as the exhaustive search of s_eo_nvscfg_ondevice_onendpoint_id2index()
+static uint16_t s_bench_linear(const nvscfg_bench_endpoint_t *e, eOnvID_t id)
+{
+    uint16_t k;
+
+    for(k=0; k<e->nvs; k++)
+    {
+        EOnv_con_t* nvcon = (EOnv_con_t*) eo_treenode_GetData((EOtreenode*) eo_constvector_At(e->treevector, k));
+
+        if(id == nvcon->id)
+        {
+            return(k);
+        }
+    }
+
+    return(EOK_uint16dummy);
+}
+
+
+static uint16_t s_bench_binary(const nvscfg_bench_endpoint_t *e, eOnvID_t id)
+{
+    uint16_t lo = 0;
+    uint16_t hi = e->nvs;
+
+    while(lo < hi)
+    {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if(e->sorted[mid].id < id)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return(((lo < e->nvs) && (id == e->sorted[lo].id)) ? (e->sorted[lo].index) : (EOK_uint16dummy));
+}
+
+
+static uint16_t s_bench_lookup(const nvscfg_bench_endpoint_t *e, nvscfg_bench_method_t method, eOnvID_t id)
+{
+    switch(method)
+    {
+        case nvscfg_bench_hash:     return(eo_nvscfg_hid_ondevice_onendpoint_id2index(e->nvscfg, 0, 0, id));
+        case nvscfg_bench_linear:   return(s_bench_linear(e, id));
+        default:                    return(s_bench_binary(e, id));
+    }
+}
+
+
+static uint32_t s_bench_check(const nvscfg_bench_endpoint_t *e)
+{
+    uint32_t errors = 0;
+    uint16_t k;
+    int m;
+
+    for(m=nvscfg_bench_hash; m<=nvscfg_bench_binary; m++)
+    {
+        for(k=0; k<e->nvs; k++)
+        {
+            if(k != s_bench_lookup(e, (nvscfg_bench_method_t)m, s_bench_id(k)))
+            {
+                errors++;
+            }
+        }
+
+        // the id of the next nv is not in the endpoint
+        if(EOK_uint16dummy != s_bench_lookup(e, (nvscfg_bench_method_t)m, s_bench_id(e->nvs)))
+        {
+            errors++;
+        }
+    }
+
+    return(errors);
+}
+
+
+// ns per lookup
+static double s_bench_time(const nvscfg_bench_endpoint_t *e, nvscfg_bench_method_t method, const eOnvID_t *ids, uint32_t n)
+{
+    uint32_t sink = 0;
+    uint64_t start = commv1_shims_nanotime();
+    uint32_t i;
+
+    for(i=0; i<n; i++)
+    {
+        sink += s_bench_lookup(e, method, ids[i]);
+    }
+
+    s_bench_sink += sink;
+    return((double)(commv1_shims_nanotime() - start) / (double)n);
+}
+
+
+static uint32_t s_bench_run(uint16_t nvs, uint32_t n)
+{
+    nvscfg_bench_endpoint_t e;
+    eOnvID_t *ids = NULL;
+    uint32_t errors = 0;
+    double best[3] = { 1e9, 1e9, 1e9 };
+    double ns = 0;
+    uint32_t i;
+    int r;
+    int m;
+
+    s_bench_build(&e, nvs);
+    errors = s_bench_check(&e);
+
+    ids = calloc(n, sizeof(eOnvID_t));
+    srand(1);
+    for(i=0; i<n; i++)
+    {
+        ids[i] = s_bench_id(rand() % nvs);
+    }
+
+    for(r=0; r<BENCH_RUNS; r++)
+    {
+        for(m=nvscfg_bench_hash; m<=nvscfg_bench_binary; m++)
+        {
+            if((ns = s_bench_time(&e, (nvscfg_bench_method_t)m, ids, n)) < best[m])
+            {
+                best[m] = ns;
+            }
+        }
+    }
+
+    printf("%8u %11.2f ns %11.2f ns %11.2f ns\n", (unsigned)nvs, best[0], best[1], best[2]);
+
+    free(ids);
+    s_bench_destroy(&e);
+
+    return(errors);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       nvscfg-ipfold-test.c
+    @brief      test of the folding of the ip addresses into the 16 bit key of the ip->index table of EOnvsCfg.
+                - the addresses of a /16 subnet (all of 10.0.0.0/16 and of 192.168.0.0/16) and the ones which differ
+                  only in the second byte (10.x.1.1) never give the same key.
+                - the boards of the iCub network (10.0.1.1 - 10.0.1.254) hashed into a table as big as the one of
+                  EOnvsCfg have short probes.
+                - an EOnvsCfg with all those boards plus two addresses whose keys collide finds every one of them,
+                  and not an address which it does not have.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "EoCommon.h"
+#include "EOnvsCfg_hid.h"
+
+#include "commv1-shims.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)        s_test_check((cond), #cond, __LINE__)
+
+// the longest probe accepted for the boards of the iCub network
+#define TEST_MAXPROBE           4
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *text, int line);
+static uint32_t s_test_collisions(eOipv4addr_t (*address)(uint32_t i), uint32_t n);
+static eOipv4addr_t s_test_subnet10(uint32_t i);
+static eOipv4addr_t s_test_subnet192(uint32_t i);
+static eOipv4addr_t s_test_secondbyte(uint32_t i);
+static eOipv4addr_t s_test_icub(uint32_t i);
+static uint16_t s_test_maxprobe(eOipv4addr_t (*address)(uint32_t i), uint32_t n);
+static void s_test_nvscfg(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of main
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    uint16_t maxprobe = 0;
+
+    commv1_shims_Initialise();
+
+    TEST_CHECK(0 == s_test_collisions(s_test_subnet10, 65536));
+    TEST_CHECK(0 == s_test_collisions(s_test_subnet192, 65536));
+    TEST_CHECK(0 == s_test_collisions(s_test_secondbyte, 256));
+    TEST_CHECK(0 == s_test_collisions(s_test_icub, 254));
+
+    // the two halves are xor-ed: 10.0.1.1 and 11.0.0.1 give the same key
+    TEST_CHECK(EO_NVSCFG_IPV4FOLD(EO_COMMON_IPV4ADDR(10, 0, 1, 1)) == EO_NVSCFG_IPV4FOLD(EO_COMMON_IPV4ADDR(11, 0, 0, 1)));
+
+    maxprobe = s_test_maxprobe(s_test_icub, 254);
+    printf("nvscfg-ipfold-test: longest probe of the 254 boards of 10.0.1.x is %u\n", (unsigned)maxprobe);
+    TEST_CHECK(maxprobe <= TEST_MAXPROBE);
+
+    s_test_nvscfg();
+
+    if(0 != s_test_failures)
+    {
+        printf("nvscfg-ipfold-test: %u checks failed\n", (unsigned)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("nvscfg-ipfold-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *text, int line)
+{
+    if(!cond)
+    {
+        printf("nvscfg-ipfold-test: line %d: %s\n", line, text);
+        s_test_failures++;
+    }
+}
+
+
+// the number of addresses whose key is the key of a previous address
+static uint32_t s_test_collisions(eOipv4addr_t (*address)(uint32_t i), uint32_t n)
+{
+    uint8_t *used = calloc(65536, sizeof(uint8_t));
+    uint32_t collisions = 0;
+    uint32_t i;
+
+    for(i=0; i<n; i++)
+    {
+        uint16_t key = EO_NVSCFG_IPV4FOLD(address(i));
+        if(0 != used[key])
+        {
+            collisions++;
+        }
+        used[key] = 1;
+    }
+
+    free(used);
+    return(collisions);
+}
+
+
+static eOipv4addr_t s_test_subnet10(uint32_t i)
+{
+    return(EO_COMMON_IPV4ADDR(10, 0, (i >> 8) & 0xff, i & 0xff));
+}
+
+
+static eOipv4addr_t s_test_subnet192(uint32_t i)
+{
+    return(EO_COMMON_IPV4ADDR(192, 168, (i >> 8) & 0xff, i & 0xff));
+}
+
+
+static eOipv4addr_t s_test_secondbyte(uint32_t i)
+{
+    return(EO_COMMON_IPV4ADDR(10, i & 0xff, 1, 1));
+}
+
+
+static eOipv4addr_t s_test_icub(uint32_t i)
+{
+    return(EO_COMMON_IPV4ADDR(10, 0, 1, 1 + i));
+}
+
+
+// the longest linear probe when the n addresses are inserted into a table sized as s_eo_nvscfg_hashtable_size() does
+static uint16_t s_test_maxprobe(eOipv4addr_t (*address)(uint32_t i), uint32_t n)
+{
+    uint32_t size = 4;
+    uint8_t *used = NULL;
+    uint16_t mask = 0;
+    uint16_t maxprobe = 0;
+    uint32_t i;
+
+    while(size < 2*n)
+    {
+        size <<= 1;
+    }
+    mask = (uint16_t)(size - 1);
+    used = calloc(size, sizeof(uint8_t));
+
+    for(i=0; i<n; i++)
+    {
+        uint16_t pos = EO_NVSCFG_HASH(EO_NVSCFG_IPV4FOLD(address(i)), mask);
+        uint16_t probe = 0;
+        while(0 != used[pos])
+        {
+            pos = (pos + 1) & mask;
+            probe++;
+        }
+        used[pos] = 1;
+        if(probe > maxprobe)
+        {
+            maxprobe = probe;
+        }
+    }
+
+    free(used);
+    return(maxprobe);
+}
+
+
+static void s_test_nvscfg(void)
+{
+    const eOipv4addr_t collide[2] = { EO_COMMON_IPV4ADDR(11, 0, 0, 1), EO_COMMON_IPV4ADDR(10, 0, 1, 1) };
+    EOnvsCfg *nvscfg = eo_nvscfg_New(256, NULL, eo_nvscfg_protection_none, NULL);
+    uint32_t i;
+
+    // 11.0.0.1 goes in first, so that 10.0.1.1 finds its position taken
+    TEST_CHECK(eores_OK == eo_nvscfg_PushBackDevice(nvscfg, eo_nvscfg_ownership_remote, collide[0], NULL, 1));
+    for(i=0; i<254; i++)
+    {
+        TEST_CHECK(eores_OK == eo_nvscfg_PushBackDevice(nvscfg, eo_nvscfg_ownership_remote, s_test_icub(i), NULL, 1));
+    }
+
+    TEST_CHECK(0 == eo_nvscfg_hid_ip2index(nvscfg, collide[0]));
+    for(i=0; i<254; i++)
+    {
+        TEST_CHECK((1 + i) == eo_nvscfg_hid_ip2index(nvscfg, s_test_icub(i)));
+    }
+    TEST_CHECK(1 == eo_nvscfg_hid_ip2index(nvscfg, collide[1]));
+
+    TEST_CHECK(EOK_uint16dummy == eo_nvscfg_hid_ip2index(nvscfg, EO_COMMON_IPV4ADDR(10, 0, 2, 1)));
+    TEST_CHECK(EOK_uint16dummy == eo_nvscfg_hid_ip2index(nvscfg, EO_COMMON_IPV4ADDR(192, 168, 1, 1)));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,725 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#define _GNU_SOURCE
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "sys/mman.h"
+#include "hal_brdcfg_modules.h"
+#include "hal_middleware_interface.h"
+#include "hal_sys.h"
+#include "hal_heap.h"
+#include "hal_gpio.h"
+#include "hal_mux.h"
+#include "hl_spi.h"
+#include "hal_spi_hid.h"
+#include "hal_encoder_hid.h"
+
+#include "hlplus-shims.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of extern public interface
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "fake-spi-dma.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define FAKE_LOWMEM                 (1024*1024)
+#define FAKE_ANSWER_MAXSIZE         8
+
+// as in stm32f4xx_dma.c
+#define FAKE_DMA_HIGH_ISR_MASK      ((uint32_t)0x20000000)
+#define FAKE_DMA_RESERVED_MASK      ((uint32_t)0x0F7D0F7D)
+#define FAKE_DMA_TRANSFER_IT_MASK   ((uint32_t)0x0F3C0F3C)
+#define FAKE_DMA_IT_ENABLE_MASK     ((uint32_t)(DMA_SxCR_TCIE | DMA_SxCR_HTIE | DMA_SxCR_TEIE | DMA_SxCR_DMEIE))
+
+#define FAKE_DMA_NUMSTREAMS         8
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    uint32_t            m0ar;
+    uint16_t            ndtr;
+} fake_stream_t;
+
+typedef struct
+{
+    SPI_TypeDef*        spi;
+    uint8_t             rxstream;           // the index of the stream of DMA1, or FAKE_DMA_NUMSTREAMS if none
+    uint8_t             txstream;
+    IRQn_Type           spiirqn;
+    IRQn_Type           rxirqn;
+    void                (*spiisr)(void);
+    void                (*rxisr)(void);
+} fake_spimap_t;
+
+typedef struct
+{
+    uint8_t             answer[FAKE_ANSWER_MAXSIZE];
+    uint8_t             answersize;
+    uint8_t             isrsent;            // the bytes sent by hal_spi in isr mode and not yet answered
+    uint8_t             isrposition;
+} fake_slave_t;
+
+typedef struct
+{
+    uint8_t             enabled;
+    hal_mux_sel_t       sel;
+} fake_mux_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static DMA_Stream_TypeDef* s_fake_stream(uint8_t index);
+static uint8_t s_fake_stream_index(DMA_Stream_TypeDef* DMAy_Streamx);
+static volatile uint32_t* s_fake_dma_isr(uint32_t flags);
+static uint32_t s_fake_dma_isrbits(uint8_t index, uint32_t bits);
+static hal_bool_t s_fake_dma_end(hal_spi_t id, hal_bool_t failed);
+static hal_bool_t s_fake_irqn_enabled_is(IRQn_Type irqn);
+static uint8_t s_fake_answer(fake_slave_t *slave, uint8_t position);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of extern variables
+// --------------------------------------------------------------------------------------------------------------------
+
+// spi2 and spi3 as on the ems4rd. spi1 has no gpio on it, but it is supported: it has no dma streams
+const hal_spi_boardconfig_t hal_spi__theboardconfig =
+{
+    .supportedmask          = (1 << hal_spi1) | (1 << hal_spi2) | (1 << hal_spi3),
+    .gpiomap                = { { { { 0 } } } }
+};
+
+const hal_encoder_boardconfig_t hal_encoder__theboardconfig =
+{
+    .supportedmask          = (1 << hal_encoder1) | (1 << hal_encoder2) | (1 << hal_encoder3) | (1 << hal_encoder4) | (1 << hal_encoder5),
+    .spimaxspeed            = 1000*1000,
+    .spiusedma              = hal_true,
+    .spimap                 =
+    {
+        { .spiid = hal_spi2,  .muxid = hal_mux2,  .muxsel = hal_mux_selA },
+        { .spiid = hal_spi2,  .muxid = hal_mux2,  .muxsel = hal_mux_selB },
+        { .spiid = hal_spi2,  .muxid = hal_mux2,  .muxsel = hal_mux_selC },
+        { .spiid = hal_spi3,  .muxid = hal_mux3,  .muxsel = hal_mux_selA },
+        { .spiid = hal_spi1,  .muxid = hal_mux1,  .muxsel = hal_mux_selA },
+        { .spiid = hal_spi1,  .muxid = hal_mux1,  .muxsel = hal_mux_selB }
+    }
+};
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+// the isr of hal_spi.c
+extern void SPI1_IRQHandler(void);
+extern void SPI2_IRQHandler(void);
+extern void SPI3_IRQHandler(void);
+extern void DMA1_Stream3_IRQHandler(void);
+extern void DMA1_Stream0_IRQHandler(void);
+
+static const fake_spimap_t s_fake_spimap[hal_spis_number] =
+{
+    { SPI1, FAKE_DMA_NUMSTREAMS, FAKE_DMA_NUMSTREAMS, SPI1_IRQn, DMA2_Stream2_IRQn, SPI1_IRQHandler, NULL },
+    { SPI2, 3, 4, SPI2_IRQn, DMA1_Stream3_IRQn, SPI2_IRQHandler, DMA1_Stream3_IRQHandler },
+    { SPI3, 0, 5, SPI3_IRQn, DMA1_Stream0_IRQn, SPI3_IRQHandler, DMA1_Stream0_IRQHandler }
+};
+
+static fake_stream_t s_fake_streams[FAKE_DMA_NUMSTREAMS] = { { 0 } };
+static fake_slave_t s_fake_slaves[hal_spis_number] = { { { 0 } } };
+static fake_mux_t s_fake_muxes[hal_muxes_number] = { { 0 } };
+static uint32_t s_fake_irqnenabled[4] = { 0 };
+static fake_spi_dma_counters_t s_fake_counters = { 0 };
+
+static uint8_t *s_fake_lowmem = NULL;
+static uint32_t s_fake_lowmemused = 0;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+extern void fake_spi_dma_Initialise(void)
+{
+    uint8_t i;
+
+    // spi2 and spi3 are in the same page
+    hlplus_shims_peripherals_map(SPI1_BASE, sizeof(SPI_TypeDef));
+    hlplus_shims_peripherals_map(SPI2_BASE, SPI3_BASE + sizeof(SPI_TypeDef) - SPI2_BASE);
+    hlplus_shims_peripherals_map(DMA1_BASE, (uint32_t)DMA1_Stream7_BASE + sizeof(DMA_Stream_TypeDef) - DMA1_BASE);
+
+    // the dma writes where the stream points: the frames of hal_heap must have 32 bit addresses
+    s_fake_lowmem = mmap(NULL, FAKE_LOWMEM, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+    if((MAP_FAILED == (void*)s_fake_lowmem) || ((uintptr_t)s_fake_lowmem + FAKE_LOWMEM > 0xffffffffu))
+    {
+        fprintf(stderr, "fake-spi-dma: cannot map memory in the low 4 GB\n");
+        abort();
+    }
+    s_fake_lowmemused = 0;
+
+    for(i=0; i<hal_spis_number; i++)
+    {
+        // the tx buffer is always empty and the bus is never busy
+        s_fake_spimap[i].spi->SR = SPI_I2S_FLAG_TXE;
+        fake_spi_dma_answer_set((hal_spi_t)i, NULL, 0);
+    }
+
+    memset(s_fake_streams, 0, sizeof(s_fake_streams));
+    memset(s_fake_muxes, 0, sizeof(s_fake_muxes));
+    memset(s_fake_irqnenabled, 0, sizeof(s_fake_irqnenabled));
+    memset(&s_fake_counters, 0, sizeof(s_fake_counters));
+}
+
+
+extern void fake_spi_dma_answer_set(hal_spi_t id, const uint8_t *frame, uint8_t size)
+{
+    fake_slave_t *slave = &s_fake_slaves[id];
+
+    if(size > FAKE_ANSWER_MAXSIZE)
+    {
+        size = FAKE_ANSWER_MAXSIZE;
+    }
+
+    memset(slave->answer, 0xFF, sizeof(slave->answer));
+    if(NULL != frame)
+    {
+        memcpy(slave->answer, frame, size);
+    }
+    slave->answersize = size;
+}
+
+
+extern hal_bool_t fake_spi_dma_complete(hal_spi_t id)
+{
+    return(s_fake_dma_end(id, hal_false));
+}
+
+
+extern hal_bool_t fake_spi_dma_fail(hal_spi_t id)
+{
+    return(s_fake_dma_end(id, hal_true));
+}
+
+
+extern hal_bool_t fake_spi_isr_complete(hal_spi_t id)
+{
+    const fake_spimap_t *map = &s_fake_spimap[id];
+    fake_slave_t *slave = &s_fake_slaves[id];
+    hal_bool_t done = hal_false;
+
+    slave->isrposition = 0;
+
+    // every byte sent clocks a byte in. the isr reads it and, if the frame is not finished, it sends the next one
+    while((0 != slave->isrsent) && (0 != (map->spi->CR1 & SPI_CR1_SPE)))
+    {
+        slave->isrsent--;
+        map->spi->DR = s_fake_answer(slave, slave->isrposition++);
+        map->spi->SR |= SPI_I2S_FLAG_RXNE;
+        s_fake_counters.isrbytes++;
+        done = hal_true;
+
+        if((0 != (map->spi->CR2 & SPI_CR2_RXNEIE)) && (hal_true == s_fake_irqn_enabled_is(map->spiirqn)))
+        {
+            map->spiisr();
+        }
+    }
+
+    return(done);
+}
+
+
+extern hal_bool_t fake_spi_dma_rxstream_enabled_is(hal_spi_t id)
+{
+    const fake_spimap_t *map = &s_fake_spimap[id];
+
+    if(FAKE_DMA_NUMSTREAMS == map->rxstream)
+    {
+        return(hal_false);
+    }
+
+    return((0 != (s_fake_stream(map->rxstream)->CR & DMA_SxCR_EN)) ? (hal_true) : (hal_false));
+}
+
+
+extern uint32_t fake_spi_dma_rxaddress_get(hal_spi_t id)
+{
+    const fake_spimap_t *map = &s_fake_spimap[id];
+
+    if(FAKE_DMA_NUMSTREAMS == map->rxstream)
+    {
+        return(0);
+    }
+
+    return(s_fake_streams[map->rxstream].m0ar);
+}
+
+
+extern hal_bool_t fake_mux_enabled_is(hal_mux_t id, hal_mux_sel_t *sel)
+{
+    if(NULL != sel)
+    {
+        *sel = s_fake_muxes[id].sel;
+    }
+
+    return((0 != s_fake_muxes[id].enabled) ? (hal_true) : (hal_false));
+}
+
+
+extern void fake_spi_dma_counters_Get(fake_spi_dma_counters_t *counters)
+{
+    *counters = s_fake_counters;
+}
+
+
+// the spi of the stm32 library: the registers are the ones of the peripheral, the bus is simulated
+
+extern void SPI_Cmd(SPI_TypeDef* SPIx, FunctionalState NewState)
+{
+    if(DISABLE != NewState)
+    {
+        SPIx->CR1 |= SPI_CR1_SPE;
+    }
+    else
+    {
+        SPIx->CR1 &= (uint16_t)~((uint16_t)SPI_CR1_SPE);
+    }
+}
+
+
+extern FlagStatus SPI_I2S_GetFlagStatus(SPI_TypeDef* SPIx, uint16_t SPI_I2S_FLAG)
+{
+    return((0 != (SPIx->SR & SPI_I2S_FLAG)) ? (SET) : (RESET));
+}
+
+
+extern void SPI_I2S_SendData(SPI_TypeDef* SPIx, uint16_t Data)
+{
+    uint8_t i;
+
+    SPIx->DR = Data;
+
+    for(i=0; i<hal_spis_number; i++)
+    {
+        if(SPIx == s_fake_spimap[i].spi)
+        {
+            s_fake_slaves[i].isrsent++;
+        }
+    }
+}
+
+
+extern uint16_t SPI_I2S_ReceiveData(SPI_TypeDef* SPIx)
+{
+    SPIx->SR &= (uint16_t)~SPI_I2S_FLAG_RXNE;
+    return(SPIx->DR);
+}
+
+
+extern void SPI_I2S_ITConfig(SPI_TypeDef* SPIx, uint8_t SPI_I2S_IT, FunctionalState NewState)
+{
+    uint16_t itmask = (uint16_t)1 << (uint16_t)(SPI_I2S_IT >> 4);
+
+    if(DISABLE != NewState)
+    {
+        SPIx->CR2 |= itmask;
+    }
+    else
+    {
+        SPIx->CR2 &= (uint16_t)~itmask;
+    }
+}
+
+
+extern void SPI_I2S_DMACmd(SPI_TypeDef* SPIx, uint16_t SPI_I2S_DMAReq, FunctionalState NewState)
+{
+    if(DISABLE != NewState)
+    {
+        SPIx->CR2 |= SPI_I2S_DMAReq;
+    }
+    else
+    {
+        SPIx->CR2 &= (uint16_t)~SPI_I2S_DMAReq;
+    }
+}
+
+
+// the dma of the stm32 library. as the hardware, a stream takes its memory address and its counter when it is
+// enabled, and while it is enabled it ignores any write of them
+
+extern void DMA_StructInit(DMA_InitTypeDef* DMA_InitStruct)
+{
+    memset(DMA_InitStruct, 0, sizeof(DMA_InitTypeDef));
+}
+
+
+extern void DMA_DeInit(DMA_Stream_TypeDef* DMAy_Streamx)
+{
+    uint8_t index = s_fake_stream_index(DMAy_Streamx);
+
+    DMAy_Streamx->CR = 0;
+    DMAy_Streamx->NDTR = 0;
+    DMAy_Streamx->PAR = 0;
+    DMAy_Streamx->M0AR = 0;
+    DMAy_Streamx->M1AR = 0;
+    DMAy_Streamx->FCR = 0x00000021;
+    *s_fake_dma_isr((index >= 4) ? FAKE_DMA_HIGH_ISR_MASK : 0) &= ~s_fake_dma_isrbits(index, 0x3D);
+    memset(&s_fake_streams[index], 0, sizeof(fake_stream_t));
+}
+
+
+extern void DMA_Init(DMA_Stream_TypeDef* DMAy_Streamx, DMA_InitTypeDef* DMA_InitStruct)
+{
+    DMAy_Streamx->CR = DMA_InitStruct->DMA_Channel | DMA_InitStruct->DMA_DIR | DMA_InitStruct->DMA_PeripheralInc |
+                       DMA_InitStruct->DMA_MemoryInc | DMA_InitStruct->DMA_PeripheralDataSize |
+                       DMA_InitStruct->DMA_MemoryDataSize | DMA_InitStruct->DMA_Mode | DMA_InitStruct->DMA_Priority |
+                       DMA_InitStruct->DMA_MemoryBurst | DMA_InitStruct->DMA_PeripheralBurst;
+    DMAy_Streamx->NDTR = DMA_InitStruct->DMA_BufferSize;
+    DMAy_Streamx->PAR = DMA_InitStruct->DMA_PeripheralBaseAddr;
+    DMAy_Streamx->M0AR = DMA_InitStruct->DMA_Memory0BaseAddr;
+}
+
+
+extern void DMA_ITConfig(DMA_Stream_TypeDef* DMAy_Streamx, uint32_t DMA_IT, FunctionalState NewState)
+{
+    if(DISABLE != NewState)
+    {
+        DMAy_Streamx->CR |= (DMA_IT & FAKE_DMA_IT_ENABLE_MASK);
+    }
+    else
+    {
+        DMAy_Streamx->CR &= ~(DMA_IT & FAKE_DMA_IT_ENABLE_MASK);
+    }
+}
+
+
+extern void DMA_SetCurrDataCounter(DMA_Stream_TypeDef* DMAy_Streamx, uint16_t Counter)
+{
+    if(0 != (DMAy_Streamx->CR & DMA_SxCR_EN))
+    {
+        s_fake_counters.ignoredwrites++;
+        return;
+    }
+
+    DMAy_Streamx->NDTR = Counter;
+}
+
+
+extern void DMA_Cmd(DMA_Stream_TypeDef* DMAy_Streamx, FunctionalState NewState)
+{
+    fake_stream_t *stream = &s_fake_streams[s_fake_stream_index(DMAy_Streamx)];
+
+    if(DISABLE == NewState)
+    {
+        DMAy_Streamx->CR &= ~(uint32_t)DMA_SxCR_EN;
+        return;
+    }
+
+    if(0 != (DMAy_Streamx->CR & DMA_SxCR_EN))
+    {   // a write of the address while enabled is detected when the stream is enabled again
+        if(DMAy_Streamx->M0AR != stream->m0ar)
+        {
+            s_fake_counters.ignoredwrites++;
+            DMAy_Streamx->M0AR = stream->m0ar;
+        }
+        return;
+    }
+
+    stream->m0ar = DMAy_Streamx->M0AR;
+    stream->ndtr = (uint16_t)DMAy_Streamx->NDTR;
+    DMAy_Streamx->CR |= DMA_SxCR_EN;
+}
+
+
+extern FunctionalState DMA_GetCmdStatus(DMA_Stream_TypeDef* DMAy_Streamx)
+{
+    return((0 != (DMAy_Streamx->CR & DMA_SxCR_EN)) ? (ENABLE) : (DISABLE));
+}
+
+
+extern void DMA_ClearFlag(DMA_Stream_TypeDef* DMAy_Streamx, uint32_t DMA_FLAG)
+{
+    // the ifcr clears the isr: here it is done at once
+    *s_fake_dma_isr(DMA_FLAG) &= ~(DMA_FLAG & FAKE_DMA_RESERVED_MASK);
+}
+
+
+extern ITStatus DMA_GetITStatus(DMA_Stream_TypeDef* DMAy_Streamx, uint32_t DMA_IT)
+{
+    uint32_t enabled = 0;
+
+    if(0 != (DMA_IT & FAKE_DMA_TRANSFER_IT_MASK))
+    {
+        enabled = DMAy_Streamx->CR & ((DMA_IT >> 11) & FAKE_DMA_IT_ENABLE_MASK);
+    }
+    else
+    {
+        enabled = DMAy_Streamx->FCR & DMA_IT_FE;
+    }
+
+    return(((0 != enabled) && (0 != (*s_fake_dma_isr(DMA_IT) & DMA_IT & FAKE_DMA_RESERVED_MASK))) ? (SET) : (RESET));
+}
+
+
+extern void DMA_ClearITPendingBit(DMA_Stream_TypeDef* DMAy_Streamx, uint32_t DMA_IT)
+{
+    *s_fake_dma_isr(DMA_IT) &= ~(DMA_IT & FAKE_DMA_RESERVED_MASK);
+}
+
+
+extern void RCC_AHB1PeriphClockCmd(uint32_t RCC_AHB1Periph, FunctionalState NewState)
+{
+}
+
+
+// hl_spi: the gpio and the clock of the spi are not there, only the speed of their bus
+
+extern uint32_t hl_spi_speedofbus_get(hl_spi_t id)
+{
+    // spi1 is on apb2, spi2 and spi3 on apb1
+    return((hl_spi1 == id) ? (84000000) : (42000000));
+}
+
+
+extern hl_result_t hl_spi_init(hl_spi_t id, const hl_spi_cfg_t *cfg)
+{
+    return(hl_res_OK);
+}
+
+
+extern hl_result_t hl_spi_enable(hl_spi_t id)
+{
+    return(hl_res_OK);
+}
+
+
+extern hl_result_t hl_spi_deinit(hl_spi_t id)
+{
+    return(hl_res_OK);
+}
+
+
+// hal_heap: memory with a 32 bit address, as the one of the boards
+
+extern void* hal_heap_new(uint32_t size)
+{
+    void *p = NULL;
+
+    size = (size + 7) & ~7u;
+    if(s_fake_lowmemused + size > FAKE_LOWMEM)
+    {
+        fprintf(stderr, "fake-spi-dma: out of low memory\n");
+        abort();
+    }
+
+    p = &s_fake_lowmem[s_fake_lowmemused];
+    s_fake_lowmemused += size;
+    return(p);
+}
+
+
+extern void hal_heap_delete(void** p)
+{
+    *p = NULL;
+}
+
+
+// hal_sys: the nvic only tells which irqs are enabled
+
+extern void hal_sys_irqn_enable(hal_irqn_t irqn)
+{
+    s_fake_irqnenabled[((uint32_t)irqn >> 5) & 3] |= (1UL << ((uint32_t)irqn & 0x1F));
+}
+
+
+extern void hal_sys_irqn_priority_set(hal_irqn_t irqn, hal_interrupt_priority_t prio)
+{
+}
+
+
+// hal_mux and hal_gpio
+
+extern hal_result_t hal_mux_init(hal_mux_t id, const hal_mux_cfg_t *cfg)
+{
+    return(hal_res_OK);
+}
+
+
+extern hal_result_t hal_mux_enable(hal_mux_t id, hal_mux_sel_t muxsel)
+{
+    s_fake_muxes[id].enabled = 1;
+    s_fake_muxes[id].sel = muxsel;
+    s_fake_counters.muxenables++;
+    return(hal_res_OK);
+}
+
+
+extern hal_result_t hal_mux_disable(hal_mux_t id)
+{
+    s_fake_muxes[id].enabled = 0;
+    s_fake_counters.muxdisables++;
+    return(hal_res_OK);
+}
+
+
+extern hal_result_t hal_mux_get_cs(hal_mux_t id, hal_gpio_t* cs)
+{
+    cs->port = hal_gpio_portNONE;
+    cs->pin = hal_gpio_pinNONE;
+    return(hal_res_OK);
+}
+
+
+extern hal_result_t hal_mux_deinit(hal_mux_t id)
+{
+    return(hal_res_OK);
+}
+
+
+extern hal_result_t hal_gpio_setval(hal_gpio_t gpio, hal_gpio_val_t val)
+{
+    return(hal_res_OK);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static DMA_Stream_TypeDef* s_fake_stream(uint8_t index)
+{
+    return((DMA_Stream_TypeDef*)(uintptr_t)(DMA1_Stream0_BASE + index*(DMA1_Stream1_BASE - DMA1_Stream0_BASE)));
+}
+
+
+static uint8_t s_fake_stream_index(DMA_Stream_TypeDef* DMAy_Streamx)
+{
+    uint32_t offset = (uint32_t)(uintptr_t)DMAy_Streamx - DMA1_Stream0_BASE;
+    uint32_t index = offset / (DMA1_Stream1_BASE - DMA1_Stream0_BASE);
+
+    if(index >= FAKE_DMA_NUMSTREAMS)
+    {
+        fprintf(stderr, "fake-spi-dma: only the streams of DMA1 are simulated\n");
+        abort();
+    }
+
+    return((uint8_t)index);
+}
+
+
+// the lisr or the hisr of DMA1, as told by the flags
+static volatile uint32_t* s_fake_dma_isr(uint32_t flags)
+{
+    return((0 != (flags & FAKE_DMA_HIGH_ISR_MASK)) ? (&DMA1->HISR) : (&DMA1->LISR));
+}
+
+
+// the bits of stream index in its isr register: the 6 bits of streams 0 and 4 are at 0, those of 1 and 5 at 6, those
+// of 2 and 6 at 16, and those of 3 and 7 at 22
+static uint32_t s_fake_dma_isrbits(uint8_t index, uint32_t bits)
+{
+    static const uint8_t shift[4] = { 0, 6, 16, 22 };
+    return(bits << shift[index & 3]);
+}
+
+
+static hal_bool_t s_fake_dma_end(hal_spi_t id, hal_bool_t failed)
+{
+    const fake_spimap_t *map = &s_fake_spimap[id];
+    fake_slave_t *slave = &s_fake_slaves[id];
+    DMA_Stream_TypeDef *rx = NULL;
+    DMA_Stream_TypeDef *tx = NULL;
+    fake_stream_t *latched = NULL;
+    uint16_t i;
+
+    if(FAKE_DMA_NUMSTREAMS == map->rxstream)
+    {
+        return(hal_false);
+    }
+
+    rx = s_fake_stream(map->rxstream);
+    tx = s_fake_stream(map->txstream);
+    latched = &s_fake_streams[map->rxstream];
+
+    // no clock on the bus without the spi, the requests to the dma and both streams
+    if((0 == (map->spi->CR1 & SPI_CR1_SPE)) || (0 == (rx->CR & DMA_SxCR_EN)) || (0 == (tx->CR & DMA_SxCR_EN)) ||
+       ((SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx) != (map->spi->CR2 & (SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx))))
+    {
+        return(hal_false);
+    }
+
+    if(hal_false == failed)
+    {   // the bytes go where the stream pointed when it was enabled
+        uint8_t *memory = (uint8_t*)(uintptr_t)latched->m0ar;
+        for(i=0; i<latched->ndtr; i++)
+        {
+            memory[i] = s_fake_answer(slave, (uint8_t)i);
+        }
+        rx->NDTR = 0;
+        tx->NDTR = 0;
+        *s_fake_dma_isr((map->rxstream >= 4) ? FAKE_DMA_HIGH_ISR_MASK : 0) |= s_fake_dma_isrbits(map->rxstream, DMA_LISR_TCIF0 | DMA_LISR_HTIF0);
+    }
+    else
+    {
+        *s_fake_dma_isr((map->rxstream >= 4) ? FAKE_DMA_HIGH_ISR_MASK : 0) |= s_fake_dma_isrbits(map->rxstream, DMA_LISR_TEIF0);
+    }
+
+    // at the end of the transfer, or on an error, the hardware disables the streams
+    rx->CR &= ~(uint32_t)DMA_SxCR_EN;
+    tx->CR &= ~(uint32_t)DMA_SxCR_EN;
+    s_fake_counters.dmatransfers++;
+
+    if(hal_true == s_fake_irqn_enabled_is(map->rxirqn))
+    {
+        map->rxisr();
+    }
+
+    return(hal_true);
+}
+
+
+static hal_bool_t s_fake_irqn_enabled_is(IRQn_Type irqn)
+{
+    return((0 != (s_fake_irqnenabled[((uint32_t)irqn >> 5) & 3] & (1UL << ((uint32_t)irqn & 0x1F)))) ? (hal_true) : (hal_false));
+}
+
+
+static uint8_t s_fake_answer(fake_slave_t *slave, uint8_t position)
+{
+    return((position < slave->answersize) ? (slave->answer[position]) : (0xFF));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// - include guard ----------------------------------------------------------------------------------------------------
+#ifndef _FAKE_SPI_DMA_H_
+#define _FAKE_SPI_DMA_H_
+
+
+/** @file       fake-spi-dma.h
+    @brief      This header file gives the control of a host replacement of the spi and dma of the stm32f4 used to run
+                hal_spi and hal_encoder of hal2 on linux.
+                the SPI_*() and DMA_*() functions of the stm32 library work on the registers of SPI1-3 and of DMA1, which
+                are mapped at their addresses. the slave on the bus and the dma controller are simulated: a stream
+                latches its memory address and its counter when it is enabled and it ignores them while it stays
+                enabled, as the hardware does. a transfer ends only when the test says so, and then the isr of hal_spi
+                is called as the nvic would do. hal_mux, hal_gpio, hal_heap, the irqs of hal_sys and hl_spi are also
+                replaced, and the board has the spi and the encoders of the ems4rd plus encoder5 on spi1, which has no
+                dma streams and keeps the isr mode.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+
+// - external dependencies --------------------------------------------------------------------------------------------
+
+#include "stdint.h"
+#include "hal_spi.h"
+#include "hal_mux.h"
+
+
+// - declaration of public user-defined types -------------------------------------------------------------------------
+
+typedef struct
+{
+    uint32_t    dmatransfers;   /**< the dma transfers ended by fake_spi_dma_complete() or by fake_spi_dma_fail() */
+    uint32_t    isrbytes;       /**< the bytes received in isr mode */
+    uint32_t    ignoredwrites;  /**< the writes of the counter or of the memory address of an enabled stream */
+    uint32_t    muxenables;     /**< the calls of hal_mux_enable() */
+    uint32_t    muxdisables;    /**< the calls of hal_mux_disable() */
+} fake_spi_dma_counters_t;
+
+
+// - declaration of extern public functions ---------------------------------------------------------------------------
+
+/** @fn         extern void fake_spi_dma_Initialise(void)
+    @brief      Maps the registers of SPI1-3 and of DMA1 and it resets the counters. It must be called once before
+                any function of hal_spi.
+ **/
+extern void fake_spi_dma_Initialise(void);
+
+
+/** @fn         extern void fake_spi_dma_answer_set(hal_spi_t id, const uint8_t *frame, uint8_t size)
+    @brief      Sets the bytes the slave on spi @e id answers to the next transfers. Past @e size it answers 0xFF, as
+                a bus with nobody on it.
+ **/
+extern void fake_spi_dma_answer_set(hal_spi_t id, const uint8_t *frame, uint8_t size);
+
+
+/** @fn         extern hal_bool_t fake_spi_dma_complete(hal_spi_t id)
+    @brief      Ends the dma transfer of spi @e id: the answer of the slave goes where the rx stream was pointing when
+                it was enabled, the streams disable themselves and the isr of the rx stream is called if enabled.
+    @return     hal_false if no transfer was going on (the streams, the dma requests or the spi were not enabled)
+ **/
+extern hal_bool_t fake_spi_dma_complete(hal_spi_t id);
+
+
+/** @fn         extern hal_bool_t fake_spi_dma_fail(hal_spi_t id)
+    @brief      Ends the dma transfer of spi @e id with a transfer error: nothing is written, the streams disable
+                themselves and the isr of the rx stream is called if its transfer error interrupt is enabled.
+    @return     hal_false if no transfer was going on
+ **/
+extern hal_bool_t fake_spi_dma_fail(hal_spi_t id);
+
+
+/** @fn         extern hal_bool_t fake_spi_isr_complete(hal_spi_t id)
+    @brief      Runs the bytes of spi @e id in isr mode: each byte sent by hal_spi gets a byte of the answer and the
+                rx isr, until hal_spi stops sending.
+    @return     hal_false if no byte was sent
+ **/
+extern hal_bool_t fake_spi_isr_complete(hal_spi_t id);
+
+
+/** @fn         extern hal_bool_t fake_spi_dma_rxstream_enabled_is(hal_spi_t id)
+    @brief      Tells if the rx stream of spi @e id is enabled, that is if a dma transfer is going on.
+ **/
+extern hal_bool_t fake_spi_dma_rxstream_enabled_is(hal_spi_t id);
+
+
+/** @fn         extern uint32_t fake_spi_dma_rxaddress_get(hal_spi_t id)
+    @brief      Gets the memory address latched by the rx stream of spi @e id when it was enabled the last time.
+ **/
+extern uint32_t fake_spi_dma_rxaddress_get(hal_spi_t id);
+
+
+/** @fn         extern hal_bool_t fake_mux_enabled_is(hal_mux_t id, hal_mux_sel_t *sel)
+    @brief      Tells if mux @e id is enabled and, if so, on which selection.
+ **/
+extern hal_bool_t fake_mux_enabled_is(hal_mux_t id, hal_mux_sel_t *sel);
+
+
+extern void fake_spi_dma_counters_Get(fake_spi_dma_counters_t *counters);
+
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
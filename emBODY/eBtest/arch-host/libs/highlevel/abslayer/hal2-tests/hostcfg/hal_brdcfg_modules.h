@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+
+
+#ifndef _HAL_BRDCFG_MODULES_H_
+#define _HAL_BRDCFG_MODULES_H_
+
+
+/** @file       hal_brdcfg_modules.h
+    @brief      This header file keeps which modules of hal2 are built in the host tests. the mpu is the stm32f407 of
+                the ems4rd, whose macros are the ones of hal_mpuname2macros.h, and the hl configuration is the one of
+                the host tests of hl-plus.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+
+#define     HAL_USE_MPU_NAME_STM32F407IG
+#define     HAL_USE_MPU_ARCH_ARMCM4
+#define     HAL_USE_MPU_TYPE_STM32F4
+
+#define     HAL_USE_HEAP
+#define     HAL_USE_SYS
+#define     HAL_USE_GPIO
+#define     HAL_USE_SPI
+#define     HAL_USE_MUX
+#define     HAL_USE_ENCODER
+
+
+#include "hl_cfg_plus_modules.h"
+
+#define     HL_USE_UTIL_SPI
+
+
+#endif  // include-guard
@@ -0,0 +1,383 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       spi-encoder-test.c
+    @brief      host test of the reading of the aea encoders by hal_encoder over hal_spi in dma mode, run over the spi
+                and the dma of fake-spi-dma.c. it checks that:
+                - a read starts with the mux on the encoder and the rx stream enabled, and it ends with one callback,
+                  the mux off, the streams off and the position of the frame. the next read goes into the other buffer.
+                - an encoder which does not answer gives tx_error, and the status bits of the frame give data_error
+                  and data_notready.
+                - a failed dma transfer calls the callback anyway, so that a chain goes on, and it gives tx_error.
+                - a read which never completes is started again without writing the registers of the enabled
+                  streams, and the new read gives the new frame.
+                - a chain of encoders on the same spi, where the callback of one starts the next, reads them all
+                  while another spi reads on its own.
+                - spi1, which has no dma streams, keeps the isr mode.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "hal_encoder.h"
+#include "hal_spi.h"
+
+#include "fake-spi-dma.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)    s_test_check((cond), #cond, __LINE__)
+
+#define TEST_ENCODERS       5
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static void s_test_on_rx(void *arg);
+static hal_encoder_position_t s_test_position(const uint8_t *frame);
+static void s_test_init(void);
+static int s_test_value_is(hal_encoder_t id, const uint8_t *frame);
+
+static void s_test_start_complete(void);
+static void s_test_encoder_errors(void);
+static void s_test_dma_failure(void);
+static void s_test_timeout(void);
+static void s_test_chain(void);
+static void s_test_isr_mode(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static uint32_t s_test_callbacks[TEST_ENCODERS] = { 0 };
+
+// the encoder started by the callback of each encoder, as the chains of EOappEncodersReader do
+static hal_encoder_t s_test_next[TEST_ENCODERS] = { hal_encoderNONE, hal_encoderNONE, hal_encoderNONE, hal_encoderNONE, hal_encoderNONE };
+
+static const uint8_t s_test_frames[3][3] =
+{
+    { 0x12, 0x34, 0x56 },
+    { 0x01, 0x24, 0x80 },
+    { 0x7F, 0xFC, 0xE0 }
+};
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    fake_spi_dma_Initialise();
+    s_test_init();
+
+    s_test_start_complete();
+    s_test_encoder_errors();
+    s_test_dma_failure();
+    s_test_timeout();
+    s_test_chain();
+    s_test_isr_mode();
+
+    if(0 != s_test_failures)
+    {
+        printf("spi-encoder-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("spi-encoder-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        printf("spi-encoder-test: line %d: %s failed\n", line, str);
+        s_test_failures++;
+    }
+}
+
+
+static void s_test_on_rx(void *arg)
+{
+    hal_encoder_t id = (hal_encoder_t)(uintptr_t)arg;
+
+    s_test_callbacks[id]++;
+
+    if(hal_encoderNONE != s_test_next[id])
+    {
+        hal_encoder_read_start(s_test_next[id]);
+    }
+}
+
+
+// as s_hal_encoder_frame2position_t1()
+static hal_encoder_position_t s_test_position(const uint8_t *frame)
+{
+    uint32_t pos = ((frame[0] & 0x7F) << 16) | (frame[1] << 8) | (frame[2] & 0xE0);
+    return((pos >> 5) & 0x03FFFF);
+}
+
+
+static void s_test_init(void)
+{
+    hal_encoder_cfg_t cfg;
+    uint8_t i;
+
+    memcpy(&cfg, &hal_encoder_cfg_default, sizeof(cfg));
+    cfg.type = hal_encoder_t1;
+    cfg.callback_on_rx = s_test_on_rx;
+
+    for(i=0; i<TEST_ENCODERS; i++)
+    {
+        cfg.arg = (void*)(uintptr_t)i;
+        TEST_CHECK(hal_res_OK == hal_encoder_init((hal_encoder_t)i, &cfg));
+    }
+}
+
+
+static int s_test_value_is(hal_encoder_t id, const uint8_t *frame)
+{
+    hal_encoder_position_t pos = 0;
+    hal_encoder_errors_flags flags = { 0 };
+
+    if(hal_res_OK != hal_encoder_get_value(id, &pos, &flags))
+    {
+        return(0);
+    }
+
+    return((s_test_position(frame) == pos) && (0 == flags.tx_error) && (0 == flags.data_error) && (0 == flags.data_notready));
+}
+
+
+static void s_test_start_complete(void)
+{
+    fake_spi_dma_counters_t counters = { 0 };
+    hal_mux_sel_t sel = hal_mux_selNONE;
+    uint32_t address0 = 0;
+
+    fake_spi_dma_answer_set(hal_spi2, s_test_frames[0], 3);
+
+    // start: the mux is on the encoder and the dma waits for the frame
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder1));
+    TEST_CHECK(hal_true == fake_mux_enabled_is(hal_mux2, &sel));
+    TEST_CHECK(hal_mux_selA == sel);
+    TEST_CHECK(hal_true == fake_spi_dma_rxstream_enabled_is(hal_spi2));
+    TEST_CHECK(hal_false == hal_spi_active_is(hal_spi2));
+    TEST_CHECK(0 == s_test_callbacks[hal_encoder1]);
+    address0 = fake_spi_dma_rxaddress_get(hal_spi2);
+    TEST_CHECK(0 != address0);
+
+    // complete: one callback, all off, and the position of the frame
+    TEST_CHECK(hal_true == fake_spi_dma_complete(hal_spi2));
+    TEST_CHECK(1 == s_test_callbacks[hal_encoder1]);
+    TEST_CHECK(hal_false == fake_mux_enabled_is(hal_mux2, NULL));
+    TEST_CHECK(hal_false == fake_spi_dma_rxstream_enabled_is(hal_spi2));
+    TEST_CHECK(hal_true == hal_spi_active_is(hal_spi2));
+    TEST_CHECK(s_test_value_is(hal_encoder1, s_test_frames[0]));
+
+    // nothing more comes without a start
+    TEST_CHECK(hal_false == fake_spi_dma_complete(hal_spi2));
+    TEST_CHECK(1 == s_test_callbacks[hal_encoder1]);
+
+    // the next read goes into the other buffer
+    fake_spi_dma_answer_set(hal_spi2, s_test_frames[1], 3);
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder1));
+    TEST_CHECK(address0 != fake_spi_dma_rxaddress_get(hal_spi2));
+    TEST_CHECK(hal_true == fake_spi_dma_complete(hal_spi2));
+    TEST_CHECK(2 == s_test_callbacks[hal_encoder1]);
+    TEST_CHECK(s_test_value_is(hal_encoder1, s_test_frames[1]));
+
+    fake_spi_dma_counters_Get(&counters);
+    TEST_CHECK(0 == counters.ignoredwrites);
+}
+
+
+static void s_test_encoder_errors(void)
+{
+    static const uint8_t baddata[3] = { 0x12, 0x33, 0x56 };
+    hal_encoder_position_t pos = 0;
+    hal_encoder_errors_flags flags = { 0 };
+
+    // nobody on the bus: the miso stays high
+    fake_spi_dma_answer_set(hal_spi2, NULL, 0);
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder2));
+    TEST_CHECK(hal_true == fake_spi_dma_complete(hal_spi2));
+    TEST_CHECK(1 == s_test_callbacks[hal_encoder2]);
+    TEST_CHECK(hal_res_NOK_generic == hal_encoder_get_value(hal_encoder2, &pos, &flags));
+    TEST_CHECK(1 == flags.tx_error);
+
+    // ocf, cof and lin are 0, 1 and 1 rather than 1, 0 and 0
+    memset(&flags, 0, sizeof(flags));
+    fake_spi_dma_answer_set(hal_spi2, baddata, 3);
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder2));
+    TEST_CHECK(hal_true == fake_spi_dma_complete(hal_spi2));
+    TEST_CHECK(2 == s_test_callbacks[hal_encoder2]);
+    TEST_CHECK(hal_res_OK == hal_encoder_get_value(hal_encoder2, &pos, &flags));
+    TEST_CHECK(0 == flags.tx_error);
+    TEST_CHECK(1 == flags.data_error);
+    TEST_CHECK(1 == flags.data_notready);
+}
+
+
+static void s_test_dma_failure(void)
+{
+    hal_encoder_position_t pos = 0;
+    hal_encoder_errors_flags flags = { 0 };
+    uint32_t callbacks = s_test_callbacks[hal_encoder1];
+
+    // a good frame first, so that a stale one would be seen
+    fake_spi_dma_answer_set(hal_spi2, s_test_frames[2], 3);
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder1));
+    TEST_CHECK(hal_true == fake_spi_dma_complete(hal_spi2));
+    TEST_CHECK(s_test_value_is(hal_encoder1, s_test_frames[2]));
+
+    // the transfer fails: the callback is called all the same and the frame is not the old one
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder1));
+    TEST_CHECK(hal_true == fake_spi_dma_fail(hal_spi2));
+    TEST_CHECK((callbacks + 2) == s_test_callbacks[hal_encoder1]);
+    TEST_CHECK(hal_true == hal_spi_active_is(hal_spi2));
+    TEST_CHECK(hal_false == fake_spi_dma_rxstream_enabled_is(hal_spi2));
+    TEST_CHECK(hal_false == fake_mux_enabled_is(hal_mux2, NULL));
+    TEST_CHECK(hal_res_NOK_generic == hal_encoder_get_value(hal_encoder1, &pos, &flags));
+    TEST_CHECK(1 == flags.tx_error);
+
+    // and the next read is good again
+    fake_spi_dma_answer_set(hal_spi2, s_test_frames[0], 3);
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder1));
+    TEST_CHECK(hal_true == fake_spi_dma_complete(hal_spi2));
+    TEST_CHECK((callbacks + 3) == s_test_callbacks[hal_encoder1]);
+    TEST_CHECK(s_test_value_is(hal_encoder1, s_test_frames[0]));
+}
+
+
+static void s_test_timeout(void)
+{
+    fake_spi_dma_counters_t counters = { 0 };
+    uint32_t callbacks = s_test_callbacks[hal_encoder3];
+
+    // the read never completes: the caller waits for the callback until its timeout
+    fake_spi_dma_answer_set(hal_spi2, s_test_frames[1], 3);
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder3));
+    TEST_CHECK(hal_false == hal_spi_active_is(hal_spi2));
+    TEST_CHECK(hal_true == fake_spi_dma_rxstream_enabled_is(hal_spi2));
+    TEST_CHECK(callbacks == s_test_callbacks[hal_encoder3]);
+
+    // then it starts again. the streams are still enabled: they must be stopped before they are loaded again
+    fake_spi_dma_answer_set(hal_spi2, s_test_frames[2], 3);
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder3));
+    fake_spi_dma_counters_Get(&counters);
+    TEST_CHECK(0 == counters.ignoredwrites);
+    TEST_CHECK(hal_true == fake_spi_dma_complete(hal_spi2));
+    TEST_CHECK((callbacks + 1) == s_test_callbacks[hal_encoder3]);
+    TEST_CHECK(s_test_value_is(hal_encoder3, s_test_frames[2]));
+    TEST_CHECK(hal_false == fake_spi_dma_complete(hal_spi2));
+}
+
+
+static void s_test_chain(void)
+{
+    static const uint8_t frame4[3] = { 0x40, 0x04, 0x20 };
+    uint32_t callbacks[TEST_ENCODERS];
+    hal_mux_sel_t sel = hal_mux_selNONE;
+    uint8_t i;
+
+    memcpy(callbacks, s_test_callbacks, sizeof(callbacks));
+
+    // encoder1 -> encoder2 -> encoder3 on spi2, and encoder4 alone on spi3
+    s_test_next[hal_encoder1] = hal_encoder2;
+    s_test_next[hal_encoder2] = hal_encoder3;
+
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder1));
+    fake_spi_dma_answer_set(hal_spi3, frame4, 3);
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder4));
+
+    for(i=0; i<3; i++)
+    {
+        // each callback has started the next encoder of the chain
+        TEST_CHECK(hal_true == fake_mux_enabled_is(hal_mux2, &sel));
+        TEST_CHECK((hal_mux_sel_t)i == sel);
+        fake_spi_dma_answer_set(hal_spi2, s_test_frames[i], 3);
+        TEST_CHECK(hal_true == fake_spi_dma_complete(hal_spi2));
+        TEST_CHECK((callbacks[i] + 1) == s_test_callbacks[i]);
+
+        if(1 == i)
+        {   // the other spi goes on its own
+            TEST_CHECK(hal_true == fake_spi_dma_complete(hal_spi3));
+        }
+    }
+
+    TEST_CHECK(hal_false == fake_spi_dma_complete(hal_spi2));
+    TEST_CHECK(hal_false == fake_mux_enabled_is(hal_mux2, NULL));
+
+    for(i=0; i<3; i++)
+    {
+        TEST_CHECK(s_test_value_is((hal_encoder_t)i, s_test_frames[i]));
+    }
+    TEST_CHECK((callbacks[hal_encoder4] + 1) == s_test_callbacks[hal_encoder4]);
+    TEST_CHECK(s_test_value_is(hal_encoder4, frame4));
+
+    s_test_next[hal_encoder1] = s_test_next[hal_encoder2] = hal_encoderNONE;
+}
+
+
+static void s_test_isr_mode(void)
+{
+    fake_spi_dma_counters_t counters = { 0 };
+    uint32_t dmatransfers = 0;
+
+    fake_spi_dma_counters_Get(&counters);
+    dmatransfers = counters.dmatransfers;
+
+    fake_spi_dma_answer_set(hal_spi1, s_test_frames[1], 3);
+    TEST_CHECK(hal_res_OK == hal_encoder_read_start(hal_encoder5));
+    TEST_CHECK(hal_false == fake_spi_dma_complete(hal_spi1));
+    TEST_CHECK(hal_true == fake_spi_isr_complete(hal_spi1));
+    TEST_CHECK(1 == s_test_callbacks[hal_encoder5]);
+    TEST_CHECK(s_test_value_is(hal_encoder5, s_test_frames[1]));
+    TEST_CHECK(hal_true == hal_spi_active_is(hal_spi1));
+
+    fake_spi_dma_counters_Get(&counters);
+    TEST_CHECK(3 == counters.isrbytes);
+    TEST_CHECK(dmatransfers == counters.dmatransfers);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       ipal-udp-test.c
+    @brief      host test of the transmission of the fake ipal (ipal/src/fake/ipal_f_udp.c), which counts the bytes that
+                ipal copies into the buffer of the stack. it checks that:
+                - ipal_udpsocket_sendto() copies every byte of the datagram.
+                - ipal_udpsocket_getbuffer() + ipal_udpsocket_commit() send the same datagram without any copy.
+                - a socket borrows one buffer at a time and gives it back with the commit, also when it fails, or when
+                  it is deleted.
+                - the losses set with ipal_f_udp_hid_loss_set() are counted and do not change the last datagram.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "ipal.h"
+#include "ipal_f_udp_hid.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)        s_test_check((cond), #cond, __LINE__)
+
+// the size of a ropframe of the ems
+#define TEST_DATAGRAMSIZE       600
+#define TEST_DATAGRAMS          10
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static void s_test_form(uint8_t *datagram, uint16_t size, uint8_t seq);
+
+static void s_test_copiedbytes(void);
+static void s_test_borrow(void);
+static void s_test_delete_gives_back(void);
+static void s_test_losses(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static const ipal_tos_t s_test_tos = { .precedence = ipal_prec_priority, .lowdelay = 1, .highthroughput = 1, .highreliability = 1, .unused = 0 };
+
+static const ipal_ipv4addr_t s_test_remaddr = IPAL_ipv4addr(10, 0, 1, 104);
+static const ipal_port_t s_test_remport = 12345;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    s_test_copiedbytes();
+    s_test_borrow();
+    s_test_delete_gives_back();
+    s_test_losses();
+
+    if(0 != s_test_failures)
+    {
+        printf("ipal-udp-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("ipal-udp-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        printf("ipal-udp-test: line %d: %s failed\n", line, str);
+        s_test_failures++;
+    }
+}
+
+
+static void s_test_form(uint8_t *datagram, uint16_t size, uint8_t seq)
+{
+    uint16_t i;
+
+    for(i=0; i<size; i++)
+    {
+        datagram[i] = (uint8_t)(seq + i);
+    }
+}
+
+
+static void s_test_copiedbytes(void)
+{
+    ipal_udpsocket_t *skt = ipal_udpsocket_new(s_test_tos);
+    ipal_f_udp_hid_statistics_t stats;
+    uint8_t datagram[TEST_DATAGRAMSIZE];
+    ipal_packet_t packet;
+    const uint8_t *last = NULL;
+    uint16_t lastsize = 0;
+    uint8_t i;
+
+    TEST_CHECK(ipal_res_OK == ipal_udpsocket_bind(skt, IPAL_ipv4addr(10, 0, 1, 1), 12346));
+
+    // the copy of ipal_udpsocket_sendto()
+    ipal_f_udp_hid_statistics_reset();
+    for(i=0; i<TEST_DATAGRAMS; i++)
+    {
+        s_test_form(datagram, sizeof(datagram), i);
+        packet.data = datagram;
+        packet.size = sizeof(datagram);
+        TEST_CHECK(ipal_res_OK == ipal_udpsocket_sendto(skt, &packet, s_test_remaddr, s_test_remport));
+    }
+    ipal_f_udp_hid_statistics_get(&stats);
+    TEST_CHECK(TEST_DATAGRAMS == stats.datagrams);
+    TEST_CHECK(TEST_DATAGRAMS*TEST_DATAGRAMSIZE == stats.bytes);
+    TEST_CHECK(TEST_DATAGRAMS*TEST_DATAGRAMSIZE == stats.copiedbytes);
+
+    // the datagram formed in place
+    ipal_f_udp_hid_statistics_reset();
+    for(i=0; i<TEST_DATAGRAMS; i++)
+    {
+        uint8_t *buffer = ipal_udpsocket_getbuffer(skt, TEST_DATAGRAMSIZE);
+        TEST_CHECK(NULL != buffer);
+        if(NULL == buffer)
+        {
+            break;
+        }
+        s_test_form(buffer, TEST_DATAGRAMSIZE, 100 + i);
+        TEST_CHECK(ipal_res_OK == ipal_udpsocket_commit(skt, buffer, TEST_DATAGRAMSIZE, s_test_remaddr, s_test_remport));
+    }
+    ipal_f_udp_hid_statistics_get(&stats);
+    TEST_CHECK(TEST_DATAGRAMS == stats.datagrams);
+    TEST_CHECK(TEST_DATAGRAMS*TEST_DATAGRAMSIZE == stats.bytes);
+    TEST_CHECK(0 == stats.copiedbytes);
+
+    // the stack has the last datagram as it was formed
+    s_test_form(datagram, sizeof(datagram), 100 + TEST_DATAGRAMS - 1);
+    last = ipal_f_udp_hid_lastdatagram_get(&lastsize);
+    TEST_CHECK(TEST_DATAGRAMSIZE == lastsize);
+    TEST_CHECK(0 == memcmp(last, datagram, TEST_DATAGRAMSIZE));
+
+    printf("ipal-udp-test: %d datagrams of %d bytes: sendto() copies %d bytes, getbuffer() + commit() copy %d\n",
+           TEST_DATAGRAMS, TEST_DATAGRAMSIZE, TEST_DATAGRAMS*TEST_DATAGRAMSIZE, (int)stats.copiedbytes);
+
+    ipal_udpsocket_delete(skt);
+}
+
+
+static void s_test_borrow(void)
+{
+    ipal_udpsocket_t *skt = ipal_udpsocket_new(s_test_tos);
+    uint8_t datagram[16] = {0};
+    ipal_packet_t packet = { .data = datagram, .size = sizeof(datagram) };
+    uint8_t *buffer = NULL;
+
+    ipal_udpsocket_bind(skt, IPAL_ipv4addr(10, 0, 1, 1), 12346);
+
+    TEST_CHECK(NULL == ipal_udpsocket_getbuffer(skt, 0));
+    TEST_CHECK(NULL == ipal_udpsocket_getbuffer(skt, IPAL_F_UDP_TXBUFFERSIZE + 1));
+
+    // one at a time, and the buffer of the stack cannot be used by sendto() meanwhile
+    buffer = ipal_udpsocket_getbuffer(skt, 100);
+    TEST_CHECK(NULL != buffer);
+    TEST_CHECK(NULL == ipal_udpsocket_getbuffer(skt, 100));
+    TEST_CHECK(ipal_res_NOK_generic == ipal_udpsocket_sendto(skt, &packet, s_test_remaddr, s_test_remport));
+
+    // a commit with a wrong size fails but gives the buffer back anyway
+    TEST_CHECK(ipal_res_NOK_generic == ipal_udpsocket_commit(skt, buffer, 0, s_test_remaddr, s_test_remport));
+    TEST_CHECK(ipal_res_NOK_generic == ipal_udpsocket_commit(skt, buffer, 10, s_test_remaddr, s_test_remport));
+    TEST_CHECK(ipal_res_OK == ipal_udpsocket_sendto(skt, &packet, s_test_remaddr, s_test_remport));
+
+    // a commit of a buffer which was not borrowed fails
+    TEST_CHECK(ipal_res_NOK_generic == ipal_udpsocket_commit(skt, datagram, 10, s_test_remaddr, s_test_remport));
+
+    ipal_udpsocket_delete(skt);
+}
+
+
+static void s_test_delete_gives_back(void)
+{
+    ipal_udpsocket_t *skt = ipal_udpsocket_new(s_test_tos);
+    uint8_t *buffer = NULL;
+
+    ipal_udpsocket_bind(skt, IPAL_ipv4addr(10, 0, 1, 1), 12346);
+    buffer = ipal_udpsocket_getbuffer(skt, 200);
+    TEST_CHECK(NULL != buffer);
+
+    // the socket is deleted with the buffer still borrowed: the stack must have it back
+    TEST_CHECK(ipal_res_OK == ipal_udpsocket_delete(skt));
+
+    skt = ipal_udpsocket_new(s_test_tos);
+    ipal_udpsocket_bind(skt, IPAL_ipv4addr(10, 0, 1, 1), 12346);
+    // the stale buffer cannot be committed and a new one can be borrowed
+    TEST_CHECK(ipal_res_NOK_generic == ipal_udpsocket_commit(skt, buffer, 200, s_test_remaddr, s_test_remport));
+    buffer = ipal_udpsocket_getbuffer(skt, 200);
+    TEST_CHECK(NULL != buffer);
+    TEST_CHECK(ipal_res_OK == ipal_udpsocket_commit(skt, buffer, 200, s_test_remaddr, s_test_remport));
+
+    ipal_udpsocket_delete(skt);
+}
+
+
+static void s_test_losses(void)
+{
+    ipal_udpsocket_t *skt = ipal_udpsocket_new(s_test_tos);
+    ipal_f_udp_hid_statistics_t stats;
+    uint16_t lastsize = 0;
+    uint8_t i;
+
+    ipal_udpsocket_bind(skt, IPAL_ipv4addr(10, 0, 1, 1), 12346);
+    ipal_f_udp_hid_statistics_reset();
+    ipal_f_udp_hid_loss_set(4);
+
+    for(i=0; i<12; i++)
+    {
+        uint8_t *buffer = ipal_udpsocket_getbuffer(skt, 64);
+        s_test_form(buffer, 64, i);
+        // the size tells which datagram the stack has last: the lost ones do not change it
+        TEST_CHECK(ipal_res_OK == ipal_udpsocket_commit(skt, buffer, 20 + i, s_test_remaddr, s_test_remport));
+        ipal_f_udp_hid_lastdatagram_get(&lastsize);
+        TEST_CHECK(lastsize == (((i+1) % 4 == 0) ? (20 + i - 1) : (20 + i)));
+    }
+
+    ipal_f_udp_hid_statistics_get(&stats);
+    TEST_CHECK(12 == stats.datagrams);
+    TEST_CHECK(3 == stats.dropped);
+
+    ipal_f_udp_hid_loss_set(0);
+    ipal_udpsocket_delete(skt);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
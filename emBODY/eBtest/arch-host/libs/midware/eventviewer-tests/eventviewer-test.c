@@ -0,0 +1,591 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       eventviewer-test.c
+    @brief      host test of the binary trace of eventviewer.c and of tools/eventviewer-decode.c, which are included as
+                they are. the primask of the cortex-m4 is a variable of the test, and an isr which preempts the copy
+                of eventviewer_trace_dump() is simulated by the memcpy() of eventviewer.c, which puts items in the
+                ring before it copies a given item. it checks that:
+                - the ring keeps the last capacity items when it wraps, and the dump gives them in order in chunks of
+                  any size, also when the 32-bit sequence number wraps around.
+                - the items are put with the irqs masked and copied by the dump with the irqs enabled.
+                - the items overwritten by an isr during the copy of a dump are trimmed away, and every item which
+                  the dump gives is intact and given once.
+                - the decoder sorts chunks received out of order, drops the duplicated ones, marks a gap with a lost
+                  event of the right size, unwraps the 32-bit timestamps and gives the slices of the entities and the
+                  events of the runner, of can and of eth.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "eventviewer.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)        s_test_check((cond), #cond, __LINE__)
+
+#define TEST_CAPACITY           16
+#define TEST_DUMPMAX            (sizeof(evTraceDumpHeader_t) + TEST_CAPACITY * sizeof(evTraceItem_t))
+#define TEST_DECODE_CHUNKS      6
+#define TEST_DECODE_PERCHUNK    4
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - the cortex-m4 and the isr which preempts the dump
+// --------------------------------------------------------------------------------------------------------------------
+
+static evTraceItem_t s_test_ring[4 * TEST_CAPACITY];
+
+static uint32_t s_test_primask = 0;
+static uint32_t s_test_copies = 0;
+static uint32_t s_test_lockedcopies = 0;
+static uint32_t s_test_isr_at = 0;
+static uint32_t s_test_isr_items = 0;
+static uint32_t s_test_putseq = 0;
+
+static void s_test_put(uint32_t number);
+
+// the copy of the items of the ring is the only one which has the ring as source
+static void * s_test_memcpy(void *dst, const void *src, size_t size)
+{
+    if(((const uint8_t*)src >= (const uint8_t*)s_test_ring) && ((const uint8_t*)src < (const uint8_t*)&s_test_ring[4 * TEST_CAPACITY]))
+    {
+        if(0 != s_test_primask)
+        {
+            s_test_lockedcopies++;
+        }
+
+        if(++s_test_copies == s_test_isr_at)
+        {   // the isr comes before this item is copied
+            s_test_put(s_test_isr_items);
+        }
+    }
+
+    return(memcpy(dst, src, size));
+}
+
+// the primask of armcc becomes a variable initialised with the one of the test
+#define __asm(x)            = s_test_primask
+#define __disable_irq()     (s_test_primask = 1)
+#define __enable_irq()      (s_test_primask = 0)
+#define memcpy              s_test_memcpy
+
+#include "eventviewer.c"
+
+#undef __asm
+#undef __disable_irq
+#undef __enable_irq
+#undef memcpy
+
+// the decoder gives its functions to the test
+#define main                eventviewer_decode_main
+
+#include "eventviewer-decode.c"
+
+#undef main
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    uint32_t    chunks;
+    uint32_t    items;          /**< the items given by the dumps */
+    uint32_t    skipped;        /**< the items between two chunks which the dumps did not give */
+    uint32_t    first;          /**< the sequence of the first item given */
+    uint32_t    broken;         /**< the items whose content is not the one put with their sequence */
+} test_dumped_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static uint32_t s_test_timestamp(void);
+static void s_test_trace_init(uint16_t capacity, uint32_t written);
+static void s_test_dump_all(uint16_t buffersize, uint32_t *cursor, test_dumped_t *dumped);
+static uint32_t s_test_count(const char *text, const char *pattern);
+
+static void s_test_ring_wrap(void);
+static void s_test_sequence_wrap(void);
+static void s_test_concurrent_dump(void);
+static void s_test_args(void);
+static void s_test_decoder(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static uint32_t s_test_time = 0;
+static uint32_t s_test_timestep = 1;
+static uint32_t s_test_unlockedputs = 0;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    s_test_ring_wrap();
+    s_test_sequence_wrap();
+    s_test_concurrent_dump();
+    s_test_args();
+    s_test_decoder();
+
+    TEST_CHECK(0 == s_test_unlockedputs);
+    TEST_CHECK(0 == s_test_lockedcopies);
+
+    if(0 != s_test_failures)
+    {
+        printf("eventviewer-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("eventviewer-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        printf("eventviewer-test: line %d: %s failed\n", line, str);
+        s_test_failures++;
+    }
+}
+
+
+// it is called by eventviewer_trace_put(), which must have masked the irqs
+static uint32_t s_test_timestamp(void)
+{
+    uint32_t t = s_test_time;
+
+    if(0 == s_test_primask)
+    {
+        s_test_unlockedputs++;
+    }
+
+    s_test_time += s_test_timestep;
+    return(t);
+}
+
+
+// the items of the ring tests have the low bits of their sequence in arg
+static void s_test_put(uint32_t number)
+{
+    uint32_t i;
+
+    for(i=0; i<number; i++)
+    {
+        eventviewer_trace_put(ev_TRACE_ID_first_usrdef, (uint16_t)s_test_putseq++);
+    }
+}
+
+
+// the sequence number is moved to written as if written items had already been put
+static void s_test_trace_init(uint16_t capacity, uint32_t written)
+{
+    evTraceCfg_t cfg;
+
+    cfg.ring = s_test_ring;
+    cfg.capacity = capacity;
+    cfg.timestamp = s_test_timestamp;
+    cfg.tickspersecond = 1000000;
+
+    TEST_CHECK(ev_res_OK == eventviewer_trace_init(&cfg));
+    eventviewer_trace_enable(1);
+
+    s_eventviewer_trace.written = written;
+    s_test_putseq = written;
+    s_test_copies = 0;
+    s_test_isr_at = 0;
+}
+
+
+// it dumps until there is nothing new and it checks every chunk
+static void s_test_dump_all(uint16_t buffersize, uint32_t *cursor, test_dumped_t *dumped)
+{
+    uint8_t buffer[TEST_DUMPMAX + 8];
+    evTraceDumpHeader_t header;
+    evTraceItem_t item;
+    uint32_t next = *cursor;
+    uint16_t size;
+    uint32_t i;
+
+    memset(dumped, 0, sizeof(test_dumped_t));
+
+    while(0 != (size = eventviewer_trace_dump(buffer, buffersize, cursor)))
+    {
+        TEST_CHECK(size <= buffersize);
+        memcpy(&header, buffer, sizeof(header));
+        TEST_CHECK(EVENTVIEWER_TRACE_MAGIC == header.magic);
+        TEST_CHECK(EVENTVIEWER_TRACE_VERSION == header.version);
+        TEST_CHECK(sizeof(evTraceItem_t) == header.sizeofitem);
+        TEST_CHECK(1000000 == header.tickspersecond);
+        TEST_CHECK(size == sizeof(header) + header.number * sizeof(evTraceItem_t));
+        TEST_CHECK(*cursor == header.sequence + header.number);
+
+        // never back: an item is given at most once
+        TEST_CHECK((int32_t)(header.sequence - next) >= 0);
+        if(0 == dumped->chunks)
+        {
+            dumped->first = header.sequence;
+        }
+        else
+        {
+            dumped->skipped += header.sequence - next;
+        }
+        next = header.sequence + header.number;
+
+        for(i=0; i<header.number; i++)
+        {
+            memcpy(&item, &buffer[sizeof(header) + i * sizeof(evTraceItem_t)], sizeof(item));
+            if((ev_TRACE_ID_first_usrdef != item.id) || ((uint16_t)(header.sequence + i) != item.arg))
+            {
+                dumped->broken++;
+            }
+        }
+
+        dumped->chunks++;
+        dumped->items += header.number;
+        TEST_CHECK(dumped->chunks < 1000);
+        if(dumped->chunks >= 1000)
+        {
+            break;
+        }
+    }
+}
+
+
+static uint32_t s_test_count(const char *text, const char *pattern)
+{
+    uint32_t n = 0;
+
+    while(NULL != (text = strstr(text, pattern)))
+    {
+        n++;
+        text += strlen(pattern);
+    }
+
+    return(n);
+}
+
+
+static void s_test_ring_wrap(void)
+{
+    test_dumped_t dumped;
+    uint32_t cursor = 0;
+    uint16_t perchunk;
+
+    // 40 items in a ring of 16: the last 16 are left, read in a single chunk
+    s_test_trace_init(TEST_CAPACITY, 0);
+    s_test_put(40);
+    s_test_dump_all(TEST_DUMPMAX, &cursor, &dumped);
+    TEST_CHECK(1 == dumped.chunks);
+    TEST_CHECK(TEST_CAPACITY == dumped.items);
+    TEST_CHECK(40 - TEST_CAPACITY == dumped.first);
+    TEST_CHECK(0 == dumped.broken);
+    TEST_CHECK(40 == cursor);
+
+    // nothing new, then only the new ones
+    s_test_dump_all(TEST_DUMPMAX, &cursor, &dumped);
+    TEST_CHECK(0 == dumped.chunks);
+    s_test_put(3);
+    s_test_dump_all(TEST_DUMPMAX, &cursor, &dumped);
+    TEST_CHECK(3 == dumped.items);
+    TEST_CHECK(40 == dumped.first);
+    TEST_CHECK(43 == cursor);
+
+    // a cursor which fell behind the ring restarts from the oldest item and does not repeat it
+    s_test_put(37);
+    cursor = 43;
+    s_test_dump_all(TEST_DUMPMAX, &cursor, &dumped);
+    TEST_CHECK(80 - TEST_CAPACITY == dumped.first);
+    TEST_CHECK(TEST_CAPACITY == dumped.items);
+
+    // every size of the chunk gives all the items without holes
+    for(perchunk=1; perchunk<=TEST_CAPACITY; perchunk++)
+    {
+        s_test_put(TEST_CAPACITY + perchunk);
+        cursor = 0;
+        s_test_dump_all(sizeof(evTraceDumpHeader_t) + perchunk * sizeof(evTraceItem_t), &cursor, &dumped);
+        TEST_CHECK(TEST_CAPACITY == dumped.items);
+        TEST_CHECK((TEST_CAPACITY + perchunk - 1) / perchunk == dumped.chunks);
+        TEST_CHECK(0 == dumped.skipped);
+        TEST_CHECK(0 == dumped.broken);
+        TEST_CHECK(s_test_putseq == cursor);
+    }
+}
+
+
+static void s_test_sequence_wrap(void)
+{
+    test_dumped_t dumped;
+    uint32_t cursor = 0xfffffff8;
+
+    // 20 items from the sequence 0xfffffff8: they end at 12 and the ring has the ones from 0xfffffffc
+    s_test_trace_init(TEST_CAPACITY, 0xfffffff8);
+    s_test_put(20);
+    TEST_CHECK(12 == s_eventviewer_trace.written);
+    s_test_dump_all(sizeof(evTraceDumpHeader_t) + 5 * sizeof(evTraceItem_t), &cursor, &dumped);
+    TEST_CHECK(0xfffffffc == dumped.first);
+    TEST_CHECK(TEST_CAPACITY == dumped.items);
+    TEST_CHECK(0 == dumped.skipped);
+    TEST_CHECK(0 == dumped.broken);
+    TEST_CHECK(12 == cursor);
+
+    // a ring much bigger than the items put around the wrap
+    s_test_trace_init(4 * TEST_CAPACITY, 0xfffffffe);
+    s_test_put(5);
+    cursor = 0xfffffffe;
+    s_test_dump_all(TEST_DUMPMAX, &cursor, &dumped);
+    TEST_CHECK(0xfffffffe == dumped.first);
+    TEST_CHECK(5 == dumped.items);
+    TEST_CHECK(3 == cursor);
+}
+
+
+// the isr comes during the copy of a dump of the full ring. the items it overwrites are trimmed away also when they
+// were copied before the isr came, and the ones copied after it are never given with the content of the new items.
+static void s_test_concurrent_dump(void)
+{
+    static const uint32_t israt[] = { 1, 2, 4, 9, 16 };
+    static const uint32_t isritems[] = { 1, 3, 5, 15, 16, 20, 40 };
+    test_dumped_t dumped;
+    uint32_t cursor;
+    uint32_t a;
+    uint32_t b;
+
+    for(a=0; a<sizeof(israt)/sizeof(israt[0]); a++)
+    {
+        for(b=0; b<sizeof(isritems)/sizeof(isritems[0]); b++)
+        {
+            uint32_t expectedfirst = (isritems[b] < TEST_CAPACITY) ? (isritems[b]) : (TEST_CAPACITY);
+            uint32_t lostinsidechunk;
+
+            s_test_trace_init(TEST_CAPACITY, 1000);
+            s_test_put(TEST_CAPACITY);
+            s_test_isr_at = israt[a];
+            s_test_isr_items = isritems[b];
+
+            // the first chunk: the items from 1000 on which the isr overwrote are not in it
+            cursor = 1000;
+            s_test_dump_all(TEST_DUMPMAX, &cursor, &dumped);
+            TEST_CHECK(0 == dumped.broken);
+            TEST_CHECK(s_test_putseq == cursor);
+            TEST_CHECK(TEST_CAPACITY + isritems[b] == s_test_putseq - 1000);
+
+            // the dump gives the last capacity items, or the ones not overwritten of the first chunk plus the isr ones
+            lostinsidechunk = (isritems[b] < TEST_CAPACITY) ? (isritems[b]) : (TEST_CAPACITY);
+            TEST_CHECK(dumped.items + lostinsidechunk + dumped.skipped >= TEST_CAPACITY);
+            TEST_CHECK(dumped.items <= TEST_CAPACITY + isritems[b] - lostinsidechunk);
+            TEST_CHECK(dumped.first >= 1000 + expectedfirst);
+        }
+    }
+
+    // the isr before the copy of the fifth item, with three items: the ones of 1000, 1001, 1002 had been copied but
+    // they are trimmed because the dump cannot tell. 1003 ... 1015 and then the three new ones are given.
+    s_test_trace_init(TEST_CAPACITY, 1000);
+    s_test_put(TEST_CAPACITY);
+    s_test_isr_at = 5;
+    s_test_isr_items = 3;
+    cursor = 1000;
+    s_test_dump_all(TEST_DUMPMAX, &cursor, &dumped);
+    TEST_CHECK(1003 == dumped.first);
+    TEST_CHECK(2 == dumped.chunks);
+    TEST_CHECK(TEST_CAPACITY == dumped.items);
+    TEST_CHECK(0 == dumped.skipped);
+    TEST_CHECK(0 == dumped.broken);
+}
+
+
+static void s_test_args(void)
+{
+    evTraceCfg_t cfg = { s_test_ring, 12, s_test_timestamp, 1000 };
+    uint8_t buffer[TEST_DUMPMAX];
+    uint32_t cursor = 0;
+    uint32_t before;
+
+    // the capacity must be a power of two
+    TEST_CHECK(ev_res_NOK_generic == eventviewer_trace_init(&cfg));
+    cfg.capacity = 0;
+    TEST_CHECK(ev_res_NOK_generic == eventviewer_trace_init(&cfg));
+    cfg.capacity = 8;
+    cfg.ring = NULL;
+    TEST_CHECK(ev_res_NOK_generic == eventviewer_trace_init(&cfg));
+    TEST_CHECK(ev_res_NOK_generic == eventviewer_trace_init(NULL));
+
+    // a buffer which does not hold the header and one item
+    s_test_trace_init(TEST_CAPACITY, 0);
+    s_test_put(2);
+    TEST_CHECK(0 == eventviewer_trace_dump(buffer, sizeof(evTraceDumpHeader_t) + sizeof(evTraceItem_t) - 1, &cursor));
+    TEST_CHECK(0 == eventviewer_trace_dump(NULL, sizeof(buffer), &cursor));
+    TEST_CHECK(0 == eventviewer_trace_dump(buffer, sizeof(buffer), NULL));
+    TEST_CHECK(0 == cursor);
+
+    // disabled: nothing is put, also by eventviewer_switch_to()
+    eventviewer_trace_enable(0);
+    before = s_eventviewer_trace.written;
+    s_test_put(3);
+    eventviewer_switch_to(ev_ID_first_ostask);
+    TEST_CHECK(before == s_eventviewer_trace.written);
+    eventviewer_trace_enable(1);
+    eventviewer_switch_to(ev_ID_idle);
+    TEST_CHECK(before + 1 == s_eventviewer_trace.written);
+    TEST_CHECK(ev_ID_idle == s_test_ring[before & (TEST_CAPACITY - 1)].id);
+    TEST_CHECK(ev_ID_first_ostask == s_test_ring[before & (TEST_CAPACITY - 1)].arg);
+}
+
+
+// three cycles of eight items, in chunks of four. the sequence wraps at the third item of the second chunk and the
+// time, in usec, at the ninth item. the third chunk is lost and the second one arrives twice.
+static void s_test_decoder(void)
+{
+    static const uint8_t order[] = { 5, 0, 3, 1, 1, 4 };
+    uint8_t chunks[TEST_DECODE_CHUNKS][sizeof(evTraceDumpHeader_t) + TEST_DECODE_PERCHUNK * sizeof(evTraceItem_t)];
+    uint16_t sizes[TEST_DECODE_CHUNKS];
+    decodeTrace_t trace;
+    evTraceDumpHeader_t header;
+    char *json = NULL;
+    size_t jsonsize = 0;
+    FILE *out = NULL;
+    char *line = NULL;
+    double lastts = 0;
+    uint32_t cursor = 0xfffffff9;
+    uint32_t c;
+    uint32_t i;
+
+    // the trace starts after a first switch to idle, which the dumps do not give
+    s_test_trace_init(4 * TEST_CAPACITY, cursor);
+    eventviewer_switch_to(ev_ID_idle);
+    cursor = s_eventviewer_trace.written;
+    s_test_time = 0xffffff80;
+    s_test_timestep = 16;
+
+    for(c=0; c<3; c++)
+    {
+        eventviewer_switch_to(ev_ID_first_ostask);
+        eventviewer_trace_put(ev_TRACE_ID_runner_rx_begin, (uint16_t)c);
+        eventviewer_trace_put(ev_TRACE_ID_runner_rx_end, (uint16_t)c);
+        eventviewer_switch_to(ev_ID_first_isr);
+        eventviewer_trace_put(ev_TRACE_ID_can_rx, (1 << 8) | 8);
+        eventviewer_switch_to(ev_ID_first_ostask);
+        eventviewer_trace_put(ev_TRACE_ID_eth_tx, 60);
+        eventviewer_switch_to(ev_ID_idle);
+    }
+
+    for(c=0; c<TEST_DECODE_CHUNKS; c++)
+    {
+        sizes[c] = eventviewer_trace_dump(chunks[c], sizeof(chunks[c]), &cursor);
+        TEST_CHECK(sizeof(chunks[c]) == sizes[c]);
+    }
+    TEST_CHECK(0 == eventviewer_trace_dump(chunks[0], sizeof(chunks[0]), &cursor));
+    memcpy(&header, chunks[1], sizeof(header));
+    TEST_CHECK(0xfffffffe == header.sequence);
+
+    // what is not a chunk is refused
+    memset(&trace, 0, sizeof(trace));
+    TEST_CHECK(-1 == s_decode_chunk(&trace, chunks[0], sizes[0] - 1));
+    TEST_CHECK(-1 == s_decode_chunk(&trace, chunks[0], sizeof(evTraceDumpHeader_t) - 1));
+    chunks[0][0] ^= 0xff;
+    TEST_CHECK(-1 == s_decode_chunk(&trace, chunks[0], sizes[0]));
+    chunks[0][0] ^= 0xff;
+    TEST_CHECK(0 == trace.number);
+
+    for(i=0; i<sizeof(order); i++)
+    {
+        TEST_CHECK(sizes[order[i]] == s_decode_chunk(&trace, chunks[order[i]], sizes[order[i]]));
+    }
+    TEST_CHECK(sizeof(order) * TEST_DECODE_PERCHUNK == trace.number);
+    TEST_CHECK(1000000 == trace.tickspersecond);
+
+    qsort(trace.items, trace.number, sizeof(decodeItem_t), s_compare);
+    for(i=1; i<trace.number; i++)
+    {
+        TEST_CHECK(trace.items[i].sequence >= trace.items[i-1].sequence);
+    }
+
+    out = open_memstream(&json, &jsonsize);
+    s_json_write(&trace, out);
+    fclose(out);
+
+    // one gap of the four items of the third chunk
+    TEST_CHECK(1 == s_test_count(json, "\"name\":\"lost\""));
+    TEST_CHECK(1 == s_test_count(json, "\"args\":{\"items\":4}"));
+
+    // the items given are 0-7 and 12-23 of the cycles: a slice is closed by the
+    // switches 3, 5, 7 of the first cycle, 15 of the second (13 follows the gap, which closes nothing) and 16, 19,
+    // 21, 23 of the third
+    TEST_CHECK(8 == s_test_count(json, "\"ph\":\"X\""));
+    TEST_CHECK(2 == s_test_count(json, "\"name\":\"rx\",\"ph\":\"B\""));
+    TEST_CHECK(2 == s_test_count(json, "\"name\":\"rx\",\"ph\":\"E\""));
+    TEST_CHECK(3 == s_test_count(json, "\"name\":\"can2 rx\""));
+    TEST_CHECK(3 == s_test_count(json, "\"name\":\"eth tx\""));
+    TEST_CHECK(1 == s_test_count(json, "\"name\":\"task 1\"}"));
+    TEST_CHECK(1 == s_test_count(json, "\"name\":\"isr 0\"}"));
+    TEST_CHECK(1 == s_test_count(json, "\"name\":\"idle\"}"));
+
+    // the timestamps never go back across the wrap of the 32 bits, which is at 4294967296 usec. the first item is at
+    // 0xffffff80 usec and the last one, the switch to idle which closes the last slice, 23 items later. the slices
+    // are written when they close, thus with a time before the one of the events which precede them.
+    TEST_CHECK(NULL != strstr(json, "\"name\":\"task 1\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":4294967168.000,\"dur\":48.000"));
+    TEST_CHECK(NULL != strstr(json, "\"name\":\"task 1\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":4294967504.000,\"dur\":32.000"));
+    for(line=strtok(json, "\n"); NULL != line; line=strtok(NULL, "\n"))
+    {
+        const char *ts = strstr(line, "\"ts\":");
+        if((NULL != ts) && (NULL == strstr(line, "\"ph\":\"X\"")))
+        {
+            double t = strtod(ts + 5, NULL);
+            TEST_CHECK(t >= lastts);
+            lastts = t;
+        }
+    }
+    TEST_CHECK(4294967520.0 == lastts);
+
+    free(json);
+    free(trace.items);
+    s_test_timestep = 1;
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       can-rx-bench.c
+    @brief      host benchmark of the drain of the can rx fifo of hl_can_comm.c, which is compiled as it is.
+                the fifo is filled by the rx isr CAN1_RX0_IRQHandler() with frames given by a fake CAN_Receive(), then
+                it is drained as eo_appCanSP_read() does:
+                - one: memset() of the frame + hl_can_comm_get() per frame, as before.
+                - many: hl_can_comm_get_many() in batches of EOAPPCANSP_RXBATCH_MAXFRAMES frames.
+                for each one it prints ns/frame, frames/s and the writes to the nvic per frame. the drained frames are
+                checked against the ones given to the isr, thus a wrong drain fails the run.
+                usage: can-rx-bench [-n iterations] [-c capacity of the rx fifo] [-f frames per fill]
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "hl_cfg_plus_modules.h"
+#include "hl_core.h"
+#include "hl_can.h"
+#include "hl_can_comm.h"
+
+#include "hlplus-shims.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+// as EOAPPCANSP_RXBATCH_MAXFRAMES in EOappCanServicesProvider_hid.h
+#define BENCH_BATCH_MAXFRAMES       16
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    const char              *name;
+    uint64_t                nanosecs;
+    uint64_t                frames;
+    hlplus_shims_counters_t counters;
+} can_bench_result_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_bench_fill(uint16_t frames);
+static uint16_t s_bench_drain_one(void);
+static uint16_t s_bench_drain_many(void);
+static void s_bench_check(const hl_can_comm_frame_t *frame);
+static void s_bench_run(can_bench_result_t *r, const char *name, uint16_t (*drain)(void), uint32_t iterations, uint16_t frames);
+static void s_bench_print(const can_bench_result_t *r);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+// the sequence number of the next frame given by CAN_Receive() and of the next frame expected from the drain
+static uint32_t s_bench_rxseq = 0;
+static uint32_t s_bench_drainseq = 0;
+static uint32_t s_bench_errors = 0;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = 20000;
+    uint16_t capacity = 128;
+    uint16_t frames = 120;
+    can_bench_result_t one;
+    can_bench_result_t many;
+    int i;
+
+    for(i=1; i<argc; i++)
+    {
+        if((0 == strcmp(argv[i], "-n")) && (i+1 < argc))
+        {
+            iterations = (uint32_t)atoi(argv[++i]);
+        }
+        else if((0 == strcmp(argv[i], "-c")) && (i+1 < argc))
+        {
+            capacity = (uint16_t)atoi(argv[++i]);
+        }
+        else if((0 == strcmp(argv[i], "-f")) && (i+1 < argc))
+        {
+            frames = (uint16_t)atoi(argv[++i]);
+        }
+        else
+        {
+            printf("usage: can-rx-bench [-n iterations] [-c capacity of the rx fifo] [-f frames per fill]\n");
+            return(EXIT_FAILURE);
+        }
+    }
+
+    if((0 == capacity) || (frames > capacity))
+    {
+        printf("can-rx-bench: the frames per fill must be at most the capacity of the rx fifo\n");
+        return(EXIT_FAILURE);
+    }
+
+    // CAN1_RX0_IRQHandler() reads the status of the hw fifo from the registers of CAN1
+    hlplus_shims_peripherals_map(CAN1_BASE, sizeof(CAN_TypeDef));
+
+    hl_can_comm_cfg_t cfg =
+    {
+        .capacityofrxfifoofframes   = 0,
+        .priorityrx                 = hl_irqpriority06,
+        .callback_on_rx             = NULL,
+        .arg_cb_rx                  = NULL,
+        .capacityoftxfifoofframes   = 0,
+        .prioritytx                 = hl_irqpriority06,
+        .callback_on_tx             = NULL,
+        .arg_cb_tx                  = NULL,
+        .priorityerr                = hl_irqpriorityNONE,
+        .callback_on_err            = NULL,
+        .arg_cb_err                 = NULL
+    };
+
+    // the capacity can be more than the 255 of hl_can_comm_cfg_t
+    if(hl_res_OK != hl_can_comm_init_large(hl_can1, &cfg, capacity, 4))
+    {
+        printf("can-rx-bench: hl_can_comm_init_large() failed\n");
+        return(EXIT_FAILURE);
+    }
+
+    printf("can-rx-bench: %u iterations, %u frames in a rx fifo of %u, batches of %u\n",
+           (unsigned)iterations, (unsigned)frames, (unsigned)capacity, (unsigned)BENCH_BATCH_MAXFRAMES);
+
+    s_bench_run(&one, "one", s_bench_drain_one, iterations, frames);
+    s_bench_run(&many, "many", s_bench_drain_many, iterations, frames);
+
+    s_bench_print(&one);
+    s_bench_print(&many);
+
+    if((0 != s_bench_errors) || (one.frames != many.frames))
+    {
+        printf("can-rx-bench: %u frames drained wrongly\n", (unsigned)s_bench_errors);
+        return(EXIT_FAILURE);
+    }
+
+    printf("can-rx-bench: many is %.2fx one\n", (0 != many.nanosecs) ? ((double)one.nanosecs / (double)many.nanosecs) : 0.0);
+
+    return(EXIT_SUCCESS);
+}
+
+
+// the parts of hl_can and of the stm32 library used by hl_can_comm.c
+
+extern hl_boolval_t hl_can_initted_is(hl_can_t id)
+{
+    return(hl_true);
+}
+
+
+extern void CAN_Receive(CAN_TypeDef* CANx, uint8_t FIFONumber, CanRxMsg* RxMessage)
+{
+    memset(RxMessage, 0, sizeof(CanRxMsg));
+    RxMessage->StdId = s_bench_rxseq & 0x7ff;
+    RxMessage->IDE = CAN_Id_Standard;
+    RxMessage->DLC = 8;
+    memcpy(RxMessage->Data, &s_bench_rxseq, sizeof(s_bench_rxseq));
+    s_bench_rxseq++;
+}
+
+
+extern uint8_t CAN_Transmit(CAN_TypeDef* CANx, CanTxMsg* TxMessage)
+{
+    return(CAN_TxStatus_NoMailBox);
+}
+
+
+extern void CAN_ITConfig(CAN_TypeDef* CANx, uint32_t CAN_IT, FunctionalState NewState)
+{
+}
+
+
+extern void CAN_ClearITPendingBit(CAN_TypeDef* CANx, uint32_t CAN_IT)
+{
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_bench_fill(uint16_t frames)
+{
+    uint16_t i;
+
+    for(i=0; i<frames; i++)
+    {
+        CAN1_RX0_IRQHandler();
+    }
+}
+
+
+// as eo_appCanSP_read() did before: the frame is cleared and then one frame is got per critical section
+static uint16_t s_bench_drain_one(void)
+{
+    hl_can_comm_frame_t frame;
+    uint16_t n = 0;
+
+    for(;;)
+    {
+        memset(&frame, 0, sizeof(frame));
+        if(hl_res_OK != hl_can_comm_get(hl_can1, &frame, NULL))
+        {
+            break;
+        }
+        s_bench_check(&frame);
+        n++;
+    }
+
+    return(n);
+}
+
+
+static uint16_t s_bench_drain_many(void)
+{
+    static hl_can_comm_frame_t batch[BENCH_BATCH_MAXFRAMES];
+    uint16_t n = 0;
+    uint8_t read = 0;
+    uint8_t i;
+
+    for(;;)
+    {
+        read = 0;
+        if(hl_res_OK != hl_can_comm_get_many(hl_can1, batch, BENCH_BATCH_MAXFRAMES, &read))
+        {
+            break;
+        }
+        for(i=0; i<read; i++)
+        {
+            s_bench_check(&batch[i]);
+        }
+        n += read;
+        if(read < BENCH_BATCH_MAXFRAMES)
+        {   // the fifo is empty
+            break;
+        }
+    }
+
+    return(n);
+}
+
+
+static void s_bench_check(const hl_can_comm_frame_t *frame)
+{
+    uint32_t seq = 0;
+
+    memcpy(&seq, frame->data, sizeof(seq));
+    if((seq != s_bench_drainseq) || ((seq & 0x7ff) != frame->id) || (8 != frame->size))
+    {
+        s_bench_errors++;
+    }
+    s_bench_drainseq = seq + 1;
+}
+
+
+static void s_bench_run(can_bench_result_t *r, const char *name, uint16_t (*drain)(void), uint32_t iterations, uint16_t frames)
+{
+    hlplus_shims_counters_t counters;
+    uint64_t start = 0;
+    uint32_t i;
+    uint16_t n;
+
+    memset(r, 0, sizeof(can_bench_result_t));
+    r->name = name;
+
+    for(i=0; i<iterations; i++)
+    {
+        s_bench_fill(frames);
+
+        hlplus_shims_counters_Reset();
+        start = hlplus_shims_nanotime();
+        n = drain();
+        r->nanosecs += hlplus_shims_nanotime() - start;
+
+        r->frames += n;
+        hlplus_shims_counters_Get(&counters);
+        r->counters.irqnenables += counters.irqnenables;
+        r->counters.irqndisables += counters.irqndisables;
+
+        if(n != frames)
+        {
+            s_bench_errors++;
+        }
+    }
+}
+
+
+static void s_bench_print(const can_bench_result_t *r)
+{
+    double frames = (0 != r->frames) ? (double)r->frames : 1.0;
+
+    printf("%-6s %8.1f ns/frame %12.0f frames/s %6.3f nvic writes/frame\n", r->name,
+           (double)r->nanosecs / frames,
+           (0 != r->nanosecs) ? (1e9 * frames / (double)r->nanosecs) : 0.0,
+           (double)(r->counters.irqnenables + r->counters.irqndisables) / frames);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#define _GNU_SOURCE
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "sys/mman.h"
+#include "hl_cfg_plus_modules.h"
+#include "hl_core.h"
+#include "hl_gpio.h"
+#include "hl_ethtrans.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of extern public interface
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "hl-eth-rx-fake.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define HL_ETH_RX_FAKE_LOWMEM       (8*1024*1024)
+#define HL_ETH_RX_FAKE_MAXFRAMES    64
+// hl_eth_frame_t has 4 bytes before the payload and the higher layer gives frames of up to 1520 bytes, the size of
+// the spares asked by hl_eth_rx_refill()
+#define HL_ETH_RX_FAKE_SPARESIZE    1520
+#define HL_ETH_RX_FAKE_FRAMESIZE    (4 + HL_ETH_RX_FAKE_SPARESIZE)
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of extern variables
+// --------------------------------------------------------------------------------------------------------------------
+
+// the eth of the stm32f4 is not mapped to gpio: the test never calls the init of the rmii
+const hl_eth_mapping_t* hl_eth_map = NULL;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint8_t *s_fake_lowmem = NULL;
+static uint32_t s_fake_lowmemused = 0;
+
+static uint8_t *s_fake_frames = NULL;
+static uint32_t s_fake_numframes = 0;
+static uint8_t s_fake_used[HL_ETH_RX_FAKE_MAXFRAMES] = { 0 };
+static uint32_t s_fake_available = 0;
+
+static hl_eth_frame_t *s_fake_received[HL_ETH_RX_FAKE_MAXFRAMES] = { NULL };
+static uint32_t s_fake_receivedput = 0;
+static uint32_t s_fake_receivedget = 0;
+
+static hl_eth_rx_fake_counters_t s_fake_counters = { 0 };
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+extern void * hl_eth_rx_fake_lowmem_new(uint32_t size)
+{
+    void *p = NULL;
+
+    if(NULL == s_fake_lowmem)
+    {
+        s_fake_lowmem = mmap(NULL, HL_ETH_RX_FAKE_LOWMEM, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+        if((MAP_FAILED == (void*)s_fake_lowmem) || ((uintptr_t)s_fake_lowmem + HL_ETH_RX_FAKE_LOWMEM > 0xffffffffu))
+        {
+            fprintf(stderr, "hl-eth-rx-fake: cannot map memory in the low 4 GB\n");
+            abort();
+        }
+    }
+
+    // word aligned, as the dma wants
+    size = (size + 7) & ~7u;
+    if(s_fake_lowmemused + size > HL_ETH_RX_FAKE_LOWMEM)
+    {
+        fprintf(stderr, "hl-eth-rx-fake: out of low memory\n");
+        abort();
+    }
+
+    p = &s_fake_lowmem[s_fake_lowmemused];
+    s_fake_lowmemused += size;
+    return(p);
+}
+
+
+extern void hl_eth_rx_fake_init(uint32_t frames)
+{
+    if(frames > HL_ETH_RX_FAKE_MAXFRAMES)
+    {
+        frames = HL_ETH_RX_FAKE_MAXFRAMES;
+    }
+
+    s_fake_frames = hl_eth_rx_fake_lowmem_new(frames * HL_ETH_RX_FAKE_FRAMESIZE);
+    s_fake_numframes = frames;
+    s_fake_available = frames;
+    memset(s_fake_used, 0, sizeof(s_fake_used));
+    s_fake_receivedput = s_fake_receivedget = 0;
+    memset(&s_fake_counters, 0, sizeof(s_fake_counters));
+}
+
+
+extern void hl_eth_rx_fake_pool_limit(uint32_t available)
+{
+    s_fake_available = available;
+}
+
+
+extern hl_eth_frame_t * hl_eth_rx_fake_received_get(void)
+{
+    if(s_fake_receivedget == s_fake_receivedput)
+    {
+        return(NULL);
+    }
+
+    return(s_fake_received[s_fake_receivedget++ % HL_ETH_RX_FAKE_MAXFRAMES]);
+}
+
+
+extern void hl_eth_rx_fake_frame_delete(hl_eth_frame_t *frame)
+{
+    uint32_t i = ((uint8_t*)frame - s_fake_frames) / HL_ETH_RX_FAKE_FRAMESIZE;
+
+    if((i >= s_fake_numframes) || (0 == s_fake_used[i]))
+    {
+        fprintf(stderr, "hl-eth-rx-fake: delete of a frame not in use\n");
+        abort();
+    }
+
+    s_fake_used[i] = 0;
+    s_fake_available++;
+    s_fake_counters.deletes++;
+}
+
+
+extern hl_bool_t hl_eth_rx_fake_frame_is(const void *p)
+{
+    const uint8_t *b = p;
+    uint32_t offset;
+
+    if((b < s_fake_frames) || (b >= s_fake_frames + s_fake_numframes * HL_ETH_RX_FAKE_FRAMESIZE))
+    {
+        return(hl_false);
+    }
+
+    offset = (uint32_t)(b - s_fake_frames) % HL_ETH_RX_FAKE_FRAMESIZE;
+    return((4 == offset) ? (hl_true) : (hl_false));
+}
+
+
+extern uint32_t hl_eth_rx_fake_pool_used(void)
+{
+    uint32_t i;
+    uint32_t n = 0;
+
+    for(i=0; i<s_fake_numframes; i++)
+    {
+        n += s_fake_used[i];
+    }
+
+    return(n);
+}
+
+
+extern void hl_eth_rx_fake_counters_Get(hl_eth_rx_fake_counters_t *counters)
+{
+    *counters = s_fake_counters;
+}
+
+
+// the higher layer of hl_eth.c: they replace the weak ones
+
+// as alloc_mem() of tcpnet: the flag 0x80000000 in len only avoids the error of the stack when out of memory
+extern hl_eth_frame_t* hl_eth_frame_new(uint32_t len)
+{
+    uint32_t i;
+
+    len &= 0xffff;
+
+    if((len > HL_ETH_RX_FAKE_SPARESIZE) || (0 == s_fake_available))
+    {
+        s_fake_counters.newsfailed++;
+        if(len < HL_ETH_RX_FAKE_SPARESIZE)
+        {
+            s_fake_counters.newsfailedisr++;
+        }
+        return(NULL);
+    }
+
+    for(i=0; i<s_fake_numframes; i++)
+    {
+        if(0 == s_fake_used[i])
+        {
+            hl_eth_frame_t *frame = (hl_eth_frame_t*)&s_fake_frames[i * HL_ETH_RX_FAKE_FRAMESIZE];
+            s_fake_used[i] = 1;
+            s_fake_available--;
+            s_fake_counters.news++;
+            frame->length = len;
+            frame->index = 0;
+            return(frame);
+        }
+    }
+
+    s_fake_counters.newsfailed++;
+    if(len < HL_ETH_RX_FAKE_SPARESIZE)
+    {
+        s_fake_counters.newsfailedisr++;
+    }
+    return(NULL);
+}
+
+
+extern void hl_eth_on_frame_received(hl_eth_frame_t* frame)
+{
+    s_fake_received[s_fake_receivedput++ % HL_ETH_RX_FAKE_MAXFRAMES] = frame;
+    s_fake_counters.received++;
+}
+
+
+extern void hl_eth_alert(void)
+{
+    s_fake_counters.alerts++;
+}
+
+
+// the parts of hl and of the stm32 library used only by hl_eth_init(), which the test does not call
+
+extern hl_result_t hl_ethtrans_init(const hl_ethtrans_cfg_t *cfg)
+{
+    return(hl_res_NOK_generic);
+}
+
+
+extern hl_result_t hl_ethtrans_start(hl_ethtrans_phymode_t *usedmiiphymode)
+{
+    return(hl_res_NOK_generic);
+}
+
+
+extern hl_result_t hl_gpio_init(hl_gpio_init_t* init)
+{
+    return(hl_res_NOK_generic);
+}
+
+
+extern hl_result_t hl_gpio_altf(hl_gpio_altf_t* altf)
+{
+    return(hl_res_NOK_generic);
+}
+
+
+extern hl_result_t hl_gpio_fill_init(hl_gpio_init_t* init, const hl_gpio_map_t* gpiomap)
+{
+    return(hl_res_NOK_generic);
+}
+
+
+extern hl_result_t hl_gpio_fill_altf(hl_gpio_altf_t* altf, const hl_gpio_map_t* gpiomap)
+{
+    return(hl_res_NOK_generic);
+}
+
+
+extern void RCC_AHB1PeriphClockCmd(uint32_t RCC_AHB1Periph, FunctionalState NewState)
+{
+}
+
+
+extern void RCC_AHB1PeriphResetCmd(uint32_t RCC_AHB1Periph, FunctionalState NewState)
+{
+}
+
+
+extern void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState)
+{
+}
+
+
+extern void SYSCFG_ETH_MediaInterfaceConfig(uint32_t SYSCFG_ETH_MediaInterface)
+{
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// - include guard ----------------------------------------------------------------------------------------------------
+#ifndef _HL_ETH_RX_FAKE_H_
+#define _HL_ETH_RX_FAKE_H_
+
+
+/** @file       hl-eth-rx-fake.h
+    @brief      This header file gives the fake higher layer used by the host test of the zero-copy reception of
+                hl_eth.c: a pool of ip-stack frames in the low 4 GB (the rx descriptors keep 32-bit addresses), the
+                queue where the ETH isr puts the received frames and the parts of hl and of the stm32 library which
+                hl_eth.c needs to link.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+
+// - external dependencies --------------------------------------------------------------------------------------------
+
+#include "stdint.h"
+#include "hl_common.h"
+#include "hl_eth.h"
+
+
+// - declaration of public user-defined types -------------------------------------------------------------------------
+
+typedef struct
+{
+    uint32_t    news;           /**< the frames given by hl_eth_frame_new() */
+    uint32_t    newsfailed;     /**< the calls of hl_eth_frame_new() with the pool empty */
+    uint32_t    newsfailedisr;  /**< of them, the ones for a frame shorter than the spares: from the copy in the isr */
+    uint32_t    deletes;
+    uint32_t    received;       /**< the calls of hl_eth_on_frame_received() */
+    uint32_t    alerts;         /**< the calls of hl_eth_alert() */
+} hl_eth_rx_fake_counters_t;
+
+
+// - declaration of extern public functions ---------------------------------------------------------------------------
+
+/** @fn         extern void * hl_eth_rx_fake_lowmem_new(uint32_t size)
+    @brief      Gets zeroed memory whose address fits in 32 bits, as the rx descriptors and the buffers of the dma.
+ **/
+extern void * hl_eth_rx_fake_lowmem_new(uint32_t size);
+
+
+/** @fn         extern void hl_eth_rx_fake_init(uint32_t frames)
+    @brief      Empties the queue of the received frames, resets the counters and makes a pool of @e frames frames.
+ **/
+extern void hl_eth_rx_fake_init(uint32_t frames);
+
+
+/** @fn         extern void hl_eth_rx_fake_pool_limit(uint32_t available)
+    @brief      Lets hl_eth_frame_new() give at most @e available more frames, to emulate a higher layer out of memory.
+ **/
+extern void hl_eth_rx_fake_pool_limit(uint32_t available);
+
+
+/** @fn         extern hl_eth_frame_t * hl_eth_rx_fake_received_get(void)
+    @brief      Gets the oldest frame given by the isr to hl_eth_on_frame_received(), or NULL.
+ **/
+extern hl_eth_frame_t * hl_eth_rx_fake_received_get(void);
+
+
+/** @fn         extern void hl_eth_rx_fake_frame_delete(hl_eth_frame_t *frame)
+    @brief      Gives a frame back to the pool, as the ip stack does after it has processed it.
+ **/
+extern void hl_eth_rx_fake_frame_delete(hl_eth_frame_t *frame);
+
+
+/** @fn         extern hl_bool_t hl_eth_rx_fake_frame_is(const void *p)
+    @brief      Tells whether @e p is the payload of a frame of the pool.
+ **/
+extern hl_bool_t hl_eth_rx_fake_frame_is(const void *p);
+
+
+extern uint32_t hl_eth_rx_fake_pool_used(void);
+
+extern void hl_eth_rx_fake_counters_Get(hl_eth_rx_fake_counters_t *counters);
+
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
+
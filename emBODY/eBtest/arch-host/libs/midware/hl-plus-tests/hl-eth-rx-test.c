@@ -0,0 +1,502 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       hl-eth-rx-test.c
+    @brief      host test of the zero-copy reception of hl_eth.c over a simulated ring of rx descriptors. hl_eth.c is
+                included as it is, so that the test uses its isr, hl_eth_rx_refill() and its static functions. a
+                simulated dma writes numbered frames in the buffers of the descriptors which it owns, as the mac of the
+                stm32f4 does, and the isr gives them to the fake higher layer of hl-eth-rx-fake.c. it checks that:
+                - without hl_eth_rx_refill() every frame is copied and the descriptors keep the rx buffers of hl_eth.
+                - with it, after the first pass of the ring every frame is given up without copy.
+                - with random bursts, refills, frames kept by the higher layer and a higher layer out of memory, the
+                  frames arrive in order and intact, none is lost but the ones the higher layer has no memory for,
+                  and no frame of the pool is ever in two places or leaked.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "hl_cfg_plus_modules.h"
+#include "hl_core.h"
+
+#include "hlplus-shims.h"
+#include "hl-eth-rx-fake.h"
+
+// the barriers of the cortex-m4 and the weak of armcc for gcc on the host. they must be defined after hl_core.h,
+// which declares the cmsis versions, and before hl_eth.c, which uses them
+#define __DMB()     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DSB()     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __ISB()     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __weak      __attribute__((weak))
+
+#include "hl_eth.c"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)        s_test_check((cond), #cond, __LINE__)
+
+#define TEST_POOLFRAMES         40
+#define TEST_MAXKEPT            8
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    uint32_t    written;        /**< the frames written by the simulated dma */
+    uint32_t    overruns;       /**< the frames lost because the dma found no descriptor of its own */
+    uint32_t    delivered;      /**< the frames which arrived to the higher layer */
+    uint32_t    zerocopy;       /**< of them, the ones in the same buffer where the dma wrote them */
+    uint32_t    nextseq;        /**< the lowest sequence number which can still arrive */
+} test_stats_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static uint32_t s_test_rand(void);
+
+static hl_eth_internal_item_t * s_test_eth_init(uint8_t capacity);
+static hl_bool_t s_test_dma_write(hl_eth_internal_item_t *intitem, uint32_t len);
+static void s_test_isr(void);
+static void s_test_higherlayer_process(test_stats_t *stats, uint32_t keep);
+static void s_test_invariants(hl_eth_internal_item_t *intitem);
+
+static void s_test_copy_only(void);
+static void s_test_zero_copy(void);
+static void s_test_refill_ring(void);
+static void s_test_random(uint8_t capacity);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+static uint32_t s_test_seed = 1;
+
+// the simulated dma
+static uint32_t s_test_dmaindex = 0;
+static uint32_t s_test_dmaseq = 0;
+// where the dma has written each frame, by sequence number
+static uint32_t s_test_dmaaddr[256] = { 0 };
+
+// the frames which the higher layer has not yet processed
+static hl_eth_frame_t *s_test_kept[TEST_MAXKEPT] = { NULL };
+static uint32_t s_test_numkept = 0;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    // the isr reads and writes the status of the dma
+    hlplus_shims_peripherals_map(ETH_MAC_BASE, sizeof(ETH_TypeDef));
+    // the isr signals with warnings the frames the higher layer has no memory for: the test counts them
+    hlplus_shims_errors_abort(hl_false);
+
+    s_test_copy_only();
+    s_test_zero_copy();
+    s_test_refill_ring();
+    s_test_random(4);
+    s_test_random(7);
+
+    if(0 != s_test_failures)
+    {
+        printf("hl-eth-rx-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("hl-eth-rx-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        if(s_test_failures < 20)
+        {
+            printf("hl-eth-rx-test: line %d: %s failed\n", line, str);
+        }
+        s_test_failures++;
+    }
+}
+
+
+static uint32_t s_test_rand(void)
+{
+    s_test_seed ^= s_test_seed << 13;
+    s_test_seed ^= s_test_seed >> 17;
+    s_test_seed ^= s_test_seed << 5;
+    return(s_test_seed);
+}
+
+
+// as hl_eth_init() does for the rx side, but with memory in the low 4 GB because the descriptors keep 32-bit addresses
+static hl_eth_internal_item_t * s_test_eth_init(uint8_t capacity)
+{
+    hl_eth_internal_item_t *intitem = hl_eth_rx_fake_lowmem_new(sizeof(hl_eth_internal_item_t));
+
+    hl_eth_rx_fake_init(TEST_POOLFRAMES);
+
+    intitem->config.capacityofrxfifoofframes = capacity;
+    intitem->config.capacityoftxfifoofframes = 1;
+    intitem->rx_buffers = (hl_eth_array_of_buffers_t) hl_eth_rx_fake_lowmem_new(ETH_BUF_SIZE * capacity);
+    intitem->rx_desc = (hl_rx_desc_t*) hl_eth_rx_fake_lowmem_new(sizeof(hl_rx_desc_t) * capacity);
+    intitem->rxframes = (hl_eth_frame_t**) hl_eth_rx_fake_lowmem_new(sizeof(hl_eth_frame_t*) * capacity);
+    intitem->rxspares = (hl_eth_frame_t**) hl_eth_rx_fake_lowmem_new(sizeof(hl_eth_frame_t*) * (capacity+1));
+    intitem->rxsparesput = 0;
+    intitem->rxsparesget = 0;
+
+    s_hl_eth_theinternals.items[0] = intitem;
+    s_hl_eth_rx_descr_init();
+    s_hl_eth_initted_set();
+
+    s_test_dmaindex = 0;
+    s_test_dmaseq = 0;
+    s_test_numkept = 0;
+
+    return(intitem);
+}
+
+
+// the dma writes a frame of len bytes plus the crc in the buffer of the next descriptor, if it owns it
+static hl_bool_t s_test_dma_write(hl_eth_internal_item_t *intitem, uint32_t len)
+{
+    hl_rx_desc_t *desc = &intitem->rx_desc[s_test_dmaindex];
+    uint8_t *buffer = (uint8_t*)(uintptr_t)desc->Addr;
+    uint32_t k;
+
+    if(0 == (desc->Stat & DMA_RX_OWN))
+    {   // the dma suspends until the cpu gives back the descriptor
+        ETH->DMASR |= INT_RBUIE;
+        return(hl_false);
+    }
+
+    // the buffer must hold the frame and the crc
+    TEST_CHECK((desc->Ctrl & 0x1fff) >= len + 4);
+
+    memcpy(buffer, &s_test_dmaseq, sizeof(s_test_dmaseq));
+    for(k=sizeof(s_test_dmaseq); k<len+4; k++)
+    {
+        buffer[k] = (uint8_t)(s_test_dmaseq + k);
+    }
+    s_test_dmaaddr[s_test_dmaseq % 256] = desc->Addr;
+    s_test_dmaseq++;
+
+    desc->Stat = ((len + 4) << 16) | DMA_RX_FS | DMA_RX_LS;
+    ETH->DMASR |= INT_RIE;
+
+    s_test_dmaindex = ((uintptr_t)desc->Next - (uintptr_t)intitem->rx_desc) / sizeof(hl_rx_desc_t);
+    return(hl_true);
+}
+
+
+static void s_test_isr(void)
+{
+    ETH_IRQHandler();
+    // the isr clears the flags of ETH->DMASR by writing 1 to them, which on the host sets them instead
+    ETH->DMASR = 0;
+}
+
+
+// the ip stack takes the frames given by the isr, checks them and releases all of them but the last keep ones
+static void s_test_higherlayer_process(test_stats_t *stats, uint32_t keep)
+{
+    hl_eth_frame_t *frame = NULL;
+
+    while(NULL != (frame = hl_eth_rx_fake_received_get()))
+    {
+        uint32_t seq = 0;
+        uint32_t k;
+        uint8_t ok = 1;
+
+        memcpy(&seq, frame->datafirstbyte, sizeof(seq));
+        // in order: some may be missing only if the higher layer had no memory for them
+        TEST_CHECK(seq >= stats->nextseq);
+        TEST_CHECK(seq < s_test_dmaseq);
+        stats->nextseq = seq + 1;
+
+        TEST_CHECK((frame->length >= 60) && (frame->length <= ETH_MTU));
+        for(k=sizeof(seq); k<frame->length; k++)
+        {
+            if(frame->datafirstbyte[k] != (uint8_t)(seq + k))
+            {
+                ok = 0;
+            }
+        }
+        TEST_CHECK(1 == ok);
+
+        stats->delivered++;
+        if((uint32_t)(uintptr_t)frame->datafirstbyte == s_test_dmaaddr[seq % 256])
+        {
+            stats->zerocopy++;
+        }
+
+        if(s_test_numkept < TEST_MAXKEPT)
+        {
+            s_test_kept[s_test_numkept++] = frame;
+        }
+        else
+        {
+            hl_eth_rx_fake_frame_delete(frame);
+        }
+    }
+
+    while(s_test_numkept > keep)
+    {
+        hl_eth_rx_fake_frame_delete(s_test_kept[--s_test_numkept]);
+    }
+}
+
+
+// every descriptor is either on its rx buffer or on a frame of the pool, and every frame of the pool in use is in
+// exactly one place: a descriptor, the ring of spares or the higher layer
+static void s_test_invariants(hl_eth_internal_item_t *intitem)
+{
+    hl_eth_frame_t *places[64];
+    uint32_t n = 0;
+    uint32_t i;
+    uint32_t j;
+    uint8_t get;
+
+    for(i=0; i<intitem->config.capacityofrxfifoofframes; i++)
+    {
+        if(NULL == intitem->rxframes[i])
+        {
+            TEST_CHECK(intitem->rx_desc[i].Addr == (uint32_t)(uintptr_t)&intitem->rx_buffers[i]);
+            TEST_CHECK((DMA_RX_RCH | ETH_BUF_SIZE) == intitem->rx_desc[i].Ctrl);
+        }
+        else
+        {
+            TEST_CHECK(intitem->rx_desc[i].Addr == (uint32_t)(uintptr_t)intitem->rxframes[i]->datafirstbyte);
+            TEST_CHECK(hl_true == hl_eth_rx_fake_frame_is(intitem->rxframes[i]->datafirstbyte));
+            places[n++] = intitem->rxframes[i];
+        }
+    }
+
+    for(get=intitem->rxsparesget; get!=intitem->rxsparesput; get=(get+1) % (intitem->config.capacityofrxfifoofframes+1))
+    {
+        places[n++] = intitem->rxspares[get];
+    }
+
+    for(i=0; i<s_test_numkept; i++)
+    {
+        places[n++] = s_test_kept[i];
+    }
+
+    for(i=0; i<n; i++)
+    {
+        for(j=i+1; j<n; j++)
+        {
+            TEST_CHECK(places[i] != places[j]);
+        }
+    }
+
+    TEST_CHECK(n == hl_eth_rx_fake_pool_used());
+}
+
+
+static void s_test_copy_only(void)
+{
+    hl_eth_internal_item_t *intitem = s_test_eth_init(4);
+    test_stats_t stats = { 0 };
+    uint32_t round;
+    uint32_t k;
+
+    for(round=0; round<50; round++)
+    {
+        for(k=0; k<3; k++)
+        {
+            stats.written += s_test_dma_write(intitem, 60 + (s_test_rand() % (ETH_MTU - 60 + 1)));
+        }
+        s_test_isr();
+        s_test_higherlayer_process(&stats, 0);
+        s_test_invariants(intitem);
+    }
+
+    TEST_CHECK(150 == stats.written);
+    TEST_CHECK(stats.written == stats.delivered);
+    TEST_CHECK(0 == stats.zerocopy);
+    TEST_CHECK(NULL == intitem->rxframes[0]);
+    TEST_CHECK(0 == hl_eth_rx_fake_pool_used());
+}
+
+
+static void s_test_zero_copy(void)
+{
+    hl_eth_internal_item_t *intitem = s_test_eth_init(4);
+    test_stats_t stats = { 0 };
+    hlplus_shims_counters_t counters;
+    uint32_t round;
+    uint32_t k;
+
+    hlplus_shims_counters_Reset();
+
+    for(round=0; round<50; round++)
+    {
+        TEST_CHECK(hl_res_OK == hl_eth_rx_refill());
+        s_test_invariants(intitem);
+        for(k=0; k<4; k++)
+        {
+            stats.written += s_test_dma_write(intitem, ETH_MTU - k);
+        }
+        s_test_isr();
+        s_test_higherlayer_process(&stats, 0);
+        s_test_invariants(intitem);
+    }
+
+    hlplus_shims_counters_Get(&counters);
+    TEST_CHECK(200 == stats.written);
+    TEST_CHECK(stats.written == stats.delivered);
+    // the first pass of the ring is on the rx buffers, then every frame is exchanged with a spare
+    TEST_CHECK(stats.zerocopy == stats.written - 4);
+    TEST_CHECK(0 == counters.errors);
+
+    // idle: the descriptors and the ring of spares keep a frame each
+    TEST_CHECK(hl_res_OK == hl_eth_rx_refill());
+    TEST_CHECK(4 + 4 == hl_eth_rx_fake_pool_used());
+}
+
+
+static void s_test_refill_ring(void)
+{
+    hl_eth_internal_item_t *intitem = s_test_eth_init(5);
+    test_stats_t stats = { 0 };
+    hl_eth_rx_fake_counters_t counters;
+
+    // the ring of spares has capacity+1 slots and is full with capacity frames
+    TEST_CHECK(hl_res_OK == hl_eth_rx_refill());
+    TEST_CHECK(5 == hl_eth_rx_fake_pool_used());
+    TEST_CHECK(hl_res_OK == hl_eth_rx_refill());
+    TEST_CHECK(5 == hl_eth_rx_fake_pool_used());
+    s_test_invariants(intitem);
+
+    // the isr takes one spare per descriptor it moves to the frames of the higher layer
+    s_test_dma_write(intitem, 100);
+    s_test_isr();
+    TEST_CHECK(NULL != intitem->rxframes[0]);
+    TEST_CHECK(NULL == intitem->rxframes[1]);
+    s_test_higherlayer_process(&stats, 0);
+
+    // with the higher layer out of memory the refill stops and says it
+    hl_eth_rx_fake_pool_limit(0);
+    TEST_CHECK(hl_res_NOK_nodata == hl_eth_rx_refill());
+    hl_eth_rx_fake_counters_Get(&counters);
+    TEST_CHECK(1 == counters.newsfailed);
+    s_test_invariants(intitem);
+
+    // not before the init
+    s_hl_eth_theinternals.eth_initted = hl_false;
+    TEST_CHECK(hl_res_NOK_generic == hl_eth_rx_refill());
+    s_hl_eth_theinternals.eth_initted = hl_true;
+}
+
+
+static void s_test_random(uint8_t capacity)
+{
+    hl_eth_internal_item_t *intitem = s_test_eth_init(capacity);
+    test_stats_t stats = { 0 };
+    hl_eth_rx_fake_counters_t counters;
+    uint32_t step;
+
+    s_test_seed = 0x2545f491u ^ capacity;
+
+    for(step=0; step<20000; step++)
+    {
+        uint32_t k;
+        uint32_t burst = 1 + s_test_rand() % (capacity + 2);
+
+        switch(s_test_rand() % 16)
+        {
+            case 0:
+            {   // the higher layer gets out of memory for a while
+                hl_eth_rx_fake_pool_limit(s_test_rand() % 3);
+            } break;
+
+            case 1:
+            case 2:
+            case 3:
+            {
+                hl_eth_rx_fake_pool_limit(TEST_POOLFRAMES);
+            } break;
+
+            default:
+            {
+                hl_eth_rx_refill();
+            } break;
+        }
+        s_test_invariants(intitem);
+
+        for(k=0; k<burst; k++)
+        {
+            if(hl_true == s_test_dma_write(intitem, 60 + (s_test_rand() % (ETH_MTU - 60 + 1))))
+            {
+                stats.written++;
+            }
+            else
+            {
+                stats.overruns++;
+            }
+        }
+
+        s_test_isr();
+        s_test_higherlayer_process(&stats, s_test_rand() % TEST_MAXKEPT);
+        s_test_invariants(intitem);
+    }
+
+    s_test_higherlayer_process(&stats, 0);
+    hl_eth_rx_fake_counters_Get(&counters);
+
+    // every frame written by the dma arrives but the ones the isr had to copy and the higher layer had no memory for
+    TEST_CHECK(stats.written == stats.delivered + counters.newsfailedisr);
+    TEST_CHECK(stats.zerocopy > 0);
+    TEST_CHECK(stats.zerocopy < stats.delivered);
+    TEST_CHECK(stats.overruns > 0);
+
+    printf("hl-eth-rx-test: %u descriptors: %u frames, %u without copy, %u dropped for no memory, %u overruns\n",
+           (unsigned)capacity, (unsigned)stats.written, (unsigned)stats.zerocopy, (unsigned)counters.newsfailedisr,
+           (unsigned)stats.overruns);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       hl-fifo-bench.c
+    @brief      host benchmark of hl_fifo.c. for each item size it moves bursts of items through a fifo whose index
+                wraps inside every burst, in three ways:
+                - single: hl_fifo_put() and hl_fifo_get() per item (the sized ones for 1, 2, 4, 8, 16 bytes).
+                - many: hl_fifo_put_many() and hl_fifo_get_many() per burst.
+                - pow2 vs not: the same with a capacity which is not a power of two, whose wrap is a compare.
+                it prints ns/item. the items which come out are checked, thus a wrong fifo fails the run.
+                usage: hl-fifo-bench [-n iterations] [-b items per burst]
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "hl_cfg_plus_modules.h"
+#include "hl_core.h"
+#include "hl_fifo.h"
+
+#include "hlplus-shims.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define BENCH_MAXBURST          512
+#define BENCH_MAXITEMSIZE       22
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+typedef hl_result_t (*bench_fn_put_t)(hl_fifo_t*, uint8_t*);
+typedef hl_result_t (*bench_fn_get_t)(hl_fifo_t*, uint8_t*, uint8_t*);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static double s_bench_single(hl_fifo_t *fifo, bench_fn_put_t put, bench_fn_get_t get, uint32_t iterations, uint16_t burst);
+static double s_bench_many(hl_fifo_t *fifo, uint32_t iterations, uint16_t burst);
+static void s_bench_prepare(uint8_t sizeofitem, uint16_t burst);
+static void s_bench_verify(uint8_t sizeofitem, uint16_t burst);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint8_t s_bench_in[BENCH_MAXBURST * BENCH_MAXITEMSIZE];
+static uint8_t s_bench_out[BENCH_MAXBURST * BENCH_MAXITEMSIZE];
+
+static uint32_t s_bench_errors = 0;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    static const uint8_t sizes[] = { 1, 2, 4, 8, 16, BENCH_MAXITEMSIZE };
+    static const bench_fn_put_t puts[] = { hl_fifo_put01, hl_fifo_put02, hl_fifo_put04, hl_fifo_put08, hl_fifo_put16, hl_fifo_put };
+    static const bench_fn_get_t gets[] = { hl_fifo_get01, hl_fifo_get02, hl_fifo_get04, hl_fifo_get08, hl_fifo_get16, hl_fifo_get };
+    uint32_t iterations = 20000;
+    uint16_t burst = 100;
+    uint32_t s;
+    int i;
+
+    for(i=1; i<argc; i++)
+    {
+        if((0 == strcmp(argv[i], "-n")) && (i+1 < argc))
+        {
+            iterations = (uint32_t)atoi(argv[++i]);
+        }
+        else if((0 == strcmp(argv[i], "-b")) && (i+1 < argc))
+        {
+            burst = (uint16_t)atoi(argv[++i]);
+        }
+        else
+        {
+            printf("usage: hl-fifo-bench [-n iterations] [-b items per burst]\n");
+            return(EXIT_FAILURE);
+        }
+    }
+
+    if((0 == burst) || (burst > BENCH_MAXBURST))
+    {
+        printf("hl-fifo-bench: the items per burst must be in [1, %d]\n", BENCH_MAXBURST);
+        return(EXIT_FAILURE);
+    }
+
+    printf("hl-fifo-bench: %u iterations, bursts of %u items, capacity %u (pow2) and %u\n",
+           (unsigned)iterations, (unsigned)burst, 2u*BENCH_MAXBURST, 2u*BENCH_MAXBURST-1);
+    printf("%5s %14s %14s %14s %14s\n", "size", "single pow2", "many pow2", "single", "many");
+
+    for(s=0; s<sizeof(sizes); s++)
+    {
+        // the capacity is not a multiple of the burst, thus the wrap falls at a different item of each burst
+        hl_fifo_t *pow2 = hl_fifo_new_large(2*BENCH_MAXBURST, sizes[s], NULL);
+        hl_fifo_t *notpow2 = hl_fifo_new_large(2*BENCH_MAXBURST-1, sizes[s], NULL);
+        double r[4];
+
+        s_bench_prepare(sizes[s], burst);
+
+        r[0] = s_bench_single(pow2, puts[s], gets[s], iterations, burst);
+        s_bench_verify(sizes[s], burst);
+        r[1] = s_bench_many(pow2, iterations, burst);
+        s_bench_verify(sizes[s], burst);
+        r[2] = s_bench_single(notpow2, puts[s], gets[s], iterations, burst);
+        s_bench_verify(sizes[s], burst);
+        r[3] = s_bench_many(notpow2, iterations, burst);
+        s_bench_verify(sizes[s], burst);
+
+        printf("%5u %11.2f ns %11.2f ns %11.2f ns %11.2f ns\n", (unsigned)sizes[s], r[0], r[1], r[2], r[3]);
+
+        hl_fifo_delete(pow2);
+        hl_fifo_delete(notpow2);
+    }
+
+    if(0 != s_bench_errors)
+    {
+        printf("hl-fifo-bench: %u bursts came out wrongly\n", (unsigned)s_bench_errors);
+        return(EXIT_FAILURE);
+    }
+
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static double s_bench_single(hl_fifo_t *fifo, bench_fn_put_t put, bench_fn_get_t get, uint32_t iterations, uint16_t burst)
+{
+    uint8_t size = fifo->sizeofitem;
+    uint64_t start = hlplus_shims_nanotime();
+    uint32_t i;
+    uint16_t k;
+
+    for(i=0; i<iterations; i++)
+    {
+        for(k=0; k<burst; k++)
+        {
+            put(fifo, &s_bench_in[k * size]);
+        }
+        for(k=0; k<burst; k++)
+        {
+            get(fifo, &s_bench_out[k * size], NULL);
+        }
+    }
+
+    return((double)(hlplus_shims_nanotime() - start) / ((double)iterations * burst));
+}
+
+
+static double s_bench_many(hl_fifo_t *fifo, uint32_t iterations, uint16_t burst)
+{
+    uint64_t start = hlplus_shims_nanotime();
+    uint32_t i;
+    uint16_t n;
+
+    for(i=0; i<iterations; i++)
+    {
+        hl_fifo_put_many(fifo, s_bench_in, burst, &n);
+        hl_fifo_get_many(fifo, s_bench_out, burst, &n);
+    }
+
+    return((double)(hlplus_shims_nanotime() - start) / ((double)iterations * burst));
+}
+
+
+static void s_bench_prepare(uint8_t sizeofitem, uint16_t burst)
+{
+    uint32_t i;
+
+    for(i=0; i<(uint32_t)burst*sizeofitem; i++)
+    {
+        s_bench_in[i] = (uint8_t)(i * 7 + sizeofitem);
+    }
+}
+
+
+static void s_bench_verify(uint8_t sizeofitem, uint16_t burst)
+{
+    if(0 != memcmp(s_bench_in, s_bench_out, (uint32_t)burst * sizeofitem))
+    {
+        s_bench_errors++;
+    }
+    memset(s_bench_out, 0, sizeof(s_bench_out));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
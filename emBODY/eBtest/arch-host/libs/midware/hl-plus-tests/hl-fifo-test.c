@@ -0,0 +1,515 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       hl-fifo-test.c
+    @brief      host unit tests of hl_fifo.c. it checks that:
+                - random sequences of put, get, front/pop, put_many and get_many give the same items, sizes and
+                  return values as a reference queue, for capacities which are and are not a power of two and for the
+                  item sizes with a fast copy (1, 2, 4, 8, 16) and without it.
+                - put_many and get_many split the copy at the wrap for every position of the wrap.
+                - the sized functions (put16, get16, front16, ...) agree with the generic ones.
+                - a fifo of 65535 items (the max with the 16-bit indices) fills, wraps and drains, and the sizes of the
+                  uint8_t functions saturate at 255.
+                - hl_fifo_new() takes its memory from hl_sys_heap_new() and the null arguments are rejected.
+                - hl_fifo_t keeps the 16 bytes it had with the 8-bit indices, so that the prebuilt libraries which
+                  give its memory to hl_fifo_init() still work.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "hl_cfg_plus_modules.h"
+#include "hl_core.h"
+#include "hl_fifo.h"
+
+#include "hlplus-shims.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)        s_test_check((cond), #cond, __LINE__)
+
+#define TEST_MAXITEMSIZE        22
+#define TEST_MAXCAPACITY        65535
+#define TEST_RANDOMOPS          20000
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+// the reference queue: a ring of items with 32-bit positions which never wrap in a run
+typedef struct
+{
+    uint8_t     *items;
+    uint32_t    capacity;
+    uint32_t    sizeofitem;
+    uint32_t    first;
+    uint32_t    size;
+} test_model_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static uint32_t s_test_rand(void);
+static void s_test_fill(uint8_t *data, uint32_t bytes);
+
+static void s_test_model_init(test_model_t *m, uint32_t capacity, uint32_t sizeofitem);
+static void s_test_model_put(test_model_t *m, const uint8_t *data, uint32_t number);
+static const uint8_t * s_test_model_at(test_model_t *m, uint32_t i);
+
+static void s_test_random(uint16_t capacity, uint8_t sizeofitem);
+static void s_test_wrap(uint16_t capacity, uint8_t sizeofitem);
+static void s_test_sized(void);
+static void s_test_maxcapacity(void);
+static void s_test_heap_and_args(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static uint32_t s_test_seed = 1;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    static const uint16_t capacities[] = { 1, 2, 3, 4, 7, 16, 100, 128, 300, 512, 1000 };
+    static const uint8_t sizes[] = { 1, 2, 3, 4, 8, 16, TEST_MAXITEMSIZE };
+    uint32_t c;
+    uint32_t s;
+
+    for(c=0; c<sizeof(capacities)/sizeof(capacities[0]); c++)
+    {
+        for(s=0; s<sizeof(sizes); s++)
+        {
+            s_test_random(capacities[c], sizes[s]);
+            s_test_wrap(capacities[c], sizes[s]);
+        }
+    }
+
+    s_test_sized();
+    s_test_maxcapacity();
+    s_test_heap_and_args();
+
+    if(0 != s_test_failures)
+    {
+        printf("hl-fifo-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("hl-fifo-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        // a broken fifo fails the same check many times: print only the first ones
+        if(s_test_failures < 20)
+        {
+            printf("hl-fifo-test: line %d: %s failed\n", line, str);
+        }
+        s_test_failures++;
+    }
+}
+
+
+// a xorshift, so that the runs are the same on every host
+static uint32_t s_test_rand(void)
+{
+    s_test_seed ^= s_test_seed << 13;
+    s_test_seed ^= s_test_seed >> 17;
+    s_test_seed ^= s_test_seed << 5;
+    return(s_test_seed);
+}
+
+
+static void s_test_fill(uint8_t *data, uint32_t bytes)
+{
+    uint32_t i;
+
+    for(i=0; i<bytes; i++)
+    {
+        data[i] = (uint8_t)s_test_rand();
+    }
+}
+
+
+static void s_test_model_init(test_model_t *m, uint32_t capacity, uint32_t sizeofitem)
+{
+    m->items = calloc(capacity, sizeofitem);
+    m->capacity = capacity;
+    m->sizeofitem = sizeofitem;
+    m->first = 0;
+    m->size = 0;
+}
+
+
+static void s_test_model_put(test_model_t *m, const uint8_t *data, uint32_t number)
+{
+    uint32_t i;
+
+    for(i=0; i<number; i++)
+    {
+        uint32_t pos = (m->first + m->size) % m->capacity;
+        memcpy(&m->items[pos * m->sizeofitem], &data[i * m->sizeofitem], m->sizeofitem);
+        m->size++;
+    }
+}
+
+
+static const uint8_t * s_test_model_at(test_model_t *m, uint32_t i)
+{
+    return(&m->items[((m->first + i) % m->capacity) * m->sizeofitem]);
+}
+
+
+static void s_test_random(uint16_t capacity, uint8_t sizeofitem)
+{
+    static uint8_t in[(TEST_MAXCAPACITY+3) * 2];
+    static uint8_t out[(TEST_MAXCAPACITY+3) * 2];
+    test_model_t model;
+    hl_fifo_t *fifo = hl_fifo_new_large(capacity, sizeofitem, NULL);
+    uint32_t op;
+    uint32_t i;
+
+    TEST_CHECK(NULL != fifo);
+    if(NULL == fifo)
+    {
+        return;
+    }
+
+    s_test_seed = 0x9e3779b9u ^ ((uint32_t)capacity << 8) ^ sizeofitem;
+    s_test_model_init(&model, capacity, sizeofitem);
+
+    for(op=0; op<TEST_RANDOMOPS; op++)
+    {
+        // up to a bit more than the capacity, so that the fifo gets full and empty
+        uint16_t k = (uint16_t)(s_test_rand() % (capacity + 3u));
+        uint16_t n = 0xffff;
+        uint8_t remaining = 0xff;
+        hl_result_t res;
+
+        if(k * sizeofitem > sizeof(in))
+        {
+            k = sizeof(in) / sizeofitem;
+        }
+
+        switch(s_test_rand() % 5)
+        {
+            case 0:
+            {
+                uint32_t expected = ((uint32_t)k < capacity - model.size) ? (k) : (capacity - model.size);
+                s_test_fill(in, (uint32_t)k * sizeofitem);
+                res = hl_fifo_put_many(fifo, in, k, &n);
+                TEST_CHECK(n == expected);
+                TEST_CHECK(res == (((0 == expected) && (0 != k)) ? (hl_res_NOK_generic) : (hl_res_OK)));
+                s_test_model_put(&model, in, n);
+            } break;
+
+            case 1:
+            {
+                uint32_t expected = ((uint32_t)k < model.size) ? (k) : (model.size);
+                res = hl_fifo_get_many(fifo, out, k, &n);
+                TEST_CHECK(n == expected);
+                TEST_CHECK(res == ((0 == model.size) ? (hl_res_NOK_nodata) : (hl_res_OK)));
+                for(i=0; i<n; i++)
+                {
+                    TEST_CHECK(0 == memcmp(&out[i * sizeofitem], s_test_model_at(&model, i), sizeofitem));
+                }
+                model.first = (model.first + n) % capacity;
+                model.size -= n;
+            } break;
+
+            case 2:
+            {
+                s_test_fill(in, sizeofitem);
+                res = hl_fifo_put(fifo, in);
+                TEST_CHECK(res == ((model.size == capacity) ? (hl_res_NOK_generic) : (hl_res_OK)));
+                if(hl_res_OK == res)
+                {
+                    s_test_model_put(&model, in, 1);
+                }
+            } break;
+
+            case 3:
+            {
+                res = hl_fifo_get(fifo, out, &remaining);
+                TEST_CHECK(res == ((0 == model.size) ? (hl_res_NOK_nodata) : (hl_res_OK)));
+                if(hl_res_OK == res)
+                {
+                    TEST_CHECK(0 == memcmp(out, s_test_model_at(&model, 0), sizeofitem));
+                    model.first = (model.first + 1) % capacity;
+                    model.size--;
+                }
+                TEST_CHECK(remaining == ((model.size > 255) ? (255) : (model.size)));
+            } break;
+
+            default:
+            {
+                uint8_t *front = hl_fifo_front(fifo);
+                TEST_CHECK((NULL == front) == (0 == model.size));
+                if(NULL != front)
+                {
+                    TEST_CHECK(0 == memcmp(front, s_test_model_at(&model, 0), sizeofitem));
+                    hl_fifo_pop(fifo);
+                    model.first = (model.first + 1) % capacity;
+                    model.size--;
+                }
+            } break;
+        }
+
+        TEST_CHECK(hl_fifo_size_large(fifo) == model.size);
+        TEST_CHECK(hl_fifo_full(fifo) == ((model.size == capacity) ? (hl_true) : (hl_false)));
+    }
+
+    free(model.items);
+    hl_fifo_delete(fifo);
+}
+
+
+// for every position of the first item, the fifo is filled with put_many() up to the capacity and drained with
+// get_many(): the two copies of each must put the items in the right order whatever the split.
+static void s_test_wrap(uint16_t capacity, uint8_t sizeofitem)
+{
+    static uint8_t in[1000 * TEST_MAXITEMSIZE];
+    static uint8_t out[1000 * TEST_MAXITEMSIZE];
+    hl_fifo_t *fifo = hl_fifo_new_large(capacity, sizeofitem, NULL);
+    uint32_t bytes = (uint32_t)capacity * sizeofitem;
+    uint16_t offset;
+    uint16_t n = 0;
+
+    if((NULL == fifo) || (bytes > sizeof(in)))
+    {
+        TEST_CHECK(NULL != fifo);
+        hl_fifo_delete(fifo);
+        return;
+    }
+
+    for(offset=0; offset<capacity; offset++)
+    {
+        hl_fifo_reset(fifo);
+        // move the index to offset
+        hl_fifo_put_many(fifo, in, offset, &n);
+        hl_fifo_get_many(fifo, out, offset, &n);
+        TEST_CHECK(0 == hl_fifo_size(fifo));
+
+        s_test_fill(in, bytes);
+        TEST_CHECK(hl_res_OK == hl_fifo_put_many(fifo, in, capacity, &n));
+        TEST_CHECK(n == capacity);
+        TEST_CHECK(hl_true == hl_fifo_full(fifo));
+        TEST_CHECK(NULL == hl_fifo_end(fifo));
+        TEST_CHECK(hl_res_NOK_generic == hl_fifo_put_many(fifo, in, 1, &n));
+        TEST_CHECK(0 == n);
+
+        memset(out, 0, bytes);
+        TEST_CHECK(hl_res_OK == hl_fifo_get_many(fifo, out, capacity + 1, &n));
+        TEST_CHECK(n == capacity);
+        TEST_CHECK(0 == memcmp(in, out, bytes));
+        TEST_CHECK(0 == hl_fifo_size(fifo));
+        TEST_CHECK(hl_res_NOK_nodata == hl_fifo_get_many(fifo, out, 1, &n));
+        TEST_CHECK(0 == n);
+    }
+
+    hl_fifo_delete(fifo);
+}
+
+
+// the functions for a specific item size are used by hl_can_comm.c (size 16) and by the others: they must share the
+// state with the generic ones
+static void s_test_sized(void)
+{
+    static const uint8_t sizes[] = { 1, 2, 4, 8, 16 };
+    hl_result_t (*put[])(hl_fifo_t*, uint8_t*) = { hl_fifo_put01, hl_fifo_put02, hl_fifo_put04, hl_fifo_put08, hl_fifo_put16 };
+    hl_result_t (*get[])(hl_fifo_t*, uint8_t*, uint8_t*) = { hl_fifo_get01, hl_fifo_get02, hl_fifo_get04, hl_fifo_get08, hl_fifo_get16 };
+    uint8_t * (*front[])(hl_fifo_t*) = { hl_fifo_front01, hl_fifo_front02, hl_fifo_front04, hl_fifo_front08, hl_fifo_front16 };
+    uint64_t in[2*7];
+    uint64_t out[2*7];
+    uint64_t item[2];
+    uint32_t s;
+    uint32_t round;
+    uint16_t i;
+    uint16_t n;
+    uint8_t remaining;
+
+    for(s=0; s<sizeof(sizes); s++)
+    {
+        uint8_t size = sizes[s];
+        hl_fifo_t *fifo = hl_fifo_new(7, size, NULL);
+
+        for(round=0; round<20; round++)
+        {
+            // five items with the sized put and two with put_many, which wrap at some point
+            s_test_fill((uint8_t*)in, sizeof(in));
+            for(i=0; i<5; i++)
+            {
+                TEST_CHECK(hl_res_OK == put[s](fifo, &((uint8_t*)in)[i * size]));
+            }
+            TEST_CHECK(hl_res_OK == hl_fifo_put_many(fifo, &((uint8_t*)in)[5 * size], 2, &n));
+            TEST_CHECK(hl_res_NOK_generic == put[s](fifo, (uint8_t*)in));
+            TEST_CHECK(7 == hl_fifo_size(fifo));
+
+            // two out with get_many, then front and the sized get
+            TEST_CHECK(hl_res_OK == hl_fifo_get_many(fifo, (uint8_t*)out, 2, &n));
+            TEST_CHECK(0 == memcmp(in, out, 2 * size));
+            for(i=2; i<7; i++)
+            {
+                TEST_CHECK(0 == memcmp(front[s](fifo), &((uint8_t*)in)[i * size], size));
+                TEST_CHECK(hl_res_OK == get[s](fifo, (uint8_t*)item, &remaining));
+                TEST_CHECK(0 == memcmp(item, &((uint8_t*)in)[i * size], size));
+                TEST_CHECK(remaining == 6 - i);
+            }
+            TEST_CHECK(NULL == front[s](fifo));
+            TEST_CHECK(hl_res_NOK_nodata == get[s](fifo, (uint8_t*)item, &remaining));
+
+            // leave one item inside so that the next round starts from another position
+            TEST_CHECK(hl_res_OK == put[s](fifo, (uint8_t*)in));
+            TEST_CHECK(hl_res_OK == hl_fifo_get(fifo, (uint8_t*)item, NULL));
+        }
+
+        hl_fifo_delete(fifo);
+    }
+}
+
+
+static void s_test_maxcapacity(void)
+{
+    static uint8_t in[TEST_MAXCAPACITY];
+    static uint8_t out[TEST_MAXCAPACITY];
+    hl_fifo_t *fifo = hl_fifo_new_large(TEST_MAXCAPACITY, 1, NULL);
+    uint32_t round;
+    uint16_t n = 0;
+
+    TEST_CHECK(NULL != fifo);
+    if(NULL == fifo)
+    {
+        return;
+    }
+
+    for(round=0; round<4; round++)
+    {
+        // 40000 items each round: the index wraps from the second round on
+        s_test_fill(in, 40000);
+        TEST_CHECK(hl_res_OK == hl_fifo_put_many(fifo, in, 40000, &n));
+        TEST_CHECK(40000 == n);
+        TEST_CHECK(40000 == hl_fifo_size_large(fifo));
+        TEST_CHECK(255 == hl_fifo_size(fifo));
+        TEST_CHECK(hl_res_OK == hl_fifo_get_many(fifo, out, TEST_MAXCAPACITY, &n));
+        TEST_CHECK(40000 == n);
+        TEST_CHECK(0 == memcmp(in, out, 40000));
+    }
+
+    s_test_fill(in, TEST_MAXCAPACITY);
+    TEST_CHECK(hl_res_OK == hl_fifo_put_many(fifo, in, TEST_MAXCAPACITY, &n));
+    TEST_CHECK(TEST_MAXCAPACITY == hl_fifo_size_large(fifo));
+    TEST_CHECK(hl_true == hl_fifo_full(fifo));
+    for(n=0; n<TEST_MAXCAPACITY; n++)
+    {
+        uint8_t item = 0;
+        uint8_t remaining = 0;
+        uint16_t left = TEST_MAXCAPACITY - n - 1;
+        if((hl_res_OK != hl_fifo_get(fifo, &item, &remaining)) || (item != in[n]) || (remaining != ((left > 255) ? (255) : (left))))
+        {
+            break;
+        }
+    }
+    TEST_CHECK(TEST_MAXCAPACITY == n);
+
+    hl_fifo_delete(fifo);
+}
+
+
+static void s_test_heap_and_args(void)
+{
+    hlplus_shims_counters_t counters;
+    hl_fifo_t fifo;
+    uint8_t data[4 * 3];
+    uint8_t initval[3] = { 0xa5, 0x5a, 0x11 };
+    uint8_t item[3];
+    hl_fifo_t *f = NULL;
+    uint16_t n = 0;
+
+    hlplus_shims_counters_Reset();
+    f = hl_fifo_new(10, 3, initval);
+    hlplus_shims_counters_Get(&counters);
+    TEST_CHECK(NULL != f);
+    TEST_CHECK(2 == counters.heapnews);
+    TEST_CHECK(sizeof(hl_fifo_t) + 10 * 3 == counters.heapbytes);
+    TEST_CHECK(0 == memcmp(&f->data[9 * 3], initval, 3));
+    hl_fifo_delete(f);
+
+    TEST_CHECK(NULL == hl_fifo_new(0, 3, NULL));
+    TEST_CHECK(NULL == hl_fifo_new(10, 0, NULL));
+
+    TEST_CHECK(hl_res_NOK_generic == hl_fifo_init(&fifo, 4, 3, NULL, NULL));
+    TEST_CHECK(hl_res_OK == hl_fifo_init(&fifo, 4, 3, data, NULL));
+    TEST_CHECK(1 == fifo.pow2);
+    TEST_CHECK(hl_res_OK == hl_fifo_init(&fifo, 3, 4, data, NULL));
+    TEST_CHECK(0 == fifo.pow2);
+    TEST_CHECK(hl_res_OK == hl_fifo_init(&fifo, 4, 3, data, NULL));
+    TEST_CHECK(hl_res_NOK_generic == hl_fifo_put_many(NULL, data, 1, &n));
+    TEST_CHECK(hl_res_NOK_generic == hl_fifo_put_many(&fifo, NULL, 1, &n));
+    TEST_CHECK(hl_res_NOK_generic == hl_fifo_get_many(&fifo, NULL, 1, &n));
+    TEST_CHECK(hl_res_NOK_generic == hl_fifo_get(&fifo, NULL, NULL));
+
+    // with data NULL the put only reserves the item, which is then written through hl_fifo_end()
+    TEST_CHECK(NULL != hl_fifo_end(&fifo));
+    memcpy(hl_fifo_end(&fifo), initval, 3);
+    TEST_CHECK(hl_res_OK == hl_fifo_put(&fifo, NULL));
+    TEST_CHECK(hl_res_OK == hl_fifo_put_many(&fifo, data, 0, &n));
+    TEST_CHECK(0 == n);
+    TEST_CHECK(hl_res_OK == hl_fifo_get(&fifo, item, NULL));
+    TEST_CHECK(0 == memcmp(item, initval, 3));
+
+    hl_fifo_clear(&fifo);
+    TEST_CHECK(0 == hl_fifo_size(&fifo));
+    TEST_CHECK(0 == data[0]);
+
+    // the 16 bytes of the cortex-m: eight of indices, sizes and flags plus the data and itemcopy pointers
+    TEST_CHECK(8 + 2 * sizeof(void*) == sizeof(hl_fifo_t));
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
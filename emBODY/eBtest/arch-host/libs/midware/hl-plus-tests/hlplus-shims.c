@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#define _GNU_SOURCE
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "time.h"
+#include "sys/mman.h"
+#include "hl_common.h"
+#include "hl_sys.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of extern public interface
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "hlplus-shims.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define HLPLUS_SHIMS_PAGE       4096
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static hlplus_shims_counters_t s_hlplus_counters = { 0 };
+
+static hl_bool_t s_hlplus_errors_abort = hl_true;
+
+// the ISER and ICER registers of the nvic of the cortex-m4: the hl_sys_irqn_*() write them as NVIC_EnableIRQ() and
+// NVIC_DisableIRQ() do, so that the cost of the critical sections is the cost of a store to a device register
+static volatile uint32_t s_hlplus_nvic_iser[8] = { 0 };
+static volatile uint32_t s_hlplus_nvic_icer[8] = { 0 };
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+extern void hlplus_shims_peripherals_map(uint32_t address, uint32_t size)
+{
+    uintptr_t first = address & ~(uintptr_t)(HLPLUS_SHIMS_PAGE-1);
+    size_t length = ((address + size - first) + HLPLUS_SHIMS_PAGE - 1) & ~(size_t)(HLPLUS_SHIMS_PAGE-1);
+    void *p = mmap((void*)first, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if((MAP_FAILED == p) || ((void*)first != p))
+    {
+        fprintf(stderr, "hlplus-shims: cannot map the peripheral at 0x%08x\n", (unsigned)address);
+        abort();
+    }
+}
+
+
+extern void hlplus_shims_errors_abort(hl_bool_t abort)
+{
+    s_hlplus_errors_abort = abort;
+}
+
+
+extern uint64_t hlplus_shims_nanotime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return((uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+
+extern void hlplus_shims_counters_Get(hlplus_shims_counters_t *counters)
+{
+    *counters = s_hlplus_counters;
+}
+
+
+extern void hlplus_shims_counters_Reset(void)
+{
+    memset(&s_hlplus_counters, 0, sizeof(s_hlplus_counters));
+}
+
+
+// the functions of hl_sys used by the utilities of hl-plus
+
+extern void* hl_sys_heap_new(uint32_t size)
+{
+    s_hlplus_counters.heapnews++;
+    s_hlplus_counters.heapbytes += size;
+    return(calloc(size, 1));
+}
+
+
+extern void hl_sys_heap_delete(void* p)
+{
+    free(p);
+}
+
+
+extern void hl_sys_irqn_disable(hl_irqn_t irqn)
+{
+    s_hlplus_counters.irqndisables++;
+    s_hlplus_nvic_icer[((uint32_t)irqn >> 5) & 7] = (1UL << ((uint32_t)irqn & 0x1F));
+}
+
+
+extern void hl_sys_irqn_enable(hl_irqn_t irqn)
+{
+    s_hlplus_counters.irqnenables++;
+    s_hlplus_nvic_iser[((uint32_t)irqn >> 5) & 7] = (1UL << ((uint32_t)irqn & 0x1F));
+}
+
+
+extern void hl_sys_irqn_priority_set(hl_irqn_t irqn, hl_irqpriority_t prio)
+{
+}
+
+
+extern void hl_sys_on_warning(const char * warningmsg)
+{
+    fprintf(stderr, "hlplus-shims: warning: %s\n", (NULL != warningmsg) ? warningmsg : "");
+}
+
+
+extern void hl_sys_on_error(hl_errorcode_t errorcode, const char * errormsg)
+{
+    s_hlplus_counters.errors++;
+
+    if(hl_true == s_hlplus_errors_abort)
+    {
+        fprintf(stderr, "hlplus-shims: error %d: %s\n", (int)errorcode, (NULL != errormsg) ? errormsg : "");
+        abort();
+    }
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
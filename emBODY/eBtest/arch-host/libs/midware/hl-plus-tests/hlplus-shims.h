@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// - include guard ----------------------------------------------------------------------------------------------------
+#ifndef _HLPLUS_SHIMS_H_
+#define _HLPLUS_SHIMS_H_
+
+
+/** @file       hlplus-shims.h
+    @brief      This header file gives the host replacement of hl_sys (heap, nvic and errors) used to run the utilities
+                of hl-plus on linux, plus the counters the tests and the benchmarks read.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+
+// - external dependencies --------------------------------------------------------------------------------------------
+
+#include "stdint.h"
+#include "hl_common.h"
+
+
+// - declaration of public user-defined types -------------------------------------------------------------------------
+
+typedef struct
+{
+    uint64_t    heapnews;       /**< the calls of hl_sys_heap_new() */
+    uint64_t    heapbytes;
+    uint64_t    irqnenables;    /**< the calls of hl_sys_irqn_enable() */
+    uint64_t    irqndisables;   /**< the calls of hl_sys_irqn_disable() */
+    uint64_t    errors;         /**< the calls of hl_sys_on_error() when it is told not to abort */
+} hlplus_shims_counters_t;
+
+
+// - declaration of extern public functions ---------------------------------------------------------------------------
+
+/** @fn         extern void hlplus_shims_peripherals_map(uint32_t address, uint32_t size)
+    @brief      Maps zeroed host memory at the @e address of a peripheral of the stm32, so that the code of hl which
+                reads or writes its registers can run. It aborts if the range cannot be mapped.
+ **/
+extern void hlplus_shims_peripherals_map(uint32_t address, uint32_t size);
+
+
+/** @fn         extern void hlplus_shims_errors_abort(hl_bool_t abort)
+    @brief      Tells whether hl_sys_on_error() aborts (the default) or it only counts the error.
+ **/
+extern void hlplus_shims_errors_abort(hl_bool_t abort);
+
+
+/** @fn         extern uint64_t hlplus_shims_nanotime(void)
+    @brief      Gets the CLOCK_MONOTONIC in nanoseconds.
+ **/
+extern uint64_t hlplus_shims_nanotime(void);
+
+
+extern void hlplus_shims_counters_Get(hlplus_shims_counters_t *counters);
+
+extern void hlplus_shims_counters_Reset(void);
+
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+
+// - include guard ----------------------------------------------------------------------------------------------------
+
+#ifndef _HL_CFG_PLUS_MODULES_H_
+#define _HL_CFG_PLUS_MODULES_H_
+
+// - doxy begin -------------------------------------------------------------------------------------------------------
+
+/** @file       hl_cfg_plus_modules.h
+    @brief      This header file keeps which plus modules to build in the host tests of the hl library. the mpu is the
+                stm32f407 of the ems4rd and of the mc4plus, so that the structs and the registers have their layout.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// - external dependencies --------------------------------------------------------------------------------------------
+
+#include "hl_common.h"
+
+
+// - public #define  --------------------------------------------------------------------------------------------------
+
+#define HL_USE_MPU_ARCH_STM32F4
+#define HL_USE_MPU_NAME_STM32F407IG
+
+// mdk5 adds it when it builds for the stm32f407
+#define STM32F40_41xxx
+
+#define HL_USE_UTIL_BITS
+#define HL_USE_UTIL_FIFO
+#define HL_USE_UTIL_CAN_COMM
+
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
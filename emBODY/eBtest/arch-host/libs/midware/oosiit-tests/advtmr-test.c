@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+/* @file       advtmr-test.c
+    @brief      host test of the hashed timer wheel of the advanced timers of oosiit (rt_iit_AdvTimer.c), which is run
+                tick by tick against a reference model. it checks that:
+                - 1000 timers, one-shot and periodic, with random stops and restarts, fire over 200000 ticks exactly
+                  at their expiry tick and never after they are stopped.
+                - the deferred callbacks are executed only by the timer task, not later than the next call of
+                  rt_iit_advtmr_deferred_process(), and that the task receives its event flags.
+                - the absolute timers follow a change of the time done with rt_iit_advtmr_synchronise().
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+// --------------------------------------------------------------------------------------------------------------------
+// - external dependencies
+// --------------------------------------------------------------------------------------------------------------------
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "oosiit.h"
+#include "rt_TypeDef.h"
+#include "rt_task.h"
+#include "RTX_Config.h"
+#include "rt_System.h"
+#include "rt_iit_changes.h"
+#include "rt_iit_AdvTimer.h"
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - #define with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+#define TEST_CHECK(cond)        s_test_check((cond), #cond, __LINE__)
+
+#define TEST_TIMERS             1000
+#define TEST_TICKS              200000
+// the timer task runs the deferred callbacks every TEST_DEFERREDPERIOD ticks
+#define TEST_DEFERREDPERIOD     3
+// one timer is stopped (and maybe restarted) every TEST_STOPPERIOD ticks
+#define TEST_STOPPERIOD         97
+
+#define TEST_DEFERREDFLAGS      0x00000001
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - typedef with internal scope
+// --------------------------------------------------------------------------------------------------------------------
+
+// the model of a timer: the tick of its next expiry (0 if it is not active) and its period (0 if it is one-shot)
+typedef struct
+{
+    OS_ID       timer;
+    uint64_t    next;
+    uint32_t    period;
+    uint8_t     deferred;
+    uint32_t    fired;
+} advtmr_model_t;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - declaration of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line);
+static void s_test_start(advtmr_model_t *m, uint32_t firstshot, uint32_t period);
+static void s_test_on_expiry(void *tmr, void *par);
+static void s_test_on_absolute(void *tmr, void *par);
+
+static void s_test_model(void);
+static void s_test_absolute(void);
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of extern variables
+// --------------------------------------------------------------------------------------------------------------------
+
+// the ones of oosiit_storage.c and of oosiit.c used by rt_iit_AdvTimer.c
+volatile uint64_t oosiit_time = 0;
+uint32_t *oosiit_cfg_advtmr_ptrs = NULL;
+uint32_t *oosiit_cfg_advtmr = NULL;
+uint16_t oosiit_cfg_advtmr_size = 0;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition (and initialisation) of static variables
+// --------------------------------------------------------------------------------------------------------------------
+
+static uint32_t s_test_failures = 0;
+
+static advtmr_model_t s_test_models[TEST_TIMERS];
+
+// 1 while the scheduler runs rt_iit_advtmr_tick()
+static uint8_t s_test_inscheduler = 0;
+
+static uint32_t s_test_firedinscheduler = 0;
+static uint32_t s_test_firedintask = 0;
+static uint32_t s_test_evtsets = 0;
+
+static int s_test_task = 1;
+
+static uint64_t s_test_absfired[8] = {0};
+static uint8_t s_test_absnumber = 0;
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of extern public functions
+// --------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    rt_iit_advtmr_init();
+
+    s_test_model();
+    s_test_absolute();
+
+    if(0 != s_test_failures)
+    {
+        printf("advtmr-test: %d failures\n", (int)s_test_failures);
+        return(EXIT_FAILURE);
+    }
+
+    printf("advtmr-test: ok\n");
+    return(EXIT_SUCCESS);
+}
+
+
+// the parts of rtx and of oosiit used by rt_iit_AdvTimer.c. the timers are allocated with rt_iit_memory_new()
+// because oosiit_cfg_advtmr_size is zero
+
+extern void* rt_alloc_box(void *box_mem)
+{
+    return(NULL);
+}
+
+
+extern U32 rt_free_box(void *box_mem, void *box)
+{
+    return(0);
+}
+
+
+extern int _init_box(void *box_mem, U32 box_size, U32 blk_size)
+{
+    return(0);
+}
+
+
+extern void* rt_iit_memory_new(uint32_t size)
+{
+    return(calloc(1, size));
+}
+
+
+extern void rt_iit_memory_del(void *mem)
+{
+    free(mem);
+}
+
+
+extern void* oosiit_ext_calloc(uint32_t s, uint32_t n)
+{
+    return(calloc(s, n));
+}
+
+
+extern void oosiit_ext_free(void *m)
+{
+    free(m);
+}
+
+
+extern void iitchanged_isr_evt_set(EVENT_t flags, OS_TPTR task)
+{
+    if(((void*)&s_test_task == (void*)task) && (TEST_DEFERREDFLAGS == flags))
+    {
+        s_test_evtsets++;
+    }
+}
+
+
+extern void rt_psq_enq(OS_ID entry, U32 arg)
+{
+}
+
+
+extern void rt_psh_req(void)
+{
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - definition of static functions
+// --------------------------------------------------------------------------------------------------------------------
+
+static void s_test_check(int cond, const char *str, int line)
+{
+    if(!cond)
+    {
+        if(s_test_failures < 16)
+        {
+            printf("advtmr-test: line %d: %s failed at tick %llu\n", line, str, (unsigned long long)oosiit_time);
+        }
+        s_test_failures++;
+    }
+}
+
+
+static void s_test_start(advtmr_model_t *m, uint32_t firstshot, uint32_t period)
+{
+    oosiit_advtmr_timing_t timing = { .startat = OOSIIT_ASAPTIME, .firstshot = firstshot, .othershots = period };
+    oosiit_advtmr_action_t action = { .cbk = s_test_on_expiry, .par = m };
+
+    m->next = oosiit_time + firstshot;
+    m->period = period;
+    TEST_CHECK(OS_R_OK == rt_iit_advtmr_start(m->timer, &timing, &action));
+}
+
+
+static void s_test_on_expiry(void *tmr, void *par)
+{
+    advtmr_model_t *m = (advtmr_model_t*)par;
+
+    TEST_CHECK(m->timer == (OS_ID)tmr);
+    // a stopped timer never fires
+    TEST_CHECK(0 != m->next);
+
+    if(0 == m->deferred)
+    {
+        TEST_CHECK(1 == s_test_inscheduler);
+        TEST_CHECK(m->next == oosiit_time);
+        s_test_firedinscheduler++;
+    }
+    else
+    {   // the timer task runs the callback at its first activation after the expiry
+        TEST_CHECK(0 == s_test_inscheduler);
+        TEST_CHECK((oosiit_time >= m->next) && (oosiit_time - m->next < TEST_DEFERREDPERIOD));
+        s_test_firedintask++;
+    }
+
+    m->fired++;
+    m->next = (0 == m->period) ? (0) : (m->next + m->period);
+}
+
+
+static void s_test_on_absolute(void *tmr, void *par)
+{
+    if(s_test_absnumber < sizeof(s_test_absfired)/sizeof(s_test_absfired[0]))
+    {
+        s_test_absfired[s_test_absnumber++] = oosiit_time;
+    }
+}
+
+
+static void s_test_model(void)
+{
+    uint32_t expected = 0;
+    uint32_t fired = 0;
+    uint32_t active = 0;
+    uint32_t k;
+    uint32_t i;
+
+    srand(7);
+    TEST_CHECK(OS_R_OK == rt_iit_advtmr_deferred_config(&s_test_task, TEST_DEFERREDFLAGS));
+
+    for(i=0; i<TEST_TIMERS; i++)
+    {
+        advtmr_model_t *m = &s_test_models[i];
+        uint32_t firstshot = 1 + rand() % 5000;
+        uint32_t period = (0 != rand() % 3) ? (1 + rand() % 2000) : (0);
+
+        memset(m, 0, sizeof(advtmr_model_t));
+        m->timer = rt_iit_advtmr_new();
+        TEST_CHECK(NULL != m->timer);
+        m->deferred = (0 == i % 10) ? (1) : (0);
+        TEST_CHECK(OS_R_OK == rt_iit_advtmr_defer(m->timer, m->deferred));
+        s_test_start(m, firstshot, period);
+    }
+
+    for(k=0; k<TEST_TICKS; k++)
+    {
+        oosiit_time++;
+        s_test_inscheduler = 1;
+        rt_iit_advtmr_tick();
+        s_test_inscheduler = 0;
+
+        // the timer task. it also runs just before a stop, so that no callback of a stopped timer is queued
+        if((0 == k % TEST_DEFERREDPERIOD) || (0 == k % TEST_STOPPERIOD))
+        {
+            rt_iit_advtmr_deferred_process();
+        }
+
+        if(0 == k % TEST_STOPPERIOD)
+        {
+            advtmr_model_t *m = &s_test_models[rand() % TEST_TIMERS];
+
+            TEST_CHECK(OS_R_OK == rt_iit_advtmr_stop(m->timer) || (0 == m->next));
+            m->next = 0;
+            TEST_CHECK(OS_R_OK != rt_iit_advtmr_isactive(m->timer));
+            if(0 != rand() % 2)
+            {
+                uint32_t firstshot = 1 + rand() % 3000;
+                uint32_t period = (0 != rand() % 2) ? (rand() % 1500) : (0);
+                s_test_start(m, firstshot, period);
+            }
+        }
+
+        // no timer of the scheduler is late
+        for(i=0; i<TEST_TIMERS; i++)
+        {
+            advtmr_model_t *m = &s_test_models[i];
+            if((0 == m->deferred) && (0 != m->next))
+            {
+                TEST_CHECK(m->next > oosiit_time);
+            }
+        }
+    }
+
+    rt_iit_advtmr_deferred_process();
+
+    for(i=0; i<TEST_TIMERS; i++)
+    {
+        advtmr_model_t *m = &s_test_models[i];
+        fired += m->fired;
+        if(OS_R_OK == rt_iit_advtmr_isactive(m->timer))
+        {
+            active++;
+            // an active timer is one which the model expects to fire
+            TEST_CHECK(0 != m->next);
+        }
+        else
+        {
+            TEST_CHECK(0 == m->next);
+        }
+    }
+
+    expected = s_test_firedinscheduler + s_test_firedintask;
+    TEST_CHECK(fired == expected);
+    TEST_CHECK(0 != s_test_firedintask);
+    TEST_CHECK(0 != s_test_evtsets);
+    TEST_CHECK(s_test_evtsets <= s_test_firedintask);
+
+    printf("advtmr-test: %d timers over %d ticks: %u callbacks in the scheduler, %u in the timer task, %u still active\n",
+           TEST_TIMERS, TEST_TICKS, (unsigned)s_test_firedinscheduler, (unsigned)s_test_firedintask, (unsigned)active);
+
+    for(i=0; i<TEST_TIMERS; i++)
+    {
+        rt_iit_advtmr_stop(s_test_models[i].timer);
+        rt_iit_advtmr_delete(s_test_models[i].timer);
+    }
+    rt_iit_advtmr_deferred_config(NULL, 0);
+}
+
+
+// a periodic absolute timer at every multiple of 100 and a one-shot absolute timer at 400 from time 0. the time is
+// moved from 250 to 1050 after the start: the one-shot is already in the past and fires at once, the periodic one
+// keeps the multiples of 100.
+static void s_test_absolute(void)
+{
+    oosiit_advtmr_timing_t timingper = { .startat = 0, .firstshot = 100, .othershots = 100 };
+    oosiit_advtmr_timing_t timingone = { .startat = 400, .firstshot = 0, .othershots = 0 };
+    oosiit_advtmr_action_t action = { .cbk = s_test_on_absolute, .par = NULL };
+    OS_ID per = rt_iit_advtmr_new();
+    OS_ID one = rt_iit_advtmr_new();
+    uint64_t oldtime = 0;
+    uint32_t k;
+
+    oosiit_time = 0;
+    s_test_absnumber = 0;
+    TEST_CHECK(OS_R_OK == rt_iit_advtmr_start(per, &timingper, &action));
+    TEST_CHECK(OS_R_OK == rt_iit_advtmr_start(one, &timingone, &action));
+
+    for(k=0; k<250; k++)
+    {
+        oosiit_time++;
+        rt_iit_advtmr_tick();
+    }
+
+    oldtime = oosiit_time;
+    oosiit_time = 1050;
+    rt_iit_advtmr_synchronise(oldtime);
+
+    for(k=0; k<160; k++)
+    {
+        oosiit_time++;
+        rt_iit_advtmr_tick();
+    }
+
+    TEST_CHECK(5 == s_test_absnumber);
+    TEST_CHECK(100 == s_test_absfired[0]);
+    TEST_CHECK(200 == s_test_absfired[1]);
+    TEST_CHECK(1051 == s_test_absfired[2]);
+    TEST_CHECK(1100 == s_test_absfired[3]);
+    TEST_CHECK(1200 == s_test_absfired[4]);
+}
+
+
+// --------------------------------------------------------------------------------------------------------------------
+// - end-of-file (leave a blank line after)
+// --------------------------------------------------------------------------------------------------------------------
+
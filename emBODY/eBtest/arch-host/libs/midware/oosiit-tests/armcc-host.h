@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 iCub Facility - Istituto Italiano di Tecnologia
+ * Author:  agent
+ * email:   agent@local
+ * website: www.robotcub.org
+ * Permission is granted to copy, distribute, and/or modify this program
+ * under the terms of the GNU General Public License, version 2 or any
+ * later version published by the Free Software Foundation.
+ *
+ * A copy of the license can be found at
+ * http://www.robotcub.org/icub/license/gpl.txt
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details
+*/
+
+// - include guard ----------------------------------------------------------------------------------------------------
+#ifndef _ARMCC_HOST_H_
+#define _ARMCC_HOST_H_
+
+
+/** @file       armcc-host.h
+    @brief      This header file is included before every source of oosiit built on the host. It removes the keywords of
+                armcc which the sources of rtx use, so that gcc can compile the parts which do not touch the cpu.
+    @author     agent@local
+    @date       10/18/2026
+**/
+
+#define __CMSIS_RTOS
+
+#define __weak
+#define __inline    inline
+#define __INLINE    inline
+#define __asm       asm
+#define __svc(x)
+
+
+#endif  // include-guard
+
+
+// - end-of-file (leave a blank line after)----------------------------------------------------------------------------
+